@@ -1,22 +1,42 @@
 #include "Core/Engine.h"
 #include "Editor.h"
+#include "Utils/RenderingHelper.h"
+#include <cstring>
+#include <cstdlib>
 
 int main(int argc, char* argv[])
 {
+    // --headless [frames] runs the engine on the null rendering API without the editor and stops after the given number of frames
+    bool bHeadless = argc > 1 && std::strcmp(argv[1], "--headless") == 0;
+    int32_t framesLeft = bHeadless && argc > 2 ? std::atoi(argv[2]) : 1;
+
+    if (bHeadless)
+    {
+        RenderingHelper::SetRenderingAPI(RenderingAPI::Null);
+    }
+
     Engine& engine = Engine::Create();
 
     engine.Start();
     engine.Initialize();
 
-    std::shared_ptr<Editor> editor = std::make_shared<Editor>();
+    if (!bHeadless)
+    {
+        std::shared_ptr<Editor> editor = std::make_shared<Editor>();
 
-    engine.AddManager(editor);
+        engine.AddManager(editor);
+    }
 
     while (true) 
     {
         if (engine.IsRunning())
         {
             engine.Update();
+
+            if (bHeadless && --framesLeft <= 0)
+            {
+                engine.Stop();
+            }
         }
         else
         {
@@ -4,6 +4,7 @@
 #include "Widgets/CameraDetailsWidget.h"
 #include "Widgets/ContentBrowserWidget.h"
 #include "Widgets/OptionsMenuWidget.h"
+#include "Widgets/ProfilerWidget.h"
 #include "Widgets/SceneTreeWidget.h"
 #include "Widgets/ViewportWidget.h"
 #include "Utils/Files.h"
@@ -41,6 +42,7 @@ void Editor::Initialize(Engine* engine)
     m_Engine->AddWidget<ViewportWidget>();
     m_Engine->AddWidget<ContentBrowserWidget>();
     m_Engine->AddWidget<AssetDetails>();
+    m_Engine->AddWidget<ProfilerWidget>();
 }
 
 void Editor::Update(float DeltaTime)
@@ -5,6 +5,7 @@
 #include "Core/Components/StaticMeshComponent.h"
 #include "Core/Components/SpotLightComponent.h"
 #include "Core/Components/DirectionalLightComponent.h"
+#include "Core/Components/IrradianceVolumeComponent.h"
 #include "Core/Objects/Actor.h"
 
 #include <imgui.h>
@@ -105,6 +106,11 @@ void ActorDetailsWidget::CreateComponent(std::shared_ptr<Actor> actor)
             actor->RegisterComponent(std::make_shared<DirectionalLightComponent>());
         }
 
+        if (ImGui::Selectable("Irradiance Volume"))
+        {
+            actor->RegisterComponent(std::make_shared<IrradianceVolumeComponent>());
+        }
+
         ImGui::EndCombo();
     }
 }
@@ -3,12 +3,14 @@
 #include "Core/Scene.h"
 #include "Core/Engine.h"
 #include "Core/Rendering/Renderer.h"
+#include "Core/Rendering/RenderGraph.h"
 #include "Core/Rendering/Passes/ResolutionPass.h"
 #include "Core/Rendering/Passes/Bloom/BloomMultiPass.h"
 #include "Core/Rendering/Passes/FXAAPass.h"
 #include "Core/Rendering/Passes/TAAPass.h"
 #include "Core/Rendering/Passes/Lighting/SpotLight/SpotLightMultiPass.h"
 #include "Core/Rendering/Passes/Lighting/SpotLight/SpotLightShadingPass.h"
+#include "Core/Rendering/Passes/Lighting/ClusteredLightingPass.h"
 #include "Core/Rendering/Passes/SSAO/SSAOMultiPass.h"
 #include "Core/Rendering/Passes/SSAO/SSAOPass.h"
 #include <imgui.h>
@@ -61,7 +63,7 @@ void CameraDetailsWidget::Tick(float DeltaTime)
 	{
 		ImGui::Begin("Rendering");
 
-		static RenderTarget targets[] = { RenderTarget::GAlbedo, RenderTarget::GPosition, RenderTarget::GNormal, RenderTarget::GRougnessMetalicEmission, RenderTarget::GVelocity, RenderTarget::GDepth, RenderTarget::SSAO, RenderTarget::Diffuse, RenderTarget::Specular, RenderTarget::Light, RenderTarget::Bloom, RenderTarget::AAOutput, RenderTarget::Resolution };
+		static RenderTarget targets[] = { RenderTarget::GAlbedo, RenderTarget::GPosition, RenderTarget::GNormal, RenderTarget::GRougnessMetalicEmission, RenderTarget::GVelocity, RenderTarget::GLightmap, RenderTarget::GDepth, RenderTarget::SSAO, RenderTarget::Diffuse, RenderTarget::Specular, RenderTarget::Light, RenderTarget::Bloom, RenderTarget::AAOutput, RenderTarget::Resolution };
 
 		if (RenderTarget activeTarget = m_Renderer->GetActiveRenderTarget(); ImGui::BeginCombo("Render Target", GetRenderTargetName(activeTarget).c_str()))
 		{
@@ -193,12 +195,41 @@ void CameraDetailsWidget::Tick(float DeltaTime)
 			}
 		}
 
+		if (bool enabled = m_Renderer->IsClusteredLightingEnabled(); ImGui::Checkbox("Clustered lighting", &enabled))
+		{
+			m_Renderer->SetClusteredLightingEnabled(enabled);
+		}
+
+		if (m_Renderer->IsClusteredLightingEnabled())
+		{
+			std::shared_ptr<ClusteredLightingPass> clustered = graph->GetPass<ClusteredLightingPass>();
+			ImGui::Text("Clustered light indices: %u", (uint32_t)clustered->GetClusters().GetLightIndices().size());
+		}
+
 		std::shared_ptr<ResolutionPass> resoultion = graph->GetPass<ResolutionPass>();
 		if (float gamma = resoultion->GetGamma(); ImGui::SliderFloat("Gamma", &gamma, 0.1f, 10.0f))
 		{
 			resoultion->SetGamma(gamma);
 		}
 
+		if (bool enabled = graph->IsPassFusionEnabled(); ImGui::Checkbox("Fuse fullscreen passes", &enabled))
+		{
+			graph->SetPassFusionEnabled(enabled);
+		}
+
+		if (bool enabled = graph->IsParallelRecordingEnabled(); ImGui::Checkbox("Record independent passes in parallel", &enabled))
+		{
+			graph->SetParallelRecordingEnabled(enabled);
+		}
+
+		glm::u32vec2 renderSize = graph->GetRenderSize();
+		RenderSizeStatistics resizes = graph->GetRenderSizeStatistics();
+		RenderTargetPoolStatistics pool = graph->GetRenderTargetPoolStatistics();
+
+		ImGui::Text("Render size: %ux%u", renderSize.x, renderSize.y);
+		ImGui::Text("Render target resizes: %u, reallocations: %u", resizes.Resizes, resizes.Reallocations);
+		ImGui::Text("Transient render targets: %u on %u textures (%.1f of %.1f MB)", pool.TransientTargetsCount, pool.PhysicalTargetsCount, pool.AllocatedMemory / 1048576.0f, pool.RequestedMemory / 1048576.0f);
+
 		ImGui::End();
 	}
 }
@@ -238,6 +269,7 @@ std::string CameraDetailsWidget::GetRenderTargetName(RenderTarget target)
     case RenderTarget::GNormal:                  return "GNormal";
     case RenderTarget::GRougnessMetalicEmission: return "GRougnessMetalicEmission";
     case RenderTarget::GVelocity:                return "GVelocity";
+    case RenderTarget::GLightmap:                return "GLightmap";
     case RenderTarget::GDepth:                   return "GDepth";
     case RenderTarget::SSAO:                     return "SSAO";
     case RenderTarget::Diffuse:                  return "Diffuse";
@@ -5,6 +5,7 @@
 #include "Core/Components/StaticMeshComponent.h"
 #include "Core/Components/PointLightComponent.h"
 #include "Core/Components/SpotLightComponent.h"
+#include "Core/Components/IrradianceVolumeComponent.h"
 #include "Utils/AssetUtils.h"
 #include <imgui.h>
 #include <glm/gtc/type_ptr.hpp>
@@ -47,6 +48,7 @@ void ComponentDetailsWidget::Tick(float DeltaTime)
         case ComponentType::PointLight:       PointLightDetails();       break;
         case ComponentType::SpotLight:        SpotLightDetails();        break;
         case ComponentType::DirectionalLight: DirectionalLightDetails(); break;
+        case ComponentType::IrradianceVolume: IrradianceVolumeDetails(); break;
         }
     }
 }
@@ -167,6 +169,11 @@ void ComponentDetailsWidget::LightComponentDetails()
 		component->SetShadowCasting(casts);
 	}
 
+	if (bool baked = component->IsBaked(); ImGui::Checkbox("Baked (lightmaps only)", &baked))
+	{
+		component->SetBaked(baked);
+	}
+
 	if (bool enabled = component->ShouldShowWireframe(); ImGui::Checkbox("Show wireframe", &enabled))
 	{
 		component->SetShowWireframe(enabled);
@@ -248,3 +255,38 @@ void ComponentDetailsWidget::DirectionalLightDetails()
         component->SetShadowFilterRadius(radius);
     }
 }
+
+void ComponentDetailsWidget::IrradianceVolumeDetails()
+{
+    std::shared_ptr<IrradianceVolumeComponent> component = std::static_pointer_cast<IrradianceVolumeComponent>(m_Component);
+    std::shared_ptr<IrradianceVolume> volume = component->GetVolume();
+
+    if (glm::vec3 size = component->GetSize(); ImGui::DragFloat3("Volume size", glm::value_ptr(size), 0.1f, 0.0f, 1000.0f))
+    {
+        component->SetSize(size);
+    }
+
+    if (glm::ivec3 count = glm::ivec3(component->GetProbesCount()); ImGui::SliderInt3("Probes count", glm::value_ptr(count), 1, 32))
+    {
+        component->SetProbesCount(glm::u32vec3(glm::max(count, glm::ivec3(1))));
+    }
+
+    if (ImGui::BeginCombo("Probes", volume ? volume->GetName().c_str() : "Bake from the scene menu"))
+    {
+        if (ImGui::Selectable("None"))
+        {
+            component->SetVolume(nullptr);
+        }
+
+        for (const auto& asset : m_AssetManager->GetAssets<IrradianceVolume>(AssetType::IrradianceVolume))
+        {
+            if (ImGui::Selectable(AssetUtils::GetAssetNameLable(asset).c_str(), volume == asset))
+            {
+                m_AssetManager->LoadAsset(asset->GetId());
+                component->SetVolume(asset);
+            }
+        }
+
+        ImGui::EndCombo();
+    }
+}
@@ -23,4 +23,5 @@ private:
     void PointLightDetails();
     void SpotLightDetails();
     void DirectionalLightDetails();
+    void IrradianceVolumeDetails();
 };
@@ -3,12 +3,20 @@
 #include "Core/Engine.h"
 #include "Core/Assets/AssetManager.h"
 #include "Core/Assets/StaticMesh.h"
+#include "Core/Assets/IrradianceVolume.h"
 #include "Core/Rendering/Textures/Texture2D.h"
 #include "Core/Scene.h"
+#include "Core/JobSystem.h"
+#include "Core/Components/StaticMeshComponent.h"
+#include "Core/Components/IrradianceVolumeComponent.h"
+#include "Core/Rendering/LightBakeScene.h"
+#include "Core/Rendering/LightmapBaker.h"
+#include "Core/Rendering/IrradianceVolumeBaker.h"
 #include "Utils/Files.h"
 #include "Utils/RenderingHelper.h"
 #include "Core/Macros.h"
 #include <imgui.h>
+#include <filesystem>
 
 void OptionsMenuWidget::Initialize()
 {
@@ -75,6 +83,16 @@ void OptionsMenuWidget::Tick(float DeltaTime)
             {
                 m_Engine->GetLoadedScene()->CreateActor<Actor>("New Actor");
             }
+
+            if (ImGui::MenuItem("Bake lighting"))
+            {
+                BakeLighting();
+            }
+
+            if (ImGui::MenuItem("Bake irradiance volumes"))
+            {
+                BakeIrradianceVolumes();
+            }
             
             ImGui::EndMenu();
         }
@@ -85,6 +103,130 @@ void OptionsMenuWidget::Tick(float DeltaTime)
 	ImGui::PopStyleVar();
 }
 
+void OptionsMenuWidget::BakeLighting()
+{
+    LightBakeScene scene;
+    std::vector<LightmapBakeInstance> instances;
+    std::vector<std::shared_ptr<StaticMeshComponent>> components;
+
+    LightmapBaker::CollectScene(m_Engine->GetLoadedScene()->GetAllComponents(), scene, instances, components);
+    scene.Build();
+
+    JobSystem jobs;
+    LightmapBaker baker;
+
+    if (instances.empty() || !baker.Bake(scene, instances, LightmapBakeSettings(), jobs))
+    {
+        ED_LOG(Widget, warn, "Nothing was baked, scene has no static meshes or they don't fit into a lightmap")
+        return;
+    }
+
+    std::string path = PlatformUtils::SaveFileWindow("Lightmap\0", *m_Window, "Save lightmap");
+    if (path.empty())
+    {
+        return;
+    }
+
+    std::shared_ptr<Texture2DImportParameters> parameters = std::make_shared<Texture2DImportParameters>();
+    parameters->Path = path;
+    parameters->Format = PixelFormat::RGB32F;
+    parameters->Filtering = FilteringMode::Linear;
+    parameters->WrapS = WrapMode::ClampToEdge;
+    parameters->WrapT = WrapMode::ClampToEdge;
+
+    const std::vector<glm::vec3>& texels = baker.GetTexels();
+    uint32_t size = texels.size() * sizeof(glm::vec3);
+
+    uint8_t* data = new uint8_t[size];
+    memcpy(data, texels.data(), size);
+
+    std::string name = std::filesystem::path(path).filename().string();
+    std::shared_ptr<Texture2D> lightmap = RenderingHelper::CreateTexture2D(name, parameters, Texture2DData(baker.GetSize(), baker.GetSize(), data, size, true));
+
+    std::string savePath = Files::GetSavePath(path, AssetType::Texture2D);
+    Archive archive(savePath, ArchiveMode::Write);
+    archive & lightmap;
+
+    m_AssetManager->RegisterAsset(lightmap, savePath);
+
+    for (uint32_t i = 0; i < components.size(); ++i)
+    {
+        components[i]->SetLightmap(lightmap, instances[i].ScaleOffset);
+    }
+}
+
+void OptionsMenuWidget::BakeIrradianceVolumes()
+{
+    LightBakeScene scene;
+    std::vector<std::shared_ptr<IrradianceVolumeComponent>> components;
+
+    IrradianceVolumeBaker::CollectScene(m_Engine->GetLoadedScene()->GetAllComponents(), scene, components);
+    scene.Build();
+
+    if (components.empty())
+    {
+        ED_LOG(Widget, warn, "Nothing was baked, scene has no irradiance volumes")
+        return;
+    }
+
+    // Asked once, volumes without an asset are saved next to each other
+    std::string path;
+    for (const std::shared_ptr<IrradianceVolumeComponent>& component : components)
+    {
+        if (!component->GetVolume())
+        {
+            path = PlatformUtils::SaveFileWindow("Irradiance volume\0", *m_Window, "Save irradiance volumes");
+            if (path.empty())
+            {
+                return;
+            }
+
+            break;
+        }
+    }
+
+    JobSystem jobs;
+
+    for (uint32_t i = 0; i < components.size(); ++i)
+    {
+        const std::shared_ptr<IrradianceVolumeComponent>& component = components[i];
+
+        glm::vec3 min = component->GetBoundsMin();
+        glm::vec3 max = component->GetBoundsMax();
+        glm::u32vec3 count = component->GetProbesCount();
+
+        std::vector<SHL2> probes = IrradianceVolumeBaker::Bake(scene, min, max, count, IrradianceVolumeBakeSettings(), jobs);
+
+        std::shared_ptr<IrradianceVolume> volume = component->GetVolume();
+        if (volume)
+        {
+            volume->SetProbes(min, max, count, probes);
+
+            std::string savePath = Files::GetSavePath(volume->GetImportParameters()->Path, AssetType::IrradianceVolume, volume->GetName());
+            Archive archive(savePath, ArchiveMode::Write);
+            archive & volume;
+        }
+        else
+        {
+            std::shared_ptr<AssetImportParameters> parameters = std::make_shared<AssetImportParameters>();
+            parameters->Path = path;
+
+            std::string name = std::filesystem::path(path).stem().string() + "_" + std::to_string(i);
+
+            volume = std::make_shared<IrradianceVolume>(name);
+            volume->SetImportParameters(parameters);
+            volume->SetProbes(min, max, count, probes);
+
+            std::string savePath = Files::GetSavePath(path, AssetType::IrradianceVolume, name);
+            Archive archive(savePath, ArchiveMode::Write);
+            archive & volume;
+
+            m_AssetManager->RegisterAsset(volume, savePath);
+            component->SetVolume(volume);
+        }
+    }
+}
+
 void OptionsMenuWidget::StaticMeshImportPopup()
 {
     ImGui::OpenPopup("Static mesh import parameters");
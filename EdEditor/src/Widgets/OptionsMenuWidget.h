@@ -23,6 +23,11 @@ private:
     std::shared_ptr<Texture2DImportParameters> m_TextureImportParameters;
     bool m_TextureImportPopupIsOpened = false;
 
+    // Bakes baked lights of the loaded scene into a lightmap shared by all of its static meshes
+    void BakeLighting();
+    // Bakes probes of every irradiance volume of the loaded scene, volumes without an asset get a new one
+    void BakeIrradianceVolumes();
+
     void StaticMeshImportPopup();
     void TextureImportPopup();
 };
@@ -0,0 +1,51 @@
+﻿#include "ProfilerWidget.h"
+#include "Core/Engine.h"
+#include "Core/Rendering/Renderer.h"
+#include "Core/Rendering/RenderGraph.h"
+#include <imgui.h>
+
+void ProfilerWidget::Initialize()
+{
+    Widget::Initialize();
+
+    m_Renderer = Engine::Get().GetRenderer();
+}
+
+void ProfilerWidget::Tick(float DeltaTime)
+{
+    Widget::Tick(DeltaTime);
+
+    ImGui::Begin("Profiler");
+
+    RenderProfiler& profiler = m_Renderer->GetGraph()->GetProfiler();
+
+    if (bool enabled = profiler.IsEnabled(); ImGui::Checkbox("Enabled", &enabled))
+    {
+        profiler.SetEnabled(enabled);
+    }
+
+    ImGui::Text("Average and max over the last %u frames, ms", RenderProfiler::HistorySize);
+
+    if (ImGui::BeginTable("Scopes", 5, ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV))
+    {
+        ImGui::TableSetupColumn("Scope");
+        ImGui::TableSetupColumn("CPU");
+        ImGui::TableSetupColumn("CPU max");
+        ImGui::TableSetupColumn("GPU");
+        ImGui::TableSetupColumn("GPU max");
+        ImGui::TableHeadersRow();
+
+        for (const ProfilerScopeStatistics& scope : profiler.GetStatistics())
+        {
+            ImGui::TableNextColumn(); ImGui::Text("%*s%s", (int32_t)scope.Depth * 2, "", scope.Name.c_str());
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", scope.AverageCPUTime);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", scope.MaxCPUTime);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", scope.AverageGPUTime);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", scope.MaxGPUTime);
+        }
+
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
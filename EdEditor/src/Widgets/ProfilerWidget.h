@@ -0,0 +1,13 @@
+﻿#pragma once
+
+#include <memory>
+#include "Core/Widget.h"
+
+class ProfilerWidget: public Widget
+{
+public:
+    virtual void Initialize() override;
+    virtual void Tick(float DeltaTime) override;
+private:
+    std::shared_ptr<class Renderer> m_Renderer;
+};
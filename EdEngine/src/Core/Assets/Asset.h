@@ -10,7 +10,8 @@ enum class AssetType : uint8_t
 	Texture2DArray,
 	Material,
 	StaticMesh,
-	StaticSubmesh
+	StaticSubmesh,
+	IrradianceVolume
 };
 
 ED_CLASS(Asset) : public GameObject
@@ -2,12 +2,15 @@
 
 #include "StaticMesh.h"
 #include "Material.h"
+#include "IrradianceVolume.h"
 #include "Core/Rendering/Textures/Texture.h"
 #include "Core/Rendering/Textures/Texture2D.h"
 #include "Core/Rendering/Textures/CubeTexture.h"
 
-#include "Platform/Rendering/OpenGL/Textures/OpenGLCubeTexture.h" // TODO: Fix for the API !!!
+#include "Platform/Rendering/OpenGL/Textures/OpenGLCubeTexture.h"
 #include "Platform/Rendering/OpenGL/Textures/OpenGLTexture2D.h"
+#include "Platform/Rendering/Null/Textures/NullCubeTexture.h"
+#include "Platform/Rendering/Null/Textures/NullTexture2D.h"
 
 #include "Core/Scene.h"
 #include <glm/detail/type_quat.hpp>
@@ -15,6 +18,7 @@
 #include <glm/gtx/matrix_transform_2d.hpp>
 
 #include "Utils/AssetUtils.h"
+#include "Utils/RenderingHelper.h"
 #include "Utils/Files.h"
 
 #include "Core/Macros.h"
@@ -35,11 +39,21 @@ void AssetManager::Initialize(Engine* engine)
     m_Importer.RegisterImporter<MaterialAssetImporter>(AssetType::Material);
     m_Importer.RegisterImporter<StaticMeshImporter>(AssetType::StaticMesh);
 
-    m_Factory = AssetTypeFactory(std::static_pointer_cast<AssetManager>(shared_from_this())); // TODO: Fix for the API !!!
-    m_Factory.RegisterFactory<TemplatedAssetFactory<OpenGLCubeTexture, AssetType::CubeTexture>>(AssetType::CubeTexture);
-    m_Factory.RegisterFactory<TemplatedAssetFactory<OpenGLTexture2D, AssetType::Texture2D>>(AssetType::Texture2D);
+    m_Factory = AssetTypeFactory(std::static_pointer_cast<AssetManager>(shared_from_this()));
+    switch (RenderingHelper::GetRenderingAPI())
+    {
+    case RenderingAPI::Null:
+        m_Factory.RegisterFactory<TemplatedAssetFactory<NullCubeTexture, AssetType::CubeTexture>>(AssetType::CubeTexture);
+        m_Factory.RegisterFactory<TemplatedAssetFactory<NullTexture2D, AssetType::Texture2D>>(AssetType::Texture2D);
+        break;
+    default:
+        m_Factory.RegisterFactory<TemplatedAssetFactory<OpenGLCubeTexture, AssetType::CubeTexture>>(AssetType::CubeTexture);
+        m_Factory.RegisterFactory<TemplatedAssetFactory<OpenGLTexture2D, AssetType::Texture2D>>(AssetType::Texture2D);
+        break;
+    }
     m_Factory.RegisterFactory<TemplatedAssetFactory<Material, AssetType::Material>>(AssetType::Material);
     m_Factory.RegisterFactory<TemplatedAssetFactory<StaticMesh, AssetType::StaticMesh>>(AssetType::StaticMesh);
+    m_Factory.RegisterFactory<TemplatedAssetFactory<IrradianceVolume, AssetType::IrradianceVolume>>(AssetType::IrradianceVolume);
 
 	std::filesystem::recursive_directory_iterator iterator(Files::ContentFolderPath);
 	for (const std::filesystem::directory_entry& entry : iterator)
@@ -0,0 +1,141 @@
+﻿#include "IrradianceVolume.h"
+#include "Utils/SerializationHelper.h"
+#include <glm/glm.hpp>
+
+IrradianceVolume::IrradianceVolume(const std::string& name) : Super(name)
+{
+}
+
+AssetType IrradianceVolume::GetType() const
+{
+	return AssetType::IrradianceVolume;
+}
+
+void IrradianceVolume::SetProbes(const glm::vec3& min, const glm::vec3& max, const glm::u32vec3& count, const std::vector<SHL2>& probes)
+{
+	ED_ASSERT(probes.size() == count.x * count.y * count.z, "Probes don't match their count")
+
+	m_Min = min;
+	m_Max = max;
+	m_ProbesCount = count;
+	m_Probes = probes;
+
+	m_bHasData = true;
+	++m_Generation;
+
+	MarkDirty();
+}
+
+glm::vec3 IrradianceVolume::GetMin() const
+{
+	return m_Min;
+}
+
+glm::vec3 IrradianceVolume::GetMax() const
+{
+	return m_Max;
+}
+
+glm::u32vec3 IrradianceVolume::GetProbesCount() const
+{
+	return m_ProbesCount;
+}
+
+const std::vector<SHL2>& IrradianceVolume::GetProbes() const
+{
+	return m_Probes;
+}
+
+uint32_t IrradianceVolume::GetGeneration() const
+{
+	return m_Generation;
+}
+
+glm::vec3 IrradianceVolume::SampleIrradiance(const glm::vec3& position, const glm::vec3& normal) const
+{
+	if (m_Probes.empty())
+	{
+		return glm::vec3(0.0f);
+	}
+
+	// Same interpolation the ambient pass does, done on coefficients so it is linear in them
+	glm::vec3 last = glm::vec3(m_ProbesCount - glm::u32vec3(1));
+	glm::vec3 extent = glm::max(m_Max - m_Min, glm::vec3(1e-6f));
+	glm::vec3 coordinates = glm::clamp((position - m_Min) / extent * last, glm::vec3(0.0f), last);
+
+	glm::u32vec3 base = glm::u32vec3(glm::floor(coordinates));
+	glm::vec3 fraction = coordinates - glm::vec3(base);
+
+	SHL2 probe;
+	for (uint32_t corner = 0; corner < 8; ++corner)
+	{
+		glm::u32vec3 offset = glm::u32vec3(corner & 1, (corner >> 1) & 1, (corner >> 2) & 1);
+		glm::u32vec3 index = glm::min(base + offset, m_ProbesCount - glm::u32vec3(1));
+
+		glm::vec3 weights = glm::mix(glm::vec3(1.0f) - fraction, fraction, glm::vec3(offset));
+		probe.Add(m_Probes[(index.z * m_ProbesCount.y + index.y) * m_ProbesCount.x + index.x], weights.x * weights.y * weights.z);
+	}
+
+	return probe.GetIrradiance(normal);
+}
+
+glm::vec3 IrradianceVolume::GetProbePosition(const glm::vec3& min, const glm::vec3& max, const glm::u32vec3& count, const glm::u32vec3& probe)
+{
+	glm::vec3 position;
+	for (int32_t axis = 0; axis < 3; ++axis)
+	{
+		if (count[axis] > 1)
+		{
+			position[axis] = min[axis] + (max[axis] - min[axis]) * float(probe[axis]) / float(count[axis] - 1);
+		}
+		else
+		{
+			position[axis] = (min[axis] + max[axis]) * 0.5f;
+		}
+	}
+
+	return position;
+}
+
+void IrradianceVolume::SerializeData(Archive& archive)
+{
+	Super::SerializeData(archive);
+
+	archive & m_Min;
+	archive & m_Max;
+
+	archive & m_ProbesCount.x;
+	archive & m_ProbesCount.y;
+	archive & m_ProbesCount.z;
+
+	std::vector<glm::vec3> coefficients;
+	if (archive.GetMode() == ArchiveMode::Write)
+	{
+		for (const SHL2& probe : m_Probes)
+		{
+			coefficients.insert(coefficients.end(), std::begin(probe.Coefficients), std::end(probe.Coefficients));
+		}
+	}
+
+	archive & coefficients;
+
+	if (archive.GetMode() == ArchiveMode::Read)
+	{
+		ED_ASSERT(coefficients.size() == m_ProbesCount.x * m_ProbesCount.y * m_ProbesCount.z * SHL2::CoefficientsCount, "Probes don't match their count")
+
+		m_Probes.assign(coefficients.size() / SHL2::CoefficientsCount, SHL2());
+		for (uint32_t i = 0; i < coefficients.size(); ++i)
+		{
+			m_Probes[i / SHL2::CoefficientsCount].Coefficients[i % SHL2::CoefficientsCount] = coefficients[i];
+		}
+
+		++m_Generation;
+	}
+}
+
+void IrradianceVolume::FreeData()
+{
+	Super::FreeData();
+
+	m_Probes.clear();
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+﻿#pragma once
+
+#include "Asset.h"
+#include "Core/Rendering/SphericalHarmonics.h"
+#include <glm/vec3.hpp>
+
+// Grid of probes baked inside a box, every probe keeps radiance arriving at its center from all directions.
+// Probes go along x first, then y, then z
+ED_CLASS(IrradianceVolume) : public Asset
+{
+	ED_CLASS_BODY(IrradianceVolume, Asset)
+public:
+	IrradianceVolume(const std::string& name = "Empty");
+
+	virtual AssetType GetType() const override;
+
+	void SetProbes(const glm::vec3& min, const glm::vec3& max, const glm::u32vec3& count, const std::vector<SHL2>& probes);
+
+	glm::vec3 GetMin() const;
+	glm::vec3 GetMax() const;
+	glm::u32vec3 GetProbesCount() const;
+	const std::vector<SHL2>& GetProbes() const;
+
+	// Changes every time probes are set, so renderer knows when to upload them again
+	uint32_t GetGeneration() const;
+
+	// Irradiance interpolated between the eight probes around the position, positions outside the box get the nearest probes
+	glm::vec3 SampleIrradiance(const glm::vec3& position, const glm::vec3& normal) const;
+
+	// Probes lie on both faces of the box, a single probe along an axis is placed in the middle of it
+	static glm::vec3 GetProbePosition(const glm::vec3& min, const glm::vec3& max, const glm::u32vec3& count, const glm::u32vec3& probe);
+
+	virtual void SerializeData(Archive& archive) override;
+	virtual void FreeData() override;
+
+private:
+	glm::vec3 m_Min = glm::vec3(0.0f);
+	glm::vec3 m_Max = glm::vec3(0.0f);
+	glm::u32vec3 m_ProbesCount = glm::u32vec3(0);
+
+	std::vector<SHL2> m_Probes;
+
+	uint32_t m_Generation = 0;
+};
\ No newline at end of file
@@ -2,7 +2,9 @@
 #include "Core/Ed.h"
 #include "Core/Rendering/Buffers/VertexBuffer.h"
 #include "Core/Rendering/Buffers/IndexBuffer.h"
+#include "Core/Rendering/LightmapUnwrap.h"
 #include "Utils/RenderingHelper.h"
+#include <glm/glm.hpp>
 
 StaticSubmesh::StaticSubmesh(const std::string& name) : Super(name)
 {
@@ -45,11 +47,6 @@ void StaticSubmesh::SerializeData(Archive& archive)
 
     archive & m_Vertices;
     archive & m_Indices;
-
-    if (archive.GetMode() == ArchiveMode::Read)
-    {
-        CreateBuffers();
-    }
 }
 
 void StaticSubmesh::FreeData()
@@ -60,6 +57,33 @@ void StaticSubmesh::FreeData()
     m_Vertices.clear();
 }
 
+void StaticSubmesh::SerializeLightmapCoordinates(Archive& archive)
+{
+    std::vector<glm::vec2> coordinates;
+
+    if (archive.GetMode() == ArchiveMode::Write)
+    {
+        for (const Vertex& vertex : m_Vertices)
+        {
+            coordinates.push_back(vertex.LightmapCoordinates);
+        }
+
+        archive & coordinates;
+    }
+    else
+    {
+        archive & coordinates;
+
+        if (coordinates.size() == m_Vertices.size())
+        {
+            for (uint32_t i = 0; i < coordinates.size(); ++i)
+            {
+                m_Vertices[i].LightmapCoordinates = coordinates[i];
+            }
+        }
+    }
+}
+
 void StaticSubmesh::CreateBuffers()
 {
     static VertexBufferLayout layout = {
@@ -68,7 +92,8 @@ void StaticSubmesh::CreateBuffers()
     		{ "TextureCoordinates",  ShaderDataType::Float3 },
     		{ "Normal",              ShaderDataType::Float3 },
     		{ "Tangent",             ShaderDataType::Float3 },
-    		{ "Bitangent",           ShaderDataType::Float3 }
+    		{ "Bitangent",           ShaderDataType::Float3 },
+    		{ "LightmapCoordinates", ShaderDataType::Float2 }
     };
     
     if (m_VertexBuffer)
@@ -88,6 +113,15 @@ void StaticSubmesh::CreateBuffers()
     {
         m_IndexBuffer = RenderingHelper::CreateIndexBuffer((void*)m_Indices.data(), m_Indices.size() * sizeof(int32_t), BufferUsage::StaticDraw);
     }
+
+    m_BoundsMin = glm::vec3(FLT_MAX);
+    m_BoundsMax = glm::vec3(-FLT_MAX);
+
+    for (const Vertex& vertex : m_Vertices)
+    {
+        m_BoundsMin = glm::min(m_BoundsMin, vertex.Position);
+        m_BoundsMax = glm::max(m_BoundsMax, vertex.Position);
+    }
 }
 
 void StaticSubmesh::Serialize(Archive& archive)
@@ -102,6 +136,7 @@ void StaticSubmesh::Serialize(Archive& archive)
 
 StaticMesh::StaticMesh(const std::string& name) : Asset(name)
 {
+    m_Version = LightmapCoordinatesVersion;
 }
 
 AssetType StaticMesh::GetType() const
@@ -129,6 +164,79 @@ void StaticMesh::AddSubmesh(std::shared_ptr<StaticSubmesh> submesh)
 	m_Submeshes.push_back(submesh);
 }
 
+glm::vec4 StaticMesh::GetBoundingSphere() const
+{
+    glm::vec3 min = glm::vec3(FLT_MAX);
+    glm::vec3 max = glm::vec3(-FLT_MAX);
+
+    for (const std::shared_ptr<StaticSubmesh>& submesh : m_Submeshes)
+    {
+        min = glm::min(min, submesh->GetBoundsMin());
+        max = glm::max(max, submesh->GetBoundsMax());
+    }
+
+    if (min.x > max.x)
+    {
+        return glm::vec4(0.0f, 0.0f, 0.0f, -1.0f);
+    }
+
+    return glm::vec4((min + max) / 2.0f, glm::length(max - min) / 2.0f);
+}
+
+bool StaticMesh::GenerateLightmapCoordinates(uint32_t resolution)
+{
+    std::vector<LightmapUnwrapSection> sections(m_Submeshes.size());
+
+    for (uint32_t i = 0; i < m_Submeshes.size(); ++i)
+    {
+        for (const Vertex& vertex : m_Submeshes[i]->GetVertices())
+        {
+            sections[i].Positions.push_back(vertex.Position);
+        }
+
+        sections[i].Indices = m_Submeshes[i]->GetIndices();
+    }
+
+    if (!LightmapUnwrap::Unwrap(sections, resolution))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < m_Submeshes.size(); ++i)
+    {
+        const LightmapUnwrapSection& section = sections[i];
+        const std::vector<Vertex>& sourceVertices = m_Submeshes[i]->GetVertices();
+
+        std::vector<Vertex> vertices(section.SourceVertices.size());
+        for (uint32_t j = 0; j < vertices.size(); ++j)
+        {
+            vertices[j] = sourceVertices[section.SourceVertices[j]];
+            vertices[j].LightmapCoordinates = section.Coordinates[j];
+        }
+
+        std::vector<int32_t> indices = section.UnwrappedIndices;
+        m_Submeshes[i]->SetData(std::move(vertices), std::move(indices));
+        m_Submeshes[i]->MarkDirty();
+    }
+
+    m_LightmapResolution = resolution;
+    m_Version = LightmapCoordinatesVersion;
+
+    MarkDirty();
+
+    return true;
+}
+
+bool StaticMesh::HasLightmapCoordinates() const
+{
+    return m_LightmapResolution != 0;
+}
+
+uint32_t StaticMesh::GetLightmapResolution() const
+{
+    return m_LightmapResolution;
+}
+
 void StaticMesh::ResetState()
 {
     
@@ -139,6 +247,27 @@ void StaticMesh::SerializeData(Archive& archive)
     Super::SerializeData(archive);
 
     archive & m_Submeshes;
+
+    // Older meshes have no lightmap coordinates and get the current version once loaded, so they are saved with them
+    if (GetVersion() >= LightmapCoordinatesVersion)
+    {
+        archive & m_LightmapResolution;
+
+        for (const std::shared_ptr<StaticSubmesh>& submesh : m_Submeshes)
+        {
+            submesh->SerializeLightmapCoordinates(archive);
+        }
+    }
+
+    if (archive.GetMode() == ArchiveMode::Read)
+    {
+        for (const std::shared_ptr<StaticSubmesh>& submesh : m_Submeshes)
+        {
+            submesh->CreateBuffers();
+        }
+
+        m_Version = LightmapCoordinatesVersion;
+    }
 }
 
 void StaticMesh::FreeData()
@@ -3,7 +3,9 @@
 #include "Asset.h"
 #include "ImportParameters/StaticMeshImportParameters.h"
 #include "Material.h"
+#include <glm/vec2.hpp>
 #include <glm/vec4.hpp>
+#include <cfloat>
 
 class VertexBuffer;
 class IndexBuffer;
@@ -17,6 +19,8 @@ struct Vertex
 	glm::vec3 Normal;
 	glm::vec3 Tangent;
 	glm::vec3 Bitangent;
+	// Serialized apart from the rest by StaticMesh, so vertices of older meshes still load
+	glm::vec2 LightmapCoordinates = glm::vec2(0.0f);
 };
 
 
@@ -53,14 +57,24 @@ public:
 	std::shared_ptr<VertexBuffer> GetVertexBuffer() const { return m_VertexBuffer; }
 	std::shared_ptr<IndexBuffer> GetIndexBuffer() const { return m_IndexBuffer; }
 	std::shared_ptr<Material> GetMaterial() const { return m_Material; }
+
+	const std::vector<Vertex>& GetVertices() const { return m_Vertices; }
+	const std::vector<int32_t>& GetIndices() const { return m_Indices; }
+
+	// Local space box around the vertices, min is greater than max until there is data
+	glm::vec3 GetBoundsMin() const { return m_BoundsMin; }
+	glm::vec3 GetBoundsMax() const { return m_BoundsMax; }
 	
 	virtual void ResetState() override;
 	
 	virtual void Serialize(Archive& archive) override;
 	virtual void SerializeData(Archive& archive) override;
 	virtual void FreeData() override;
-	
-protected:
+
+	// Called by StaticMesh after the rest of the data
+	void SerializeLightmapCoordinates(Archive& archive);
+
+	// Loaded submeshes get their buffers from StaticMesh once lightmap coordinates are read too, so vertices are uploaded once
     void CreateBuffers();
 
 protected:
@@ -71,12 +85,19 @@ protected:
 
     std::shared_ptr<VertexBuffer> m_VertexBuffer;
     std::shared_ptr<IndexBuffer> m_IndexBuffer;
+
+    // Kept when data is freed
+    glm::vec3 m_BoundsMin = glm::vec3(FLT_MAX);
+    glm::vec3 m_BoundsMax = glm::vec3(-FLT_MAX);
 };
 
 ED_CLASS(StaticMesh): public Asset
 {
 	ED_CLASS_BODY(StaticMesh, Asset)
 public:
+	// Version meshes got lightmap coordinates in
+	static const uint32_t LightmapCoordinatesVersion = 1;
+
 	StaticMesh(const std::string& name = "Empty");
 	
 	virtual AssetType GetType() const override;
@@ -86,6 +107,15 @@ public:
 	void SetSubmeshes(const std::vector<std::shared_ptr<StaticSubmesh>>& submeshes);
 	void AddSubmesh(std::shared_ptr<StaticSubmesh> submesh);
 	const std::vector<std::shared_ptr<StaticSubmesh>>& GetSubmeshes() const { return m_Submeshes; }
+
+	// Local space sphere around the bounds of all submeshes, xyz is the center and w the radius. Radius is negative when no submesh has data
+	glm::vec4 GetBoundingSphere() const;
+
+	// Submeshes share one lightmap. Vertices are split where charts meet, false when charts don't fit the resolution
+	bool GenerateLightmapCoordinates(uint32_t resolution);
+	bool HasLightmapCoordinates() const;
+	// Size of lightmaps coordinates were generated for, zero without coordinates
+	uint32_t GetLightmapResolution() const;
 	
 	virtual void ResetState() override;
 	
@@ -93,4 +123,6 @@ public:
 	virtual void FreeData() override;
 private:
     std::vector<std::shared_ptr<StaticSubmesh>> m_Submeshes;
+
+    uint32_t m_LightmapResolution = 0;
 };
\ No newline at end of file
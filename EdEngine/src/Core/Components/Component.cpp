@@ -1,5 +1,6 @@
 ﻿#include "Component.h"
 #include "Core/Objects/Actor.h"
+#include "Core/Scene.h"
 
 Component::Component(const std::string& name) : Super(name)
 {
@@ -12,8 +13,15 @@ ComponentType Component::GetType() const
 
 void Component::ClearChildren()
 {
+    Scene* scene = m_OwnerActor ? m_OwnerActor->GetScene() : nullptr;
+
     for (std::shared_ptr<Component> component : m_Children)
     {
+        if (scene)
+        {
+            scene->OnComponentRemoved(component);
+        }
+
         component->SetOwnerActor(nullptr);
         component->SetOwnerComponent(nullptr);
     }
@@ -25,6 +33,11 @@ void Component::AddChild(std::shared_ptr<Component> component)
     component->SetOwnerActor(m_OwnerActor);
     component->SetOwnerComponent(m_OwnerComponent);
     m_Children.push_back(component);
+
+    if (m_OwnerActor && m_OwnerActor->GetScene())
+    {
+        m_OwnerActor->GetScene()->OnComponentAdded(component);
+    }
 }
 
 const std::vector<std::shared_ptr<Component>>& Component::GetChildren() const
@@ -37,6 +50,7 @@ std::vector<std::shared_ptr<Component>> Component::GetAllChildren()
     std::vector<std::shared_ptr<Component>> components;
     for (std::shared_ptr<Component> child: m_Children)
     {
+        components.push_back(child);
         for (std::shared_ptr<Component> component: child->GetAllChildren())
         {
             components.push_back(component);
@@ -73,11 +87,11 @@ std::shared_ptr<Actor> Component::GetOwnerActor() const
 void Component::SetRelativeTransform(const Transform& transform)
 {
     m_Transform = transform;
-}
 
-Transform& Component::GetRelativeTransform()
-{
-    return m_Transform;
+    if (m_Hierarchy)
+    {
+        m_Hierarchy->SetLocal(m_TransformNode, transform);
+    }
 }
 
 Transform Component::GetRelativeTransform() const
@@ -92,6 +106,11 @@ Transform Component::GetPreviousRelativeTransform() const
 
 Transform Component::GetWorldTransform() const
 {
+    if (m_Hierarchy && !m_Hierarchy->IsDirty(m_TransformNode))
+    {
+        return m_Hierarchy->GetWorld(m_TransformNode);
+    }
+
     Transform transform = m_Transform;
 
     std::shared_ptr<Component> component = m_OwnerComponent;
@@ -128,6 +147,52 @@ Transform Component::GetPreviousWorldTransform() const
 	return transform;
 }
 
+glm::mat4 Component::GetWorldMatrix() const
+{
+    if (m_Hierarchy && !m_Hierarchy->IsDirty(m_TransformNode))
+    {
+        return m_Hierarchy->GetWorldMatrix(m_TransformNode);
+    }
+
+    return GetWorldTransform().GetMatrix();
+}
+
+glm::mat4 Component::GetPreviousWorldMatrix() const
+{
+    if (m_Hierarchy && !m_Hierarchy->IsDirty(m_TransformNode))
+    {
+        return m_Hierarchy->GetPreviousWorldMatrix(m_TransformNode);
+    }
+
+    return GetPreviousWorldTransform().GetMatrix();
+}
+
+glm::mat4 Component::GetNormalMatrix() const
+{
+    if (m_Hierarchy && !m_Hierarchy->IsDirty(m_TransformNode))
+    {
+        return m_Hierarchy->GetNormalMatrix(m_TransformNode);
+    }
+
+    return GetWorldTransform().GetInversedTransposedMatrix();
+}
+
+uint32_t Component::GetWorldTransformGeneration() const
+{
+    return m_Hierarchy ? m_Hierarchy->GetGeneration(m_TransformNode) : 0;
+}
+
+void Component::SetTransformNode(TransformHierarchy* hierarchy, TransformNode node)
+{
+    m_Hierarchy = hierarchy;
+    m_TransformNode = node;
+}
+
+TransformNode Component::GetTransformNode() const
+{
+    return m_TransformNode;
+}
+
 void Component::Update(float deltaSeconds)
 {
     m_PreviousTransform = m_Transform;
@@ -3,6 +3,7 @@
 #include "Core/Ed.h"
 #include "Core/Objects/GameObject.h"
 #include "Core/Math/Transform.h"
+#include "Core/Math/TransformHierarchy.h"
 
 enum class ComponentType: uint8_t
 {
@@ -10,7 +11,8 @@ enum class ComponentType: uint8_t
     StaticMesh,
     PointLight,
     SpotLight,
-    DirectionalLight
+    DirectionalLight,
+    IrradianceVolume
 };
 
 class Actor;
@@ -36,13 +38,24 @@ public:
     std::shared_ptr<Actor> GetOwnerActor() const;
 
     void SetRelativeTransform(const Transform& transform);
-    Transform& GetRelativeTransform();
     Transform GetRelativeTransform() const;
     Transform GetPreviousRelativeTransform() const;
 
+    // Cached by the scene transform hierarchy, components outside of a scene or changed since its last update walk the parent chain
     Transform GetWorldTransform() const;
     Transform GetPreviousWorldTransform() const;
 
+    glm::mat4 GetWorldMatrix() const;
+    glm::mat4 GetPreviousWorldMatrix() const;
+    glm::mat4 GetNormalMatrix() const;
+
+    // Changes every time the world transform changes, always zero outside of a scene
+    uint32_t GetWorldTransformGeneration() const;
+
+    // Set by the scene when the component enters or leaves it
+    void SetTransformNode(TransformHierarchy* hierarchy, TransformNode node);
+    TransformNode GetTransformNode() const;
+
     virtual void Update(float deltaSeconds);
 
     virtual void Serialize(Archive& archive) override;
@@ -52,6 +65,9 @@ protected:
 
     Transform m_Transform;
     Transform m_PreviousTransform;
+
+    TransformHierarchy* m_Hierarchy = nullptr;
+    TransformNode m_TransformNode = TransformHierarchy::InvalidNode;
     
     std::vector<std::shared_ptr<Component>> m_Children;
 };
@@ -0,0 +1,64 @@
+﻿#include "IrradianceVolumeComponent.h"
+#include "Utils/SerializationHelper.h"
+
+IrradianceVolumeComponent::IrradianceVolumeComponent() : Super("Irradiance volume")
+{
+}
+
+ComponentType IrradianceVolumeComponent::GetType() const
+{
+    return ComponentType::IrradianceVolume;
+}
+
+void IrradianceVolumeComponent::SetSize(const glm::vec3& size)
+{
+    m_Size = glm::max(size, glm::vec3(0.0f));
+}
+
+glm::vec3 IrradianceVolumeComponent::GetSize() const
+{
+    return m_Size;
+}
+
+void IrradianceVolumeComponent::SetProbesCount(const glm::u32vec3& count)
+{
+    m_ProbesCount = glm::max(count, glm::u32vec3(1));
+}
+
+glm::u32vec3 IrradianceVolumeComponent::GetProbesCount() const
+{
+    return m_ProbesCount;
+}
+
+glm::vec3 IrradianceVolumeComponent::GetBoundsMin() const
+{
+    return GetWorldTransform().GetTranslation() - m_Size * 0.5f;
+}
+
+glm::vec3 IrradianceVolumeComponent::GetBoundsMax() const
+{
+    return GetWorldTransform().GetTranslation() + m_Size * 0.5f;
+}
+
+void IrradianceVolumeComponent::SetVolume(std::shared_ptr<IrradianceVolume> volume)
+{
+    m_Volume = volume;
+}
+
+std::shared_ptr<IrradianceVolume> IrradianceVolumeComponent::GetVolume() const
+{
+    return m_Volume;
+}
+
+void IrradianceVolumeComponent::Serialize(Archive& archive)
+{
+    Super::Serialize(archive);
+
+    archive & m_Size;
+
+    archive & m_ProbesCount.x;
+    archive & m_ProbesCount.y;
+    archive & m_ProbesCount.z;
+
+    m_Volume = SerializationHelper::SerializeAsset(archive, m_Volume);
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+﻿#pragma once
+
+#include "Component.h"
+#include "Core/Assets/IrradianceVolume.h"
+
+// Box of baked irradiance probes centered on the component. The box is axis aligned, rotation and scale of the component are ignored
+ED_CLASS(IrradianceVolumeComponent) : public Component
+{
+    ED_CLASS_BODY(IrradianceVolumeComponent, Component)
+public:
+    IrradianceVolumeComponent();
+
+    virtual ComponentType GetType() const override;
+
+    void SetSize(const glm::vec3& size);
+    glm::vec3 GetSize() const;
+
+    // Probes along every axis, takes effect next time the volume is baked
+    void SetProbesCount(const glm::u32vec3& count);
+    glm::u32vec3 GetProbesCount() const;
+
+    glm::vec3 GetBoundsMin() const;
+    glm::vec3 GetBoundsMax() const;
+
+    void SetVolume(std::shared_ptr<IrradianceVolume> volume);
+    std::shared_ptr<IrradianceVolume> GetVolume() const;
+
+    virtual void Serialize(Archive& archive) override;
+private:
+    glm::vec3 m_Size = glm::vec3(10.0f);
+    glm::u32vec3 m_ProbesCount = glm::u32vec3(4);
+
+    std::shared_ptr<IrradianceVolume> m_Volume;
+};
\ No newline at end of file
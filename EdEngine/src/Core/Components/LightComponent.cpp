@@ -1,7 +1,8 @@
-#include "LightComponent.h"
+﻿#include "LightComponent.h"
 
 LightComponent::LightComponent(): Component("Light")
 {
+	m_Version = BakedVersion;
 }
 
 void LightComponent::SetColor(glm::vec3 color)
@@ -29,6 +30,16 @@ bool LightComponent::IsShadowCasting() const
 	return m_bIsCastingShadow;
 }
 
+void LightComponent::SetBaked(bool enabled)
+{
+	m_bIsBaked = enabled;
+}
+
+bool LightComponent::IsBaked() const
+{
+	return m_bIsBaked;
+}
+
 void LightComponent::SetShowWireframe(bool enabled)
 {
 	m_bShowWireframe = enabled;
@@ -52,6 +63,17 @@ void LightComponent::Serialize(Archive& archive)
 	archive & m_Intensity;
 	archive & m_bIsCastingShadow;
 
+	// Lights saved before baking existed are saved with the flag next time
+	if (GetVersion() >= BakedVersion)
+	{
+		archive & m_bIsBaked;
+	}
+
+	if (archive.GetMode() == ArchiveMode::Read)
+	{
+		m_Version = BakedVersion;
+	}
+
 	m_Color = glm::clamp(m_Color, glm::vec3(0.0f), glm::vec3(1.0f));
 }
 
@@ -1,4 +1,4 @@
-#pragma once
+﻿#pragma once
 
 #include "Component.h"
 
@@ -6,6 +6,9 @@ ED_CLASS(LightComponent) : public Component
 {
 	ED_CLASS_BODY(LightComponent, Component)
 public:
+	// Version lights got the baked flag in
+	static const uint32_t BakedVersion = 1;
+
 	LightComponent();
 
 	void SetColor(glm::vec3 color);
@@ -17,6 +20,10 @@ public:
 	void SetShadowCasting(bool enabled);
 	bool IsShadowCasting() const;
 
+	// Baked lights are skipped by light passes, lightmaps hold their light. Moving them or anything they light needs a new bake
+	void SetBaked(bool enabled);
+	bool IsBaked() const;
+
 	void SetShowWireframe(bool enabled);
 	bool ShouldShowWireframe() const;
 
@@ -27,5 +34,6 @@ private:
 	glm::vec3 m_Color = glm::vec3(1.0f);
 	float m_Intensity = glm::radians(1.0f);
 	bool m_bIsCastingShadow = true;
+	bool m_bIsBaked = false;
 	bool m_bShowWireframe = false;
 };
\ No newline at end of file
@@ -1,12 +1,21 @@
 ﻿#include "StaticMeshComponent.h"
 #include "Core/Assets/StaticMesh.h"
+#include "Core/Rendering/Textures/Texture2D.h"
+#include <glm/glm.hpp>
 
-StaticMeshComponent::StaticMeshComponent(): Super("StaticMesh"), m_StaticMesh(nullptr) {}
+StaticMeshComponent::StaticMeshComponent(): Super("StaticMesh"), m_StaticMesh(nullptr)
+{
+    m_Version = LightmapVersion;
+}
 
-StaticMeshComponent::StaticMeshComponent(const StaticMeshComponent& StaticMesh): Super("StaticMesh"), m_StaticMesh(StaticMesh.m_StaticMesh) {}
+StaticMeshComponent::StaticMeshComponent(const StaticMeshComponent& StaticMesh): Super("StaticMesh"), m_StaticMesh(StaticMesh.m_StaticMesh)
+{
+    m_Version = LightmapVersion;
+}
 
 StaticMeshComponent::StaticMeshComponent(std::shared_ptr<StaticMesh> mesh): Super("StaticMesh")
 {
+    m_Version = LightmapVersion;
     SetStaticMesh(mesh);
 }
 
@@ -21,6 +30,42 @@ std::shared_ptr<StaticMesh> StaticMeshComponent::GetStaticMesh() const
     return m_StaticMesh;
 }
 
+glm::vec4 StaticMeshComponent::GetWorldBoundingSphere() const
+{
+    glm::mat4 world = GetWorldMatrix();
+
+    // Nothing to bound without a mesh
+    if (!m_StaticMesh)
+    {
+        return glm::vec4(glm::vec3(world[3]), 0.0f);
+    }
+
+    glm::vec4 sphere = m_StaticMesh->GetBoundingSphere();
+    if (sphere.w < 0.0f)
+    {
+        return sphere;
+    }
+    float scale = glm::max(glm::max(glm::length(glm::vec3(world[0])), glm::length(glm::vec3(world[1]))), glm::length(glm::vec3(world[2])));
+
+    return glm::vec4(glm::vec3(world * glm::vec4(glm::vec3(sphere), 1.0f)), sphere.w * scale);
+}
+
+void StaticMeshComponent::SetLightmap(std::shared_ptr<Texture2D> lightmap, glm::vec4 scaleOffset)
+{
+    m_Lightmap = lightmap;
+    m_LightmapScaleOffset = lightmap ? scaleOffset : glm::vec4(0.0f);
+}
+
+std::shared_ptr<Texture2D> StaticMeshComponent::GetLightmap() const
+{
+    return m_Lightmap;
+}
+
+glm::vec4 StaticMeshComponent::GetLightmapScaleOffset() const
+{
+    return m_LightmapScaleOffset;
+}
+
 ComponentType StaticMeshComponent::GetType() const
 {
     return ComponentType::StaticMesh;
@@ -31,4 +76,16 @@ void StaticMeshComponent::Serialize(Archive& archive)
     Super::Serialize(archive);
 
     m_StaticMesh = SerializationHelper::SerializeAsset(archive, m_StaticMesh);
+
+    // Components saved before lightmaps existed are saved with them next time
+    if (GetVersion() >= LightmapVersion)
+    {
+        m_Lightmap = SerializationHelper::SerializeAsset(archive, m_Lightmap);
+        archive & m_LightmapScaleOffset;
+    }
+
+    if (archive.GetMode() == ArchiveMode::Read)
+    {
+        m_Version = LightmapVersion;
+    }
 }
\ No newline at end of file
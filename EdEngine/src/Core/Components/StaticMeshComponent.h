@@ -4,16 +4,29 @@
 #include "Core/Ed.h"
 #include "Core/Assets/StaticMesh.h"
 
+class Texture2D;
+
 ED_CLASS(StaticMeshComponent) : public Component
 {
     ED_CLASS_BODY(StaticMeshComponent, Component)
 public:
+    // Version components got lightmaps in
+    static const uint32_t LightmapVersion = 1;
+
     StaticMeshComponent();
     StaticMeshComponent(const StaticMeshComponent& submesh);
     StaticMeshComponent(std::shared_ptr<StaticMesh> mesh);
     
     void SetStaticMesh(std::shared_ptr<StaticMesh> mesh);
     std::shared_ptr<StaticMesh> GetStaticMesh() const;
+
+    // World space sphere around the mesh, negative radius when the mesh has no data loaded
+    glm::vec4 GetWorldBoundingSphere() const;
+
+    // Region of a baked lightmap atlas, atlas coordinates are lightmap coordinates of the mesh times xy plus zw
+    void SetLightmap(std::shared_ptr<Texture2D> lightmap, glm::vec4 scaleOffset);
+    std::shared_ptr<Texture2D> GetLightmap() const;
+    glm::vec4 GetLightmapScaleOffset() const;
    
     virtual ComponentType GetType() const override;
 
@@ -21,5 +34,8 @@ public:
 private:
     std::shared_ptr<StaticMesh> m_StaticMesh;
 
+    std::shared_ptr<Texture2D> m_Lightmap;
+    glm::vec4 m_LightmapScaleOffset = glm::vec4(0.0f);
+
     UUID GetStaticMeshAssetId() const;
 };
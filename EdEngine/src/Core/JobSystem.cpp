@@ -0,0 +1,126 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+JobSystem::JobSystem() : JobSystem(std::max(std::thread::hardware_concurrency(), 1u) - 1)
+{
+}
+
+JobSystem::JobSystem(uint32_t workersCount)
+{
+	m_Workers.reserve(workersCount);
+	for (uint32_t i = 0; i < workersCount; ++i)
+	{
+		m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+	}
+}
+
+void JobSystem::ParallelFor(uint32_t count, const Job& job)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	if (m_Workers.empty() || count == 1)
+	{
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			job(i, 0);
+		}
+
+		return;
+	}
+
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Job = &job;
+		m_JobsCount = count;
+		m_NextJob = 0;
+		m_FinishedJobs = 0;
+		++m_Generation;
+	}
+
+	m_WorkAvailable.notify_all();
+
+	RunJobs(0);
+
+	std::unique_lock lock(m_Mutex);
+	m_WorkFinished.wait(lock, [this]() { return m_FinishedJobs == m_JobsCount; });
+
+	m_Job = nullptr;
+}
+
+uint32_t JobSystem::GetWorkersCount() const
+{
+	return m_Workers.size();
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard lock(m_Mutex);
+		m_bIsStopping = true;
+	}
+
+	m_WorkAvailable.notify_all();
+
+	for (std::thread& worker : m_Workers)
+	{
+		worker.join();
+	}
+}
+
+void JobSystem::WorkerLoop(uint32_t worker)
+{
+	uint64_t generation = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock lock(m_Mutex);
+			m_WorkAvailable.wait(lock, [&]() { return m_bIsStopping || m_Generation != generation; });
+
+			if (m_bIsStopping)
+			{
+				return;
+			}
+
+			generation = m_Generation;
+		}
+
+		RunJobs(worker);
+	}
+}
+
+void JobSystem::RunJobs(uint32_t worker)
+{
+	while (true)
+	{
+		uint32_t index;
+		const Job* job;
+
+		{
+			std::lock_guard lock(m_Mutex);
+			if (!m_Job || m_NextJob >= m_JobsCount)
+			{
+				return;
+			}
+
+			index = m_NextJob++;
+			job = m_Job;
+		}
+
+		(*job)(index, worker);
+
+		bool bIsLast;
+		{
+			std::lock_guard lock(m_Mutex);
+			bIsLast = ++m_FinishedJobs == m_JobsCount;
+		}
+
+		if (bIsLast)
+		{
+			m_WorkFinished.notify_one();
+		}
+	}
+}
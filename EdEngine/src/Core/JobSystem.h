@@ -0,0 +1,49 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed pool of worker threads, work is split into indexed jobs that are picked up by whichever thread is free.
+// Calling thread takes part in the work, so a pool without workers runs everything inline
+class JobSystem
+{
+public:
+	// Worker index is 0 for the calling thread and 1..GetWorkersCount() for pool threads, so per worker data can be indexed by it
+	using Job = std::function<void(uint32_t index, uint32_t worker)>;
+
+	// Uses one thread less than the hardware has, the calling thread is the remaining one
+	JobSystem();
+	explicit JobSystem(uint32_t workersCount);
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	// Runs job for every index in [0, count) and returns when all of them are finished. Calls don't nest and aren't made from several threads at once
+	void ParallelFor(uint32_t count, const Job& job);
+
+	uint32_t GetWorkersCount() const;
+
+	~JobSystem();
+private:
+	void WorkerLoop(uint32_t worker);
+	void RunJobs(uint32_t worker);
+
+private:
+	std::vector<std::thread> m_Workers;
+
+	std::mutex m_Mutex;
+	std::condition_variable m_WorkAvailable;
+	std::condition_variable m_WorkFinished;
+
+	// Batch currently being worked on, generation tells workers a new one was started
+	const Job* m_Job = nullptr;
+	uint32_t m_JobsCount = 0;
+	uint32_t m_NextJob = 0;
+	uint32_t m_FinishedJobs = 0;
+	uint64_t m_Generation = 0;
+
+	bool m_bIsStopping = false;
+};
@@ -8,11 +8,13 @@
 
 Camera::Camera() : m_Projection(glm::mat4(1))
 {
-
+    UpdateView();
+    UpdateProjection();
 }
 
 Camera::Camera(float fovDegrees, float aspect, float near, float far): m_Fov(glm::radians(fovDegrees)), m_Aspect(aspect), m_Near(near), m_Far(far)
 {
+    UpdateView();
     CalculateProjectionMatrix();
 }
 
@@ -34,6 +36,7 @@ void Camera::SetProjection(float fov, float aspect, float near, float far)
 void Camera::SetProjection(const glm::mat4& projection)
 {
     m_Projection = projection;
+    UpdateProjection();
 }
 
 glm::vec3 Camera::GetPosition() const
@@ -44,6 +47,7 @@ glm::vec3 Camera::GetPosition() const
 void Camera::SetPosition(const glm::vec3 position)
 {
     m_Position = position;
+    UpdateView();
 }
 
 glm::vec3 Camera::GetOrientation() const
@@ -59,6 +63,7 @@ glm::vec3 Camera::GetRotation() const
 void Camera::SetOrientation(glm::vec3 orientation)
 {
     m_Orientation = orientation;
+    UpdateView();
 }
 
 void Camera::AddRotation(glm::vec3 rotation)
@@ -82,6 +87,8 @@ void Camera::AddRotation(glm::vec3 rotation)
     m_Orientation.y = glm::sin(pitch);
     m_Orientation.z = glm::cos(pitch) * glm::sin(yaw);
     m_Orientation = glm::normalize(m_Orientation);
+
+    UpdateView();
 }
 
 void Camera::SetRotation(glm::vec3 rotation)
@@ -104,26 +111,88 @@ void Camera::SetRotation(glm::vec3 rotation)
     m_Orientation.y = glm::sin(pitch);
     m_Orientation.z = glm::cos(pitch) * glm::sin(yaw);
     m_Orientation = glm::normalize(m_Orientation);
+
+    UpdateView();
 }
 
 void Camera::AddPositionOffset(glm::vec3 offset)
 {
     m_Position += offset;
+    UpdateView();
 }
 
-glm::mat4 Camera::GetView() const
+const glm::mat4& Camera::GetView() const
 {
-    return glm::lookAt(m_Position, m_Position + m_Orientation, m_Up);
+    return m_View;
 }
 
-glm::mat4 Camera::GetProjection() const
+const glm::mat4& Camera::GetProjection() const
 {
     return m_Projection;
 }
 
-glm::mat4 Camera::GetProjectionView() const
+const glm::mat4& Camera::GetProjectionView() const
+{
+    return m_ProjectionView;
+}
+
+const glm::mat4& Camera::GetInverseView() const
+{
+    return m_InverseView;
+}
+
+const glm::mat4& Camera::GetInverseProjection() const
+{
+    return m_InverseProjection;
+}
+
+const glm::mat4& Camera::GetInverseProjectionView() const
+{
+    return m_InverseProjectionView;
+}
+
+const Frustum& Camera::GetFrustum() const
+{
+    return m_Frustum;
+}
+
+void Camera::GetFrustumCorners(float near, float far, glm::vec3 corners[8]) const
+{
+    // Cached projection may have been set directly, so view depths are taken to NDC through it rather than through m_Near and m_Far
+    glm::vec4 nearClip = m_Projection * glm::vec4(0.0f, 0.0f, -near, 1.0f);
+    glm::vec4 farClip = m_Projection * glm::vec4(0.0f, 0.0f, -far, 1.0f);
+
+    float depthsNDC[2] = { nearClip.z / nearClip.w, farClip.z / farClip.w };
+
+    static const glm::vec2 cornersNDC[4] = { { -1.0f, -1.0f }, { -1.0f, 1.0f }, { 1.0f, 1.0f }, { 1.0f, -1.0f } };
+
+    for (int32_t i = 0; i < 8; ++i)
+    {
+        glm::vec4 corner = m_InverseProjectionView * glm::vec4(cornersNDC[i % 4], depthsNDC[i / 4], 1.0f);
+        corners[i] = glm::vec3(corner) / corner.w;
+    }
+}
+
+const glm::mat4& Camera::GetPreviousView() const
+{
+    return m_PreviousView;
+}
+
+const glm::mat4& Camera::GetPreviousProjection() const
+{
+    return m_PreviousProjection;
+}
+
+const glm::mat4& Camera::GetPreviousProjectionView() const
+{
+    return m_PreviousProjectionView;
+}
+
+void Camera::StorePreviousMatrices()
 {
-    return m_Projection * GetView(); // TODO: May be add some checks here ;)
+    m_PreviousView = m_View;
+    m_PreviousProjection = m_Projection;
+    m_PreviousProjectionView = m_ProjectionView;
 }
 
 glm::vec3 Camera::GetForward() const
@@ -148,9 +217,7 @@ glm::mat4 Camera::GetProjection(float near, float far) const
 
 glm::mat4 Camera::GetProjectionView(float near, float far) const
 {
-    glm::mat4 projection = GetProjection(near, far);
-    glm::mat4 view = GetView();
-    return projection * view;
+    return GetProjection(near, far) * m_View;
 }
 
 void Camera::SetFOVRadians(float fov)
@@ -211,4 +278,25 @@ float Camera::GetFar() const
 void Camera::CalculateProjectionMatrix()
 {
     m_Projection = glm::perspective(m_Fov, m_Aspect, m_Near, m_Far);
+    UpdateProjection();
+}
+
+void Camera::UpdateView()
+{
+    m_View = glm::lookAt(m_Position, m_Position + m_Orientation, m_Up);
+    m_InverseView = glm::inverse(m_View);
+    UpdateProjectionView();
+}
+
+void Camera::UpdateProjection()
+{
+    m_InverseProjection = glm::inverse(m_Projection);
+    UpdateProjectionView();
+}
+
+void Camera::UpdateProjectionView()
+{
+    m_ProjectionView = m_Projection * m_View;
+    m_InverseProjectionView = m_InverseView * m_InverseProjection;
+    m_Frustum = Frustum::FromProjectionView(m_ProjectionView, m_InverseProjectionView);
 }
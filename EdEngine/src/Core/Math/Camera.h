@@ -2,6 +2,7 @@
 #include <glm/fwd.hpp>
 
 #include "Transform.h"
+#include "Frustum.h"
 
 class Camera
 {
@@ -19,6 +20,9 @@ class Camera
 		ar & m_Aspect;
 		ar & m_Near;
 		ar & m_Far;
+
+		UpdateView();
+		UpdateProjection();
 	}
 public:
     Camera();
@@ -41,9 +45,26 @@ public:
     
     void AddPositionOffset(glm::vec3 offset);
 
-    glm::mat4 GetView() const;
-    glm::mat4 GetProjection() const;
-    glm::mat4 GetProjectionView() const;
+    // Matrices and frustum are recomputed only when position, rotation or projection change
+    const glm::mat4& GetView() const;
+    const glm::mat4& GetProjection() const;
+    const glm::mat4& GetProjectionView() const;
+
+    const glm::mat4& GetInverseView() const;
+    const glm::mat4& GetInverseProjection() const;
+    const glm::mat4& GetInverseProjectionView() const;
+
+    const Frustum& GetFrustum() const;
+
+    // Corners of the frustum cut at other near and far distances, ordered the same way as frustum corners
+    void GetFrustumCorners(float near, float far, glm::vec3 corners[8]) const;
+
+    // Matrices stored by the last StorePreviousMatrices call, it is made once per frame by the pass that needs them
+    const glm::mat4& GetPreviousView() const;
+    const glm::mat4& GetPreviousProjection() const;
+    const glm::mat4& GetPreviousProjectionView() const;
+
+    void StorePreviousMatrices();
 
     glm::vec3 GetForward() const;
     glm::vec3 GetRight() const;
@@ -80,7 +101,23 @@ private:
     float m_Near = 0;
     float m_Far = 0;
 
+    glm::mat4 m_View = glm::mat4(1.0f);
+    glm::mat4 m_ProjectionView = glm::mat4(1.0f);
+    glm::mat4 m_InverseView = glm::mat4(1.0f);
+    glm::mat4 m_InverseProjection = glm::mat4(1.0f);
+    glm::mat4 m_InverseProjectionView = glm::mat4(1.0f);
+
+    glm::mat4 m_PreviousView = glm::mat4(1.0f);
+    glm::mat4 m_PreviousProjection = glm::mat4(1.0f);
+    glm::mat4 m_PreviousProjectionView = glm::mat4(1.0f);
+
+    Frustum m_Frustum;
+
     void CalculateProjectionMatrix();
+
+    void UpdateView();
+    void UpdateProjection();
+    void UpdateProjectionView();
 };
 
 BOOST_CLASS_VERSION(Camera, 1)
\ No newline at end of file
@@ -0,0 +1,84 @@
+﻿#include "Frustum.h"
+#include <glm/glm.hpp>
+
+Frustum Frustum::FromProjectionView(const glm::mat4& projectionView, const glm::mat4& inverseProjectionView)
+{
+	Frustum frustum;
+
+	glm::mat4 transposed = glm::transpose(projectionView);
+
+	// Clip space planes are sums and differences of matrix rows, -w <= x, y, z <= w
+	frustum.Planes[(int32_t)FrustumPlane::Left]   = transposed[3] + transposed[0];
+	frustum.Planes[(int32_t)FrustumPlane::Right]  = transposed[3] - transposed[0];
+	frustum.Planes[(int32_t)FrustumPlane::Bottom] = transposed[3] + transposed[1];
+	frustum.Planes[(int32_t)FrustumPlane::Top]    = transposed[3] - transposed[1];
+	frustum.Planes[(int32_t)FrustumPlane::Near]   = transposed[3] + transposed[2];
+	frustum.Planes[(int32_t)FrustumPlane::Far]    = transposed[3] - transposed[2];
+
+	for (glm::vec4& plane : frustum.Planes)
+	{
+		plane /= glm::length(glm::vec3(plane));
+	}
+
+	static const glm::vec4 cornersNDC[8] = {
+		{ -1.0f, -1.0f, -1.0f, 1.0f },
+		{ -1.0f,  1.0f, -1.0f, 1.0f },
+		{  1.0f,  1.0f, -1.0f, 1.0f },
+		{  1.0f, -1.0f, -1.0f, 1.0f },
+		{ -1.0f, -1.0f,  1.0f, 1.0f },
+		{ -1.0f,  1.0f,  1.0f, 1.0f },
+		{  1.0f,  1.0f,  1.0f, 1.0f },
+		{  1.0f, -1.0f,  1.0f, 1.0f }
+	};
+
+	for (int32_t i = 0; i < 8; ++i)
+	{
+		glm::vec4 corner = inverseProjectionView * cornersNDC[i];
+		frustum.Corners[i] = glm::vec3(corner) / corner.w;
+	}
+
+	return frustum;
+}
+
+float Frustum::GetDistance(FrustumPlane plane, const glm::vec3& point) const
+{
+	const glm::vec4& equation = Planes[(int32_t)plane];
+	return glm::dot(glm::vec3(equation), point) + equation.w;
+}
+
+bool Frustum::IsSphereVisible(const glm::vec3& center, float radius) const
+{
+	for (const glm::vec4& plane : Planes)
+	{
+		if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool Frustum::IsConeVisible(const glm::vec3& apex, const glm::vec3& direction, float height, float radius) const
+{
+	glm::vec3 baseCenter = apex + direction * height;
+
+	for (const glm::vec4& plane : Planes)
+	{
+		glm::vec3 normal = glm::vec3(plane);
+
+		// Point of the base disk furthest in front of the plane is offset from its center across the cone axis, the cone is behind the plane if it and the apex are
+		float normalAlongAxis = glm::dot(normal, direction);
+		float normalAcrossAxis = glm::sqrt(glm::max(1.0f - normalAlongAxis * normalAlongAxis, 0.0f));
+
+		float apexDistance = glm::dot(normal, apex) + plane.w;
+		float baseDistance = glm::dot(normal, baseCenter) + plane.w + radius * normalAcrossAxis;
+
+		if (apexDistance < 0.0f && baseDistance < 0.0f)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
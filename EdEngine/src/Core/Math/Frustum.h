@@ -0,0 +1,29 @@
+﻿#pragma once
+
+#include "Core/Ed.h"
+
+enum class FrustumPlane : uint8_t
+{
+	Left,
+	Right,
+	Bottom,
+	Top,
+	Near,
+	Far
+};
+
+// World space view volume of a projection view matrix. Planes point inwards and are normalized, so plane distance of a point is in world units.
+// Corners are ordered the way NDC corners (-1, -1), (-1, 1), (1, 1), (1, -1) go, first on the near plane and then on the far one
+struct Frustum
+{
+	glm::vec4 Planes[6];
+	glm::vec3 Corners[8];
+
+	static Frustum FromProjectionView(const glm::mat4& projectionView, const glm::mat4& inverseProjectionView);
+
+	float GetDistance(FrustumPlane plane, const glm::vec3& point) const;
+
+	bool IsSphereVisible(const glm::vec3& center, float radius) const;
+	// Cone from apex along normalized direction, its base disk has radius at height
+	bool IsConeVisible(const glm::vec3& apex, const glm::vec3& direction, float height, float radius) const;
+};
@@ -0,0 +1,460 @@
+#include "TransformHierarchy.h"
+#include "Core/Macros.h"
+#include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define ED_TRANSFORM_HIERARCHY_SIMD
+#endif
+
+static const uint8_t Clean = 0;
+static const uint8_t Dirty = 1;
+// Created since the last update, its previous matrix is set to the first computed one
+static const uint8_t Created = 2;
+
+static void ComposeMatrix(const Transform& transform, glm::mat4& world, glm::mat4& normal)
+{
+	glm::vec3 t = transform.GetTranslation();
+	glm::quat q = glm::normalize(transform.GetRotation());
+	glm::vec3 s = transform.GetScale();
+
+	float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+	float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+	float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+	glm::vec3 rotation[3] = {
+		{ 1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy) },
+		{ 2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx) },
+		{ 2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy) }
+	};
+
+	// Inverse transpose of translation * rotation * scale keeps the rotation, inverts the scale and moves the translation to the last row
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		world[i] = glm::vec4(rotation[i] * s[i], 0.0f);
+		normal[i] = glm::vec4(rotation[i] / s[i], -glm::dot(rotation[i], t) / s[i]);
+	}
+
+	world[3] = glm::vec4(t, 1.0f);
+	normal[3] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+#ifdef ED_TRANSFORM_HIERARCHY_SIMD
+// Four transforms at once, every register holds one value of all four
+static void ComposeMatrices4(const Transform* transforms, glm::mat4* worldMatrices, glm::mat4* normalMatrices)
+{
+	alignas(16) float values[10][4];
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		glm::vec3 t = transforms[i].GetTranslation();
+		glm::quat q = glm::normalize(transforms[i].GetRotation());
+		glm::vec3 s = transforms[i].GetScale();
+
+		values[0][i] = t.x; values[1][i] = t.y; values[2][i] = t.z;
+		values[3][i] = q.x; values[4][i] = q.y; values[5][i] = q.z; values[6][i] = q.w;
+		values[7][i] = s.x; values[8][i] = s.y; values[9][i] = s.z;
+	}
+
+	__m128 t[3] = { _mm_load_ps(values[0]), _mm_load_ps(values[1]), _mm_load_ps(values[2]) };
+	__m128 x = _mm_load_ps(values[3]), y = _mm_load_ps(values[4]), z = _mm_load_ps(values[5]), w = _mm_load_ps(values[6]);
+	__m128 s[3] = { _mm_load_ps(values[7]), _mm_load_ps(values[8]), _mm_load_ps(values[9]) };
+
+	__m128 one = _mm_set1_ps(1.0f);
+	__m128 two = _mm_set1_ps(2.0f);
+	__m128 zero = _mm_setzero_ps();
+
+	__m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+	__m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+	__m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+	__m128 rotation[3][3] = {
+		{ _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), _mm_mul_ps(two, _mm_add_ps(xy, wz)), _mm_mul_ps(two, _mm_sub_ps(xz, wy)) },
+		{ _mm_mul_ps(two, _mm_sub_ps(xy, wz)), _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), _mm_mul_ps(two, _mm_add_ps(yz, wx)) },
+		{ _mm_mul_ps(two, _mm_add_ps(xz, wy)), _mm_mul_ps(two, _mm_sub_ps(yz, wx)), _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))) }
+	};
+
+	for (uint32_t column = 0; column < 3; ++column)
+	{
+		__m128 inversedScale = _mm_div_ps(one, s[column]);
+
+		__m128 worldX = _mm_mul_ps(rotation[column][0], s[column]);
+		__m128 worldY = _mm_mul_ps(rotation[column][1], s[column]);
+		__m128 worldZ = _mm_mul_ps(rotation[column][2], s[column]);
+		__m128 worldW = zero;
+		_MM_TRANSPOSE4_PS(worldX, worldY, worldZ, worldW);
+
+		__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rotation[column][0], t[0]), _mm_mul_ps(rotation[column][1], t[1])), _mm_mul_ps(rotation[column][2], t[2]));
+
+		__m128 normalX = _mm_mul_ps(rotation[column][0], inversedScale);
+		__m128 normalY = _mm_mul_ps(rotation[column][1], inversedScale);
+		__m128 normalZ = _mm_mul_ps(rotation[column][2], inversedScale);
+		__m128 normalW = _mm_sub_ps(zero, _mm_mul_ps(dot, inversedScale));
+		_MM_TRANSPOSE4_PS(normalX, normalY, normalZ, normalW);
+
+		_mm_storeu_ps(&worldMatrices[0][column][0], worldX);
+		_mm_storeu_ps(&worldMatrices[1][column][0], worldY);
+		_mm_storeu_ps(&worldMatrices[2][column][0], worldZ);
+		_mm_storeu_ps(&worldMatrices[3][column][0], worldW);
+
+		_mm_storeu_ps(&normalMatrices[0][column][0], normalX);
+		_mm_storeu_ps(&normalMatrices[1][column][0], normalY);
+		_mm_storeu_ps(&normalMatrices[2][column][0], normalZ);
+		_mm_storeu_ps(&normalMatrices[3][column][0], normalW);
+	}
+
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		worldMatrices[i][3] = glm::vec4(values[0][i], values[1][i], values[2][i], 1.0f);
+		normalMatrices[i][3] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+}
+#endif
+
+TransformNode TransformHierarchy::Create(TransformNode parent, const Transform& local)
+{
+	TransformNode node;
+	if (!m_FreeNodes.empty())
+	{
+		node = m_FreeNodes.back();
+		m_FreeNodes.pop_back();
+	}
+	else
+	{
+		node = m_Parents.size();
+
+		m_Parents.push_back(InvalidNode);
+		m_FirstChildren.push_back(InvalidNode);
+		m_NextSiblings.push_back(InvalidNode);
+		m_PreviousSiblings.push_back(InvalidNode);
+		m_Depths.push_back(0);
+
+		m_Locals.emplace_back();
+		m_Worlds.emplace_back();
+		m_WorldMatrices.emplace_back(1.0f);
+		m_PreviousWorldMatrices.emplace_back(1.0f);
+		m_NormalMatrices.emplace_back(1.0f);
+
+		// Generations aren't reset when a node is reused, so values cached for a destroyed node never match
+		m_Generations.push_back(0);
+		m_DirtyFlags.push_back(Clean);
+		m_AliveFlags.push_back(false);
+	}
+
+	m_AliveFlags[node] = true;
+	m_Locals[node] = local;
+	m_Worlds[node] = local;
+
+	// Node destroyed and reused before an update is still listed
+	if (m_DirtyFlags[node] == Clean)
+	{
+		m_DirtyNodes.push_back(node);
+	}
+
+	m_DirtyFlags[node] = Created;
+
+	Link(node, parent);
+	UpdateDepth(node);
+
+	return node;
+}
+
+void TransformHierarchy::Destroy(TransformNode node)
+{
+	ED_ASSERT(node < m_AliveFlags.size() && m_AliveFlags[node], "Transform node doesn't exist")
+
+	while (m_FirstChildren[node] != InvalidNode)
+	{
+		SetParent(m_FirstChildren[node], m_Parents[node]);
+	}
+
+	Unlink(node);
+
+	// Dirty flag is kept until the next update, which skips destroyed nodes
+	m_AliveFlags[node] = false;
+	m_FreeNodes.push_back(node);
+}
+
+void TransformHierarchy::SetParent(TransformNode node, TransformNode parent)
+{
+	if (m_Parents[node] == parent)
+	{
+		return;
+	}
+
+	Unlink(node);
+	Link(node, parent);
+
+	UpdateDepth(node);
+	MarkDirty(node);
+}
+
+TransformNode TransformHierarchy::GetParent(TransformNode node) const
+{
+	return m_Parents[node];
+}
+
+void TransformHierarchy::SetLocal(TransformNode node, const Transform& local)
+{
+	// Editor sets transforms of the selected component every frame, unchanged ones don't invalidate the subtree
+	const Transform& current = m_Locals[node];
+	if (current.GetTranslation() == local.GetTranslation() && current.GetRotation() == local.GetRotation() && current.GetScale() == local.GetScale())
+	{
+		return;
+	}
+
+	m_Locals[node] = local;
+	MarkDirty(node);
+}
+
+const Transform& TransformHierarchy::GetLocal(TransformNode node) const
+{
+	return m_Locals[node];
+}
+
+bool TransformHierarchy::IsDirty(TransformNode node) const
+{
+	return m_DirtyFlags[node] != Clean;
+}
+
+const Transform& TransformHierarchy::GetWorld(TransformNode node) const
+{
+	return m_Worlds[node];
+}
+
+const glm::mat4& TransformHierarchy::GetWorldMatrix(TransformNode node) const
+{
+	return m_WorldMatrices[node];
+}
+
+const glm::mat4& TransformHierarchy::GetPreviousWorldMatrix(TransformNode node) const
+{
+	return m_PreviousWorldMatrices[node];
+}
+
+const glm::mat4& TransformHierarchy::GetNormalMatrix(TransformNode node) const
+{
+	return m_NormalMatrices[node];
+}
+
+uint32_t TransformHierarchy::GetGeneration(TransformNode node) const
+{
+	return m_Generations[node];
+}
+
+void TransformHierarchy::Update()
+{
+	// Nodes that don't change this frame had the same world matrix in the previous one
+	for (TransformNode node : m_UpdatedNodes)
+	{
+		m_PreviousWorldMatrices[node] = m_WorldMatrices[node];
+	}
+
+	m_UpdatedNodes.clear();
+
+	// Counting sort by depth, so parents are composed before their children
+	uint32_t maxDepth = 0;
+	for (TransformNode node : m_DirtyNodes)
+	{
+		if (m_AliveFlags[node])
+		{
+			maxDepth = std::max(maxDepth, m_Depths[node]);
+		}
+		else
+		{
+			m_DirtyFlags[node] = Clean;
+		}
+	}
+
+	m_DepthOffsets.assign(maxDepth + 2, 0);
+	for (TransformNode node : m_DirtyNodes)
+	{
+		if (m_AliveFlags[node])
+		{
+			++m_DepthOffsets[m_Depths[node] + 1];
+		}
+	}
+
+	for (uint32_t depth = 1; depth < m_DepthOffsets.size(); ++depth)
+	{
+		m_DepthOffsets[depth] += m_DepthOffsets[depth - 1];
+	}
+
+	m_SortedNodes.resize(m_DepthOffsets.back());
+	for (TransformNode node : m_DirtyNodes)
+	{
+		if (m_AliveFlags[node])
+		{
+			m_SortedNodes[m_DepthOffsets[m_Depths[node]]++] = node;
+		}
+	}
+
+	m_DirtyNodes.clear();
+
+	m_BatchTransforms.resize(m_SortedNodes.size());
+	for (uint32_t i = 0; i < m_SortedNodes.size(); ++i)
+	{
+		TransformNode node = m_SortedNodes[i];
+		TransformNode parent = m_Parents[node];
+
+		m_Worlds[node] = parent != InvalidNode ? m_Locals[node] + m_Worlds[parent] : m_Locals[node];
+		m_BatchTransforms[i] = m_Worlds[node];
+	}
+
+	m_BatchWorldMatrices.resize(m_SortedNodes.size());
+	m_BatchNormalMatrices.resize(m_SortedNodes.size());
+	ComposeMatrices(m_BatchTransforms.data(), m_BatchTransforms.size(), m_BatchWorldMatrices.data(), m_BatchNormalMatrices.data());
+
+	for (uint32_t i = 0; i < m_SortedNodes.size(); ++i)
+	{
+		TransformNode node = m_SortedNodes[i];
+
+		m_WorldMatrices[node] = m_BatchWorldMatrices[i];
+		m_NormalMatrices[node] = m_BatchNormalMatrices[i];
+
+		if (m_DirtyFlags[node] == Created)
+		{
+			m_PreviousWorldMatrices[node] = m_WorldMatrices[node];
+		}
+
+		m_DirtyFlags[node] = Clean;
+		++m_Generations[node];
+	}
+
+	m_UpdatedNodes.swap(m_SortedNodes);
+}
+
+uint32_t TransformHierarchy::GetNodesCount() const
+{
+	return m_Parents.size() - m_FreeNodes.size();
+}
+
+uint32_t TransformHierarchy::GetLastUpdatedNodesCount() const
+{
+	return m_UpdatedNodes.size();
+}
+
+void TransformHierarchy::ComposeMatrices(const Transform* transforms, uint32_t count, glm::mat4* worldMatrices, glm::mat4* normalMatrices)
+{
+	uint32_t i = 0;
+
+#ifdef ED_TRANSFORM_HIERARCHY_SIMD
+	for (; i + 4 <= count; i += 4)
+	{
+		ComposeMatrices4(transforms + i, worldMatrices + i, normalMatrices + i);
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		ComposeMatrix(transforms[i], worldMatrices[i], normalMatrices[i]);
+	}
+}
+
+void TransformHierarchy::MarkDirty(TransformNode node)
+{
+	// Subtree of a dirty node is dirty as well, nodes are cleaned only by Update which cleans whole subtrees
+	if (m_DirtyFlags[node] != Clean)
+	{
+		return;
+	}
+
+	TransformNode current = node;
+	while (true)
+	{
+		if (m_DirtyFlags[current] == Clean)
+		{
+			m_DirtyFlags[current] = Dirty;
+			m_DirtyNodes.push_back(current);
+		}
+
+		if (m_FirstChildren[current] != InvalidNode)
+		{
+			current = m_FirstChildren[current];
+			continue;
+		}
+
+		while (current != node && m_NextSiblings[current] == InvalidNode)
+		{
+			current = m_Parents[current];
+		}
+
+		if (current == node)
+		{
+			break;
+		}
+
+		current = m_NextSiblings[current];
+	}
+}
+
+void TransformHierarchy::Link(TransformNode node, TransformNode parent)
+{
+	m_Parents[node] = parent;
+	m_PreviousSiblings[node] = InvalidNode;
+	m_NextSiblings[node] = InvalidNode;
+
+	if (parent != InvalidNode)
+	{
+		m_NextSiblings[node] = m_FirstChildren[parent];
+		if (m_FirstChildren[parent] != InvalidNode)
+		{
+			m_PreviousSiblings[m_FirstChildren[parent]] = node;
+		}
+
+		m_FirstChildren[parent] = node;
+	}
+}
+
+void TransformHierarchy::Unlink(TransformNode node)
+{
+	TransformNode parent = m_Parents[node];
+	TransformNode previous = m_PreviousSiblings[node];
+	TransformNode next = m_NextSiblings[node];
+
+	if (previous != InvalidNode)
+	{
+		m_NextSiblings[previous] = next;
+	}
+	else if (parent != InvalidNode)
+	{
+		m_FirstChildren[parent] = next;
+	}
+
+	if (next != InvalidNode)
+	{
+		m_PreviousSiblings[next] = previous;
+	}
+
+	m_Parents[node] = InvalidNode;
+	m_PreviousSiblings[node] = InvalidNode;
+	m_NextSiblings[node] = InvalidNode;
+}
+
+void TransformHierarchy::UpdateDepth(TransformNode node)
+{
+	TransformNode current = node;
+	while (true)
+	{
+		TransformNode parent = m_Parents[current];
+		m_Depths[current] = parent != InvalidNode ? m_Depths[parent] + 1 : 0;
+
+		if (m_FirstChildren[current] != InvalidNode)
+		{
+			current = m_FirstChildren[current];
+			continue;
+		}
+
+		while (current != node && m_NextSiblings[current] == InvalidNode)
+		{
+			current = m_Parents[current];
+		}
+
+		if (current == node)
+		{
+			break;
+		}
+
+		current = m_NextSiblings[current];
+	}
+}
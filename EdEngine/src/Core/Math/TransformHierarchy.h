@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Transform.h"
+#include <vector>
+
+using TransformNode = uint32_t;
+
+// World transforms of a scene cached per node, composed the same way Component::GetWorldTransform composes the parent chain.
+// Every attribute lives in its own contiguous array indexed by node. Changing a local transform marks the node and its subtree dirty,
+// Update recomputes only dirty nodes, parents before children, and builds their matrices in batches
+class TransformHierarchy
+{
+public:
+	static const TransformNode InvalidNode = UINT32_MAX;
+
+	TransformNode Create(TransformNode parent, const Transform& local);
+	// Children of the node are moved to its parent
+	void Destroy(TransformNode node);
+
+	void SetParent(TransformNode node, TransformNode parent);
+	TransformNode GetParent(TransformNode node) const;
+
+	void SetLocal(TransformNode node, const Transform& local);
+	const Transform& GetLocal(TransformNode node) const;
+
+	// World values of a dirty node are the ones from the last update
+	bool IsDirty(TransformNode node) const;
+
+	const Transform& GetWorld(TransformNode node) const;
+	const glm::mat4& GetWorldMatrix(TransformNode node) const;
+	const glm::mat4& GetPreviousWorldMatrix(TransformNode node) const;
+	const glm::mat4& GetNormalMatrix(TransformNode node) const;
+
+	// Increased every time world transform of the node changes, so anything derived from it can be cached
+	uint32_t GetGeneration(TransformNode node) const;
+
+	// Called once per frame, previous world matrices become the ones of the last update
+	void Update();
+
+	uint32_t GetNodesCount() const;
+	uint32_t GetLastUpdatedNodesCount() const;
+
+	// Builds world and normal matrices for every transform, in batches of four when SIMD is available.
+	// Same as Transform::GetMatrix and Transform::GetInversedTransposedMatrix for normalized rotations
+	static void ComposeMatrices(const Transform* transforms, uint32_t count, glm::mat4* worldMatrices, glm::mat4* normalMatrices);
+
+private:
+	void MarkDirty(TransformNode node);
+	void Link(TransformNode node, TransformNode parent);
+	void Unlink(TransformNode node);
+	void UpdateDepth(TransformNode node);
+
+private:
+	// Hierarchy, children of a node are a linked list so subtrees can be walked without allocations
+	std::vector<TransformNode> m_Parents;
+	std::vector<TransformNode> m_FirstChildren;
+	std::vector<TransformNode> m_NextSiblings;
+	std::vector<TransformNode> m_PreviousSiblings;
+	std::vector<uint32_t> m_Depths;
+
+	std::vector<Transform> m_Locals;
+	std::vector<Transform> m_Worlds;
+	std::vector<glm::mat4> m_WorldMatrices;
+	std::vector<glm::mat4> m_PreviousWorldMatrices;
+	std::vector<glm::mat4> m_NormalMatrices;
+
+	std::vector<uint32_t> m_Generations;
+	std::vector<uint8_t> m_DirtyFlags;
+	std::vector<uint8_t> m_AliveFlags;
+
+	std::vector<TransformNode> m_FreeNodes;
+
+	// Nodes marked dirty since the last update and nodes recomputed by it, their previous matrices are refreshed by the next one
+	std::vector<TransformNode> m_DirtyNodes;
+	std::vector<TransformNode> m_UpdatedNodes;
+
+	// Scratch memory of Update, kept between frames
+	std::vector<uint32_t> m_DepthOffsets;
+	std::vector<TransformNode> m_SortedNodes;
+	std::vector<Transform> m_BatchTransforms;
+	std::vector<glm::mat4> m_BatchWorldMatrices;
+	std::vector<glm::mat4> m_BatchNormalMatrices;
+};
@@ -1,4 +1,6 @@
 ﻿#include "Actor.h"
+#include "Core/Scene.h"
+#include <algorithm>
 
 Actor::Actor(const std::string& name): Super(name)
 {
@@ -13,9 +15,14 @@ void Actor::Intialize()
 void Actor::SetTransform(const Transform& transform)
 {
     m_Transform = transform;
+
+    if (m_Scene)
+    {
+        m_Scene->GetTransforms().SetLocal(m_TransformNode, transform);
+    }
 }
 
-Transform& Actor::GetTransform()
+const Transform& Actor::GetTransform() const
 {
     return m_Transform;
 }
@@ -39,6 +46,28 @@ void Actor::RegisterComponent(std::shared_ptr<Component> component)
 {
     component->SetOwnerActor(shared_from_this());
     m_Components.push_back(component);
+
+    if (m_Scene)
+    {
+        m_Scene->OnComponentAdded(component);
+    }
+}
+
+void Actor::UnregisterComponent(std::shared_ptr<Component> component)
+{
+    auto it = std::find(m_Components.begin(), m_Components.end(), component);
+    if (it == m_Components.end())
+    {
+        return;
+    }
+
+    if (m_Scene)
+    {
+        m_Scene->OnComponentRemoved(component);
+    }
+
+    component->SetOwnerActor(nullptr);
+    m_Components.erase(it);
 }
 
 const std::vector<std::shared_ptr<Component>>& Actor::GetComponents() const
@@ -61,6 +90,38 @@ std::vector<std::shared_ptr<Component>> Actor::GetAllComponents() const
     return components;
 }
 
+void Actor::SetScene(Scene* scene)
+{
+    // Scene initialization sets the scene of actors added before it again, recreating the root node would detach their components
+    if (scene == m_Scene)
+    {
+        return;
+    }
+
+    if (m_Scene)
+    {
+        m_Scene->GetTransforms().Destroy(m_TransformNode);
+        m_TransformNode = TransformHierarchy::InvalidNode;
+    }
+
+    m_Scene = scene;
+
+    if (m_Scene)
+    {
+        m_TransformNode = m_Scene->GetTransforms().Create(TransformHierarchy::InvalidNode, m_Transform);
+    }
+}
+
+Scene* Actor::GetScene() const
+{
+    return m_Scene;
+}
+
+TransformNode Actor::GetTransformNode() const
+{
+    return m_TransformNode;
+}
+
 void Actor::Serialize(Archive& archive)
 {
     Super::Serialize(archive);
@@ -3,6 +3,8 @@
 #include "GameObject.h"
 #include "Core/Components/Component.h"
 
+class Scene;
+
 ED_CLASS(Actor) : public GameObject, public std::enable_shared_from_this<Actor>
 {
     ED_CLASS_BODY(Actor, GameObject)
@@ -12,19 +14,30 @@ public:
     virtual void Intialize(); 
 
     void SetTransform(const Transform& transform);
-    Transform& GetTransform();
+    const Transform& GetTransform() const;
     Transform GetPreviousTransform() const;
 
     virtual void Update(float deltaSeconds);
 
     void RegisterComponent(std::shared_ptr<Component> component);
+    void UnregisterComponent(std::shared_ptr<Component> component);
     const std::vector<std::shared_ptr<Component>>& GetComponents() const;
 
     std::vector<std::shared_ptr<Component>> GetAllComponents() const;
 
+    // Scene the actor was added to, it is notified about components attached to the actor afterwards.
+    // Actor gets a root node in the scene transform hierarchy, its components are parented to it
+    void SetScene(Scene* scene);
+    Scene* GetScene() const;
+
+    TransformNode GetTransformNode() const;
+
     virtual void Serialize(Archive& archive) override;
 protected:
     std::vector<std::shared_ptr<Component>> m_Components;
     Transform m_Transform;
     Transform m_PreviousTransform;
+
+    Scene* m_Scene = nullptr;
+    TransformNode m_TransformNode = TransformHierarchy::InvalidNode;
 };
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Buffer.h"
+
+class StorageBuffer : public Buffer
+{
+public:
+	virtual uint32_t GetSize() const = 0;
+
+	virtual ~StorageBuffer() = default;
+};
@@ -0,0 +1,811 @@
+#include "CommandBufferRenderingContext.h"
+#include "PipelineState.h"
+#include "Core/Macros.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <ostream>
+
+static const char* GetCommandName(RenderCommandType type)
+{
+	switch (type)
+	{
+	case RenderCommandType::SetDefaultFramebuffer:     return "SetDefaultFramebuffer";
+	case RenderCommandType::SetFramebuffer:            return "SetFramebuffer";
+	case RenderCommandType::SetViewport:               return "SetViewport";
+	case RenderCommandType::SetVertexBuffer:           return "SetVertexBuffer";
+	case RenderCommandType::SetIndexBuffer:            return "SetIndexBuffer";
+	case RenderCommandType::SetStorageBuffer:          return "SetStorageBuffer";
+	case RenderCommandType::SetUniformBuffer:          return "SetUniformBuffer";
+	case RenderCommandType::SetShader:                 return "SetShader";
+	case RenderCommandType::SetPipelineState:          return "SetPipelineState";
+	case RenderCommandType::SetShaderDataTexture:      return "SetShaderDataTexture";
+	case RenderCommandType::SetShaderDataImage:        return "SetShaderDataImage";
+	case RenderCommandType::SetShaderDataInt:          return "SetShaderDataInt";
+	case RenderCommandType::SetShaderDataFloat:        return "SetShaderDataFloat";
+	case RenderCommandType::SetShaderDataFloat2:       return "SetShaderDataFloat2";
+	case RenderCommandType::SetShaderDataFloat3:       return "SetShaderDataFloat3";
+	case RenderCommandType::SetShaderDataFloat4:       return "SetShaderDataFloat4";
+	case RenderCommandType::SetShaderDataMat4:         return "SetShaderDataMat4";
+	case RenderCommandType::SetShaderDataMat3:         return "SetShaderDataMat3";
+	case RenderCommandType::SetShaderDataBool:         return "SetShaderDataBool";
+	case RenderCommandType::RunComputeShader:          return "RunComputeShader";
+	case RenderCommandType::Barier:                    return "Barier";
+	case RenderCommandType::Draw:                      return "Draw";
+	case RenderCommandType::DrawInstanced:             return "DrawInstanced";
+	case RenderCommandType::EnableBlending:            return "EnableBlending";
+	case RenderCommandType::SetBlending:               return "SetBlending";
+	case RenderCommandType::DisableBlending:           return "DisableBlending";
+	case RenderCommandType::EnableDethTest:            return "EnableDethTest";
+	case RenderCommandType::SetDethTestFunction:       return "SetDethTestFunction";
+	case RenderCommandType::DisableDethTest:           return "DisableDethTest";
+	case RenderCommandType::EnableFaceCulling:         return "EnableFaceCulling";
+	case RenderCommandType::EnableFaceCullingWithFace: return "EnableFaceCullingWithFace";
+	case RenderCommandType::SetCullingFace:            return "SetCullingFace";
+	case RenderCommandType::DisableFaceCulling:        return "DisableFaceCulling";
+	case RenderCommandType::ClearDepthTarget:          return "ClearDepthTarget";
+	case RenderCommandType::ClearDepthTargetRegion:    return "ClearDepthTargetRegion";
+	case RenderCommandType::ClearColorTarget:          return "ClearColorTarget";
+	case RenderCommandType::SetClearColor:             return "SetClearColor";
+	case RenderCommandType::CopyTexture:               return "CopyTexture";
+	case RenderCommandType::BeginUIFrame:              return "BeginUIFrame";
+	case RenderCommandType::EndUIFrame:                return "EndUIFrame";
+	case RenderCommandType::SwapBuffers:               return "SwapBuffers";
+	default:
+		ED_ASSERT(0, "Unsupported render command")
+	}
+
+	return "";
+}
+
+static void WriteFloats(std::ostream& stream, const float* values, uint32_t count)
+{
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		stream << ' ' << values[i];
+	}
+}
+
+void CommandBufferRenderingContext::SetDefaultFramebuffer()
+{
+	WriteCommand(RenderCommandType::SetDefaultFramebuffer);
+}
+
+void CommandBufferRenderingContext::SetFramebuffer(std::shared_ptr<Framebuffer> framebuffer)
+{
+	WriteCommand(RenderCommandType::SetFramebuffer);
+	WriteObject(framebuffer);
+}
+
+void CommandBufferRenderingContext::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+	WriteCommand(RenderCommandType::SetViewport);
+	Write(glm::u32vec4(x, y, width, height));
+}
+
+void CommandBufferRenderingContext::SetVertexBuffer(std::shared_ptr<VertexBuffer> buffer)
+{
+	WriteCommand(RenderCommandType::SetVertexBuffer);
+	WriteObject(buffer);
+}
+
+void CommandBufferRenderingContext::SetIndexBuffer(std::shared_ptr<IndexBuffer> buffer)
+{
+	WriteCommand(RenderCommandType::SetIndexBuffer);
+	WriteObject(buffer);
+}
+
+void CommandBufferRenderingContext::SetStorageBuffer(uint32_t binding, std::shared_ptr<StorageBuffer> buffer)
+{
+	WriteCommand(RenderCommandType::SetStorageBuffer);
+	Write(binding);
+	WriteObject(buffer);
+}
+
+void CommandBufferRenderingContext::SetUniformBuffer(uint32_t binding, std::shared_ptr<UniformBuffer> buffer)
+{
+	WriteCommand(RenderCommandType::SetUniformBuffer);
+	Write(binding);
+	WriteObject(buffer);
+}
+
+void CommandBufferRenderingContext::SetShader(std::shared_ptr<Shader> shader)
+{
+	WriteCommand(RenderCommandType::SetShader);
+	WriteObject(shader);
+
+	m_Shader = shader;
+}
+
+const std::shared_ptr<Shader>& CommandBufferRenderingContext::GetShader() const
+{
+	return m_Shader;
+}
+
+void CommandBufferRenderingContext::SetPipelineState(std::shared_ptr<PipelineState> state)
+{
+	WriteCommand(RenderCommandType::SetPipelineState);
+	WriteObject(state);
+
+	m_Shader = state->GetDescription().Shader;
+}
+
+void CommandBufferRenderingContext::SetShaderDataTexture(const std::string& name, std::shared_ptr<Texture> texture)
+{
+	SetShaderDataTexture(name.c_str(), texture);
+}
+
+void CommandBufferRenderingContext::SetShaderDataImage(const std::string& name, std::shared_ptr<Texture> texture)
+{
+	SetShaderDataImage(name.c_str(), texture);
+}
+
+void CommandBufferRenderingContext::SetShaderDataInt(const std::string& name, int32_t value)
+{
+	SetShaderDataInt(name.c_str(), value);
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat(const std::string& name, float value)
+{
+	SetShaderDataFloat(name.c_str(), value);
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat2(const std::string& name, glm::vec2 vector)
+{
+	SetShaderDataFloat2(name.c_str(), vector);
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat2(const std::string& name, float x, float y)
+{
+	SetShaderDataFloat2(name.c_str(), glm::vec2(x, y));
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat3(const std::string& name, float x, float y, float z)
+{
+	SetShaderDataFloat3(name.c_str(), glm::vec3(x, y, z));
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat3(const std::string& name, glm::vec3 vector)
+{
+	SetShaderDataFloat3(name.c_str(), vector);
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat4(const std::string& name, float r, float g, float b, float a)
+{
+	SetShaderDataFloat4(name.c_str(), glm::vec4(r, g, b, a));
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat4(const std::string& name, glm::vec4 vector)
+{
+	SetShaderDataFloat4(name.c_str(), vector);
+}
+
+void CommandBufferRenderingContext::SetShaderDataMat4(const std::string& name, const glm::mat4& matrix)
+{
+	SetShaderDataMat4(name.c_str(), matrix);
+}
+
+void CommandBufferRenderingContext::SetShaderDataMat3(const std::string& name, const glm::mat3& matrix)
+{
+	SetShaderDataMat3(name.c_str(), matrix);
+}
+
+void CommandBufferRenderingContext::SetShaderDataBool(const std::string& name, bool value)
+{
+	SetShaderDataBool(name.c_str(), value);
+}
+
+void CommandBufferRenderingContext::SetShaderDataTexture(const char* name, std::shared_ptr<Texture> texture)
+{
+	WriteCommand(RenderCommandType::SetShaderDataTexture);
+	WriteUniformKey(std::string_view(name));
+	WriteObject(texture);
+}
+
+void CommandBufferRenderingContext::SetShaderDataImage(const char* name, std::shared_ptr<Texture> texture)
+{
+	WriteCommand(RenderCommandType::SetShaderDataImage);
+	WriteUniformKey(std::string_view(name));
+	WriteObject(texture);
+}
+
+void CommandBufferRenderingContext::SetShaderDataInt(const char* name, int32_t value)
+{
+	WriteCommand(RenderCommandType::SetShaderDataInt);
+	WriteUniformKey(std::string_view(name));
+	Write(value);
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat(const char* name, float value)
+{
+	WriteCommand(RenderCommandType::SetShaderDataFloat);
+	WriteUniformKey(std::string_view(name));
+	Write(value);
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat2(const char* name, glm::vec2 vector)
+{
+	WriteCommand(RenderCommandType::SetShaderDataFloat2);
+	WriteUniformKey(std::string_view(name));
+	Write(vector);
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat2(const char* name, float x, float y)
+{
+	SetShaderDataFloat2(name, glm::vec2(x, y));
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat3(const char* name, float x, float y, float z)
+{
+	SetShaderDataFloat3(name, glm::vec3(x, y, z));
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat3(const char* name, glm::vec3 vector)
+{
+	WriteCommand(RenderCommandType::SetShaderDataFloat3);
+	WriteUniformKey(std::string_view(name));
+	Write(vector);
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat4(const char* name, float r, float g, float b, float a)
+{
+	SetShaderDataFloat4(name, glm::vec4(r, g, b, a));
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat4(const char* name, glm::vec4 vector)
+{
+	WriteCommand(RenderCommandType::SetShaderDataFloat4);
+	WriteUniformKey(std::string_view(name));
+	Write(vector);
+}
+
+void CommandBufferRenderingContext::SetShaderDataMat4(const char* name, const glm::mat4& matrix)
+{
+	WriteCommand(RenderCommandType::SetShaderDataMat4);
+	WriteUniformKey(std::string_view(name));
+	Write(matrix);
+}
+
+void CommandBufferRenderingContext::SetShaderDataMat3(const char* name, const glm::mat3& matrix)
+{
+	WriteCommand(RenderCommandType::SetShaderDataMat3);
+	WriteUniformKey(std::string_view(name));
+	Write(matrix);
+}
+
+void CommandBufferRenderingContext::SetShaderDataBool(const char* name, bool value)
+{
+	WriteCommand(RenderCommandType::SetShaderDataBool);
+	WriteUniformKey(std::string_view(name));
+	Write(value);
+}
+
+void CommandBufferRenderingContext::SetShaderDataTexture(int32_t location, std::shared_ptr<Texture> texture)
+{
+	WriteCommand(RenderCommandType::SetShaderDataTexture);
+	WriteUniformKey(location);
+	WriteObject(texture);
+}
+
+void CommandBufferRenderingContext::SetShaderDataImage(int32_t location, std::shared_ptr<Texture> texture)
+{
+	WriteCommand(RenderCommandType::SetShaderDataImage);
+	WriteUniformKey(location);
+	WriteObject(texture);
+}
+
+void CommandBufferRenderingContext::SetShaderDataInt(int32_t location, int32_t value)
+{
+	WriteCommand(RenderCommandType::SetShaderDataInt);
+	WriteUniformKey(location);
+	Write(value);
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat(int32_t location, float value)
+{
+	WriteCommand(RenderCommandType::SetShaderDataFloat);
+	WriteUniformKey(location);
+	Write(value);
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat2(int32_t location, glm::vec2 vector)
+{
+	WriteCommand(RenderCommandType::SetShaderDataFloat2);
+	WriteUniformKey(location);
+	Write(vector);
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat3(int32_t location, glm::vec3 vector)
+{
+	WriteCommand(RenderCommandType::SetShaderDataFloat3);
+	WriteUniformKey(location);
+	Write(vector);
+}
+
+void CommandBufferRenderingContext::SetShaderDataFloat4(int32_t location, glm::vec4 vector)
+{
+	WriteCommand(RenderCommandType::SetShaderDataFloat4);
+	WriteUniformKey(location);
+	Write(vector);
+}
+
+void CommandBufferRenderingContext::SetShaderDataMat4(int32_t location, const glm::mat4& matrix)
+{
+	WriteCommand(RenderCommandType::SetShaderDataMat4);
+	WriteUniformKey(location);
+	Write(matrix);
+}
+
+void CommandBufferRenderingContext::SetShaderDataMat3(int32_t location, const glm::mat3& matrix)
+{
+	WriteCommand(RenderCommandType::SetShaderDataMat3);
+	WriteUniformKey(location);
+	Write(matrix);
+}
+
+void CommandBufferRenderingContext::SetShaderDataBool(int32_t location, bool value)
+{
+	WriteCommand(RenderCommandType::SetShaderDataBool);
+	WriteUniformKey(location);
+	Write(value);
+}
+
+void CommandBufferRenderingContext::RunComputeShader(uint32_t sizeX, uint32_t sizeY, uint32_t sizeZ)
+{
+	WriteCommand(RenderCommandType::RunComputeShader);
+	Write(glm::u32vec3(sizeX, sizeY, sizeZ));
+}
+
+void CommandBufferRenderingContext::Barier(BarrierType type)
+{
+	WriteCommand(RenderCommandType::Barier);
+	Write(type);
+}
+
+void CommandBufferRenderingContext::Draw(DrawMode mode)
+{
+	WriteCommand(RenderCommandType::Draw);
+	Write(mode);
+}
+
+void CommandBufferRenderingContext::DrawInstanced(uint32_t instancesCount, uint32_t firstInstance, DrawMode mode)
+{
+	WriteCommand(RenderCommandType::DrawInstanced);
+	Write(instancesCount);
+	Write(firstInstance);
+	Write(mode);
+}
+
+void CommandBufferRenderingContext::EnableBlending(BlendFactor source, BlendFactor destination)
+{
+	WriteCommand(RenderCommandType::EnableBlending);
+	Write(source);
+	Write(destination);
+}
+
+void CommandBufferRenderingContext::SetBlending(BlendFactor source, BlendFactor destination)
+{
+	WriteCommand(RenderCommandType::SetBlending);
+	Write(source);
+	Write(destination);
+}
+
+void CommandBufferRenderingContext::DisableBlending()
+{
+	WriteCommand(RenderCommandType::DisableBlending);
+}
+
+void CommandBufferRenderingContext::EnableDethTest(DepthTestFunction function)
+{
+	WriteCommand(RenderCommandType::EnableDethTest);
+	Write(function);
+}
+
+void CommandBufferRenderingContext::SetDethTestFunction(DepthTestFunction function)
+{
+	WriteCommand(RenderCommandType::SetDethTestFunction);
+	Write(function);
+}
+
+void CommandBufferRenderingContext::DisableDethTest()
+{
+	WriteCommand(RenderCommandType::DisableDethTest);
+}
+
+void CommandBufferRenderingContext::EnableFaceCulling()
+{
+	WriteCommand(RenderCommandType::EnableFaceCulling);
+}
+
+void CommandBufferRenderingContext::EnableFaceCulling(Face face)
+{
+	WriteCommand(RenderCommandType::EnableFaceCullingWithFace);
+	Write(face);
+}
+
+void CommandBufferRenderingContext::SetCullingFace(Face face)
+{
+	WriteCommand(RenderCommandType::SetCullingFace);
+	Write(face);
+}
+
+void CommandBufferRenderingContext::DisableFaceCulling()
+{
+	WriteCommand(RenderCommandType::DisableFaceCulling);
+}
+
+void CommandBufferRenderingContext::ClearDepthTarget()
+{
+	WriteCommand(RenderCommandType::ClearDepthTarget);
+}
+
+void CommandBufferRenderingContext::ClearDepthTarget(std::shared_ptr<Texture> target, glm::u32vec3 offset, glm::u32vec3 size)
+{
+	WriteCommand(RenderCommandType::ClearDepthTargetRegion);
+	WriteObject(target);
+	Write(offset);
+	Write(size);
+}
+
+void CommandBufferRenderingContext::CopyTexture(std::shared_ptr<Texture> source, std::shared_ptr<Texture> destination, glm::u32vec3 offset, glm::u32vec3 size)
+{
+	WriteCommand(RenderCommandType::CopyTexture);
+	WriteObject(source);
+	WriteObject(destination);
+	Write(offset);
+	Write(size);
+}
+
+void CommandBufferRenderingContext::ClearColorTarget()
+{
+	WriteCommand(RenderCommandType::ClearColorTarget);
+}
+
+void CommandBufferRenderingContext::SetClearColor(float r, float g, float b, float a)
+{
+	SetClearColor(glm::vec4(r, g, b, a));
+}
+
+void CommandBufferRenderingContext::SetClearColor(glm::vec4 color)
+{
+	WriteCommand(RenderCommandType::SetClearColor);
+	Write(color);
+}
+
+void CommandBufferRenderingContext::BeginUIFrame()
+{
+	WriteCommand(RenderCommandType::BeginUIFrame);
+}
+
+void CommandBufferRenderingContext::EndUIFrame()
+{
+	WriteCommand(RenderCommandType::EndUIFrame);
+}
+
+void CommandBufferRenderingContext::SwapBuffers()
+{
+	WriteCommand(RenderCommandType::SwapBuffers);
+}
+
+const RenderingStateStatistics& CommandBufferRenderingContext::GetStatistics() const
+{
+	return m_Statistics;
+}
+
+void CommandBufferRenderingContext::ResetStatistics()
+{
+
+}
+
+void CommandBufferRenderingContext::Replay(RenderingContext& context) const
+{
+	size_t offset = 0;
+	while (offset < m_Data.size())
+	{
+		switch (Read<RenderCommandType>(offset))
+		{
+		case RenderCommandType::SetDefaultFramebuffer: context.SetDefaultFramebuffer(); break;
+		case RenderCommandType::SetFramebuffer:        context.SetFramebuffer(ReadObject<Framebuffer>(offset)); break;
+		case RenderCommandType::SetViewport:
+		{
+			glm::u32vec4 viewport = Read<glm::u32vec4>(offset);
+			context.SetViewport(viewport.x, viewport.y, viewport.z, viewport.w);
+		} break;
+		case RenderCommandType::SetVertexBuffer:       context.SetVertexBuffer(ReadObject<VertexBuffer>(offset)); break;
+		case RenderCommandType::SetIndexBuffer:        context.SetIndexBuffer(ReadObject<IndexBuffer>(offset)); break;
+		case RenderCommandType::SetStorageBuffer:
+		{
+			uint32_t binding = Read<uint32_t>(offset);
+			context.SetStorageBuffer(binding, ReadObject<StorageBuffer>(offset));
+		} break;
+		case RenderCommandType::SetUniformBuffer:
+		{
+			uint32_t binding = Read<uint32_t>(offset);
+			context.SetUniformBuffer(binding, ReadObject<UniformBuffer>(offset));
+		} break;
+		case RenderCommandType::SetShader:        context.SetShader(ReadObject<Shader>(offset)); break;
+		case RenderCommandType::SetPipelineState: context.SetPipelineState(ReadObject<PipelineState>(offset)); break;
+
+		case RenderCommandType::SetShaderDataTexture: ReadUniformKey(offset, [&](const auto& key) { context.SetShaderDataTexture(key, ReadObject<Texture>(offset)); }); break;
+		case RenderCommandType::SetShaderDataImage:   ReadUniformKey(offset, [&](const auto& key) { context.SetShaderDataImage(key, ReadObject<Texture>(offset)); }); break;
+		case RenderCommandType::SetShaderDataInt:     ReadUniformKey(offset, [&](const auto& key) { context.SetShaderDataInt(key, Read<int32_t>(offset)); }); break;
+		case RenderCommandType::SetShaderDataFloat:   ReadUniformKey(offset, [&](const auto& key) { context.SetShaderDataFloat(key, Read<float>(offset)); }); break;
+		case RenderCommandType::SetShaderDataFloat2:  ReadUniformKey(offset, [&](const auto& key) { context.SetShaderDataFloat2(key, Read<glm::vec2>(offset)); }); break;
+		case RenderCommandType::SetShaderDataFloat3:  ReadUniformKey(offset, [&](const auto& key) { context.SetShaderDataFloat3(key, Read<glm::vec3>(offset)); }); break;
+		case RenderCommandType::SetShaderDataFloat4:  ReadUniformKey(offset, [&](const auto& key) { context.SetShaderDataFloat4(key, Read<glm::vec4>(offset)); }); break;
+		case RenderCommandType::SetShaderDataMat4:    ReadUniformKey(offset, [&](const auto& key) { context.SetShaderDataMat4(key, Read<glm::mat4>(offset)); }); break;
+		case RenderCommandType::SetShaderDataMat3:    ReadUniformKey(offset, [&](const auto& key) { context.SetShaderDataMat3(key, Read<glm::mat3>(offset)); }); break;
+		case RenderCommandType::SetShaderDataBool:    ReadUniformKey(offset, [&](const auto& key) { context.SetShaderDataBool(key, Read<bool>(offset)); }); break;
+
+		case RenderCommandType::RunComputeShader:
+		{
+			glm::u32vec3 size = Read<glm::u32vec3>(offset);
+			context.RunComputeShader(size.x, size.y, size.z);
+		} break;
+		case RenderCommandType::Barier: context.Barier(Read<BarrierType>(offset)); break;
+		case RenderCommandType::Draw:   context.Draw(Read<DrawMode>(offset)); break;
+		case RenderCommandType::DrawInstanced:
+		{
+			uint32_t instancesCount = Read<uint32_t>(offset);
+			uint32_t firstInstance = Read<uint32_t>(offset);
+			context.DrawInstanced(instancesCount, firstInstance, Read<DrawMode>(offset));
+		} break;
+
+		case RenderCommandType::EnableBlending:
+		{
+			BlendFactor source = Read<BlendFactor>(offset);
+			context.EnableBlending(source, Read<BlendFactor>(offset));
+		} break;
+		case RenderCommandType::SetBlending:
+		{
+			BlendFactor source = Read<BlendFactor>(offset);
+			context.SetBlending(source, Read<BlendFactor>(offset));
+		} break;
+		case RenderCommandType::DisableBlending:           context.DisableBlending(); break;
+		case RenderCommandType::EnableDethTest:            context.EnableDethTest(Read<DepthTestFunction>(offset)); break;
+		case RenderCommandType::SetDethTestFunction:       context.SetDethTestFunction(Read<DepthTestFunction>(offset)); break;
+		case RenderCommandType::DisableDethTest:           context.DisableDethTest(); break;
+		case RenderCommandType::EnableFaceCulling:         context.EnableFaceCulling(); break;
+		case RenderCommandType::EnableFaceCullingWithFace: context.EnableFaceCulling(Read<Face>(offset)); break;
+		case RenderCommandType::SetCullingFace:            context.SetCullingFace(Read<Face>(offset)); break;
+		case RenderCommandType::DisableFaceCulling:        context.DisableFaceCulling(); break;
+
+		case RenderCommandType::ClearDepthTarget: context.ClearDepthTarget(); break;
+		case RenderCommandType::ClearDepthTargetRegion:
+		{
+			std::shared_ptr<Texture> target = ReadObject<Texture>(offset);
+			glm::u32vec3 regionOffset = Read<glm::u32vec3>(offset);
+			context.ClearDepthTarget(target, regionOffset, Read<glm::u32vec3>(offset));
+		} break;
+		case RenderCommandType::ClearColorTarget: context.ClearColorTarget(); break;
+		case RenderCommandType::SetClearColor:    context.SetClearColor(Read<glm::vec4>(offset)); break;
+		case RenderCommandType::CopyTexture:
+		{
+			std::shared_ptr<Texture> source = ReadObject<Texture>(offset);
+			std::shared_ptr<Texture> destination = ReadObject<Texture>(offset);
+			glm::u32vec3 regionOffset = Read<glm::u32vec3>(offset);
+			context.CopyTexture(source, destination, regionOffset, Read<glm::u32vec3>(offset));
+		} break;
+
+		case RenderCommandType::BeginUIFrame: context.BeginUIFrame(); break;
+		case RenderCommandType::EndUIFrame:   context.EndUIFrame(); break;
+		case RenderCommandType::SwapBuffers:  context.SwapBuffers(); break;
+		default:
+			ED_ASSERT(0, "Unsupported render command")
+			return;
+		}
+	}
+}
+
+void CommandBufferRenderingContext::Serialize(std::ostream& stream) const
+{
+	auto writeObject = [&](size_t& offset)
+	{
+		uint32_t index = Read<uint32_t>(offset);
+		if (index == NullObject)
+		{
+			stream << " null";
+		}
+		else
+		{
+			stream << " #" << index;
+		}
+	};
+
+	auto writeKey = [&](const auto& key)
+	{
+		stream << ' ' << key;
+	};
+
+	size_t offset = 0;
+	while (offset < m_Data.size())
+	{
+		RenderCommandType type = Read<RenderCommandType>(offset);
+		stream << GetCommandName(type);
+
+		switch (type)
+		{
+		case RenderCommandType::SetFramebuffer:
+		case RenderCommandType::SetVertexBuffer:
+		case RenderCommandType::SetIndexBuffer:
+		case RenderCommandType::SetShader:
+		case RenderCommandType::SetPipelineState:
+			writeObject(offset);
+			break;
+		case RenderCommandType::SetStorageBuffer:
+		case RenderCommandType::SetUniformBuffer:
+			stream << ' ' << Read<uint32_t>(offset);
+			writeObject(offset);
+			break;
+		case RenderCommandType::SetViewport:
+		{
+			glm::u32vec4 viewport = Read<glm::u32vec4>(offset);
+			stream << ' ' << viewport.x << ' ' << viewport.y << ' ' << viewport.z << ' ' << viewport.w;
+		} break;
+
+		case RenderCommandType::SetShaderDataTexture:
+		case RenderCommandType::SetShaderDataImage:
+			ReadUniformKey(offset, writeKey);
+			writeObject(offset);
+			break;
+		case RenderCommandType::SetShaderDataInt:
+			ReadUniformKey(offset, writeKey);
+			stream << ' ' << Read<int32_t>(offset);
+			break;
+		case RenderCommandType::SetShaderDataFloat:
+			ReadUniformKey(offset, writeKey);
+			stream << ' ' << Read<float>(offset);
+			break;
+		case RenderCommandType::SetShaderDataFloat2:
+			ReadUniformKey(offset, writeKey);
+			WriteFloats(stream, glm::value_ptr(Read<glm::vec2>(offset)), 2);
+			break;
+		case RenderCommandType::SetShaderDataFloat3:
+			ReadUniformKey(offset, writeKey);
+			WriteFloats(stream, glm::value_ptr(Read<glm::vec3>(offset)), 3);
+			break;
+		case RenderCommandType::SetShaderDataFloat4:
+			ReadUniformKey(offset, writeKey);
+			WriteFloats(stream, glm::value_ptr(Read<glm::vec4>(offset)), 4);
+			break;
+		case RenderCommandType::SetShaderDataMat4:
+			ReadUniformKey(offset, writeKey);
+			WriteFloats(stream, glm::value_ptr(Read<glm::mat4>(offset)), 16);
+			break;
+		case RenderCommandType::SetShaderDataMat3:
+			ReadUniformKey(offset, writeKey);
+			WriteFloats(stream, glm::value_ptr(Read<glm::mat3>(offset)), 9);
+			break;
+		case RenderCommandType::SetShaderDataBool:
+			ReadUniformKey(offset, writeKey);
+			stream << ' ' << Read<bool>(offset);
+			break;
+
+		case RenderCommandType::RunComputeShader:
+		{
+			glm::u32vec3 size = Read<glm::u32vec3>(offset);
+			stream << ' ' << size.x << ' ' << size.y << ' ' << size.z;
+		} break;
+		case RenderCommandType::Barier:
+			stream << ' ' << (uint32_t)Read<BarrierType>(offset);
+			break;
+		case RenderCommandType::Draw:
+			stream << ' ' << (uint32_t)Read<DrawMode>(offset);
+			break;
+		case RenderCommandType::DrawInstanced:
+		{
+			uint32_t instancesCount = Read<uint32_t>(offset);
+			uint32_t firstInstance = Read<uint32_t>(offset);
+			stream << ' ' << instancesCount << ' ' << firstInstance << ' ' << (uint32_t)Read<DrawMode>(offset);
+		} break;
+
+		case RenderCommandType::EnableBlending:
+		case RenderCommandType::SetBlending:
+		{
+			BlendFactor source = Read<BlendFactor>(offset);
+			stream << ' ' << (uint32_t)source << ' ' << (uint32_t)Read<BlendFactor>(offset);
+		} break;
+		case RenderCommandType::EnableDethTest:
+		case RenderCommandType::SetDethTestFunction:
+			stream << ' ' << (uint32_t)Read<DepthTestFunction>(offset);
+			break;
+		case RenderCommandType::EnableFaceCullingWithFace:
+		case RenderCommandType::SetCullingFace:
+			stream << ' ' << (uint32_t)Read<Face>(offset);
+			break;
+		case RenderCommandType::SetClearColor:
+			WriteFloats(stream, glm::value_ptr(Read<glm::vec4>(offset)), 4);
+			break;
+		case RenderCommandType::ClearDepthTargetRegion:
+		case RenderCommandType::CopyTexture:
+		{
+			writeObject(offset);
+			if (type == RenderCommandType::CopyTexture)
+			{
+				writeObject(offset);
+			}
+
+			glm::u32vec3 regionOffset = Read<glm::u32vec3>(offset);
+			glm::u32vec3 size = Read<glm::u32vec3>(offset);
+			stream << ' ' << regionOffset.x << ' ' << regionOffset.y << ' ' << regionOffset.z << ' ' << size.x << ' ' << size.y << ' ' << size.z;
+		} break;
+		default:
+			break;
+		}
+
+		stream << '\n';
+	}
+}
+
+void CommandBufferRenderingContext::Reset()
+{
+	m_Data.clear();
+	m_CommandsCount = 0;
+
+	m_Objects.clear();
+	m_ObjectIndices.clear();
+
+	m_Shader = nullptr;
+}
+
+uint32_t CommandBufferRenderingContext::GetCommandsCount() const
+{
+	return m_CommandsCount;
+}
+
+const std::vector<uint8_t>& CommandBufferRenderingContext::GetData() const
+{
+	return m_Data;
+}
+
+void CommandBufferRenderingContext::WriteCommand(RenderCommandType type)
+{
+	Write(type);
+	++m_CommandsCount;
+}
+
+void CommandBufferRenderingContext::WriteObject(std::shared_ptr<void> object)
+{
+	if (!object)
+	{
+		Write(NullObject);
+		return;
+	}
+
+	auto [it, bIsInserted] = m_ObjectIndices.try_emplace(object.get(), (uint32_t)m_Objects.size());
+	if (bIsInserted)
+	{
+		m_Objects.push_back(std::move(object));
+	}
+
+	Write(it->second);
+}
+
+void CommandBufferRenderingContext::WriteString(std::string_view string)
+{
+	Write((uint32_t)string.size());
+
+	size_t offset = m_Data.size();
+	m_Data.resize(offset + string.size());
+	std::memcpy(m_Data.data() + offset, string.data(), string.size());
+}
+
+void CommandBufferRenderingContext::WriteUniformKey(int32_t location)
+{
+	Write(UniformKey::Location);
+	Write(location);
+}
+
+void CommandBufferRenderingContext::WriteUniformKey(std::string_view name)
+{
+	Write(UniformKey::Name);
+	WriteString(name);
+}
+
+std::string CommandBufferRenderingContext::ReadString(size_t& offset) const
+{
+	uint32_t size = Read<uint32_t>(offset);
+	std::string string(reinterpret_cast<const char*>(m_Data.data() + offset), size);
+	offset += size;
+
+	return string;
+}
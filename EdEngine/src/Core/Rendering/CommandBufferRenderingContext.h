@@ -0,0 +1,236 @@
+#pragma once
+
+#include "RenderingContex.h"
+#include <cstring>
+#include <iosfwd>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+enum class RenderCommandType : uint8_t
+{
+	SetDefaultFramebuffer,
+	SetFramebuffer,
+	SetViewport,
+	SetVertexBuffer,
+	SetIndexBuffer,
+	SetStorageBuffer,
+	SetUniformBuffer,
+	SetShader,
+	SetPipelineState,
+
+	SetShaderDataTexture,
+	SetShaderDataImage,
+	SetShaderDataInt,
+	SetShaderDataFloat,
+	SetShaderDataFloat2,
+	SetShaderDataFloat3,
+	SetShaderDataFloat4,
+	SetShaderDataMat4,
+	SetShaderDataMat3,
+	SetShaderDataBool,
+
+	RunComputeShader,
+	Barier,
+	Draw,
+	DrawInstanced,
+
+	EnableBlending,
+	SetBlending,
+	DisableBlending,
+	EnableDethTest,
+	SetDethTestFunction,
+	DisableDethTest,
+	EnableFaceCulling,
+	EnableFaceCullingWithFace,
+	SetCullingFace,
+	DisableFaceCulling,
+
+	ClearDepthTarget,
+	ClearDepthTargetRegion,
+	ClearColorTarget,
+	SetClearColor,
+	CopyTexture,
+
+	BeginUIFrame,
+	EndUIFrame,
+	SwapBuffers
+};
+
+// Encodes calls into a linear byte stream instead of executing them, so a frame can be recorded on any thread and replayed on the one owning the graphics API.
+// Each command is its type followed by its arguments, objects are stored as indices into a table that keeps them alive until the buffer is reset.
+// Uniforms are recorded by location or by name, whichever was used, locations are resolved against the shader set when they are recorded
+class CommandBufferRenderingContext : public RenderingContext
+{
+public:
+	virtual void SetDefaultFramebuffer() override;
+	virtual void SetFramebuffer(std::shared_ptr<Framebuffer> framebuffer) override;
+	virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+
+	virtual void SetVertexBuffer(std::shared_ptr<VertexBuffer> buffer) override;
+
+	virtual void SetIndexBuffer(std::shared_ptr<IndexBuffer> buffer) override;
+
+	virtual void SetStorageBuffer(uint32_t binding, std::shared_ptr<StorageBuffer> buffer) override;
+	virtual void SetUniformBuffer(uint32_t binding, std::shared_ptr<UniformBuffer> buffer) override;
+
+	virtual void SetShader(std::shared_ptr<Shader> shader) override;
+	virtual const std::shared_ptr<Shader>& GetShader() const override;
+
+	virtual void SetPipelineState(std::shared_ptr<PipelineState> state) override;
+
+	virtual void SetShaderDataTexture(const std::string& name, std::shared_ptr<Texture> texture) override;
+	virtual void SetShaderDataImage(const std::string& name, std::shared_ptr<Texture> texture) override;
+	virtual void SetShaderDataInt(const std::string& name, int32_t value) override;
+	virtual void SetShaderDataFloat(const std::string& name, float value) override;
+	virtual void SetShaderDataFloat2(const std::string& name, glm::vec2 vector) override;
+	virtual void SetShaderDataFloat2(const std::string& name, float x, float y) override;
+	virtual void SetShaderDataFloat3(const std::string& name, float x, float y, float z) override;
+	virtual void SetShaderDataFloat3(const std::string& name, glm::vec3 vector) override;
+	virtual void SetShaderDataFloat4(const std::string& name, float r, float g, float b, float a) override;
+	virtual void SetShaderDataFloat4(const std::string& name, glm::vec4 vector) override;
+	virtual void SetShaderDataMat4(const std::string& name, const glm::mat4& matrix) override;
+	virtual void SetShaderDataMat3(const std::string& name, const glm::mat3& matrix) override;
+	virtual void SetShaderDataBool(const std::string& name, bool value) override;
+
+	virtual void SetShaderDataTexture(const char* name, std::shared_ptr<Texture> texture) override;
+	virtual void SetShaderDataImage(const char* name, std::shared_ptr<Texture> texture) override;
+	virtual void SetShaderDataInt(const char* name, int32_t value) override;
+	virtual void SetShaderDataFloat(const char* name, float value) override;
+	virtual void SetShaderDataFloat2(const char* name, glm::vec2 vector) override;
+	virtual void SetShaderDataFloat2(const char* name, float x, float y) override;
+	virtual void SetShaderDataFloat3(const char* name, float x, float y, float z) override;
+	virtual void SetShaderDataFloat3(const char* name, glm::vec3 vector) override;
+	virtual void SetShaderDataFloat4(const char* name, float r, float g, float b, float a) override;
+	virtual void SetShaderDataFloat4(const char* name, glm::vec4 vector) override;
+	virtual void SetShaderDataMat4(const char* name, const glm::mat4& matrix) override;
+	virtual void SetShaderDataMat3(const char* name, const glm::mat3& matrix) override;
+	virtual void SetShaderDataBool(const char* name, bool value) override;
+
+	virtual void SetShaderDataTexture(int32_t location, std::shared_ptr<Texture> texture) override;
+	virtual void SetShaderDataImage(int32_t location, std::shared_ptr<Texture> texture) override;
+	virtual void SetShaderDataInt(int32_t location, int32_t value) override;
+	virtual void SetShaderDataFloat(int32_t location, float value) override;
+	virtual void SetShaderDataFloat2(int32_t location, glm::vec2 vector) override;
+	virtual void SetShaderDataFloat3(int32_t location, glm::vec3 vector) override;
+	virtual void SetShaderDataFloat4(int32_t location, glm::vec4 vector) override;
+	virtual void SetShaderDataMat4(int32_t location, const glm::mat4& matrix) override;
+	virtual void SetShaderDataMat3(int32_t location, const glm::mat3& matrix) override;
+	virtual void SetShaderDataBool(int32_t location, bool value) override;
+
+	virtual void RunComputeShader(uint32_t sizeX, uint32_t sizeY, uint32_t sizeZ) override;
+	virtual void Barier(BarrierType type) override;
+
+	virtual void Draw(DrawMode mode = DrawMode::Triangles) override;
+	virtual void DrawInstanced(uint32_t instancesCount, uint32_t firstInstance = 0, DrawMode mode = DrawMode::Triangles) override;
+
+	virtual void EnableBlending(BlendFactor source, BlendFactor destination) override;
+	virtual void SetBlending(BlendFactor source, BlendFactor destination) override;
+	virtual void DisableBlending() override;
+
+	virtual void EnableDethTest(DepthTestFunction function) override;
+	virtual void SetDethTestFunction(DepthTestFunction function) override;
+	virtual void DisableDethTest() override;
+
+	virtual void EnableFaceCulling() override;
+	virtual void EnableFaceCulling(Face face) override;
+	virtual void SetCullingFace(Face face) override;
+	virtual void DisableFaceCulling() override;
+
+	virtual void ClearDepthTarget() override;
+	virtual void ClearDepthTarget(std::shared_ptr<Texture> target, glm::u32vec3 offset, glm::u32vec3 size) override;
+	virtual void CopyTexture(std::shared_ptr<Texture> source, std::shared_ptr<Texture> destination, glm::u32vec3 offset, glm::u32vec3 size) override;
+	virtual void ClearColorTarget() override;
+	virtual void SetClearColor(float r, float g, float b, float a) override;
+	virtual void SetClearColor(glm::vec4 color) override;
+
+	virtual void BeginUIFrame() override;
+	virtual void EndUIFrame() override;
+
+	virtual void SwapBuffers() override;
+
+	// Nothing reaches the graphics API while recording, statistics come from the context the buffer is replayed on
+	virtual const RenderingStateStatistics& GetStatistics() const override;
+	virtual void ResetStatistics() override;
+
+	// Executes recorded commands in order, buffer stays intact so it can be replayed again
+	void Replay(RenderingContext& context) const;
+
+	// Writes one command per line, objects are written as their table indices, so equal frames produce equal text
+	void Serialize(std::ostream& stream) const;
+
+	// Drops commands and objects, allocated memory is kept for the next recording
+	void Reset();
+
+	uint32_t GetCommandsCount() const;
+	const std::vector<uint8_t>& GetData() const;
+
+protected:
+	static constexpr uint32_t NullObject = UINT32_MAX;
+
+	enum class UniformKey : uint8_t
+	{
+		Location,
+		Name
+	};
+
+	template<typename T>
+	void Write(const T& value)
+	{
+		size_t offset = m_Data.size();
+		m_Data.resize(offset + sizeof(T));
+		std::memcpy(m_Data.data() + offset, &value, sizeof(T));
+	}
+
+	template<typename T>
+	T Read(size_t& offset) const
+	{
+		T value;
+		std::memcpy(&value, m_Data.data() + offset, sizeof(T));
+		offset += sizeof(T);
+		return value;
+	}
+
+	void WriteCommand(RenderCommandType type);
+	void WriteObject(std::shared_ptr<void> object);
+	void WriteString(std::string_view string);
+	void WriteUniformKey(int32_t location);
+	void WriteUniformKey(std::string_view name);
+
+	template<typename T>
+	std::shared_ptr<T> ReadObject(size_t& offset) const
+	{
+		uint32_t index = Read<uint32_t>(offset);
+		return index != NullObject ? std::static_pointer_cast<T>(m_Objects[index]) : nullptr;
+	}
+
+	std::string ReadString(size_t& offset) const;
+
+	// Calls the function with the location or the name the uniform was recorded with, its value follows in the stream
+	template<typename Function>
+	void ReadUniformKey(size_t& offset, Function function) const
+	{
+		if (Read<UniformKey>(offset) == UniformKey::Location)
+		{
+			int32_t location = Read<int32_t>(offset);
+			function(location);
+		}
+		else
+		{
+			function(ReadString(offset));
+		}
+	}
+
+protected:
+	std::vector<uint8_t> m_Data;
+	uint32_t m_CommandsCount = 0;
+
+	// Every object is stored once, commands refer to it by index
+	std::vector<std::shared_ptr<void>> m_Objects;
+	std::unordered_map<const void*, uint32_t> m_ObjectIndices;
+
+	// Shader parameters resolve uniform locations through the current shader
+	std::shared_ptr<Shader> m_Shader;
+
+	RenderingStateStatistics m_Statistics;
+};
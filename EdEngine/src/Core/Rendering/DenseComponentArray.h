@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Packed array of components of one type, every component is stored once and removal moves the last one into its place.
+// Array object never moves, so render graph parameters can reference its items for the lifetime of the renderer
+template<typename T>
+class DenseComponentArray
+{
+public:
+	// Returns false if the component is already stored
+	bool Add(std::shared_ptr<T> component)
+	{
+		auto [it, bIsInserted] = m_Indices.try_emplace(component.get(), (uint32_t)m_Items.size());
+		if (bIsInserted)
+		{
+			m_Items.push_back(std::move(component));
+		}
+
+		return bIsInserted;
+	}
+
+	// Returns false if the component isn't stored
+	bool Remove(const T* component)
+	{
+		auto it = m_Indices.find(component);
+		if (it == m_Indices.end())
+		{
+			return false;
+		}
+
+		uint32_t index = it->second;
+		m_Indices.erase(it);
+
+		if (index + 1 != m_Items.size())
+		{
+			m_Items[index] = std::move(m_Items.back());
+			m_Indices[m_Items[index].get()] = index;
+		}
+
+		m_Items.pop_back();
+
+		return true;
+	}
+
+	bool Contains(const T* component) const
+	{
+		return m_Indices.contains(component);
+	}
+
+	void Clear()
+	{
+		m_Items.clear();
+		m_Indices.clear();
+	}
+
+	uint32_t GetSize() const
+	{
+		return m_Items.size();
+	}
+
+	std::vector<std::shared_ptr<T>>& GetItems()
+	{
+		return m_Items;
+	}
+
+	const std::vector<std::shared_ptr<T>>& GetItems() const
+	{
+		return m_Items;
+	}
+
+private:
+	std::vector<std::shared_ptr<T>> m_Items;
+	std::unordered_map<const T*, uint32_t> m_Indices;
+};
@@ -17,6 +17,11 @@ std::shared_ptr<Texture> Framebuffer::GetDepthAttachment() const
     return m_DepthAttachment;
 }
 
+uint32_t Framebuffer::GetAttachmentsCount() const
+{
+    return m_Attachments.size();
+}
+
 uint32_t Framebuffer::GetID() const
 {
     return m_Id;
@@ -57,6 +57,8 @@ public:
 
     std::shared_ptr<Texture> GetAttachment(int32_t index) const;
     std::shared_ptr<Texture> GetDepthAttachment() const;
+
+    uint32_t GetAttachmentsCount() const;
     
     virtual void SetAttachment(int32_t index, std::shared_ptr<Texture> attachment, FramebufferSizeAdjustmentMode mode) = 0;
     virtual void SetDepthAttachment(std::shared_ptr<Texture> attachment, FramebufferSizeAdjustmentMode mode) = 0;
@@ -0,0 +1,56 @@
+#include "FullscreenPassFusion.h"
+
+bool FullscreenPassFusion::CanFuse(const FullscreenPassDescription& previous, const FullscreenPassDescription& next)
+{
+	if (previous.Feature.empty() || next.Feature.empty())
+	{
+		return false;
+	}
+
+	return !next.Writes.empty() && previous.Writes == next.Writes && !next.bClearsTargets;
+}
+
+std::vector<FusedPassGroup> FullscreenPassFusion::FindGroups(const std::vector<FullscreenPassDescription>& passes)
+{
+	std::vector<FusedPassGroup> groups;
+
+	for (uint32_t first = 0; first < passes.size();)
+	{
+		uint32_t last = first;
+		while (last + 1 < passes.size() && CanFuse(passes[last], passes[last + 1]))
+		{
+			++last;
+		}
+
+		if (last > first)
+		{
+			groups.push_back({ first, last });
+		}
+
+		first = last + 1;
+	}
+
+	return groups;
+}
+
+std::vector<std::string> FullscreenPassFusion::GetDefines(const std::vector<FullscreenPassDescription>& passes, const FusedPassGroup& group)
+{
+	std::vector<std::string> defines;
+	for (uint32_t i = group.First; i <= group.Last; ++i)
+	{
+		defines.push_back(passes[i].Feature);
+	}
+
+	return defines;
+}
+
+std::string FullscreenPassFusion::GetName(const std::vector<FullscreenPassDescription>& passes, const FusedPassGroup& group)
+{
+	std::string name = passes[group.First].Name;
+	for (uint32_t i = group.First + 1; i <= group.Last; ++i)
+	{
+		name += " + " + passes[i].Name;
+	}
+
+	return name;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// What the render graph knows about a scheduled pass when deciding whether it can be merged with its neighbours
+struct FullscreenPassDescription
+{
+	std::string Name;
+
+	// Define enabling the pass in the fused fullscreen uber shader, empty if the pass can't be fused.
+	// Fusable passes draw a single fullscreen quad and read their inputs only at the pixel they write
+	std::string Feature;
+
+	// Sorted handles of render targets the pass draws into
+	std::vector<uint32_t> Writes;
+
+	bool bClearsTargets = false;
+};
+
+// Consecutive passes drawn as one, both indices are inclusive
+struct FusedPassGroup
+{
+	uint32_t First = 0;
+	uint32_t Last = 0;
+};
+
+// Decides which fullscreen passes are merged into one uber shader draw, it doesn't touch the GPU
+class FullscreenPassFusion
+{
+public:
+	// Next pass can be folded into the previous one when both are fusable and draw into the same targets without clearing them in between,
+	// so nothing outside of them can observe the intermediate result and the uber shader computes the whole chain per pixel
+	static bool CanFuse(const FullscreenPassDescription& previous, const FullscreenPassDescription& next);
+
+	// Passes are in execution order, groups of a single pass aren't returned
+	static std::vector<FusedPassGroup> FindGroups(const std::vector<FullscreenPassDescription>& passes);
+
+	// Defines the uber shader is compiled with for the group, in execution order
+	static std::vector<std::string> GetDefines(const std::vector<FullscreenPassDescription>& passes, const FusedPassGroup& group);
+	static std::string GetName(const std::vector<FullscreenPassDescription>& passes, const FusedPassGroup& group);
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Writes GPU timestamps into one of FramesInFlight query sets, a set is read back only when it is reused, so reading never waits for the GPU
+class GPUTimer
+{
+public:
+	static const uint32_t FramesInFlight = 2;
+
+	// Switches to the next query set. Fills timestamps written into it FramesInFlight frames ago in nanoseconds,
+	// returns false if they aren't available yet, they are dropped then
+	virtual bool BeginFrame(std::vector<uint64_t>& timestamps) = 0;
+
+	// Returns index of the timestamp in the current frame
+	virtual uint32_t WriteTimestamp() = 0;
+
+	virtual ~GPUTimer() = default;
+};
@@ -0,0 +1,55 @@
+#include "InstanceBuffer.h"
+#include "RenderQueue.h"
+#include "RenderingContex.h"
+#include "Buffers/StorageBuffer.h"
+#include "Utils/RenderingHelper.h"
+
+void InstanceBuffer::Clear()
+{
+	m_Instances.clear();
+}
+
+uint32_t InstanceBuffer::Add(const DrawCommand& command)
+{
+	InstanceData& instance = m_Instances.emplace_back();
+	instance.ModelMatrix = command.ModelMatrix;
+	instance.PreviousModelMatrix = command.PreviousModelMatrix;
+	instance.NormalMatrix = glm::mat4(command.NormalMatrix);
+	instance.LightmapScaleOffset = command.LightmapScaleOffset;
+
+	return m_Instances.size() - 1;
+}
+
+void InstanceBuffer::Fill(const RenderQueue& queue)
+{
+	Clear();
+
+	for (const DrawPacket& packet : queue.GetPackets())
+	{
+		Add(queue.GetCommand(packet));
+	}
+
+	Upload();
+}
+
+void InstanceBuffer::Upload()
+{
+	if (m_Instances.empty())
+	{
+		return;
+	}
+
+	uint32_t size = m_Instances.size() * sizeof(InstanceData);
+
+	RenderingHelper::UploadStorageBuffer(m_Buffer, m_Instances.data(), size, BufferUsage::DynamicDraw);
+}
+
+void InstanceBuffer::Bind(std::shared_ptr<RenderingContext> context)
+{
+	context->SetStorageBuffer(Binding, m_Buffer);
+}
+
+uint32_t InstanceBuffer::GetSize() const
+{
+	return m_Instances.size();
+}
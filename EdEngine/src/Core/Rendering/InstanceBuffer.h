@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Core/Ed.h"
+#include <glm/mat4x4.hpp>
+
+class StorageBuffer;
+class RenderingContext;
+struct DrawCommand;
+class RenderQueue;
+
+// Layout matches InstanceData in shaders (std430), normal matrix is padded to mat4 to avoid mat3 alignment rules
+struct InstanceData
+{
+	glm::mat4 ModelMatrix;
+	glm::mat4 PreviousModelMatrix;
+	glm::mat4 NormalMatrix;
+	glm::vec4 LightmapScaleOffset;
+};
+
+// Per frame storage of instance transforms, shaders read it by gl_BaseInstance + gl_InstanceID
+class InstanceBuffer
+{
+public:
+	static const uint32_t Binding = 0;
+
+	void Clear();
+
+	uint32_t Add(const DrawCommand& command);
+
+	// Instances are stored in sorted packet order, so packet index is the instance index
+	void Fill(const RenderQueue& queue);
+
+	void Upload();
+	void Bind(std::shared_ptr<RenderingContext> context);
+
+	uint32_t GetSize() const;
+
+protected:
+	std::vector<InstanceData> m_Instances;
+	std::shared_ptr<StorageBuffer> m_Buffer;
+};
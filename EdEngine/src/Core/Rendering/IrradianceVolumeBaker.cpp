@@ -0,0 +1,97 @@
+#include "IrradianceVolumeBaker.h"
+#include "LightBakeScene.h"
+#include "Core/JobSystem.h"
+#include "Core/Assets/IrradianceVolume.h"
+#include "Core/Components/StaticMeshComponent.h"
+#include "Core/Components/LightComponent.h"
+#include "Core/Components/IrradianceVolumeComponent.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+void IrradianceVolumeBaker::CollectScene(const std::vector<std::shared_ptr<Component>>& components, LightBakeScene& scene, std::vector<std::shared_ptr<IrradianceVolumeComponent>>& volumes)
+{
+	for (const std::shared_ptr<Component>& component : components)
+	{
+		switch (component->GetType())
+		{
+		case ComponentType::StaticMesh:
+		{
+			scene.AddMesh(static_cast<const StaticMeshComponent&>(*component));
+		}
+		break;
+		case ComponentType::DirectionalLight:
+		case ComponentType::PointLight:
+		case ComponentType::SpotLight:
+		{
+			const LightComponent& light = static_cast<const LightComponent&>(*component);
+			if (light.IsBaked() && light.GetIntensity() != 0.0f)
+			{
+				scene.AddLight(light);
+			}
+		}
+		break;
+		case ComponentType::IrradianceVolume:
+		{
+			volumes.push_back(std::static_pointer_cast<IrradianceVolumeComponent>(component));
+		}
+		break;
+		}
+	}
+}
+
+std::vector<SHL2> IrradianceVolumeBaker::Bake(const LightBakeScene& scene, const glm::vec3& min, const glm::vec3& max, const glm::u32vec3& count, const IrradianceVolumeBakeSettings& settings, JobSystem& jobs)
+{
+	std::vector<SHL2> probes(count.x * count.y * count.z);
+
+	jobs.ParallelFor(probes.size(), [&](uint32_t index, uint32_t worker)
+	{
+		glm::u32vec3 probe = glm::u32vec3(index % count.x, index / count.x % count.y, index / (count.x * count.y));
+		glm::vec3 position = IrradianceVolume::GetProbePosition(min, max, count, probe);
+
+		BakeRandom random(settings.Seed, index);
+		probes[index] = BakeProbe(scene, position, settings, random);
+	});
+
+	return probes;
+}
+
+SHL2 IrradianceVolumeBaker::BakeProbe(const LightBakeScene& scene, const glm::vec3& position, const IrradianceVolumeBakeSettings& settings, BakeRandom& random)
+{
+	SHL2 probe;
+
+	// Lights are points or parallel rays, so they are added as deltas instead of waiting for random rays to hit them
+	for (const BakeLight& light : scene.GetLights())
+	{
+		glm::vec3 direction;
+		float distance;
+
+		glm::vec3 irradiance = scene.GetLightIrradiance(light, position, direction, distance);
+		if (irradiance == glm::vec3(0.0f) || scene.IsOccluded(position, direction, distance))
+		{
+			continue;
+		}
+
+		probe.AddRadiance(direction, irradiance, 1.0f);
+	}
+
+	if (settings.BouncesCount == 0 || settings.SamplesCount == 0)
+	{
+		return probe;
+	}
+
+	// Every uniform sample stands for the same part of the sphere
+	float weight = 4.0f * glm::pi<float>() / settings.SamplesCount;
+
+	for (uint32_t i = 0; i < settings.SamplesCount; ++i)
+	{
+		float z = 1.0f - 2.0f * random.Next();
+		float phi = 2.0f * glm::pi<float>() * random.Next();
+		float radius = glm::sqrt(glm::max(0.0f, 1.0f - z * z));
+
+		glm::vec3 direction = glm::vec3(radius * glm::cos(phi), radius * glm::sin(phi), z);
+
+		probe.AddRadiance(direction, scene.TraceRadiance(position, direction, settings.BouncesCount, random), weight);
+	}
+
+	return probe;
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Core/Ed.h"
+#include "SphericalHarmonics.h"
+
+class JobSystem;
+class LightBakeScene;
+class Component;
+class IrradianceVolumeComponent;
+class BakeRandom;
+
+struct IrradianceVolumeBakeSettings
+{
+	// Directions traced from every probe, spread uniformly over the sphere
+	uint32_t SamplesCount = 512;
+	// Surfaces light may bounce off before reaching a probe, zero bakes only light coming straight from lights
+	uint32_t BouncesCount = 2;
+	uint32_t Seed = 0;
+};
+
+// Bakes radiance arriving at points of a grid into second order spherical harmonics. Like lightmaps every probe seeds
+// its own random numbers, so probes are the same no matter how many threads bake them
+class IrradianceVolumeBaker
+{
+public:
+	// Static mesh components become occluders, lights marked as baked are added to the scene and volume components are collected
+	static void CollectScene(const std::vector<std::shared_ptr<Component>>& components, LightBakeScene& scene, std::vector<std::shared_ptr<IrradianceVolumeComponent>>& volumes);
+
+	// Probes go along x first, then y, then z, positions are the ones of IrradianceVolume::GetProbePosition
+	static std::vector<SHL2> Bake(const LightBakeScene& scene, const glm::vec3& min, const glm::vec3& max, const glm::u32vec3& count, const IrradianceVolumeBakeSettings& settings, JobSystem& jobs);
+
+	static SHL2 BakeProbe(const LightBakeScene& scene, const glm::vec3& position, const IrradianceVolumeBakeSettings& settings, BakeRandom& random);
+};
\ No newline at end of file
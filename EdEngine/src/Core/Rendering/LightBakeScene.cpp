@@ -0,0 +1,334 @@
+#include "LightBakeScene.h"
+#include "Core/Components/StaticMeshComponent.h"
+#include "Core/Components/DirectionalLightComponent.h"
+#include "Core/Components/PointLightComponent.h"
+#include "Core/Components/SpotLightComponent.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <cmath>
+
+BakeRandom::BakeRandom(uint32_t seed) : m_State(Hash(seed))
+{
+}
+
+BakeRandom::BakeRandom(uint32_t seed, uint32_t index) : m_State(Hash(seed ^ Hash(index)))
+{
+}
+
+float BakeRandom::Next()
+{
+	m_State = Hash(m_State);
+	return (m_State >> 8) * (1.0f / 16777216.0f);
+}
+
+// PCG output permutation, cheap and good enough for sampling
+uint32_t BakeRandom::Hash(uint32_t value)
+{
+	uint32_t state = value * 747796405u + 2891336453u;
+	uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+	return (word >> 22u) ^ word;
+}
+
+uint32_t LightBakeScene::AddTriangles(const std::vector<glm::vec3>& corners, const std::vector<glm::vec3>& normals, const std::vector<glm::vec2>& coordinates, const glm::vec3& albedo)
+{
+	ED_ASSERT(corners.size() % 3 == 0 && normals.size() == corners.size(), "Every corner needs a normal")
+	ED_ASSERT(coordinates.empty() || coordinates.size() == corners.size(), "Every corner needs lightmap coordinates")
+
+	uint32_t first = GetTrianglesCount();
+
+	m_Corners.insert(m_Corners.end(), corners.begin(), corners.end());
+	m_Normals.insert(m_Normals.end(), normals.begin(), normals.end());
+
+	if (coordinates.empty())
+	{
+		m_Coordinates.resize(m_Corners.size(), glm::vec2(0.0f));
+	}
+	else
+	{
+		m_Coordinates.insert(m_Coordinates.end(), coordinates.begin(), coordinates.end());
+	}
+
+	m_Albedos.resize(m_Corners.size() / 3, albedo);
+
+	return first;
+}
+
+uint32_t LightBakeScene::AddMesh(const StaticMeshComponent& component)
+{
+	uint32_t first = GetTrianglesCount();
+
+	std::shared_ptr<StaticMesh> mesh = component.GetStaticMesh();
+	if (!mesh)
+	{
+		return first;
+	}
+
+	glm::mat4 world = component.GetWorldMatrix();
+	glm::mat3 normalMatrix = glm::mat3(component.GetNormalMatrix());
+
+	std::vector<glm::vec3> corners;
+	std::vector<glm::vec3> normals;
+	std::vector<glm::vec2> coordinates;
+
+	for (const std::shared_ptr<StaticSubmesh>& submesh : mesh->GetSubmeshes())
+	{
+		const std::vector<Vertex>& vertices = submesh->GetVertices();
+		const std::vector<int32_t>& indices = submesh->GetIndices();
+
+		corners.clear();
+		normals.clear();
+		coordinates.clear();
+
+		for (int32_t index : indices)
+		{
+			const Vertex& vertex = vertices[index];
+
+			corners.push_back(glm::vec3(world * glm::vec4(vertex.Position, 1.0f)));
+			normals.push_back(glm::normalize(normalMatrix * vertex.Normal));
+			coordinates.push_back(vertex.LightmapCoordinates);
+		}
+
+		std::shared_ptr<Material> material = submesh->GetMaterial();
+		AddTriangles(corners, normals, coordinates, material ? material->GetBaseColor() : glm::vec3(1.0f));
+	}
+
+	return first;
+}
+
+void LightBakeScene::AddLight(const BakeLight& light)
+{
+	m_Lights.push_back(light);
+}
+
+void LightBakeScene::AddLight(const LightComponent& light)
+{
+	BakeLight& bakeLight = m_Lights.emplace_back();
+	bakeLight.Position = light.GetPosition();
+	bakeLight.Radiance = light.GetColor() * light.GetIntensity();
+
+	switch (light.GetType())
+	{
+	case ComponentType::DirectionalLight:
+	{
+		bakeLight.Type = BakeLightType::Directional;
+		bakeLight.Direction = static_cast<const DirectionalLightComponent&>(light).GetDirection();
+	}
+	break;
+	case ComponentType::PointLight:
+	{
+		bakeLight.Type = BakeLightType::Point;
+		bakeLight.Range = static_cast<const PointLightComponent&>(light).GetRadius();
+	}
+	break;
+	case ComponentType::SpotLight:
+	{
+		const SpotLightComponent& spotLight = static_cast<const SpotLightComponent&>(light);
+
+		// Same direction the spot light mesh points along
+		bakeLight.Type = BakeLightType::Spot;
+		bakeLight.Direction = glm::normalize(light.GetWorldTransform().GetRotation() * glm::vec3(0.0f, -1.0f, 0.0f));
+		bakeLight.Range = spotLight.GetMaxDistance();
+		bakeLight.InnerAngleCos = glm::cos(spotLight.GetInnerAngle());
+		bakeLight.OuterAngleCos = glm::cos(spotLight.GetOuterAngle());
+	}
+	break;
+	default:
+		ED_ASSERT(0, "Unsupported light type")
+	}
+}
+
+void LightBakeScene::Build()
+{
+	m_BVH.Build(m_Corners);
+
+	// Offset grows with the scene, floats lose precision far from the origin
+	if (!m_Corners.empty())
+	{
+		glm::vec3 extent = glm::max(glm::abs(m_BVH.GetBoundsMin()), glm::abs(m_BVH.GetBoundsMax()));
+		m_RayOffset = glm::max(1e-4f, 1e-5f * glm::max(glm::max(extent.x, extent.y), extent.z));
+	}
+}
+
+glm::vec3 LightBakeScene::GetLightIrradiance(const BakeLight& light, const glm::vec3& position, glm::vec3& direction, float& distance) const
+{
+	distance = FLT_MAX;
+
+	if (light.Type == BakeLightType::Directional)
+	{
+		direction = -light.Direction;
+		return light.Radiance;
+	}
+
+	glm::vec3 lightVector = light.Position - position;
+	float distanceSqr = glm::dot(lightVector, lightVector);
+
+	if (distanceSqr >= light.Range * light.Range || distanceSqr == 0.0f)
+	{
+		return glm::vec3(0.0f);
+	}
+
+	distance = glm::sqrt(distanceSqr);
+	direction = lightVector / distance;
+
+	if (light.Type == BakeLightType::Point)
+	{
+		float A = distanceSqr / (light.Range * light.Range);
+		float B = glm::clamp(1.0f - A * A, 0.0f, 1.0f);
+
+		return light.Radiance * (B * B / (distanceSqr + 1.0f));
+	}
+
+	float angle = glm::dot(-direction, light.Direction);
+	if (light.OuterAngleCos > angle)
+	{
+		return glm::vec3(0.0f);
+	}
+
+	float a = 1.0f / (light.InnerAngleCos - light.OuterAngleCos);
+	float b = -light.OuterAngleCos * a;
+	float softness = glm::clamp((a * angle + b) * (a * angle + b), 0.0f, 1.0f);
+
+	return light.Radiance * (softness / (distanceSqr + 1.0f));
+}
+
+bool LightBakeScene::IsOccluded(const glm::vec3& origin, const glm::vec3& direction, float distance) const
+{
+	return m_BVH.IsOccluded(origin, direction, distance - m_RayOffset);
+}
+
+glm::vec3 LightBakeScene::GetDirectIrradiance(const glm::vec3& position, const glm::vec3& normal) const
+{
+	glm::vec3 irradiance = glm::vec3(0.0f);
+	glm::vec3 origin = position + normal * m_RayOffset;
+
+	for (const BakeLight& light : m_Lights)
+	{
+		glm::vec3 direction;
+		float distance;
+
+		glm::vec3 lightIrradiance = GetLightIrradiance(light, position, direction, distance);
+
+		float NdotL = glm::dot(normal, direction);
+		if (NdotL <= 0.0f || lightIrradiance == glm::vec3(0.0f))
+		{
+			continue;
+		}
+
+		if (IsOccluded(origin, direction, distance))
+		{
+			continue;
+		}
+
+		irradiance += lightIrradiance * NdotL;
+	}
+
+	return irradiance;
+}
+
+glm::vec3 LightBakeScene::GetIndirectIrradiance(const glm::vec3& position, const glm::vec3& normal, uint32_t samples, uint32_t bounces, BakeRandom& random) const
+{
+	if (samples == 0)
+	{
+		return glm::vec3(0.0f);
+	}
+
+	glm::vec3 origin = position + normal * m_RayOffset;
+	glm::vec3 radiance = glm::vec3(0.0f);
+
+	for (uint32_t i = 0; i < samples; ++i)
+	{
+		radiance += TraceRadiance(origin, SampleCosineHemisphere(normal, random), bounces, random);
+	}
+
+	// Cosine weighted samples cancel the cosine of the integral, pi is what is left of it
+	return glm::pi<float>() * radiance / float(samples);
+}
+
+glm::vec3 LightBakeScene::TraceRadiance(const glm::vec3& origin, const glm::vec3& direction, uint32_t bounces, BakeRandom& random) const
+{
+	glm::vec3 radiance = glm::vec3(0.0f);
+	glm::vec3 throughput = glm::vec3(1.0f);
+
+	glm::vec3 rayOrigin = origin;
+	glm::vec3 rayDirection = direction;
+
+	for (uint32_t bounce = 0; bounce < bounces; ++bounce)
+	{
+		TriangleHit hit;
+		if (!m_BVH.Intersect(rayOrigin, rayDirection, FLT_MAX, hit))
+		{
+			break;
+		}
+
+		float w = 1.0f - hit.Barycentrics.x - hit.Barycentrics.y;
+
+		const glm::vec3* corners = GetCorners(hit.Triangle);
+		const glm::vec3* normals = GetNormals(hit.Triangle);
+
+		glm::vec3 position = corners[0] * w + corners[1] * hit.Barycentrics.x + corners[2] * hit.Barycentrics.y;
+		glm::vec3 normal = glm::normalize(normals[0] * w + normals[1] * hit.Barycentrics.x + normals[2] * hit.Barycentrics.y);
+
+		// Back faces are insides of closed meshes, light would leak through walls otherwise
+		if (glm::dot(normal, rayDirection) >= 0.0f)
+		{
+			break;
+		}
+
+		throughput *= m_Albedos[hit.Triangle];
+
+		// Lambertian surface sends albedo / pi of its irradiance in every direction
+		radiance += throughput * GetDirectIrradiance(position, normal) / glm::pi<float>();
+
+		rayOrigin = position + normal * m_RayOffset;
+		rayDirection = SampleCosineHemisphere(normal, random);
+	}
+
+	return radiance;
+}
+
+glm::vec3 LightBakeScene::SampleCosineHemisphere(const glm::vec3& normal, BakeRandom& random)
+{
+	float phi = 2.0f * glm::pi<float>() * random.Next();
+	float radiusSqr = random.Next();
+	float radius = glm::sqrt(radiusSqr);
+
+	// Orthonormal basis without branches on the normal direction, Duff et al.
+	float sign = std::copysign(1.0f, normal.z);
+	float a = -1.0f / (sign + normal.z);
+	float b = normal.x * normal.y * a;
+
+	glm::vec3 tangent = glm::vec3(1.0f + sign * normal.x * normal.x * a, sign * b, -sign * normal.x);
+	glm::vec3 bitangent = glm::vec3(b, sign + normal.y * normal.y * a, -normal.y);
+
+	return glm::normalize(tangent * (radius * glm::cos(phi)) + bitangent * (radius * glm::sin(phi)) + normal * glm::sqrt(1.0f - radiusSqr));
+}
+
+uint32_t LightBakeScene::GetTrianglesCount() const
+{
+	return m_Corners.size() / 3;
+}
+
+const glm::vec3* LightBakeScene::GetCorners(uint32_t triangle) const
+{
+	return &m_Corners[3 * triangle];
+}
+
+const glm::vec3* LightBakeScene::GetNormals(uint32_t triangle) const
+{
+	return &m_Normals[3 * triangle];
+}
+
+const glm::vec2* LightBakeScene::GetCoordinates(uint32_t triangle) const
+{
+	return &m_Coordinates[3 * triangle];
+}
+
+const std::vector<BakeLight>& LightBakeScene::GetLights() const
+{
+	return m_Lights;
+}
+
+float LightBakeScene::GetRayOffset() const
+{
+	return m_RayOffset;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Core/Ed.h"
+#include "TriangleBVH.h"
+
+class StaticMeshComponent;
+class LightComponent;
+
+enum class BakeLightType : uint8_t
+{
+	Directional,
+	Point,
+	Spot
+};
+
+// Radiance is color times intensity, falloffs of every type are the same as in the light shaders
+struct BakeLight
+{
+	BakeLightType Type = BakeLightType::Point;
+
+	glm::vec3 Position = glm::vec3(0.0f);
+	// Direction light travels along, directional and spot lights only
+	glm::vec3 Direction = glm::vec3(0.0f, -1.0f, 0.0f);
+	glm::vec3 Radiance = glm::vec3(0.0f);
+
+	float Range = 0.0f;
+	float InnerAngleCos = 0.0f;
+	float OuterAngleCos = 0.0f;
+};
+
+// Hash based generator, every texel or probe seeds its own, so results don't depend on the order work is picked up by threads
+class BakeRandom
+{
+public:
+	explicit BakeRandom(uint32_t seed);
+	BakeRandom(uint32_t seed, uint32_t index);
+
+	// Uniform in [0, 1)
+	float Next();
+
+	static uint32_t Hash(uint32_t value);
+
+private:
+	uint32_t m_State = 0;
+};
+
+// World space copy of static geometry and lights baked on the CPU. Surfaces are lambertian with the base color of their materials,
+// nothing is emitted by the sky. Filled on one thread, then traced from any number of threads
+class LightBakeScene
+{
+public:
+	// Three corners per triangle with a normal per corner, lightmap coordinates may be empty. Returns index of the first triangle
+	uint32_t AddTriangles(const std::vector<glm::vec3>& corners, const std::vector<glm::vec3>& normals, const std::vector<glm::vec2>& coordinates, const glm::vec3& albedo);
+	// Submeshes transformed into world space, nothing is added for components without mesh data
+	uint32_t AddMesh(const StaticMeshComponent& component);
+
+	void AddLight(const BakeLight& light);
+	void AddLight(const LightComponent& light);
+
+	// Called once everything is added and before anything is traced
+	void Build();
+
+	// Irradiance of the light on a surface at the position facing it, occlusion is not tested. Zero outside range and cone of the light
+	glm::vec3 GetLightIrradiance(const BakeLight& light, const glm::vec3& position, glm::vec3& direction, float& distance) const;
+	// Whether anything lies between the origin and a point distance away along the direction
+	bool IsOccluded(const glm::vec3& origin, const glm::vec3& direction, float distance) const;
+
+	// Irradiance of lights reaching the point unoccluded
+	glm::vec3 GetDirectIrradiance(const glm::vec3& position, const glm::vec3& normal) const;
+	// Irradiance of light bounced off the scene, cosine weighted samples of the hemisphere around the normal
+	glm::vec3 GetIndirectIrradiance(const glm::vec3& position, const glm::vec3& normal, uint32_t samples, uint32_t bounces, BakeRandom& random) const;
+
+	// Radiance arriving at the origin from the direction after bouncing off at most bounces surfaces, zero bounces is always black
+	glm::vec3 TraceRadiance(const glm::vec3& origin, const glm::vec3& direction, uint32_t bounces, BakeRandom& random) const;
+
+	static glm::vec3 SampleCosineHemisphere(const glm::vec3& normal, BakeRandom& random);
+
+	uint32_t GetTrianglesCount() const;
+	const glm::vec3* GetCorners(uint32_t triangle) const;
+	const glm::vec3* GetNormals(uint32_t triangle) const;
+	const glm::vec2* GetCoordinates(uint32_t triangle) const;
+
+	const std::vector<BakeLight>& GetLights() const;
+
+	// Rays leave surfaces this far along their normals, so they don't hit the surface they start on
+	float GetRayOffset() const;
+
+private:
+	std::vector<glm::vec3> m_Corners;
+	std::vector<glm::vec3> m_Normals;
+	std::vector<glm::vec2> m_Coordinates;
+	std::vector<glm::vec3> m_Albedos;
+
+	std::vector<BakeLight> m_Lights;
+
+	TriangleBVH m_BVH;
+	float m_RayOffset = 1e-4f;
+};
\ No newline at end of file
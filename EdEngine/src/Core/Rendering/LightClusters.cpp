@@ -0,0 +1,292 @@
+#include "LightClusters.h"
+#include "Core/JobSystem.h"
+#include <glm/glm.hpp>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define ED_LIGHT_CLUSTERS_SIMD
+#endif
+
+LightClusters::LightClusters()
+{
+	m_SliceData.resize(Slices);
+	m_Clusters.resize(ClustersCount);
+
+	SetView(glm::mat4(1.0f), glm::radians(90.0f), 1.0f, 1.0f, 2.0f);
+}
+
+void LightClusters::SetView(const glm::mat4& view, float fov, float aspect, float near, float far)
+{
+	m_View = view;
+	m_Near = near;
+	m_Far = far;
+
+	m_SliceScale = Slices / glm::log(far / near);
+	m_SliceBias = -glm::log(near) * m_SliceScale;
+
+	float tanHalfFov = glm::tan(fov / 2.0f);
+
+	for (uint32_t x = 0; x < TilesX; ++x)
+	{
+		m_TileMinX[x] = (2.0f * x / TilesX - 1.0f) * tanHalfFov * aspect;
+		m_TileMaxX[x] = (2.0f * (x + 1) / TilesX - 1.0f) * tanHalfFov * aspect;
+	}
+
+	for (uint32_t y = 0; y < TilesY; ++y)
+	{
+		m_TileMinY[y] = (2.0f * y / TilesY - 1.0f) * tanHalfFov;
+		m_TileMaxY[y] = (2.0f * (y + 1) / TilesY - 1.0f) * tanHalfFov;
+	}
+}
+
+void LightClusters::Assign(const std::vector<ClusterLight>& lights, JobSystem& jobs)
+{
+	m_Lights.resize(lights.size());
+	m_Spheres.resize(lights.size());
+
+	for (uint32_t i = 0; i < lights.size(); ++i)
+	{
+		const ClusterLight& light = lights[i];
+
+		ViewLight& viewLight = m_Lights[i];
+		viewLight.bIsSpot = light.Type == ClusterLightType::Spot;
+		viewLight.Position = glm::vec3(m_View * glm::vec4(light.Position, 1.0f));
+		viewLight.Range = light.Range;
+
+		if (viewLight.bIsSpot)
+		{
+			// Cone test doesn't work for cones wider than a half space
+			float angle = glm::min(light.OuterAngle, glm::radians(89.0f));
+
+			viewLight.Direction = glm::normalize(glm::vec3(m_View * glm::vec4(light.Direction, 0.0f)));
+			viewLight.AngleCos = glm::cos(angle);
+			viewLight.AngleSin = glm::sin(angle);
+
+			// Tightest sphere around the cone, wide cones are bounded by their base and narrow ones by a sphere through apex and base
+			if (viewLight.AngleCos < viewLight.AngleSin)
+			{
+				m_Spheres[i] = glm::vec4(viewLight.Position + viewLight.Direction * (light.Range * viewLight.AngleCos), light.Range * viewLight.AngleSin);
+			}
+			else
+			{
+				float radius = light.Range / (2.0f * viewLight.AngleCos);
+				m_Spheres[i] = glm::vec4(viewLight.Position + viewLight.Direction * radius, radius);
+			}
+		}
+		else
+		{
+			m_Spheres[i] = glm::vec4(viewLight.Position, light.Range);
+		}
+	}
+
+	jobs.ParallelFor(Slices, [this](uint32_t slice, uint32_t worker)
+	{
+		AssignSlice(slice);
+	});
+
+	// Slices have offsets relative to their own indices, they are moved into one array in cluster order
+	uint32_t count = 0;
+	for (uint32_t slice = 0; slice < Slices; ++slice)
+	{
+		count += m_SliceData[slice].Indices.size();
+	}
+
+	m_LightIndices.resize(count);
+
+	uint32_t offset = 0;
+	for (uint32_t slice = 0; slice < Slices; ++slice)
+	{
+		const std::vector<uint32_t>& indices = m_SliceData[slice].Indices;
+		if (!indices.empty())
+		{
+			std::memcpy(m_LightIndices.data() + offset, indices.data(), indices.size() * sizeof(uint32_t));
+		}
+
+		for (uint32_t i = 0; i < TilesX * TilesY; ++i)
+		{
+			m_Clusters[slice * TilesX * TilesY + i].Offset += offset;
+		}
+
+		offset += indices.size();
+	}
+}
+
+uint32_t LightClusters::GetClusterIndex(uint32_t x, uint32_t y, uint32_t slice)
+{
+	return (slice * TilesY + y) * TilesX + x;
+}
+
+uint32_t LightClusters::GetSlice(float depth) const
+{
+	float slice = glm::log(depth) * m_SliceScale + m_SliceBias;
+	return (uint32_t)glm::clamp(slice, 0.0f, Slices - 1.0f);
+}
+
+float LightClusters::GetSliceScale() const
+{
+	return m_SliceScale;
+}
+
+float LightClusters::GetSliceBias() const
+{
+	return m_SliceBias;
+}
+
+float LightClusters::GetSliceDepth(uint32_t slice) const
+{
+	return m_Near * glm::pow(m_Far / m_Near, (float)slice / Slices);
+}
+
+const std::vector<LightCluster>& LightClusters::GetClusters() const
+{
+	return m_Clusters;
+}
+
+const std::vector<uint32_t>& LightClusters::GetLightIndices() const
+{
+	return m_LightIndices;
+}
+
+void LightClusters::AssignSlice(uint32_t slice)
+{
+	SliceData& data = m_SliceData[slice];
+
+	data.Candidates.clear();
+	data.X.clear();
+	data.Y.clear();
+	data.Z.clear();
+	data.Radius.clear();
+	data.Indices.clear();
+
+	// View space looks down negative z
+	float nearDepth = GetSliceDepth(slice);
+	float farDepth = GetSliceDepth(slice + 1);
+
+	for (uint32_t i = 0; i < m_Spheres.size(); ++i)
+	{
+		const glm::vec4& sphere = m_Spheres[i];
+		if (-sphere.z + sphere.w >= nearDepth && -sphere.z - sphere.w <= farDepth)
+		{
+			data.Candidates.push_back(i);
+			data.X.push_back(sphere.x);
+			data.Y.push_back(sphere.y);
+			data.Z.push_back(sphere.z);
+			data.Radius.push_back(sphere.w);
+		}
+	}
+
+	uint32_t candidatesCount = data.Candidates.size();
+
+	// Padded to whole groups of four, padding lanes are masked out
+	while (data.X.size() % 4 != 0)
+	{
+		data.X.push_back(0.0f);
+		data.Y.push_back(0.0f);
+		data.Z.push_back(0.0f);
+		data.Radius.push_back(0.0f);
+	}
+
+	float minZ = -farDepth;
+	float maxZ = -nearDepth;
+
+	for (uint32_t y = 0; y < TilesY; ++y)
+	{
+		float minY = glm::min(m_TileMinY[y] * nearDepth, m_TileMinY[y] * farDepth);
+		float maxY = glm::max(m_TileMaxY[y] * nearDepth, m_TileMaxY[y] * farDepth);
+
+		for (uint32_t x = 0; x < TilesX; ++x)
+		{
+			float minX = glm::min(m_TileMinX[x] * nearDepth, m_TileMinX[x] * farDepth);
+			float maxX = glm::max(m_TileMaxX[x] * nearDepth, m_TileMaxX[x] * farDepth);
+
+			// Cone tests use the sphere around the froxel box
+			glm::vec3 center = glm::vec3(minX + maxX, minY + maxY, minZ + maxZ) / 2.0f;
+			float radius = glm::length(glm::vec3(maxX - minX, maxY - minY, maxZ - minZ)) / 2.0f;
+
+			glm::vec3 boxMin = glm::vec3(minX, minY, minZ);
+			glm::vec3 boxMax = glm::vec3(maxX, maxY, maxZ);
+
+			LightCluster& cluster = m_Clusters[GetClusterIndex(x, y, slice)];
+			cluster.Offset = data.Indices.size();
+
+			for (uint32_t i = 0; i < candidatesCount; i += 4)
+			{
+				uint32_t mask = GetOverlapMask(data.X.data() + i, data.Y.data() + i, data.Z.data() + i, data.Radius.data() + i, boxMin, boxMax);
+
+				uint32_t lanes = glm::min(candidatesCount - i, 4u);
+				mask &= (1u << lanes) - 1;
+
+				for (uint32_t lane = 0; lane < lanes; ++lane)
+				{
+					if (mask & (1u << lane))
+					{
+						uint32_t index = data.Candidates[i + lane];
+						if (!m_Lights[index].bIsSpot || IsInsideCone(m_Lights[index], center, radius))
+						{
+							data.Indices.push_back(index);
+						}
+					}
+				}
+			}
+
+			cluster.Count = data.Indices.size() - cluster.Offset;
+		}
+	}
+}
+
+uint32_t LightClusters::GetOverlapMask(const float* x, const float* y, const float* z, const float* radius, const glm::vec3& boxMin, const glm::vec3& boxMax)
+{
+#ifdef ED_LIGHT_CLUSTERS_SIMD
+	// Squared distance from four sphere centers to the box at once
+	const __m128 zero = _mm_setzero_ps();
+
+	__m128 sphereX = _mm_loadu_ps(x);
+	__m128 sphereY = _mm_loadu_ps(y);
+	__m128 sphereZ = _mm_loadu_ps(z);
+	__m128 sphereRadius = _mm_loadu_ps(radius);
+
+	__m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(boxMin.x), sphereX), _mm_sub_ps(sphereX, _mm_set1_ps(boxMax.x))), zero);
+	__m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(boxMin.y), sphereY), _mm_sub_ps(sphereY, _mm_set1_ps(boxMax.y))), zero);
+	__m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(boxMin.z), sphereZ), _mm_sub_ps(sphereZ, _mm_set1_ps(boxMax.z))), zero);
+
+	__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+	return _mm_movemask_ps(_mm_cmple_ps(distance, _mm_mul_ps(sphereRadius, sphereRadius)));
+#else
+	return GetOverlapMaskScalar(x, y, z, radius, boxMin, boxMax);
+#endif
+}
+
+uint32_t LightClusters::GetOverlapMaskScalar(const float* x, const float* y, const float* z, const float* radius, const glm::vec3& boxMin, const glm::vec3& boxMax)
+{
+	uint32_t mask = 0;
+
+	for (uint32_t lane = 0; lane < 4; ++lane)
+	{
+		float dx = glm::max(glm::max(boxMin.x - x[lane], x[lane] - boxMax.x), 0.0f);
+		float dy = glm::max(glm::max(boxMin.y - y[lane], y[lane] - boxMax.y), 0.0f);
+		float dz = glm::max(glm::max(boxMin.z - z[lane], z[lane] - boxMax.z), 0.0f);
+
+		if (dx * dx + dy * dy + dz * dz <= radius[lane] * radius[lane])
+		{
+			mask |= 1u << lane;
+		}
+	}
+
+	return mask;
+}
+
+bool LightClusters::IsInsideCone(const ViewLight& light, const glm::vec3& center, float radius) const
+{
+	// Distance from the sphere center to the cone surface, split along and across the cone axis
+	glm::vec3 offset = center - light.Position;
+	float offsetLengthSqr = glm::dot(offset, offset);
+	float axisDistance = glm::dot(offset, light.Direction);
+	float closestDistance = light.AngleCos * glm::sqrt(glm::max(offsetLengthSqr - axisDistance * axisDistance, 0.0f)) - axisDistance * light.AngleSin;
+
+	bool bIsOutsideAngle = closestDistance > radius;
+	bool bIsInFront = axisDistance > radius + light.Range;
+	bool bIsBehind = axisDistance < -radius;
+
+	return !(bIsOutsideAngle || bIsInFront || bIsBehind);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Core/Ed.h"
+
+class JobSystem;
+
+enum class ClusterLightType : uint8_t
+{
+	Point,
+	Spot
+};
+
+// World space bounds of a light, point lights are spheres and spot lights are cones cut by the sphere of their range
+struct ClusterLight
+{
+	ClusterLightType Type = ClusterLightType::Point;
+
+	glm::vec3 Position = glm::vec3(0.0f);
+	float Range = 0.0f;
+
+	// Spot lights only, outer angle is in radians
+	glm::vec3 Direction = glm::vec3(0.0f, -1.0f, 0.0f);
+	float OuterAngle = 0.0f;
+};
+
+// Range of light indices belonging to a cluster, layout matches uvec2 of the clusters buffer in shaders
+struct LightCluster
+{
+	uint32_t Offset = 0;
+	uint32_t Count = 0;
+};
+
+// View frustum split into froxels, screen space tiles times depth slices that grow exponentially with distance.
+// Lights are assigned to every froxel their bounds overlap, slices don't depend on each other so they are assigned in parallel
+class LightClusters
+{
+public:
+	static const uint32_t TilesX = 16;
+	static const uint32_t TilesY = 9;
+	static const uint32_t Slices = 24;
+	static const uint32_t ClustersCount = TilesX * TilesY * Slices;
+
+	LightClusters();
+
+	// Perspective view the froxels are built for, fov is vertical and in radians
+	void SetView(const glm::mat4& view, float fov, float aspect, float near, float far);
+
+	// Light indices are indices into lights
+	void Assign(const std::vector<ClusterLight>& lights, JobSystem& jobs);
+
+	static uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t slice);
+
+	// Slice of a positive view space depth is log(depth) * scale + bias, shaders get the same values
+	uint32_t GetSlice(float depth) const;
+	float GetSliceScale() const;
+	float GetSliceBias() const;
+	float GetSliceDepth(uint32_t slice) const;
+
+	// Bit per sphere of the four starting at the pointers that overlaps the box, the scalar version is the fallback without SIMD
+	static uint32_t GetOverlapMask(const float* x, const float* y, const float* z, const float* radius, const glm::vec3& boxMin, const glm::vec3& boxMax);
+	static uint32_t GetOverlapMaskScalar(const float* x, const float* y, const float* z, const float* radius, const glm::vec3& boxMin, const glm::vec3& boxMax);
+
+	const std::vector<LightCluster>& GetClusters() const;
+	// Indices of all clusters one after another, in cluster order
+	const std::vector<uint32_t>& GetLightIndices() const;
+
+private:
+	struct ViewLight
+	{
+		bool bIsSpot;
+		glm::vec3 Position;
+		glm::vec3 Direction;
+		float Range;
+		float AngleCos;
+		float AngleSin;
+	};
+
+	// Scratch memory and results of a slice, only the job assigning the slice touches it
+	struct SliceData
+	{
+		std::vector<uint32_t> Candidates;
+		std::vector<float> X;
+		std::vector<float> Y;
+		std::vector<float> Z;
+		std::vector<float> Radius;
+
+		std::vector<uint32_t> Indices;
+	};
+
+	void AssignSlice(uint32_t slice);
+	bool IsInsideCone(const ViewLight& light, const glm::vec3& center, float radius) const;
+
+private:
+	glm::mat4 m_View = glm::mat4(1.0f);
+	float m_Near = 1.0f;
+	float m_Far = 2.0f;
+	float m_SliceScale = 0.0f;
+	float m_SliceBias = 0.0f;
+
+	// Tile bounds on the plane one unit in front of the camera, froxel bounds are them scaled by depth
+	float m_TileMinX[TilesX];
+	float m_TileMaxX[TilesX];
+	float m_TileMinY[TilesY];
+	float m_TileMaxY[TilesY];
+
+	std::vector<ViewLight> m_Lights;
+	// View space bounding spheres of lights
+	std::vector<glm::vec4> m_Spheres;
+
+	std::vector<SliceData> m_SliceData;
+
+	std::vector<LightCluster> m_Clusters;
+	std::vector<uint32_t> m_LightIndices;
+};
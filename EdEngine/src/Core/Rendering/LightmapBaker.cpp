@@ -0,0 +1,320 @@
+#include "LightmapBaker.h"
+#include "LightBakeScene.h"
+#include "LightmapUnwrap.h"
+#include "Core/JobSystem.h"
+#include "Core/Components/StaticMeshComponent.h"
+#include "Core/Components/LightComponent.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+
+static uint32_t RoundUpToPowerOfTwo(uint32_t value)
+{
+	uint32_t result = 1;
+	while (result < value)
+	{
+		result <<= 1;
+	}
+
+	return result;
+}
+
+static float Cross(const glm::vec2& first, const glm::vec2& second)
+{
+	return first.x * second.y - first.y * second.x;
+}
+
+void LightmapBaker::CollectScene(const std::vector<std::shared_ptr<Component>>& components, LightBakeScene& scene,
+	std::vector<LightmapBakeInstance>& instances, std::vector<std::shared_ptr<StaticMeshComponent>>& instanceComponents)
+{
+	for (const std::shared_ptr<Component>& component : components)
+	{
+		switch (component->GetType())
+		{
+		case ComponentType::StaticMesh:
+		{
+			std::shared_ptr<StaticMeshComponent> meshComponent = std::static_pointer_cast<StaticMeshComponent>(component);
+
+			std::shared_ptr<StaticMesh> mesh = meshComponent->GetStaticMesh();
+			if (!mesh)
+			{
+				break;
+			}
+
+			// Meshes whose charts don't fit still cast shadows and bounce light
+			if (!mesh->HasLightmapCoordinates() && !mesh->GenerateLightmapCoordinates(DefaultResolution))
+			{
+				ED_LOG(Renderer, warn, "Cannot fit lightmap charts of {} into {} texels", mesh->GetName(), DefaultResolution)
+
+				scene.AddMesh(*meshComponent);
+				break;
+			}
+
+			LightmapBakeInstance& instance = instances.emplace_back();
+			instance.FirstTriangle = scene.AddMesh(*meshComponent);
+			instance.TrianglesCount = scene.GetTrianglesCount() - instance.FirstTriangle;
+			instance.Resolution = mesh->GetLightmapResolution();
+
+			instanceComponents.push_back(meshComponent);
+		}
+		break;
+		case ComponentType::DirectionalLight:
+		case ComponentType::PointLight:
+		case ComponentType::SpotLight:
+		{
+			const LightComponent& light = static_cast<const LightComponent&>(*component);
+			if (light.IsBaked() && light.GetIntensity() != 0.0f)
+			{
+				scene.AddLight(light);
+			}
+		}
+		break;
+		}
+	}
+}
+
+bool LightmapBaker::Bake(const LightBakeScene& scene, std::vector<LightmapBakeInstance>& instances, const LightmapBakeSettings& settings, JobSystem& jobs)
+{
+	m_SurfaceTexels.clear();
+
+	if (!AllocateRegions(instances, settings.MaxAtlasSize))
+	{
+		m_Size = 0;
+		m_Coverage.clear();
+		m_Texels.clear();
+
+		return false;
+	}
+
+	m_Coverage.assign(m_Size * m_Size, 0);
+	m_Texels.assign(m_Size * m_Size, glm::vec3(0.0f));
+
+	for (uint32_t i = 0; i < instances.size(); ++i)
+	{
+		const ShadowAtlasTile& region = m_Regions[i];
+		Rasterize(scene, instances[i], region);
+
+		float scale = float(region.Size) / m_Size;
+		instances[i].ScaleOffset = glm::vec4(scale, scale, float(region.X) / m_Size, float(region.Y) / m_Size);
+	}
+
+	// Texels are traced in small chunks, costs differ a lot between open and occluded parts of a scene
+	const uint32_t texelsPerJob = 64;
+	uint32_t jobsCount = (m_SurfaceTexels.size() + texelsPerJob - 1) / texelsPerJob;
+
+	jobs.ParallelFor(jobsCount, [&](uint32_t index, uint32_t worker)
+	{
+		uint32_t end = glm::min<uint32_t>((index + 1) * texelsPerJob, m_SurfaceTexels.size());
+
+		for (uint32_t i = index * texelsPerJob; i < end; ++i)
+		{
+			const SurfaceTexel& texel = m_SurfaceTexels[i];
+			BakeRandom random(settings.Seed, texel.Index);
+
+			glm::vec3 irradiance = scene.GetDirectIrradiance(texel.Position, texel.Normal);
+			if (settings.BouncesCount > 0)
+			{
+				irradiance += scene.GetIndirectIrradiance(texel.Position, texel.Normal, settings.SamplesCount, settings.BouncesCount, random);
+			}
+
+			m_Texels[texel.Index] = irradiance / glm::pi<float>();
+		}
+	});
+
+	for (const ShadowAtlasTile& region : m_Regions)
+	{
+		Dilate(region);
+	}
+
+	return true;
+}
+
+uint32_t LightmapBaker::GetSize() const
+{
+	return m_Size;
+}
+
+const std::vector<glm::vec3>& LightmapBaker::GetTexels() const
+{
+	return m_Texels;
+}
+
+bool LightmapBaker::AllocateRegions(const std::vector<LightmapBakeInstance>& instances, uint32_t maxSize)
+{
+	m_Regions.assign(instances.size(), ShadowAtlasTile());
+	m_Size = 0;
+
+	if (instances.empty())
+	{
+		return true;
+	}
+
+	uint32_t largest = 1;
+	uint32_t smallest = UINT32_MAX;
+
+	for (const LightmapBakeInstance& instance : instances)
+	{
+		ED_ASSERT(instance.Resolution > 0, "Lightmap resolution cannot be zero")
+
+		largest = glm::max(largest, RoundUpToPowerOfTwo(instance.Resolution));
+		smallest = glm::min(smallest, RoundUpToPowerOfTwo(instance.Resolution));
+	}
+
+	// Biggest regions first, so small ones fill the gaps left by them
+	std::vector<uint32_t> order(instances.size());
+	for (uint32_t i = 0; i < order.size(); ++i)
+	{
+		order[i] = i;
+	}
+
+	std::stable_sort(order.begin(), order.end(), [&instances](uint32_t first, uint32_t second)
+	{
+		return instances[first].Resolution > instances[second].Resolution;
+	});
+
+	// Same quadtree shadow atlases are split with, the atlas doubles until every region fits
+	for (uint32_t size = largest; size <= maxSize; size *= 2)
+	{
+		ShadowAtlasAllocator allocator;
+		allocator.Reset(size, smallest);
+
+		bool bFits = true;
+		for (uint32_t index : order)
+		{
+			if (!allocator.Allocate(instances[index].Resolution, m_Regions[index]))
+			{
+				bFits = false;
+				break;
+			}
+		}
+
+		if (bFits)
+		{
+			m_Size = size;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void LightmapBaker::Rasterize(const LightBakeScene& scene, const LightmapBakeInstance& instance, const ShadowAtlasTile& region)
+{
+	// Triangles overlapping in lightmap space are resolved by the last one drawn
+	std::vector<int32_t> regionTexels(region.Size * region.Size, -1);
+	std::vector<SurfaceTexel> texels;
+
+	for (uint32_t triangle = instance.FirstTriangle; triangle < instance.FirstTriangle + instance.TrianglesCount; ++triangle)
+	{
+		const glm::vec3* corners = scene.GetCorners(triangle);
+		const glm::vec3* normals = scene.GetNormals(triangle);
+		const glm::vec2* coordinates = scene.GetCoordinates(triangle);
+
+		glm::vec2 a = coordinates[0] * float(region.Size);
+		glm::vec2 b = coordinates[1] * float(region.Size);
+		glm::vec2 c = coordinates[2] * float(region.Size);
+
+		float area = Cross(b - a, c - a);
+		if (glm::abs(area) < 1e-12f)
+		{
+			continue;
+		}
+
+		glm::vec2 min = glm::max(glm::floor(glm::min(glm::min(a, b), c)), glm::vec2(0.0f));
+		glm::vec2 max = glm::min(glm::ceil(glm::max(glm::max(a, b), c)), glm::vec2(float(region.Size)));
+
+		for (uint32_t y = uint32_t(min.y); y < uint32_t(max.y); ++y)
+		{
+			for (uint32_t x = uint32_t(min.x); x < uint32_t(max.x); ++x)
+			{
+				glm::vec2 center = glm::vec2(x + 0.5f, y + 0.5f);
+
+				float weightA = Cross(c - b, center - b) / area;
+				float weightB = Cross(a - c, center - c) / area;
+				float weightC = 1.0f - weightA - weightB;
+
+				const float epsilon = -1e-5f;
+				if (weightA < epsilon || weightB < epsilon || weightC < epsilon)
+				{
+					continue;
+				}
+
+				glm::vec3 normal = normals[0] * weightA + normals[1] * weightB + normals[2] * weightC;
+				if (glm::dot(normal, normal) == 0.0f)
+				{
+					continue;
+				}
+
+				int32_t& slot = regionTexels[y * region.Size + x];
+				if (slot < 0)
+				{
+					slot = texels.size();
+					texels.emplace_back();
+				}
+
+				SurfaceTexel& texel = texels[slot];
+				texel.Index = (region.Y + y) * m_Size + region.X + x;
+				texel.Position = corners[0] * weightA + corners[1] * weightB + corners[2] * weightC;
+				texel.Normal = glm::normalize(normal);
+			}
+		}
+	}
+
+	// Texels are kept in atlas order, so neighbouring jobs trace neighbouring texels
+	for (int32_t slot : regionTexels)
+	{
+		if (slot >= 0)
+		{
+			m_SurfaceTexels.push_back(texels[slot]);
+			m_Coverage[texels[slot].Index] = 1;
+		}
+	}
+}
+
+void LightmapBaker::Dilate(const ShadowAtlasTile& region)
+{
+	std::vector<std::pair<uint32_t, glm::vec3>> dilated;
+
+	for (uint32_t pass = 0; pass < LightmapUnwrap::Padding; ++pass)
+	{
+		dilated.clear();
+
+		for (uint32_t y = region.Y; y < region.Y + region.Size; ++y)
+		{
+			for (uint32_t x = region.X; x < region.X + region.Size; ++x)
+			{
+				if (m_Coverage[y * m_Size + x])
+				{
+					continue;
+				}
+
+				glm::vec3 sum = glm::vec3(0.0f);
+				uint32_t count = 0;
+
+				for (uint32_t neighbourY = glm::max(y, region.Y + 1) - 1; neighbourY <= glm::min(y + 1, region.Y + region.Size - 1); ++neighbourY)
+				{
+					for (uint32_t neighbourX = glm::max(x, region.X + 1) - 1; neighbourX <= glm::min(x + 1, region.X + region.Size - 1); ++neighbourX)
+					{
+						uint32_t index = neighbourY * m_Size + neighbourX;
+						if (m_Coverage[index])
+						{
+							sum += m_Texels[index];
+							++count;
+						}
+					}
+				}
+
+				if (count > 0)
+				{
+					dilated.emplace_back(y * m_Size + x, sum / float(count));
+				}
+			}
+		}
+
+		for (const auto& [index, value] : dilated)
+		{
+			m_Texels[index] = value;
+			m_Coverage[index] = 1;
+		}
+	}
+}
\ No newline at end of file
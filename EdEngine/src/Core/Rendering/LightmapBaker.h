@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Core/Ed.h"
+#include "ShadowAtlas.h"
+
+class JobSystem;
+class LightBakeScene;
+class Component;
+class StaticMeshComponent;
+
+struct LightmapBakeSettings
+{
+	// Hemisphere samples per texel for light bounced off the scene
+	uint32_t SamplesCount = 256;
+	// Surfaces light may bounce off before reaching a texel, zero bakes only direct light
+	uint32_t BouncesCount = 2;
+	uint32_t Seed = 0;
+
+	uint32_t MaxAtlasSize = 4096;
+};
+
+// Triangles of the bake scene sharing one region of the atlas, usually a mesh component
+struct LightmapBakeInstance
+{
+	uint32_t FirstTriangle = 0;
+	uint32_t TrianglesCount = 0;
+
+	// Lightmap coordinates of the triangles were generated for this resolution, it is rounded up to a power of two
+	uint32_t Resolution = 64;
+
+	// Filled by baking, atlas coordinates are lightmap coordinates times xy plus zw
+	glm::vec4 ScaleOffset = glm::vec4(0.0f);
+};
+
+// Bakes light of a scene into an atlas with a square region for every instance. Texels hold irradiance divided by pi,
+// so albedo times a texel is the diffuse light leaving the surface. Every texel seeds its own random numbers,
+// so the atlas is the same no matter how many threads bake it
+class LightmapBaker
+{
+public:
+	static const uint32_t DefaultResolution = 64;
+
+	// Static mesh components become occluders and instances, lights marked as baked are added to the scene.
+	// Meshes without lightmap coordinates get them generated for the default resolution
+	static void CollectScene(const std::vector<std::shared_ptr<Component>>& components, LightBakeScene& scene,
+		std::vector<LightmapBakeInstance>& instances, std::vector<std::shared_ptr<StaticMeshComponent>>& instanceComponents);
+
+	// Regions are allocated before anything is traced, false when instances don't fit the max atlas size
+	bool Bake(const LightBakeScene& scene, std::vector<LightmapBakeInstance>& instances, const LightmapBakeSettings& settings, JobSystem& jobs);
+
+	uint32_t GetSize() const;
+	// Rows go from the bottom up, the order textures are uploaded in
+	const std::vector<glm::vec3>& GetTexels() const;
+
+private:
+	// Texel center lying on a triangle of an instance
+	struct SurfaceTexel
+	{
+		uint32_t Index = 0;
+		glm::vec3 Position = glm::vec3(0.0f);
+		glm::vec3 Normal = glm::vec3(0.0f);
+	};
+
+	bool AllocateRegions(const std::vector<LightmapBakeInstance>& instances, uint32_t maxSize);
+	void Rasterize(const LightBakeScene& scene, const LightmapBakeInstance& instance, const ShadowAtlasTile& region);
+	// Texels next to charts get values of their neighbours, so filtering at chart edges doesn't pick up black texels
+	void Dilate(const ShadowAtlasTile& region);
+
+private:
+	uint32_t m_Size = 0;
+
+	std::vector<ShadowAtlasTile> m_Regions;
+	std::vector<SurfaceTexel> m_SurfaceTexels;
+	std::vector<uint8_t> m_Coverage;
+
+	std::vector<glm::vec3> m_Texels;
+};
\ No newline at end of file
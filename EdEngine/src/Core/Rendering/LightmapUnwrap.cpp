@@ -0,0 +1,284 @@
+#include "LightmapUnwrap.h"
+#include "Core/Macros.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <map>
+#include <tuple>
+
+struct UnwrapChart
+{
+	uint32_t Axis = 0;
+
+	// Projected bounds in world units
+	glm::vec2 Min = glm::vec2(FLT_MAX);
+	glm::vec2 Max = glm::vec2(-FLT_MAX);
+
+	// Texel the chart minimum is placed at
+	glm::vec2 Offset = glm::vec2(0.0f);
+};
+
+// Axes are +X, -X, +Y, -Y, +Z and -Z, opposite sides of a thin wall end up in different charts
+static uint32_t GetDominantAxis(const glm::vec3& normal)
+{
+	glm::vec3 absolute = glm::abs(normal);
+	uint32_t axis = absolute.x >= absolute.y && absolute.x >= absolute.z ? 0 : (absolute.y >= absolute.z ? 1 : 2);
+
+	return 2 * axis + (normal[axis] < 0.0f ? 1 : 0);
+}
+
+static glm::vec2 Project(const glm::vec3& position, uint32_t axis)
+{
+	switch (axis / 2)
+	{
+	case 0:  return glm::vec2(position.y, position.z);
+	case 1:  return glm::vec2(position.x, position.z);
+	default: return glm::vec2(position.x, position.y);
+	}
+}
+
+static uint32_t FindRoot(std::vector<uint32_t>& parents, uint32_t index)
+{
+	while (parents[index] != index)
+	{
+		parents[index] = parents[parents[index]];
+		index = parents[index];
+	}
+
+	return index;
+}
+
+static glm::u32vec2 GetChartSize(const UnwrapChart& chart, float scale)
+{
+	glm::vec2 size = glm::ceil((chart.Max - chart.Min) * scale);
+	return glm::u32vec2(glm::max(size, glm::vec2(1.0f))) + 2u * LightmapUnwrap::Padding;
+}
+
+// Charts are placed left to right in rows as high as their first chart
+static bool PackCharts(std::vector<UnwrapChart>& charts, const std::vector<uint32_t>& order, float scale, uint32_t resolution)
+{
+	uint32_t x = 0;
+	uint32_t y = 0;
+	uint32_t rowHeight = 0;
+
+	for (uint32_t index : order)
+	{
+		UnwrapChart& chart = charts[index];
+		glm::u32vec2 size = GetChartSize(chart, scale);
+
+		if (x + size.x > resolution)
+		{
+			x = 0;
+			y += rowHeight;
+			rowHeight = 0;
+		}
+
+		if (size.x > resolution || y + size.y > resolution)
+		{
+			return false;
+		}
+
+		chart.Offset = glm::vec2(x + LightmapUnwrap::Padding, y + LightmapUnwrap::Padding);
+
+		x += size.x;
+		rowHeight = glm::max(rowHeight, size.y);
+	}
+
+	return true;
+}
+
+bool LightmapUnwrap::Unwrap(std::vector<LightmapUnwrapSection>& sections, uint32_t resolution)
+{
+	ED_ASSERT(resolution > 2 * Padding, "Lightmap resolution {} leaves no texels inside padding", resolution)
+
+	// Sections are unwrapped together, so triangle index t of section s is the t-th triangle after all triangles of earlier sections
+	std::vector<uint32_t> firstTriangles;
+	std::vector<uint32_t> axes;
+
+	// Corners at the same position are welded, meshes split vertices along hard edges and texture seams
+	std::map<std::tuple<float, float, float>, uint32_t> weldedPositions;
+	std::vector<std::vector<uint32_t>> weldedIndices(sections.size());
+
+	for (uint32_t sectionIndex = 0; sectionIndex < sections.size(); ++sectionIndex)
+	{
+		const LightmapUnwrapSection& section = sections[sectionIndex];
+		ED_ASSERT(section.Indices.size() % 3 == 0, "Indices count {} isn't a multiple of three", section.Indices.size())
+
+		firstTriangles.push_back(axes.size());
+
+		for (const glm::vec3& position : section.Positions)
+		{
+			auto [iterator, bIsNew] = weldedPositions.try_emplace(std::make_tuple(position.x, position.y, position.z), weldedPositions.size());
+			weldedIndices[sectionIndex].push_back(iterator->second);
+		}
+
+		for (uint32_t i = 0; i < section.Indices.size(); i += 3)
+		{
+			const glm::vec3& first = section.Positions[section.Indices[i]];
+			const glm::vec3& second = section.Positions[section.Indices[i + 1]];
+			const glm::vec3& third = section.Positions[section.Indices[i + 2]];
+
+			axes.push_back(GetDominantAxis(glm::cross(second - first, third - first)));
+		}
+	}
+
+	// Triangles sharing an edge and an axis belong to the same chart
+	std::vector<uint32_t> parents(axes.size());
+	for (uint32_t i = 0; i < parents.size(); ++i)
+	{
+		parents[i] = i;
+	}
+
+	std::map<std::tuple<uint32_t, uint32_t, uint32_t>, uint32_t> edges;
+
+	for (uint32_t sectionIndex = 0; sectionIndex < sections.size(); ++sectionIndex)
+	{
+		const LightmapUnwrapSection& section = sections[sectionIndex];
+		const std::vector<uint32_t>& welded = weldedIndices[sectionIndex];
+
+		for (uint32_t i = 0; i < section.Indices.size(); i += 3)
+		{
+			uint32_t triangle = firstTriangles[sectionIndex] + i / 3;
+
+			for (uint32_t corner = 0; corner < 3; ++corner)
+			{
+				uint32_t first = welded[section.Indices[i + corner]];
+				uint32_t second = welded[section.Indices[i + (corner + 1) % 3]];
+
+				auto [iterator, bIsNew] = edges.try_emplace(std::make_tuple(glm::min(first, second), glm::max(first, second), axes[triangle]), triangle);
+				if (!bIsNew)
+				{
+					parents[FindRoot(parents, triangle)] = FindRoot(parents, iterator->second);
+				}
+			}
+		}
+	}
+
+	// Charts are numbered in the order of their first triangles
+	std::vector<UnwrapChart> charts;
+	std::vector<uint32_t> triangleCharts(axes.size());
+	std::vector<uint32_t> rootCharts(axes.size(), UINT32_MAX);
+
+	for (uint32_t sectionIndex = 0; sectionIndex < sections.size(); ++sectionIndex)
+	{
+		const LightmapUnwrapSection& section = sections[sectionIndex];
+
+		for (uint32_t i = 0; i < section.Indices.size(); i += 3)
+		{
+			uint32_t triangle = firstTriangles[sectionIndex] + i / 3;
+			uint32_t root = FindRoot(parents, triangle);
+
+			if (rootCharts[root] == UINT32_MAX)
+			{
+				rootCharts[root] = charts.size();
+				charts.emplace_back().Axis = axes[triangle];
+			}
+
+			UnwrapChart& chart = charts[rootCharts[root]];
+			triangleCharts[triangle] = rootCharts[root];
+
+			for (uint32_t corner = 0; corner < 3; ++corner)
+			{
+				glm::vec2 projected = Project(section.Positions[section.Indices[i + corner]], chart.Axis);
+
+				chart.Min = glm::min(chart.Min, projected);
+				chart.Max = glm::max(chart.Max, projected);
+			}
+		}
+	}
+
+	for (LightmapUnwrapSection& section : sections)
+	{
+		section.SourceVertices.clear();
+		section.Coordinates.clear();
+		section.UnwrappedIndices.clear();
+	}
+
+	if (charts.empty())
+	{
+		return true;
+	}
+
+	// Tallest charts first, so rows waste less space
+	std::vector<uint32_t> order(charts.size());
+	for (uint32_t i = 0; i < order.size(); ++i)
+	{
+		order[i] = i;
+	}
+
+	std::stable_sort(order.begin(), order.end(), [&charts](uint32_t first, uint32_t second)
+	{
+		return charts[first].Max.y - charts[first].Min.y > charts[second].Max.y - charts[second].Min.y;
+	});
+
+	// First guess fills half of the lightmap, then the scale is grown or shrunk by small steps to the largest one that fits
+	float area = 0.0f;
+	for (const UnwrapChart& chart : charts)
+	{
+		glm::vec2 size = chart.Max - chart.Min;
+		area += size.x * size.y;
+	}
+
+	float scale = area > 0.0f ? glm::sqrt(0.5f * resolution * resolution / area) : 1.0f;
+	float fittingScale = 0.0f;
+
+	const uint32_t maxAttempts = 64;
+	const float step = 1.1f;
+
+	if (PackCharts(charts, order, scale, resolution))
+	{
+		fittingScale = scale;
+		for (uint32_t attempt = 0; attempt < maxAttempts && PackCharts(charts, order, scale * step, resolution); ++attempt)
+		{
+			scale *= step;
+			fittingScale = scale;
+		}
+	}
+	else
+	{
+		for (uint32_t attempt = 0; attempt < maxAttempts && fittingScale == 0.0f; ++attempt)
+		{
+			scale /= step;
+			if (PackCharts(charts, order, scale, resolution))
+			{
+				fittingScale = scale;
+			}
+		}
+	}
+
+	if (fittingScale == 0.0f)
+	{
+		return false;
+	}
+
+	PackCharts(charts, order, fittingScale, resolution);
+
+	for (uint32_t sectionIndex = 0; sectionIndex < sections.size(); ++sectionIndex)
+	{
+		LightmapUnwrapSection& section = sections[sectionIndex];
+
+		// Key is the chart in the high bits and the source vertex in the low ones
+		std::map<uint64_t, int32_t> unwrappedVertices;
+
+		for (uint32_t i = 0; i < section.Indices.size(); ++i)
+		{
+			uint32_t triangle = firstTriangles[sectionIndex] + i / 3;
+			uint32_t source = section.Indices[i];
+
+			const UnwrapChart& chart = charts[triangleCharts[triangle]];
+
+			auto [iterator, bIsNew] = unwrappedVertices.try_emplace((uint64_t(triangleCharts[triangle]) << 32) | source, section.SourceVertices.size());
+			if (bIsNew)
+			{
+				glm::vec2 texel = chart.Offset + (Project(section.Positions[source], chart.Axis) - chart.Min) * fittingScale;
+
+				section.SourceVertices.push_back(source);
+				section.Coordinates.push_back(texel / float(resolution));
+			}
+
+			section.UnwrappedIndices.push_back(iterator->second);
+		}
+	}
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Core/Ed.h"
+
+// Triangles of one submesh, all sections of a mesh share one lightmap
+struct LightmapUnwrapSection
+{
+	std::vector<glm::vec3> Positions;
+	std::vector<int32_t> Indices;
+
+	// Filled by unwrapping. Vertices are split where charts meet, every unwrapped vertex is a copy of a source vertex with its own lightmap coordinates
+	std::vector<uint32_t> SourceVertices;
+	std::vector<glm::vec2> Coordinates;
+	std::vector<int32_t> UnwrappedIndices;
+};
+
+// Generates lightmap coordinates. Connected triangles facing the same axis form a chart that is flattened by projecting it onto the plane of that axis,
+// charts keep their world space proportions and are packed into rows of a square lightmap with padding texels around them, so they don't bleed into each other
+class LightmapUnwrap
+{
+public:
+	static const uint32_t Padding = 2;
+
+	// False when charts don't fit the resolution even when shrunk, sections are left without coordinates then
+	static bool Unwrap(std::vector<LightmapUnwrapSection>& sections, uint32_t resolution);
+};
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "AmbientPass.h"
 #include "Core/Rendering/Framebuffer.h"
+#include "Core/Rendering/Buffers/StorageBuffer.h"
 
 void AmbientPass::Initialize(std::shared_ptr<RenderGraph> graph)
 {
@@ -11,19 +12,104 @@ void AmbientPass::Initialize(std::shared_ptr<RenderGraph> graph)
 	m_Parameters.bClearColors = true;
 	m_Parameters.bClearDepth = true;
 
-	m_ShaderParameters.Albedo = m_Parameters.Albedo;
+	// Created now, so the texture isn't uploaded from a thread recording the pass
+	RenderingHelper::GetWhiteTexture();
+}
+
+void AmbientPass::PreExecute()
+{
+	RenderPass<AmbientPassParameters, AmbientPassShaderParameters>::PreExecute();
+
+	UploadIrradianceVolumes();
 }
 
 void AmbientPass::Execute()
 {
 	RenderPass<AmbientPassParameters, AmbientPassShaderParameters>::Execute();
 
-	glm::u32vec2 size = m_Renderer->GetViewportSize();
-	m_Parameters.DrawFramebuffer->Resize(size.x, size.y, 1);
+	SubmitFullscreenParameters();
+
+	m_Renderer->SubmitFullScreenQuad(m_Context);
+}
+
+std::string AmbientPass::GetFusionFeature() const
+{
+	return "AMBIENT_PASS";
+}
+
+bool AmbientPass::SupportsParallelRecording() const
+{
+	return true;
+}
+
+void AmbientPass::SubmitFullscreenParameters()
+{
+	m_ShaderParameters.Albedo = m_Parameters.Albedo;
+	m_ShaderParameters.Lightmap = m_Parameters.Lightmap;
+	m_ShaderParameters.Position = m_Parameters.Position;
+	m_ShaderParameters.Normal = m_Parameters.Normal;
 
 	m_ShaderParameters.AmbientOcclusion = m_Renderer->IsSSAOEnabled() ? m_Parameters.AmbientOcclusion.Get() : RenderingHelper::GetWhiteTexture();
 
+	m_ShaderParameters.IrradianceVolumesCount = m_UploadedVolumes.size();
+	if (!m_UploadedVolumes.empty())
+	{
+		m_Context->SetStorageBuffer(IrradianceVolumesBinding, m_VolumesBuffer);
+		m_Context->SetStorageBuffer(IrradianceProbesBinding, m_ProbesBuffer);
+	}
+
 	SubmitShaderParameters();
+}
+
+void AmbientPass::UploadIrradianceVolumes()
+{
+	std::vector<std::shared_ptr<IrradianceVolume>> volumes;
+	std::vector<std::pair<const IrradianceVolume*, uint32_t>> uploadedVolumes;
+
+	for (const std::shared_ptr<IrradianceVolumeComponent>& component : m_Parameters.IrradianceVolumes.Get())
+	{
+		std::shared_ptr<IrradianceVolume> volume = component->GetVolume();
+		if (volume && !volume->GetProbes().empty())
+		{
+			volumes.push_back(volume);
+			uploadedVolumes.emplace_back(volume.get(), volume->GetGeneration());
+		}
+	}
+
+	if (uploadedVolumes == m_UploadedVolumes)
+	{
+		return;
+	}
+
+	m_UploadedVolumes = uploadedVolumes;
+
+	if (volumes.empty())
+	{
+		return;
+	}
+
+	std::vector<IrradianceVolumeData> volumesData;
+	std::vector<glm::vec4> probesData;
+
+	for (const std::shared_ptr<IrradianceVolume>& volume : volumes)
+	{
+		IrradianceVolumeData& data = volumesData.emplace_back();
+		data.Min = volume->GetMin();
+		data.Max = volume->GetMax();
+		data.ProbesCount = volume->GetProbesCount();
+		data.FirstProbe = probesData.size() / SHL2::CoefficientsCount;
+
+		// Convolved once here, so shaders only evaluate the coefficients
+		for (const SHL2& probe : volume->GetProbes())
+		{
+			SHL2 convolved = probe.GetCosineConvolved();
+			for (const glm::vec3& coefficient : convolved.Coefficients)
+			{
+				probesData.emplace_back(coefficient, 0.0f);
+			}
+		}
+	}
 
-	m_Renderer->SubmitFullScreenQuad();
+	RenderingHelper::UploadStorageBuffer(m_VolumesBuffer, volumesData.data(), volumesData.size() * sizeof(IrradianceVolumeData), BufferUsage::DynamicDraw);
+	RenderingHelper::UploadStorageBuffer(m_ProbesBuffer, probesData.data(), probesData.size() * sizeof(glm::vec4), BufferUsage::DynamicDraw);
 }
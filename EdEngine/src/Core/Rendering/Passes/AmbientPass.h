@@ -1,15 +1,21 @@
 #pragma once
 
 #include "Core/Rendering/Passes/RenderPass.h"
+#include "Core/Components/IrradianceVolumeComponent.h"
 
 ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(AmbientPass, Base)
 
-	ED_RENDER_PASS_DECLARE_RENDER_TARGET(Texture2D, Diffuse,  Color16, "LightBuffer.Diffuse")
-	ED_RENDER_PASS_DECLARE_RENDER_TARGET(Texture2D, Specular, Color16, "LightBuffer.Specular")
-	ED_RENDER_PASS_DECLARE_RENDER_TARGET(Texture2D, Combined, Color16, "LightBuffer.Combined")
+	ED_RENDER_PASS_DECLARE_TRANSIENT_RENDER_TARGET(Texture2D, Diffuse,  Color16, 1.0f, "LightBuffer.Diffuse")
+	ED_RENDER_PASS_DECLARE_TRANSIENT_RENDER_TARGET(Texture2D, Specular, Color16, 1.0f, "LightBuffer.Specular")
+	ED_RENDER_PASS_DECLARE_TRANSIENT_RENDER_TARGET(Texture2D, Combined, Color16, 1.0f, "LightBuffer.Combined")
 
-	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, Albedo,           "GBuffer.Albedo", Read)
-	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, AmbientOcclusion, "SSAO.Base",      Read)
+	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, Albedo,           "GBuffer.Albedo",   Read)
+	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, AmbientOcclusion, "SSAO.Base",        Read)
+	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, Lightmap,         "GBuffer.Lightmap", Read)
+	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, Position,         "GBuffer.Position", Read)
+	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, Normal,           "GBuffer.Normal",   Read)
+
+	ED_RENDER_PASS_PARAMETER(std::vector<std::shared_ptr<IrradianceVolumeComponent>>, IrradianceVolumes, "Scene.IrradianceVolume", Read)
 	
 ED_END_RENDER_PASS_PARAMETERS_DECLARATION()
 	
@@ -17,12 +23,46 @@ ED_BEGIN_SHADER_PARAMETERS_DECLARATION(AmbientPass)
 
 	ED_SHADER_PARAMETER_PTR(Texture, Texture2D, Albedo)
 	ED_SHADER_PARAMETER_PTR(Texture, Texture2D, AmbientOcclusion)
+	ED_SHADER_PARAMETER_PTR(Texture, Texture2D, Lightmap)
+	ED_SHADER_PARAMETER_PTR(Texture, Texture2D, Position)
+	ED_SHADER_PARAMETER_PTR(Texture, Texture2D, Normal)
+
+	ED_SHADER_PARAMETER(Int, int32_t, IrradianceVolumesCount)
 
 ED_END_SHADER_PARAMETERS_DECLARATION()
 
+// Layout matches IrradianceVolume in shaders (std430)
+struct IrradianceVolumeData
+{
+	glm::vec3 Min;
+	float Padding0;
+	glm::vec3 Max;
+	float Padding1;
+	glm::u32vec3 ProbesCount;
+	uint32_t FirstProbe;
+};
+
+// Lights surfaces with their lightmaps, baked irradiance volumes where there are none and a constant term everywhere else
 class AmbientPass : public RenderPass<AmbientPassParameters, AmbientPassShaderParameters>
 {
 public:
+	static const uint32_t IrradianceVolumesBinding = 4;
+	static const uint32_t IrradianceProbesBinding = 5;
+
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph) override;
+	virtual void PreExecute() override;
 	virtual void Execute() override;
+
+	virtual std::string GetFusionFeature() const override;
+	virtual void SubmitFullscreenParameters() override;
+
+	virtual bool SupportsParallelRecording() const override;
+protected:
+	void UploadIrradianceVolumes();
+protected:
+	// Assets and their generations the buffers were filled from, probes are uploaded again only when they change
+	std::vector<std::pair<const IrradianceVolume*, uint32_t>> m_UploadedVolumes;
+
+	std::shared_ptr<StorageBuffer> m_VolumesBuffer;
+	std::shared_ptr<StorageBuffer> m_ProbesBuffer;
 };
\ No newline at end of file
@@ -27,16 +27,14 @@ void BloomDownscalePass::Execute()
 	}
 
 	glm::vec2 inputSize = glm::vec2(m_ShaderParameters.Input->GetSize());
-
-	glm::vec2 outputSize = inputSize / 2.0f;
-	m_Parameters.DrawFramebuffer->Resize(outputSize.x, outputSize.y, 1);
+	glm::vec2 outputSize = glm::vec2(m_Parameters.DrawFramebuffer->GetWidth(), m_Parameters.DrawFramebuffer->GetHeight());
 
 	m_ShaderParameters.InPixelSize = 1.0f / inputSize;
 	m_ShaderParameters.OutPixelSize = 1.0f / outputSize;
 
 	SubmitShaderParameters();
 
-	m_Renderer->SubmitFullScreenQuad();
+	m_Renderer->SubmitFullScreenQuad(m_Context);
 }
 
 std::shared_ptr<Texture2D> BloomDownscalePass::GetTexture() const
@@ -4,7 +4,7 @@
 
 ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(BloomDownscalePass, Base)
 
-	ED_RENDER_PASS_DECLARE_RENDER_TARGET(Texture2D, Output, Color16, "Bloom.Intermediate" + std::to_string(Parameters.InstanceNumber))
+	ED_RENDER_PASS_DECLARE_TRANSIENT_RENDER_TARGET(Texture2D, Output, Color16, 1.0f / (1 << Parameters.InstanceNumber), "Bloom.Intermediate" + std::to_string(Parameters.InstanceNumber))
 
 	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, TAAOutput, "TAA.Output", Read)
 	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, FXAAOutput, "FXAA.Output", Read)
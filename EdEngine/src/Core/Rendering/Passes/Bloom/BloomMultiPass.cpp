@@ -6,6 +6,7 @@ void BloomMultiPass::Initialize(std::shared_ptr<RenderGraph> graph)
 {
 	MultiPassRenderPass<BloomMultiPassParameters, ShaderParameters>::Initialize(graph);
 
+	m_Parameters.Name = "Bloom MultiPass";
 	m_Parameters.DownscaleCount = 4;
 }
 
@@ -13,22 +14,24 @@ void BloomMultiPass::Execute()
 {
 	MultiPassRenderPass<BloomMultiPassParameters, ShaderParameters>::Execute();
 
-	if (m_Renderer->IsBloomEnabled())
+	// Downscaling
+	for (uint32_t i = 0; i < m_Parameters.DownscaleCount; ++i)
 	{
-		// Downscaling
-		for (uint32_t i = 0; i < m_Parameters.DownscaleCount; ++i)
-		{
-			m_Graph->ExecutePass(m_Passes[i]);
-		}
+		m_Graph->ExecutePass(m_Passes[i]);
+	}
 
-		// Upscaling (we are only upscaling to half the resolution of the full scene)
-		for (uint32_t i = MaxBloomDownscalingCount * 2 - m_Parameters.DownscaleCount; i < m_Passes.size(); ++i)
-		{
-			m_Graph->ExecutePass(m_Passes[i]);
-		}
+	// Upscaling (we are only upscaling to half the resolution of the full scene)
+	for (uint32_t i = MaxBloomDownscalingCount * 2 - m_Parameters.DownscaleCount; i < m_Passes.size(); ++i)
+	{
+		m_Graph->ExecutePass(m_Passes[i]);
 	}
 }
 
+bool BloomMultiPass::IsEnabled() const
+{
+	return m_Renderer->IsBloomEnabled();
+}
+
 void BloomMultiPass::CreatePasses()
 {
 	for (uint32_t i = 0; i < MaxBloomDownscalingCount; ++i)
@@ -16,6 +16,7 @@ public:
 public:
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph);
 	virtual void Execute() override;
+	virtual bool IsEnabled() const override;
 
 	virtual void CreatePasses() override;
 
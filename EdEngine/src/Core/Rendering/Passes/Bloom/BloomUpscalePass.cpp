@@ -14,9 +14,6 @@ void BloomUpscalePass::Execute()
 {
 	RenderPass<BloomUpscalePassParameters, BloomUpscalePassShaderParameters>::Execute();
 
-	glm::u32vec3 size = m_Parameters.Upscaled->GetSize();
-	m_Parameters.DrawFramebuffer->Resize(size.x, size.y, size.z);
-
 	m_ShaderParameters.Downscaled = m_Parameters.Downscaled;
 	m_ShaderParameters.Upscaled = m_Parameters.Upscaled; // TODO: Should probably change this :) (reading and writing to this target at this pass)
 
@@ -25,7 +22,7 @@ void BloomUpscalePass::Execute()
 
 	SubmitShaderParameters();
 
-	m_Renderer->SubmitFullScreenQuad();
+	m_Renderer->SubmitFullScreenQuad(m_Context);
 }
 
 float BloomUpscalePass::GetBloomMixStrength() const
@@ -20,9 +20,6 @@ void IconsPass::Execute()
 {
 	RenderPass<IconsPassParameters, IconsPassShaderParameters>::Execute();
 
-	glm::u32vec2 size = m_Renderer->GetViewportSize();
-	m_Parameters.DrawFramebuffer->Resize(size.x, size.y, 1);
-
 	Camera& camera = m_Parameters.Camera->GetCamera();
 
 	m_Renderer->SetCamera(camera);
@@ -9,21 +9,32 @@ void EmissionPass::Initialize(std::shared_ptr<RenderGraph> graph)
 
 	m_Parameters.DestinationFactor = BlendFactor::One;
 	m_Parameters.SourceFactor = BlendFactor::One;
-
-	m_ShaderParameters.Albedo = m_Parameters.Albedo;
-	m_ShaderParameters.RoughnessMetalic = m_Parameters.RoughnessMetalic;
 }
 
 void EmissionPass::Execute()
 {
 	RenderPass<EmissionPassParameters, EmissionPassShaderParameters>::Execute();
 
-	glm::u32vec2 size = m_Renderer->GetViewportSize();
-	m_Parameters.DrawFramebuffer->Resize(size.x, size.y, 1);
+	SubmitFullscreenParameters();
 
-	SubmitShaderParameters();
+	m_Renderer->SubmitFullScreenQuad(m_Context);
+}
+
+std::string EmissionPass::GetFusionFeature() const
+{
+	return "EMISSION_PASS";
+}
 
+bool EmissionPass::SupportsParallelRecording() const
+{
+	return true;
+}
+
+void EmissionPass::SubmitFullscreenParameters()
+{
+	m_ShaderParameters.Albedo = m_Parameters.Albedo;
+	m_ShaderParameters.RoughnessMetalic = m_Parameters.RoughnessMetalic;
 	m_ShaderParameters.PixelSize = 1.0f / glm::vec2(m_Parameters.Diffuse->GetSize());
 
-	m_Renderer->SubmitFullScreenQuad();
+	SubmitShaderParameters();
 }
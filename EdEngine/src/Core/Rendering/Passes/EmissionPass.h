@@ -27,4 +27,9 @@ class EmissionPass : public RenderPass<EmissionPassParameters, EmissionPassShade
 public:
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph) override;
 	virtual void Execute() override;
+
+	virtual std::string GetFusionFeature() const override;
+	virtual void SubmitFullscreenParameters() override;
+
+	virtual bool SupportsParallelRecording() const override;
 };
\ No newline at end of file
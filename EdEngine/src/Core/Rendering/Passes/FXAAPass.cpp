@@ -9,32 +9,45 @@ void FXAAPass::Initialize(std::shared_ptr<RenderGraph> graph)
 
 	m_Parameters.Output = RenderingHelper::CreateRenderTarget<Texture2D>({ "FXAA.Output", FramebufferAttachmentType::Color16 }, TextureType::Texture2D);
 
-	m_ShaderParameters.Input = m_Parameters.LightCombined;
-
 	m_ShaderParameters.ContrastThreshold = 0.0312f;
 	m_ShaderParameters.RelativeThreshold = 0.125f;
 	m_ShaderParameters.SubpixelBlending = 1.0f;
 }
 
+void FXAAPass::PreExecute()
+{
+	RenderPass<FXAAPassParameters, FXAAPassShaderParameters>::PreExecute();
+
+	// Output isn't a render target, so the graph doesn't resize it
+	glm::u32vec3 size = m_Parameters.LightCombined->GetSize();
+	m_Parameters.Output->Resize(size.x, size.y, 1);
+}
+
 void FXAAPass::Execute()
 {
 	RenderPass<FXAAPassParameters, FXAAPassShaderParameters>::Execute();
-	
-	glm::u32vec2 size = m_Renderer->GetViewportSize();
-	m_Parameters.Output->Resize(size.x, size.y, 1);
 
-	if (m_Renderer->GetAAMethod() == AAMethod::FXAA)
-	{
-		m_ShaderParameters.Output = m_Parameters.Output;
+	m_ShaderParameters.Output = m_Parameters.Output;
 
-		m_ShaderParameters.PixelSize = glm::vec2(1.0f / m_Parameters.LightCombined->GetWidth(), 1.0f / m_Parameters.LightCombined->GetHeight());
+	m_ShaderParameters.Input = m_Parameters.LightCombined;
+
+	m_ShaderParameters.PixelSize = glm::vec2(1.0f / m_Parameters.LightCombined->GetWidth(), 1.0f / m_Parameters.LightCombined->GetHeight());
+
+	SubmitShaderParameters();
+
+	m_Context->RunComputeShader(m_Parameters.Output->GetWidth(), m_Parameters.Output->GetHeight(), 1);
 
-		SubmitShaderParameters();
+	m_Context->Barier(BarrierType::AllBits);
+}
 
-		m_Context->RunComputeShader(m_Parameters.Output->GetWidth(), m_Parameters.Output->GetHeight(), 1);
+bool FXAAPass::IsEnabled() const
+{
+	return m_Renderer->GetAAMethod() == AAMethod::FXAA;
+}
 
-		m_Context->Barier(BarrierType::AllBits);
-	}
+bool FXAAPass::SupportsParallelRecording() const
+{
+	return true;
 }
 
 void FXAAPass::SetContrastThreshold(float threshold)
@@ -27,7 +27,10 @@ class FXAAPass : public RenderPass<FXAAPassParameters, FXAAPassShaderParameters>
 {
 public:
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph);
+	virtual void PreExecute() override;
 	virtual void Execute();
+	virtual bool IsEnabled() const override;
+	virtual bool SupportsParallelRecording() const override;
 
 	void SetContrastThreshold(float threshold);
 	float GetContrastThreshold() const;
@@ -1,13 +1,14 @@
 #include "GBufferPass.h"
 #include "Utils/MathHelper.h"
 #include "Core/Components/StaticMeshComponent.h"
+#include <unordered_set>
 
 void GBufferPass::Initialize(std::shared_ptr<RenderGraph> graph)
 {
 	RenderPass<GBufferPassParameters, GBufferPassShaderParameters>::Initialize(graph);
 
 	m_Parameters.Name = "GBuffer pass";
-	m_Parameters.Shader = RenderingHelper::CreateShader("shaders\\deferred\\geometry-pass.glsl");
+	m_Parameters.Shader = RenderingHelper::CreateShader("shaders\\deferred\\geometry-pass.glsl", { "INSTANCED" });
 
 	m_Parameters.bUseBlending = false;
 
@@ -20,88 +21,178 @@ void GBufferPass::Initialize(std::shared_ptr<RenderGraph> graph)
 	}
 }
 
+void GBufferPass::PreExecute()
+{
+	RenderPass<GBufferPassParameters, GBufferPassShaderParameters>::PreExecute();
+
+	UpdateCamera();
+
+	SetLightmap();
+	FillRenderQueue();
+	UpdateMaterials();
+
+	m_Instances.Fill(m_Queue);
+
+	UploadShaderParameters();
+}
+
 void GBufferPass::Execute()
 {
 	RenderPass<GBufferPassParameters, GBufferPassShaderParameters>::Execute();
 
-	glm::vec2 size = m_Renderer->GetViewportSize();
-	m_Parameters.DrawFramebuffer->Resize(size.x, size.y, 1);
+	m_Instances.Bind(m_Context);
+
+	const Material* currentMaterial = nullptr;
 
-	SetCameraInformation();
+	for (const DrawBatch& batch : m_Queue.GetBatches())
+	{
+		const DrawCommand& command = m_Queue.GetCommand(m_Queue.GetPackets()[batch.FirstPacket]);
+
+		if (command.Material != currentMaterial)
+		{
+			SetMaterial(command.Material);
+			currentMaterial = command.Material;
+		}
+
+		// Context skips rebinding when buffers are the same as for the previous draw
+		m_Context->SetVertexBuffer(command.Submesh->GetVertexBuffer());
+		m_Context->SetIndexBuffer(command.Submesh->GetIndexBuffer());
+		m_Context->DrawInstanced(batch.Count, batch.FirstPacket);
+	}
+}
+
+void GBufferPass::FillRenderQueue()
+{
+	m_Queue.Clear();
+
+	Camera& camera = m_Parameters.Camera->GetCamera();
+
+	glm::vec3 viewPosition = camera.GetPosition();
+	glm::vec3 viewForward = camera.GetForward();
 
 	for (const std::shared_ptr<StaticMeshComponent>& component : m_Parameters.Meshes.Get())
 	{
 		if (std::shared_ptr<StaticMesh> mesh = component->GetStaticMesh())
 		{
-			Transform worldTransform = component->GetWorldTransform();
-			Transform previousWorldTransform = component->GetPreviousWorldTransform();
+			DrawCommand command;
+			command.PreviousModelMatrix = component->GetPreviousWorldMatrix();
+			command.ModelMatrix = component->GetWorldMatrix();
+			command.NormalMatrix = component->GetNormalMatrix();
+
+			if (component->GetLightmap() == m_ShaderParameters.Lightmap)
+			{
+				command.LightmapScaleOffset = component->GetLightmapScaleOffset();
+			}
+
+			float depth = glm::dot(glm::vec3(command.ModelMatrix[3]) - viewPosition, viewForward);
+			uint32_t depthBucket = RenderQueue::CalculateDepthBucket(depth, camera.GetNear(), camera.GetFar());
 
 			for (const std::shared_ptr<StaticSubmesh>& submesh : mesh->GetSubmeshes())
 			{
 				if (std::shared_ptr<Material> material = submesh->GetMaterial())
 				{
-					m_ShaderParameters.Material_BaseColor = material->GetBaseColor();
+					command.Submesh = submesh.get();
+					command.Material = material.get();
 
-					SetTextureOrWhite(m_ShaderParameters.Material_BaseColorTexture, material->GetBaseColorTexture());
-					SetTextureOrWhite(m_ShaderParameters.Material_NormalTexture, material->GetNormalTexture());
-					SetTextureOrWhite(m_ShaderParameters.Material_RoughnessTexture, material->GetRoughnessTexture());
-					SetTextureOrWhite(m_ShaderParameters.Material_MetalicTexture, material->GetMetalicTexture());
-					
-					m_ShaderParameters.Material_PerformNormalMapping = material->ShouldPerformNormalMapping();
+					uint64_t key = RenderQueue::MakeSortKey(RenderQueuePass::GBuffer, depthBucket, m_Queue.GetMaterialId(command.Material), m_Queue.GetGeometryId(command.Submesh));
+					m_Queue.Submit(key, command);
+				}
+			}
+		}
+	}
 
-					m_ShaderParameters.PreviousModelMatrix = previousWorldTransform.GetMatrix();
-					m_ShaderParameters.ModelMatrix = worldTransform.GetMatrix();
-					m_ShaderParameters.NormalMatrix = worldTransform.GetInversedTransposedMatrix();
+	m_Queue.GroupInstances();
+	m_Queue.Sort();
+	m_Queue.BuildBatches();
+}
 
-					m_ShaderParameters.Material_Roughness = material->GetRoughness();
-					m_ShaderParameters.Material_Metalic = material->GetMetalic();
-					m_ShaderParameters.Material_Emission = material->GetEmission();
+void GBufferPass::SetLightmap()
+{
+	m_ShaderParameters.Lightmap = nullptr;
 
-					SubmitShaderParameters();
+	for (const std::shared_ptr<StaticMeshComponent>& component : m_Parameters.Meshes.Get())
+	{
+		if (std::shared_ptr<Texture2D> lightmap = component->GetLightmap())
+		{
+			m_ShaderParameters.Lightmap = lightmap;
+			break;
+		}
+	}
 
-					m_Context->SetVertexBuffer(submesh->GetVertexBuffer());
-					m_Context->SetIndexBuffer(submesh->GetIndexBuffer());
-					m_Context->Draw();
-				}
-			}
+	SetTextureOrWhite(m_ShaderParameters.Lightmap, m_ShaderParameters.Lightmap);
+}
+
+void GBufferPass::UpdateMaterials()
+{
+	std::unordered_set<const Material*> materials;
+
+	for (const DrawBatch& batch : m_Queue.GetBatches())
+	{
+		const Material* material = m_Queue.GetCommand(m_Queue.GetPackets()[batch.FirstPacket]).Material;
+		if (!materials.insert(material).second)
+		{
+			continue;
 		}
+
+		// Constructed in place, parameters refer to themselves and can't be moved
+		GBufferPassMaterialShaderParameters& parameters = m_MaterialShaderParameters.try_emplace(material).first->second;
+
+		GBufferPassMaterialShaderParameters::MaterialUniformBufferData& data = parameters.Material.Data;
+		data.BaseColor = material->GetBaseColor();
+		data.Roughness = material->GetRoughness();
+		data.Metalic = material->GetMetalic();
+		data.Emission = material->GetEmission();
+		data.PerformNormalMapping = material->ShouldPerformNormalMapping();
+
+		SetTextureOrWhite(parameters.BaseColorTexture, material->GetBaseColorTexture());
+		SetTextureOrWhite(parameters.NormalTexture, material->GetNormalTexture());
+		SetTextureOrWhite(parameters.RoughnessTexture, material->GetRoughnessTexture());
+		SetTextureOrWhite(parameters.MetalicTexture, material->GetMetalicTexture());
+
+		// Block is uploaded only when the material has changed
+		UploadShaderParameters(parameters);
 	}
+
+	// Buffers of materials no longer drawn are released
+	std::erase_if(m_MaterialShaderParameters, [&materials](const auto& entry) { return !materials.contains(entry.first); });
+}
+
+void GBufferPass::SetMaterial(const Material* material)
+{
+	SubmitShaderParameters(m_MaterialShaderParameters.at(material));
+
+	// Texture slots are reused round robin, so the lightmap is bound again with every material
+	SubmitShaderParameters();
 }
 
-void GBufferPass::SetCameraInformation()
+bool GBufferPass::SupportsParallelRecording() const
+{
+	return true;
+}
+
+void GBufferPass::UpdateCamera()
 {
 	Camera& camera = m_Parameters.Camera->GetCamera();
 
-	glm::mat4 view = camera.GetView();
 	glm::mat4 projection = camera.GetProjection();
 
 	glm::vec2 size = glm::vec2(m_Parameters.DrawFramebuffer->GetWidth(), m_Parameters.DrawFramebuffer->GetHeight());
 
-	glm::vec2 jitter = m_JitterSequence[m_CurrentJitterIndex] / size;
-	glm::vec2 previousJitter = m_JitterSequence[(m_CurrentJitterIndex - 1 + m_JitterSequenceSize) % m_JitterSequenceSize] / size;
-
-	bool bIsTAAEnabled = m_Renderer->GetAAMethod() == AAMethod::TAA;
+	GBufferPassShaderParameters::FrameUniformBufferData& frame = m_ShaderParameters.Frame.Data;
+	frame.Jitter = m_JitterSequence[m_CurrentJitterIndex] / size;
+	frame.PreviousJitter = m_JitterSequence[(m_CurrentJitterIndex - 1 + m_JitterSequenceSize) % m_JitterSequenceSize] / size;
 
-	if (bIsTAAEnabled)
+	if (m_Renderer->GetAAMethod() == AAMethod::TAA)
 	{
-		projection = glm::translate(glm::mat4(1.0f), glm::vec3(jitter - previousJitter, 0.0f)) * projection;
+		projection = glm::translate(glm::mat4(1.0f), glm::vec3(frame.Jitter - frame.PreviousJitter, 0.0f)) * projection;
 		camera.SetProjection(projection);
 	}
 
-	m_Renderer->SetCamera(view, projection, camera.GetPosition());
-
-	if (bIsTAAEnabled)
-	{
-		m_Context->SetShaderDataFloat2("u_PreviousJitter", previousJitter);
-		m_Context->SetShaderDataFloat2("u_Jitter", jitter);
-	}
-	else
-	{
-		m_Context->SetShaderDataMat4("u_PreviousProjectionMatrix", projection);
-	}
+	m_Renderer->SetCamera(camera);
 
-	m_Context->SetShaderDataMat4("u_PreviousViewMatrix", m_PreviousView);
+	frame.PreviousProjectionMatrix = projection;
+	frame.PreviousViewMatrix = camera.GetPreviousView();
 
 	m_CurrentJitterIndex = (m_CurrentJitterIndex + 1) % m_JitterSequenceSize;
-	m_PreviousView = view;
+	camera.StorePreviousMatrices();
 }
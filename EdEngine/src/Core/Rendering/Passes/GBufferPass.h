@@ -3,14 +3,18 @@
 #include "Core/Rendering/Passes/RenderPass.h"
 #include "Core/Components/CameraComponent.h"
 #include "Core/Components/StaticMeshComponent.h"
+#include "Core/Rendering/RenderQueue.h"
+#include "Core/Rendering/InstanceBuffer.h"
 
 ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(GBufferPass, Base)
-	ED_RENDER_PASS_DECLARE_RENDER_TARGET(Texture2D, Albedo,           Color,     "GBuffer.Albedo")
-	ED_RENDER_PASS_DECLARE_RENDER_TARGET(Texture2D, Position,         Position,  "GBuffer.Position")
-	ED_RENDER_PASS_DECLARE_RENDER_TARGET(Texture2D, Normal,           Direction, "GBuffer.Normal")
-	ED_RENDER_PASS_DECLARE_RENDER_TARGET(Texture2D, RoughnessMetalic, Color16,   "GBuffer.RoughnessMetalic")
-	ED_RENDER_PASS_DECLARE_RENDER_TARGET(Texture2D, Velocity,         Velocity,  "GBuffer.Velocity")
-	ED_RENDER_PASS_DECLARE_RENDER_TARGET(Texture2D, Depth,            Depth,     "GBuffer.Depth")
+	ED_RENDER_PASS_DECLARE_TRANSIENT_RENDER_TARGET(Texture2D, Albedo,           Color,     1.0f, "GBuffer.Albedo")
+	ED_RENDER_PASS_DECLARE_TRANSIENT_RENDER_TARGET(Texture2D, Position,         Position,  1.0f, "GBuffer.Position")
+	ED_RENDER_PASS_DECLARE_TRANSIENT_RENDER_TARGET(Texture2D, Normal,           Direction, 1.0f, "GBuffer.Normal")
+	ED_RENDER_PASS_DECLARE_TRANSIENT_RENDER_TARGET(Texture2D, RoughnessMetalic, Color16,   1.0f, "GBuffer.RoughnessMetalic")
+	ED_RENDER_PASS_DECLARE_TRANSIENT_RENDER_TARGET(Texture2D, Velocity,         Velocity,  1.0f, "GBuffer.Velocity")
+	// Light baked for static meshes divided by pi, alpha is zero where there is no lightmap
+	ED_RENDER_PASS_DECLARE_TRANSIENT_RENDER_TARGET(Texture2D, Lightmap,         Color16,   1.0f, "GBuffer.Lightmap")
+	ED_RENDER_PASS_DECLARE_TRANSIENT_RENDER_TARGET(Texture2D, Depth,            Depth,     1.0f, "GBuffer.Depth")
 
 	ED_RENDER_PASS_OBJECT_PTR_PARAMETER(CameraComponent, Camera, "Camera", Read)
 
@@ -20,34 +24,66 @@ ED_END_RENDER_PASS_PARAMETERS_DECLARATION()
 
 ED_BEGIN_SHADER_PARAMETERS_DECLARATION(GBufferPass)
 
-	ED_SHADER_PARAMETER_SUBSTRUCT(Material, Float3, glm::vec3, BaseColor)
-	
-	ED_SHADER_PARAMETER_SUBSTRUCT(Material, Float, float, Roughness)
-	ED_SHADER_PARAMETER_SUBSTRUCT(Material, Float, float, Metalic)
-	ED_SHADER_PARAMETER_SUBSTRUCT(Material, Float, float, Emission)
+	ED_BEGIN_SHADER_PARAMETERS_BLOCK(Frame, 1)
+		ED_SHADER_BLOCK_PARAMETER(glm::mat4, PreviousViewMatrix)
+		ED_SHADER_BLOCK_PARAMETER(glm::mat4, PreviousProjectionMatrix)
+		ED_SHADER_BLOCK_PARAMETER(glm::vec2, Jitter)
+		ED_SHADER_BLOCK_PARAMETER(glm::vec2, PreviousJitter)
+	ED_END_SHADER_PARAMETERS_BLOCK(Frame)
 
-	ED_SHADER_PARAMETER_SUBSTRUCT_PTR(Material, Texture, Texture2D, BaseColorTexture)
+	ED_SHADER_PARAMETER_PTR(Texture, Texture2D, Lightmap)
 
-	ED_SHADER_PARAMETER_SUBSTRUCT_PTR(Material, Texture, Texture2D, NormalTexture)
-	ED_SHADER_PARAMETER_SUBSTRUCT(Material, Bool, bool, PerformNormalMapping)
+ED_END_SHADER_PARAMETERS_DECLARATION()
+
+// Offsets of the Frame block in resources/shaders/deferred/geometry-pass.glsl
+static_assert(offsetof(GBufferPassShaderParameters::FrameUniformBufferData, PreviousViewMatrix) == 0);
+static_assert(offsetof(GBufferPassShaderParameters::FrameUniformBufferData, PreviousProjectionMatrix) == 64);
+static_assert(offsetof(GBufferPassShaderParameters::FrameUniformBufferData, Jitter) == 128);
+static_assert(offsetof(GBufferPassShaderParameters::FrameUniformBufferData, PreviousJitter) == 136);
 
-	ED_SHADER_PARAMETER_SUBSTRUCT_PTR(Material, Texture, Texture2D, RoughnessTexture)
-	ED_SHADER_PARAMETER_SUBSTRUCT_PTR(Material, Texture, Texture2D, MetalicTexture)
+ED_BEGIN_SHADER_PARAMETERS_DECLARATION(GBufferPassMaterial)
 
-	ED_SHADER_PARAMETER(Mat4, glm::mat4, PreviousModelMatrix)
-	ED_SHADER_PARAMETER(Mat4, glm::mat4, ModelMatrix)
-	ED_SHADER_PARAMETER(Mat3, glm::mat3, NormalMatrix)
+	// Bool of a GLSL block takes four bytes, so PerformNormalMapping is sent as an int
+	ED_BEGIN_SHADER_PARAMETERS_BLOCK(Material, 2)
+		ED_SHADER_BLOCK_PARAMETER(glm::vec3, BaseColor)
+		ED_SHADER_BLOCK_PARAMETER(float, Roughness)
+		ED_SHADER_BLOCK_PARAMETER(float, Metalic)
+		ED_SHADER_BLOCK_PARAMETER(float, Emission)
+		ED_SHADER_BLOCK_PARAMETER(int32_t, PerformNormalMapping)
+	ED_END_SHADER_PARAMETERS_BLOCK(Material)
+
+	ED_SHADER_PARAMETER_PTR(Texture, Texture2D, BaseColorTexture)
+	ED_SHADER_PARAMETER_PTR(Texture, Texture2D, NormalTexture)
+	ED_SHADER_PARAMETER_PTR(Texture, Texture2D, RoughnessTexture)
+	ED_SHADER_PARAMETER_PTR(Texture, Texture2D, MetalicTexture)
 
 ED_END_SHADER_PARAMETERS_DECLARATION()
 
+// Offsets of the Material block in resources/shaders/deferred/geometry-pass.glsl
+static_assert(offsetof(GBufferPassMaterialShaderParameters::MaterialUniformBufferData, BaseColor) == 0);
+static_assert(offsetof(GBufferPassMaterialShaderParameters::MaterialUniformBufferData, Roughness) == 12);
+static_assert(offsetof(GBufferPassMaterialShaderParameters::MaterialUniformBufferData, Metalic) == 16);
+static_assert(offsetof(GBufferPassMaterialShaderParameters::MaterialUniformBufferData, Emission) == 20);
+static_assert(offsetof(GBufferPassMaterialShaderParameters::MaterialUniformBufferData, PerformNormalMapping) == 24);
+
 class GBufferPass : public RenderPass<GBufferPassParameters, GBufferPassShaderParameters>
 {
 public:
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph);
+	virtual void PreExecute() override;
 	virtual void Execute();
 
+	virtual bool SupportsParallelRecording() const override;
+
 protected:
-	void SetCameraInformation();
+	void UpdateCamera();
+
+	void FillRenderQueue();
+	// All static meshes are baked into one atlas, meshes lit by a different bake are drawn without lightmaps
+	void SetLightmap();
+	// Fills and uploads the block of every material in the queue, so Execute only binds them
+	void UpdateMaterials();
+	void SetMaterial(const Material* material);
 
 	inline void SetTextureOrWhite(std::shared_ptr<Texture2D>& destination, std::shared_ptr<Texture2D> texture)
 	{
@@ -59,5 +95,9 @@ protected:
 	int32_t m_CurrentJitterIndex = 0;
 	std::vector<glm::vec2> m_JitterSequence;
 
-	glm::mat4 m_PreviousView;
+	// Parameters own the material block, so every material drawn keeps its own uniform buffer
+	std::unordered_map<const Material*, GBufferPassMaterialShaderParameters> m_MaterialShaderParameters;
+
+	RenderQueue m_Queue;
+	InstanceBuffer m_Instances;
 };
\ No newline at end of file
@@ -6,19 +6,41 @@ void GrayscalePass::Initialize(std::shared_ptr<RenderGraph> graph)
 
 	m_Parameters.Name = "Grayscale pass";
 	m_Parameters.Shader = RenderingHelper::CreateShader("shaders\\Grayscale.glsl");;
-	m_ShaderParameters.Color = m_Parameters.Color;
 }
 
 void GrayscalePass::Execute()
 {
 	RenderPass<GrayscalePassParameters, GrayscalePassShaderParameters>::Execute();
 
-	return;
+	SubmitFullscreenParameters();
+
+	m_Renderer->SubmitFullScreenQuad(m_Context);
+}
+
+std::string GrayscalePass::GetFusionFeature() const
+{
+	return "GRAYSCALE_PASS";
+}
+
+bool GrayscalePass::SupportsParallelRecording() const
+{
+	return true;
+}
 
-	glm::u32vec2 size = m_Renderer->GetViewportSize();
-	m_Parameters.DrawFramebuffer->Resize(size.x, size.y, 1);
+void GrayscalePass::SubmitFullscreenParameters()
+{
+	m_ShaderParameters.Color = m_Parameters.Color;
 
 	SubmitShaderParameters();
+}
 
-	m_Renderer->SubmitFullScreenQuad();
+bool GrayscalePass::IsEnabled() const
+{
+	return m_bIsEnabled;
+}
+
+void GrayscalePass::SetEnabled(bool bEnabled)
+{
+	m_bIsEnabled = bEnabled;
+	m_Graph->Invalidate();
 }
@@ -20,4 +20,15 @@ class GrayscalePass : public RenderPass<GrayscalePassParameters, GrayscalePassSh
 public:
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph) override;
 	virtual void Execute() override;
+
+	virtual std::string GetFusionFeature() const override;
+	virtual void SubmitFullscreenParameters() override;
+
+	virtual bool SupportsParallelRecording() const override;
+
+	virtual bool IsEnabled() const override;
+	void SetEnabled(bool bEnabled);
+
+protected:
+	bool m_bIsEnabled = false;
 };
@@ -0,0 +1,126 @@
+#include "ClusteredLightingPass.h"
+#include "Core/Rendering/Buffers/StorageBuffer.h"
+
+void ClusteredLightingPass::Initialize(std::shared_ptr<RenderGraph> graph)
+{
+	RenderPass<ClusteredLightingPassParameters, ClusteredLightingShaderParameters>::Initialize(graph);
+
+	m_Parameters.Name = "Clustered lighting pass";
+	m_Parameters.Shader = RenderingHelper::CreateShader("shaders\\light\\clustered-light-pass.glsl");
+
+	m_Parameters.SourceFactor = BlendFactor::One;
+	m_Parameters.DestinationFactor = BlendFactor::One;
+}
+
+void ClusteredLightingPass::Execute()
+{
+	RenderPass<ClusteredLightingPassParameters, ClusteredLightingShaderParameters>::Execute();
+
+	CollectLights();
+
+	if (m_Lights.empty())
+	{
+		return;
+	}
+
+	Camera& camera = m_Parameters.Camera->GetCamera();
+
+	m_Clusters.SetView(camera.GetView(), camera.GetFOVRadians(), camera.GetAspect(), camera.GetNear(), camera.GetFar());
+	m_Clusters.Assign(m_Lights, m_Graph->GetJobSystem());
+
+	const std::vector<uint32_t>& indices = m_Clusters.GetLightIndices();
+	if (indices.empty())
+	{
+		return;
+	}
+
+	const std::vector<LightCluster>& clusters = m_Clusters.GetClusters();
+
+	RenderingHelper::UploadStorageBuffer(m_LightsBuffer, m_LightsData.data(), m_LightsData.size() * sizeof(ClusteredLightData), BufferUsage::DynamicDraw);
+	RenderingHelper::UploadStorageBuffer(m_ClustersBuffer, (void*)clusters.data(), clusters.size() * sizeof(LightCluster), BufferUsage::DynamicDraw);
+	RenderingHelper::UploadStorageBuffer(m_LightIndicesBuffer, (void*)indices.data(), indices.size() * sizeof(uint32_t), BufferUsage::DynamicDraw);
+
+	m_Context->SetStorageBuffer(LightsBinding, m_LightsBuffer);
+	m_Context->SetStorageBuffer(ClustersBinding, m_ClustersBuffer);
+	m_Context->SetStorageBuffer(LightIndicesBinding, m_LightIndicesBuffer);
+
+	m_Renderer->SetCamera(camera);
+
+	m_ShaderParameters.Albedo = m_Parameters.Albedo;
+	m_ShaderParameters.Position = m_Parameters.Position;
+	m_ShaderParameters.Normal = m_Parameters.Normal;
+	m_ShaderParameters.RoughnessMetalic = m_Parameters.RoughnessMetalic;
+
+	m_ShaderParameters.PixelSize = 1.0f / glm::vec2(m_Parameters.Albedo->GetSize());
+
+	m_ShaderParameters.SliceScale = m_Clusters.GetSliceScale();
+	m_ShaderParameters.SliceBias = m_Clusters.GetSliceBias();
+
+	SubmitShaderParameters();
+
+	m_Renderer->SubmitFullScreenQuad(m_Context);
+}
+
+bool ClusteredLightingPass::IsEnabled() const
+{
+	return m_Renderer->IsClusteredLightingEnabled();
+}
+
+const LightClusters& ClusteredLightingPass::GetClusters() const
+{
+	return m_Clusters;
+}
+
+void ClusteredLightingPass::CollectLights()
+{
+	m_Lights.clear();
+	m_LightsData.clear();
+
+	for (const std::shared_ptr<PointLightComponent>& light : m_Parameters.PointLights.Get())
+	{
+		if (light->GetIntensity() == 0 || light->IsShadowCasting() || light->IsBaked())
+		{
+			continue;
+		}
+
+		ClusterLight& bounds = m_Lights.emplace_back();
+		bounds.Type = ClusterLightType::Point;
+		bounds.Position = light->GetPosition();
+		bounds.Range = light->GetRadius();
+
+		ClusteredLightData& data = m_LightsData.emplace_back();
+		data.Position = bounds.Position;
+		data.Range = bounds.Range;
+		data.Color = light->GetColor();
+		data.Intensity = light->GetIntensity();
+		data.Type = (uint32_t)ClusterLightType::Point;
+	}
+
+	// Same direction the spot light mesh points along
+	static const glm::vec3 spotLightDirection = glm::vec3(0.0f, -1.0f, 0.0f);
+
+	for (const std::shared_ptr<SpotLightComponent>& light : m_Parameters.SpotLights.Get())
+	{
+		if (light->GetIntensity() == 0 || light->IsShadowCasting() || light->IsBaked())
+		{
+			continue;
+		}
+
+		ClusterLight& bounds = m_Lights.emplace_back();
+		bounds.Type = ClusterLightType::Spot;
+		bounds.Position = light->GetPosition();
+		bounds.Range = light->GetMaxDistance();
+		bounds.Direction = glm::normalize(light->GetWorldTransform().GetRotation() * spotLightDirection);
+		bounds.OuterAngle = light->GetOuterAngle();
+
+		ClusteredLightData& data = m_LightsData.emplace_back();
+		data.Position = bounds.Position;
+		data.Range = bounds.Range;
+		data.Color = light->GetColor();
+		data.Intensity = light->GetIntensity();
+		data.Direction = bounds.Direction;
+		data.InnerAngleCos = glm::cos(light->GetInnerAngle());
+		data.OuterAngleCos = glm::cos(light->GetOuterAngle());
+		data.Type = (uint32_t)ClusterLightType::Spot;
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Core/Rendering/Passes/RenderPass.h"
+#include "Core/Rendering/LightClusters.h"
+#include "Core/Components/CameraComponent.h"
+#include "Core/Components/PointLightComponent.h"
+#include "Core/Components/SpotLightComponent.h"
+
+ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(ClusteredLightingPass, Base)
+
+	ED_RENDER_PASS_RENDER_TARGET_REFERENCE(Texture2D, Diffuse,  "LightBuffer.Diffuse")
+	ED_RENDER_PASS_RENDER_TARGET_REFERENCE(Texture2D, Specular, "LightBuffer.Specular")
+	ED_RENDER_PASS_RENDER_TARGET_REFERENCE(Texture2D, Combined, "LightBuffer.Combined")
+
+	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, Albedo,           "GBuffer.Albedo",           Read)
+	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, Position,         "GBuffer.Position",         Read)
+	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, Normal,           "GBuffer.Normal",           Read)
+	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, RoughnessMetalic, "GBuffer.RoughnessMetalic", Read)
+
+	ED_RENDER_PASS_OBJECT_PTR_PARAMETER(CameraComponent, Camera, "Camera", Read)
+
+	ED_RENDER_PASS_PARAMETER(std::vector<std::shared_ptr<PointLightComponent>>, PointLights, "Scene.PointLight", Read)
+	ED_RENDER_PASS_PARAMETER(std::vector<std::shared_ptr<SpotLightComponent>>,  SpotLights,  "Scene.SpotLight",  Read)
+
+ED_END_RENDER_PASS_PARAMETERS_DECLARATION()
+
+ED_BEGIN_SHADER_PARAMETERS_DECLARATION(ClusteredLighting)
+
+	ED_SHADER_PARAMETER_PTR(Texture, Texture2D, Albedo)
+	ED_SHADER_PARAMETER_PTR(Texture, Texture2D, Position)
+	ED_SHADER_PARAMETER_PTR(Texture, Texture2D, Normal)
+	ED_SHADER_PARAMETER_PTR(Texture, Texture2D, RoughnessMetalic)
+
+	ED_SHADER_PARAMETER(Float2, glm::vec2, PixelSize)
+
+	ED_SHADER_PARAMETER(Float, float, SliceScale)
+	ED_SHADER_PARAMETER(Float, float, SliceBias)
+
+ED_END_SHADER_PARAMETERS_DECLARATION()
+
+// Layout matches ClusteredLight in shaders (std430)
+struct ClusteredLightData
+{
+	glm::vec3 Position;
+	float Range;
+	glm::vec3 Color;
+	float Intensity;
+	glm::vec3 Direction;
+	float InnerAngleCos;
+	float OuterAngleCos;
+	uint32_t Type;
+	glm::vec2 Padding;
+};
+
+// Shades point and spot lights without shadows in one fullscreen draw, every pixel loops over the lights of its froxel.
+// Shadow casting lights stay in their multipasses, their shadow maps are rendered per light
+class ClusteredLightingPass : public RenderPass<ClusteredLightingPassParameters, ClusteredLightingShaderParameters>
+{
+public:
+	static const uint32_t LightsBinding = 1;
+	static const uint32_t ClustersBinding = 2;
+	static const uint32_t LightIndicesBinding = 3;
+
+	virtual void Initialize(std::shared_ptr<RenderGraph> graph) override;
+	virtual void Execute() override;
+
+	virtual bool IsEnabled() const override;
+
+	const LightClusters& GetClusters() const;
+protected:
+	void CollectLights();
+protected:
+	LightClusters m_Clusters;
+
+	std::vector<ClusterLight> m_Lights;
+	std::vector<ClusteredLightData> m_LightsData;
+
+	std::shared_ptr<StorageBuffer> m_LightsBuffer;
+	std::shared_ptr<StorageBuffer> m_ClustersBuffer;
+	std::shared_ptr<StorageBuffer> m_LightIndicesBuffer;
+};
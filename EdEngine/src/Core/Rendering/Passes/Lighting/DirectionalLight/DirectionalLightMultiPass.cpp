@@ -17,7 +17,7 @@ void DirectionalLightMultiPass::Execute()
 	{
 		m_Parameters.Light = light;
 
-		if (light->GetIntensity() != 0.0f)
+		if (light->GetIntensity() != 0.0f && !light->IsBaked())
 		{
 			for (const std::shared_ptr<BaseRenderPass>& pass : m_Passes)
 			{
@@ -10,11 +10,6 @@ void DirectionalLightShadingRenderPass::Initialize(std::shared_ptr<RenderGraph>
 	m_Parameters.SourceFactor = BlendFactor::One;
 	m_Parameters.DestinationFactor = BlendFactor::One;
 
-	m_ShaderParameters.Albedo = m_Parameters.Albedo;
-	m_ShaderParameters.Position = m_Parameters.Position;
-	m_ShaderParameters.Normal = m_Parameters.Normal;
-	m_ShaderParameters.RoughnessMetalic = m_Parameters.RoughnessMetalic;
-
 	m_ShaderParameters.Light_ShadowMap = m_Parameters.ShadowMap;
 }
 
@@ -22,8 +17,10 @@ void DirectionalLightShadingRenderPass::Execute()
 {
 	RenderPass<DirecationalLightShadingParameters, DirectionalLightShadingShaderParameters>::Execute();
 
-	glm::u32vec2 size = m_Renderer->GetViewportSize();
-	m_Parameters.DrawFramebuffer->Resize(size.x, size.y, 1);
+	m_ShaderParameters.Albedo = m_Parameters.Albedo;
+	m_ShaderParameters.Position = m_Parameters.Position;
+	m_ShaderParameters.Normal = m_Parameters.Normal;
+	m_ShaderParameters.RoughnessMetalic = m_Parameters.RoughnessMetalic;
 
 	m_Renderer->SetCamera(m_Parameters.Camera->GetCamera());
 
@@ -40,7 +37,7 @@ void DirectionalLightShadingRenderPass::Execute()
 
 	if (light->IsShadowCasting())
 	{
-		m_ShaderParameters.Light_ShadowMapPixelSize = 1.0f / m_Parameters.DrawFramebuffer->GetWidth();
+		m_ShaderParameters.Light_ShadowMapPixelSize = 1.0f / m_Parameters.ShadowMap->GetWidth();
 		
 		m_ShaderParameters.Light_ShadowFilterSize = light->GetShadowFilterSize();
 		m_ShaderParameters.Light_ShadowFilterRadius = light->GetShadowFilterRadius();
@@ -54,5 +51,5 @@ void DirectionalLightShadingRenderPass::Execute()
 
 	SubmitShaderParameters();
 
-	m_Renderer->SubmitFullScreenQuad();
+	m_Renderer->SubmitFullScreenQuad(m_Context);
 }
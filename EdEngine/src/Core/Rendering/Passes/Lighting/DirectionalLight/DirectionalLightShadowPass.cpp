@@ -1,157 +1,108 @@
 #include "DirectionalLightShadowPass.h"
-#include "Utils/MathHelper.h"
 
 void DirectionalLightShadowPass::Initialize(std::shared_ptr<RenderGraph> graph)
 {
 	RenderPass<DirectionalLightShadowPassParameters, DirectionalLightShadowPassShaderParameters>::Initialize(graph);
 
 	m_Parameters.Name = "Directional light shadow pass";
-	m_Parameters.Shader = RenderingHelper::CreateShader("shaders\\light\\directional-light-shadow-pass.glsl");
+	m_Parameters.Shader = RenderingHelper::CreateShader("shaders\\light\\directional-light-shadow-pass.glsl", { "INSTANCED" });
 
 	m_Parameters.bUseBlending = false;
-	m_Parameters.bClearDepth = true;
+	// Layers are cleared one by one when their cascades are drawn
+	m_Parameters.bClearDepth = false;
 }
 
 void DirectionalLightShadowPass::Execute()
 {
 	RenderPass<DirectionalLightShadowPassParameters, DirectionalLightShadowPassShaderParameters>::Execute();
 
-	glm::u32vec2 size = m_Renderer->GetViewportSize();
-	uint32_t sideSize = glm::max((uint32_t)size.x, ShadowCascadeMinSize);
-	m_Parameters.DrawFramebuffer->Resize(sideSize, sideSize, MaxShadowCascadesCount);
+	std::vector<glm::mat4>& matrices = m_Parameters.ShadowViewProjectionMatrices;
 
-	if (m_Parameters.Light->IsShadowCasting())
+	std::shared_ptr<DirectionalLightComponent> light = m_Parameters.Light;
+	if (!light->IsShadowCasting())
 	{
-		m_Parameters.ShadowViewProjectionMatrices = CalculateShadowViewProjectionMatrices(m_Parameters.Light);
-
-		m_ShaderParameters.Cascades = m_Parameters.ShadowViewProjectionMatrices.size();
-		for (uint32_t i = 0; i < m_ShaderParameters.Cascades; ++i)
-		{
-			m_ShaderParameters.ProjectionViewMatries[i] = m_Parameters.ShadowViewProjectionMatrices[i];
-		}
-
-		for (const std::shared_ptr<StaticMeshComponent>& component : m_Parameters.Meshes.Get())
-		{
-			if (std::shared_ptr<StaticMesh> mesh = component->GetStaticMesh())
-			{
-				Transform worldTransform = component->GetWorldTransform();
-				Transform previousWorldTransform = component->GetPreviousWorldTransform();
-
-				for (const std::shared_ptr<StaticSubmesh>& submesh : mesh->GetSubmeshes())
-				{
-					if (std::shared_ptr<Material> material = submesh->GetMaterial())
-					{
-						m_ShaderParameters.ModelMatrix = worldTransform.GetMatrix();
-
-						SubmitShaderParameters();
-
-						m_Context->SetVertexBuffer(submesh->GetVertexBuffer());
-						m_Context->SetIndexBuffer(submesh->GetIndexBuffer());
-						m_Context->Draw();
-					}
-				}
-			}
-		}
+		matrices.clear();
+		return;
 	}
-}
-
-std::vector<glm::mat4> DirectionalLightShadowPass::CalculateShadowViewProjectionMatrices(std::shared_ptr<DirectionalLightComponent> light) const
-{
-	std::vector<glm::mat4> matrices;
 
-	if (light->IsShadowCasting())
+	if (m_ShadowMap != m_Parameters.ShadowMap)
 	{
-		static std::vector<glm::vec4> cornersNDC = {
-			{ -1.0f, -1.0f, -1.0f, 1.0f },
-			{ -1.0f,  1.0f, -1.0f, 1.0f },
-			{  1.0f,  1.0f, -1.0f, 1.0f },
-			{  1.0f, -1.0f, -1.0f, 1.0f },
-			{ -1.0f, -1.0f,  1.0f, 1.0f },
-			{ -1.0f,  1.0f,  1.0f, 1.0f },
-			{  1.0f,  1.0f,  1.0f, 1.0f },
-			{  1.0f, -1.0f,  1.0f, 1.0f }
-		};
-
-		int32_t cascades = glm::clamp<int32_t>(light->GetShadowCascadesCount(), MinShadowCascadesCount, MaxShadowCascadesCount);
-		float farPlane = m_Renderer->GetFarPlane();
-
-		Camera& camera = m_Parameters.Camera->GetCamera();
-
-		for (int32_t i = 0; i < cascades; ++i)
-		{
-			float currentNearPlane = glm::max(1.0f, (1.0f * i / cascades) * farPlane);
-			float currentFarPlane = ((i + 1.0f) / cascades) * farPlane;
-			glm::mat4 inverseProjectionView = glm::inverse(camera.GetProjectionView(currentNearPlane, currentFarPlane));
-
-			glm::vec3 centerWorld(0.0f);
+		m_ShadowMap = m_Parameters.ShadowMap;
+		m_Cascades.Invalidate();
 
-			std::vector<glm::vec3> cornersWorld;
+		std::fill(std::begin(m_bIsCascadeEmpty), std::end(m_bIsCascadeEmpty), false);
+	}
 
-			for (const glm::vec4& cornerNDC : cornersNDC)
-			{
-				glm::vec4 cornerWorld = inverseProjectionView * cornerNDC;
-				cornerWorld /= cornerWorld.w;
-				cornersWorld.emplace_back(cornerWorld);
+	uint32_t resolution = m_ShadowMap->GetWidth();
 
-				centerWorld += glm::vec3(cornerWorld);
-			}
+	Camera& camera = m_Parameters.Camera->GetCamera();
+	m_Cascades.Update(camera, m_Renderer->GetFarPlane(), light->GetDirection(), light->GetShadowCascadesCount(), ShadowCascadesSplitLambda, resolution, light->GetShadowMapZMultiplier());
 
-			centerWorld /= cornersNDC.size();
+	matrices.resize(m_Cascades.GetCount());
+	for (uint32_t i = 0; i < m_Cascades.GetCount(); ++i)
+	{
+		matrices[i] = m_Cascades.GetCascade(i).ProjectionView;
+	}
 
-			static glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f);
-			glm::vec3 direction = light->GetDirection();
-			if (direction == up || direction == -up)
-			{
-				direction += glm::vec3(0.001f);
-			}
+	const std::vector<std::shared_ptr<StaticMeshComponent>>& meshes = m_Parameters.Meshes.Get();
 
-			glm::mat4 lightView = glm::lookAt(centerWorld - direction, centerWorld, up);
+	m_CasterSpheres.resize(meshes.size());
+	for (uint32_t i = 0; i < meshes.size(); ++i)
+	{
+		m_CasterSpheres[i] = meshes[i]->GetWorldBoundingSphere();
+	}
 
-			glm::vec3 leftCornerView(std::numeric_limits<float>::max());
-			glm::vec3 rightCornerView(std::numeric_limits<float>::min());
+	for (uint32_t i = 0; i < m_Cascades.GetCount(); ++i)
+	{
+		const ShadowCascade& cascade = m_Cascades.GetCascade(i);
+		if (!cascade.bShouldUpdate)
+		{
+			continue;
+		}
 
-			for (const glm::vec3& cornerWorld : cornersWorld)
+		m_Casters.clear();
+		for (uint32_t j = 0; j < meshes.size(); ++j)
+		{
+			if (m_Cascades.Intersects(i, m_CasterSpheres[j]))
 			{
-				glm::vec3 cornerView = lightView * glm::vec4(cornerWorld, 1.0f);
-
-				leftCornerView = MathHelper::MinPerComponent(leftCornerView, cornerView);
-				rightCornerView = MathHelper::MaxPerComponent(rightCornerView, cornerView);
+				m_Casters.push_back(meshes[j]);
 			}
+		}
 
-			float size = glm::max(glm::distance(cornersWorld[0], cornersWorld[6]), glm::distance(cornersWorld[0], cornersWorld[2]));
+		bool bIsEmpty = m_Casters.empty();
+		if (bIsEmpty && m_bIsCascadeEmpty[i])
+		{
+			continue;
+		}
 
-			float width = rightCornerView.x - leftCornerView.x;
-			float height = rightCornerView.y - leftCornerView.y;
+		m_Context->ClearDepthTarget(m_ShadowMap, glm::u32vec3(0, 0, i), glm::u32vec3(resolution, resolution, 1));
+		m_bIsCascadeEmpty[i] = bIsEmpty;
 
-			size = glm::max(size, glm::min(width, height));
+		if (bIsEmpty)
+		{
+			continue;
+		}
 
-			{
-				float diff = size - width;
-				leftCornerView.x -= diff / 2.0f;
-				rightCornerView.x += diff / 2.0f;
-			}
+		m_ShaderParameters.Cascade = i;
+		m_ShaderParameters.ProjectionViewMatrix = cascade.ProjectionView;
 
-			{
-				float diff = size - height;
-				leftCornerView.y -= diff / 2.0f;
-				rightCornerView.y += diff / 2.0f;
-			}
+		SubmitShaderParameters();
 
-			leftCornerView.z *= light->GetShadowMapZMultiplier();
-			rightCornerView.z *= light->GetShadowMapZMultiplier();
+		RenderQueue& queue = m_Queues[i];
+		InstanceBuffer& instances = m_Instances[i];
 
-			float pixelSize = size / m_Parameters.DrawFramebuffer->GetWidth();
+		RenderingHelper::FillShadowRenderQueue(queue, m_Casters);
 
-			leftCornerView.x = std::round(leftCornerView.x / pixelSize) * pixelSize;
-			leftCornerView.y = std::round(leftCornerView.y / pixelSize) * pixelSize;
-			rightCornerView.x = std::round(rightCornerView.x / pixelSize) * pixelSize;
-			rightCornerView.y = std::round(rightCornerView.y / pixelSize) * pixelSize;
+		instances.Fill(queue);
+		instances.Bind(m_Context);
 
-			glm::mat4 lightProjection = glm::ortho(leftCornerView.x, rightCornerView.x, leftCornerView.y, rightCornerView.y, leftCornerView.z, rightCornerView.z);
+		for (const DrawBatch& batch : queue.GetBatches())
+		{
+			const DrawCommand& command = queue.GetCommand(queue.GetPackets()[batch.FirstPacket]);
 
-			matrices.push_back(lightProjection * lightView);
+			m_Context->SetVertexBuffer(command.Submesh->GetVertexBuffer());
+			m_Context->SetIndexBuffer(command.Submesh->GetIndexBuffer());
+			m_Context->DrawInstanced(batch.Count, batch.FirstPacket);
 		}
 	}
-
-	return matrices;
-}
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Core/Rendering/Passes/RenderPass.h"
+#include "Core/Rendering/RenderQueue.h"
+#include "Core/Rendering/InstanceBuffer.h"
+#include "Core/Rendering/ShadowCascades.h"
 #include "Core/Components/DirectionalLightComponent.h"
 #include "Core/Components/StaticMeshComponent.h"
 #include "Core/Components/CameraComponent.h"
@@ -8,7 +11,10 @@
 
 ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(DirectionalLightShadowPass, Base)
 
-	ED_RENDER_PASS_DECLARE_RENDER_TARGET(Texture2DArray, ShadowMap, Depth, "DirectionalLightPass.ShadowMap")
+	static const uint32_t MaxShadowCascadesCount = ShadowCascades::MaxCascadesCount;
+	static const uint32_t ShadowCascadeSize = 2048;
+
+	ED_RENDER_PASS_DECLARE_FIXED_SIZE_RENDER_TARGET(Texture2DArray, ShadowMap, Depth, ShadowCascadeSize, MaxShadowCascadesCount, "DirectionalLightPass.ShadowMap")
 
 	ED_RENDER_PASS_PARAMETER(std::vector<std::shared_ptr<StaticMeshComponent>>, Meshes, "Scene.StaticMesh", Read)
 
@@ -21,22 +27,31 @@ ED_END_RENDER_PASS_PARAMETERS_DECLARATION()
 
 ED_BEGIN_SHADER_PARAMETERS_DECLARATION(DirectionalLightShadowPass)
 
-	ED_SHADER_PARAMETER(Float, float, Cascades)
-	ED_SHADER_PARAMETER_ARRAY(Mat4, glm::mat4, ProjectionViewMatries, 4)
-
-	ED_SHADER_PARAMETER(Mat4, glm::mat4, ModelMatrix)
+	ED_SHADER_PARAMETER(Float, float, Cascade)
+	ED_SHADER_PARAMETER(Mat4, glm::mat4, ProjectionViewMatrix)
 
 ED_END_SHADER_PARAMETERS_DECLARATION()
 
 class DirectionalLightShadowPass : public RenderPass<DirectionalLightShadowPassParameters, DirectionalLightShadowPassShaderParameters>
 {
 	static const uint32_t MinShadowCascadesCount = 1;
-	static const uint32_t MaxShadowCascadesCount = 4;
-	static const uint32_t ShadowCascadeMinSize = 2048;
+	static const uint32_t MaxShadowCascadesCount = DirectionalLightShadowPassParameters::MaxShadowCascadesCount;
+	// Blend of uniform and logarithmic splits
+	static constexpr float ShadowCascadesSplitLambda = 0.75f;
 public:
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph) override;
 	virtual void Execute() override;
 
 protected:
-	std::vector<glm::mat4> CalculateShadowViewProjectionMatrices(std::shared_ptr<DirectionalLightComponent> component) const;
+	ShadowCascades m_Cascades;
+	// Layers are drawn only when their cascades are due and have casters, a layer that stays empty isn't even cleared again
+	bool m_bIsCascadeEmpty[MaxShadowCascadesCount] = {};
+	// Cascades are invalidated when the graph creates the shadow map again
+	std::shared_ptr<Texture2DArray> m_ShadowMap;
+
+	std::vector<glm::vec4> m_CasterSpheres;
+	std::vector<std::shared_ptr<StaticMeshComponent>> m_Casters;
+
+	RenderQueue m_Queues[MaxShadowCascadesCount];
+	InstanceBuffer m_Instances[MaxShadowCascadesCount];
 };
\ No newline at end of file
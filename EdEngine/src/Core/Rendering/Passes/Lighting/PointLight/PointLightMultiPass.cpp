@@ -16,41 +16,160 @@ void PointLightMultiPass::Initialize(std::shared_ptr<RenderGraph> graph)
 		m_Parameters.LightMeshVertices = std::move(vertices);
 		m_Parameters.LightMeshIndices = std::move(indices);
 	}
+
+	m_Parameters.ShadowViewProjections.resize(6);
+
+	const uint32_t layerSize = PointLightShadowPassParameters::ShadowLayerSize;
+	const uint64_t atlasSize = layerSize * PointLightShadowPassParameters::ShadowSlotsGridSize;
+
+	// Tiles can't be bigger than a layer, otherwise they would cross slots
+	m_ShadowCache.Reset(atlasSize, MinShadowTileSize);
+	m_ShadowScheduler.Reset(MinShadowTileSize, layerSize, atlasSize * atlasSize, ShadowUpdateBudget);
 }
 
 void PointLightMultiPass::Execute()
 {
 	MultiPassRenderPass<PointLightMultiPassParameters, ShaderParameters>::Execute();
 
-	for (const std::shared_ptr<PointLightComponent>& light : m_Parameters.Lights.Get())
+	const std::vector<std::shared_ptr<PointLightComponent>>& lights = m_Parameters.Lights.Get();
+	RenderingHelper::ClassifyPointLights(lights, m_Parameters.Camera->GetCamera(), m_Visibilities);
+
+	std::shared_ptr<Texture2DArray> shadowMap = GetPass<PointLightShadowPass>()->GetParameters().ShadowMap;
+	if (m_ShadowMap != shadowMap)
+	{
+		m_ShadowMap = shadowMap;
+		m_ShadowCache.Invalidate();
+	}
+
+	RenderingHelper::FillShadowCasters(m_ShadowCasters, m_Parameters.Meshes.Get());
+	m_ShadowCache.BeginFrame(m_ShadowCasters);
+
+	// Shadows of lights drawn this frame share the atlas and the update budget
+	m_ShadowRequests.clear();
+	for (uint32_t i = 0; i < lights.size(); ++i)
 	{
+		const std::shared_ptr<PointLightComponent>& light = lights[i];
+		if (light->IsShadowCasting() && !light->IsBaked() && light->GetIntensity() != 0 && m_Visibilities[i] != LightVolumeVisibility::Hidden)
+		{
+			ShadowRequest& request = m_ShadowRequests.emplace_back();
+			request.Key = light.get();
+			request.BoundingSphere = glm::vec4(light->GetPosition(), light->GetRadius());
+			request.Intensity = light->GetIntensity();
+			request.Faces = 6;
+		}
+	}
+
+	const Camera& camera = m_Parameters.Camera->GetCamera();
+	m_ShadowScheduler.SetView(camera.GetPosition(), camera.GetFOVRadians(), m_Renderer->GetViewportSize(), m_Renderer->GetFarPlane());
+	m_ShadowScheduler.Schedule(m_ShadowRequests);
+
+	// Passes read the view of the camera while they are recorded, so it is uploaded once before all of them
+	m_Renderer->SetCamera(camera);
+
+	std::shared_ptr<BaseRenderPass> shadowPass = GetPass<PointLightShadowPass>();
+	std::shared_ptr<BaseRenderPass> shadingPass = GetPass<PointLightShadingPass>();
+	std::shared_ptr<BaseRenderPass> wireframePass = GetPass<PointLightWireframePass>();
+
+	// Lights are prepared in order, so they take atlas tiles and caster uploads as before, and then recorded together
+	m_Items.clear();
+	for (uint32_t i = 0; i < lights.size(); ++i)
+	{
+		const std::shared_ptr<PointLightComponent>& light = lights[i];
 		m_Parameters.Light = light;
 
-		if (light->GetIntensity() != 0 && IsActiveLightVisible())
+		// Lights without shadows are shaded by the clustered lighting pass and baked ones by lightmaps, only their wireframes are drawn here
+		bool bIsShadedElsewhere = light->IsBaked() || (m_Renderer->IsClusteredLightingEnabled() && !light->IsShadowCasting());
+		if (bIsShadedElsewhere && !light->ShouldShowWireframe())
+		{
+			continue;
+		}
+
+		if (light->GetIntensity() != 0 && m_Visibilities[i] != LightVolumeVisibility::Hidden)
 		{
-			for (const std::shared_ptr<BaseRenderPass>& pass : m_Passes)
+			m_Parameters.LightVisibility = m_Visibilities[i];
+
+			// Light names aren't unique, index keeps their scopes apart
+			RenderGraphItem& item = m_Items.emplace_back();
+			item.Name = std::to_string(i) + ". " + light->GetName();
+			item.Index = m_Items.size() - 1;
+
+			if (!bIsShadedElsewhere)
+			{
+				UpdateShadow(light);
+
+				item.Passes.push_back(shadowPass);
+				item.Passes.push_back(shadingPass);
+			}
+
+			if (light->ShouldShowWireframe())
 			{
-				m_Graph->ExecutePass(pass);
+				item.Passes.push_back(wireframePass);
+			}
+
+			for (const std::shared_ptr<BaseRenderPass>& pass : item.Passes)
+			{
+				pass->PrepareItem(item.Index);
 			}
 		}
 	}
-}
 
-void PointLightMultiPass::CreatePasses()
-{
-	AddPass<PointLightShadowPass>();
-	AddPass<PointLightShadingPass>();
-	AddPass<PointLightWireframePass>();
+	m_Graph->RecordItems(m_Items);
+
+	m_ShadowCache.EndFrame();
 }
 
-bool PointLightMultiPass::IsActiveLightVisible()
+void PointLightMultiPass::UpdateShadow(const std::shared_ptr<PointLightComponent>& light)
 {
-	std::shared_ptr<PointLightComponent> light = m_Parameters.Light;
+	m_Parameters.StaticShadowCasters.clear();
+	m_Parameters.DynamicShadowCasters.clear();
+
+	if (!light->IsShadowCasting())
+	{
+		m_Parameters.ShadowTile = ShadowAtlasTile();
+		m_Parameters.ShadowMapUpdate = ShadowUpdate::None;
+		return;
+	}
+
+	glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 1.0f, m_Renderer->GetFarPlane());
+	for (int32_t i = 0; i < 6; ++i)
+	{
+		m_Parameters.ShadowViewProjections[i] = projection * light->GetShadowMapPassCameraTransformation(i);
+	}
+
+	// Faces share the projection, the first one changes together with all others
+	ShadowLight shadowLight;
+	shadowLight.Key = light.get();
+	shadowLight.BoundingSphere = glm::vec4(light->GetPosition(), light->GetRadius());
+	shadowLight.ProjectionView = m_Parameters.ShadowViewProjections[0];
+
+	const ShadowSchedule& schedule = m_ShadowScheduler.GetSchedule(light.get());
+	shadowLight.TileSize = schedule.TileSize;
+	shadowLight.bShouldUpdate = schedule.bShouldUpdate;
 
-	Transform transform = light->GetWorldTransform();
-	transform.SetScale(glm::vec3(light->GetRadius()));
+	ShadowAtlasTile tile;
+	m_Parameters.ShadowMapUpdate = m_ShadowCache.UpdateLight(shadowLight, tile);
 
-	Camera& camera = m_Parameters.Camera->GetCamera();
+	const uint32_t layerSize = PointLightShadowPassParameters::ShadowLayerSize;
 
-	return RenderingHelper::IsLightMeshVisible(m_Parameters.LightMeshVertices, transform, camera);
+	m_Parameters.ShadowSlot = (tile.Y / layerSize) * PointLightShadowPassParameters::ShadowSlotsGridSize + tile.X / layerSize;
+	m_Parameters.ShadowTile = ShadowAtlasTile{ tile.X % layerSize, tile.Y % layerSize, tile.Size };
+
+	const std::vector<std::shared_ptr<StaticMeshComponent>>& meshes = m_Parameters.Meshes.Get();
+
+	for (uint32_t index : m_ShadowCache.GetStaticCasters())
+	{
+		m_Parameters.StaticShadowCasters.push_back(meshes[index]);
+	}
+
+	for (uint32_t index : m_ShadowCache.GetDynamicCasters())
+	{
+		m_Parameters.DynamicShadowCasters.push_back(meshes[index]);
+	}
+}
+
+void PointLightMultiPass::CreatePasses()
+{
+	AddPass<PointLightShadowPass>();
+	AddPass<PointLightShadingPass>();
+	AddPass<PointLightWireframePass>();
 }
@@ -3,10 +3,24 @@
 #include "Core/Rendering/Passes/RenderPass.h"
 #include "Core/Components/PointLightComponent.h"
 #include "Core/Components/CameraComponent.h"
+#include "Core/Components/StaticMeshComponent.h"
+#include "Core/Rendering/ShadowCache.h"
+#include "Core/Rendering/ShadowScheduler.h"
+#include "Core/Rendering/Textures/Texture2DArray.h"
 
 ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(PointLightMultiPass, Multi)
 
 	ED_RENDER_PASS_DECLARE_OBJECT_PTR_PRAMETER(PointLightComponent, Light, "PointLightPass.Light")
+	ED_RENDER_PASS_DECLARE_PARAMETER(LightVolumeVisibility, LightVisibility, "PointLightPass.LightVisibility")
+
+	// Tile is relative to the layers of its slot, every slot holds six layers with the faces of a light
+	ED_RENDER_PASS_DECLARE_PARAMETER(std::vector<glm::mat4>, ShadowViewProjections, "PointLightPass.ShadowViewProjections")
+	ED_RENDER_PASS_DECLARE_PARAMETER(ShadowAtlasTile,        ShadowTile,            "PointLightPass.ShadowTile")
+	ED_RENDER_PASS_DECLARE_PARAMETER(uint32_t,               ShadowSlot,            "PointLightPass.ShadowSlot")
+	ED_RENDER_PASS_DECLARE_PARAMETER(ShadowUpdate,           ShadowMapUpdate,       "PointLightPass.ShadowMapUpdate")
+
+	ED_RENDER_PASS_DECLARE_PARAMETER(std::vector<std::shared_ptr<StaticMeshComponent>>, StaticShadowCasters,  "PointLightPass.StaticShadowCasters")
+	ED_RENDER_PASS_DECLARE_PARAMETER(std::vector<std::shared_ptr<StaticMeshComponent>>, DynamicShadowCasters, "PointLightPass.DynamicShadowCasters")
 
 	ED_RENDER_PASS_DECLARE_PARAMETER(std::vector<glm::vec3>, LightMeshVertices, "PointLightPass.LightMeshVertices")
 	ED_RENDER_PASS_DECLARE_PARAMETER(std::vector<int32_t>,   LightMeshIndices,  "PointLightPass.LightMeshIndices")
@@ -14,6 +28,7 @@ ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(PointLightMultiPass, Multi)
 	ED_RENDER_PASS_OBJECT_PTR_PARAMETER(CameraComponent, Camera, "Camera", Read)
 	
 	ED_RENDER_PASS_PARAMETER(std::vector<std::shared_ptr<PointLightComponent>>, Lights, "Scene.PointLight", Read)
+	ED_RENDER_PASS_PARAMETER(std::vector<std::shared_ptr<StaticMeshComponent>>, Meshes, "Scene.StaticMesh", Read)
 
 ED_END_RENDER_PASS_PARAMETERS_DECLARATION()
 
@@ -21,11 +36,29 @@ class PointLightMultiPass : public MultiPassRenderPass<PointLightMultiPassParame
 {
 	static const uint32_t PointLightMeshSectorsCount = 30;
 	static const uint32_t PointLightMeshStackCount = 30;
+	static const uint32_t MinShadowTileSize = 128;
+	// Texels drawn per frame on average, faces of four 512 tiles
+	static const uint64_t ShadowUpdateBudget = 4 * 6 * 512 * 512;
 public:
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph) override;
 	virtual void Execute() override;
 protected:
 	virtual void CreatePasses();
 
-	bool IsActiveLightVisible();
+	void UpdateShadow(const std::shared_ptr<PointLightComponent>& light);
+
+protected:
+	std::vector<LightVolumeVisibility> m_Visibilities;
+
+	// Atlas is a grid of slots as big as a layer of the shadow map, tiles never cross slots since they are at most that big
+	ShadowCache m_ShadowCache;
+	std::vector<ShadowCaster> m_ShadowCasters;
+
+	ShadowScheduler m_ShadowScheduler;
+	std::vector<ShadowRequest> m_ShadowRequests;
+	// Cache is invalidated when the graph creates the shadow map again
+	std::shared_ptr<Texture2DArray> m_ShadowMap;
+
+	// Drawn lights, their passes are recorded on workers of the graph
+	std::vector<RenderGraphItem> m_Items;
 };
\ No newline at end of file
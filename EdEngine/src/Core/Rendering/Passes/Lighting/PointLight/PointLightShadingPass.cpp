@@ -22,45 +22,82 @@ void PointLightShadingPass::Initialize(std::shared_ptr<RenderGraph> graph)
 
 	m_Parameters.bEnableFaceCulling = true;
 	m_Parameters.FaceToCull = Face::Front;
-
-	m_ShaderParameters.Albedo = m_Parameters.Albedo;
-	m_ShaderParameters.Position = m_Parameters.Position;
-	m_ShaderParameters.Normal = m_Parameters.Normal;
-	m_ShaderParameters.RoughnessMetalic = m_Parameters.RoughnessMetalic;
 }
 
-void PointLightShadingPass::Execute()
+void PointLightShadingPass::PrepareItem(uint32_t index)
 {
-	RenderPass<PointLightShadingPassParameters, PointLightShadingShaderParameters>::Execute();
+	RenderPass<PointLightShadingPassParameters, PointLightShadingShaderParameters>::PrepareItem(index);
+
+	while (m_Items.size() <= index)
+	{
+		m_Items.push_back(std::make_unique<PointLightShadingItem>());
+	}
+
+	PointLightShadingItem& item = *m_Items[index];
+	PointLightShadingShaderParameters& parameters = item.ShaderParameters;
+
+	// Outside of the light volume its front faces cover the same pixels, back faces are needed only when the camera is inside it
+	item.PipelineState = m_Parameters.LightVisibility.Get() == LightVolumeVisibility::Visible ? GetBackFaceCullingPipelineState() : nullptr;
 
-	glm::u32vec2 size = m_Renderer->GetViewportSize();
-	m_Parameters.DrawFramebuffer->Resize(size.x, size.y, 1);
+	parameters.Albedo = m_Parameters.Albedo;
+	parameters.Position = m_Parameters.Position;
+	parameters.Normal = m_Parameters.Normal;
+	parameters.RoughnessMetalic = m_Parameters.RoughnessMetalic;
 
 	std::shared_ptr<PointLightComponent> light = m_Parameters.Light;
-	
-	m_Renderer->SetCamera(m_Parameters.Camera->GetCamera());
 
-	m_ShaderParameters.FarPlane = m_Renderer->GetFarPlane();
-	m_ShaderParameters.PixelSize = 1.0f / glm::vec2(m_Parameters.Albedo->GetSize());
+	parameters.ShadowFarPlane = m_Renderer->GetFarPlane();
+	parameters.PixelSize = 1.0f / glm::vec2(m_Parameters.Albedo->GetSize());
+
+	parameters.Light_Position = light->GetPosition();
+	parameters.Light_Color = light->GetColor();
+	parameters.Light_Intensity = light->GetIntensity();
+	parameters.Light_Radius = light->GetRadius();
 
-	m_ShaderParameters.Light_Position = light->GetPosition();
-	m_ShaderParameters.Light_Color = light->GetColor();
-	m_ShaderParameters.Light_Intensity = light->GetIntensity();
-	m_ShaderParameters.Light_Radius = light->GetRadius();
+	// Light doesn't have a shadow when the atlas has no space left for it
+	const ShadowAtlasTile& tile = m_Parameters.ShadowTile.Get();
+	float layerSize = m_Parameters.ShadowMap->GetSize().x;
 
-	m_ShaderParameters.Light_UseShadowMap = light->IsShadowCasting();
-	m_ShaderParameters.Light_ShadowMap = m_Parameters.ShadowMap.Get();
-	m_ShaderParameters.Light_FilterSize = light->GetShadowFilterSize();
-	m_ShaderParameters.Light_ShadowMapPixelSize = 1.0f / m_Parameters.DrawFramebuffer->GetWidth();
+	parameters.Light_UseShadowMap = light->IsShadowCasting() && tile.IsValid();
+	parameters.Light_ShadowMap = m_Parameters.ShadowMap.Get();
+	parameters.Light_FilterSize = light->GetShadowFilterSize();
+	parameters.Light_ShadowMapPixelSize = 1.0f / layerSize;
+	parameters.Light_ShadowMapTile = glm::vec4(tile.Size, tile.Size, tile.X, tile.Y) / layerSize;
+	parameters.Light_ShadowMapLayer = 6.0f * m_Parameters.ShadowSlot.Get();
 
 	Transform transform = light->GetWorldTransform();
 	transform.SetScale(glm::vec3(light->GetRadius()));
 	
-	m_ShaderParameters.ModelMatrix = transform.GetMatrix();
+	parameters.ModelMatrix = transform.GetMatrix();
+}
+
+void PointLightShadingPass::RecordItem(uint32_t index, const std::shared_ptr<RenderingContext>& context)
+{
+	RenderPass<PointLightShadingPassParameters, PointLightShadingShaderParameters>::RecordItem(index, context);
 
-	SubmitShaderParameters();
+	const PointLightShadingItem& item = *m_Items[index];
+	if (item.PipelineState)
+	{
+		context->SetPipelineState(item.PipelineState);
+	}
+
+	SubmitShaderParameters(item.ShaderParameters, context);
+
+	context->SetVertexBuffer(m_Parameters.LightMeshVBO);
+	context->SetIndexBuffer(m_Parameters.LightMeshIBO);
+	context->Draw();
+}
+
+std::shared_ptr<PipelineState> PointLightShadingPass::GetBackFaceCullingPipelineState()
+{
+	if (m_FrontFaceCullingPipelineState != m_Parameters.PipelineState)
+	{
+		PipelineStateDescription description = m_Parameters.PipelineState->GetDescription();
+		description.FaceToCull = Face::Back;
+
+		m_FrontFaceCullingPipelineState = m_Parameters.PipelineState;
+		m_BackFaceCullingPipelineState = m_Graph->GetPipelineState(description);
+	}
 
-	m_Context->SetVertexBuffer(m_Parameters.LightMeshVBO);
-	m_Context->SetIndexBuffer(m_Parameters.LightMeshIBO);
-	m_Context->Draw();
+	return m_BackFaceCullingPipelineState;
 }
@@ -3,7 +3,8 @@
 #include "Core/Rendering/Passes/RenderPass.h"
 #include "Core/Components/CameraComponent.h"
 #include "Core/Components/PointLightComponent.h"
-#include "Core/Rendering/Textures/CubeTexture.h"
+#include "Core/Rendering/Textures/Texture2DArray.h"
+#include "Core/Rendering/ShadowAtlas.h"
 
 ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(PointLightShadingPass, Base)
 
@@ -16,7 +17,10 @@ ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(PointLightShadingPass, Base)
 	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, Normal,           "GBuffer.Normal",           Read)
 	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, RoughnessMetalic, "GBuffer.RoughnessMetalic", Read)
 
-	ED_RENDER_PASS_RESOURCE_REFERENCE(CubeTexture, ShadowMap, "PointLightPass.ShadowMap", Read)
+	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2DArray, ShadowMap, "PointLightPass.ShadowMap", Read)
+
+	ED_RENDER_PASS_PARAMETER(ShadowAtlasTile, ShadowTile, "PointLightPass.ShadowTile", Read)
+	ED_RENDER_PASS_PARAMETER(uint32_t,        ShadowSlot, "PointLightPass.ShadowSlot", Read)
 
 	ED_RENDER_PASS_PARAMETER(std::vector<glm::vec3>, LightMeshVertices, "PointLightPass.LightMeshVertices", Read)
 	ED_RENDER_PASS_PARAMETER(std::vector<int32_t>,   LightMeshIndices,  "PointLightPass.LightMeshIndices",  Read)
@@ -24,6 +28,8 @@ ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(PointLightShadingPass, Base)
 	ED_RENDER_PASS_OBJECT_PTR_PARAMETER(CameraComponent,     Camera, "Camera",               Read)
 	ED_RENDER_PASS_OBJECT_PTR_PARAMETER(PointLightComponent, Light,  "PointLightPass.Light", Read)
 
+	ED_RENDER_PASS_PARAMETER(LightVolumeVisibility, LightVisibility, "PointLightPass.LightVisibility", Read)
+
 	ED_RENDER_PASS_DECLARE_RESOURCE(VertexBuffer, LightMeshVBO, "PointLightPass.LightMeshVBO")
 	ED_RENDER_PASS_DECLARE_RESOURCE(IndexBuffer,  LightMeshIBO, "PointLightPass.LightMeshIBO")
 
@@ -36,7 +42,7 @@ ED_BEGIN_SHADER_PARAMETERS_DECLARATION(PointLightShading)
 	ED_SHADER_PARAMETER_PTR(Texture, Texture2D, Normal)
 	ED_SHADER_PARAMETER_PTR(Texture, Texture2D, RoughnessMetalic)
 
-	ED_SHADER_PARAMETER(Float, float, FarPlane)
+	ED_SHADER_PARAMETER(Float, float, ShadowFarPlane)
 	ED_SHADER_PARAMETER(Float2, glm::vec2, PixelSize)
 
 	ED_SHADER_PARAMETER_SUBSTRUCT(Light, Float3, glm::vec3, Position)
@@ -46,15 +52,36 @@ ED_BEGIN_SHADER_PARAMETERS_DECLARATION(PointLightShading)
 	ED_SHADER_PARAMETER_SUBSTRUCT(Light, Bool, bool, UseShadowMap)
 	ED_SHADER_PARAMETER_SUBSTRUCT(Light, Float, float, ShadowMapPixelSize)
 	ED_SHADER_PARAMETER_SUBSTRUCT(Light, Float, float, FilterSize)
-	ED_SHADER_PARAMETER_SUBSTRUCT_PTR(Light, Texture, CubeTexture, ShadowMap)
+	ED_SHADER_PARAMETER_SUBSTRUCT(Light, Float4, glm::vec4, ShadowMapTile)
+	ED_SHADER_PARAMETER_SUBSTRUCT(Light, Float, float, ShadowMapLayer)
+	ED_SHADER_PARAMETER_SUBSTRUCT_PTR(Light, Texture, Texture2DArray, ShadowMap)
 
 	ED_SHADER_PARAMETER(Mat4, glm::mat4, ModelMatrix)
 
 ED_END_SHADER_PARAMETERS_DECLARATION()
 
+struct PointLightShadingItem
+{
+	// Replaces the state of the pass when the camera is inside the light volume
+	std::shared_ptr<PipelineState> PipelineState;
+	PointLightShadingShaderParameters ShaderParameters;
+};
+
 class PointLightShadingPass : public RenderPass<PointLightShadingPassParameters, PointLightShadingShaderParameters>
 {
 public:
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph) override;
-	virtual void Execute() override;
+
+	virtual void PrepareItem(uint32_t index) override;
+	virtual void RecordItem(uint32_t index, const std::shared_ptr<RenderingContext>& context) override;
+
+protected:
+	std::shared_ptr<PipelineState> GetBackFaceCullingPipelineState();
+
+protected:
+	std::vector<std::unique_ptr<PointLightShadingItem>> m_Items;
+
+	// Variant of the state created at build culling back faces instead, created again when that state changes
+	std::shared_ptr<PipelineState> m_FrontFaceCullingPipelineState;
+	std::shared_ptr<PipelineState> m_BackFaceCullingPipelineState;
 };
\ No newline at end of file
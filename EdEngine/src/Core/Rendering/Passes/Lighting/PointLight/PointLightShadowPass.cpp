@@ -1,60 +1,116 @@
 #include "PointLightShadowPass.h"
-#include "Core/Assets/StaticMesh.h"
+#include "Core/Rendering/Framebuffer.h"
 
 void PointLightShadowPass::Initialize(std::shared_ptr<RenderGraph> graph)
 {
 	RenderPass<PointLightShadowPassParameters, PointLightShadowPassShaderParameters>::Initialize(graph);
 
 	m_Parameters.Name = "Point light shadow pass";
-	m_Parameters.Shader = RenderingHelper::CreateShader("shaders\\light\\point-light-shadow-pass.glsl");
+	m_Parameters.Shader = RenderingHelper::CreateShader("shaders\\light\\point-light-shadow-pass.glsl", { "INSTANCED" });
 
 	m_Parameters.bUseBlending = false;
-	m_Parameters.bClearDepth = true;
+	// Tiles are cleared one by one, the rest of the layers belongs to other lights
+	m_Parameters.bClearDepth = false;
+
+	m_StaticShadowFramebuffer = RenderingHelper::CreateFramebuffer("Point light static shadows", 1, 1, 1, { { "PointLightPass.StaticShadowMap", FramebufferAttachmentType::Depth } }, TextureType::Texture2DArray);
+	m_StaticShadowFramebuffer->Resize(m_Parameters.ShadowLayerSize, m_Parameters.ShadowLayerSize, 6 * m_Parameters.ShadowSlotsCount);
+
+	m_StaticShadowMap = m_StaticShadowFramebuffer->GetDepthAttachment<Texture2DArray>();
 }
 
-void PointLightShadowPass::Execute()
+void PointLightShadowPass::PrepareItem(uint32_t index)
 {
-	RenderPass<PointLightShadowPassParameters, PointLightShadowPassShaderParameters>::Execute();
+	RenderPass<PointLightShadowPassParameters, PointLightShadowPassShaderParameters>::PrepareItem(index);
+
+	while (m_Items.size() <= index)
+	{
+		m_Items.push_back(std::make_unique<PointLightShadowItem>());
+	}
+
+	PointLightShadowItem& item = *m_Items[index];
+
+	item.Update = m_Parameters.ShadowMapUpdate.Get();
+	if (item.Update == ShadowUpdate::None)
+	{
+		return;
+	}
 
-	std::shared_ptr<PointLightComponent> light = m_Parameters.Light;
+	item.Tile = m_Parameters.ShadowTile.Get();
+	item.FirstLayer = 6 * m_Parameters.ShadowSlot.Get();
 
-	glm::u32vec2 size = m_Renderer->GetViewportSize();
-	m_Parameters.DrawFramebuffer->Resize(size.x, size.x, size.x);
+	const std::vector<glm::mat4>& viewProjections = m_Parameters.ShadowViewProjections.Get();
+	for (int32_t i = 0; i < 6; ++i)
+	{
+		item.ShaderParameters.ViewProjection[i] = viewProjections[i];
+	}
+
+	item.ShaderParameters.FarPlane = m_Renderer->GetFarPlane();
+	item.ShaderParameters.FirstLayer = item.FirstLayer;
+	item.ShaderParameters.ViewPosition = m_Parameters.Light->GetPosition();
 
-	if (light->IsShadowCasting())
+	if (item.Update == ShadowUpdate::Full)
 	{
-		static const glm::mat4 perspective = glm::perspective(glm::radians(90.0f), 1.0f, 1.0f, m_Renderer->GetFarPlane());
+		FillCasters(item.StaticQueue, item.StaticInstances, m_Parameters.StaticCasters.Get());
+	}
 
-		for (int32_t i = 0; i < 6; ++i)
-		{
-			m_ShaderParameters.ViewProjection[i] = perspective * light->GetShadowMapPassCameraTransformation(i);
-		}
+	FillCasters(item.DynamicQueue, item.DynamicInstances, m_Parameters.DynamicCasters.Get());
+}
 
-		m_ShaderParameters.FarPlane = m_Renderer->GetFarPlane();
+void PointLightShadowPass::RecordItem(uint32_t index, const std::shared_ptr<RenderingContext>& context)
+{
+	RenderPass<PointLightShadowPassParameters, PointLightShadowPassShaderParameters>::RecordItem(index, context);
+
+	PointLightShadowItem& item = *m_Items[index];
+	if (item.Update == ShadowUpdate::None)
+	{
+		return;
+	}
 
-		m_ShaderParameters.ViewPosition = light->GetPosition();
+	const ShadowAtlasTile& tile = item.Tile;
 
-		for (const std::shared_ptr<StaticMeshComponent>& component : m_Parameters.Meshes.Get())
-		{
-			if (std::shared_ptr<StaticMesh> mesh = component->GetStaticMesh())
-			{
-				Transform worldTransform = component->GetWorldTransform();
-				Transform previousWorldTransform = component->GetPreviousWorldTransform();
+	glm::u32vec3 offset = glm::u32vec3(tile.X, tile.Y, item.FirstLayer);
+	glm::u32vec3 size = glm::u32vec3(tile.Size, tile.Size, 6);
 
-				for (const std::shared_ptr<StaticSubmesh>& submesh : mesh->GetSubmeshes())
-				{
-					if (std::shared_ptr<Material> material = submesh->GetMaterial())
-					{
-						m_ShaderParameters.ModelMatrix = worldTransform.GetMatrix();
+	SubmitShaderParameters(item.ShaderParameters, context);
 
-						SubmitShaderParameters();
+	if (item.Update == ShadowUpdate::Full)
+	{
+		context->SetFramebuffer(m_StaticShadowFramebuffer);
+		context->SetViewport(tile.X, tile.Y, tile.Size, tile.Size);
+		context->ClearDepthTarget(m_StaticShadowMap, offset, size);
+
+		DrawCasters(item.StaticQueue, item.StaticInstances, context);
+
+		context->SetFramebuffer(m_Parameters.DrawFramebuffer);
+	}
+
+	context->CopyTexture(m_StaticShadowMap, m_Parameters.ShadowMap, offset, size);
+
+	context->SetViewport(tile.X, tile.Y, tile.Size, tile.Size);
+	DrawCasters(item.DynamicQueue, item.DynamicInstances, context);
+}
+
+void PointLightShadowPass::FillCasters(RenderQueue& queue, InstanceBuffer& instances, const std::vector<std::shared_ptr<StaticMeshComponent>>& casters)
+{
+	RenderingHelper::FillShadowRenderQueue(queue, casters);
+	instances.Fill(queue);
+}
+
+void PointLightShadowPass::DrawCasters(const RenderQueue& queue, InstanceBuffer& instances, const std::shared_ptr<RenderingContext>& context)
+{
+	if (queue.GetBatches().empty())
+	{
+		return;
+	}
+
+	instances.Bind(context);
+
+	for (const DrawBatch& batch : queue.GetBatches())
+	{
+		const DrawCommand& command = queue.GetCommand(queue.GetPackets()[batch.FirstPacket]);
 
-						m_Context->SetVertexBuffer(submesh->GetVertexBuffer());
-						m_Context->SetIndexBuffer(submesh->GetIndexBuffer());
-						m_Context->Draw();
-					}
-				}
-			}
-		}
+		context->SetVertexBuffer(command.Submesh->GetVertexBuffer());
+		context->SetIndexBuffer(command.Submesh->GetIndexBuffer());
+		context->DrawInstanced(batch.Count, batch.FirstPacket);
 	}
 }
\ No newline at end of file
@@ -1,38 +1,76 @@
 #pragma once
 
 #include "Core/Rendering/Passes/RenderPass.h"
+#include "Core/Rendering/RenderQueue.h"
+#include "Core/Rendering/InstanceBuffer.h"
+#include "Core/Rendering/ShadowCache.h"
 #include "Core/Components/StaticMeshComponent.h"
 #include "Core/Components/PointLightComponent.h"
-#include "Core/Components/CameraComponent.h"
-#include "Core/Rendering/Textures/CubeTexture.h"
+#include "Core/Rendering/Textures/Texture2DArray.h"
 
 ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(PointLightShadowPass, Base)
 
-	ED_RENDER_PASS_DECLARE_RENDER_TARGET(CubeTexture, ShadowMap, Depth, "PointLightPass.ShadowMap")
-	
-	ED_RENDER_PASS_PARAMETER(std::vector<std::shared_ptr<StaticMeshComponent>>, Meshes, "Scene.StaticMesh", Read)
+	static const uint32_t ShadowLayerSize = 1024;
+	static const uint32_t ShadowSlotsGridSize = 2;
+	static const uint32_t ShadowSlotsCount = ShadowSlotsGridSize * ShadowSlotsGridSize;
 
-	ED_RENDER_PASS_OBJECT_PTR_PARAMETER(PointLightComponent, Light,  "PointLightPass.Light", Read)
-	ED_RENDER_PASS_OBJECT_PTR_PARAMETER(CameraComponent,     Camera, "Camera", Read)
+	// Faces of all point lights, slot n takes layers 6n to 6n + 5 and each light draws only into its tile of them
+	ED_RENDER_PASS_DECLARE_FIXED_SIZE_RENDER_TARGET(Texture2DArray, ShadowMap, Depth, ShadowLayerSize, 6 * ShadowSlotsCount, "PointLightPass.ShadowMap")
+
+	ED_RENDER_PASS_PARAMETER(std::vector<std::shared_ptr<StaticMeshComponent>>, StaticCasters,  "PointLightPass.StaticShadowCasters",  Read)
+	ED_RENDER_PASS_PARAMETER(std::vector<std::shared_ptr<StaticMeshComponent>>, DynamicCasters, "PointLightPass.DynamicShadowCasters", Read)
+
+	ED_RENDER_PASS_PARAMETER(std::vector<glm::mat4>, ShadowViewProjections, "PointLightPass.ShadowViewProjections", Read)
+	ED_RENDER_PASS_PARAMETER(ShadowAtlasTile,        ShadowTile,            "PointLightPass.ShadowTile",            Read)
+	ED_RENDER_PASS_PARAMETER(uint32_t,               ShadowSlot,            "PointLightPass.ShadowSlot",            Read)
+	ED_RENDER_PASS_PARAMETER(ShadowUpdate,           ShadowMapUpdate,       "PointLightPass.ShadowMapUpdate",       Read)
+
+	ED_RENDER_PASS_OBJECT_PTR_PARAMETER(PointLightComponent, Light, "PointLightPass.Light", Read)
 
 ED_END_RENDER_PASS_PARAMETERS_DECLARATION()
 
 ED_BEGIN_SHADER_PARAMETERS_DECLARATION(PointLightShadowPass)
 
 	ED_SHADER_PARAMETER(Float, float, FarPlane)
+	ED_SHADER_PARAMETER(Float, float, FirstLayer)
 	ED_SHADER_PARAMETER_ARRAY(Mat4, glm::mat4, ViewProjection, 6)
 	ED_SHADER_PARAMETER(Float3, glm::vec3, ViewPosition)
 
-	ED_SHADER_PARAMETER(Mat4, glm::mat4, ModelMatrix)
-
 ED_END_SHADER_PARAMETERS_DECLARATION()
 
+// Shadow of a light with its casters already uploaded, lights are recorded only after all of them are prepared
+struct PointLightShadowItem
+{
+	ShadowUpdate Update = ShadowUpdate::None;
+	ShadowAtlasTile Tile;
+	uint32_t FirstLayer = 0;
+
+	PointLightShadowPassShaderParameters ShaderParameters;
+
+	RenderQueue StaticQueue;
+	InstanceBuffer StaticInstances;
+
+	RenderQueue DynamicQueue;
+	InstanceBuffer DynamicInstances;
+};
+
 class PointLightShadowPass : public RenderPass<PointLightShadowPassParameters, PointLightShadowPassShaderParameters>
 {
 public:
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph) override;
-	virtual void Execute() override;
+
+	virtual void PrepareItem(uint32_t index) override;
+	virtual void RecordItem(uint32_t index, const std::shared_ptr<RenderingContext>& context) override;
 
 protected:
-	bool IsActiveLightVisible();
+	void FillCasters(RenderQueue& queue, InstanceBuffer& instances, const std::vector<std::shared_ptr<StaticMeshComponent>>& casters);
+	void DrawCasters(const RenderQueue& queue, InstanceBuffer& instances, const std::shared_ptr<RenderingContext>& context);
+
+protected:
+	// Same layout as the shadow map with only static casters, tiles are copied from it before dynamic casters are drawn
+	std::shared_ptr<Framebuffer> m_StaticShadowFramebuffer;
+	std::shared_ptr<Texture2DArray> m_StaticShadowMap;
+
+	// Kept between frames, so queues and instance buffers of lights aren't allocated again
+	std::vector<std::unique_ptr<PointLightShadowItem>> m_Items;
 };
\ No newline at end of file
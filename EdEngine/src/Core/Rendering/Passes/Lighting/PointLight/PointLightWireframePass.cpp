@@ -11,28 +11,30 @@ void PointLightWireframePass::Initialize(std::shared_ptr<RenderGraph> graph)
 	m_Parameters.DestinationFactor = BlendFactor::One;
 }
 
-void PointLightWireframePass::Execute()
+void PointLightWireframePass::PrepareItem(uint32_t index)
 {
-	RenderPass<PointLightWireframePassParameters, PointLightWireframePassShaderParameters>::Execute();
+	RenderPass<PointLightWireframePassParameters, PointLightWireframePassShaderParameters>::PrepareItem(index);
 
-	glm::u32vec2 size = m_Renderer->GetViewportSize();
-	m_Parameters.DrawFramebuffer->Resize(size.x, size.y, 1);
-
-	if (m_Parameters.Light->ShouldShowWireframe())
+	while (m_Items.size() <= index)
 	{
-		m_Renderer->SetCamera(m_Parameters.Camera->GetCamera());
+		m_Items.push_back(std::make_unique<PointLightWireframePassShaderParameters>());
+	}
+
+	std::shared_ptr<PointLightComponent> light = m_Parameters.Light;
 
-		std::shared_ptr<PointLightComponent> light = m_Parameters.Light;
+	Transform transform = light->GetWorldTransform();
+	transform.SetScale(glm::vec3(light->GetRadius()));
 
-		Transform transform = light->GetWorldTransform();
-		transform.SetScale(glm::vec3(light->GetRadius()));
+	m_Items[index]->ModelMatrix = transform.GetMatrix();
+}
 
-		m_ShaderParameters.ModelMatrix = transform.GetMatrix();
+void PointLightWireframePass::RecordItem(uint32_t index, const std::shared_ptr<RenderingContext>& context)
+{
+	RenderPass<PointLightWireframePassParameters, PointLightWireframePassShaderParameters>::RecordItem(index, context);
 
-		SubmitShaderParameters();
+	SubmitShaderParameters(*m_Items[index], context);
 
-		m_Context->SetVertexBuffer(m_Parameters.LightMeshVBO);
-		m_Context->SetIndexBuffer(m_Parameters.LightMeshIBO);
-		m_Context->Draw(DrawMode::LineStrip);
-	}
+	context->SetVertexBuffer(m_Parameters.LightMeshVBO);
+	context->SetIndexBuffer(m_Parameters.LightMeshIBO);
+	context->Draw(DrawMode::LineStrip);
 }
@@ -4,6 +4,27 @@
 #include "SpotLightWireframePass.h"
 #include "Utils/GeometryBuilder.h"
 
+static glm::vec3 GetLightDirection(const std::shared_ptr<SpotLightComponent>& light)
+{
+	return light->GetWorldTransform().GetRotation() * glm::vec3(0.0f, -1.0f, 0.0f);
+}
+
+// Tightest sphere around the cone of a light, same as the one light clusters use
+static glm::vec4 GetLightBoundingSphere(const glm::vec3& position, const glm::vec3& direction, float range, float outerAngle)
+{
+	float angle = glm::min(outerAngle, glm::radians(89.0f));
+	float angleCos = glm::cos(angle);
+	float angleSin = glm::sin(angle);
+
+	if (angleCos < angleSin)
+	{
+		return glm::vec4(position + direction * (range * angleCos), range * angleSin);
+	}
+
+	float radius = range / (2.0f * angleCos);
+	return glm::vec4(position + direction * radius, radius);
+}
+
 void SpotLightMultiPass::Initialize(std::shared_ptr<RenderGraph> graph)
 {
 	MultiPassRenderPass<SpotLightMultiPassParameters, ShaderParameters>::Initialize(graph);
@@ -16,45 +37,152 @@ void SpotLightMultiPass::Initialize(std::shared_ptr<RenderGraph> graph)
 		m_Parameters.LightMeshVertices = std::move(vertices);
 		m_Parameters.LightMeshIndices = std::move(indices);
 	}
+
+	const uint64_t atlasSize = SpotLightShadowPassParameters::ShadowAtlasSize;
+
+	m_ShadowCache.Reset(atlasSize, MinShadowTileSize);
+	m_ShadowScheduler.Reset(MinShadowTileSize, MaxShadowTileSize, atlasSize * atlasSize, ShadowUpdateBudget);
 }
 
 void SpotLightMultiPass::Execute()
 {
 	MultiPassRenderPass<SpotLightMultiPassParameters, ShaderParameters>::Execute();
 
-	for (const std::shared_ptr<SpotLightComponent>& light : m_Parameters.Lights.Get())
+	const std::vector<std::shared_ptr<SpotLightComponent>>& lights = m_Parameters.Lights.Get();
+	RenderingHelper::ClassifySpotLights(lights, m_Parameters.Camera->GetCamera(), m_Visibilities);
+
+	std::shared_ptr<Texture2D> shadowMap = GetPass<SpotLightShadowPass>()->GetParameters().ShadowMap;
+	if (m_ShadowMap != shadowMap)
+	{
+		m_ShadowMap = shadowMap;
+		m_ShadowCache.Invalidate();
+	}
+
+	// Only lights drawn this frame are updated, hidden ones keep their tiles until they are evicted
+	RenderingHelper::FillShadowCasters(m_ShadowCasters, m_Parameters.Meshes.Get());
+	m_ShadowCache.BeginFrame(m_ShadowCasters);
+
+	// Shadows of lights drawn this frame share the atlas and the update budget
+	m_ShadowRequests.clear();
+	for (uint32_t i = 0; i < lights.size(); ++i)
+	{
+		const std::shared_ptr<SpotLightComponent>& light = lights[i];
+		if (light->IsShadowCasting() && !light->IsBaked() && light->GetIntensity() != 0 && m_Visibilities[i] != LightVolumeVisibility::Hidden)
+		{
+			ShadowRequest& request = m_ShadowRequests.emplace_back();
+			request.Key = light.get();
+			request.BoundingSphere = GetLightBoundingSphere(light->GetPosition(), GetLightDirection(light), light->GetMaxDistance(), light->GetOuterAngle());
+			request.Intensity = light->GetIntensity();
+		}
+	}
+
+	const Camera& camera = m_Parameters.Camera->GetCamera();
+	m_ShadowScheduler.SetView(camera.GetPosition(), camera.GetFOVRadians(), m_Renderer->GetViewportSize(), m_Renderer->GetFarPlane());
+	m_ShadowScheduler.Schedule(m_ShadowRequests);
+
+	// Passes read the view of the camera while they are recorded, so it is uploaded once before all of them
+	m_Renderer->SetCamera(camera);
+
+	std::shared_ptr<BaseRenderPass> shadowPass = GetPass<SpotLightShadowPass>();
+	std::shared_ptr<BaseRenderPass> shadingPass = GetPass<SpotLightShadingPass>();
+	std::shared_ptr<BaseRenderPass> wireframePass = GetPass<SpotLightWireframePass>();
+
+	// Lights are prepared in order, so they take atlas tiles and caster uploads as before, and then recorded together
+	m_Items.clear();
+	for (uint32_t i = 0; i < lights.size(); ++i)
 	{
+		const std::shared_ptr<SpotLightComponent>& light = lights[i];
 		m_Parameters.Light = light;
-		
-		if (light->GetIntensity() != 0 && IsActiveLightVisible())
+
+		// Lights without shadows are shaded by the clustered lighting pass and baked ones by lightmaps, only their wireframes are drawn here
+		bool bIsShadedElsewhere = light->IsBaked() || (m_Renderer->IsClusteredLightingEnabled() && !light->IsShadowCasting());
+		if (bIsShadedElsewhere && !light->ShouldShowWireframe())
+		{
+			continue;
+		}
+
+		if (light->GetIntensity() != 0 && m_Visibilities[i] != LightVolumeVisibility::Hidden)
 		{
-			for (const std::shared_ptr<BaseRenderPass>& pass : m_Passes)
+			m_Parameters.LightVisibility = m_Visibilities[i];
+
+			// Light names aren't unique, index keeps their scopes apart
+			RenderGraphItem& item = m_Items.emplace_back();
+			item.Name = std::to_string(i) + ". " + light->GetName();
+			item.Index = m_Items.size() - 1;
+
+			if (!bIsShadedElsewhere)
+			{
+				UpdateShadow(light);
+
+				item.Passes.push_back(shadowPass);
+				item.Passes.push_back(shadingPass);
+			}
+
+			if (light->ShouldShowWireframe())
+			{
+				item.Passes.push_back(wireframePass);
+			}
+
+			for (const std::shared_ptr<BaseRenderPass>& pass : item.Passes)
 			{
-				m_Graph->ExecutePass(pass);
+				pass->PrepareItem(item.Index);
 			}
 		}
 	}
-}
 
-void SpotLightMultiPass::CreatePasses()
-{
-	AddPass<SpotLightShadowPass>();
-	AddPass<SpotLightShadingPass>();
-	AddPass<SpotLightWireframePass>();
+	m_Graph->RecordItems(m_Items);
+
+	m_ShadowCache.EndFrame();
 }
 
-bool SpotLightMultiPass::IsActiveLightVisible()
+void SpotLightMultiPass::UpdateShadow(const std::shared_ptr<SpotLightComponent>& light)
 {
-	std::shared_ptr<SpotLightComponent> light = m_Parameters.Light;
+	m_Parameters.StaticShadowCasters.clear();
+	m_Parameters.DynamicShadowCasters.clear();
+
+	if (!light->IsShadowCasting())
+	{
+		m_Parameters.ShadowTile = ShadowAtlasTile();
+		m_Parameters.ShadowMapUpdate = ShadowUpdate::None;
+		return;
+	}
 
-	const float angle = light->GetOuterAngle();
-	const float length = light->GetMaxDistance();
-	const float radius = glm::tan(angle) * length;
+	glm::vec3 position = light->GetPosition();
+	glm::vec3 direction = GetLightDirection(light);
 
-	Transform transform = light->GetWorldTransform();
-	transform.SetScale(glm::vec3(radius, length, radius));
+	// Atlas tiles are square
+	glm::mat4 view = glm::lookAt(position, position + direction, glm::vec3(0.0f, 0.0f, 1.0f));
+	glm::mat4 projection = glm::perspective(light->GetOuterAngle() * 2.0f, 1.0f, 1.0f, m_Renderer->GetFarPlane());
 
-	Camera& camera = m_Parameters.Camera->GetCamera();
+	m_Parameters.ShadowProjectionViewMatrix = projection * view;
 
-	return RenderingHelper::IsLightMeshVisible(m_Parameters.LightMeshVertices, transform, camera);
+	ShadowLight shadowLight;
+	shadowLight.Key = light.get();
+	shadowLight.BoundingSphere = GetLightBoundingSphere(position, direction, light->GetMaxDistance(), light->GetOuterAngle());
+	shadowLight.ProjectionView = m_Parameters.ShadowProjectionViewMatrix;
+
+	const ShadowSchedule& schedule = m_ShadowScheduler.GetSchedule(light.get());
+	shadowLight.TileSize = schedule.TileSize;
+	shadowLight.bShouldUpdate = schedule.bShouldUpdate;
+
+	m_Parameters.ShadowMapUpdate = m_ShadowCache.UpdateLight(shadowLight, m_Parameters.ShadowTile);
+
+	const std::vector<std::shared_ptr<StaticMeshComponent>>& meshes = m_Parameters.Meshes.Get();
+
+	for (uint32_t index : m_ShadowCache.GetStaticCasters())
+	{
+		m_Parameters.StaticShadowCasters.push_back(meshes[index]);
+	}
+
+	for (uint32_t index : m_ShadowCache.GetDynamicCasters())
+	{
+		m_Parameters.DynamicShadowCasters.push_back(meshes[index]);
+	}
+}
+
+void SpotLightMultiPass::CreatePasses()
+{
+	AddPass<SpotLightShadowPass>();
+	AddPass<SpotLightShadingPass>();
+	AddPass<SpotLightWireframePass>();
 }
@@ -3,10 +3,21 @@
 #include "Core/Rendering/Passes/RenderPass.h"
 #include "Core/Components/SpotLightComponent.h"
 #include "Core/Components/CameraComponent.h"
+#include "Core/Components/StaticMeshComponent.h"
+#include "Core/Rendering/ShadowCache.h"
+#include "Core/Rendering/ShadowScheduler.h"
 
 ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(SpotLightMultiPass, Multi)
 
 	ED_RENDER_PASS_DECLARE_OBJECT_PTR_PRAMETER(SpotLightComponent, Light, "SpotLightPass.Light")
+	ED_RENDER_PASS_DECLARE_PARAMETER(LightVolumeVisibility, LightVisibility, "SpotLightPass.LightVisibility")
+
+	ED_RENDER_PASS_DECLARE_PARAMETER(glm::mat4,       ShadowProjectionViewMatrix, "SpotLightPass.ShadowProjectionViewMatrix")
+	ED_RENDER_PASS_DECLARE_PARAMETER(ShadowAtlasTile, ShadowTile,                 "SpotLightPass.ShadowTile")
+	ED_RENDER_PASS_DECLARE_PARAMETER(ShadowUpdate,    ShadowMapUpdate,            "SpotLightPass.ShadowMapUpdate")
+
+	ED_RENDER_PASS_DECLARE_PARAMETER(std::vector<std::shared_ptr<StaticMeshComponent>>, StaticShadowCasters,  "SpotLightPass.StaticShadowCasters")
+	ED_RENDER_PASS_DECLARE_PARAMETER(std::vector<std::shared_ptr<StaticMeshComponent>>, DynamicShadowCasters, "SpotLightPass.DynamicShadowCasters")
 	
 	ED_RENDER_PASS_DECLARE_PARAMETER(std::vector<glm::vec3>, LightMeshVertices, "SpotLightPass.LightMeshVertices")
 	ED_RENDER_PASS_DECLARE_PARAMETER(std::vector<int32_t>,   LightMeshIndices,  "SpotLightPass.LightMeshIndices")
@@ -14,17 +25,36 @@ ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(SpotLightMultiPass, Multi)
 	ED_RENDER_PASS_OBJECT_PTR_PARAMETER(CameraComponent, Camera, "Camera", Read)
 
 	ED_RENDER_PASS_PARAMETER(std::vector<std::shared_ptr<SpotLightComponent>>, Lights, "Scene.SpotLight", Read)
+	ED_RENDER_PASS_PARAMETER(std::vector<std::shared_ptr<StaticMeshComponent>>, Meshes, "Scene.StaticMesh", Read)
 
 ED_END_RENDER_PASS_PARAMETERS_DECLARATION()
 
 class SpotLightMultiPass : public MultiPassRenderPass<SpotLightMultiPassParameters, ShaderParameters>
 {
 	static const int32_t SpotLightMeshSectorsCount = 50;
+	static const uint32_t MaxShadowTileSize = 1024;
+	static const uint32_t MinShadowTileSize = 128;
+	// Texels drawn per frame on average, four of the biggest tiles
+	static const uint64_t ShadowUpdateBudget = 4 * MaxShadowTileSize * MaxShadowTileSize;
 public:
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph) override;
 	virtual void Execute() override;
 protected:
 	virtual void CreatePasses();
 
-	bool IsActiveLightVisible();
+	void UpdateShadow(const std::shared_ptr<SpotLightComponent>& light);
+
+protected:
+	std::vector<LightVolumeVisibility> m_Visibilities;
+
+	ShadowCache m_ShadowCache;
+	std::vector<ShadowCaster> m_ShadowCasters;
+
+	ShadowScheduler m_ShadowScheduler;
+	std::vector<ShadowRequest> m_ShadowRequests;
+	// Cache is invalidated when the graph creates the atlas again
+	std::shared_ptr<Texture2D> m_ShadowMap;
+
+	// Drawn lights, their passes are recorded on workers of the graph
+	std::vector<RenderGraphItem> m_Items;
 };
\ No newline at end of file
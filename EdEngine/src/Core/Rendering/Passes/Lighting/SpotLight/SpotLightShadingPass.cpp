@@ -36,46 +36,58 @@ void SpotLightShadingPass::Initialize(std::shared_ptr<RenderGraph> graph)
 
 	m_Parameters.bEnableFaceCulling = true;
 	m_Parameters.FaceToCull = Face::Front;
-
-	m_ShaderParameters.Albedo = m_Parameters.Albedo;
-	m_ShaderParameters.Position = m_Parameters.Position;
-	m_ShaderParameters.Normal = m_Parameters.Normal;
-	m_ShaderParameters.RoughnessMetalic = m_Parameters.RoughnessMetalic;
 }
 
-void SpotLightShadingPass::Execute()
+void SpotLightShadingPass::PrepareItem(uint32_t index)
 {
-	RenderPass<SpotLightShadingParameters, SpotLightShadingShaderParameters>::Execute();
+	RenderPass<SpotLightShadingParameters, SpotLightShadingShaderParameters>::PrepareItem(index);
+
+	while (m_Items.size() <= index)
+	{
+		m_Items.push_back(std::make_unique<SpotLightShadingItem>());
+	}
+
+	SpotLightShadingItem& item = *m_Items[index];
+	SpotLightShadingShaderParameters& parameters = item.ShaderParameters;
 
-	glm::u32vec2 size = m_Renderer->GetViewportSize();
-	m_Parameters.DrawFramebuffer->Resize(size.x, size.y, 1);
+	// Outside of the light volume its front faces cover the same pixels, back faces are needed only when the camera is inside it
+	item.PipelineState = m_Parameters.LightVisibility.Get() == LightVolumeVisibility::Visible ? GetBackFaceCullingPipelineState() : nullptr;
 
-	m_Renderer->SetCamera(m_Parameters.Camera->GetCamera());
+	parameters.Albedo = m_Parameters.Albedo;
+	parameters.Position = m_Parameters.Position;
+	parameters.Normal = m_Parameters.Normal;
+	parameters.RoughnessMetalic = m_Parameters.RoughnessMetalic;
 
-	m_ShaderParameters.FarPlane = m_Renderer->GetFarPlane();
-	m_ShaderParameters.PixelSize = 1.0f / glm::vec2(m_Parameters.Albedo->GetSize());
+	parameters.FarPlane = m_Renderer->GetFarPlane();
+	parameters.PixelSize = 1.0f / glm::vec2(m_Parameters.Albedo->GetSize());
 
 	std::shared_ptr<SpotLightComponent> light = m_Parameters.Light;
 
-	m_ShaderParameters.Light_Color = light->GetColor();
-	m_ShaderParameters.Light_MaxDistance = light->GetMaxDistance();
-	m_ShaderParameters.Light_Intensity = light->GetIntensity();
-	m_ShaderParameters.Light_Position = light->GetPosition();
+	parameters.Light_Color = light->GetColor();
+	parameters.Light_MaxDistance = light->GetMaxDistance();
+	parameters.Light_Intensity = light->GetIntensity();
+	parameters.Light_Position = light->GetPosition();
 
-	m_ShaderParameters.Light_InnerAngleCos = glm::cos(light->GetInnerAngle());
-	m_ShaderParameters.Light_OuterAngleCos = glm::cos(light->GetOuterAngle());
+	parameters.Light_InnerAngleCos = glm::cos(light->GetInnerAngle());
+	parameters.Light_OuterAngleCos = glm::cos(light->GetOuterAngle());
 
-	m_ShaderParameters.Light_IsShadowCasting = light->IsShadowCasting();
-	m_ShaderParameters.Light_ShadowMap = m_ShaderParameters.Light_IsShadowCasting ? m_Parameters.ShadowMap.Get() : RenderingHelper::GetWhiteTexture();
+	parameters.Light_ShadowSamples = m_ShaderParameters.Light_ShadowSamples;
+	parameters.Light_ShadowSamplesPixelSize = m_ShaderParameters.Light_ShadowSamplesPixelSize;
 
-	if (m_ShaderParameters.Light_IsShadowCasting)
+	// Light doesn't have a shadow when the atlas has no space left for it
+	const ShadowAtlasTile& tile = m_Parameters.ShadowTile.Get();
+	parameters.Light_IsShadowCasting = light->IsShadowCasting() && tile.IsValid();
+	parameters.Light_ShadowMap = parameters.Light_IsShadowCasting ? m_Parameters.ShadowMap.Get() : RenderingHelper::GetWhiteTexture();
+
+	if (parameters.Light_IsShadowCasting)
 	{
-		m_ShaderParameters.Light_ShadowMapPixelSize = glm::vec2(1.0f / m_ShaderParameters.Light_ShadowMap->GetWidth(), 1.0f / m_ShaderParameters.Light_ShadowMap->GetHeight());
+		parameters.Light_ShadowMapPixelSize = glm::vec2(1.0f / parameters.Light_ShadowMap->GetWidth(), 1.0f / parameters.Light_ShadowMap->GetHeight());
+		parameters.Light_ShadowMapTile = glm::vec4(tile.Size, tile.Size, tile.X, tile.Y) / (float)parameters.Light_ShadowMap->GetWidth();
 
-		m_ShaderParameters.Light_ShadowProjectionViewMatrix = m_Parameters.ShadowProjectionViewMatrix;
+		parameters.Light_ShadowProjectionViewMatrix = m_Parameters.ShadowProjectionViewMatrix;
 
-		m_ShaderParameters.Light_ShadowFilterSize = light->GetShadowFilterSize();
-		m_ShaderParameters.Light_ShadowFilterRadius = light->GetShadowFilterRadius();
+		parameters.Light_ShadowFilterSize = light->GetShadowFilterSize();
+		parameters.Light_ShadowFilterRadius = light->GetShadowFilterRadius();
 	}
 
 	const float angle = light->GetOuterAngle();
@@ -86,14 +98,25 @@ void SpotLightShadingPass::Execute()
 	transform.SetScale(glm::vec3(radius, length, radius));
 
 	static const glm::vec3 spotLightMeshDirection = glm::vec3(0.0f, -1.0f, 0.0f);
-	m_ShaderParameters.Light_Direction = glm::normalize(transform.GetRotation() * spotLightMeshDirection);
-	m_ShaderParameters.ModelMatrix = transform.GetMatrix();
+	parameters.Light_Direction = glm::normalize(transform.GetRotation() * spotLightMeshDirection);
+	parameters.ModelMatrix = transform.GetMatrix();
+}
 
-	SubmitShaderParameters();
+void SpotLightShadingPass::RecordItem(uint32_t index, const std::shared_ptr<RenderingContext>& context)
+{
+	RenderPass<SpotLightShadingParameters, SpotLightShadingShaderParameters>::RecordItem(index, context);
 
-	m_Context->SetVertexBuffer(m_Parameters.LightMeshVBO);
-	m_Context->SetIndexBuffer(m_Parameters.LightMeshIBO);
-	m_Context->Draw();
+	const SpotLightShadingItem& item = *m_Items[index];
+	if (item.PipelineState)
+	{
+		context->SetPipelineState(item.PipelineState);
+	}
+
+	SubmitShaderParameters(item.ShaderParameters, context);
+
+	context->SetVertexBuffer(m_Parameters.LightMeshVBO);
+	context->SetIndexBuffer(m_Parameters.LightMeshIBO);
+	context->Draw();
 }
 
 void SpotLightShadingPass::SetShadowSamplesBlockCount(uint32_t count)
@@ -126,3 +149,17 @@ void SpotLightShadingPass::UpdateShadowSamplesTexture()
 	m_ShaderParameters.Light_ShadowSamples->SetData(std::move(data));
 	m_ShaderParameters.Light_ShadowSamplesPixelSize = glm::vec2(1.0f / (m_ShadowSamplesBlockSize * m_ShadowSamplesBlockCount), 1.0f / m_ShadowSamplesBlockSize);
 }
+
+std::shared_ptr<PipelineState> SpotLightShadingPass::GetBackFaceCullingPipelineState()
+{
+	if (m_FrontFaceCullingPipelineState != m_Parameters.PipelineState)
+	{
+		PipelineStateDescription description = m_Parameters.PipelineState->GetDescription();
+		description.FaceToCull = Face::Back;
+
+		m_FrontFaceCullingPipelineState = m_Parameters.PipelineState;
+		m_BackFaceCullingPipelineState = m_Graph->GetPipelineState(description);
+	}
+
+	return m_BackFaceCullingPipelineState;
+}
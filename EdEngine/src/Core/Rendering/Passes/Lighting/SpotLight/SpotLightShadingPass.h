@@ -3,6 +3,7 @@
 #include "Core/Rendering/Passes/RenderPass.h"
 #include "Core/Components/SpotLightComponent.h"
 #include "Core/Components/CameraComponent.h"
+#include "Core/Rendering/ShadowAtlas.h"
 
 ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(SpotLightShading, Base)
 
@@ -17,12 +18,15 @@ ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(SpotLightShading, Base)
 	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, ShadowMap,        "SpotLightPass.ShadowMap",  Read)
 
 	ED_RENDER_PASS_PARAMETER(glm::mat4,              ShadowProjectionViewMatrix, "SpotLightPass.ShadowProjectionViewMatrix", Read)
+	ED_RENDER_PASS_PARAMETER(ShadowAtlasTile,        ShadowTile,                 "SpotLightPass.ShadowTile",                 Read)
 	ED_RENDER_PASS_PARAMETER(std::vector<glm::vec3>, LightMeshVertices,          "SpotLightPass.LightMeshVertices",          Read)
 	ED_RENDER_PASS_PARAMETER(std::vector<int32_t>,   LightMeshIndices,           "SpotLightPass.LightMeshIndices",           Read)
 
 	ED_RENDER_PASS_OBJECT_PTR_PARAMETER(CameraComponent,    Camera, "Camera"             , Read)
 	ED_RENDER_PASS_OBJECT_PTR_PARAMETER(SpotLightComponent, Light,  "SpotLightPass.Light", Read)
 
+	ED_RENDER_PASS_PARAMETER(LightVolumeVisibility, LightVisibility, "SpotLightPass.LightVisibility", Read)
+
 	ED_RENDER_PASS_DECLARE_RESOURCE(VertexBuffer, LightMeshVBO, "SpotLightPass.LightMeshVBO")
 	ED_RENDER_PASS_DECLARE_RESOURCE(IndexBuffer,  LightMeshIBO, "SpotLightPass.LightMeshIBO")
 
@@ -48,6 +52,7 @@ ED_BEGIN_SHADER_PARAMETERS_DECLARATION(SpotLightShading)
 	ED_SHADER_PARAMETER_SUBSTRUCT(Light, Bool, bool, IsShadowCasting)
 	ED_SHADER_PARAMETER_SUBSTRUCT_PTR(Light, Texture, Texture2D, ShadowMap)
 	ED_SHADER_PARAMETER_SUBSTRUCT(Light, Float2, glm::vec2, ShadowMapPixelSize)
+	ED_SHADER_PARAMETER_SUBSTRUCT(Light, Float4, glm::vec4, ShadowMapTile)
 	ED_SHADER_PARAMETER_SUBSTRUCT(Light, Mat4, glm::mat4, ShadowProjectionViewMatrix)
 	
 	ED_SHADER_PARAMETER_SUBSTRUCT_PTR(Light, Texture, Texture2D, ShadowSamples)
@@ -62,11 +67,20 @@ ED_BEGIN_SHADER_PARAMETERS_DECLARATION(SpotLightShading)
 ED_END_SHADER_PARAMETERS_DECLARATION()
 
 
+struct SpotLightShadingItem
+{
+	// Replaces the state of the pass when the camera is inside the light volume
+	std::shared_ptr<PipelineState> PipelineState;
+	SpotLightShadingShaderParameters ShaderParameters;
+};
+
 class SpotLightShadingPass : public RenderPass<SpotLightShadingParameters, SpotLightShadingShaderParameters>
 {
 public:
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph) override;
-	virtual void Execute() override;
+
+	virtual void PrepareItem(uint32_t index) override;
+	virtual void RecordItem(uint32_t index, const std::shared_ptr<RenderingContext>& context) override;
 
 	void SetShadowSamplesBlockCount(uint32_t count);
 	uint32_t GetShadowSamplesBlocksCount() const;
@@ -76,8 +90,15 @@ public:
 
 protected:
 	void UpdateShadowSamplesTexture();
+	std::shared_ptr<PipelineState> GetBackFaceCullingPipelineState();
 
 protected:
 	uint32_t m_ShadowSamplesBlockCount = 10;
 	uint32_t m_ShadowSamplesBlockSize = 32;
+
+	std::vector<std::unique_ptr<SpotLightShadingItem>> m_Items;
+
+	// Variant of the state created at build culling back faces instead, created again when that state changes
+	std::shared_ptr<PipelineState> m_FrontFaceCullingPipelineState;
+	std::shared_ptr<PipelineState> m_BackFaceCullingPipelineState;
 };
\ No newline at end of file
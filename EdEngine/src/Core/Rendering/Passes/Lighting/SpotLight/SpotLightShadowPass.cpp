@@ -1,57 +1,105 @@
 #include "SpotLightShadowPass.h"
+#include "Core/Rendering/Framebuffer.h"
 
 void SpotLightShadowPass::Initialize(std::shared_ptr<RenderGraph> graph)
 {
 	RenderPass<SpotLightShadowPassParameters, SpotLightShadowPassShaderParameters>::Initialize(graph);
 
 	m_Parameters.Name = "Spot light shadow pass";
-	m_Parameters.Shader = RenderingHelper::CreateShader("shaders\\light\\spot-light-shadow-pass.glsl");
+	m_Parameters.Shader = RenderingHelper::CreateShader("shaders\\light\\spot-light-shadow-pass.glsl", { "INSTANCED" });
 
 	m_Parameters.bUseBlending = false;
-	m_Parameters.bClearDepth = true;
+	// Tiles are cleared one by one, the rest of the atlas belongs to other lights
+	m_Parameters.bClearDepth = false;
+
+	m_StaticShadowFramebuffer = RenderingHelper::CreateFramebuffer("Spot light static shadows", 1, 1, 1, { { "SpotLightPass.StaticShadowMap", FramebufferAttachmentType::Depth } }, TextureType::Texture2D);
+	m_StaticShadowFramebuffer->Resize(m_Parameters.ShadowAtlasSize, m_Parameters.ShadowAtlasSize, 1);
+
+	m_StaticShadowMap = m_StaticShadowFramebuffer->GetDepthAttachment<Texture2D>();
 }
 
-void SpotLightShadowPass::Execute()
+void SpotLightShadowPass::PrepareItem(uint32_t index)
 {
-	RenderPass<SpotLightShadowPassParameters, SpotLightShadowPassShaderParameters>::Execute();
+	RenderPass<SpotLightShadowPassParameters, SpotLightShadowPassShaderParameters>::PrepareItem(index);
+
+	while (m_Items.size() <= index)
+	{
+		m_Items.push_back(std::make_unique<SpotLightShadowItem>());
+	}
 
-	glm::u32vec2 size = m_Renderer->GetViewportSize();
-	m_Parameters.DrawFramebuffer->Resize(size.x, size.y, 1);
+	SpotLightShadowItem& item = *m_Items[index];
 
-	std::shared_ptr<SpotLightComponent> light = m_Parameters.Light;
+	item.Update = m_Parameters.ShadowMapUpdate.Get();
+	if (item.Update == ShadowUpdate::None)
+	{
+		return;
+	}
+
+	item.Tile = m_Parameters.ShadowTile.Get();
+	item.ShaderParameters.ProjectionViewMatrix = m_Parameters.ShadowProjectionViewMatrix;
 
-	if (light->IsShadowCasting())
+	if (item.Update == ShadowUpdate::Full)
 	{
-		Camera& camera = m_Parameters.Camera->GetCamera();
-
-		glm::mat4 view = glm::lookAt(light->GetPosition(), light->GetPosition() + light->GetWorldTransform().GetRotation() * glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-		glm::mat4 projection = glm::perspective(light->GetOuterAngle() * 2.0f, camera.GetAspect(), 1.0f, m_Renderer->GetFarPlane());
-		
-		m_Parameters.ShadowProjectionViewMatrix = projection * view;
-
-		m_Renderer->SetCamera(view, projection, light->GetPosition());
-
-		for (const std::shared_ptr<StaticMeshComponent>& component : m_Parameters.Meshes.Get())
-		{
-			if (std::shared_ptr<StaticMesh> mesh = component->GetStaticMesh())
-			{
-				Transform worldTransform = component->GetWorldTransform();
-				Transform previousWorldTransform = component->GetPreviousWorldTransform();
-
-				for (const std::shared_ptr<StaticSubmesh>& submesh : mesh->GetSubmeshes())
-				{
-					if (std::shared_ptr<Material> material = submesh->GetMaterial())
-					{
-						m_ShaderParameters.ModelMatrix = worldTransform.GetMatrix();
-						
-						SubmitShaderParameters();
-
-						m_Context->SetVertexBuffer(submesh->GetVertexBuffer());
-						m_Context->SetIndexBuffer(submesh->GetIndexBuffer());
-						m_Context->Draw();
-					}
-				}
-			}
-		}
+		FillCasters(item.StaticQueue, item.StaticInstances, m_Parameters.StaticCasters.Get());
+	}
+
+	FillCasters(item.DynamicQueue, item.DynamicInstances, m_Parameters.DynamicCasters.Get());
+}
+
+void SpotLightShadowPass::RecordItem(uint32_t index, const std::shared_ptr<RenderingContext>& context)
+{
+	RenderPass<SpotLightShadowPassParameters, SpotLightShadowPassShaderParameters>::RecordItem(index, context);
+
+	SpotLightShadowItem& item = *m_Items[index];
+	if (item.Update == ShadowUpdate::None)
+	{
+		return;
+	}
+
+	const ShadowAtlasTile& tile = item.Tile;
+	glm::u32vec3 offset = glm::u32vec3(tile.X, tile.Y, 0);
+	glm::u32vec3 size = glm::u32vec3(tile.Size, tile.Size, 1);
+
+	SubmitShaderParameters(item.ShaderParameters, context);
+
+	if (item.Update == ShadowUpdate::Full)
+	{
+		context->SetFramebuffer(m_StaticShadowFramebuffer);
+		context->SetViewport(tile.X, tile.Y, tile.Size, tile.Size);
+		context->ClearDepthTarget(m_StaticShadowMap, offset, size);
+
+		DrawCasters(item.StaticQueue, item.StaticInstances, context);
+
+		context->SetFramebuffer(m_Parameters.DrawFramebuffer);
+	}
+
+	context->CopyTexture(m_StaticShadowMap, m_Parameters.ShadowMap, offset, size);
+
+	context->SetViewport(tile.X, tile.Y, tile.Size, tile.Size);
+	DrawCasters(item.DynamicQueue, item.DynamicInstances, context);
+}
+
+void SpotLightShadowPass::FillCasters(RenderQueue& queue, InstanceBuffer& instances, const std::vector<std::shared_ptr<StaticMeshComponent>>& casters)
+{
+	RenderingHelper::FillShadowRenderQueue(queue, casters);
+	instances.Fill(queue);
+}
+
+void SpotLightShadowPass::DrawCasters(const RenderQueue& queue, InstanceBuffer& instances, const std::shared_ptr<RenderingContext>& context)
+{
+	if (queue.GetBatches().empty())
+	{
+		return;
+	}
+
+	instances.Bind(context);
+
+	for (const DrawBatch& batch : queue.GetBatches())
+	{
+		const DrawCommand& command = queue.GetCommand(queue.GetPackets()[batch.FirstPacket]);
+
+		context->SetVertexBuffer(command.Submesh->GetVertexBuffer());
+		context->SetIndexBuffer(command.Submesh->GetIndexBuffer());
+		context->DrawInstanced(batch.Count, batch.FirstPacket);
 	}
 }
@@ -1,32 +1,65 @@
 #pragma once
 
 #include "Core/Rendering/Passes/RenderPass.h"
+#include "Core/Rendering/RenderQueue.h"
+#include "Core/Rendering/InstanceBuffer.h"
+#include "Core/Rendering/ShadowCache.h"
 #include "Core/Components/StaticMeshComponent.h"
-#include "Core/Components/SpotLightComponent.h"
-#include "Core/Components/CameraComponent.h"
 
 ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(SpotLightShadowPass, Base)
 
-	ED_RENDER_PASS_DECLARE_RENDER_TARGET(Texture2D, ShadowMap, Depth, "SpotLightPass.ShadowMap")
-	
-	ED_RENDER_PASS_PARAMETER(std::vector<std::shared_ptr<StaticMeshComponent>>, Meshes, "Scene.StaticMesh", Read)
+	static const uint32_t ShadowAtlasSize = 4096;
 
-	ED_RENDER_PASS_OBJECT_PTR_PARAMETER(SpotLightComponent, Light,  "SpotLightPass.Light", Read)
-	ED_RENDER_PASS_OBJECT_PTR_PARAMETER(CameraComponent,    Camera, "Camera",              Read)
+	// Atlas of all spot lights, each light draws only into its tile
+	ED_RENDER_PASS_DECLARE_FIXED_SIZE_RENDER_TARGET(Texture2D, ShadowMap, Depth, ShadowAtlasSize, 1, "SpotLightPass.ShadowMap")
 
-	ED_RENDER_PASS_DECLARE_PARAMETER(glm::mat4, ShadowProjectionViewMatrix, "SpotLightPass.ShadowProjectionViewMatrix")
+	ED_RENDER_PASS_PARAMETER(std::vector<std::shared_ptr<StaticMeshComponent>>, StaticCasters,  "SpotLightPass.StaticShadowCasters",  Read)
+	ED_RENDER_PASS_PARAMETER(std::vector<std::shared_ptr<StaticMeshComponent>>, DynamicCasters, "SpotLightPass.DynamicShadowCasters", Read)
+
+	ED_RENDER_PASS_PARAMETER(glm::mat4,       ShadowProjectionViewMatrix, "SpotLightPass.ShadowProjectionViewMatrix", Read)
+	ED_RENDER_PASS_PARAMETER(ShadowAtlasTile, ShadowTile,                 "SpotLightPass.ShadowTile",                 Read)
+	ED_RENDER_PASS_PARAMETER(ShadowUpdate,    ShadowMapUpdate,            "SpotLightPass.ShadowMapUpdate",            Read)
 
 ED_END_RENDER_PASS_PARAMETERS_DECLARATION()
 
 ED_BEGIN_SHADER_PARAMETERS_DECLARATION(SpotLightShadowPass)
 
-	ED_SHADER_PARAMETER(Mat4, glm::mat4, ModelMatrix)
+	ED_SHADER_PARAMETER(Mat4, glm::mat4, ProjectionViewMatrix)
 
 ED_END_SHADER_PARAMETERS_DECLARATION()
 
+// Shadow of a light with its casters already uploaded, lights are recorded only after all of them are prepared
+struct SpotLightShadowItem
+{
+	ShadowUpdate Update = ShadowUpdate::None;
+	ShadowAtlasTile Tile;
+
+	SpotLightShadowPassShaderParameters ShaderParameters;
+
+	RenderQueue StaticQueue;
+	InstanceBuffer StaticInstances;
+
+	RenderQueue DynamicQueue;
+	InstanceBuffer DynamicInstances;
+};
+
 class SpotLightShadowPass : public RenderPass<SpotLightShadowPassParameters, SpotLightShadowPassShaderParameters>
 {
 public:
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph) override;
-	virtual void Execute() override;
+
+	virtual void PrepareItem(uint32_t index) override;
+	virtual void RecordItem(uint32_t index, const std::shared_ptr<RenderingContext>& context) override;
+
+protected:
+	void FillCasters(RenderQueue& queue, InstanceBuffer& instances, const std::vector<std::shared_ptr<StaticMeshComponent>>& casters);
+	void DrawCasters(const RenderQueue& queue, InstanceBuffer& instances, const std::shared_ptr<RenderingContext>& context);
+
+protected:
+	// Same layout as the atlas with only static casters, tiles are copied from it before dynamic casters are drawn
+	std::shared_ptr<Framebuffer> m_StaticShadowFramebuffer;
+	std::shared_ptr<Texture2D> m_StaticShadowMap;
+
+	// Kept between frames, so queues and instance buffers of lights aren't allocated again
+	std::vector<std::unique_ptr<SpotLightShadowItem>> m_Items;
 };
\ No newline at end of file
@@ -11,32 +11,34 @@ void SpotLightWireframePass::Initialize(std::shared_ptr<RenderGraph> graph)
 	m_Parameters.DestinationFactor = BlendFactor::OneMinusSourceAlpha;
 }
 
-void SpotLightWireframePass::Execute()
+void SpotLightWireframePass::PrepareItem(uint32_t index)
 {
-	RenderPass<SpotLightWireframePassParameters, SpotLightWireframePassShaderParameters>::Execute();
+	RenderPass<SpotLightWireframePassParameters, SpotLightWireframePassShaderParameters>::PrepareItem(index);
 
-	glm::u32vec2 size = m_Renderer->GetViewportSize();
-	m_Parameters.DrawFramebuffer->Resize(size.x, size.y, 1);
+	while (m_Items.size() <= index)
+	{
+		m_Items.push_back(std::make_unique<SpotLightWireframePassShaderParameters>());
+	}
 
 	std::shared_ptr<SpotLightComponent> light = m_Parameters.Light;
 
-	if (light->ShouldShowWireframe())
-	{
-		m_Renderer->SetCamera(m_Parameters.Camera->GetCamera());
+	const float angle = light->GetOuterAngle();
+	const float length = light->GetMaxDistance();
+	const float radius = glm::tan(angle) * length;
 
-		const float angle = light->GetOuterAngle();
-		const float length = light->GetMaxDistance();
-		const float radius = glm::tan(angle) * length;
+	Transform transform = light->GetWorldTransform();
+	transform.SetScale(glm::vec3(radius, length, radius));
 
-		Transform transform = light->GetWorldTransform();
-		transform.SetScale(glm::vec3(radius, length, radius));
+	m_Items[index]->ModelMatrix = transform.GetMatrix();
+}
 
-		m_ShaderParameters.ModelMatrix = transform.GetMatrix();
+void SpotLightWireframePass::RecordItem(uint32_t index, const std::shared_ptr<RenderingContext>& context)
+{
+	RenderPass<SpotLightWireframePassParameters, SpotLightWireframePassShaderParameters>::RecordItem(index, context);
 
-		SubmitShaderParameters();
+	SubmitShaderParameters(*m_Items[index], context);
 
-		m_Context->SetVertexBuffer(m_Parameters.LightMeshVBO);
-		m_Context->SetIndexBuffer(m_Parameters.LightMeshIBO);
-		m_Context->Draw(DrawMode::LineStrip);
-	}
+	context->SetVertexBuffer(m_Parameters.LightMeshVBO);
+	context->SetIndexBuffer(m_Parameters.LightMeshIBO);
+	context->Draw(DrawMode::LineStrip);
 }
@@ -28,5 +28,11 @@ class SpotLightWireframePass : public RenderPass<SpotLightWireframePassParameter
 {
 public:
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph) override;
-	virtual void Execute() override;
+
+	virtual void PrepareItem(uint32_t index) override;
+	virtual void RecordItem(uint32_t index, const std::shared_ptr<RenderingContext>& context) override;
+
+protected:
+	// Only lights showing their wireframes are drawn by the pass
+	std::vector<std::unique_ptr<SpotLightWireframePassShaderParameters>> m_Items;
 };
\ No newline at end of file
@@ -13,6 +13,10 @@ struct RenderTargetDeclaration
 {
 	std::string ResourceName;
 
+	// Transient targets don't own a texture, graph binds them to pooled ones based on their lifetimes
+	bool bIsTransient = false;
+	RenderTargetDescription Description;
+
 	virtual std::shared_ptr<Texture> Declare(std::shared_ptr<RenderGraph> graph) = 0;
 };
 
@@ -101,6 +105,9 @@ struct BaseRenderPassParameters : public RenderPassParameters
 
 	bool bEnableFaceCulling = false;
 	Face FaceToCull = Face::Back;
+
+	// Created from the fields above at RenderGraph::Build, they must not change after it
+	std::shared_ptr<class PipelineState> PipelineState;
 };
 
 struct ComputeRenderPassParameters : public RenderPassParameters
@@ -137,7 +144,7 @@ struct MultiRenderPassParameters : public RenderPassParameters
 
 #define ED_END_RENDER_PASS_PARAMETERS_DECLARATION() };
 
-#define ED_RENDER_PASS_DECLARE_RENDER_TARGET(type, name, attachmentType, resourceName) \
+#define ED_RENDER_PASS_DECLARE_RENDER_TARGET_INTERNAL(type, name, attachmentType, resourceName, transient, scale, minSize, maxSize, layers) \
 	std::shared_ptr<type> name; \
 	private: \
 	\
@@ -158,6 +165,15 @@ struct MultiRenderPassParameters : public RenderPassParameters
 			specification.Name = ResourceName; \
 			\
 			specification.Type = FramebufferAttachmentType::attachmentType; \
+			\
+			bIsTransient = transient; \
+			Description.Type = TextureType::type; \
+			Description.Format = specification.Type; \
+			Description.Scale = scale; \
+			Description.MinSize = minSize; \
+			Description.MaxSize = maxSize; \
+			Description.Layers = layers; \
+			\
 			Parameters.name = RenderingHelper::CreateRenderTarget<type>(specification, TextureType::type); \
 			graph->DeclareResource(specification.Name, Parameters.name); \
 			return Parameters.name; \
@@ -167,6 +183,18 @@ struct MultiRenderPassParameters : public RenderPassParameters
 	\
 	public:
 
+// Graph resizes render targets at the start of a frame, passes must not resize them on their own
+#define ED_RENDER_PASS_DECLARE_RENDER_TARGET(type, name, attachmentType, resourceName) \
+	ED_RENDER_PASS_DECLARE_RENDER_TARGET_INTERNAL(type, name, attachmentType, resourceName, false, 1.0f, 1, UINT32_MAX, 1)
+
+// Size doesn't depend on the viewport, e.g. shadow maps
+#define ED_RENDER_PASS_DECLARE_FIXED_SIZE_RENDER_TARGET(type, name, attachmentType, size, layers, resourceName) \
+	ED_RENDER_PASS_DECLARE_RENDER_TARGET_INTERNAL(type, name, attachmentType, resourceName, false, 0.0f, size, size, layers)
+
+// Texture is shared with other transient targets, so its content is valid only between the first and the last use in a frame. Scale is relative to the render size
+#define ED_RENDER_PASS_DECLARE_TRANSIENT_RENDER_TARGET(type, name, attachmentType, scale, resourceName) \
+	ED_RENDER_PASS_DECLARE_RENDER_TARGET_INTERNAL(type, name, attachmentType, resourceName, true, scale, 1, UINT32_MAX, 1)
+
 #define ED_RENDER_PASS_RENDER_TARGET_REFERENCE(type, name, resourceName) \
 	RefFromShared<type> name; \
 	private: \
@@ -1,10 +1,47 @@
 #pragma once
 
-#include "ParametersCommon.h"
+#include "Core/Ed.h"
+#include "Core/Rendering/Shader.h"
+#include "UniformBufferParameters.h"
+#include <sstream>
 
 struct ShaderParameter
 {
 	virtual void SubmitParameter(std::shared_ptr<RenderingContext> context) = 0;
+
+	// Called on the main thread before the parameter is submitted, parameters set by value don't need it
+	virtual void UploadParameter() {}
+
+protected:
+	static const int32_t UnresolvedLocation = -2;
+
+	// Locations are looked up once and reused until the parameter is submitted to another shader
+	int32_t ResolveLocation(const std::shared_ptr<RenderingContext>& context, const std::string& name, uint32_t index = 0)
+	{
+		const std::shared_ptr<Shader>& shader = context->GetShader();
+		if (shader != m_Shader)
+		{
+			m_Shader = shader;
+			m_Locations.clear();
+		}
+
+		if (index >= m_Locations.size())
+		{
+			m_Locations.resize(index + 1, UnresolvedLocation);
+		}
+
+		int32_t& location = m_Locations[index];
+		if (location == UnresolvedLocation)
+		{
+			location = shader ? shader->GetUniformLocation(name) : -1;
+		}
+
+		return location;
+	}
+
+private:
+	std::shared_ptr<Shader> m_Shader;
+	std::vector<int32_t> m_Locations;
 };
 
 struct ShaderParameters
@@ -28,6 +65,46 @@ private:
 
 #define ED_END_SHADER_PARAMETERS_DECLARATION() };
 
+// Members declared between ED_BEGIN_SHADER_PARAMETERS_BLOCK and ED_END_SHADER_PARAMETERS_BLOCK make name##UniformBufferData,
+// laid out by std140 rules in the same order as the GLSL block bound to the same binding. The block is accessed through the name member,
+// UploadParameter updates its buffer and SubmitParameter binds it
+#define ED_BEGIN_SHADER_PARAMETERS_BLOCK(name, binding) \
+	struct alignas(16) name ## UniformBufferData \
+	{ \
+		static const uint32_t Binding = binding;
+
+#define ED_SHADER_BLOCK_PARAMETER(type, name) \
+		alignas(Std140Alignment<type>::Value) type name;
+
+#define ED_END_SHADER_PARAMETERS_BLOCK(name) \
+	}; \
+	\
+	UniformBufferParameters<name ## UniformBufferData> name; \
+	private: \
+	\
+	struct name ## ShaderParameter : public ShaderParameter \
+	{ \
+		ParametersStruct& Parameters; \
+		\
+		name ## ShaderParameter(ParametersStruct& parameters) : Parameters(parameters) \
+		{ \
+			parameters.AddParameter(this); \
+		} \
+		\
+		virtual void UploadParameter() override \
+		{ \
+			Parameters.name.Upload(); \
+		} \
+		\
+		virtual void SubmitParameter(std::shared_ptr<RenderingContext> context) override \
+		{ \
+			Parameters.name.Bind(context); \
+		} \
+	}; \
+	name ## ShaderParameter name ## ShaderParameterValue { *this }; \
+	\
+	public:
+
 #define ED_SHADER_PARAMETER(shaderType, type, name) \
 	type name; \
 	private: \
@@ -48,7 +125,7 @@ private:
 		\
 		virtual void SubmitParameter(std::shared_ptr<RenderingContext> context) override \
 		{ \
-			context->SetShaderData ## shaderType(Name, Parameters.name); \
+			context->SetShaderData ## shaderType(ResolveLocation(context, Name), Parameters.name); \
 		} \
 	}; \
 	name ## ShaderParameter name ## ShaderParameterValue { *this }; \
@@ -75,7 +152,7 @@ private:
 		\
 		virtual void SubmitParameter(std::shared_ptr<RenderingContext> context) override \
 		{ \
-			context->SetShaderData ## shaderType(Name, Parameters.name); \
+			context->SetShaderData ## shaderType(ResolveLocation(context, Name), Parameters.name); \
 		} \
 	}; \
 	name ## ShaderParameter name ## ShaderParameterValue { *this }; \
@@ -106,7 +183,7 @@ private:
 		{ \
 			for (int32_t i = 0; i < count; ++i) \
 			{ \
-				context->SetShaderData ## shaderType(Names[i], Parameters.name[i]); \
+				context->SetShaderData ## shaderType(ResolveLocation(context, Names[i], i), Parameters.name[i]); \
 			} \
 		} \
 	}; \
@@ -138,7 +215,7 @@ private:
 		{ \
 			for (int32_t i = 0; i < count; ++i) \
 			{ \
-				context->SetShaderData ## shaderType(Names[i], Parameters.name[i]); \
+				context->SetShaderData ## shaderType(ResolveLocation(context, Names[i], i), Parameters.name[i]); \
 			} \
 		} \
 	}; \
@@ -166,7 +243,7 @@ private:
 		\
 		virtual void SubmitParameter(std::shared_ptr<RenderingContext> context) override \
 		{ \
-			context->SetShaderData ## shaderType(Name, Parameters.structName ## _ ## name); \
+			context->SetShaderData ## shaderType(ResolveLocation(context, Name), Parameters.structName ## _ ## name); \
 		} \
 	}; \
 	structName ## name ## ShaderParameter structName ## name ## ShaderParameterValue { *this }; \
@@ -193,7 +270,7 @@ private:
 		\
 		virtual void SubmitParameter(std::shared_ptr<RenderingContext> context) override \
 		{ \
-			context->SetShaderData ## shaderType(Name, Parameters.structName ## _ ## name); \
+			context->SetShaderData ## shaderType(ResolveLocation(context, Name), Parameters.structName ## _ ## name); \
 		} \
 	}; \
 	structName ## name ## ShaderParameter structName ## name ## ShaderParameterValue { *this }; \
@@ -224,7 +301,7 @@ private:
 		{ \
 			for (int32_t i = 0; i < count; ++i) \
 			{ \
-				context->SetShaderData ## shaderType(names[i], Parameters.structName ## _ ## name[i]); \
+				context->SetShaderData ## shaderType(ResolveLocation(context, names[i], i), Parameters.structName ## _ ## name[i]); \
 			} \
 		} \
 	}; \
@@ -256,7 +333,7 @@ private:
 		{ \
 			for (int32_t i = 0; i < count; ++i) \
 			{ \
-				context->SetShaderData ## shaderType(names[i], Parameters.structName ## _ ## name[i]); \
+				context->SetShaderData ## shaderType(ResolveLocation(context, names[i], i), Parameters.structName ## _ ## name[i]); \
 			} \
 		} \
 	}; \
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Core/Ed.h"
+#include "Core/Rendering/RenderingContex.h"
+#include "Core/Rendering/Buffers/UniformBuffer.h"
+#include "Utils/RenderingHelper.h"
+#include <glm/glm.hpp>
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
+
+// std140 base alignments, types without specialization (bool, mat3, ...) can't be used in uniform buffers
+template<typename T> struct Std140Alignment;
+template<> struct Std140Alignment<int32_t>   { static const size_t Value = 4; };
+template<> struct Std140Alignment<uint32_t>  { static const size_t Value = 4; };
+template<> struct Std140Alignment<float>     { static const size_t Value = 4; };
+template<> struct Std140Alignment<glm::vec2> { static const size_t Value = 8; };
+template<> struct Std140Alignment<glm::vec3> { static const size_t Value = 16; };
+template<> struct Std140Alignment<glm::vec4> { static const size_t Value = 16; };
+template<> struct Std140Alignment<glm::mat4> { static const size_t Value = 16; };
+
+// Keeps a CPU copy of a std140 block, GPU buffer is updated only when the data has changed since the last upload
+template<typename DataStruct>
+class UniformBufferParameters
+{
+	static_assert(std::is_trivially_copyable_v<DataStruct>, "Uniform buffer data has to be trivially copyable");
+public:
+	DataStruct Data;
+
+	UniformBufferParameters()
+	{
+		// Padding bytes take part in comparison, so they have to be zeroed
+		std::memset(&Data, 0, sizeof(DataStruct));
+		std::memset(&m_UploadedData, 0, sizeof(DataStruct));
+	}
+
+	// Main thread only, the GPU buffer is created on the first upload
+	void Upload()
+	{
+		if (!m_Buffer)
+		{
+			m_Buffer = RenderingHelper::CreateUniformBuffer(&Data, sizeof(DataStruct), BufferUsage::DynamicDraw);
+			std::memcpy(&m_UploadedData, &Data, sizeof(DataStruct));
+		}
+		else if (std::memcmp(&m_UploadedData, &Data, sizeof(DataStruct)) != 0)
+		{
+			m_Buffer->SetSubdata(0, sizeof(DataStruct), &Data);
+			std::memcpy(&m_UploadedData, &Data, sizeof(DataStruct));
+		}
+	}
+
+	// Only records the binding, so it can be submitted to a command buffer on a worker thread
+	void Bind(const std::shared_ptr<RenderingContext>& context) const
+	{
+		ED_ASSERT(m_Buffer, "Uniform buffer has to be uploaded before it is bound")
+		context->SetUniformBuffer(DataStruct::Binding, m_Buffer);
+	}
+
+	void Submit(const std::shared_ptr<RenderingContext>& context)
+	{
+		Upload();
+		Bind(context);
+	}
+
+private:
+	DataStruct m_UploadedData;
+	std::shared_ptr<UniformBuffer> m_Buffer;
+};
@@ -22,6 +22,46 @@ void BaseRenderPass::Execute()
 
 }
 
+bool BaseRenderPass::IsEnabled() const
+{
+	return true;
+}
+
+std::string BaseRenderPass::GetFusionFeature() const
+{
+	return "";
+}
+
+void BaseRenderPass::SubmitFullscreenParameters()
+{
+
+}
+
+bool BaseRenderPass::SupportsParallelRecording() const
+{
+	return false;
+}
+
+void BaseRenderPass::PrepareItem(uint32_t index)
+{
+
+}
+
+void BaseRenderPass::RecordItem(uint32_t index, const std::shared_ptr<RenderingContext>& context)
+{
+
+}
+
+void BaseRenderPass::SetContext(std::shared_ptr<RenderingContext> context)
+{
+	m_Context = context;
+}
+
+const std::shared_ptr<RenderingContext>& BaseRenderPass::GetContext() const
+{
+	return m_Context;
+}
+
 void BaseMultiPassRenderPass::PostInitialization()
 {
 	for (const std::shared_ptr<BaseRenderPass>& pass : m_Passes)
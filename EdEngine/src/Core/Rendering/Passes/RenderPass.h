@@ -2,6 +2,7 @@
 
 #include "Parameters/RenderPassParameters.h"
 #include "Parameters/ShaderParameters.h"
+#include "Core/Rendering/RenderPassTypeId.h"
 
 class BaseRenderPass : public std::enable_shared_from_this<BaseRenderPass>
 {
@@ -11,6 +12,29 @@ public:
 	virtual void PreExecute();
 	virtual void Execute();
 
+	// Disabled passes are culled by the render graph, call RenderGraph::Invalidate when the result changes
+	virtual bool IsEnabled() const;
+
+	// Define enabling the pass in the fused fullscreen uber shader, passes returning one can be merged with neighbouring fullscreen passes.
+	// Such pass has to draw only a fullscreen quad, read its inputs at the pixel it writes and set all of its uniforms in SubmitFullscreenParameters
+	virtual std::string GetFusionFeature() const;
+
+	// Sets shader parameters of a fullscreen pass without drawing, so merged passes can share a draw
+	virtual void SubmitFullscreenParameters();
+
+	// Pass whose Execute only submits commands to m_Context and draws with Renderer::SubmitFullScreenQuad(m_Context), without uploading data or touching the API directly.
+	// Such pass can be recorded into a command buffer on a worker thread, everything else has to happen in PreExecute, which runs on the main thread
+	virtual bool SupportsParallelRecording() const;
+
+	// Passes a multipass draws once per item, e.g. per light, keep what every item needs under its index. PrepareItem runs on the main thread
+	// like PreExecute, RecordItem only submits commands of the item to the context, so items can be recorded from several threads at once
+	virtual void PrepareItem(uint32_t index);
+	virtual void RecordItem(uint32_t index, const std::shared_ptr<RenderingContext>& context);
+
+	// Context the pass submits its commands to, the graph swaps it for a command buffer while the pass is recorded
+	void SetContext(std::shared_ptr<RenderingContext> context);
+	const std::shared_ptr<RenderingContext>& GetContext() const;
+
 	virtual RenderPassParameters& GetBaseParameters() = 0;
 	virtual ShaderParameters& GetBaseShaderParameters() = 0;
 
@@ -32,11 +56,35 @@ public:
 	const ParameterStruct& GetParameters() const { return m_Parameters; }
 	const ShaderParametersStruct& GetShaderParameters() const { return m_ShaderParameters; }
 
+	// Uniform blocks are uploaded here, on the main thread, Submit only binds them
+	void UploadShaderParameters()
+	{
+		UploadShaderParameters(m_ShaderParameters);
+	}
+
+	void UploadShaderParameters(const ShaderParameters& parameters)
+	{
+		for (ShaderParameter* parameter : parameters.GetParameters())
+		{
+			parameter->UploadParameter();
+		}
+	}
+
 	void SubmitShaderParameters()
 	{
-		for (ShaderParameter* parameter : m_ShaderParameters.GetParameters())
+		SubmitShaderParameters(m_ShaderParameters);
+	}
+
+	void SubmitShaderParameters(const ShaderParameters& parameters)
+	{
+		SubmitShaderParameters(parameters, m_Context);
+	}
+
+	void SubmitShaderParameters(const ShaderParameters& parameters, const std::shared_ptr<RenderingContext>& context)
+	{
+		for (ShaderParameter* parameter : parameters.GetParameters())
 		{
-			parameter->SubmitParameter(m_Context);
+			parameter->SubmitParameter(context);
 		}
 	}
 
@@ -54,32 +102,37 @@ public:
 
 	virtual std::vector<std::shared_ptr<BaseRenderPass>> GetRenderPasses() const { return m_Passes; }
 
+	// Looks for the exact type, returns the first added pass of it
 	template<typename T>
-	std::shared_ptr<T> GetPass()
+	std::shared_ptr<T> GetPass() const
 	{
-		for (const std::shared_ptr<BaseRenderPass>& pass : m_Passes)
-		{
-			if (std::shared_ptr<T> castedPass = std::dynamic_pointer_cast<T>(pass))
-			{
-				return castedPass;
-			}
-		}
-
-		return nullptr;
+		uint32_t typeId = RenderPassTypeId::Get<T>();
+		return typeId < m_PassesByType.size() ? std::static_pointer_cast<T>(m_PassesByType[typeId]) : nullptr;
 	}
 protected:
 	template<typename T>
 	void AddPass()
 	{
-		AddPass(std::make_shared<T>());
+		AddPass(std::make_shared<T>(), RenderPassTypeId::Get<T>());
 	}
 
-	void AddPass(std::shared_ptr<BaseRenderPass> pass)
+	void AddPass(std::shared_ptr<BaseRenderPass> pass, uint32_t typeId)
 	{
+		if (typeId >= m_PassesByType.size())
+		{
+			m_PassesByType.resize(typeId + 1);
+		}
+
+		if (!m_PassesByType[typeId])
+		{
+			m_PassesByType[typeId] = pass;
+		}
+
 		m_Passes.push_back(pass);
 	}
 protected:
 	std::vector<std::shared_ptr<BaseRenderPass>> m_Passes;
+	std::vector<std::shared_ptr<BaseRenderPass>> m_PassesByType;
 };
 
 template<typename ParameterStruct, typename ShaderParametersStruct>
@@ -18,9 +18,23 @@ void ResolutionPass::Execute()
 {
 	RenderPass<ResolutionPassParameters, ResolutionPassShaderParameters>::Execute();
 
-	glm::u32vec2 size = m_Renderer->GetViewportSize();
-	m_Parameters.DrawFramebuffer->Resize(size.x, size.y, 1);
+	SubmitFullscreenParameters();
 	
+	m_Renderer->SubmitFullScreenQuad(m_Context);
+}
+
+std::string ResolutionPass::GetFusionFeature() const
+{
+	return "RESOLUTION_PASS";
+}
+
+bool ResolutionPass::SupportsParallelRecording() const
+{
+	return true;
+}
+
+void ResolutionPass::SubmitFullscreenParameters()
+{
 	switch (m_Renderer->GetAAMethod())
 	{
 		case AAMethod::TAA: m_ShaderParameters.Light = m_Parameters.TAAOutput; break;
@@ -32,8 +46,6 @@ void ResolutionPass::Execute()
 	m_ShaderParameters.Bloom = m_Parameters.Bloom;
 
 	SubmitShaderParameters();
-	
-	m_Renderer->SubmitFullScreenQuad();
 }
 
 void ResolutionPass::SetGamma(float gamma)
@@ -4,7 +4,7 @@
 
 ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(ResolutionPass, Base)
 
-	ED_RENDER_PASS_DECLARE_RENDER_TARGET(Texture2D, Color, Color16, "Resolution.Color")
+	ED_RENDER_PASS_DECLARE_TRANSIENT_RENDER_TARGET(Texture2D, Color, Color16, 1.0f, "Resolution.Color")
 
 	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, TAAOutput,  "TAA.Output",           Read)
 	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, FXAAOutput, "FXAA.Output",          Read)
@@ -31,6 +31,11 @@ public:
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph) override;
 	virtual void Execute() override;
 
+	virtual std::string GetFusionFeature() const override;
+	virtual void SubmitFullscreenParameters() override;
+
+	virtual bool SupportsParallelRecording() const override;
+
 	void SetGamma(float gamma);
 	float GetGamma() const;
 
@@ -4,7 +4,7 @@
 
 ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(SSAOBlurPass, Base)
 
-	ED_RENDER_PASS_DECLARE_RENDER_TARGET(Texture2D, Blured, Distance, "SSAO.Blured")
+	ED_RENDER_PASS_DECLARE_TRANSIENT_RENDER_TARGET(Texture2D, Blured, Distance, 0.5f, "SSAO.Blured")
 
 	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, AmbientOcclusion, "SSAO.Base", Read)
 
@@ -21,4 +21,6 @@ class SSAOBlurPass : public RenderPass<SSAOBlurPassParameters, SSAOBlurPassShade
 {
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph) override;
 	virtual void Execute() override;
+
+	virtual bool SupportsParallelRecording() const override;
 };
\ No newline at end of file
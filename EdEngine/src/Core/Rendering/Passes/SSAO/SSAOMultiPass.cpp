@@ -2,17 +2,43 @@
 #include "SSAOPass.h"
 #include "SSAOBlurPass.h"
 
+void SSAOMultiPass::PreExecute()
+{
+	MultiPassRenderPass<MultiRenderPassParameters, ShaderParameters>::PreExecute();
+
+	for (const std::shared_ptr<BaseRenderPass>& pass : m_Passes)
+	{
+		pass->PreExecute();
+	}
+}
+
 void SSAOMultiPass::Execute()
 {
 	MultiPassRenderPass<MultiRenderPassParameters, ShaderParameters>::Execute();
 
-	if (m_Renderer->IsSSAOEnabled())
+	// Context is a command buffer when the multipass is recorded on a worker
+	for (const std::shared_ptr<BaseRenderPass>& pass : m_Passes)
 	{
-		for (const std::shared_ptr<BaseRenderPass>& pass : m_Passes)
+		m_Graph->RecordPass(pass, m_Context);
+	}
+}
+
+bool SSAOMultiPass::SupportsParallelRecording() const
+{
+	for (const std::shared_ptr<BaseRenderPass>& pass : m_Passes)
+	{
+		if (!pass->SupportsParallelRecording())
 		{
-			m_Graph->ExecutePass(pass);
+			return false;
 		}
 	}
+
+	return true;
+}
+
+bool SSAOMultiPass::IsEnabled() const
+{
+	return m_Renderer->IsSSAOEnabled();
 }
 
 void SSAOMultiPass::CreatePasses()
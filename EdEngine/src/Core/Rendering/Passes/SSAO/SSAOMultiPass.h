@@ -5,7 +5,11 @@
 class SSAOMultiPass : public MultiPassRenderPass<MultiRenderPassParameters, ShaderParameters>
 {
 public:
+	virtual void PreExecute() override;
 	virtual void Execute() override;
+	virtual bool IsEnabled() const override;
+
+	virtual bool SupportsParallelRecording() const override;
 
 protected:
 	virtual void CreatePasses();
@@ -12,9 +12,6 @@ void SSAOBasePass::Initialize(std::shared_ptr<RenderGraph> graph)
 	m_Parameters.bUseBlending = false;
 	m_Parameters.bClearColors = true;
 
-	m_ShaderParameters.Position = m_Parameters.Position;
-	m_ShaderParameters.Normal = m_Parameters.Normal;
-
 	{
 		std::shared_ptr<Texture2D> texture = RenderingHelper::CreateTexture2D("SSAO noise");
 		texture->SetWrapS(WrapMode::Repeat);
@@ -33,22 +30,32 @@ void SSAOBasePass::Initialize(std::shared_ptr<RenderGraph> graph)
 	SetBias(0.025f);
 }
 
-void SSAOBasePass::Execute()
+void SSAOBasePass::PreExecute()
 {
-	RenderPass<SSAOBasePassParameters, SSAOBasePassShaderParameters>::Execute();
+	RenderPass<SSAOBasePassParameters, SSAOBasePassShaderParameters>::PreExecute();
 
-	glm::u32vec2 size = m_Renderer->GetViewportSize();
-    m_Parameters.DrawFramebuffer->Resize(std::max<int32_t>(size.x / 2, 1), std::max<int32_t>(size.y / 2, 1), 1);
+	m_ShaderParameters.Position = m_Parameters.Position;
+	m_ShaderParameters.Normal = m_Parameters.Normal;
 
 	Camera& camera = m_Parameters.Camera->GetCamera();
 	m_Renderer->SetCamera(camera);
 
-	m_ShaderParameters.NormalMatrix = glm::transpose(glm::inverse(camera.GetView()));
+	m_ShaderParameters.NormalMatrix = glm::transpose(camera.GetInverseView());
 	m_ShaderParameters.ScreenSize = m_Parameters.Base->GetSize();
+}
+
+void SSAOBasePass::Execute()
+{
+	RenderPass<SSAOBasePassParameters, SSAOBasePassShaderParameters>::Execute();
 
 	SubmitShaderParameters();
 
-	m_Renderer->SubmitFullScreenQuad();
+	m_Renderer->SubmitFullScreenQuad(m_Context);
+}
+
+bool SSAOBasePass::SupportsParallelRecording() const
+{
+	return true;
 }
 
 void SSAOBasePass::SetSamplesCount(uint32_t count)
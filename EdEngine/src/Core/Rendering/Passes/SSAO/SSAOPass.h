@@ -5,7 +5,7 @@
 
 ED_BEGIN_RENDER_PASS_PARAMETERS_DECLARATION(SSAOBasePass, Base)
 	
-	ED_RENDER_PASS_DECLARE_RENDER_TARGET(Texture2D, Base, Distance, "SSAO.Base")
+	ED_RENDER_PASS_DECLARE_TRANSIENT_RENDER_TARGET(Texture2D, Base, Distance, 0.5f, "SSAO.Base")
 
 	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, Position, "GBuffer.Position", Read)
 	ED_RENDER_PASS_RESOURCE_REFERENCE(Texture2D, Normal,   "GBuffer.Normal",   Read)
@@ -39,8 +39,11 @@ class SSAOBasePass : public RenderPass<SSAOBasePassParameters, SSAOBasePassShade
 	static const uint32_t MaxSSAOSamplesCount = 32;
 public:
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph) override;
+	virtual void PreExecute() override;
 	virtual void Execute() override;
 
+	virtual bool SupportsParallelRecording() const override;
+
     void SetSamplesCount(uint32_t count);
     uint32_t GetSamplesCount() const;
 
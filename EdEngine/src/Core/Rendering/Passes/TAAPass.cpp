@@ -19,39 +19,42 @@ void TAAPass::Initialize(std::shared_ptr<RenderGraph> graph)
 
 void TAAPass::PreExecute()
 {
-	if (m_Renderer->GetAAMethod() == AAMethod::TAA)
-	{
-		std::shared_ptr<Texture2D> newHistoryBuffer = m_Parameters.DrawFramebuffer->GetAttachment<Texture2D>(0);
-		
-		m_Parameters.DrawFramebuffer->SetAttachment(0, m_HistoryBuffer, FramebufferSizeAdjustmentMode::ResizeTextureToFramebufferSize);
-		m_Parameters.Output = m_HistoryBuffer;
-
-		m_HistoryBuffer = newHistoryBuffer;
-	}
-
-	glm::u32vec2 size = m_Renderer->GetViewportSize();
-	m_Parameters.DrawFramebuffer->Resize(size.x, size.y, 1);
-	m_HistoryBuffer->Resize(size.x, size.y, 1);
+	std::shared_ptr<Texture2D> newHistoryBuffer = m_Parameters.DrawFramebuffer->GetAttachment<Texture2D>(0);
+	
+	m_Parameters.DrawFramebuffer->SetAttachment(0, m_HistoryBuffer, FramebufferSizeAdjustmentMode::ResizeTextureToFramebufferSize);
+	m_Parameters.Output = m_HistoryBuffer;
+
+	m_HistoryBuffer = newHistoryBuffer;
+
+	// Graph resizes only the texture that is attached at the moment
+	m_HistoryBuffer->Resize(m_Parameters.DrawFramebuffer->GetWidth(), m_Parameters.DrawFramebuffer->GetHeight(), 1);
 }
 
 void TAAPass::Execute()
 {
 	RenderPass<TAAPassParameters, TAAPassShaderParameters>::Execute();
 
-	if (m_Renderer->GetAAMethod() == AAMethod::TAA)
-	{
-		m_ShaderParameters.PreviousColor = m_HistoryBuffer;
-		m_ShaderParameters.CurrentColor = m_Parameters.SceneBase;
-		m_ShaderParameters.CurrentDepth = m_Parameters.SceneDepth;
-		m_ShaderParameters.Velocity = m_Parameters.SceneVelocity;
-		
-		m_ShaderParameters.PixelSize = 1.0f / glm::vec2(m_HistoryBuffer->GetSize());
-		m_ShaderParameters.ScreenSize = glm::vec2(m_HistoryBuffer->GetSize());
+	m_ShaderParameters.PreviousColor = m_HistoryBuffer;
+	m_ShaderParameters.CurrentColor = m_Parameters.SceneBase;
+	m_ShaderParameters.CurrentDepth = m_Parameters.SceneDepth;
+	m_ShaderParameters.Velocity = m_Parameters.SceneVelocity;
+	
+	m_ShaderParameters.PixelSize = 1.0f / glm::vec2(m_HistoryBuffer->GetSize());
+	m_ShaderParameters.ScreenSize = glm::vec2(m_HistoryBuffer->GetSize());
+
+	SubmitShaderParameters();
+
+	m_Renderer->SubmitFullScreenQuad(m_Context);
+}
 
-		SubmitShaderParameters();
+bool TAAPass::IsEnabled() const
+{
+	return m_Renderer->GetAAMethod() == AAMethod::TAA;
+}
 
-		m_Renderer->SubmitFullScreenQuad();
-	}
+bool TAAPass::SupportsParallelRecording() const
+{
+	return true;
 }
 
 void TAAPass::SetGamma(float gamma)
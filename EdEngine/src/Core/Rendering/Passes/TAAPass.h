@@ -32,6 +32,8 @@ public:
 	virtual void Initialize(std::shared_ptr<RenderGraph> graph) override;
 	virtual void PreExecute() override;
 	virtual void Execute() override;
+	virtual bool IsEnabled() const override;
+	virtual bool SupportsParallelRecording() const override;
 
 	void SetGamma(float gamma);
 	float GetGamma() const;
@@ -0,0 +1,114 @@
+#include "PipelineState.h"
+#include "Framebuffer.h"
+
+// FNV-1a, states are hashed only at RenderGraph::Build, so simplicity beats speed here
+static void HashValue(uint64_t& hash, uint64_t value)
+{
+	for (uint32_t i = 0; i < sizeof(value); ++i)
+	{
+		hash ^= (value >> (i * 8)) & 0xFF;
+		hash *= 1099511628211ull;
+	}
+}
+
+void PipelineStateDescription::SetFramebufferFormat(const std::shared_ptr<Framebuffer>& framebuffer)
+{
+	ColorFormats.clear();
+	bHasDepthAttachment = false;
+
+	if (!framebuffer)
+	{
+		return;
+	}
+
+	for (uint32_t i = 0; i < framebuffer->GetAttachmentsCount(); ++i)
+	{
+		ColorFormats.push_back(framebuffer->GetAttachment(i)->GetPixelFormat());
+	}
+
+	if (std::shared_ptr<Texture> depth = framebuffer->GetDepthAttachment())
+	{
+		bHasDepthAttachment = true;
+		DepthFormat = depth->GetPixelFormat();
+	}
+}
+
+uint64_t PipelineStateDescription::CalculateHash() const
+{
+	uint64_t hash = 14695981039346656037ull;
+
+	HashValue(hash, (uint64_t)Shader.get());
+
+	HashValue(hash, bUseBlending);
+	HashValue(hash, (uint64_t)SourceFactor);
+	HashValue(hash, (uint64_t)DestinationFactor);
+
+	HashValue(hash, bUseDepthTesting);
+	HashValue(hash, (uint64_t)DepthFunction);
+
+	HashValue(hash, bEnableFaceCulling);
+	HashValue(hash, (uint64_t)FaceToCull);
+
+	for (PixelFormat format : ColorFormats)
+	{
+		HashValue(hash, (uint64_t)format);
+	}
+
+	HashValue(hash, bHasDepthAttachment);
+	HashValue(hash, (uint64_t)DepthFormat);
+
+	return hash;
+}
+
+bool PipelineStateDescription::operator==(const PipelineStateDescription& other) const
+{
+	return Shader == other.Shader &&
+		bUseBlending == other.bUseBlending && SourceFactor == other.SourceFactor && DestinationFactor == other.DestinationFactor &&
+		bUseDepthTesting == other.bUseDepthTesting && DepthFunction == other.DepthFunction &&
+		bEnableFaceCulling == other.bEnableFaceCulling && FaceToCull == other.FaceToCull &&
+		ColorFormats == other.ColorFormats && bHasDepthAttachment == other.bHasDepthAttachment && DepthFormat == other.DepthFormat;
+}
+
+PipelineState::PipelineState(const PipelineStateDescription& description) : m_Description(description), m_Hash(description.CalculateHash())
+{
+
+}
+
+const PipelineStateDescription& PipelineState::GetDescription() const
+{
+	return m_Description;
+}
+
+uint64_t PipelineState::GetHash() const
+{
+	return m_Hash;
+}
+
+std::shared_ptr<PipelineState> PipelineStateCache::GetOrCreate(const PipelineStateDescription& description)
+{
+	uint64_t hash = description.CalculateHash();
+
+	auto [begin, end] = m_States.equal_range(hash);
+	for (auto it = begin; it != end; ++it)
+	{
+		if (it->second->GetDescription() == description)
+		{
+			return it->second;
+		}
+	}
+
+	std::shared_ptr<PipelineState> state = std::make_shared<PipelineState>(description);
+	m_States.emplace(hash, state);
+
+	return state;
+}
+
+void PipelineStateCache::Clear()
+{
+	m_States.clear();
+}
+
+uint32_t PipelineStateCache::GetSize() const
+{
+	return m_States.size();
+}
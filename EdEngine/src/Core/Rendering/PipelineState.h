@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Core/Ed.h"
+#include "Types.h"
+
+class Shader;
+class Framebuffer;
+
+// Fixed function state and shader used by a render pass, everything BeginPass used to set one call at a time
+struct PipelineStateDescription
+{
+	std::shared_ptr<class Shader> Shader;
+
+	bool bUseBlending = false;
+	BlendFactor SourceFactor = BlendFactor::SourceAlpha;
+	BlendFactor DestinationFactor = BlendFactor::OneMinusSourceAlpha;
+
+	bool bUseDepthTesting = false;
+	DepthTestFunction DepthFunction = DepthTestFunction::Lesser;
+
+	bool bEnableFaceCulling = false;
+	Face FaceToCull = Face::Back;
+
+	// Attachment formats the state is used with, framebuffer itself is bound separately
+	std::vector<PixelFormat> ColorFormats;
+	bool bHasDepthAttachment = false;
+	PixelFormat DepthFormat = PixelFormat::Depth;
+
+	void SetFramebufferFormat(const std::shared_ptr<Framebuffer>& framebuffer);
+
+	uint64_t CalculateHash() const;
+
+	bool operator==(const PipelineStateDescription& other) const;
+};
+
+// Immutable, states with equal descriptions are shared, so contexts can compare them by pointer
+class PipelineState
+{
+public:
+	PipelineState(const PipelineStateDescription& description);
+
+	const PipelineStateDescription& GetDescription() const;
+	uint64_t GetHash() const;
+
+protected:
+	PipelineStateDescription m_Description;
+	uint64_t m_Hash;
+};
+
+class PipelineStateCache
+{
+public:
+	std::shared_ptr<PipelineState> GetOrCreate(const PipelineStateDescription& description);
+
+	void Clear();
+	uint32_t GetSize() const;
+
+protected:
+	std::unordered_multimap<uint64_t, std::shared_ptr<PipelineState>> m_States;
+};
@@ -1,21 +1,151 @@
 #include "RenderGraph.h"
 #include "Utils/RenderingHelper.h"
 #include "Passes/RenderPass.h"
+#include <algorithm>
 
-void RenderGraph::AddPass(std::shared_ptr<BaseRenderPass> pass)
+static PipelineStateDescription GetPipelineStateDescription(const BaseRenderPassParameters& parameters)
+{
+	PipelineStateDescription description;
+	description.Shader = parameters.Shader;
+	description.bUseBlending = parameters.bUseBlending;
+	description.SourceFactor = parameters.SourceFactor;
+	description.DestinationFactor = parameters.DestinationFactor;
+	description.bUseDepthTesting = parameters.bUseDepthTesting;
+	description.DepthFunction = parameters.DepthFunction;
+	description.bEnableFaceCulling = parameters.bEnableFaceCulling;
+	description.FaceToCull = parameters.FaceToCull;
+	description.SetFramebufferFormat(parameters.DrawFramebuffer);
+
+	return description;
+}
+
+void RenderGraph::AddPass(std::shared_ptr<BaseRenderPass> pass, uint32_t typeId)
 {
 	if (pass->GetType() == RenderPassType::MultiPass)
 	{
 		std::static_pointer_cast<BaseMultiPassRenderPass>(pass)->CreatePasses();
 	}
 
+	if (typeId >= m_PassesByType.size())
+	{
+		m_PassesByType.resize(typeId + 1);
+	}
+
+	if (!m_PassesByType[typeId])
+	{
+		m_PassesByType[typeId] = pass;
+	}
+
 	m_Passes.push_back(pass);
 }
 
+RenderGraphHandle RenderGraph::Intern(const std::string& name)
+{
+	auto [it, bIsInserted] = m_Handles.try_emplace(name, (RenderGraphHandle)m_Names.size());
+	if (bIsInserted)
+	{
+		m_Names.push_back(name);
+		m_Resources.push_back(nullptr);
+		m_Parameters.push_back(nullptr);
+		m_ResourceUsages.emplace_back();
+		m_RenderTargetBindings.emplace_back();
+	}
+
+	return it->second;
+}
+
+RenderGraphHandle RenderGraph::GetHandle(const std::string& name) const
+{
+	auto it = m_Handles.find(name);
+	return it != m_Handles.end() ? it->second : InvalidHandle;
+}
+
+const std::string& RenderGraph::GetName(RenderGraphHandle handle) const
+{
+	ED_ASSERT(handle < m_Names.size(), "Invalid render graph handle")
+	return m_Names[handle];
+}
+
 void RenderGraph::Build()
 {
 	InitializePasses();
+
+	for (const std::shared_ptr<BaseRenderPass>& pass : m_Passes)
+	{
+		CreatePipelineStates(pass);
+	}
+
 	BuildNodes();
+	BuildSchedule();
+}
+
+void RenderGraph::SetOutput(const std::string& resourceName)
+{
+	m_Output = resourceName;
+	m_bIsScheduleDirty = true;
+}
+
+void RenderGraph::SetDebugOutput(const std::string& resourceName)
+{
+	m_DebugOutput = resourceName;
+	m_bIsScheduleDirty = true;
+}
+
+void RenderGraph::Invalidate()
+{
+	m_bIsScheduleDirty = true;
+}
+
+void RenderGraph::SetPassFusionEnabled(bool bEnabled)
+{
+	m_bIsPassFusionEnabled = bEnabled;
+	m_bIsScheduleDirty = true;
+}
+
+bool RenderGraph::IsPassFusionEnabled() const
+{
+	return m_bIsPassFusionEnabled;
+}
+
+void RenderGraph::SetParallelRecordingEnabled(bool bEnabled)
+{
+	m_bIsParallelRecordingEnabled = bEnabled;
+	m_bIsScheduleDirty = true;
+}
+
+bool RenderGraph::IsParallelRecordingEnabled() const
+{
+	return m_bIsParallelRecordingEnabled;
+}
+
+RenderTargetPoolStatistics RenderGraph::GetRenderTargetPoolStatistics() const
+{
+	return RenderTargetPool::CalculateStatistics(m_TransientRenderTargets, m_PhysicalRenderTargets, m_RenderSize.GetSize());
+}
+
+glm::u32vec2 RenderGraph::GetRenderSize() const
+{
+	return m_RenderSize.GetSize();
+}
+
+RenderSizeStatistics RenderGraph::GetRenderSizeStatistics() const
+{
+	return m_RenderSizeStatistics;
+}
+
+RenderProfiler& RenderGraph::GetProfiler()
+{
+	return m_Profiler;
+}
+
+JobSystem& RenderGraph::GetJobSystem()
+{
+	return m_JobSystem;
+}
+
+std::shared_ptr<PipelineState> RenderGraph::GetPipelineState(const PipelineStateDescription& description)
+{
+	return m_PipelineStates.GetOrCreate(description);
 }
 
 void RenderGraph::InitializePasses()
@@ -37,44 +167,89 @@ void RenderGraph::InitializePasses()
 	}
 }
 
-void RenderGraph::Update(float deltaSeconds)
+void RenderGraph::CreatePipelineStates(std::shared_ptr<BaseRenderPass> pass)
 {
-	for (const std::shared_ptr<RenderGraphNode>& node : m_Nodes)
-	{
-		node->bHasFinished = false;
+	RenderPassParameters& parameters = pass->GetBaseParameters();
 
-		if (node->Upstream.empty())
+	if (parameters.Type == RenderPassType::Base)
+	{
+		BaseRenderPassParameters& castedParameters = static_cast<BaseRenderPassParameters&>(parameters);
+		castedParameters.PipelineState = m_PipelineStates.GetOrCreate(GetPipelineStateDescription(castedParameters));
+	}
+	else if (parameters.Type == RenderPassType::MultiPass)
+	{
+		std::shared_ptr<BaseMultiPassRenderPass> castedPass = std::static_pointer_cast<BaseMultiPassRenderPass>(pass);
+		for (const std::shared_ptr<BaseRenderPass>& innerPass : castedPass->GetRenderPasses())
 		{
-			m_ExecutionQueue.push(node);
+			CreatePipelineStates(innerPass);
 		}
 	}
+}
 
-	while (!m_ExecutionQueue.empty())
+void RenderGraph::Update(float deltaSeconds)
+{
+	m_Profiler.BeginFrame();
+
+	if (m_bIsScheduleDirty)
+	{
+		BuildSchedule();
+	}
+
+	// Targets are resized only between frames, so every pass of a frame sees the same sizes
+	if (m_RenderSize.Update(m_Renderer->GetViewportSize()) || m_bAreRenderTargetsDirty)
 	{
-		std::shared_ptr<RenderGraphNode> node = m_ExecutionQueue.front();
-		m_ExecutionQueue.pop();
+		ResizeRenderTargets();
+	}
 
-		if (node->CanStart())
+	uint32_t batch = 0;
+	for (uint32_t i = 0; i < m_Schedule.size();)
+	{
+		if (batch < m_RecordingBatches.size() && m_RecordingBatches[batch].First == i)
 		{
-			std::shared_ptr<BaseRenderPass> pass = node->Pass;
+			ExecuteRecordingBatch(m_RecordingBatches[batch]);
+			i = m_RecordingBatches[batch++].Last + 1;
+		}
+		else
+		{
+			ExecuteNode(*m_Nodes[m_Schedule[i++]]);
+		}
+	}
 
-			ExecutePass(pass);
+	// Passes leave their framebuffer bound, so consecutive passes drawing to the same one don't rebind it
+	m_Context->SetDefaultFramebuffer();
 
-			node->bHasFinished = true;
+	m_Profiler.EndFrame();
+}
 
-			for (const std::shared_ptr<RenderGraphNode>& downstreamNode : node->Downstream)
-			{
-				m_ExecutionQueue.push(downstreamNode);
-			}
+bool RenderGraph::SortTopologically(const std::vector<std::shared_ptr<RenderGraphNode>>& nodes, std::vector<uint32_t>& order)
+{
+	order.clear();
+	order.reserve(nodes.size());
+
+	// Edges can be duplicated when passes share several resources, they are counted on both ends so it doesn't matter
+	std::vector<uint32_t> inDegrees(nodes.size());
+	for (uint32_t i = 0; i < nodes.size(); ++i)
+	{
+		inDegrees[i] = nodes[i]->Upstream.size();
+		if (inDegrees[i] == 0)
+		{
+			order.push_back(i);
 		}
-		else
+	}
+
+	// Order doubles as the queue, nodes before current are already processed
+	for (uint32_t current = 0; current < order.size(); ++current)
+	{
+		for (const std::shared_ptr<RenderGraphNode>& downstreamNode : nodes[order[current]]->Downstream)
 		{
-			if (!node->bHasFinished)
+			if (--inDegrees[downstreamNode->Index] == 0)
 			{
-				m_ExecutionQueue.push(node);
+				order.push_back(downstreamNode->Index);
 			}
 		}
 	}
+
+	return order.size() == nodes.size();
 }
 
 std::shared_ptr<Renderer> RenderGraph::GetRenderer() const
@@ -87,12 +262,22 @@ std::shared_ptr<RenderingContext> RenderGraph::GetContext() const
 	return m_Context;
 }
 
+std::shared_ptr<Resource>& RenderGraph::GetResource(RenderGraphHandle handle) const
+{
+	return GetResource<Resource>(handle);
+}
+
 std::shared_ptr<Resource>& RenderGraph::GetResource(const std::string& name) const
 {
-	return *m_Resources.at(name);
+	return GetResource<Resource>(GetHandle(name));
 }
 
 void RenderGraph::BeginPass(const RenderPassParameters& inParameters)
+{
+	BeginPass(inParameters, m_Context);
+}
+
+void RenderGraph::BeginPass(const RenderPassParameters& inParameters, const std::shared_ptr<RenderingContext>& context)
 {
 	switch (inParameters.Type)
 	{
@@ -100,51 +285,25 @@ void RenderGraph::BeginPass(const RenderPassParameters& inParameters)
 		{
 			const BaseRenderPassParameters& parameters = static_cast<const BaseRenderPassParameters&>(inParameters);
 
-			m_Context->SetShader(parameters.Shader);
+			ED_ASSERT(parameters.PipelineState, "Pipeline state is created at RenderGraph::Build")
 
-			m_Context->SetFramebuffer(parameters.DrawFramebuffer);
-
-			if (parameters.bUseBlending)
-			{
-				m_Context->EnableBlending(parameters.SourceFactor, parameters.DestinationFactor);
-			}
-			else
-			{
-				m_Context->DisableBlending();
-			}
-
-			if (parameters.bUseDepthTesting)
-			{
-				m_Context->EnableDethTest(parameters.DepthFunction);
-			}
-			else
-			{
-				m_Context->DisableDethTest();
-			}
+			context->SetPipelineState(parameters.PipelineState);
+			context->SetFramebuffer(parameters.DrawFramebuffer);
 
 			if (parameters.bClearColors)
 			{
-				m_Context->ClearColorTarget();
+				context->ClearColorTarget();
 			}
 
 			if (parameters.bClearDepth)
 			{
-				m_Context->ClearDepthTarget();
-			}
-
-			if (parameters.bEnableFaceCulling)
-			{
-				m_Context->EnableFaceCulling(parameters.FaceToCull);
-			}
-			else
-			{
-				m_Context->DisableFaceCulling();
+				context->ClearDepthTarget();
 			}
 		} break;
 		case RenderPassType::Compute:
 		{
 			const ComputeRenderPassParameters& parameters = static_cast<const ComputeRenderPassParameters&>(inParameters);
-			m_Context->SetShader(parameters.Shader);
+			context->SetShader(parameters.Shader);
 		} break;
 		case RenderPassType::MultiPass:
 			break;
@@ -155,10 +314,7 @@ void RenderGraph::BeginPass(const RenderPassParameters& inParameters)
 
 void RenderGraph::EndPass(const RenderPassParameters& inParameters)
 {
-	if (inParameters.Type == RenderPassType::Base)
-	{
-		m_Context->SetDefaultFramebuffer();
-	}
+
 }
 
 void RenderGraph::ProcessDeclarations(std::shared_ptr<BaseRenderPass> pass, uint32_t index)
@@ -178,11 +334,25 @@ void RenderGraph::ProcessDeclarations(std::shared_ptr<BaseRenderPass> pass, uint
 		for (RenderTargetDeclaration* declaration : parameters.GetRenderTargetDeclarations())
 		{
 			std::shared_ptr<Texture> renderTarget = declaration->Declare(shared_from_this());
+			RenderGraphHandle handle = GetHandle(declaration->ResourceName);
+
+			AddRenderTargetBinding(handle, framebuffer, renderTarget);
 			framebuffer->AddAttachment(renderTarget);
 			
 			ResourceUsages usage;
 			usage.Declaration = index;
-			m_ResourceUsages[declaration->ResourceName] = usage;
+			m_ResourceUsages[handle] = usage;
+
+			m_RenderTargetDescriptions.emplace_back(handle, declaration->Description);
+
+			if (declaration->bIsTransient)
+			{
+				TransientRenderTarget target;
+				target.Name = declaration->ResourceName;
+				target.Handle = handle;
+				target.Description = declaration->Description;
+				m_TransientRenderTargets.push_back(target);
+			}
 		}
 	}
 
@@ -192,7 +362,7 @@ void RenderGraph::ProcessDeclarations(std::shared_ptr<BaseRenderPass> pass, uint
 
 		ResourceUsages usage;
 		usage.Declaration = index;
-		m_ResourceUsages[declaration->ResourceName] = usage;
+		m_ResourceUsages[GetHandle(declaration->ResourceName)] = usage;
 	}
 
 	if (pass->GetBaseParameters().Type == RenderPassType::MultiPass)
@@ -225,9 +395,12 @@ void RenderGraph::ProcessReferences(std::shared_ptr<BaseRenderPass> pass, uint32
 		for (RenderTargetReference* reference : parameters.GetRenderTargetReferences())
 		{
 			std::shared_ptr<Texture> renderTarget = reference->SetValue(shared_from_this());
+			RenderGraphHandle handle = GetHandle(reference->ResourceName);
+
+			AddRenderTargetBinding(handle, framebuffer, renderTarget);
 			framebuffer->AddAttachment(renderTarget);
 
-			m_ResourceUsages[reference->ResourceName].AddWriter(index);
+			m_ResourceUsages[handle].AddWriter(index);
 		}
 	}
 
@@ -235,14 +408,14 @@ void RenderGraph::ProcessReferences(std::shared_ptr<BaseRenderPass> pass, uint32
 	{
 		reference->SetValue(shared_from_this());
 
+		ResourceUsages& usage = m_ResourceUsages[GetHandle(reference->ResourceName)];
 		if (reference->AccessMode == ReferenceAccessMode::Read)
 		{
-
-			m_ResourceUsages[reference->ResourceName].AddReader(index);
+			usage.AddReader(index);
 		}
 		else
 		{
-			m_ResourceUsages[reference->ResourceName].AddWriter(index);
+			usage.AddWriter(index);
 		}
 	}
 
@@ -256,20 +429,39 @@ void RenderGraph::ProcessReferences(std::shared_ptr<BaseRenderPass> pass, uint32
 	}
 }
 
+void RenderGraph::AddRenderTargetBinding(RenderGraphHandle handle, std::shared_ptr<Framebuffer> framebuffer, std::shared_ptr<Texture> renderTarget)
+{
+	RenderTargetBinding binding;
+	binding.Framebuffer = framebuffer;
+
+	// Same rule framebuffer uses to decide where the attachment goes
+	PixelFormat format = renderTarget->GetPixelFormat();
+	if (format != PixelFormat::Depth && format != PixelFormat::DepthStencil)
+	{
+		binding.Attachment = framebuffer->GetAttachmentsCount();
+	}
+
+	m_RenderTargetBindings[handle].push_back(binding);
+}
+
 void RenderGraph::BuildNodes()
 {
+	m_Nodes.clear();
+	m_bIsScheduleDirty = true;
+
 	for (uint32_t i = 0; i < m_Passes.size(); ++i)
 	{
 		std::shared_ptr<RenderGraphNode> node = std::make_shared<RenderGraphNode>();
 		node->Pass = m_Passes[i];
+		node->Index = i;
 		m_Nodes.push_back(node);
 	}
 
-	for (auto& [name, usage] : m_ResourceUsages)
+	for (ResourceUsages& usage : m_ResourceUsages)
 	{
 		if (!usage.Writers.empty())
 		{
-			if (usage.Declaration != usage.Writers[0])
+			if (usage.Declaration != ResourceUsages::NoDeclaration && usage.Declaration != usage.Writers[0])
 			{
 				std::shared_ptr<RenderGraphNode> declaration = m_Nodes[usage.Declaration];
 				std::shared_ptr<RenderGraphNode> firstWriter = m_Nodes[usage.Writers[0]];
@@ -288,7 +480,17 @@ void RenderGraph::BuildNodes()
 			currentWriter->Upstream.push_back(previousWriter);
 		}
 
+		for (uint32_t reader : usage.Readers)
+		{
+			m_Nodes[reader]->Reads.push_back(&usage);
+		}
+
 		uint32_t lastWriterIndex = !usage.Writers.empty() ? *usage.Writers.rbegin() : usage.Declaration;
+		if (lastWriterIndex == ResourceUsages::NoDeclaration)
+		{
+			continue;
+		}
+
 		std::shared_ptr<RenderGraphNode> lastWriter = m_Nodes[lastWriterIndex];
 
 		for (uint32_t Reader : usage.Readers)
@@ -301,8 +503,6 @@ void RenderGraph::BuildNodes()
 	}
 
 	CheckGraphForCycles();
-
-	m_ResourceUsages.clear();
 }
 
 void RenderGraph::CheckGraphForCycles()
@@ -321,10 +521,323 @@ void RenderGraph::CheckGraphForCycles()
 	}
 }
 
+void RenderGraph::BuildSchedule()
+{
+	m_OutputHandle = m_Output.empty() ? InvalidHandle : GetHandle(m_Output);
+	m_DebugOutputHandle = m_DebugOutput.empty() ? InvalidHandle : GetHandle(m_DebugOutput);
+	ED_ASSERT(m_Output.empty() || m_OutputHandle != InvalidHandle, "Render graph output isn't declared by any pass")
+
+	bool bIsSorted = SortTopologically(m_Nodes, m_SortedNodes);
+	ED_ASSERT(bIsSorted, "Render graph has cycles")
+
+	CullPasses();
+
+	m_Schedule.clear();
+	for (uint32_t index : m_SortedNodes)
+	{
+		if (!m_Nodes[index]->bIsCulled)
+		{
+			m_Schedule.push_back(index);
+		}
+	}
+
+	FuseFullscreenPasses();
+	BuildRecordingBatches();
+
+	AllocateTransientRenderTargets();
+
+	m_bIsScheduleDirty = false;
+}
+
+void RenderGraph::CullPasses()
+{
+	if (m_OutputHandle == InvalidHandle)
+	{
+		for (const std::shared_ptr<RenderGraphNode>& node : m_Nodes)
+		{
+			node->bIsCulled = !node->Pass->IsEnabled();
+		}
+
+		return;
+	}
+
+	for (const std::shared_ptr<RenderGraphNode>& node : m_Nodes)
+	{
+		node->bIsCulled = true;
+	}
+
+	// Walks back from the output, enabled producers of a used resource are kept and everything they read becomes used
+	const ResourceUsages* output = &m_ResourceUsages[m_OutputHandle];
+	std::set<const ResourceUsages*> usedResources = { output };
+	std::vector<const ResourceUsages*> resourcesToVisit = { output };
+
+	auto keepProducer = [&](uint32_t index)
+	{
+		const std::shared_ptr<RenderGraphNode>& node = m_Nodes[index];
+		if (!node->bIsCulled || !node->Pass->IsEnabled())
+		{
+			return;
+		}
+
+		node->bIsCulled = false;
+
+		for (const ResourceUsages* read : node->Reads)
+		{
+			if (usedResources.insert(read).second)
+			{
+				resourcesToVisit.push_back(read);
+			}
+		}
+	};
+
+	while (!resourcesToVisit.empty())
+	{
+		const ResourceUsages* usage = resourcesToVisit.back();
+		resourcesToVisit.pop_back();
+
+		if (usage->Declaration != ResourceUsages::NoDeclaration)
+		{
+			keepProducer(usage->Declaration);
+		}
+
+		for (uint32_t writer : usage->Writers)
+		{
+			keepProducer(writer);
+		}
+	}
+}
+
+void RenderGraph::FuseFullscreenPasses()
+{
+	for (const std::shared_ptr<RenderGraphNode>& node : m_Nodes)
+	{
+		node->FusedNodes.clear();
+		node->FusedPipelineState = nullptr;
+		node->FusedName.clear();
+	}
+
+	if (!m_bIsPassFusionEnabled)
+	{
+		return;
+	}
+
+	std::vector<FullscreenPassDescription> descriptions;
+	descriptions.reserve(m_Schedule.size());
+
+	for (uint32_t index : m_Schedule)
+	{
+		descriptions.push_back(DescribeFullscreenPass(m_Nodes[index]->Pass));
+	}
+
+	std::vector<FusedPassGroup> groups = FullscreenPassFusion::FindGroups(descriptions);
+	if (groups.empty())
+	{
+		return;
+	}
+
+	std::vector<bool> isFused(m_Schedule.size(), false);
+
+	for (const FusedPassGroup& group : groups)
+	{
+		std::shared_ptr<RenderGraphNode> node = m_Nodes[m_Schedule[group.First]];
+		for (uint32_t i = group.First + 1; i <= group.Last; ++i)
+		{
+			node->FusedNodes.push_back(m_Nodes[m_Schedule[i]]);
+			isFused[i] = true;
+		}
+
+		std::string key;
+		std::vector<std::string> defines = FullscreenPassFusion::GetDefines(descriptions, group);
+		for (const std::string& define : defines)
+		{
+			key += define + ";";
+		}
+
+		std::shared_ptr<Shader>& shader = m_FusedShaders[key];
+		if (!shader)
+		{
+			shader = RenderingHelper::CreateShader("shaders\\fused-fullscreen-pass.glsl", defines);
+		}
+
+		// Pass drawing first keeps its framebuffer, clears and blending, the rest is done by the shader
+		PipelineStateDescription description = GetPipelineStateDescription(static_cast<const BaseRenderPassParameters&>(node->Pass->GetBaseParameters()));
+		description.Shader = shader;
+
+		node->FusedPipelineState = m_PipelineStates.GetOrCreate(description);
+		node->FusedName = FullscreenPassFusion::GetName(descriptions, group);
+	}
+
+	std::vector<uint32_t> schedule;
+	for (uint32_t i = 0; i < m_Schedule.size(); ++i)
+	{
+		if (!isFused[i])
+		{
+			schedule.push_back(m_Schedule[i]);
+		}
+	}
+
+	m_Schedule = std::move(schedule);
+
+	ED_LOG(RenderGraph, info, "Fused {} fullscreen pass groups", groups.size())
+}
+
+FullscreenPassDescription RenderGraph::DescribeFullscreenPass(std::shared_ptr<BaseRenderPass> pass) const
+{
+	FullscreenPassDescription description;
+
+	RenderPassParameters& parameters = pass->GetBaseParameters();
+	if (parameters.Type != RenderPassType::Base)
+	{
+		return description;
+	}
+
+	const BaseRenderPassParameters& castedParameters = static_cast<const BaseRenderPassParameters&>(parameters);
+
+	description.Name = parameters.Name;
+	description.Feature = pass->GetFusionFeature();
+	description.bClearsTargets = castedParameters.bClearColors || castedParameters.bClearDepth;
+
+	for (RenderTargetDeclaration* declaration : parameters.GetRenderTargetDeclarations())
+	{
+		description.Writes.push_back(GetHandle(declaration->ResourceName));
+	}
+
+	for (RenderTargetReference* reference : parameters.GetRenderTargetReferences())
+	{
+		description.Writes.push_back(GetHandle(reference->ResourceName));
+	}
+
+	std::sort(description.Writes.begin(), description.Writes.end());
+
+	return description;
+}
+
+void RenderGraph::AllocateTransientRenderTargets()
+{
+	static const uint32_t NotScheduled = UINT32_MAX;
+
+	// Fused passes use their targets when the pass they are drawn with does
+	std::vector<uint32_t> positions(m_Nodes.size(), NotScheduled);
+	for (uint32_t i = 0; i < m_Schedule.size(); ++i)
+	{
+		positions[m_Schedule[i]] = i;
+
+		for (const std::shared_ptr<RenderGraphNode>& fusedNode : m_Nodes[m_Schedule[i]]->FusedNodes)
+		{
+			positions[fusedNode->Index] = i;
+		}
+	}
+
+	for (TransientRenderTarget& target : m_TransientRenderTargets)
+	{
+		target.FirstUse = TransientRenderTarget::Unassigned;
+		target.LastUse = 0;
+
+		auto addUse = [&](uint32_t index)
+		{
+			if (index != ResourceUsages::NoDeclaration && positions[index] != NotScheduled)
+			{
+				target.FirstUse = std::min(target.FirstUse, positions[index]);
+				target.LastUse = std::max(target.LastUse, positions[index]);
+			}
+		};
+
+		const ResourceUsages& usage = m_ResourceUsages[target.Handle];
+
+		addUse(usage.Declaration);
+
+		for (uint32_t writer : usage.Writers)
+		{
+			addUse(writer);
+		}
+
+		for (uint32_t reader : usage.Readers)
+		{
+			addUse(reader);
+		}
+
+		// Outputs are read after the last pass, so nothing may overwrite them until the end of the frame
+		if (target.IsUsed() && (target.Handle == m_OutputHandle || target.Handle == m_DebugOutputHandle))
+		{
+			target.LastUse = m_Schedule.size();
+		}
+	}
+
+	m_PhysicalRenderTargets = RenderTargetPool::AssignPhysicalTargets(m_TransientRenderTargets);
+	m_RenderTargetPool.Allocate(m_PhysicalRenderTargets);
+
+	for (const TransientRenderTarget& target : m_TransientRenderTargets)
+	{
+		// Nothing executes with unused targets, so they keep whatever texture they had
+		if (!target.IsUsed())
+		{
+			continue;
+		}
+
+		std::shared_ptr<Texture> texture = m_RenderTargetPool.GetTexture(target.PhysicalTarget);
+		GetResource<Texture>(target.Handle) = texture;
+
+		for (const RenderTargetBinding& binding : m_RenderTargetBindings[target.Handle])
+		{
+			if (binding.Attachment == RenderTargetBinding::DepthAttachment)
+			{
+				binding.Framebuffer->SetDepthAttachment(texture, FramebufferSizeAdjustmentMode::ResizeTextureToFramebufferSize);
+			}
+			else
+			{
+				binding.Framebuffer->SetAttachment(binding.Attachment, texture, FramebufferSizeAdjustmentMode::ResizeTextureToFramebufferSize);
+			}
+		}
+	}
+
+	// Pool can hand out textures of any size
+	m_bAreRenderTargetsDirty = true;
+
+	ED_LOG(RenderGraph, info, "Aliased {} transient render targets onto {} textures", m_TransientRenderTargets.size(), m_PhysicalRenderTargets.size())
+}
+
+void RenderGraph::ResizeRenderTargets()
+{
+	glm::u32vec2 renderSize = m_RenderSize.GetSize();
+
+	// Aliased targets share a texture, it has to be counted once
+	std::set<Texture*> reallocatedTextures;
+
+	for (const auto& [handle, description] : m_RenderTargetDescriptions)
+	{
+		glm::u32vec3 size = description.CalculateSize(renderSize);
+
+		std::shared_ptr<Texture>& texture = GetResource<Texture>(handle);
+		if (glm::u32vec2(texture->GetSize()) != glm::u32vec2(size))
+		{
+			reallocatedTextures.insert(texture.get());
+		}
+
+		// Framebuffer resizes all of its attachments, including the texture itself
+		for (const RenderTargetBinding& binding : m_RenderTargetBindings[handle])
+		{
+			binding.Framebuffer->Resize(size);
+		}
+	}
+
+	++m_RenderSizeStatistics.Resizes;
+	m_RenderSizeStatistics.Reallocations += reallocatedTextures.size();
+
+	m_bAreRenderTargetsDirty = false;
+
+	ED_LOG(RenderGraph, info, "Resized render targets to {}x{}, {} textures were reallocated", renderSize.x, renderSize.y, reallocatedTextures.size())
+}
+
 void RenderGraph::TraverseGraph(std::shared_ptr<RenderGraphNode> node)
 {
 	ED_ASSERT(node->NodeState != RenderGraphNode::VisitedButNotExited, "Render graph has cycles")
 
+	// Everything downstream of an exited node was already checked, walking it again would follow every path of the graph
+	if (node->NodeState == RenderGraphNode::VisitedAndExited)
+	{
+		return;
+	}
+
 	node->NodeState = RenderGraphNode::VisitedButNotExited;
 
 	for (const std::shared_ptr<RenderGraphNode>& dowstreamNode : node->Downstream)
@@ -337,6 +850,8 @@ void RenderGraph::TraverseGraph(std::shared_ptr<RenderGraphNode> node)
 
 void RenderGraph::ExecutePass(std::shared_ptr<BaseRenderPass> pass)
 {
+	m_Profiler.BeginScope(pass->GetBaseParameters().Name);
+
 	pass->PreExecute();
 
 	BeginPass(pass->GetBaseParameters());
@@ -344,12 +859,343 @@ void RenderGraph::ExecutePass(std::shared_ptr<BaseRenderPass> pass)
 	pass->Execute();
 
 	EndPass(pass->GetBaseParameters());
+
+	m_Profiler.EndScope();
+}
+
+void RenderGraph::RecordPass(std::shared_ptr<BaseRenderPass> pass, const std::shared_ptr<RenderingContext>& context)
+{
+	bool bIsMainContext = context == m_Context;
+	if (bIsMainContext)
+	{
+		m_Profiler.BeginScope(pass->GetBaseParameters().Name);
+	}
+
+	pass->SetContext(context);
+
+	BeginPass(pass->GetBaseParameters(), context);
+
+	pass->Execute();
+
+	EndPass(pass->GetBaseParameters());
+
+	pass->SetContext(m_Context);
+
+	if (bIsMainContext)
+	{
+		m_Profiler.EndScope();
+	}
+}
+
+void RenderGraph::RecordItems(const std::vector<RenderGraphItem>& items)
+{
+	m_ItemPasses.clear();
+	for (uint32_t item = 0; item < items.size(); ++item)
+	{
+		for (uint32_t pass = 0; pass < items[item].Passes.size(); ++pass)
+		{
+			m_ItemPasses.emplace_back(item, pass);
+		}
+	}
+
+	uint32_t count = m_ItemPasses.size();
+	bool bIsRecordedInParallel = m_bIsParallelRecordingEnabled && m_JobSystem.GetWorkersCount() > 0 && count > 1;
+
+	if (bIsRecordedInParallel)
+	{
+		while (m_CommandBuffers.size() < count)
+		{
+			m_CommandBuffers.push_back(std::make_shared<CommandBufferRenderingContext>());
+		}
+
+		m_JobSystem.ParallelFor(count, [this, &items](uint32_t index, uint32_t worker)
+		{
+			const std::shared_ptr<CommandBufferRenderingContext>& buffer = m_CommandBuffers[index];
+			buffer->Reset();
+
+			auto [item, pass] = m_ItemPasses[index];
+			RecordItemPass(*items[item].Passes[pass], items[item].Index, buffer);
+		});
+	}
+
+	// Profiler isn't thread safe, scopes of recorded passes measure the replay
+	uint32_t index = 0;
+	for (const RenderGraphItem& item : items)
+	{
+		m_Profiler.BeginScope(item.Name);
+
+		for (const std::shared_ptr<BaseRenderPass>& pass : item.Passes)
+		{
+			m_Profiler.BeginScope(pass->GetBaseParameters().Name);
+
+			if (bIsRecordedInParallel)
+			{
+				m_CommandBuffers[index++]->Replay(*m_Context);
+			}
+			else
+			{
+				RecordItemPass(*pass, item.Index, m_Context);
+			}
+
+			m_Profiler.EndScope();
+		}
+
+		m_Profiler.EndScope();
+	}
+}
+
+void RenderGraph::ExecuteNode(const RenderGraphNode& node)
+{
+	if (node.FusedNodes.empty())
+	{
+		ExecutePass(node.Pass);
+	}
+	else
+	{
+		ExecuteFusedPasses(node);
+	}
+}
+
+void RenderGraph::ExecuteFusedPasses(const RenderGraphNode& node)
+{
+	m_Profiler.BeginScope(node.FusedName);
+
+	node.Pass->PreExecute();
+	for (const std::shared_ptr<RenderGraphNode>& fusedNode : node.FusedNodes)
+	{
+		fusedNode->Pass->PreExecute();
+	}
+
+	SubmitFusedPasses(node, m_Context);
+
+	m_Profiler.EndScope();
+}
+
+void RenderGraph::SubmitFusedPasses(const RenderGraphNode& node, const std::shared_ptr<RenderingContext>& context)
+{
+	const BaseRenderPassParameters& parameters = static_cast<const BaseRenderPassParameters&>(node.Pass->GetBaseParameters());
+
+	context->SetPipelineState(node.FusedPipelineState);
+	context->SetFramebuffer(parameters.DrawFramebuffer);
+
+	if (parameters.bClearColors)
+	{
+		context->ClearColorTarget();
+	}
+
+	if (parameters.bClearDepth)
+	{
+		context->ClearDepthTarget();
+	}
+
+	// Passes set uniforms of the bound uber shader, ones of features that aren't compiled in are ignored
+	node.Pass->SubmitFullscreenParameters();
+	for (const std::shared_ptr<RenderGraphNode>& fusedNode : node.FusedNodes)
+	{
+		fusedNode->Pass->SubmitFullscreenParameters();
+	}
+
+	m_Renderer->SubmitFullScreenQuad(context);
+
+	EndPass(parameters);
+}
+
+bool RenderGraph::CanRecordInParallel(const RenderGraphNode& node) const
+{
+	if (!node.Pass->SupportsParallelRecording())
+	{
+		return false;
+	}
+
+	for (const std::shared_ptr<RenderGraphNode>& fusedNode : node.FusedNodes)
+	{
+		if (!fusedNode->Pass->SupportsParallelRecording())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void RenderGraph::BuildRecordingBatches()
+{
+	m_RecordingBatches.clear();
+
+	if (!m_bIsParallelRecordingEnabled || m_JobSystem.GetWorkersCount() == 0)
+	{
+		return;
+	}
+
+	// Culled nodes are kept, dependencies going through them still order the passes around them
+	std::vector<std::vector<bool>> ancestors(m_Nodes.size(), std::vector<bool>(m_Nodes.size(), false));
+	for (uint32_t index : m_SortedNodes)
+	{
+		for (const std::shared_ptr<RenderGraphNode>& upstreamNode : m_Nodes[index]->Upstream)
+		{
+			ancestors[index][upstreamNode->Index] = true;
+			for (uint32_t i = 0; i < m_Nodes.size(); ++i)
+			{
+				if (ancestors[upstreamNode->Index][i])
+				{
+					ancestors[index][i] = true;
+				}
+			}
+		}
+	}
+
+	RecordingBatch batch;
+	std::vector<bool> isInBatch(m_Nodes.size(), false);
+	bool bHasBatch = false;
+
+	auto closeBatch = [&]()
+	{
+		if (bHasBatch && batch.Last > batch.First)
+		{
+			m_RecordingBatches.push_back(batch);
+		}
+
+		std::fill(isInBatch.begin(), isInBatch.end(), false);
+		bHasBatch = false;
+	};
+
+	for (uint32_t i = 0; i < m_Schedule.size(); ++i)
+	{
+		const RenderGraphNode& node = *m_Nodes[m_Schedule[i]];
+		if (!CanRecordInParallel(node))
+		{
+			closeBatch();
+			continue;
+		}
+
+		// Fused passes are drawn together with the node, so they are a part of it here
+		std::vector<uint32_t> members = { node.Index };
+		for (const std::shared_ptr<RenderGraphNode>& fusedNode : node.FusedNodes)
+		{
+			members.push_back(fusedNode->Index);
+		}
+
+		bool bIsIndependent = bHasBatch;
+		for (uint32_t member : members)
+		{
+			for (uint32_t j = 0; j < m_Nodes.size() && bIsIndependent; ++j)
+			{
+				bIsIndependent = !(ancestors[member][j] && isInBatch[j]);
+			}
+		}
+
+		if (!bIsIndependent)
+		{
+			closeBatch();
+
+			batch.First = i;
+			bHasBatch = true;
+		}
+
+		batch.Last = i;
+		for (uint32_t member : members)
+		{
+			isInBatch[member] = true;
+		}
+	}
+
+	closeBatch();
+
+	uint32_t biggestBatch = 0;
+	for (const RecordingBatch& recordingBatch : m_RecordingBatches)
+	{
+		biggestBatch = std::max(biggestBatch, recordingBatch.Last - recordingBatch.First + 1);
+	}
+
+	while (m_CommandBuffers.size() < biggestBatch)
+	{
+		m_CommandBuffers.push_back(std::make_shared<CommandBufferRenderingContext>());
+	}
+
+	if (!m_RecordingBatches.empty())
+	{
+		ED_LOG(RenderGraph, info, "Found {} groups of passes recorded in parallel", m_RecordingBatches.size())
+	}
+}
+
+void RenderGraph::ExecuteRecordingBatch(const RecordingBatch& batch)
+{
+	uint32_t count = batch.Last - batch.First + 1;
+
+	// Passes resize and upload their resources here, it has to be done on the thread owning the graphics API
+	for (uint32_t i = batch.First; i <= batch.Last; ++i)
+	{
+		const RenderGraphNode& node = *m_Nodes[m_Schedule[i]];
+
+		node.Pass->PreExecute();
+		for (const std::shared_ptr<RenderGraphNode>& fusedNode : node.FusedNodes)
+		{
+			fusedNode->Pass->PreExecute();
+		}
+	}
+
+	m_JobSystem.ParallelFor(count, [this, &batch](uint32_t index, uint32_t worker)
+	{
+		const std::shared_ptr<CommandBufferRenderingContext>& buffer = m_CommandBuffers[index];
+		buffer->Reset();
+
+		RecordNode(*m_Nodes[m_Schedule[batch.First + index]], buffer);
+	});
+
+	// Profiler isn't thread safe, scopes measure the replay
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const RenderGraphNode& node = *m_Nodes[m_Schedule[batch.First + i]];
+
+		m_Profiler.BeginScope(node.FusedNodes.empty() ? node.Pass->GetBaseParameters().Name : node.FusedName);
+		m_CommandBuffers[i]->Replay(*m_Context);
+		m_Profiler.EndScope();
+	}
+}
+
+void RenderGraph::RecordNode(const RenderGraphNode& node, const std::shared_ptr<RenderingContext>& context)
+{
+	node.Pass->SetContext(context);
+	for (const std::shared_ptr<RenderGraphNode>& fusedNode : node.FusedNodes)
+	{
+		fusedNode->Pass->SetContext(context);
+	}
+
+	if (node.FusedNodes.empty())
+	{
+		BeginPass(node.Pass->GetBaseParameters(), context);
+
+		node.Pass->Execute();
+
+		EndPass(node.Pass->GetBaseParameters());
+	}
+	else
+	{
+		SubmitFusedPasses(node, context);
+	}
+
+	node.Pass->SetContext(m_Context);
+	for (const std::shared_ptr<RenderGraphNode>& fusedNode : node.FusedNodes)
+	{
+		fusedNode->Pass->SetContext(m_Context);
+	}
+}
+
+void RenderGraph::RecordItemPass(BaseRenderPass& pass, uint32_t index, const std::shared_ptr<RenderingContext>& context)
+{
+	BeginPass(pass.GetBaseParameters(), context);
+
+	pass.RecordItem(index, context);
+
+	EndPass(pass.GetBaseParameters());
 }
 
 void RenderGraph::Initilaize(std::shared_ptr<Renderer> renderer)
 {
 	m_Renderer = renderer;
 	m_Context = renderer->GetContext();
+
+	m_Profiler.SetTimer(RenderingHelper::CreateGPUTimer());
 }
 
 void ResourceUsages::AddWriter(uint32_t writer)
@@ -3,45 +3,64 @@
 #include "RenderingContex.h"
 #include "Renderer.h"
 #include "Passes/Parameters/RenderGraphParameters.h"
+#include "PipelineState.h"
+#include "RenderTargetPool.h"
+#include "RenderProfiler.h"
+#include "RenderPassTypeId.h"
+#include "FullscreenPassFusion.h"
+#include "CommandBufferRenderingContext.h"
+#include "Core/JobSystem.h"
 #include <set>
+#include <unordered_map>
 
 struct RenderPassParameters;
 class BaseRenderPass;
 
+// Interned resource or parameter name, names are resolved to handles once when passes are built and everything after it is indexed by them
+using RenderGraphHandle = uint32_t;
+
 template<typename ParameterStructClass, typename ShaderParametersClass>
 class RenderPass;
 
 struct ResourceUsages
 {
+	// Graph level parameters (scene, camera) aren't declared by any pass
+	static const uint32_t NoDeclaration = UINT32_MAX;
+
 	void AddWriter(uint32_t writer);
 	void AddReader(uint32_t reader);
 
-	uint32_t Declaration;
+	uint32_t Declaration = NoDeclaration;
 	std::vector<uint32_t> Readers;
 	std::vector<uint32_t> Writers;
 };
 
-struct RenderGraphNode
+// Place where a render target is attached, so it can be rebound when the graph moves it to another texture
+struct RenderTargetBinding
 {
-	bool CanStart() const
-	{
-		for (const std::shared_ptr<RenderGraphNode>& node : Upstream)
-		{
-			if (!node->bHasFinished)
-			{
-				return false;
-			}
-		}
-
-		return !bHasFinished;
-	}
+	static const int32_t DepthAttachment = -1;
 
+	std::shared_ptr<class Framebuffer> Framebuffer;
+	int32_t Attachment = DepthAttachment;
+};
+
+struct RenderGraphNode
+{
 	std::shared_ptr<BaseRenderPass> Pass;
-	bool bHasFinished = false;
+	uint32_t Index = 0;
+
+	// Culled passes are disabled or none of their outputs reach the graph output
+	bool bIsCulled = false;
+	std::vector<const ResourceUsages*> Reads;
 
 	std::vector<std::shared_ptr<RenderGraphNode>> Upstream;
 	std::vector<std::shared_ptr<RenderGraphNode>> Downstream;
 
+	// Passes scheduled right after this one that are drawn together with it by the fused uber shader, they aren't scheduled themselves
+	std::vector<std::shared_ptr<RenderGraphNode>> FusedNodes;
+	std::shared_ptr<PipelineState> FusedPipelineState;
+	std::string FusedName;
+
 protected:
 	static const uint32_t NotVisited = 0;
 	static const uint32_t VisitedButNotExited = 1;
@@ -52,106 +71,255 @@ protected:
 	friend class RenderGraph;
 };
 
+// Consecutive schedule entries none of which depends on another, they are recorded on worker threads and replayed in schedule order
+struct RecordingBatch
+{
+	uint32_t First = 0;
+	uint32_t Last = 0;
+};
+
+// Passes a multipass draws for one of its items after PrepareItem was called for each of them, the name is the profiler scope of the item
+struct RenderGraphItem
+{
+	std::string Name;
+	uint32_t Index = 0;
+	std::vector<std::shared_ptr<BaseRenderPass>> Passes;
+};
+
 class RenderGraph : public std::enable_shared_from_this<RenderGraph>
 {
 public:
 	void Initilaize(std::shared_ptr<Renderer> renderer);
 
+	static const RenderGraphHandle InvalidHandle = UINT32_MAX;
+
+	// Looks for the exact type, returns the first added pass of it
 	template<typename T>
-	std::shared_ptr<T> GetPass()
+	std::shared_ptr<T> GetPass() const
 	{
-		for (const std::shared_ptr<BaseRenderPass>& pass : m_Passes)
-		{
-			if (std::shared_ptr<T> castedPass = std::dynamic_pointer_cast<T>(pass))
-			{
-				return castedPass;
-			}
-		}
-
-		return nullptr;
+		uint32_t typeId = RenderPassTypeId::Get<T>();
+		return typeId < m_PassesByType.size() ? std::static_pointer_cast<T>(m_PassesByType[typeId]) : nullptr;
 	}
 
-	void AddPass(std::shared_ptr<BaseRenderPass> pass);
-
 	template<typename T>
 	void AddPass()
 	{
-		AddPass(std::make_shared<T>());
+		AddPass(std::make_shared<T>(), RenderPassTypeId::Get<T>());
+	}
+
+	template<typename T>
+	void AddPass(std::shared_ptr<T> pass)
+	{
+		AddPass(pass, RenderPassTypeId::Get<T>());
 	}
 
 	void Build();
 
+	// Resource presented at the end of the frame, passes not contributing to it are culled
+	void SetOutput(const std::string& resourceName);
+
+	// Resource viewed by the editor besides the output, it is kept alive until the end of the frame
+	void SetDebugOutput(const std::string& resourceName);
+
+	// Has to be called when passes get enabled or disabled, schedule is recompiled before the next frame
+	void Invalidate();
+
+	// Merges consecutive fullscreen passes drawing into the same targets into a single uber shader draw
+	void SetPassFusionEnabled(bool bEnabled);
+	bool IsPassFusionEnabled() const;
+
+	// Records independent passes supporting it into command buffers on worker threads, they are still submitted in schedule order
+	void SetParallelRecordingEnabled(bool bEnabled);
+	bool IsParallelRecordingEnabled() const;
+
+	RenderTargetPoolStatistics GetRenderTargetPoolStatistics() const;
+
+	// Size viewport relative render targets are allocated for, it can be bigger than the viewport while it is being resized
+	glm::u32vec2 GetRenderSize() const;
+	RenderSizeStatistics GetRenderSizeStatistics() const;
+
+	// Every executed pass is a scope, passes can open nested scopes for their own parts
+	RenderProfiler& GetProfiler();
+
+	// Workers of parallel recording, passes executed on the main thread can split their CPU work over them
+	JobSystem& GetJobSystem();
+
+	// Shared state for a description, for passes switching between variants of the state created for them at build
+	std::shared_ptr<PipelineState> GetPipelineState(const PipelineStateDescription& description);
+
 	void Update(float deltaSeconds);
+
+	// Kahn's algorithm over node indices. Ready nodes are taken in the order they became ready, roots first by index, so the order is stable
+	// between builds of the same graph. Returns false if the graph has cycles
+	static bool SortTopologically(const std::vector<std::shared_ptr<RenderGraphNode>>& nodes, std::vector<uint32_t>& order);
 	void ExecutePass(std::shared_ptr<BaseRenderPass> pass);
 
+	// Draws a pass of a multipass that already ran its PreExecute into the context the multipass submits to, so multipasses supporting
+	// parallel recording can be recorded with their passes. Profiler scope is opened only on the main context
+	void RecordPass(std::shared_ptr<BaseRenderPass> pass, const std::shared_ptr<RenderingContext>& context);
+
+	// Records items of a multipass executed on the main thread, every pass of an item into its own command buffer on the workers, and replays
+	// them in order. Items are recorded straight into the context when parallel recording is disabled
+	void RecordItems(const std::vector<RenderGraphItem>& items);
+
 	std::shared_ptr<Renderer> GetRenderer() const;
 	std::shared_ptr<RenderingContext> GetContext() const;
 
+	// Returns InvalidHandle for names nothing has declared or referenced, handles stay valid for the lifetime of the graph
+	RenderGraphHandle GetHandle(const std::string& name) const;
+	const std::string& GetName(RenderGraphHandle handle) const;
+
 	template<typename T>
 	void DeclareResource(const std::string& name, std::shared_ptr<T>& resource)
 	{
-		ED_ASSERT(!m_Resources.contains(name), "Resource with this name already exists")
-		m_Resources[name] = reinterpret_cast<std::shared_ptr<Resource>*>(&resource);
+		RenderGraphHandle handle = Intern(name);
+		ED_ASSERT(!m_Resources[handle], "Resource with this name already exists")
+		m_Resources[handle] = reinterpret_cast<std::shared_ptr<Resource>*>(&resource);
 	}
 
+	std::shared_ptr<Resource>& GetResource(RenderGraphHandle handle) const;
 	std::shared_ptr<Resource>& GetResource(const std::string& name) const;
-	
+
+	template<typename T>
+	std::shared_ptr<T>& GetResource(RenderGraphHandle handle) const
+	{
+		ED_ASSERT(handle < m_Resources.size() && m_Resources[handle], "This resource doesn't exist")
+		return *reinterpret_cast<std::shared_ptr<T>*>(m_Resources[handle]);
+	}
+
 	template<typename T>
 	std::shared_ptr<T>& GetResource(const std::string& name) const
 	{
-		ED_ASSERT(m_Resources.contains(name), "This parameter doesn't exist")
-		return *reinterpret_cast<std::shared_ptr<T>*>(m_Resources.at(name));
+		return GetResource<T>(GetHandle(name));
 	}
 	
 	template<typename T>
 	void DeclareParameter(const std::string& name, T& value)
 	{
 		std::shared_ptr<RenderGraphParemeter<T>> parameter = std::make_shared<RenderGraphParemeter<T>>(name, value);
-		m_Parameters[name] = std::move(parameter);
+		m_Parameters[Intern(name)] = std::move(parameter);
 	}
 
 	template<typename T>
 	void DeclareObjectPtrParameter(const std::string& name, std::shared_ptr<T>& value)
 	{
 		std::shared_ptr<RenderGraphObjectPtrParameter<T>> parameter = std::make_shared<RenderGraphObjectPtrParameter<T>>(name, value);
-		m_Parameters[name] = std::move(parameter);
+		m_Parameters[Intern(name)] = std::move(parameter);
+	}
+
+	template<typename T>
+	T& GetParameterValue(RenderGraphHandle handle) const
+	{
+		ED_ASSERT(handle < m_Parameters.size() && m_Parameters[handle], "This parameter doesn't exist")
+		return std::static_pointer_cast<RenderGraphParemeter<T>>(m_Parameters[handle])->GetValue();
 	}
 
 	template<typename T>
-	T& GetParameterValue(const std::string& name)
+	T& GetParameterValue(const std::string& name) const
 	{
-		ED_ASSERT(m_Parameters.contains(name), "This parameter doesn't exist")
-		return std::static_pointer_cast<RenderGraphParemeter<T>>(m_Parameters[name])->GetValue();
+		return GetParameterValue<T>(GetHandle(name));
 	}
 
 	template<typename T>
-	std::shared_ptr<T>& GetObjectPtrParameterValue(const std::string& name)
+	std::shared_ptr<T>& GetObjectPtrParameterValue(RenderGraphHandle handle) const
 	{
-		ED_ASSERT(m_Parameters.contains(name), "This parameter doesn't exist")
-		return std::static_pointer_cast<RenderGraphObjectPtrParameter<T>>(m_Parameters[name])->GetValue();
+		ED_ASSERT(handle < m_Parameters.size() && m_Parameters[handle], "This parameter doesn't exist")
+		return std::static_pointer_cast<RenderGraphObjectPtrParameter<T>>(m_Parameters[handle])->GetValue();
+	}
+
+	template<typename T>
+	std::shared_ptr<T>& GetObjectPtrParameterValue(const std::string& name) const
+	{
+		return GetObjectPtrParameterValue<T>(GetHandle(name));
 	}
 
 	virtual void BeginPass(const RenderPassParameters& inParameters);
 	virtual void EndPass(const RenderPassParameters& inParameters);
 
+	void BeginPass(const RenderPassParameters& inParameters, const std::shared_ptr<RenderingContext>& context);
+
 protected:
+	void AddPass(std::shared_ptr<BaseRenderPass> pass, uint32_t typeId);
+
+	// Returns the handle of the name, assigning a new one if it is seen for the first time
+	RenderGraphHandle Intern(const std::string& name);
+
 	void InitializePasses();
+	void CreatePipelineStates(std::shared_ptr<BaseRenderPass> pass);
 	void ProcessDeclarations(std::shared_ptr<BaseRenderPass> pass, uint32_t index);
 	void ProcessReferences(std::shared_ptr<BaseRenderPass> pass, uint32_t index);
+	void AddRenderTargetBinding(RenderGraphHandle handle, std::shared_ptr<Framebuffer> framebuffer, std::shared_ptr<Texture> renderTarget);
 	
 	void BuildNodes();
 	void CheckGraphForCycles();
 	void TraverseGraph(std::shared_ptr<RenderGraphNode> node);
+	void BuildSchedule();
+	void CullPasses();
+	void FuseFullscreenPasses();
+	FullscreenPassDescription DescribeFullscreenPass(std::shared_ptr<BaseRenderPass> pass) const;
+	void ExecuteNode(const RenderGraphNode& node);
+	void ExecuteFusedPasses(const RenderGraphNode& node);
+	void SubmitFusedPasses(const RenderGraphNode& node, const std::shared_ptr<RenderingContext>& context);
+
+	bool CanRecordInParallel(const RenderGraphNode& node) const;
+	void BuildRecordingBatches();
+	void ExecuteRecordingBatch(const RecordingBatch& batch);
+	void RecordNode(const RenderGraphNode& node, const std::shared_ptr<RenderingContext>& context);
+	void RecordItemPass(BaseRenderPass& pass, uint32_t index, const std::shared_ptr<RenderingContext>& context);
+	void AllocateTransientRenderTargets();
+	void ResizeRenderTargets();
 protected:
 	std::vector<std::shared_ptr<BaseRenderPass>> m_Passes;
+	std::vector<std::shared_ptr<BaseRenderPass>> m_PassesByType;
+
+	std::unordered_map<std::string, RenderGraphHandle> m_Handles;
+	std::vector<std::string> m_Names;
 
-	std::map<std::string, ResourceUsages> m_ResourceUsages;
+	// Indexed by handle, nodes point into it so it must not grow after BuildNodes
+	std::vector<ResourceUsages> m_ResourceUsages;
 	std::vector<std::shared_ptr<RenderGraphNode>> m_Nodes;
-	std::queue<std::shared_ptr<RenderGraphNode>> m_ExecutionQueue;
+
+	// Indices of not culled nodes in execution order, rebuilt only when nodes or enabled passes change
+	std::vector<uint32_t> m_Schedule;
+	std::vector<uint32_t> m_SortedNodes;
+	bool m_bIsScheduleDirty = true;
+
+	bool m_bIsPassFusionEnabled = true;
+
+	bool m_bIsParallelRecordingEnabled = true;
+	std::vector<RecordingBatch> m_RecordingBatches;
+
+	// One per node of the biggest batch or per pass of the most items recorded at once, reused every frame so their memory isn't reallocated
+	std::vector<std::shared_ptr<CommandBufferRenderingContext>> m_CommandBuffers;
+	// Item and pass of every recorded command buffer
+	std::vector<std::pair<uint32_t, uint32_t>> m_ItemPasses;
+	JobSystem m_JobSystem;
+
+	// Uber shader variants by their joined defines, they survive schedule rebuilds
+	std::map<std::string, std::shared_ptr<Shader>> m_FusedShaders;
+
+	std::string m_Output;
+	std::string m_DebugOutput;
+	RenderGraphHandle m_OutputHandle = InvalidHandle;
+	RenderGraphHandle m_DebugOutputHandle = InvalidHandle;
+
+	std::vector<TransientRenderTarget> m_TransientRenderTargets;
+	std::vector<RenderTargetDescription> m_PhysicalRenderTargets;
+	std::vector<std::vector<RenderTargetBinding>> m_RenderTargetBindings;
+	std::vector<std::pair<RenderGraphHandle, RenderTargetDescription>> m_RenderTargetDescriptions;
+	RenderTargetPool m_RenderTargetPool;
+
+	RenderSizeTracker m_RenderSize;
+	RenderSizeStatistics m_RenderSizeStatistics;
+	bool m_bAreRenderTargetsDirty = true;
+
+	RenderProfiler m_Profiler;
+
+	PipelineStateCache m_PipelineStates;
 
 	std::shared_ptr<RenderingContext>  m_Context;
 	std::shared_ptr<Renderer> m_Renderer;
 
-	std::map<std::string, std::shared_ptr<Resource>*> m_Resources;
-	std::map<std::string, std::shared_ptr<RenderGraphBaseParameter>> m_Parameters;
+	std::vector<std::shared_ptr<Resource>*> m_Resources;
+	std::vector<std::shared_ptr<RenderGraphBaseParameter>> m_Parameters;
 };
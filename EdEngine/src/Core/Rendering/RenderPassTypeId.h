@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+// Dense id of a pass type, it is assigned on the first use and is used as an index, so passes are found without dynamic casts
+class RenderPassTypeId
+{
+public:
+	template<typename T>
+	static uint32_t Get()
+	{
+		static const uint32_t id = s_TypesCount++;
+		return id;
+	}
+
+private:
+	static inline uint32_t s_TypesCount = 0;
+};
@@ -0,0 +1,208 @@
+#include "RenderProfiler.h"
+#include "Core/Macros.h"
+#include <algorithm>
+
+RenderProfiler::RenderProfiler()
+{
+	Scope root;
+	root.Name = "Frame";
+
+	m_Scopes.push_back(std::move(root));
+}
+
+void RenderProfiler::SetTimer(std::shared_ptr<GPUTimer> timer)
+{
+	m_Timer = timer;
+}
+
+void RenderProfiler::SetEnabled(bool bEnabled)
+{
+	m_bIsEnabled = bEnabled;
+}
+
+bool RenderProfiler::IsEnabled() const
+{
+	return m_bIsEnabled;
+}
+
+void RenderProfiler::BeginFrame()
+{
+	m_bIsFrameProfiled = m_bIsEnabled;
+	if (!m_bIsFrameProfiled)
+	{
+		return;
+	}
+
+	ReadGPUTimes();
+	PushScope(0);
+}
+
+void RenderProfiler::EndFrame()
+{
+	if (!m_bIsFrameProfiled)
+	{
+		return;
+	}
+
+	ED_ASSERT(m_OpenScopes.size() == 1, "Every profiler scope has to be ended before the end of the frame")
+	EndScope();
+
+	for (Scope& scope : m_Scopes)
+	{
+		scope.CPUHistory[m_CPUHistoryIndex] = scope.FrameCPUTime;
+		scope.FrameCPUTime = 0.0f;
+	}
+
+	m_CPUHistoryIndex = (m_CPUHistoryIndex + 1) % HistorySize;
+	if (m_CPUFramesCount < HistorySize)
+	{
+		++m_CPUFramesCount;
+	}
+}
+
+void RenderProfiler::BeginScope(const std::string& name)
+{
+	if (!m_bIsFrameProfiled)
+	{
+		return;
+	}
+
+	ED_ASSERT(!m_OpenScopes.empty(), "Profiler scopes can be opened only between BeginFrame and EndFrame")
+
+	uint32_t parentIndex = m_OpenScopes.back().Scope;
+	Scope& parent = m_Scopes[parentIndex];
+
+	uint32_t index = 0;
+	if (auto it = parent.ChildrenByName.find(name); it != parent.ChildrenByName.end())
+	{
+		index = it->second;
+	}
+	else
+	{
+		index = m_Scopes.size();
+		parent.ChildrenByName.emplace(name, index);
+		parent.Children.push_back(index);
+
+		Scope scope;
+		scope.Name = name;
+		scope.Depth = parent.Depth + 1;
+
+		// Invalidates parent
+		m_Scopes.push_back(std::move(scope));
+	}
+
+	PushScope(index);
+}
+
+void RenderProfiler::EndScope()
+{
+	if (!m_bIsFrameProfiled)
+	{
+		return;
+	}
+
+	ED_ASSERT(!m_OpenScopes.empty(), "There is no profiler scope to end")
+
+	const OpenScope& openScope = m_OpenScopes.back();
+
+	Scope& scope = m_Scopes[openScope.Scope];
+	scope.FrameCPUTime += std::chrono::duration<float, std::milli>(Clock::now() - openScope.Start).count();
+
+	if (openScope.StartTimestamp != NoTimestamp)
+	{
+		ScopeTimestamps timestamps;
+		timestamps.Scope = openScope.Scope;
+		timestamps.Start = openScope.StartTimestamp;
+		timestamps.End = m_Timer->WriteTimestamp();
+
+		m_PendingTimestamps[m_CurrentSet].push_back(timestamps);
+	}
+
+	m_OpenScopes.pop_back();
+}
+
+std::vector<ProfilerScopeStatistics> RenderProfiler::GetStatistics() const
+{
+	std::vector<ProfilerScopeStatistics> statistics;
+	statistics.reserve(m_Scopes.size());
+
+	GetStatistics(0, statistics);
+
+	return statistics;
+}
+
+void RenderProfiler::PushScope(uint32_t scope)
+{
+	OpenScope openScope;
+	openScope.Scope = scope;
+	openScope.StartTimestamp = m_Timer ? m_Timer->WriteTimestamp() : NoTimestamp;
+	openScope.Start = Clock::now();
+
+	m_OpenScopes.push_back(openScope);
+}
+
+void RenderProfiler::ReadGPUTimes()
+{
+	if (!m_Timer)
+	{
+		return;
+	}
+
+	// Timer switches query sets in the same order
+	m_CurrentSet = (m_CurrentSet + 1) % GPUTimer::FramesInFlight;
+	std::vector<ScopeTimestamps>& pending = m_PendingTimestamps[m_CurrentSet];
+
+	if (m_Timer->BeginFrame(m_Timestamps) && !pending.empty())
+	{
+		for (const ScopeTimestamps& timestamps : pending)
+		{
+			if (timestamps.End < m_Timestamps.size())
+			{
+				m_Scopes[timestamps.Scope].FrameGPUTime += (m_Timestamps[timestamps.End] - m_Timestamps[timestamps.Start]) / 1000000.0f;
+			}
+		}
+
+		for (Scope& scope : m_Scopes)
+		{
+			scope.GPUHistory[m_GPUHistoryIndex] = scope.FrameGPUTime;
+			scope.FrameGPUTime = 0.0f;
+		}
+
+		m_GPUHistoryIndex = (m_GPUHistoryIndex + 1) % HistorySize;
+		if (m_GPUFramesCount < HistorySize)
+		{
+			++m_GPUFramesCount;
+		}
+	}
+
+	pending.clear();
+}
+
+void RenderProfiler::GetStatistics(uint32_t index, std::vector<ProfilerScopeStatistics>& statistics) const
+{
+	const Scope& scope = m_Scopes[index];
+
+	ProfilerScopeStatistics scopeStatistics;
+	scopeStatistics.Name = scope.Name;
+	scopeStatistics.Depth = scope.Depth;
+
+	// History is zero initialized, so frames that weren't recorded yet don't change the sums
+	for (uint32_t i = 0; i < HistorySize; ++i)
+	{
+		scopeStatistics.AverageCPUTime += scope.CPUHistory[i];
+		scopeStatistics.MaxCPUTime = std::max(scopeStatistics.MaxCPUTime, scope.CPUHistory[i]);
+
+		scopeStatistics.AverageGPUTime += scope.GPUHistory[i];
+		scopeStatistics.MaxGPUTime = std::max(scopeStatistics.MaxGPUTime, scope.GPUHistory[i]);
+	}
+
+	scopeStatistics.AverageCPUTime /= std::max(m_CPUFramesCount, 1u);
+	scopeStatistics.AverageGPUTime /= std::max(m_GPUFramesCount, 1u);
+
+	statistics.push_back(std::move(scopeStatistics));
+
+	for (uint32_t child : scope.Children)
+	{
+		GetStatistics(child, statistics);
+	}
+}
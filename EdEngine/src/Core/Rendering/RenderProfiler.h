@@ -0,0 +1,105 @@
+#pragma once
+
+#include "GPUTimer.h"
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+
+struct ProfilerScopeStatistics
+{
+	std::string Name;
+	uint32_t Depth = 0;
+
+	// Milliseconds per frame over the last RenderProfiler::HistorySize frames, a scope entered several times in a frame is summed
+	float AverageCPUTime = 0.0f;
+	float MaxCPUTime = 0.0f;
+
+	float AverageGPUTime = 0.0f;
+	float MaxGPUTime = 0.0f;
+};
+
+// Collects nested CPU and GPU timing scopes, root scope covers the whole frame.
+// Scopes are identified by the name and the parent, so passes executed for every light are separate when each light opens its own scope
+class RenderProfiler
+{
+public:
+	static const uint32_t HistorySize = 64;
+
+	RenderProfiler();
+
+	// Without a timer only CPU time is measured
+	void SetTimer(std::shared_ptr<GPUTimer> timer);
+
+	// Takes effect at the next frame
+	void SetEnabled(bool bEnabled);
+	bool IsEnabled() const;
+
+	void BeginFrame();
+	void EndFrame();
+
+	void BeginScope(const std::string& name);
+	void EndScope();
+
+	// Scopes in depth first order
+	std::vector<ProfilerScopeStatistics> GetStatistics() const;
+
+protected:
+	using Clock = std::chrono::steady_clock;
+
+	static const uint32_t NoTimestamp = UINT32_MAX;
+
+	struct Scope
+	{
+		std::string Name;
+		uint32_t Depth = 0;
+
+		std::map<std::string, uint32_t, std::less<>> ChildrenByName;
+		std::vector<uint32_t> Children;
+
+		// Time spent in the current frame
+		float FrameCPUTime = 0.0f;
+		float FrameGPUTime = 0.0f;
+
+		float CPUHistory[HistorySize] = {};
+		float GPUHistory[HistorySize] = {};
+	};
+
+	struct OpenScope
+	{
+		uint32_t Scope = 0;
+		Clock::time_point Start;
+		uint32_t StartTimestamp = NoTimestamp;
+	};
+
+	struct ScopeTimestamps
+	{
+		uint32_t Scope = 0;
+		uint32_t Start = 0;
+		uint32_t End = 0;
+	};
+
+	void PushScope(uint32_t scope);
+	void ReadGPUTimes();
+	void GetStatistics(uint32_t scope, std::vector<ProfilerScopeStatistics>& statistics) const;
+
+protected:
+	std::shared_ptr<GPUTimer> m_Timer;
+
+	bool m_bIsEnabled = true;
+	bool m_bIsFrameProfiled = false;
+
+	// Root is the first one
+	std::vector<Scope> m_Scopes;
+	std::vector<OpenScope> m_OpenScopes;
+
+	// Timestamps written in each of the frames in flight, they are matched with results when the timer reuses the query set
+	std::vector<ScopeTimestamps> m_PendingTimestamps[GPUTimer::FramesInFlight];
+	std::vector<uint64_t> m_Timestamps;
+	uint32_t m_CurrentSet = 0;
+
+	uint32_t m_CPUHistoryIndex = 0;
+	uint32_t m_GPUHistoryIndex = 0;
+	uint32_t m_CPUFramesCount = 0;
+	uint32_t m_GPUFramesCount = 0;
+};
@@ -0,0 +1,247 @@
+#include "RenderQueue.h"
+#include <glm/common.hpp>
+#include <glm/exponential.hpp>
+
+uint64_t RenderQueue::MakeSortKey(RenderQueuePass pass, uint32_t depthBucket, uint32_t materialId, uint32_t geometryId)
+{
+	uint64_t key = (uint64_t)pass & ((1ull << PassBits) - 1);
+	key = (key << DepthBucketBits) | (depthBucket & ((1ull << DepthBucketBits) - 1));
+	key = (key << MaterialBits) | (materialId & ((1ull << MaterialBits) - 1));
+	key = (key << GeometryBits) | (geometryId & ((1ull << GeometryBits) - 1));
+	return key;
+}
+
+uint32_t RenderQueue::GetKeyPass(uint64_t key)
+{
+	return (key >> (DepthBucketBits + MaterialBits + GeometryBits)) & ((1ull << PassBits) - 1);
+}
+
+uint32_t RenderQueue::GetKeyDepthBucket(uint64_t key)
+{
+	return (key >> (MaterialBits + GeometryBits)) & ((1ull << DepthBucketBits) - 1);
+}
+
+uint32_t RenderQueue::GetKeyMaterialId(uint64_t key)
+{
+	return (key >> GeometryBits) & ((1ull << MaterialBits) - 1);
+}
+
+uint32_t RenderQueue::GetKeyGeometryId(uint64_t key)
+{
+	return key & ((1ull << GeometryBits) - 1);
+}
+
+uint32_t RenderQueue::CalculateDepthBucket(float depth, float nearPlane, float farPlane)
+{
+	nearPlane = glm::max(nearPlane, 0.001f);
+	farPlane = glm::max(farPlane, nearPlane * 1.001f);
+	depth = glm::clamp(depth, nearPlane, farPlane);
+
+	float normalized = glm::log(depth / nearPlane) / glm::log(farPlane / nearPlane);
+	return glm::min<uint32_t>(normalized * DepthBucketsCount, DepthBucketsCount - 1);
+}
+
+uint32_t RenderQueue::GetMaterialId(const Material* material)
+{
+	return GetInternedId(m_MaterialIds, material, MaterialBits);
+}
+
+uint32_t RenderQueue::GetGeometryId(const StaticSubmesh* submesh)
+{
+	return GetInternedId(m_GeometryIds, submesh, GeometryBits);
+}
+
+void RenderQueue::Clear()
+{
+	for (InternedIds* ids : { &m_MaterialIds, &m_GeometryIds })
+	{
+		if (ids->Entries.size() > 2 * ids->UsedCount + MinPrunedEntriesCount)
+		{
+			PruneInternedIds(*ids);
+		}
+		ids->UsedCount = 0;
+	}
+	++m_Fill;
+
+	m_Packets.clear();
+	m_Commands.clear();
+	m_Batches.clear();
+}
+
+void RenderQueue::Submit(uint64_t key, const DrawCommand& command)
+{
+	m_Packets.push_back({ key, (uint32_t)m_Commands.size() });
+	m_Commands.push_back(command);
+}
+
+void RenderQueue::GroupInstances()
+{
+	m_GroupDepthBuckets.clear();
+
+	for (const DrawPacket& packet : m_Packets)
+	{
+		uint64_t group = packet.SortKey & ~DepthBucketMask;
+		uint64_t depthBucket = packet.SortKey & DepthBucketMask;
+
+		auto [it, bInserted] = m_GroupDepthBuckets.try_emplace(group, depthBucket);
+		if (!bInserted && depthBucket < it->second)
+		{
+			it->second = depthBucket;
+		}
+	}
+
+	for (DrawPacket& packet : m_Packets)
+	{
+		uint64_t group = packet.SortKey & ~DepthBucketMask;
+		packet.SortKey = group | m_GroupDepthBuckets[group];
+	}
+}
+
+void RenderQueue::Sort()
+{
+	// LSD radix sort with 8 bit digits, it is stable so submission order is kept for equal keys
+	static const uint32_t DigitBits = 8;
+	static const uint32_t DigitsCount = 1 << DigitBits;
+	static const uint32_t PassesCount = 64 / DigitBits;
+
+	if (m_Packets.size() < 2)
+	{
+		return;
+	}
+
+	m_SortBuffer.resize(m_Packets.size());
+
+	uint32_t counts[PassesCount][DigitsCount] = {};
+
+	for (const DrawPacket& packet : m_Packets)
+	{
+		for (uint32_t pass = 0; pass < PassesCount; ++pass)
+		{
+			++counts[pass][(packet.SortKey >> (pass * DigitBits)) & (DigitsCount - 1)];
+		}
+	}
+
+	for (uint32_t pass = 0; pass < PassesCount; ++pass)
+	{
+		uint32_t* passCounts = counts[pass];
+
+		// All keys have the same digit, so this pass won't change the order
+		if (passCounts[(m_Packets[0].SortKey >> (pass * DigitBits)) & (DigitsCount - 1)] == m_Packets.size())
+		{
+			continue;
+		}
+
+		uint32_t offset = 0;
+		for (uint32_t digit = 0; digit < DigitsCount; ++digit)
+		{
+			uint32_t count = passCounts[digit];
+			passCounts[digit] = offset;
+			offset += count;
+		}
+
+		for (const DrawPacket& packet : m_Packets)
+		{
+			m_SortBuffer[passCounts[(packet.SortKey >> (pass * DigitBits)) & (DigitsCount - 1)]++] = packet;
+		}
+
+		m_Packets.swap(m_SortBuffer);
+	}
+}
+
+void RenderQueue::BuildBatches()
+{
+	m_Batches.clear();
+
+	for (uint32_t i = 0; i < m_Packets.size(); ++i)
+	{
+		if (!m_Batches.empty())
+		{
+			DrawBatch& batch = m_Batches.back();
+			if ((m_Packets[batch.FirstPacket].SortKey & ~DepthBucketMask) == (m_Packets[i].SortKey & ~DepthBucketMask))
+			{
+				++batch.Count;
+				continue;
+			}
+		}
+
+		m_Batches.push_back({ i, 1 });
+	}
+}
+
+const std::vector<DrawPacket>& RenderQueue::GetPackets() const
+{
+	return m_Packets;
+}
+
+const DrawCommand& RenderQueue::GetCommand(const DrawPacket& packet) const
+{
+	return m_Commands[packet.CommandIndex];
+}
+
+const std::vector<DrawBatch>& RenderQueue::GetBatches() const
+{
+	return m_Batches;
+}
+
+uint32_t RenderQueue::GetSize() const
+{
+	return m_Packets.size();
+}
+
+bool RenderQueue::IsEmpty() const
+{
+	return m_Packets.empty();
+}
+
+uint32_t RenderQueue::GetInternedId(InternedIds& ids, const void* object, uint32_t bits)
+{
+	auto [it, bInserted] = ids.Entries.try_emplace(object);
+	InternedIds::Entry& entry = it->second;
+
+	if (!bInserted)
+	{
+		if (entry.LastFill != m_Fill)
+		{
+			entry.LastFill = m_Fill;
+			++ids.UsedCount;
+		}
+		return entry.Id;
+	}
+
+	entry.LastFill = m_Fill;
+	++ids.UsedCount;
+
+	if (ids.FreeIds.empty() && ids.NextId == (1u << bits))
+	{
+		PruneInternedIds(ids);
+		ED_ASSERT(!ids.FreeIds.empty(), "More distinct objects in one fill than the sort key has ids for")
+	}
+
+	if (ids.FreeIds.empty())
+	{
+		entry.Id = ids.NextId++;
+	}
+	else
+	{
+		entry.Id = ids.FreeIds.back();
+		ids.FreeIds.pop_back();
+	}
+
+	return entry.Id;
+}
+
+void RenderQueue::PruneInternedIds(InternedIds& ids)
+{
+	for (auto it = ids.Entries.begin(); it != ids.Entries.end();)
+	{
+		if (it->second.LastFill != m_Fill)
+		{
+			ids.FreeIds.push_back(it->second.Id);
+			it = ids.Entries.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "Core/Ed.h"
+#include <glm/mat3x3.hpp>
+
+class StaticSubmesh;
+class Material;
+
+enum class RenderQueuePass : uint8_t
+{
+	GBuffer,
+	Shadow
+};
+
+// Sort key layout (most significant bits first): pass | depth bucket | material id | geometry id
+struct DrawPacket
+{
+	uint64_t SortKey;
+	uint32_t CommandIndex;
+};
+
+// Range of sorted packets sharing pass, material and geometry, drawn with one instanced draw
+struct DrawBatch
+{
+	uint32_t FirstPacket;
+	uint32_t Count;
+};
+
+// Ids of objects submitted to a queue. Pointers can outlive their objects once assets unload, so entries not used by the latest fill
+// are dropped when the table grows or runs out of ids, and their ids are handed out again
+struct InternedIds
+{
+	struct Entry
+	{
+		uint32_t Id;
+		uint32_t LastFill;
+	};
+
+	std::unordered_map<const void*, Entry> Entries;
+	std::vector<uint32_t> FreeIds;
+	uint32_t NextId = 0;
+	// Entries used since the last Clear
+	uint32_t UsedCount = 0;
+};
+
+struct DrawCommand
+{
+	// Raw pointers are fine here, scene keeps meshes alive for the whole frame
+	class StaticSubmesh* Submesh = nullptr;
+	class Material* Material = nullptr;
+
+	glm::mat4 ModelMatrix;
+	glm::mat4 PreviousModelMatrix;
+	glm::mat3 NormalMatrix;
+
+	// Zero scale means the submesh has no region in the bound lightmap
+	glm::vec4 LightmapScaleOffset = glm::vec4(0.0f);
+};
+
+class RenderQueue
+{
+public:
+	static const uint32_t PassBits = 8;
+	static const uint32_t DepthBucketBits = 8;
+	static const uint32_t MaterialBits = 24;
+	static const uint32_t GeometryBits = 24;
+
+	static const uint32_t DepthBucketsCount = 1 << DepthBucketBits;
+
+	static uint64_t MakeSortKey(RenderQueuePass pass, uint32_t depthBucket, uint32_t materialId, uint32_t geometryId);
+
+	static uint32_t GetKeyPass(uint64_t key);
+	static uint32_t GetKeyDepthBucket(uint64_t key);
+	static uint32_t GetKeyMaterialId(uint64_t key);
+	static uint32_t GetKeyGeometryId(uint64_t key);
+
+	// Logarithmic distribution, so close objects get finer buckets than distant ones
+	static uint32_t CalculateDepthBucket(float depth, float nearPlane, float farPlane);
+
+	uint32_t GetMaterialId(const Material* material);
+	uint32_t GetGeometryId(const StaticSubmesh* submesh);
+
+	void Clear();
+
+	void Submit(uint64_t key, const DrawCommand& command);
+
+	// Moves packets with the same pass, material and geometry to the closest depth bucket among them, so they end up adjacent after sorting
+	void GroupInstances();
+
+	void Sort();
+
+	// Has to be called after Sort
+	void BuildBatches();
+
+	const std::vector<DrawPacket>& GetPackets() const;
+	const DrawCommand& GetCommand(const DrawPacket& packet) const;
+	const std::vector<DrawBatch>& GetBatches() const;
+
+	uint32_t GetSize() const;
+	bool IsEmpty() const;
+
+protected:
+	static const uint64_t DepthBucketMask = ((1ull << DepthBucketBits) - 1) << (MaterialBits + GeometryBits);
+	// Stale entries are kept until there are more of them than this and twice the used ones
+	static const uint32_t MinPrunedEntriesCount = 1024;
+
+	uint32_t GetInternedId(InternedIds& ids, const void* object, uint32_t bits);
+	// Drops entries not used since the last Clear
+	void PruneInternedIds(InternedIds& ids);
+
+protected:
+	std::vector<DrawPacket> m_Packets;
+	std::vector<DrawPacket> m_SortBuffer;
+	std::vector<DrawCommand> m_Commands;
+	std::vector<DrawBatch> m_Batches;
+
+	std::unordered_map<uint64_t, uint64_t> m_GroupDepthBuckets;
+
+	InternedIds m_MaterialIds;
+	InternedIds m_GeometryIds;
+	uint32_t m_Fill = 0;
+};
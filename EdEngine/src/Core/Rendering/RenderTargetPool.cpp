@@ -0,0 +1,198 @@
+#include "RenderTargetPool.h"
+#include "Utils/RenderingHelper.h"
+#include <algorithm>
+
+static PixelFormat GetPixelFormat(const RenderTargetDescription& description)
+{
+	switch (description.Type)
+	{
+	case TextureType::Texture2D:      return RenderingHelper::GetRenderTargetTexture2DImportParameters(description.Format)->Format;
+	case TextureType::CubeTexture:    return RenderingHelper::GetRenderTargetCubeTextureImportParameters(description.Format)->Format;
+	case TextureType::Texture2DArray: return RenderingHelper::GetRenderTargetTexture2DArrayImportParameters(description.Format)->Format;
+	default:
+		ED_ASSERT(0, "Unsupported texture type")
+	}
+
+	return PixelFormat::RGBA8F;
+}
+
+glm::u32vec3 RenderTargetDescription::CalculateSize(glm::u32vec2 renderSize) const
+{
+	uint32_t width = std::clamp((uint32_t)(renderSize.x * Scale), MinSize, MaxSize);
+	uint32_t height = std::clamp((uint32_t)(renderSize.y * Scale), MinSize, MaxSize);
+
+	// Cube faces are square, their size is taken from the width
+	if (Type == TextureType::CubeTexture)
+	{
+		height = width;
+	}
+
+	return glm::u32vec3(std::max(width, 1u), std::max(height, 1u), Layers);
+}
+
+uint64_t RenderTargetDescription::CalculateMemory(glm::u32vec2 renderSize) const
+{
+	glm::u32vec3 size = CalculateSize(renderSize);
+	uint64_t layers = Type == TextureType::CubeTexture ? 6 * Layers : Layers;
+
+	return (uint64_t)size.x * size.y * layers * Types::GetPixelSize(GetPixelFormat(*this));
+}
+
+bool RenderTargetDescription::operator==(const RenderTargetDescription& other) const
+{
+	return Type == other.Type && Format == other.Format && Scale == other.Scale && MinSize == other.MinSize && MaxSize == other.MaxSize && Layers == other.Layers;
+}
+
+bool TransientRenderTarget::IsUsed() const
+{
+	return FirstUse <= LastUse;
+}
+
+std::vector<RenderTargetDescription> RenderTargetPool::AssignPhysicalTargets(std::vector<TransientRenderTarget>& targets)
+{
+	std::vector<uint32_t> order;
+	for (uint32_t i = 0; i < targets.size(); ++i)
+	{
+		targets[i].PhysicalTarget = TransientRenderTarget::Unassigned;
+
+		if (targets[i].IsUsed())
+		{
+			order.push_back(i);
+		}
+	}
+
+	std::stable_sort(order.begin(), order.end(), [&targets](uint32_t left, uint32_t right)
+	{
+		return targets[left].FirstUse < targets[right].FirstUse;
+	});
+
+	std::vector<RenderTargetDescription> physicalTargets;
+
+	// Last use of the current tenant of each physical target
+	std::vector<uint32_t> busyUntil;
+
+	for (uint32_t index : order)
+	{
+		TransientRenderTarget& target = targets[index];
+
+		for (uint32_t i = 0; i < physicalTargets.size(); ++i)
+		{
+			if (busyUntil[i] < target.FirstUse && physicalTargets[i] == target.Description)
+			{
+				target.PhysicalTarget = i;
+				break;
+			}
+		}
+
+		if (target.PhysicalTarget == TransientRenderTarget::Unassigned)
+		{
+			target.PhysicalTarget = physicalTargets.size();
+			physicalTargets.push_back(target.Description);
+			busyUntil.push_back(0);
+		}
+
+		busyUntil[target.PhysicalTarget] = target.LastUse;
+	}
+
+	return physicalTargets;
+}
+
+RenderTargetPoolStatistics RenderTargetPool::CalculateStatistics(const std::vector<TransientRenderTarget>& targets, const std::vector<RenderTargetDescription>& physicalTargets, glm::u32vec2 renderSize)
+{
+	RenderTargetPoolStatistics statistics;
+
+	for (const TransientRenderTarget& target : targets)
+	{
+		if (target.IsUsed())
+		{
+			++statistics.TransientTargetsCount;
+			statistics.RequestedMemory += target.Description.CalculateMemory(renderSize);
+		}
+	}
+
+	for (const RenderTargetDescription& description : physicalTargets)
+	{
+		++statistics.PhysicalTargetsCount;
+		statistics.AllocatedMemory += description.CalculateMemory(renderSize);
+	}
+
+	return statistics;
+}
+
+void RenderTargetPool::Allocate(const std::vector<RenderTargetDescription>& physicalTargets)
+{
+	std::vector<std::shared_ptr<Texture>> textures(physicalTargets.size());
+
+	for (uint32_t i = 0; i < physicalTargets.size(); ++i)
+	{
+		for (uint32_t j = 0; j < m_Textures.size(); ++j)
+		{
+			if (m_Textures[j] && m_Descriptions[j] == physicalTargets[i])
+			{
+				textures[i] = std::move(m_Textures[j]);
+				break;
+			}
+		}
+
+		if (!textures[i])
+		{
+			RenderTargetSpecification specification;
+			specification.Name = "Transient render target " + std::to_string(i);
+			specification.Type = physicalTargets[i].Format;
+
+			textures[i] = RenderingHelper::CreateRenderTarget(specification, physicalTargets[i].Type);
+		}
+	}
+
+	m_Descriptions = physicalTargets;
+	m_Textures = std::move(textures);
+}
+
+std::shared_ptr<Texture> RenderTargetPool::GetTexture(uint32_t physicalTarget) const
+{
+	ED_ASSERT(physicalTarget < m_Textures.size(), "Physical target isn't allocated")
+	return m_Textures[physicalTarget];
+}
+
+const std::vector<RenderTargetDescription>& RenderTargetPool::GetDescriptions() const
+{
+	return m_Descriptions;
+}
+
+glm::u32vec2 RenderSizeTracker::RoundUp(glm::u32vec2 viewportSize)
+{
+	glm::u32vec2 size = glm::max(viewportSize, glm::u32vec2(1));
+	return (size + Granularity - 1u) / Granularity * Granularity;
+}
+
+bool RenderSizeTracker::Update(glm::u32vec2 viewportSize)
+{
+	m_StableFrames = viewportSize == m_LastViewportSize ? m_StableFrames + 1 : 0;
+	m_LastViewportSize = viewportSize;
+
+	glm::u32vec2 size = RoundUp(viewportSize);
+
+	bool bIsTooSmall = m_Size.x < viewportSize.x || m_Size.y < viewportSize.y;
+	bool bIsTooBig = m_Size.x > size.x * ShrinkThreshold || m_Size.y > size.y * ShrinkThreshold;
+
+	if (bIsTooSmall || bIsTooBig)
+	{
+		m_Size = size;
+		return true;
+	}
+
+	// Once resizing is over targets match the viewport exactly, so the image isn't resampled
+	glm::u32vec2 exactSize = glm::max(viewportSize, glm::u32vec2(1));
+	if (m_StableFrames == SettleFrames && m_Size != exactSize)
+	{
+		m_Size = exactSize;
+		return true;
+	}
+
+	return false;
+}
+
+glm::u32vec2 RenderSizeTracker::GetSize() const
+{
+	return m_Size;
+}
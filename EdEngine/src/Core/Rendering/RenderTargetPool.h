@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Core/Ed.h"
+#include "Framebuffer.h"
+
+// What a render graph target needs from a texture, targets with equal descriptions can share one
+struct RenderTargetDescription
+{
+	TextureType Type = TextureType::Texture2D;
+	FramebufferAttachmentType Format = FramebufferAttachmentType::Color;
+
+	// Size is the render size times scale clamped per side, fixed size targets have zero scale
+	float Scale = 1.0f;
+	uint32_t MinSize = 1;
+	uint32_t MaxSize = UINT32_MAX;
+	uint32_t Layers = 1;
+
+	glm::u32vec3 CalculateSize(glm::u32vec2 renderSize) const;
+	uint64_t CalculateMemory(glm::u32vec2 renderSize) const;
+
+	bool operator==(const RenderTargetDescription& other) const;
+};
+
+struct TransientRenderTarget
+{
+	static const uint32_t Unassigned = UINT32_MAX;
+
+	std::string Name;
+	RenderTargetDescription Description;
+
+	// Render graph handle of the resource
+	uint32_t Handle = Unassigned;
+
+	// Positions in the execution schedule, both inclusive
+	uint32_t FirstUse = Unassigned;
+	uint32_t LastUse = 0;
+
+	uint32_t PhysicalTarget = Unassigned;
+
+	// Targets not used by any scheduled pass don't get a physical target
+	bool IsUsed() const;
+};
+
+struct RenderTargetPoolStatistics
+{
+	uint32_t TransientTargetsCount = 0;
+	uint32_t PhysicalTargetsCount = 0;
+
+	// Memory transient targets would take without aliasing and memory they actually take
+	uint64_t RequestedMemory = 0;
+	uint64_t AllocatedMemory = 0;
+};
+
+// Owns textures shared by transient render targets whose lifetimes don't overlap
+class RenderTargetPool
+{
+public:
+	// Targets are visited in order of their first use and take a free physical target with the same description, it becomes free again after the last use of its tenant.
+	// Doesn't touch the GPU, fills PhysicalTarget of every used target and returns descriptions of the physical targets
+	static std::vector<RenderTargetDescription> AssignPhysicalTargets(std::vector<TransientRenderTarget>& targets);
+
+	static RenderTargetPoolStatistics CalculateStatistics(const std::vector<TransientRenderTarget>& targets, const std::vector<RenderTargetDescription>& physicalTargets, glm::u32vec2 renderSize);
+
+	// Textures with matching descriptions are kept from the previous allocation, so recompiling the graph doesn't recreate all of them
+	void Allocate(const std::vector<RenderTargetDescription>& physicalTargets);
+
+	std::shared_ptr<Texture> GetTexture(uint32_t physicalTarget) const;
+	const std::vector<RenderTargetDescription>& GetDescriptions() const;
+
+protected:
+	std::vector<RenderTargetDescription> m_Descriptions;
+	std::vector<std::shared_ptr<Texture>> m_Textures;
+};
+
+struct RenderSizeStatistics
+{
+	uint32_t Resizes = 0;
+	uint32_t Reallocations = 0;
+};
+
+// Size render targets are allocated for, it follows the viewport lazily so dragging the viewport doesn't reallocate targets every frame.
+// While the viewport changes sizes are rounded up to buckets and targets shrink only when they are much bigger than needed, once it stops they match it exactly
+class RenderSizeTracker
+{
+public:
+	static const uint32_t Granularity = 64;
+	static const uint32_t SettleFrames = 30;
+	static constexpr float ShrinkThreshold = 1.5f;
+
+	static glm::u32vec2 RoundUp(glm::u32vec2 viewportSize);
+
+	// Returns true when the render size has changed
+	bool Update(glm::u32vec2 viewportSize);
+
+	glm::u32vec2 GetSize() const;
+
+protected:
+	glm::u32vec2 m_Size = glm::u32vec2(0);
+	glm::u32vec2 m_LastViewportSize = glm::u32vec2(0);
+	uint32_t m_StableFrames = 0;
+};
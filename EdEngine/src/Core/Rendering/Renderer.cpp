@@ -12,6 +12,7 @@
 #include "Core/Components/StaticMeshComponent.h"
 #include "Core/Components/PointLightComponent.h"
 #include "Core/Components/SpotLightComponent.h"
+#include "Core/Components/IrradianceVolumeComponent.h"
 
 #include "Core/Rendering/Buffers/VertexBuffer.h"
 
@@ -28,6 +29,7 @@
 #include "Passes/Lighting/DirectionalLight/DirectionalLightMultiPass.h"
 #include "Passes/Lighting/SpotLight/SpotLightMultiPass.h"
 #include "Passes/Lighting/PointLight/PointLightMultiPass.h"
+#include "Passes/Lighting/ClusteredLightingPass.h"
 #include "Passes/FXAAPass.h"
 #include "Passes/TAAPass.h"
 #include "Passes/Bloom/BloomMultiPass.h"
@@ -35,6 +37,35 @@
 #include "Passes/GrayscalePass.h"
 #include "Passes/Editor/IconsPass.h"
 
+static const char* GetRenderTargetResourceName(RenderTarget target)
+{
+	switch (target)
+	{
+	case RenderTarget::GAlbedo:                   return "GBuffer.Albedo";
+	case RenderTarget::GPosition:                 return "GBuffer.Position";
+	case RenderTarget::GNormal:                   return "GBuffer.Normal";
+	case RenderTarget::GRougnessMetalicEmission:  return "GBuffer.RoughnessMetalic";
+	case RenderTarget::GVelocity:                 return "GBuffer.Velocity";
+	case RenderTarget::GLightmap:                 return "GBuffer.Lightmap";
+	case RenderTarget::GDepth:                    return "GBuffer.Depth";
+
+	case RenderTarget::SSAO:                      return "SSAO.Blured";
+
+	case RenderTarget::Diffuse:                   return "LightBuffer.Diffuse";
+	case RenderTarget::Specular:                  return "LightBuffer.Specular";
+	case RenderTarget::Light:                     return "LightBuffer.Combined";
+
+	case RenderTarget::Bloom:                     return "Bloom.Intermediate1";
+
+	case RenderTarget::AAOutput:                  return "TAA.Output";
+	case RenderTarget::Resolution:                return "Resolution.Color";
+	default:
+		ED_ASSERT(0, "Unsuppoerted target")
+	}
+
+	return "Resolution.Color";
+}
+
 void Renderer::Initialize(Engine* engine)
 {
 	ED_LOG(Renderer, info, "Started initalizing Renderer")
@@ -62,6 +93,18 @@ void Renderer::Initialize(Engine* engine)
 	m_TextVBO = RenderingHelper::CreateVertexBuffer(nullptr, 20 * sizeof(float), textVBOlayout, BufferUsage::DynamicDraw);
 	m_QuadVBO = RenderingHelper::CreateVertexBuffer(square, 24 * sizeof(float), textVBOlayout, BufferUsage::StaticDraw);
 
+	float fullScreenQuad[4 * 6] = {
+		-1.0f, -1.0f, 0.0f, 0.0f,
+		-1.0f,  1.0f, 0.0f, 1.0f,
+		 1.0f,  1.0f, 1.0f, 1.0f,
+
+		 1.0f,  1.0f, 1.0f, 1.0f,
+		 1.0f, -1.0f, 1.0f, 0.0f,
+		-1.0f, -1.0f, 0.0f, 0.0f,
+	};
+
+	m_FullScreenQuadVBO = RenderingHelper::CreateVertexBuffer(fullScreenQuad, 24 * sizeof(float), textVBOlayout, BufferUsage::StaticDraw);
+
 	{
 		m_Graph = std::make_shared<RenderGraph>();
 		m_Graph->Initilaize(std::static_pointer_cast<Renderer>(shared_from_this()));
@@ -69,11 +112,12 @@ void Renderer::Initialize(Engine* engine)
 		m_Camera = m_Engine->GetLoadedScene()->GetPlayerActor()->GetCameraComponent();
 		m_Graph->DeclareObjectPtrParameter("Camera", m_Camera); // Level transitions ? Will it crash here ? ;) yes it did :)
 
-		m_Graph->DeclareParameter("Scene.Component", m_Components);
-		m_Graph->DeclareParameter("Scene.StaticMesh", m_StaticMeshes);
-		m_Graph->DeclareParameter("Scene.PointLight", m_PointLights);
-		m_Graph->DeclareParameter("Scene.DirectionalLight", m_DirectionalLights);
-		m_Graph->DeclareParameter("Scene.SpotLight", m_SpotLights);
+		m_Graph->DeclareParameter("Scene.Component", m_Components.GetItems());
+		m_Graph->DeclareParameter("Scene.StaticMesh", m_StaticMeshes.GetItems());
+		m_Graph->DeclareParameter("Scene.PointLight", m_PointLights.GetItems());
+		m_Graph->DeclareParameter("Scene.DirectionalLight", m_DirectionalLights.GetItems());
+		m_Graph->DeclareParameter("Scene.SpotLight", m_SpotLights.GetItems());
+		m_Graph->DeclareParameter("Scene.IrradianceVolume", m_IrradianceVolumes.GetItems());
 
 		m_Graph->AddPass<GBufferPass>();
 		
@@ -85,6 +129,7 @@ void Renderer::Initialize(Engine* engine)
 		m_Graph->AddPass<DirectionalLightMultiPass>();
 		m_Graph->AddPass<SpotLightMultiPass>();
 		m_Graph->AddPass<PointLightMultiPass>();
+		m_Graph->AddPass<ClusteredLightingPass>();
 
 		m_Graph->AddPass<FXAAPass>();
 		m_Graph->AddPass<TAAPass>();
@@ -97,7 +142,24 @@ void Renderer::Initialize(Engine* engine)
 
 		m_Graph->AddPass<IconsPass>();
 
+		m_Graph->SetOutput("Resolution.Color");
+
 		m_Graph->Build();
+
+		m_ActiveRenderTargetHandle = m_Graph->GetHandle(GetRenderTargetResourceName(m_ActiveRenderTarget));
+	}
+
+	{
+		std::shared_ptr<Scene> scene = m_Engine->GetLoadedScene();
+
+		// Components added before the renderer existed are registered once, the rest comes from scene notifications
+		for (const std::shared_ptr<Component>& component : scene->GetAllComponents())
+		{
+			RegisterComponent(component);
+		}
+
+		scene->SubscribeToComponentAdded([this](const std::shared_ptr<Component>& component) { RegisterComponent(component); });
+		scene->SubscribeToComponentRemoved([this](const std::shared_ptr<Component>& component) { UnregisterComponent(component); });
 	}
 
 	SetSSAOEnabled(m_bSSAOEnabled);
@@ -116,35 +178,7 @@ void Renderer::Deinitialize()
 void Renderer::Update(float deltaSeconds)
 {
 	m_Context->SwapBuffers();
-
-	std::shared_ptr<Scene> scene = m_Engine->GetLoadedScene();
-
-	// TODO: This is probably not the best way to do it :)
-
-	m_Components = scene->GetAllComponents();
-	m_StaticMeshes.clear();
-	m_DirectionalLights.clear();
-	m_SpotLights.clear();
-	m_PointLights.clear();
-
-	for (const std::shared_ptr<Component>& component : m_Components)
-	{
-		switch (component->GetType())
-		{
-		case ComponentType::StaticMesh:
-			m_StaticMeshes.push_back(std::static_pointer_cast<StaticMeshComponent>(component));
-			break;
-		case ComponentType::DirectionalLight:
-			m_DirectionalLights.push_back(std::static_pointer_cast<DirectionalLightComponent>(component));
-			break;
-		case ComponentType::SpotLight:
-			m_SpotLights.push_back(std::static_pointer_cast<SpotLightComponent>(component));
-			break;
-		case ComponentType::PointLight:
-			m_PointLights.push_back(std::static_pointer_cast<PointLightComponent>(component));
-			break;
-		}
-	}
+	m_Context->ResetStatistics();
 
 	if (m_bIsViewportSizeDirty)
 	{
@@ -162,6 +196,60 @@ void Renderer::Update(float deltaSeconds)
 	m_bIsViewportSizeDirty = false;
 }
 
+void Renderer::RegisterComponent(const std::shared_ptr<Component>& component)
+{
+	if (!m_Components.Add(component))
+	{
+		return;
+	}
+
+	switch (component->GetType())
+	{
+	case ComponentType::StaticMesh:
+		m_StaticMeshes.Add(std::static_pointer_cast<StaticMeshComponent>(component));
+		break;
+	case ComponentType::DirectionalLight:
+		m_DirectionalLights.Add(std::static_pointer_cast<DirectionalLightComponent>(component));
+		break;
+	case ComponentType::SpotLight:
+		m_SpotLights.Add(std::static_pointer_cast<SpotLightComponent>(component));
+		break;
+	case ComponentType::PointLight:
+		m_PointLights.Add(std::static_pointer_cast<PointLightComponent>(component));
+		break;
+	case ComponentType::IrradianceVolume:
+		m_IrradianceVolumes.Add(std::static_pointer_cast<IrradianceVolumeComponent>(component));
+		break;
+	}
+}
+
+void Renderer::UnregisterComponent(const std::shared_ptr<Component>& component)
+{
+	if (!m_Components.Remove(component.get()))
+	{
+		return;
+	}
+
+	switch (component->GetType())
+	{
+	case ComponentType::StaticMesh:
+		m_StaticMeshes.Remove(static_cast<const StaticMeshComponent*>(component.get()));
+		break;
+	case ComponentType::DirectionalLight:
+		m_DirectionalLights.Remove(static_cast<const DirectionalLightComponent*>(component.get()));
+		break;
+	case ComponentType::SpotLight:
+		m_SpotLights.Remove(static_cast<const SpotLightComponent*>(component.get()));
+		break;
+	case ComponentType::PointLight:
+		m_PointLights.Remove(static_cast<const PointLightComponent*>(component.get()));
+		break;
+	case ComponentType::IrradianceVolume:
+		m_IrradianceVolumes.Remove(static_cast<const IrradianceVolumeComponent*>(component.get()));
+		break;
+	}
+}
+
 bool Renderer::IsViewportSizeDirty() const
 {
 	return m_bIsViewportSizeDirty;
@@ -199,6 +287,7 @@ std::shared_ptr<RenderGraph> Renderer::GetGraph() const
 void Renderer::SetSSAOEnabled(bool enabled)
 {
 	m_bSSAOEnabled = enabled;
+	m_Graph->Invalidate();
 }
 
 bool Renderer::IsSSAOEnabled() const
@@ -209,6 +298,7 @@ bool Renderer::IsSSAOEnabled() const
 void Renderer::SetBloomEnabled(bool enabled)
 {
 	m_bIsBloomEnabled = enabled;
+	m_Graph->Invalidate();
 }
 
 bool Renderer::IsBloomEnabled() const
@@ -216,6 +306,17 @@ bool Renderer::IsBloomEnabled() const
 	return m_bIsBloomEnabled;
 }
 
+void Renderer::SetClusteredLightingEnabled(bool enabled)
+{
+	m_bIsClusteredLightingEnabled = enabled;
+	m_Graph->Invalidate();
+}
+
+bool Renderer::IsClusteredLightingEnabled() const
+{
+	return m_bIsClusteredLightingEnabled;
+}
+
 void Renderer::SetUpsampleScale(float scale)
 {
 	m_UpsampleScale = scale;
@@ -234,6 +335,8 @@ AAMethod Renderer::GetAAMethod() const
 void Renderer::SetActiveRenderTarget(RenderTarget target)
 {
 	m_ActiveRenderTarget = target;
+	m_Graph->SetDebugOutput(GetRenderTargetResourceName(target));
+	m_ActiveRenderTargetHandle = m_Graph->GetHandle(GetRenderTargetResourceName(target));
 }
 
 RenderTarget Renderer::GetActiveRenderTarget() const
@@ -244,37 +347,18 @@ RenderTarget Renderer::GetActiveRenderTarget() const
 void Renderer::SetAAMethod(AAMethod method)
 {
 	m_AAMethod = method;
+	m_Graph->Invalidate();
 }
 
 std::shared_ptr<Texture2D> Renderer::GetRenderTarget(RenderTarget target) const
 {
-	switch (target)
-	{
-	case RenderTarget::GAlbedo:                   return m_Graph->GetPass<GBufferPass>()->GetParameters().DrawFramebuffer->GetAttachment<Texture2D>(0);
-	case RenderTarget::GPosition:                 return m_Graph->GetPass<GBufferPass>()->GetParameters().DrawFramebuffer->GetAttachment<Texture2D>(1);
-	case RenderTarget::GNormal:                   return m_Graph->GetPass<GBufferPass>()->GetParameters().DrawFramebuffer->GetAttachment<Texture2D>(2);
-	case RenderTarget::GRougnessMetalicEmission:  return m_Graph->GetPass<GBufferPass>()->GetParameters().DrawFramebuffer->GetAttachment<Texture2D>(3);
-	case RenderTarget::GVelocity:                 return m_Graph->GetPass<GBufferPass>()->GetParameters().DrawFramebuffer->GetAttachment<Texture2D>(4);
-	case RenderTarget::GDepth:                    return m_Graph->GetPass<GBufferPass>()->GetParameters().DrawFramebuffer->GetDepthAttachment<Texture2D>();
-
-	case RenderTarget::SSAO:                      return m_Graph->GetPass<SSAOMultiPass>()->GetPass<SSAOBlurPass>()->GetParameters().DrawFramebuffer->GetAttachment<Texture2D>(0);
-
-	case RenderTarget::Diffuse:                   return m_Graph->GetPass<AmbientPass>()->GetParameters().DrawFramebuffer->GetAttachment<Texture2D>(0);
-	case RenderTarget::Specular:                  return m_Graph->GetPass<AmbientPass>()->GetParameters().DrawFramebuffer->GetAttachment<Texture2D>(1);
-	case RenderTarget::Light:                     return m_Graph->GetPass<AmbientPass>()->GetParameters().DrawFramebuffer->GetAttachment<Texture2D>(2);
-
-	case RenderTarget::Bloom:                     return m_Graph->GetPass<ResolutionPass>()->GetParameters().Bloom;
-
-	case RenderTarget::AAOutput:                  return m_Graph->GetPass<TAAPass>()->GetParameters().DrawFramebuffer->GetAttachment<Texture2D>(0);
-	case RenderTarget::Resolution:                return m_Graph->GetPass<ResolutionPass>()->GetParameters().DrawFramebuffer->GetAttachment<Texture2D>(0);
-	default:
-		ED_ASSERT(0, "Unsuppoerted target")
-	}
+	// Transient targets are moved between pooled textures, so they are looked up by name and not through pass framebuffers
+	return m_Graph->GetResource<Texture2D>(GetRenderTargetResourceName(target));
 }
 
 std::shared_ptr<Texture2D> Renderer::GetViewportTexture() const
 {
-	return GetRenderTarget(m_ActiveRenderTarget);
+	return m_Graph->GetResource<Texture2D>(m_ActiveRenderTargetHandle);
 }
 
 float Renderer::GetFarPlane() const
@@ -294,30 +378,46 @@ void Renderer::EndUIFrame()
 
 void Renderer::SetCamera(const Camera& camera)
 {
-	glm::mat4 view = camera.GetView();
-	glm::mat4 projection = camera.GetProjection();
-	
-	m_Context->SetShaderDataMat4("u_ViewMatrix", view);
-	m_Context->SetShaderDataMat4("u_ProjectionMatrix", projection);
-	m_Context->SetShaderDataMat4("u_ProjectionViewMatrix", projection * view);
-	m_Context->SetShaderDataMat4("u_InvProjectionViewMatrix", glm::inverse(projection * view));
-
-	m_Context->SetShaderDataFloat3("u_ViewPosition", camera.GetPosition());
-
-	m_Context->SetShaderDataFloat("u_FarPlane", camera.GetFar());
+	// Camera keeps its matrices up to date, so nothing is inverted here
+	ViewShaderParameters::ViewUniformBufferData& data = m_ViewShaderParameters.View.Data;
+	data.ViewMatrix = camera.GetView();
+	data.ProjectionMatrix = camera.GetProjection();
+	data.ProjectionViewMatrix = camera.GetProjectionView();
+	data.InvProjectionViewMatrix = camera.GetInverseProjectionView();
+	data.ViewPosition = camera.GetPosition();
+	data.FarPlane = camera.GetFar();
+
+	m_ViewShaderParameters.View.Submit(m_Context);
 }
 
 void Renderer::SetCamera(const glm::mat4& view, const glm::mat4& projection, glm::vec3 viewPosition)
 {
-	m_Context->SetShaderDataMat4("u_ViewMatrix", view);
-	m_Context->SetShaderDataMat4("u_ProjectionMatrix", projection);
-	m_Context->SetShaderDataMat4("u_ProjectionViewMatrix", projection * view);
-	m_Context->SetShaderDataFloat3("u_ViewPosition", viewPosition);
+	ViewShaderParameters::ViewUniformBufferData& data = m_ViewShaderParameters.View.Data;
+	data.ViewMatrix = view;
+	data.ProjectionMatrix = projection;
+	data.ProjectionViewMatrix = projection * view;
+	data.InvProjectionViewMatrix = glm::inverse(data.ProjectionViewMatrix);
+	data.ViewPosition = viewPosition;
+
+	// View distance of the far plane, NDC depth of one taken back through the projection
+	glm::vec4 farPoint = glm::inverse(projection) * glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+	data.FarPlane = -farPoint.z / farPoint.w;
+
+	// Uploaded only when something has changed
+	m_ViewShaderParameters.View.Submit(m_Context);
 }
 
 void Renderer::SubmitFullScreenQuad()
 {
-	SubmitQuad(-1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f, 1.0f, -1.0f);
+	SubmitFullScreenQuad(m_Context);
+}
+
+void Renderer::SubmitFullScreenQuad(const std::shared_ptr<RenderingContext>& context)
+{
+	context->SetVertexBuffer(m_FullScreenQuadVBO);
+	context->SetIndexBuffer(nullptr);
+
+	context->Draw();
 }
 
 void Renderer::SubmitQuad(float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4)
@@ -5,6 +5,8 @@
 #include "Core/Math/Camera.h"
 #include "Core/Math/Transform.h"
 #include "Framebuffer.h"
+#include "DenseComponentArray.h"
+#include "Passes/Parameters/ShaderParameters.h"
 #include <queue>
 #include <functional>
 
@@ -16,6 +18,7 @@ class StaticMeshComponent;
 class PointLightComponent;
 class SpotLightComponent;
 class DirectionalLightComponent;
+class IrradianceVolumeComponent;
 class CameraComponent;
 
 class VertexBuffer;
@@ -31,6 +34,27 @@ class StaticSubmesh;
 
 class RenderGraph;
 
+ED_BEGIN_SHADER_PARAMETERS_DECLARATION(View)
+
+	ED_BEGIN_SHADER_PARAMETERS_BLOCK(View, 0)
+		ED_SHADER_BLOCK_PARAMETER(glm::mat4, ViewMatrix)
+		ED_SHADER_BLOCK_PARAMETER(glm::mat4, ProjectionMatrix)
+		ED_SHADER_BLOCK_PARAMETER(glm::mat4, ProjectionViewMatrix)
+		ED_SHADER_BLOCK_PARAMETER(glm::mat4, InvProjectionViewMatrix)
+		ED_SHADER_BLOCK_PARAMETER(glm::vec3, ViewPosition)
+		ED_SHADER_BLOCK_PARAMETER(float, FarPlane)
+	ED_END_SHADER_PARAMETERS_BLOCK(View)
+
+ED_END_SHADER_PARAMETERS_DECLARATION()
+
+// Offsets of the View block in resources/shaders/common/view.glsl
+static_assert(offsetof(ViewShaderParameters::ViewUniformBufferData, ViewMatrix) == 0);
+static_assert(offsetof(ViewShaderParameters::ViewUniformBufferData, ProjectionMatrix) == 64);
+static_assert(offsetof(ViewShaderParameters::ViewUniformBufferData, ProjectionViewMatrix) == 128);
+static_assert(offsetof(ViewShaderParameters::ViewUniformBufferData, InvProjectionViewMatrix) == 192);
+static_assert(offsetof(ViewShaderParameters::ViewUniformBufferData, ViewPosition) == 256);
+static_assert(offsetof(ViewShaderParameters::ViewUniformBufferData, FarPlane) == 268);
+
 ED_CLASS(Renderer) : public BaseManager
 {
     ED_CLASS_BODY(Renderer, BaseManager)
@@ -40,6 +64,10 @@ public:
 
     void Update(float deltaSeconds);
 
+    // Called by the scene when components are attached or detached, so the arrays used for rendering change only with the scene
+    void RegisterComponent(const std::shared_ptr<Component>& component);
+    void UnregisterComponent(const std::shared_ptr<Component>& component);
+
     bool IsViewportSizeDirty() const;
 
     void ResizeViewport(glm::vec2 size);
@@ -56,6 +84,10 @@ public:
     void SetBloomEnabled(bool enabled);
     bool IsBloomEnabled() const;
 
+    // Point and spot lights without shadows are shaded together by ClusteredLightingPass instead of one pass per light
+    void SetClusteredLightingEnabled(bool enabled);
+    bool IsClusteredLightingEnabled() const;
+
     void SetUpsampleScale(float scale);
     float GetUpsampleScale() const;
 
@@ -77,6 +109,8 @@ public:
 	void SetCamera(const glm::mat4& view, const glm::mat4& projection, glm::vec3 viewPosition);
 
 	void SubmitFullScreenQuad();
+	// Draws from a buffer filled once at initialization, so it can be submitted to a context recorded on another thread
+	void SubmitFullScreenQuad(const std::shared_ptr<RenderingContext>& context);
 	void SubmitQuad(float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4);
 	void SubmitIcon(std::shared_ptr<Texture2D> texture, const glm::mat4& Transform);
 
@@ -85,6 +119,7 @@ public:
 private:
     bool m_bSSAOEnabled = true;
     bool m_bIsBloomEnabled = false;
+    bool m_bIsClusteredLightingEnabled = true;
 
     float m_FarPlane = 500.0f;
 
@@ -93,6 +128,8 @@ private:
     float m_UpsampleScale = 1.0f;
 
     RenderTarget m_ActiveRenderTarget = RenderTarget::Resolution;
+    // Graph handle of the active target, so the viewport texture isn't looked up by name every frame
+    uint32_t m_ActiveRenderTargetHandle = UINT32_MAX;
 
     std::shared_ptr<RenderGraph> m_Graph;
 
@@ -105,14 +142,18 @@ private:
     
     std::shared_ptr<RenderingContext> m_Context;
 
+    ViewShaderParameters m_ViewShaderParameters;
+
     std::shared_ptr<VertexBuffer> m_QuadVBO;
+    std::shared_ptr<VertexBuffer> m_FullScreenQuadVBO;
     std::shared_ptr<VertexBuffer> m_TextVBO;
 
     std::shared_ptr<CameraComponent> m_Camera;
 
-    std::vector<std::shared_ptr<Component>> m_Components;
-    std::vector<std::shared_ptr<StaticMeshComponent>> m_StaticMeshes;
-    std::vector<std::shared_ptr<DirectionalLightComponent>> m_DirectionalLights;
-    std::vector<std::shared_ptr<PointLightComponent>> m_PointLights;
-    std::vector<std::shared_ptr<SpotLightComponent>> m_SpotLights;
+    DenseComponentArray<Component> m_Components;
+    DenseComponentArray<StaticMeshComponent> m_StaticMeshes;
+    DenseComponentArray<DirectionalLightComponent> m_DirectionalLights;
+    DenseComponentArray<PointLightComponent> m_PointLights;
+    DenseComponentArray<SpotLightComponent> m_SpotLights;
+    DenseComponentArray<IrradianceVolumeComponent> m_IrradianceVolumes;
 };
\ No newline at end of file
@@ -10,6 +10,19 @@ class Shader;
 class Framebuffer;
 class VertexBuffer;
 class IndexBuffer;
+class StorageBuffer;
+class UniformBuffer;
+class PipelineState;
+
+// State changes are calls that reached the graphics API, eliminated ones matched the state that was already set
+struct RenderingStateStatistics
+{
+	uint32_t PipelineStateChanges = 0;
+	uint32_t EliminatedPipelineStateChanges = 0;
+
+	uint32_t StateChanges = 0;
+	uint32_t EliminatedStateChanges = 0;
+};
 
 class RenderingContext 
 {
@@ -19,11 +32,21 @@ public:
 	virtual void SetDefaultFramebuffer() = 0;
 	virtual void SetFramebuffer(std::shared_ptr<Framebuffer> framebuffer) = 0;
 
+	// Region of the bound framebuffer draws go to, setting a framebuffer resets it to the whole framebuffer
+	virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
+
 	virtual void SetVertexBuffer(std::shared_ptr<VertexBuffer> buffer) = 0;
 
 	virtual void SetIndexBuffer(std::shared_ptr<IndexBuffer> buffer) = 0;
 
+	virtual void SetStorageBuffer(uint32_t binding, std::shared_ptr<StorageBuffer> buffer) = 0;
+	virtual void SetUniformBuffer(uint32_t binding, std::shared_ptr<UniformBuffer> buffer) = 0;
+
 	virtual void SetShader(std::shared_ptr<Shader> shader) = 0;
+	virtual const std::shared_ptr<Shader>& GetShader() const = 0;
+
+	// Issues only the calls for the parts of the state that differ from the current one
+	virtual void SetPipelineState(std::shared_ptr<PipelineState> state) = 0;
 
 	virtual void SetShaderDataTexture(const std::string& name, std::shared_ptr<Texture> texture) = 0;
 	virtual void SetShaderDataImage(const std::string& name, std::shared_ptr<Texture> texture) = 0;
@@ -53,10 +76,23 @@ public:
 	virtual void SetShaderDataMat3(const char* name, const glm::mat3& matrix)  = 0;
 	virtual void SetShaderDataBool(const char* name, bool value) = 0;
 
+	// Location is resolved with Shader::GetUniformLocation, values equal to the last uploaded ones are skipped
+	virtual void SetShaderDataTexture(int32_t location, std::shared_ptr<Texture> texture) = 0;
+	virtual void SetShaderDataImage(int32_t location, std::shared_ptr<Texture> texture) = 0;
+	virtual void SetShaderDataInt(int32_t location, int32_t value) = 0;
+	virtual void SetShaderDataFloat(int32_t location, float value) = 0;
+	virtual void SetShaderDataFloat2(int32_t location, glm::vec2 vector) = 0;
+	virtual void SetShaderDataFloat3(int32_t location, glm::vec3 vector) = 0;
+	virtual void SetShaderDataFloat4(int32_t location, glm::vec4 vector) = 0;
+	virtual void SetShaderDataMat4(int32_t location, const glm::mat4& matrix) = 0;
+	virtual void SetShaderDataMat3(int32_t location, const glm::mat3& matrix) = 0;
+	virtual void SetShaderDataBool(int32_t location, bool value) = 0;
+
 	virtual void RunComputeShader(uint32_t sizeX, uint32_t sizeY, uint32_t sizeZ) = 0;
 	virtual void Barier(BarrierType type) = 0;
 
 	virtual void Draw(DrawMode mode = DrawMode::Triangles) = 0;
+	virtual void DrawInstanced(uint32_t instancesCount, uint32_t firstInstance = 0, DrawMode mode = DrawMode::Triangles) = 0;
 
 	virtual void EnableBlending(BlendFactor source, BlendFactor destination) = 0;
 	virtual void SetBlending(BlendFactor source, BlendFactor destination) = 0;
@@ -72,6 +108,9 @@ public:
 	virtual void DisableFaceCulling() = 0;
 
 	virtual void ClearDepthTarget() = 0;
+	// Regions are in texels, z is the layer for array textures
+	virtual void ClearDepthTarget(std::shared_ptr<Texture> target, glm::u32vec3 offset, glm::u32vec3 size) = 0;
+	virtual void CopyTexture(std::shared_ptr<Texture> source, std::shared_ptr<Texture> destination, glm::u32vec3 offset, glm::u32vec3 size) = 0;
 	virtual void ClearColorTarget() = 0;
 	virtual void SetClearColor(float r, float g, float b, float a) = 0;
 	virtual void SetClearColor(glm::vec4 color) = 0;
@@ -81,6 +120,10 @@ public:
 
 	virtual void SwapBuffers() = 0;
 
+	// Statistics of the last finished frame, ResetStatistics has to be called once per frame
+	virtual const RenderingStateStatistics& GetStatistics() const = 0;
+	virtual void ResetStatistics() = 0;
+
 	virtual ~RenderingContext() = default;
 protected:
 	static void SetContext(RenderingContext* context);
@@ -2,9 +2,14 @@
 
 #include "Types.h"
 #include <string>
+#include <string_view>
 
 class Shader {
 public:
 	virtual void SetShaderCode(ShaderType type, const std::string& code) = 0;
+
+	// Returns -1 if uniform isn't active in the program
+	virtual int32_t GetUniformLocation(std::string_view name) const = 0;
+
 	virtual ~Shader() = default;
 };
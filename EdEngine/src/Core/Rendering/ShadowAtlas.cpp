@@ -0,0 +1,177 @@
+#include "ShadowAtlas.h"
+#include "Core/Macros.h"
+#include <algorithm>
+
+static bool IsPowerOfTwo(uint32_t value)
+{
+	return value != 0 && (value & (value - 1)) == 0;
+}
+
+static uint32_t RoundUpToPowerOfTwo(uint32_t value)
+{
+	uint32_t result = 1;
+	while (result < value)
+	{
+		result <<= 1;
+	}
+
+	return result;
+}
+
+void ShadowAtlasAllocator::Reset(uint32_t size, uint32_t minTileSize)
+{
+	ED_ASSERT(IsPowerOfTwo(size) && IsPowerOfTwo(minTileSize) && minTileSize <= size, "Atlas size {} and min tile size {} must be powers of two", size, minTileSize)
+
+	m_Size = size;
+	m_MinTileSize = minTileSize;
+	m_AllocatedTilesCount = 0;
+
+	m_Levels.resize(GetLevel(minTileSize) + 1);
+	for (uint32_t level = 0; level < m_Levels.size(); ++level)
+	{
+		m_Levels[level].assign((1u << level) * (1u << level), NodeState::Covered);
+	}
+
+	m_Levels[0][0] = NodeState::Free;
+}
+
+bool ShadowAtlasAllocator::Allocate(uint32_t size, ShadowAtlasTile& tile)
+{
+	if (m_Levels.empty())
+	{
+		return false;
+	}
+
+	size = std::clamp(RoundUpToPowerOfTwo(size), m_MinTileSize, m_Size);
+	uint32_t targetLevel = GetLevel(size);
+
+	// Smallest free tile that fits, so big tiles aren't split while there are small ones left
+	for (int32_t level = targetLevel; level >= 0; --level)
+	{
+		uint32_t gridSize = 1u << level;
+		std::vector<NodeState>& nodes = m_Levels[level];
+
+		for (uint32_t index = 0; index < nodes.size(); ++index)
+		{
+			if (nodes[index] != NodeState::Free)
+			{
+				continue;
+			}
+
+			uint32_t x = index % gridSize;
+			uint32_t y = index / gridSize;
+
+			for (uint32_t current = level; current < targetLevel; ++current)
+			{
+				GetNode(current, x, y) = NodeState::Split;
+
+				x *= 2;
+				y *= 2;
+
+				GetNode(current + 1, x, y) = NodeState::Free;
+				GetNode(current + 1, x + 1, y) = NodeState::Free;
+				GetNode(current + 1, x, y + 1) = NodeState::Free;
+				GetNode(current + 1, x + 1, y + 1) = NodeState::Free;
+			}
+
+			GetNode(targetLevel, x, y) = NodeState::Allocated;
+			++m_AllocatedTilesCount;
+
+			tile.X = x * size;
+			tile.Y = y * size;
+			tile.Size = size;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ShadowAtlasAllocator::Free(const ShadowAtlasTile& tile)
+{
+	uint32_t level = GetLevel(tile.Size);
+	uint32_t x = tile.X / tile.Size;
+	uint32_t y = tile.Y / tile.Size;
+
+	NodeState& node = GetNode(level, x, y);
+	ED_ASSERT(node == NodeState::Allocated, "Tile {} {} of size {} isn't allocated", tile.X, tile.Y, tile.Size)
+
+	node = NodeState::Free;
+	--m_AllocatedTilesCount;
+
+	while (level > 0)
+	{
+		uint32_t parentX = x / 2;
+		uint32_t parentY = y / 2;
+
+		uint32_t childX = parentX * 2;
+		uint32_t childY = parentY * 2;
+
+		NodeState& first = GetNode(level, childX, childY);
+		NodeState& second = GetNode(level, childX + 1, childY);
+		NodeState& third = GetNode(level, childX, childY + 1);
+		NodeState& fourth = GetNode(level, childX + 1, childY + 1);
+
+		if (first != NodeState::Free || second != NodeState::Free || third != NodeState::Free || fourth != NodeState::Free)
+		{
+			break;
+		}
+
+		first = second = third = fourth = NodeState::Covered;
+
+		--level;
+		x = parentX;
+		y = parentY;
+
+		GetNode(level, x, y) = NodeState::Free;
+	}
+}
+
+uint32_t ShadowAtlasAllocator::GetSize() const
+{
+	return m_Size;
+}
+
+uint32_t ShadowAtlasAllocator::GetMinTileSize() const
+{
+	return m_MinTileSize;
+}
+
+uint64_t ShadowAtlasAllocator::GetFreeArea() const
+{
+	uint64_t area = 0;
+	for (uint32_t level = 0; level < m_Levels.size(); ++level)
+	{
+		uint64_t tileSize = GetTileSize(level);
+		area += tileSize * tileSize * std::count(m_Levels[level].begin(), m_Levels[level].end(), NodeState::Free);
+	}
+
+	return area;
+}
+
+uint32_t ShadowAtlasAllocator::GetAllocatedTilesCount() const
+{
+	return m_AllocatedTilesCount;
+}
+
+uint32_t ShadowAtlasAllocator::GetLevel(uint32_t size) const
+{
+	uint32_t level = 0;
+	while ((m_Size >> level) > size)
+	{
+		++level;
+	}
+
+	return level;
+}
+
+uint32_t ShadowAtlasAllocator::GetTileSize(uint32_t level) const
+{
+	return m_Size >> level;
+}
+
+ShadowAtlasAllocator::NodeState& ShadowAtlasAllocator::GetNode(uint32_t level, uint32_t x, uint32_t y)
+{
+	return m_Levels[level][y * (1u << level) + x];
+}
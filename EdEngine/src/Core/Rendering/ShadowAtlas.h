@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Core/Ed.h"
+
+// Square region of a shadow atlas in texels, size of zero means nothing is allocated
+struct ShadowAtlasTile
+{
+	uint32_t X = 0;
+	uint32_t Y = 0;
+	uint32_t Size = 0;
+
+	bool IsValid() const { return Size != 0; }
+	bool operator==(const ShadowAtlasTile& other) const { return X == other.X && Y == other.Y && Size == other.Size; }
+};
+
+// Quadtree of power of two tiles, a tile is split into four children when a smaller one is needed and
+// freed children are merged back into their parent. Levels are scanned linearly, atlases have at most a few thousand nodes
+class ShadowAtlasAllocator
+{
+public:
+	// Both sizes must be powers of two, all tiles are freed
+	void Reset(uint32_t size, uint32_t minTileSize);
+
+	// Size is rounded up to a power of two between the min tile size and the atlas size
+	bool Allocate(uint32_t size, ShadowAtlasTile& tile);
+	void Free(const ShadowAtlasTile& tile);
+
+	uint32_t GetSize() const;
+	uint32_t GetMinTileSize() const;
+
+	// Area in texels not covered by allocated tiles
+	uint64_t GetFreeArea() const;
+	uint32_t GetAllocatedTilesCount() const;
+
+private:
+	enum class NodeState : uint8_t
+	{
+		// Covered by a free or an allocated ancestor
+		Covered,
+		Free,
+		Allocated,
+		Split
+	};
+
+	uint32_t GetLevel(uint32_t size) const;
+	uint32_t GetTileSize(uint32_t level) const;
+	NodeState& GetNode(uint32_t level, uint32_t x, uint32_t y);
+
+private:
+	uint32_t m_Size = 0;
+	uint32_t m_MinTileSize = 0;
+	uint32_t m_AllocatedTilesCount = 0;
+
+	// Level 0 is the whole atlas, level n is a grid of 2^n by 2^n tiles
+	std::vector<std::vector<NodeState>> m_Levels;
+};
@@ -0,0 +1,287 @@
+#include "ShadowCache.h"
+#include <glm/glm.hpp>
+
+void ShadowCache::Reset(uint32_t atlasSize, uint32_t minTileSize)
+{
+	m_Allocator.Reset(atlasSize, minTileSize);
+	m_Lights.clear();
+}
+
+void ShadowCache::Invalidate()
+{
+	for (auto& [key, light] : m_Lights)
+	{
+		light.bIsDirty = true;
+	}
+}
+
+void ShadowCache::BeginFrame(const std::vector<ShadowCaster>& casters)
+{
+	++m_Frame;
+
+	m_CasterSpheres.resize(casters.size());
+	m_DynamicCasterFlags.resize(casters.size());
+	m_DynamicCasterIndices.clear();
+
+	for (uint32_t i = 0; i < casters.size(); ++i)
+	{
+		const ShadowCaster& caster = casters[i];
+
+		auto [iterator, bIsNew] = m_Casters.try_emplace(caster.Key);
+		CasterState& state = iterator->second;
+
+		if (bIsNew)
+		{
+			state.BoundingSphere = caster.BoundingSphere;
+			state.Generation = caster.Generation;
+
+			InvalidateIntersecting(caster.BoundingSphere);
+		}
+		else if (state.Generation != caster.Generation || state.BoundingSphere != caster.BoundingSphere)
+		{
+			// Caches still have the caster where it was
+			if (!state.bIsDynamic)
+			{
+				InvalidateIntersecting(state.BoundingSphere);
+			}
+
+			state.BoundingSphere = caster.BoundingSphere;
+			state.Generation = caster.Generation;
+			state.StillFrames = 0;
+			state.bIsDynamic = true;
+		}
+		else if (state.bIsDynamic && ++state.StillFrames >= SettleFrames)
+		{
+			state.bIsDynamic = false;
+
+			InvalidateIntersecting(state.BoundingSphere);
+		}
+
+		state.LastFrame = m_Frame;
+
+		m_CasterSpheres[i] = caster.BoundingSphere;
+		m_DynamicCasterFlags[i] = state.bIsDynamic;
+
+		if (state.bIsDynamic)
+		{
+			m_DynamicCasterIndices.push_back(i);
+		}
+	}
+
+	for (auto iterator = m_Casters.begin(); iterator != m_Casters.end();)
+	{
+		const CasterState& state = iterator->second;
+		if (state.LastFrame != m_Frame)
+		{
+			if (!state.bIsDynamic)
+			{
+				InvalidateIntersecting(state.BoundingSphere);
+			}
+
+			iterator = m_Casters.erase(iterator);
+		}
+		else
+		{
+			++iterator;
+		}
+	}
+}
+
+ShadowUpdate ShadowCache::UpdateLight(const ShadowLight& light, ShadowAtlasTile& tile)
+{
+	m_StaticCasters.clear();
+	m_DynamicCasters.clear();
+
+	LightState& state = m_Lights[light.Key];
+
+	state.LastFrame = m_Frame;
+	state.BoundingSphere = light.BoundingSphere;
+
+	if (light.TileSize == 0)
+	{
+		if (state.Tile.IsValid())
+		{
+			m_Allocator.Free(state.Tile);
+		}
+
+		state = LightState();
+		state.LastFrame = m_Frame;
+
+		tile = state.Tile;
+		return ShadowUpdate::None;
+	}
+
+	// Changes made while the light is skipped stay pending until its next update
+	if (!light.bShouldUpdate && state.Tile.IsValid() && state.RequestedTileSize == light.TileSize)
+	{
+		tile = state.Tile;
+		return ShadowUpdate::None;
+	}
+
+	bool bIsFull = state.bIsDirty || state.ProjectionView != light.ProjectionView;
+
+	state.ProjectionView = light.ProjectionView;
+	state.bIsDirty = false;
+
+	if (!state.Tile.IsValid() || state.RequestedTileSize != light.TileSize)
+	{
+		if (state.Tile.IsValid())
+		{
+			m_Allocator.Free(state.Tile);
+			state.Tile = ShadowAtlasTile();
+		}
+
+		state.RequestedTileSize = light.TileSize;
+		AllocateTile(light.TileSize, state.Tile);
+
+		bIsFull = true;
+	}
+
+	tile = state.Tile;
+
+	if (!tile.IsValid())
+	{
+		state.bHadDynamicCasters = false;
+		return ShadowUpdate::None;
+	}
+
+	if (bIsFull)
+	{
+		for (uint32_t i = 0; i < m_CasterSpheres.size(); ++i)
+		{
+			if (!m_DynamicCasterFlags[i] && Intersects(m_CasterSpheres[i], light.BoundingSphere))
+			{
+				m_StaticCasters.push_back(i);
+			}
+		}
+	}
+
+	for (uint32_t index : m_DynamicCasterIndices)
+	{
+		if (Intersects(m_CasterSpheres[index], light.BoundingSphere))
+		{
+			m_DynamicCasters.push_back(index);
+		}
+	}
+
+	// Tile has to be restored from the cache once more after the last dynamic caster leaves
+	bool bHadDynamicCasters = state.bHadDynamicCasters;
+	state.bHadDynamicCasters = !m_DynamicCasters.empty();
+
+	if (bIsFull)
+	{
+		return ShadowUpdate::Full;
+	}
+
+	return !m_DynamicCasters.empty() || bHadDynamicCasters ? ShadowUpdate::Dynamic : ShadowUpdate::None;
+}
+
+const std::vector<uint32_t>& ShadowCache::GetStaticCasters() const
+{
+	return m_StaticCasters;
+}
+
+const std::vector<uint32_t>& ShadowCache::GetDynamicCasters() const
+{
+	return m_DynamicCasters;
+}
+
+void ShadowCache::EndFrame()
+{
+	for (auto iterator = m_Lights.begin(); iterator != m_Lights.end();)
+	{
+		LightState& state = iterator->second;
+		if (m_Frame - state.LastFrame > EvictionFrames)
+		{
+			if (state.Tile.IsValid())
+			{
+				m_Allocator.Free(state.Tile);
+			}
+
+			iterator = m_Lights.erase(iterator);
+		}
+		else
+		{
+			++iterator;
+		}
+	}
+}
+
+const ShadowAtlasAllocator& ShadowCache::GetAllocator() const
+{
+	return m_Allocator;
+}
+
+uint32_t ShadowCache::GetCachedLightsCount() const
+{
+	return m_Lights.size();
+}
+
+void ShadowCache::InvalidateIntersecting(const glm::vec4& sphere)
+{
+	for (auto& [key, light] : m_Lights)
+	{
+		if (Intersects(light.BoundingSphere, sphere))
+		{
+			light.bIsDirty = true;
+		}
+	}
+}
+
+bool ShadowCache::AllocateTile(uint32_t size, ShadowAtlasTile& tile)
+{
+	// Lights not needed this frame give their tiles up first
+	while (!m_Allocator.Allocate(size, tile))
+	{
+		if (!EvictLeastRecentlyUsed())
+		{
+			for (size /= 2; size >= m_Allocator.GetMinTileSize(); size /= 2)
+			{
+				if (m_Allocator.Allocate(size, tile))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool ShadowCache::EvictLeastRecentlyUsed()
+{
+	auto evicted = m_Lights.end();
+	for (auto iterator = m_Lights.begin(); iterator != m_Lights.end(); ++iterator)
+	{
+		const LightState& state = iterator->second;
+		if (state.Tile.IsValid() && state.LastFrame != m_Frame && (evicted == m_Lights.end() || state.LastFrame < evicted->second.LastFrame))
+		{
+			evicted = iterator;
+		}
+	}
+
+	if (evicted == m_Lights.end())
+	{
+		return false;
+	}
+
+	m_Allocator.Free(evicted->second.Tile);
+	m_Lights.erase(evicted);
+
+	return true;
+}
+
+bool ShadowCache::Intersects(const glm::vec4& first, const glm::vec4& second)
+{
+	if (first.w < 0.0f || second.w < 0.0f)
+	{
+		return true;
+	}
+
+	glm::vec3 offset = glm::vec3(first) - glm::vec3(second);
+	float distance = first.w + second.w;
+
+	return glm::dot(offset, offset) <= distance * distance;
+}
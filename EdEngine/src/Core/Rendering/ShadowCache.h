@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Core/Ed.h"
+#include "ShadowAtlas.h"
+#include <glm/vec4.hpp>
+#include <unordered_map>
+
+enum class ShadowUpdate : uint8_t
+{
+	// Tile still holds the shadow of the last update
+	None,
+	// Cached static casters are copied into the tile and dynamic ones are drawn over them
+	Dynamic,
+	// Cache of static casters is drawn again before dynamic casters are drawn
+	Full
+};
+
+// Bounding sphere has negative radius when it is unknown, such casters touch every light.
+// Generation is anything that changes when the caster moves, e.g. Component::GetWorldTransformGeneration
+struct ShadowCaster
+{
+	const void* Key = nullptr;
+	glm::vec4 BoundingSphere = glm::vec4(0.0f, 0.0f, 0.0f, -1.0f);
+	uint32_t Generation = 0;
+};
+
+// Bounding sphere encloses the volume the light reaches, any change of the projection view matrix redraws the shadow.
+// Lights with tile size of zero give their tiles up, lights that shouldn't update keep their shadows as they are unless their tiles change
+struct ShadowLight
+{
+	const void* Key = nullptr;
+	glm::vec4 BoundingSphere = glm::vec4(0.0f);
+	glm::mat4 ProjectionView = glm::mat4(1.0f);
+	uint32_t TileSize = 0;
+	bool bShouldUpdate = true;
+};
+
+// Keeps an atlas tile and a cache of static casters for every shadow casting light. There are no mobility flags,
+// so casters become dynamic when they move and go back to the static cache once they stay still for a while.
+// A cache is invalidated only when a static caster within the light bounds appears, disappears, starts or stops moving, or the light itself changes
+class ShadowCache
+{
+public:
+	static const uint32_t SettleFrames = 30;
+	// Tiles of lights that weren't updated for this long are freed, lights hidden for a moment keep their caches
+	static const uint32_t EvictionFrames = 120;
+
+	// Frees all tiles, so every light is drawn in full again
+	void Reset(uint32_t atlasSize, uint32_t minTileSize);
+	void Invalidate();
+
+	// Called once per frame with every shadow caster of the scene
+	void BeginFrame(const std::vector<ShadowCaster>& casters);
+
+	// Called for lights whose shadows are needed this frame. When the atlas is full of lights of this frame the tile is smaller than
+	// requested or invalid, invalid tiles mean the light has no shadow this frame. Casters are indices into the casters of BeginFrame
+	ShadowUpdate UpdateLight(const ShadowLight& light, ShadowAtlasTile& tile);
+	const std::vector<uint32_t>& GetStaticCasters() const;
+	const std::vector<uint32_t>& GetDynamicCasters() const;
+
+	void EndFrame();
+
+	const ShadowAtlasAllocator& GetAllocator() const;
+	uint32_t GetCachedLightsCount() const;
+
+private:
+	struct CasterState
+	{
+		glm::vec4 BoundingSphere;
+		uint32_t Generation = 0;
+		uint32_t StillFrames = 0;
+		uint64_t LastFrame = 0;
+		bool bIsDynamic = false;
+	};
+
+	struct LightState
+	{
+		ShadowAtlasTile Tile;
+		uint32_t RequestedTileSize = 0;
+		glm::vec4 BoundingSphere = glm::vec4(0.0f);
+		glm::mat4 ProjectionView = glm::mat4(1.0f);
+		uint64_t LastFrame = 0;
+		bool bIsDirty = true;
+		bool bHadDynamicCasters = false;
+	};
+
+	void InvalidateIntersecting(const glm::vec4& sphere);
+	bool AllocateTile(uint32_t size, ShadowAtlasTile& tile);
+	bool EvictLeastRecentlyUsed();
+
+	static bool Intersects(const glm::vec4& first, const glm::vec4& second);
+
+private:
+	ShadowAtlasAllocator m_Allocator;
+	uint64_t m_Frame = 0;
+
+	std::unordered_map<const void*, CasterState> m_Casters;
+	std::unordered_map<const void*, LightState> m_Lights;
+
+	// Casters of the current frame
+	std::vector<glm::vec4> m_CasterSpheres;
+	std::vector<uint32_t> m_DynamicCasterIndices;
+	std::vector<uint8_t> m_DynamicCasterFlags;
+
+	std::vector<uint32_t> m_StaticCasters;
+	std::vector<uint32_t> m_DynamicCasters;
+};
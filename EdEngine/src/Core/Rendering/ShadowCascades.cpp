@@ -0,0 +1,167 @@
+#include "ShadowCascades.h"
+#include "Core/Math/Camera.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+// Radius is rounded up to this step so float noise of frustum corners doesn't change the size of texels
+static const float RadiusStep = 1.0f / 16.0f;
+
+void ShadowCascades::CalculateSplits(float near, float far, uint32_t count, float lambda, float* splits)
+{
+	for (uint32_t i = 0; i <= count; ++i)
+	{
+		float fraction = (float)i / count;
+
+		float uniform = near + (far - near) * fraction;
+		float logarithmic = near * glm::pow(far / near, fraction);
+
+		splits[i] = glm::mix(uniform, logarithmic, lambda);
+	}
+
+	// Exact ends, pow doesn't always return them
+	splits[0] = near;
+	splits[count] = far;
+}
+
+uint32_t ShadowCascades::GetUpdateInterval(uint32_t cascade)
+{
+	return cascade < 2 ? 1 : glm::min(1u << (cascade - 1), MaxUpdateInterval);
+}
+
+void ShadowCascades::Update(const Camera& camera, float far, const glm::vec3& direction, uint32_t count, float lambda, uint32_t resolution, float depthMultiplier)
+{
+	++m_Frame;
+
+	count = glm::clamp(count, 1u, MaxCascadesCount);
+
+	bool bUpdateAll = !m_bIsValid || count != m_Count || direction != m_Direction || lambda != m_Lambda || resolution != m_Resolution || depthMultiplier != m_DepthMultiplier;
+
+	m_Count = count;
+	m_Direction = direction;
+	m_Lambda = lambda;
+	m_Resolution = resolution;
+	m_DepthMultiplier = depthMultiplier;
+	m_bIsValid = true;
+
+	if (bUpdateAll)
+	{
+		glm::vec3 up = glm::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+		m_LightView = glm::lookAt(glm::vec3(0.0f), direction, up);
+	}
+
+	float splits[MaxCascadesCount + 1];
+	CalculateSplits(camera.GetNear(), far, count, lambda, splits);
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		ShadowCascade& cascade = m_Cascades[i];
+
+		cascade.UpdateInterval = GetUpdateInterval(i);
+		cascade.bShouldUpdate = bUpdateAll || (m_Frame + i) % cascade.UpdateInterval == 0;
+
+		glm::vec3 corners[8];
+		camera.GetFrustumCorners(splits[i], splits[i + 1], corners);
+
+		// Turning the camera moves the slice out of the old projection well before its center moves much,
+		// fragments outside of every layer would be left in shadow
+		if (!cascade.bShouldUpdate)
+		{
+			cascade.bShouldUpdate = !Covers(cascade, corners);
+		}
+
+		if (cascade.bShouldUpdate)
+		{
+			cascade.Near = splits[i];
+			cascade.Far = splits[i + 1];
+
+			CalculateCascade(cascade, corners, resolution, depthMultiplier);
+		}
+	}
+}
+
+void ShadowCascades::Invalidate()
+{
+	m_bIsValid = false;
+}
+
+bool ShadowCascades::Intersects(uint32_t index, const glm::vec4& sphere) const
+{
+	if (sphere.w < 0.0f)
+	{
+		return true;
+	}
+
+	const ShadowCascade& cascade = m_Cascades[index];
+	float extent = cascade.BoundingSphere.w + sphere.w;
+
+	glm::vec3 center = m_LightView * glm::vec4(glm::vec3(sphere), 1.0f);
+	float distance = -center.z;
+
+	return glm::abs(center.x - cascade.LightCenter.x) <= extent && glm::abs(center.y - cascade.LightCenter.y) <= extent &&
+		distance + sphere.w >= cascade.LightNear && distance - sphere.w <= cascade.LightFar;
+}
+
+uint32_t ShadowCascades::GetCount() const
+{
+	return m_Count;
+}
+
+const ShadowCascade& ShadowCascades::GetCascade(uint32_t index) const
+{
+	return m_Cascades[index];
+}
+
+bool ShadowCascades::Covers(const ShadowCascade& cascade, const glm::vec3 corners[8]) const
+{
+	float radius = cascade.BoundingSphere.w;
+
+	for (int32_t i = 0; i < 8; ++i)
+	{
+		glm::vec3 corner = m_LightView * glm::vec4(corners[i], 1.0f);
+		float distance = -corner.z;
+
+		if (glm::abs(corner.x - cascade.LightCenter.x) > radius || glm::abs(corner.y - cascade.LightCenter.y) > radius ||
+			distance < cascade.LightNear || distance > cascade.LightFar)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void ShadowCascades::CalculateCascade(ShadowCascade& cascade, const glm::vec3 corners[8], uint32_t resolution, float depthMultiplier) const
+{
+	glm::vec3 center(0.0f);
+	for (int32_t i = 0; i < 8; ++i)
+	{
+		center += corners[i];
+	}
+
+	center /= 8.0f;
+
+	float radius = 0.0f;
+	for (int32_t i = 0; i < 8; ++i)
+	{
+		radius = glm::max(radius, glm::distance(center, corners[i]));
+	}
+
+	radius = glm::ceil(radius / RadiusStep) * RadiusStep;
+
+	cascade.BoundingSphere = glm::vec4(center, radius);
+
+	// Projection moves by whole texels only, so texels of static geometry stay where they were
+	float texelSize = 2.0f * radius / resolution;
+
+	glm::vec3 centerLight = m_LightView * glm::vec4(center, 1.0f);
+	cascade.LightCenter = glm::floor(glm::vec2(centerLight) / texelSize) * texelSize;
+
+	float distance = -centerLight.z;
+	cascade.LightNear = distance - radius * depthMultiplier;
+	cascade.LightFar = distance + radius;
+
+	glm::vec2 min = cascade.LightCenter - radius;
+	glm::vec2 max = cascade.LightCenter + radius;
+
+	cascade.ProjectionView = glm::ortho(min.x, max.x, min.y, max.y, cascade.LightNear, cascade.LightFar) * m_LightView;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Core/Ed.h"
+#include <glm/mat4x4.hpp>
+
+class Camera;
+
+struct ShadowCascade
+{
+	// View depth range of the camera the cascade covers
+	float Near = 0.0f;
+	float Far = 0.0f;
+
+	// World space sphere around the slice of the view frustum, its radius depends only on the depth range and the projection,
+	// so the projection keeps its size while the camera turns
+	glm::vec4 BoundingSphere = glm::vec4(0.0f, 0.0f, 0.0f, -1.0f);
+
+	// Light view only rotates, center of the projection is snapped to its texels in it
+	glm::mat4 ProjectionView = glm::mat4(1.0f);
+	glm::vec2 LightCenter = glm::vec2(0.0f);
+	// Distances along the light direction, casters between the light and the receivers are caught by the near one
+	float LightNear = 0.0f;
+	float LightFar = 0.0f;
+
+	uint32_t UpdateInterval = 1;
+	bool bShouldUpdate = true;
+};
+
+// Splits the view frustum into cascades of a directional light shadow. Far cascades update every few frames,
+// cascades that are not due keep the matrices their layers were drawn with
+class ShadowCascades
+{
+public:
+	static const uint32_t MaxCascadesCount = 4;
+	static const uint32_t MaxUpdateInterval = 4;
+
+	// Lambda blends uniform splits at 0 with logarithmic ones at 1, splits get count + 1 distances from near to far
+	static void CalculateSplits(float near, float far, uint32_t count, float lambda, float* splits);
+
+	// First two cascades update every frame, every next one half as often
+	static uint32_t GetUpdateInterval(uint32_t cascade);
+
+	// Changes of the light or the settings update all cascades at once
+	void Update(const Camera& camera, float far, const glm::vec3& direction, uint32_t count, float lambda, uint32_t resolution, float depthMultiplier);
+	// Next update recalculates every cascade, e.g. when layers are lost
+	void Invalidate();
+
+	// Whether a sphere can cast a shadow into the cascade, spheres with negative radius always can
+	bool Intersects(uint32_t cascade, const glm::vec4& sphere) const;
+
+	uint32_t GetCount() const;
+	const ShadowCascade& GetCascade(uint32_t index) const;
+
+private:
+	// Whether the projection the cascade was drawn with still contains every corner of its slice
+	bool Covers(const ShadowCascade& cascade, const glm::vec3 corners[8]) const;
+	void CalculateCascade(ShadowCascade& cascade, const glm::vec3 corners[8], uint32_t resolution, float depthMultiplier) const;
+
+private:
+	ShadowCascade m_Cascades[MaxCascadesCount];
+	uint32_t m_Count = 0;
+	uint64_t m_Frame = 0;
+
+	// Light view without translation
+	glm::mat4 m_LightView = glm::mat4(1.0f);
+
+	// Settings the cascades were calculated with
+	glm::vec3 m_Direction = glm::vec3(0.0f);
+	float m_Lambda = 0.0f;
+	uint32_t m_Resolution = 0;
+	float m_DepthMultiplier = 0.0f;
+	bool m_bIsValid = false;
+};
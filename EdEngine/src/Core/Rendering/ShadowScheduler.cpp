@@ -0,0 +1,197 @@
+#include "ShadowScheduler.h"
+#include "Core/Macros.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+
+// Projected size has to drift this far from a tile size before the tile size changes
+static const float TileSizeHysteresis = 1.25f;
+
+// Nearest power of two on a logarithmic scale
+static uint32_t RoundToPowerOfTwo(float value)
+{
+	uint32_t result = 1;
+	while (result * glm::root_two<float>() <= value)
+	{
+		result <<= 1;
+	}
+
+	return result;
+}
+
+void ShadowScheduler::Reset(uint32_t minTileSize, uint32_t maxTileSize, uint64_t atlasBudget, uint64_t updateBudget)
+{
+	ED_ASSERT(minTileSize <= maxTileSize, "Min tile size {} is bigger than max tile size {}", minTileSize, maxTileSize)
+
+	m_MinTileSize = minTileSize;
+	m_MaxTileSize = maxTileSize;
+	m_AtlasBudget = atlasBudget;
+	m_UpdateBudget = updateBudget;
+
+	m_Lights.clear();
+}
+
+void ShadowScheduler::SetView(const glm::vec3& position, float fov, glm::u32vec2 viewportSize, float maxDistance)
+{
+	m_ViewPosition = position;
+	m_ProjectionScale = 0.5f * viewportSize.y / glm::tan(0.5f * fov);
+	m_ScreenArea = glm::max(1.0f, (float)viewportSize.x * viewportSize.y);
+	m_MaxDistance = maxDistance;
+}
+
+void ShadowScheduler::Schedule(const std::vector<ShadowRequest>& requests)
+{
+	++m_Frame;
+
+	m_AllocatedArea = 0;
+	m_UpdateCost = 0;
+
+	m_Scores.resize(requests.size());
+	m_Diameters.resize(requests.size());
+
+	for (uint32_t i = 0; i < requests.size(); ++i)
+	{
+		m_Diameters[i] = GetProjectedDiameter(requests[i].BoundingSphere);
+		m_Scores[i] = GetScore(requests[i]);
+	}
+
+	m_Order.resize(requests.size());
+	std::iota(m_Order.begin(), m_Order.end(), 0);
+	std::sort(m_Order.begin(), m_Order.end(), [this](uint32_t first, uint32_t second) { return m_Scores[first] > m_Scores[second]; });
+
+	for (uint32_t index : m_Order)
+	{
+		const ShadowRequest& request = requests[index];
+
+		LightState& state = m_Lights[request.Key];
+		state.LastFrame = m_Frame;
+
+		ShadowSchedule& schedule = state.Schedule;
+		schedule = ShadowSchedule();
+		schedule.Score = m_Scores[index];
+
+		if (schedule.Score <= 0.0f)
+		{
+			state.DesiredTileSize = 0;
+			continue;
+		}
+
+		state.DesiredTileSize = GetDesiredTileSize(m_Diameters[index], state.DesiredTileSize);
+
+		// Less important lights get what is left of the atlas, down to the smallest tile
+		uint64_t atlasLeft = m_AtlasBudget - m_AllocatedArea;
+
+		uint32_t size = state.DesiredTileSize;
+		while (size > m_MinTileSize && (uint64_t)size * size > atlasLeft)
+		{
+			size /= 2;
+		}
+
+		if ((uint64_t)size * size > atlasLeft)
+		{
+			continue;
+		}
+
+		schedule.TileSize = size;
+		m_AllocatedArea += (uint64_t)size * size;
+
+		uint64_t cost = (uint64_t)request.Faces * size * size;
+		uint64_t updateLeft = m_UpdateBudget - m_UpdateCost;
+
+		for (uint32_t interval = 1; interval <= MaxUpdateInterval; interval *= 2)
+		{
+			if (cost / interval <= updateLeft)
+			{
+				schedule.UpdateInterval = interval;
+				m_UpdateCost += cost / interval;
+				break;
+			}
+		}
+
+		// Key spreads lights with the same interval over different frames
+		if (schedule.UpdateInterval != 0)
+		{
+			uint64_t phase = std::hash<const void*>{}(request.Key);
+			schedule.bShouldUpdate = (m_Frame + phase) % schedule.UpdateInterval == 0;
+		}
+	}
+
+	for (auto iterator = m_Lights.begin(); iterator != m_Lights.end();)
+	{
+		if (iterator->second.LastFrame != m_Frame)
+		{
+			iterator = m_Lights.erase(iterator);
+		}
+		else
+		{
+			++iterator;
+		}
+	}
+}
+
+const ShadowSchedule& ShadowScheduler::GetSchedule(const void* key) const
+{
+	static const ShadowSchedule empty;
+
+	auto iterator = m_Lights.find(key);
+	return iterator != m_Lights.end() ? iterator->second.Schedule : empty;
+}
+
+float ShadowScheduler::GetScore(const ShadowRequest& request) const
+{
+	const glm::vec4& sphere = request.BoundingSphere;
+
+	float distance = glm::max(0.0f, glm::distance(glm::vec3(sphere), m_ViewPosition) - sphere.w);
+	if (distance >= m_MaxDistance || request.Intensity <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	float radius = 0.5f * GetProjectedDiameter(sphere);
+	float coverage = glm::min(1.0f, glm::pi<float>() * radius * radius / m_ScreenArea);
+
+	return coverage * request.Intensity * (1.0f - distance / m_MaxDistance);
+}
+
+float ShadowScheduler::GetProjectedDiameter(const glm::vec4& sphere) const
+{
+	glm::vec3 offset = glm::vec3(sphere) - m_ViewPosition;
+
+	float distanceSqr = glm::dot(offset, offset);
+	float radiusSqr = sphere.w * sphere.w;
+
+	if (distanceSqr <= radiusSqr)
+	{
+		return std::numeric_limits<float>::infinity();
+	}
+
+	// Tangent of the angle the sphere takes from its center
+	return 2.0f * m_ProjectionScale * sphere.w / glm::sqrt(distanceSqr - radiusSqr);
+}
+
+uint64_t ShadowScheduler::GetAllocatedArea() const
+{
+	return m_AllocatedArea;
+}
+
+uint64_t ShadowScheduler::GetUpdateCost() const
+{
+	return m_UpdateCost;
+}
+
+uint32_t ShadowScheduler::GetDesiredTileSize(float diameter, uint32_t previous) const
+{
+	if (previous != 0 && diameter * TileSizeHysteresis >= previous * glm::one_over_root_two<float>() && diameter <= previous * glm::root_two<float>() * TileSizeHysteresis)
+	{
+		return previous;
+	}
+
+	if (diameter >= m_MaxTileSize)
+	{
+		return m_MaxTileSize;
+	}
+
+	return glm::clamp(RoundToPowerOfTwo(diameter), m_MinTileSize, m_MaxTileSize);
+}
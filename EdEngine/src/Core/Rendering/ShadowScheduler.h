@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Core/Ed.h"
+#include <unordered_map>
+
+// Bounding sphere encloses the volume the light reaches. Faces are the shadow maps drawn for a tile, six for point lights
+struct ShadowRequest
+{
+	const void* Key = nullptr;
+	glm::vec4 BoundingSphere = glm::vec4(0.0f);
+	float Intensity = 0.0f;
+	uint32_t Faces = 1;
+};
+
+// Tile size of zero means the light has no shadow. Update interval of zero means the shadow is frozen,
+// it is drawn only when its tile is allocated again
+struct ShadowSchedule
+{
+	float Score = 0.0f;
+	uint32_t TileSize = 0;
+	uint32_t UpdateInterval = 0;
+	bool bShouldUpdate = false;
+};
+
+// Scores shadow casting lights by how much of the screen they cover, their intensity and distance, then hands out tile sizes
+// from an atlas budget and update intervals from a budget of texels drawn per frame, most important lights first.
+// Interval n costs 1/n of a full update per frame on average, lights are spread over frames so they don't update together
+class ShadowScheduler
+{
+public:
+	static const uint32_t MaxUpdateInterval = 8;
+
+	// Tile sizes must be powers of two, both budgets are in texels
+	void Reset(uint32_t minTileSize, uint32_t maxTileSize, uint64_t atlasBudget, uint64_t updateBudget);
+
+	// Fov is vertical and in radians, lights farther than max distance don't get shadows
+	void SetView(const glm::vec3& position, float fov, glm::u32vec2 viewportSize, float maxDistance);
+
+	// Called once per frame with every light that needs a shadow, schedules of lights not passed are dropped
+	void Schedule(const std::vector<ShadowRequest>& requests);
+	const ShadowSchedule& GetSchedule(const void* key) const;
+
+	float GetScore(const ShadowRequest& request) const;
+	// Diameter of the light bounds on the screen in pixels, infinite when the view is inside them
+	float GetProjectedDiameter(const glm::vec4& sphere) const;
+
+	uint64_t GetAllocatedArea() const;
+	uint64_t GetUpdateCost() const;
+
+private:
+	struct LightState
+	{
+		ShadowSchedule Schedule;
+		// Size before the budget is applied, kept while the projected size stays close to it so tiles aren't allocated again every frame
+		uint32_t DesiredTileSize = 0;
+		uint64_t LastFrame = 0;
+	};
+
+	uint32_t GetDesiredTileSize(float diameter, uint32_t previous) const;
+
+private:
+	uint32_t m_MinTileSize = 1;
+	uint32_t m_MaxTileSize = 1;
+	uint64_t m_AtlasBudget = 0;
+	uint64_t m_UpdateBudget = 0;
+
+	glm::vec3 m_ViewPosition = glm::vec3(0.0f);
+	float m_ProjectionScale = 1.0f;
+	float m_ScreenArea = 1.0f;
+	float m_MaxDistance = 1.0f;
+
+	uint64_t m_Frame = 0;
+	uint64_t m_AllocatedArea = 0;
+	uint64_t m_UpdateCost = 0;
+
+	std::unordered_map<const void*, LightState> m_Lights;
+
+	std::vector<float> m_Scores;
+	std::vector<float> m_Diameters;
+	std::vector<uint32_t> m_Order;
+};
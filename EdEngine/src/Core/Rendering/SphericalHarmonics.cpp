@@ -0,0 +1,80 @@
+#include "SphericalHarmonics.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+SHL2::SHL2()
+{
+	for (glm::vec3& coefficient : Coefficients)
+	{
+		coefficient = glm::vec3(0.0f);
+	}
+}
+
+void SHL2::EvaluateBasis(const glm::vec3& direction, float basis[CoefficientsCount])
+{
+	const glm::vec3& d = direction;
+
+	basis[0] = 0.282095f;
+
+	basis[1] = 0.488603f * d.y;
+	basis[2] = 0.488603f * d.z;
+	basis[3] = 0.488603f * d.x;
+
+	basis[4] = 1.092548f * d.x * d.y;
+	basis[5] = 1.092548f * d.y * d.z;
+	basis[6] = 0.315392f * (3.0f * d.z * d.z - 1.0f);
+	basis[7] = 1.092548f * d.x * d.z;
+	basis[8] = 0.546274f * (d.x * d.x - d.y * d.y);
+}
+
+void SHL2::AddRadiance(const glm::vec3& direction, const glm::vec3& radiance, float weight)
+{
+	float basis[CoefficientsCount];
+	EvaluateBasis(direction, basis);
+
+	for (uint32_t i = 0; i < CoefficientsCount; ++i)
+	{
+		Coefficients[i] += radiance * (basis[i] * weight);
+	}
+}
+
+void SHL2::Add(const SHL2& other, float weight)
+{
+	for (uint32_t i = 0; i < CoefficientsCount; ++i)
+	{
+		Coefficients[i] += other.Coefficients[i] * weight;
+	}
+}
+
+SHL2 SHL2::GetCosineConvolved() const
+{
+	// Bands of the clamped cosine are pi, 2pi/3 and pi/4 (Ramamoorthi and Hanrahan), divided by pi here
+	static const float bands[CoefficientsCount] = { 1.0f, 2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f };
+
+	SHL2 result;
+	for (uint32_t i = 0; i < CoefficientsCount; ++i)
+	{
+		result.Coefficients[i] = Coefficients[i] * bands[i];
+	}
+
+	return result;
+}
+
+glm::vec3 SHL2::Evaluate(const glm::vec3& direction) const
+{
+	float basis[CoefficientsCount];
+	EvaluateBasis(direction, basis);
+
+	glm::vec3 result = glm::vec3(0.0f);
+	for (uint32_t i = 0; i < CoefficientsCount; ++i)
+	{
+		result += Coefficients[i] * basis[i];
+	}
+
+	return result;
+}
+
+glm::vec3 SHL2::GetIrradiance(const glm::vec3& normal) const
+{
+	return glm::max(glm::pi<float>() * GetCosineConvolved().Evaluate(normal), glm::vec3(0.0f));
+}
\ No newline at end of file
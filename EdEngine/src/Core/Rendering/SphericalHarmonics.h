@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Core/Ed.h"
+
+// RGB radiance in real spherical harmonics up to the second band. Nine coefficients keep irradiance of a point within a few percent,
+// the cosine lobe it is convolved with has almost nothing in higher bands
+struct SHL2
+{
+	static const uint32_t CoefficientsCount = 9;
+
+	glm::vec3 Coefficients[CoefficientsCount];
+
+	SHL2();
+
+	static void EvaluateBasis(const glm::vec3& direction, float basis[CoefficientsCount]);
+
+	// Weight is the solid angle the sample stands for, light of a point source is added with its irradiance and weight one
+	void AddRadiance(const glm::vec3& direction, const glm::vec3& radiance, float weight);
+	void Add(const SHL2& other, float weight);
+
+	// Coefficients of irradiance divided by pi, evaluating them in a normal gives the diffuse light of a white surface
+	SHL2 GetCosineConvolved() const;
+
+	glm::vec3 Evaluate(const glm::vec3& direction) const;
+	// Never negative, ringing of the second band can push a few directions below zero
+	glm::vec3 GetIrradiance(const glm::vec3& normal) const;
+};
\ No newline at end of file
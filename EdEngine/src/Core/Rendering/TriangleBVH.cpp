@@ -0,0 +1,393 @@
+#include "TriangleBVH.h"
+#include "Core/Macros.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+
+static float GetSurfaceArea(const glm::vec3& min, const glm::vec3& max)
+{
+	if (min.x > max.x)
+	{
+		return 0.0f;
+	}
+
+	glm::vec3 size = max - min;
+	return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+// Moller-Trumbore, both sides of the triangle are hit
+static bool IntersectTriangle(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3* corners, float maxDistance, float& distance, glm::vec2& barycentrics)
+{
+	glm::vec3 firstEdge = corners[1] - corners[0];
+	glm::vec3 secondEdge = corners[2] - corners[0];
+
+	glm::vec3 p = glm::cross(direction, secondEdge);
+	float determinant = glm::dot(firstEdge, p);
+
+	if (glm::abs(determinant) < 1e-12f)
+	{
+		return false;
+	}
+
+	float inverseDeterminant = 1.0f / determinant;
+
+	glm::vec3 t = origin - corners[0];
+	float u = glm::dot(t, p) * inverseDeterminant;
+	if (u < 0.0f || u > 1.0f)
+	{
+		return false;
+	}
+
+	glm::vec3 q = glm::cross(t, firstEdge);
+	float v = glm::dot(direction, q) * inverseDeterminant;
+	if (v < 0.0f || u + v > 1.0f)
+	{
+		return false;
+	}
+
+	float hitDistance = glm::dot(secondEdge, q) * inverseDeterminant;
+	if (hitDistance <= 0.0f || hitDistance >= maxDistance)
+	{
+		return false;
+	}
+
+	distance = hitDistance;
+	barycentrics = glm::vec2(u, v);
+
+	return true;
+}
+
+void TriangleBVH::Build(const std::vector<glm::vec3>& corners)
+{
+	ED_ASSERT(corners.size() % 3 == 0, "Corners count {} isn't a multiple of three", corners.size())
+
+	m_Corners = corners;
+	m_Nodes.clear();
+
+	uint32_t trianglesCount = corners.size() / 3;
+
+	m_Triangles.resize(trianglesCount);
+	std::vector<glm::vec3> centroids(trianglesCount);
+
+	for (uint32_t i = 0; i < trianglesCount; ++i)
+	{
+		m_Triangles[i] = i;
+		centroids[i] = (corners[3 * i] + corners[3 * i + 1] + corners[3 * i + 2]) / 3.0f;
+	}
+
+	// Two nodes per triangle is the most a binary tree with one triangle per leaf can have
+	m_Nodes.reserve(glm::max(2 * trianglesCount, 1u));
+
+	Node& root = m_Nodes.emplace_back();
+	root.First = 0;
+	root.Count = trianglesCount;
+
+	if (trianglesCount == 0)
+	{
+		return;
+	}
+
+	UpdateBounds(root);
+	Subdivide(0, 0, centroids);
+}
+
+bool TriangleBVH::Intersect(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, TriangleHit& hit) const
+{
+	hit = TriangleHit();
+	return Traverse<false>(origin, direction, maxDistance, hit);
+}
+
+bool TriangleBVH::IsOccluded(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const
+{
+	TriangleHit hit;
+	return Traverse<true>(origin, direction, maxDistance, hit);
+}
+
+uint32_t TriangleBVH::GetTrianglesCount() const
+{
+	return m_Triangles.size();
+}
+
+uint32_t TriangleBVH::GetNodesCount() const
+{
+	return m_Nodes.size();
+}
+
+glm::vec3 TriangleBVH::GetBoundsMin() const
+{
+	return m_Nodes.empty() ? glm::vec3(FLT_MAX) : m_Nodes[0].Min;
+}
+
+glm::vec3 TriangleBVH::GetBoundsMax() const
+{
+	return m_Nodes.empty() ? glm::vec3(-FLT_MAX) : m_Nodes[0].Max;
+}
+
+void TriangleBVH::Subdivide(uint32_t nodeIndex, uint32_t depth, const std::vector<glm::vec3>& centroids)
+{
+	Node node = m_Nodes[nodeIndex];
+	if (node.Count <= 1 || depth >= MaxDepth)
+	{
+		return;
+	}
+
+	glm::vec3 centroidMin = glm::vec3(FLT_MAX);
+	glm::vec3 centroidMax = glm::vec3(-FLT_MAX);
+
+	for (uint32_t i = node.First; i < node.First + node.Count; ++i)
+	{
+		centroidMin = glm::min(centroidMin, centroids[m_Triangles[i]]);
+		centroidMax = glm::max(centroidMax, centroids[m_Triangles[i]]);
+	}
+
+	// Cost of a leaf is one intersection per triangle, relative to the area of the node
+	float bestCost = node.Count * GetSurfaceArea(node.Min, node.Max);
+	int32_t bestAxis = -1;
+	uint32_t bestSplit = 0;
+
+	for (int32_t axis = 0; axis < 3; ++axis)
+	{
+		float extent = centroidMax[axis] - centroidMin[axis];
+		if (extent <= 0.0f)
+		{
+			continue;
+		}
+
+		struct Bin
+		{
+			glm::vec3 Min = glm::vec3(FLT_MAX);
+			glm::vec3 Max = glm::vec3(-FLT_MAX);
+			uint32_t Count = 0;
+		};
+
+		Bin bins[BinsCount];
+		float scale = BinsCount / extent;
+
+		for (uint32_t i = node.First; i < node.First + node.Count; ++i)
+		{
+			uint32_t triangle = m_Triangles[i];
+			uint32_t binIndex = glm::min(uint32_t((centroids[triangle][axis] - centroidMin[axis]) * scale), BinsCount - 1);
+
+			Bin& bin = bins[binIndex];
+			++bin.Count;
+
+			for (uint32_t corner = 0; corner < 3; ++corner)
+			{
+				bin.Min = glm::min(bin.Min, m_Corners[3 * triangle + corner]);
+				bin.Max = glm::max(bin.Max, m_Corners[3 * triangle + corner]);
+			}
+		}
+
+		// Costs of everything left of a split are swept from the left and the rest from the right
+		float leftAreas[BinsCount - 1];
+		uint32_t leftCounts[BinsCount - 1];
+
+		glm::vec3 min = glm::vec3(FLT_MAX);
+		glm::vec3 max = glm::vec3(-FLT_MAX);
+		uint32_t count = 0;
+
+		for (uint32_t i = 0; i < BinsCount - 1; ++i)
+		{
+			min = glm::min(min, bins[i].Min);
+			max = glm::max(max, bins[i].Max);
+			count += bins[i].Count;
+
+			leftAreas[i] = GetSurfaceArea(min, max);
+			leftCounts[i] = count;
+		}
+
+		min = glm::vec3(FLT_MAX);
+		max = glm::vec3(-FLT_MAX);
+		count = 0;
+
+		for (uint32_t i = BinsCount - 1; i > 0; --i)
+		{
+			min = glm::min(min, bins[i].Min);
+			max = glm::max(max, bins[i].Max);
+			count += bins[i].Count;
+
+			if (count == 0 || leftCounts[i - 1] == 0)
+			{
+				continue;
+			}
+
+			float cost = leftCounts[i - 1] * leftAreas[i - 1] + count * GetSurfaceArea(min, max);
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = i;
+			}
+		}
+	}
+
+	uint32_t middle = node.First;
+
+	if (bestAxis >= 0)
+	{
+		float scale = BinsCount / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+
+		auto begin = m_Triangles.begin() + node.First;
+		auto end = begin + node.Count;
+
+		middle = std::stable_partition(begin, end, [&](uint32_t triangle)
+		{
+			return glm::min(uint32_t((centroids[triangle][bestAxis] - centroidMin[bestAxis]) * scale), BinsCount - 1) < bestSplit;
+		}) - m_Triangles.begin();
+	}
+	else if (node.Count > MaxLeafSize)
+	{
+		// Heuristic found no better split, big leaves are still halved along the longest axis
+		glm::vec3 extent = centroidMax - centroidMin;
+		int32_t axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+		auto begin = m_Triangles.begin() + node.First;
+		auto end = begin + node.Count;
+
+		std::stable_sort(begin, end, [&](uint32_t first, uint32_t second)
+		{
+			return centroids[first][axis] < centroids[second][axis];
+		});
+
+		middle = node.First + node.Count / 2;
+	}
+	else
+	{
+		return;
+	}
+
+	uint32_t leftCount = middle - node.First;
+	if (leftCount == 0 || leftCount == node.Count)
+	{
+		return;
+	}
+
+	uint32_t leftIndex = m_Nodes.size();
+
+	Node& left = m_Nodes.emplace_back();
+	left.First = node.First;
+	left.Count = leftCount;
+	UpdateBounds(left);
+
+	Node& right = m_Nodes.emplace_back();
+	right.First = middle;
+	right.Count = node.Count - leftCount;
+	UpdateBounds(right);
+
+	m_Nodes[nodeIndex].First = leftIndex;
+	m_Nodes[nodeIndex].Count = 0;
+
+	Subdivide(leftIndex, depth + 1, centroids);
+	Subdivide(leftIndex + 1, depth + 1, centroids);
+}
+
+void TriangleBVH::UpdateBounds(Node& node) const
+{
+	node.Min = glm::vec3(FLT_MAX);
+	node.Max = glm::vec3(-FLT_MAX);
+
+	for (uint32_t i = node.First; i < node.First + node.Count; ++i)
+	{
+		uint32_t triangle = m_Triangles[i];
+		for (uint32_t corner = 0; corner < 3; ++corner)
+		{
+			node.Min = glm::min(node.Min, m_Corners[3 * triangle + corner]);
+			node.Max = glm::max(node.Max, m_Corners[3 * triangle + corner]);
+		}
+	}
+}
+
+template<bool bAnyHit>
+bool TriangleBVH::Traverse(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, TriangleHit& hit) const
+{
+	if (m_Triangles.empty())
+	{
+		return false;
+	}
+
+	glm::vec3 inverseDirection = 1.0f / direction;
+
+	float distance = 0.0f;
+	if (!IntersectBox(m_Nodes[0], origin, inverseDirection, maxDistance, distance))
+	{
+		return false;
+	}
+
+	uint32_t stack[MaxDepth + 1];
+	uint32_t stackSize = 0;
+
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		const Node& node = m_Nodes[stack[--stackSize]];
+
+		if (node.Count > 0)
+		{
+			for (uint32_t i = node.First; i < node.First + node.Count; ++i)
+			{
+				uint32_t triangle = m_Triangles[i];
+
+				float triangleDistance = 0.0f;
+				glm::vec2 barycentrics;
+
+				if (IntersectTriangle(origin, direction, &m_Corners[3 * triangle], maxDistance, triangleDistance, barycentrics))
+				{
+					if constexpr (bAnyHit)
+					{
+						return true;
+					}
+
+					maxDistance = triangleDistance;
+
+					hit.Distance = triangleDistance;
+					hit.Triangle = triangle;
+					hit.Barycentrics = barycentrics;
+				}
+			}
+
+			continue;
+		}
+
+		const Node& left = m_Nodes[node.First];
+		const Node& right = m_Nodes[node.First + 1];
+
+		float leftDistance = 0.0f;
+		float rightDistance = 0.0f;
+
+		bool bHitsLeft = IntersectBox(left, origin, inverseDirection, maxDistance, leftDistance);
+		bool bHitsRight = IntersectBox(right, origin, inverseDirection, maxDistance, rightDistance);
+
+		// Closer child is visited first, so the farther one is often culled by the hit found in it
+		if (bHitsLeft && bHitsRight)
+		{
+			bool bLeftIsCloser = leftDistance <= rightDistance;
+			stack[stackSize++] = bLeftIsCloser ? node.First + 1 : node.First;
+			stack[stackSize++] = bLeftIsCloser ? node.First : node.First + 1;
+		}
+		else if (bHitsLeft)
+		{
+			stack[stackSize++] = node.First;
+		}
+		else if (bHitsRight)
+		{
+			stack[stackSize++] = node.First + 1;
+		}
+	}
+
+	return hit.IsValid();
+}
+
+bool TriangleBVH::IntersectBox(const Node& node, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance, float& distance)
+{
+	glm::vec3 first = (node.Min - origin) * inverseDirection;
+	glm::vec3 second = (node.Max - origin) * inverseDirection;
+
+	glm::vec3 entries = glm::min(first, second);
+	glm::vec3 exits = glm::max(first, second);
+
+	float enter = glm::max(glm::max(entries.x, entries.y), glm::max(entries.z, 0.0f));
+	float exit = glm::min(glm::min(exits.x, exits.y), glm::min(exits.z, maxDistance));
+
+	distance = enter;
+	return enter <= exit;
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Core/Ed.h"
+#include <cfloat>
+
+// Distance is along the ray direction, barycentrics are weights of the second and the third corner
+struct TriangleHit
+{
+	float Distance = FLT_MAX;
+	uint32_t Triangle = UINT32_MAX;
+	glm::vec2 Barycentrics = glm::vec2(0.0f);
+
+	bool IsValid() const { return Triangle != UINT32_MAX; }
+};
+
+// Bounding volume hierarchy over triangles built with binned surface area heuristic, used by bakers to trace rays on the CPU.
+// Triangles are hit from both sides, building and tracing don't depend on threads, so results are the same on every run
+class TriangleBVH
+{
+public:
+	static const uint32_t MaxLeafSize = 4;
+
+	// Three corners per triangle, hits refer to triangles in this order
+	void Build(const std::vector<glm::vec3>& corners);
+
+	// Closest hit closer than max distance
+	bool Intersect(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, TriangleHit& hit) const;
+	// Any hit closer than max distance, cheaper than looking for the closest one
+	bool IsOccluded(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const;
+
+	uint32_t GetTrianglesCount() const;
+	uint32_t GetNodesCount() const;
+
+	glm::vec3 GetBoundsMin() const;
+	glm::vec3 GetBoundsMax() const;
+
+private:
+	static const uint32_t BinsCount = 12;
+	static const uint32_t MaxDepth = 64;
+
+	// Inner nodes have count of zero and children at first and first + 1, leaves hold count triangles starting at first
+	struct Node
+	{
+		glm::vec3 Min = glm::vec3(FLT_MAX);
+		uint32_t First = 0;
+		glm::vec3 Max = glm::vec3(-FLT_MAX);
+		uint32_t Count = 0;
+	};
+
+	void Subdivide(uint32_t nodeIndex, uint32_t depth, const std::vector<glm::vec3>& centroids);
+	void UpdateBounds(Node& node) const;
+
+	template<bool bAnyHit>
+	bool Traverse(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, TriangleHit& hit) const;
+
+	static bool IntersectBox(const Node& node, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance, float& distance);
+
+private:
+	std::vector<Node> m_Nodes;
+
+	// Triangle order of the corners passed to Build, leaves index into it
+	std::vector<uint32_t> m_Triangles;
+	std::vector<glm::vec3> m_Corners;
+};
\ No newline at end of file
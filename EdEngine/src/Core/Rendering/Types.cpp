@@ -43,8 +43,24 @@ uint32_t Types::GetPixelSize(PixelFormat format)
 	case PixelFormat::RG16F:      return 2 * sizeof(uint16_t);
 	case PixelFormat::RG32F:      return 2 * sizeof(uint32_t);
 	case PixelFormat::R11G11B10F: return     sizeof(uint32_t);
+	case PixelFormat::Depth:      return     sizeof(uint32_t);
+	case PixelFormat::DepthStencil: return   sizeof(uint32_t);
 	default:
 		ED_LOG(Types, warn, "Cannot calculate pixel size")
 	}
 	return 0;
 }
+
+uint32_t Types::GetShaderDataTypeSize(ShaderDataType type)
+{
+	switch (type)
+	{
+	case ShaderDataType::Float:  return     sizeof(float);
+	case ShaderDataType::Float2: return 2 * sizeof(float);
+	case ShaderDataType::Float3: return 3 * sizeof(float);
+	case ShaderDataType::Float4: return 4 * sizeof(float);
+	default:
+		ED_LOG(Types, warn, "Cannot calculate shader data type size")
+	}
+	return 0;
+}
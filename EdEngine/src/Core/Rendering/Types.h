@@ -115,6 +115,7 @@ enum class RenderTarget
 	GNormal,
 	GRougnessMetalicEmission,
 	GVelocity,
+	GLightmap,
 	GDepth,
 
 	SSAO,
@@ -136,9 +137,17 @@ enum class DrawMode
 	LineStrip
 };
 
+// Null backend runs everything except the graphics API, used for headless runs
+enum class RenderingAPI
+{
+	OpenGL,
+	Null
+};
+
 class Types
 {
 public:
 	static uint32_t GetChannelNumber(PixelFormat format);
 	static uint32_t GetPixelSize(PixelFormat format);
+	static uint32_t GetShaderDataTypeSize(ShaderDataType type);
 };
\ No newline at end of file
@@ -2,11 +2,26 @@
 
 #include "Components/Component.h"
 #include "Objects/Actor.h"
+#include <algorithm>
 
 Scene::Scene(std::string name) : Super(name)
 {
 }
 
+Scene::~Scene()
+{
+    // Actors and components can outlive the scene, they shouldn't keep pointing into its hierarchy
+    for (const std::shared_ptr<Actor>& actor : m_Actors)
+    {
+        for (const std::shared_ptr<Component>& component : actor->GetAllComponents())
+        {
+            component->SetTransformNode(nullptr, TransformHierarchy::InvalidNode);
+        }
+
+        actor->SetScene(nullptr);
+    }
+}
+
 void Scene::Initialize()
 {
 	for (const std::shared_ptr<Actor>& actor : m_Actors)
@@ -26,16 +41,55 @@ void Scene::Initialize()
 
     for (const std::shared_ptr<Actor>& actor : m_Actors)
     {
+        actor->SetScene(this);
         actor->Intialize();
+
+        for (const std::shared_ptr<Component>& component : actor->GetComponents())
+        {
+            CreateTransformNodes(component);
+        }
+    }
+
+    m_Transforms.Update();
+}
+
+void Scene::AddActor(std::shared_ptr<Actor> actor)
+{
+    m_Actors.push_back(actor);
+    actor->SetScene(this);
+
+    for (const std::shared_ptr<Component>& component : actor->GetComponents())
+    {
+        OnComponentAdded(component);
     }
 }
 
+void Scene::RemoveActor(std::shared_ptr<Actor> actor)
+{
+    auto it = std::find(m_Actors.begin(), m_Actors.end(), actor);
+    if (it == m_Actors.end())
+    {
+        return;
+    }
+
+    for (const std::shared_ptr<Component>& component : actor->GetComponents())
+    {
+        OnComponentRemoved(component);
+    }
+
+    // Destroys root node of the actor, nodes of its components are already gone
+    actor->SetScene(nullptr);
+    m_Actors.erase(it);
+}
+
 void Scene::Update(float deltaSeconds)
 {
     for (std::shared_ptr<Actor> actor : m_Actors)
     {
         actor->Update(deltaSeconds);
     }
+
+    m_Transforms.Update();
 }
 
 std::vector<std::shared_ptr<Component>> Scene::GetAllComponents() const
@@ -52,6 +106,91 @@ std::vector<std::shared_ptr<Component>> Scene::GetAllComponents() const
     return components;
 }
 
+void Scene::SubscribeToComponentAdded(ComponentCallback callback)
+{
+    m_ComponentAddedSubscribers.push_back(callback);
+}
+
+void Scene::SubscribeToComponentRemoved(ComponentCallback callback)
+{
+    m_ComponentRemovedSubscribers.push_back(callback);
+}
+
+void Scene::OnComponentAdded(std::shared_ptr<Component> component)
+{
+    CreateTransformNodes(component);
+
+    for (ComponentCallback& callback : m_ComponentAddedSubscribers)
+    {
+        callback(component);
+        for (const std::shared_ptr<Component>& child : component->GetAllChildren())
+        {
+            callback(child);
+        }
+    }
+}
+
+void Scene::OnComponentRemoved(std::shared_ptr<Component> component)
+{
+    for (ComponentCallback& callback : m_ComponentRemovedSubscribers)
+    {
+        callback(component);
+        for (const std::shared_ptr<Component>& child : component->GetAllChildren())
+        {
+            callback(child);
+        }
+    }
+
+    DestroyTransformNodes(component);
+}
+
+TransformHierarchy& Scene::GetTransforms()
+{
+    return m_Transforms;
+}
+
+void Scene::CreateTransformNodes(const std::shared_ptr<Component>& component)
+{
+    std::vector<std::shared_ptr<Component>> components = component->GetAllChildren();
+    components.insert(components.begin(), component);
+
+    // Parents are listed before their children, so their nodes already exist. Parent is picked the same way GetWorldTransform walks the chain
+    for (const std::shared_ptr<Component>& current : components)
+    {
+        if (current->GetTransformNode() != TransformHierarchy::InvalidNode)
+        {
+            continue;
+        }
+
+        TransformNode parent = TransformHierarchy::InvalidNode;
+        if (std::shared_ptr<Component> owner = current->GetOwnerComponent())
+        {
+            parent = owner->GetTransformNode();
+        }
+        else if (std::shared_ptr<Actor> owner = current->GetOwnerActor())
+        {
+            parent = owner->GetTransformNode();
+        }
+
+        current->SetTransformNode(&m_Transforms, m_Transforms.Create(parent, current->GetRelativeTransform()));
+    }
+}
+
+void Scene::DestroyTransformNodes(const std::shared_ptr<Component>& component)
+{
+    std::vector<std::shared_ptr<Component>> components = component->GetAllChildren();
+    components.insert(components.begin(), component);
+
+    for (auto it = components.rbegin(); it != components.rend(); ++it)
+    {
+        if ((*it)->GetTransformNode() != TransformHierarchy::InvalidNode)
+        {
+            m_Transforms.Destroy((*it)->GetTransformNode());
+            (*it)->SetTransformNode(nullptr, TransformHierarchy::InvalidNode);
+        }
+    }
+}
+
 std::shared_ptr<PlayerActor> Scene::GetPlayerActor() const
 {
     return m_PlayerActor;
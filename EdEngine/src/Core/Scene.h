@@ -3,38 +3,59 @@
 #include "Core/Ed.h"
 #include "Objects/Actor.h"
 #include "Objects/PlayerActor.h"
+#include <functional>
 
 ED_CLASS(Scene) : public GameObject
 {
     ED_CLASS_BODY(Scene, GameObject)
 public:
+    using ComponentCallback = std::function<void(const std::shared_ptr<class Component>&)>;
+
     Scene(std::string name = "New Scene");
+    virtual ~Scene() override;
     
-    void AddActor(std::shared_ptr<Actor> actor) 
-    {
-        m_Actors.push_back(actor);
-    }
+    void AddActor(std::shared_ptr<Actor> actor);
+    void RemoveActor(std::shared_ptr<Actor> actor);
     
     template <class T>
     std::shared_ptr<T> CreateActor(const std::string& name)
     {
         std::shared_ptr<T> actor = std::make_shared<T>(name);
-        m_Actors.push_back(actor);
+        AddActor(actor);
         return actor;
     }
     
     virtual void Initialize();
     
+    // Updates actors and components, then world transforms of everything that moved
     virtual void Update(float deltaSeconds);
     
     const std::vector<std::shared_ptr<Actor>>& GetActors() const { return m_Actors; }
     
     std::vector<std::shared_ptr<class Component>> GetAllComponents() const;
+
+    // Called once for every component entering or leaving the scene, children are reported together with their parent
+    void SubscribeToComponentAdded(ComponentCallback callback);
+    void SubscribeToComponentRemoved(ComponentCallback callback);
+
+    // Used by actors and components when something is attached or detached
+    void OnComponentAdded(std::shared_ptr<class Component> component);
+    void OnComponentRemoved(std::shared_ptr<class Component> component);
+
+    TransformHierarchy& GetTransforms();
     
     std::shared_ptr<PlayerActor> GetPlayerActor() const;
     
     virtual void Serialize(Archive& archive) override;
 private:
+    void CreateTransformNodes(const std::shared_ptr<class Component>& component);
+    void DestroyTransformNodes(const std::shared_ptr<class Component>& component);
+private:
+    TransformHierarchy m_Transforms;
+
     std::shared_ptr<PlayerActor> m_PlayerActor;
     std::vector<std::shared_ptr<Actor>> m_Actors; 
+
+    std::vector<ComponentCallback> m_ComponentAddedSubscribers;
+    std::vector<ComponentCallback> m_ComponentRemovedSubscribers;
 };
\ No newline at end of file
@@ -0,0 +1,38 @@
+#include "NullIndexBuffer.h"
+#include "Platform/Rendering/Null/NullRenderingContext.h"
+
+NullIndexBuffer::NullIndexBuffer()
+{
+	++NullRenderingContext::GetResourceStatistics().Buffers;
+}
+
+void NullIndexBuffer::SetData(void* data, BufferUsage usage)
+{
+
+}
+
+void NullIndexBuffer::SetData(void* data, int32_t size, BufferUsage usage)
+{
+	NullResourceStatistics& statistics = NullRenderingContext::GetResourceStatistics();
+	statistics.BuffersMemory -= m_Size;
+	statistics.BuffersMemory += size;
+
+	m_Size = size;
+}
+
+void NullIndexBuffer::SetSubdata(uint32_t offset, uint32_t size, void* data)
+{
+
+}
+
+uint32_t NullIndexBuffer::GetCount()
+{
+	return m_Size / sizeof(uint32_t);
+}
+
+NullIndexBuffer::~NullIndexBuffer()
+{
+	NullResourceStatistics& statistics = NullRenderingContext::GetResourceStatistics();
+	statistics.BuffersMemory -= m_Size;
+	--statistics.Buffers;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Core/Rendering/Buffers/IndexBuffer.h"
+
+class NullIndexBuffer : public IndexBuffer
+{
+public:
+	NullIndexBuffer();
+
+	virtual void SetData(void* data, BufferUsage usage) override;
+	virtual void SetData(void* data, int32_t size, BufferUsage usage) override;
+
+	virtual void SetSubdata(uint32_t offset, uint32_t size, void* data) override;
+
+	virtual uint32_t GetCount() override;
+
+	virtual ~NullIndexBuffer() override;
+private:
+	uint32_t m_Size = 0;
+};
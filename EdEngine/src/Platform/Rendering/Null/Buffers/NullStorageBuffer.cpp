@@ -0,0 +1,38 @@
+#include "NullStorageBuffer.h"
+#include "Platform/Rendering/Null/NullRenderingContext.h"
+
+NullStorageBuffer::NullStorageBuffer()
+{
+	++NullRenderingContext::GetResourceStatistics().Buffers;
+}
+
+void NullStorageBuffer::SetData(void* data, BufferUsage usage)
+{
+
+}
+
+void NullStorageBuffer::SetData(void* data, int32_t size, BufferUsage usage)
+{
+	NullResourceStatistics& statistics = NullRenderingContext::GetResourceStatistics();
+	statistics.BuffersMemory -= m_Size;
+	statistics.BuffersMemory += size;
+
+	m_Size = size;
+}
+
+void NullStorageBuffer::SetSubdata(uint32_t offset, uint32_t size, void* data)
+{
+
+}
+
+uint32_t NullStorageBuffer::GetSize() const
+{
+	return m_Size;
+}
+
+NullStorageBuffer::~NullStorageBuffer()
+{
+	NullResourceStatistics& statistics = NullRenderingContext::GetResourceStatistics();
+	statistics.BuffersMemory -= m_Size;
+	--statistics.Buffers;
+}
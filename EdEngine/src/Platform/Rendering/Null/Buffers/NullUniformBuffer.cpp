@@ -0,0 +1,38 @@
+#include "NullUniformBuffer.h"
+#include "Platform/Rendering/Null/NullRenderingContext.h"
+
+NullUniformBuffer::NullUniformBuffer()
+{
+	++NullRenderingContext::GetResourceStatistics().Buffers;
+}
+
+void NullUniformBuffer::SetData(void* data, BufferUsage usage)
+{
+
+}
+
+void NullUniformBuffer::SetData(void* data, int32_t size, BufferUsage usage)
+{
+	NullResourceStatistics& statistics = NullRenderingContext::GetResourceStatistics();
+	statistics.BuffersMemory -= m_Size;
+	statistics.BuffersMemory += size;
+
+	m_Size = size;
+}
+
+void NullUniformBuffer::SetSubdata(uint32_t offset, uint32_t size, void* data)
+{
+
+}
+
+uint32_t NullUniformBuffer::GetSize() const
+{
+	return m_Size;
+}
+
+NullUniformBuffer::~NullUniformBuffer()
+{
+	NullResourceStatistics& statistics = NullRenderingContext::GetResourceStatistics();
+	statistics.BuffersMemory -= m_Size;
+	--statistics.Buffers;
+}
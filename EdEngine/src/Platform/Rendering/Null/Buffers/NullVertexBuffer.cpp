@@ -0,0 +1,48 @@
+#include "NullVertexBuffer.h"
+#include "Platform/Rendering/Null/NullRenderingContext.h"
+
+NullVertexBuffer::NullVertexBuffer()
+{
+	++NullRenderingContext::GetResourceStatistics().Buffers;
+}
+
+void NullVertexBuffer::SetLayout(const VertexBufferLayout& layout)
+{
+	m_Layout = layout;
+	m_VertexSize = 0;
+	for (const VertexBufferLayoutElement& element : layout.GetElements())
+	{
+		m_VertexSize += Types::GetShaderDataTypeSize(element.Type);
+	}
+}
+
+void NullVertexBuffer::SetData(void* data, BufferUsage usage)
+{
+
+}
+
+void NullVertexBuffer::SetData(void* data, int32_t size, BufferUsage usage)
+{
+	NullResourceStatistics& statistics = NullRenderingContext::GetResourceStatistics();
+	statistics.BuffersMemory -= m_Size;
+	statistics.BuffersMemory += size;
+
+	m_Size = size;
+}
+
+void NullVertexBuffer::SetSubdata(uint32_t offset, uint32_t size, void* data)
+{
+
+}
+
+uint32_t NullVertexBuffer::GetCount() const
+{
+	return m_VertexSize ? m_Size / m_VertexSize : 0;
+}
+
+NullVertexBuffer::~NullVertexBuffer()
+{
+	NullResourceStatistics& statistics = NullRenderingContext::GetResourceStatistics();
+	statistics.BuffersMemory -= m_Size;
+	--statistics.Buffers;
+}
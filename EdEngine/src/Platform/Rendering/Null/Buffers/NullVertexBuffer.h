@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Core/Rendering/Buffers/VertexBuffer.h"
+
+class NullVertexBuffer : public VertexBuffer
+{
+public:
+	NullVertexBuffer();
+
+	virtual void SetLayout(const VertexBufferLayout& layout) override;
+
+	virtual void SetData(void* data, BufferUsage usage) override;
+	virtual void SetData(void* data, int32_t size, BufferUsage usage) override;
+
+	virtual void SetSubdata(uint32_t offset, uint32_t size, void* data) override;
+
+	virtual uint32_t GetCount() const override;
+
+	virtual ~NullVertexBuffer() override;
+private:
+	uint32_t m_Size = 0;
+	uint32_t m_VertexSize = 0;
+};
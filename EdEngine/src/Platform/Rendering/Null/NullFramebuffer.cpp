@@ -0,0 +1,68 @@
+#include "NullFramebuffer.h"
+#include "NullRenderingContext.h"
+#include "Core/Macros.h"
+
+NullFramebuffer::NullFramebuffer(const FramebufferSpecification& specification) : Framebuffer(specification)
+{
+	++NullRenderingContext::GetResourceStatistics().Framebuffers;
+}
+
+// Attachments are kept the same way the OpenGL framebuffer keeps them, so passes see identical sizes and formats
+void NullFramebuffer::AddAttachment(std::shared_ptr<Texture> attachment)
+{
+	if (attachment->GetPixelFormat() == PixelFormat::Depth || attachment->GetPixelFormat() == PixelFormat::DepthStencil)
+	{
+		m_DepthAttachment = attachment;
+	}
+	else
+	{
+		m_Attachments.push_back(attachment);
+	}
+}
+
+void NullFramebuffer::SetAttachment(int32_t index, std::shared_ptr<Texture> attachment, FramebufferSizeAdjustmentMode mode)
+{
+	ED_ASSERT(index < m_Attachments.size(), "SetAttachment can only replace an attachment")
+
+	if (mode == FramebufferSizeAdjustmentMode::ResizeTextureToFramebufferSize)
+	{
+		attachment->Resize(m_Width, m_Height, m_Depth);
+	}
+
+	m_Attachments[index] = attachment;
+
+	if (mode == FramebufferSizeAdjustmentMode::ResizeFramebufferToTexutreSize)
+	{
+		Resize(attachment->GetSize());
+	}
+}
+
+void NullFramebuffer::SetDepthAttachment(std::shared_ptr<Texture> attachment, FramebufferSizeAdjustmentMode mode)
+{
+	if (mode == FramebufferSizeAdjustmentMode::ResizeTextureToFramebufferSize)
+	{
+		attachment->Resize(m_Width, m_Height, m_Depth);
+	}
+
+	m_DepthAttachment = attachment;
+
+	if (mode == FramebufferSizeAdjustmentMode::ResizeFramebufferToTexutreSize)
+	{
+		Resize(attachment->GetSize());
+	}
+}
+
+void NullFramebuffer::CopyAttachment(std::shared_ptr<Framebuffer> framebuffer, int32_t attachment)
+{
+
+}
+
+void NullFramebuffer::CopyDepthAttachment(std::shared_ptr<Framebuffer> framebuffer)
+{
+
+}
+
+NullFramebuffer::~NullFramebuffer()
+{
+	--NullRenderingContext::GetResourceStatistics().Framebuffers;
+}
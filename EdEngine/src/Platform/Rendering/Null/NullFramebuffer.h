@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Core/Rendering/Framebuffer.h"
+
+class NullFramebuffer : public Framebuffer
+{
+public:
+	NullFramebuffer(const FramebufferSpecification& specification);
+
+	virtual void AddAttachment(std::shared_ptr<Texture> attachment) override;
+
+	virtual void SetAttachment(int32_t index, std::shared_ptr<Texture> attachment, FramebufferSizeAdjustmentMode mode) override;
+	virtual void SetDepthAttachment(std::shared_ptr<Texture> attachment, FramebufferSizeAdjustmentMode mode) override;
+
+	virtual void CopyAttachment(std::shared_ptr<Framebuffer> framebuffer, int32_t attachment) override;
+	virtual void CopyDepthAttachment(std::shared_ptr<Framebuffer> framebuffer) override;
+
+	virtual ~NullFramebuffer() override;
+};
@@ -0,0 +1,32 @@
+#include "NullGPUTimer.h"
+
+bool NullGPUTimer::BeginFrame(std::vector<uint64_t>& timestamps)
+{
+	m_CurrentSet = (m_CurrentSet + 1) % FramesInFlight;
+
+	// Nothing is executed, so results are always available
+	timestamps = m_Sets[m_CurrentSet];
+	m_Sets[m_CurrentSet].clear();
+
+	return !timestamps.empty();
+}
+
+uint32_t NullGPUTimer::WriteTimestamp()
+{
+	m_Time += m_TimestampStep;
+
+	std::vector<uint64_t>& set = m_Sets[m_CurrentSet];
+	set.push_back(m_Time);
+
+	return set.size() - 1;
+}
+
+void NullGPUTimer::SetTimestampStep(uint64_t nanoseconds)
+{
+	m_TimestampStep = nanoseconds;
+}
+
+uint64_t NullGPUTimer::GetTimestampStep() const
+{
+	return m_TimestampStep;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Core/Rendering/GPUTimer.h"
+
+// Reports synthetic timestamps, every timestamp is TimestampStep nanoseconds after the previous one
+class NullGPUTimer : public GPUTimer
+{
+public:
+	virtual bool BeginFrame(std::vector<uint64_t>& timestamps) override;
+	virtual uint32_t WriteTimestamp() override;
+
+	void SetTimestampStep(uint64_t nanoseconds);
+	uint64_t GetTimestampStep() const;
+private:
+	std::vector<uint64_t> m_Sets[FramesInFlight];
+	uint32_t m_CurrentSet = 0;
+
+	uint64_t m_Time = 0;
+	uint64_t m_TimestampStep = 1000000;
+};
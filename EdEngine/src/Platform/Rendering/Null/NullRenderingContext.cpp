@@ -0,0 +1,387 @@
+#include "NullRenderingContext.h"
+#include "Core/Rendering/Shader.h"
+#include <glm/glm.hpp>
+
+void NullRenderingContext::SetDefaultFramebuffer()
+{
+	++m_FrameStatistics.FramebufferBinds;
+}
+
+void NullRenderingContext::SetFramebuffer(std::shared_ptr<Framebuffer> framebuffer)
+{
+	++m_FrameStatistics.FramebufferBinds;
+}
+
+void NullRenderingContext::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::SetVertexBuffer(std::shared_ptr<VertexBuffer> buffer)
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::SetIndexBuffer(std::shared_ptr<IndexBuffer> buffer)
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::SetStorageBuffer(uint32_t binding, std::shared_ptr<StorageBuffer> buffer)
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::SetUniformBuffer(uint32_t binding, std::shared_ptr<UniformBuffer> buffer)
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::SetShader(std::shared_ptr<Shader> shader)
+{
+	CountStateChange();
+
+	m_Shader = shader;
+}
+
+const std::shared_ptr<Shader>& NullRenderingContext::GetShader() const
+{
+	return m_Shader;
+}
+
+void NullRenderingContext::SetPipelineState(std::shared_ptr<PipelineState> state)
+{
+	++m_StateStatistics.PipelineStateChanges;
+}
+
+void NullRenderingContext::SetShaderDataTexture(const std::string& name, std::shared_ptr<Texture> texture)
+{
+	SetShaderDataTexture(m_Shader ? m_Shader->GetUniformLocation(name) : -1, texture);
+}
+
+void NullRenderingContext::SetShaderDataImage(const std::string& name, std::shared_ptr<Texture> texture)
+{
+	SetShaderDataImage(m_Shader ? m_Shader->GetUniformLocation(name) : -1, texture);
+}
+
+void NullRenderingContext::SetShaderDataInt(const std::string& name, int32_t value)
+{
+	SetShaderDataInt(m_Shader ? m_Shader->GetUniformLocation(name) : -1, value);
+}
+
+void NullRenderingContext::SetShaderDataFloat(const std::string& name, float value)
+{
+	SetShaderDataFloat(m_Shader ? m_Shader->GetUniformLocation(name) : -1, value);
+}
+
+void NullRenderingContext::SetShaderDataFloat2(const std::string& name, glm::vec2 vector)
+{
+	SetShaderDataFloat2(m_Shader ? m_Shader->GetUniformLocation(name) : -1, vector);
+}
+
+void NullRenderingContext::SetShaderDataFloat2(const std::string& name, float x, float y)
+{
+	SetShaderDataFloat2(m_Shader ? m_Shader->GetUniformLocation(name) : -1, glm::vec2(x, y));
+}
+
+void NullRenderingContext::SetShaderDataFloat3(const std::string& name, float x, float y, float z)
+{
+	SetShaderDataFloat3(m_Shader ? m_Shader->GetUniformLocation(name) : -1, glm::vec3(x, y, z));
+}
+
+void NullRenderingContext::SetShaderDataFloat3(const std::string& name, glm::vec3 vector)
+{
+	SetShaderDataFloat3(m_Shader ? m_Shader->GetUniformLocation(name) : -1, vector);
+}
+
+void NullRenderingContext::SetShaderDataFloat4(const std::string& name, float r, float g, float b, float a)
+{
+	SetShaderDataFloat4(m_Shader ? m_Shader->GetUniformLocation(name) : -1, glm::vec4(r, g, b, a));
+}
+
+void NullRenderingContext::SetShaderDataFloat4(const std::string& name, glm::vec4 vector)
+{
+	SetShaderDataFloat4(m_Shader ? m_Shader->GetUniformLocation(name) : -1, vector);
+}
+
+void NullRenderingContext::SetShaderDataMat4(const std::string& name, const glm::mat4& matrix)
+{
+	SetShaderDataMat4(m_Shader ? m_Shader->GetUniformLocation(name) : -1, matrix);
+}
+
+void NullRenderingContext::SetShaderDataMat3(const std::string& name, const glm::mat3& matrix)
+{
+	SetShaderDataMat3(m_Shader ? m_Shader->GetUniformLocation(name) : -1, matrix);
+}
+
+void NullRenderingContext::SetShaderDataBool(const std::string& name, bool value)
+{
+	SetShaderDataBool(m_Shader ? m_Shader->GetUniformLocation(name) : -1, value);
+}
+
+void NullRenderingContext::SetShaderDataTexture(const char* name, std::shared_ptr<Texture> texture)
+{
+	SetShaderDataTexture(m_Shader ? m_Shader->GetUniformLocation(name) : -1, texture);
+}
+
+void NullRenderingContext::SetShaderDataImage(const char* name, std::shared_ptr<Texture> texture)
+{
+	SetShaderDataImage(m_Shader ? m_Shader->GetUniformLocation(name) : -1, texture);
+}
+
+void NullRenderingContext::SetShaderDataInt(const char* name, int32_t value)
+{
+	SetShaderDataInt(m_Shader ? m_Shader->GetUniformLocation(name) : -1, value);
+}
+
+void NullRenderingContext::SetShaderDataFloat(const char* name, float value)
+{
+	SetShaderDataFloat(m_Shader ? m_Shader->GetUniformLocation(name) : -1, value);
+}
+
+void NullRenderingContext::SetShaderDataFloat2(const char* name, glm::vec2 vector)
+{
+	SetShaderDataFloat2(m_Shader ? m_Shader->GetUniformLocation(name) : -1, vector);
+}
+
+void NullRenderingContext::SetShaderDataFloat2(const char* name, float x, float y)
+{
+	SetShaderDataFloat2(m_Shader ? m_Shader->GetUniformLocation(name) : -1, glm::vec2(x, y));
+}
+
+void NullRenderingContext::SetShaderDataFloat3(const char* name, float x, float y, float z)
+{
+	SetShaderDataFloat3(m_Shader ? m_Shader->GetUniformLocation(name) : -1, glm::vec3(x, y, z));
+}
+
+void NullRenderingContext::SetShaderDataFloat3(const char* name, glm::vec3 vector)
+{
+	SetShaderDataFloat3(m_Shader ? m_Shader->GetUniformLocation(name) : -1, vector);
+}
+
+void NullRenderingContext::SetShaderDataFloat4(const char* name, float r, float g, float b, float a)
+{
+	SetShaderDataFloat4(m_Shader ? m_Shader->GetUniformLocation(name) : -1, glm::vec4(r, g, b, a));
+}
+
+void NullRenderingContext::SetShaderDataFloat4(const char* name, glm::vec4 vector)
+{
+	SetShaderDataFloat4(m_Shader ? m_Shader->GetUniformLocation(name) : -1, vector);
+}
+
+void NullRenderingContext::SetShaderDataMat4(const char* name, const glm::mat4& matrix)
+{
+	SetShaderDataMat4(m_Shader ? m_Shader->GetUniformLocation(name) : -1, matrix);
+}
+
+void NullRenderingContext::SetShaderDataMat3(const char* name, const glm::mat3& matrix)
+{
+	SetShaderDataMat3(m_Shader ? m_Shader->GetUniformLocation(name) : -1, matrix);
+}
+
+void NullRenderingContext::SetShaderDataBool(const char* name, bool value)
+{
+	SetShaderDataBool(m_Shader ? m_Shader->GetUniformLocation(name) : -1, value);
+}
+
+void NullRenderingContext::SetShaderDataTexture(int32_t location, std::shared_ptr<Texture> texture)
+{
+	CountUniformUpload();
+}
+
+void NullRenderingContext::SetShaderDataImage(int32_t location, std::shared_ptr<Texture> texture)
+{
+	CountUniformUpload();
+}
+
+void NullRenderingContext::SetShaderDataInt(int32_t location, int32_t value)
+{
+	CountUniformUpload();
+}
+
+void NullRenderingContext::SetShaderDataFloat(int32_t location, float value)
+{
+	CountUniformUpload();
+}
+
+void NullRenderingContext::SetShaderDataFloat2(int32_t location, glm::vec2 vector)
+{
+	CountUniformUpload();
+}
+
+void NullRenderingContext::SetShaderDataFloat3(int32_t location, glm::vec3 vector)
+{
+	CountUniformUpload();
+}
+
+void NullRenderingContext::SetShaderDataFloat4(int32_t location, glm::vec4 vector)
+{
+	CountUniformUpload();
+}
+
+void NullRenderingContext::SetShaderDataMat4(int32_t location, const glm::mat4& matrix)
+{
+	CountUniformUpload();
+}
+
+void NullRenderingContext::SetShaderDataMat3(int32_t location, const glm::mat3& matrix)
+{
+	CountUniformUpload();
+}
+
+void NullRenderingContext::SetShaderDataBool(int32_t location, bool value)
+{
+	CountUniformUpload();
+}
+
+void NullRenderingContext::RunComputeShader(uint32_t sizeX, uint32_t sizeY, uint32_t sizeZ)
+{
+	++m_FrameStatistics.ComputeDispatches;
+}
+
+void NullRenderingContext::Barier(BarrierType type)
+{
+	++m_FrameStatistics.Barriers;
+}
+
+void NullRenderingContext::Draw(DrawMode mode)
+{
+	++m_FrameStatistics.Draws;
+	++m_FrameStatistics.Instances;
+}
+
+void NullRenderingContext::DrawInstanced(uint32_t instancesCount, uint32_t firstInstance, DrawMode mode)
+{
+	++m_FrameStatistics.Draws;
+	m_FrameStatistics.Instances += instancesCount;
+}
+
+void NullRenderingContext::EnableBlending(BlendFactor source, BlendFactor destination)
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::SetBlending(BlendFactor source, BlendFactor destination)
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::DisableBlending()
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::EnableDethTest(DepthTestFunction function)
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::SetDethTestFunction(DepthTestFunction function)
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::DisableDethTest()
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::EnableFaceCulling()
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::EnableFaceCulling(Face face)
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::SetCullingFace(Face face)
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::DisableFaceCulling()
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::ClearDepthTarget()
+{
+	++m_FrameStatistics.Clears;
+}
+
+void NullRenderingContext::ClearDepthTarget(std::shared_ptr<Texture> target, glm::u32vec3 offset, glm::u32vec3 size)
+{
+	++m_FrameStatistics.Clears;
+}
+
+void NullRenderingContext::CopyTexture(std::shared_ptr<Texture> source, std::shared_ptr<Texture> destination, glm::u32vec3 offset, glm::u32vec3 size)
+{
+	++m_FrameStatistics.Copies;
+}
+
+void NullRenderingContext::ClearColorTarget()
+{
+	++m_FrameStatistics.Clears;
+}
+
+void NullRenderingContext::SetClearColor(float r, float g, float b, float a)
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::SetClearColor(glm::vec4 color)
+{
+	CountStateChange();
+}
+
+void NullRenderingContext::BeginUIFrame()
+{
+
+}
+
+void NullRenderingContext::EndUIFrame()
+{
+
+}
+
+void NullRenderingContext::SwapBuffers()
+{
+
+}
+
+const RenderingStateStatistics& NullRenderingContext::GetStatistics() const
+{
+	return m_LastFrameStateStatistics;
+}
+
+void NullRenderingContext::ResetStatistics()
+{
+	m_LastFrameStateStatistics = m_StateStatistics;
+	m_StateStatistics = RenderingStateStatistics();
+
+	m_LastFrameStatistics = m_FrameStatistics;
+	m_FrameStatistics = NullFrameStatistics();
+}
+
+const NullFrameStatistics& NullRenderingContext::GetFrameStatistics() const
+{
+	return m_LastFrameStatistics;
+}
+
+NullResourceStatistics& NullRenderingContext::GetResourceStatistics()
+{
+	static NullResourceStatistics statistics;
+	return statistics;
+}
+
+void NullRenderingContext::CountUniformUpload()
+{
+	++m_FrameStatistics.UniformUploads;
+}
+
+void NullRenderingContext::CountStateChange()
+{
+	++m_StateStatistics.StateChanges;
+}
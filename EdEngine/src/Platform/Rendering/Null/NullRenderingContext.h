@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Core/Rendering/RenderingContex.h"
+
+// Objects alive on the null backend and the memory they would take on the GPU
+struct NullResourceStatistics
+{
+	uint32_t Textures = 0;
+	uint32_t Framebuffers = 0;
+	uint32_t Buffers = 0;
+	uint32_t Shaders = 0;
+
+	uint64_t TexturesMemory = 0;
+	uint64_t BuffersMemory = 0;
+};
+
+// Work submitted during a frame
+struct NullFrameStatistics
+{
+	uint32_t Draws = 0;
+	uint32_t Instances = 0;
+	uint32_t ComputeDispatches = 0;
+	uint32_t Barriers = 0;
+	uint32_t FramebufferBinds = 0;
+	uint32_t Clears = 0;
+	uint32_t Copies = 0;
+	uint32_t UniformUploads = 0;
+};
+
+// Accepts every call without touching a graphics API, only counts what was submitted
+class NullRenderingContext : public RenderingContext
+{
+public:
+	virtual void SetDefaultFramebuffer() override;
+	virtual void SetFramebuffer(std::shared_ptr<Framebuffer> framebuffer) override;
+	virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+
+	virtual void SetVertexBuffer(std::shared_ptr<VertexBuffer> buffer) override;
+
+	virtual void SetIndexBuffer(std::shared_ptr<IndexBuffer> buffer) override;
+
+	virtual void SetStorageBuffer(uint32_t binding, std::shared_ptr<StorageBuffer> buffer) override;
+	virtual void SetUniformBuffer(uint32_t binding, std::shared_ptr<UniformBuffer> buffer) override;
+
+	virtual void SetShader(std::shared_ptr<Shader> shader) override;
+	virtual const std::shared_ptr<Shader>& GetShader() const override;
+
+	virtual void SetPipelineState(std::shared_ptr<PipelineState> state) override;
+
+	virtual void SetShaderDataTexture(const std::string& name, std::shared_ptr<Texture> texture) override;
+	virtual void SetShaderDataImage(const std::string& name, std::shared_ptr<Texture> texture) override;
+	virtual void SetShaderDataInt(const std::string& name, int32_t value) override;
+	virtual void SetShaderDataFloat(const std::string& name, float value) override;
+	virtual void SetShaderDataFloat2(const std::string& name, glm::vec2 vector) override;
+	virtual void SetShaderDataFloat2(const std::string& name, float x, float y) override;
+	virtual void SetShaderDataFloat3(const std::string& name, float x, float y, float z) override;
+	virtual void SetShaderDataFloat3(const std::string& name, glm::vec3 vector) override;
+	virtual void SetShaderDataFloat4(const std::string& name, float r, float g, float b, float a) override;
+	virtual void SetShaderDataFloat4(const std::string& name, glm::vec4 vector) override;
+	virtual void SetShaderDataMat4(const std::string& name, const glm::mat4& matrix) override;
+	virtual void SetShaderDataMat3(const std::string& name, const glm::mat3& matrix) override;
+	virtual void SetShaderDataBool(const std::string& name, bool value) override;
+
+	virtual void SetShaderDataTexture(const char* name, std::shared_ptr<Texture> texture) override;
+	virtual void SetShaderDataImage(const char* name, std::shared_ptr<Texture> texture) override;
+	virtual void SetShaderDataInt(const char* name, int32_t value) override;
+	virtual void SetShaderDataFloat(const char* name, float value) override;
+	virtual void SetShaderDataFloat2(const char* name, glm::vec2 vector) override;
+	virtual void SetShaderDataFloat2(const char* name, float x, float y) override;
+	virtual void SetShaderDataFloat3(const char* name, float x, float y, float z) override;
+	virtual void SetShaderDataFloat3(const char* name, glm::vec3 vector) override;
+	virtual void SetShaderDataFloat4(const char* name, float r, float g, float b, float a) override;
+	virtual void SetShaderDataFloat4(const char* name, glm::vec4 vector) override;
+	virtual void SetShaderDataMat4(const char* name, const glm::mat4& matrix) override;
+	virtual void SetShaderDataMat3(const char* name, const glm::mat3& matrix) override;
+	virtual void SetShaderDataBool(const char* name, bool value) override;
+
+	virtual void SetShaderDataTexture(int32_t location, std::shared_ptr<Texture> texture) override;
+	virtual void SetShaderDataImage(int32_t location, std::shared_ptr<Texture> texture) override;
+	virtual void SetShaderDataInt(int32_t location, int32_t value) override;
+	virtual void SetShaderDataFloat(int32_t location, float value) override;
+	virtual void SetShaderDataFloat2(int32_t location, glm::vec2 vector) override;
+	virtual void SetShaderDataFloat3(int32_t location, glm::vec3 vector) override;
+	virtual void SetShaderDataFloat4(int32_t location, glm::vec4 vector) override;
+	virtual void SetShaderDataMat4(int32_t location, const glm::mat4& matrix) override;
+	virtual void SetShaderDataMat3(int32_t location, const glm::mat3& matrix) override;
+	virtual void SetShaderDataBool(int32_t location, bool value) override;
+
+	virtual void RunComputeShader(uint32_t sizeX, uint32_t sizeY, uint32_t sizeZ) override;
+	virtual void Barier(BarrierType type) override;
+
+	virtual void Draw(DrawMode mode = DrawMode::Triangles) override;
+	virtual void DrawInstanced(uint32_t instancesCount, uint32_t firstInstance = 0, DrawMode mode = DrawMode::Triangles) override;
+
+	virtual void EnableBlending(BlendFactor source, BlendFactor destination) override;
+	virtual void SetBlending(BlendFactor source, BlendFactor destination) override;
+	virtual void DisableBlending() override;
+
+	virtual void EnableDethTest(DepthTestFunction function) override;
+	virtual void SetDethTestFunction(DepthTestFunction function) override;
+	virtual void DisableDethTest() override;
+
+	virtual void EnableFaceCulling() override;
+	virtual void EnableFaceCulling(Face face) override;
+	virtual void SetCullingFace(Face face) override;
+	virtual void DisableFaceCulling() override;
+
+	virtual void ClearDepthTarget() override;
+	virtual void ClearDepthTarget(std::shared_ptr<Texture> target, glm::u32vec3 offset, glm::u32vec3 size) override;
+	virtual void CopyTexture(std::shared_ptr<Texture> source, std::shared_ptr<Texture> destination, glm::u32vec3 offset, glm::u32vec3 size) override;
+	virtual void ClearColorTarget() override;
+	virtual void SetClearColor(float r, float g, float b, float a) override;
+	virtual void SetClearColor(glm::vec4 color) override;
+
+	virtual void BeginUIFrame() override;
+	virtual void EndUIFrame() override;
+
+	virtual void SwapBuffers() override;
+
+	// Nothing is cached, so every state change counts as one that reached the API
+	virtual const RenderingStateStatistics& GetStatistics() const override;
+	virtual void ResetStatistics() override;
+
+	// Statistics of the last finished frame, rotated by ResetStatistics
+	const NullFrameStatistics& GetFrameStatistics() const;
+
+	// Shared by every null object, they update it when created, resized or destroyed
+	static NullResourceStatistics& GetResourceStatistics();
+
+private:
+	void CountUniformUpload();
+	void CountStateChange();
+
+private:
+	std::shared_ptr<Shader> m_Shader;
+
+	RenderingStateStatistics m_StateStatistics;
+	RenderingStateStatistics m_LastFrameStateStatistics;
+
+	NullFrameStatistics m_FrameStatistics;
+	NullFrameStatistics m_LastFrameStatistics;
+};
@@ -0,0 +1,44 @@
+#include "NullShader.h"
+#include "NullRenderingContext.h"
+
+NullShader::NullShader()
+{
+	++NullRenderingContext::GetResourceStatistics().Shaders;
+}
+
+void NullShader::SetShaderCode(ShaderType type, const std::string& code)
+{
+	++m_StagesCount;
+}
+
+int32_t NullShader::GetUniformLocation(std::string_view name) const
+{
+	std::lock_guard lock(m_UniformLocationsMutex);
+
+	auto it = m_UniformLocations.find(name);
+	if (it != m_UniformLocations.end())
+	{
+		return it->second;
+	}
+
+	int32_t location = m_UniformLocations.size();
+	m_UniformLocations.emplace(std::string(name), location);
+
+	return location;
+}
+
+uint32_t NullShader::GetStagesCount() const
+{
+	return m_StagesCount;
+}
+
+uint32_t NullShader::GetUniformsCount() const
+{
+	std::lock_guard lock(m_UniformLocationsMutex);
+	return m_UniformLocations.size();
+}
+
+NullShader::~NullShader()
+{
+	--NullRenderingContext::GetResourceStatistics().Shaders;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Core/Rendering/Shader.h"
+#include <mutex>
+#include <unordered_map>
+
+class NullShader : public Shader
+{
+public:
+	NullShader();
+
+	virtual void SetShaderCode(ShaderType type, const std::string& code) override;
+
+	// Every name gets its own location the first time it's asked for, so location based caches behave like with a linked program
+	virtual int32_t GetUniformLocation(std::string_view name) const override;
+
+	uint32_t GetStagesCount() const;
+	uint32_t GetUniformsCount() const;
+
+	virtual ~NullShader() override;
+private:
+	struct UniformNameHash
+	{
+		using is_transparent = void;
+
+		size_t operator()(std::string_view name) const
+		{
+			return std::hash<std::string_view>{}(name);
+		}
+	};
+
+	uint32_t m_StagesCount = 0;
+
+	// Passes recorded on worker threads look up locations concurrently
+	mutable std::mutex m_UniformLocationsMutex;
+	mutable std::unordered_map<std::string, int32_t, UniformNameHash, std::equal_to<>> m_UniformLocations;
+};
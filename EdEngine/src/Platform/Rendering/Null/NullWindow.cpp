@@ -0,0 +1,66 @@
+#include "NullWindow.h"
+#include "NullRenderingContext.h"
+#include "Core/Macros.h"
+
+NullWindow::NullWindow(WindowSpecification specification) : Window(specification)
+{
+	m_Context = std::make_shared<NullRenderingContext>();
+
+	ED_LOG(Window, info, "Created headless window {}x{}", m_Width, m_Height)
+}
+
+void NullWindow::Update()
+{
+
+}
+
+bool NullWindow::IsRunning()
+{
+	return m_bIsRunning;
+}
+
+void NullWindow::Resize(int32_t width, int32_t height)
+{
+	m_Width = width;
+	m_Height = height;
+}
+
+glm::vec2 NullWindow::GetMousePosition()
+{
+	return glm::vec2(0.0f);
+}
+
+glm::vec2 NullWindow::GetMousePositionNormalized()
+{
+	return glm::vec2(0.0f);
+}
+
+void NullWindow::Move(glm::vec2 delta)
+{
+
+}
+
+void* NullWindow::GetNativeWindow()
+{
+	return nullptr;
+}
+
+std::shared_ptr<RenderingContext> NullWindow::GetContext()
+{
+	return m_Context;
+}
+
+void NullWindow::Close()
+{
+	if (m_bIsRunning)
+	{
+		m_bIsRunning = false;
+
+		ED_LOG(Window, info, "Window is closed")
+	}
+}
+
+NullWindow::~NullWindow()
+{
+	Close();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Core/Window.h"
+
+// Window without a surface, it keeps running until it's closed and never receives input
+class NullWindow : public Window
+{
+public:
+	NullWindow(WindowSpecification specification);
+
+	virtual void Update() override;
+
+	virtual bool IsRunning() override;
+
+	virtual void Resize(int32_t width, int32_t height) override;
+
+	virtual glm::vec2 GetMousePosition() override;
+	virtual glm::vec2 GetMousePositionNormalized() override;
+
+	virtual void Move(glm::vec2 delta) override;
+
+	virtual void* GetNativeWindow() override;
+
+	virtual std::shared_ptr<RenderingContext> GetContext() override;
+
+	virtual void Close() override;
+	virtual ~NullWindow() override;
+private:
+	std::shared_ptr<RenderingContext> m_Context;
+
+	bool m_bIsRunning = true;
+};
@@ -0,0 +1,45 @@
+#include "NullCubeTexture.h"
+#include "Platform/Rendering/Null/NullRenderingContext.h"
+
+NullCubeTexture::NullCubeTexture(const std::string& name) : Super(name)
+{
+	++NullRenderingContext::GetResourceStatistics().Textures;
+}
+
+NullCubeTexture::~NullCubeTexture()
+{
+	NullResourceStatistics& statistics = NullRenderingContext::GetResourceStatistics();
+	statistics.TexturesMemory -= m_Memory;
+	--statistics.Textures;
+}
+
+void NullCubeTexture::Initialize()
+{
+	m_bIsInitialized = true;
+
+	UpdateMemory();
+}
+
+void NullCubeTexture::RefreshData()
+{
+	if (m_bIsInitialized)
+	{
+		UpdateMemory();
+	}
+}
+
+void NullCubeTexture::RefreshParameters()
+{
+
+}
+
+void NullCubeTexture::UpdateMemory()
+{
+	uint64_t memory = 6ull * m_Data.GetSize() * m_Data.GetSize() * Types::GetPixelSize(m_PixelFormat);
+
+	NullResourceStatistics& statistics = NullRenderingContext::GetResourceStatistics();
+	statistics.TexturesMemory -= m_Memory;
+	statistics.TexturesMemory += memory;
+
+	m_Memory = memory;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Core/Rendering/Textures/CubeTexture.h"
+
+ED_CLASS(NullCubeTexture) : public CubeTexture
+{
+	ED_CLASS_BODY(NullCubeTexture, CubeTexture)
+public:
+	NullCubeTexture(const std::string& name = "Empty");
+
+	virtual void Initialize() override;
+
+	virtual ~NullCubeTexture() override;
+protected:
+	virtual void RefreshData() override;
+	virtual void RefreshParameters() override;
+private:
+	void UpdateMemory();
+
+	uint64_t m_Memory = 0;
+};
@@ -0,0 +1,61 @@
+#include "NullTexture2D.h"
+#include "Platform/Rendering/Null/NullRenderingContext.h"
+
+NullTexture2D::NullTexture2D(const std::string& name) : Super(name)
+{
+	++NullRenderingContext::GetResourceStatistics().Textures;
+}
+
+NullTexture2D::~NullTexture2D()
+{
+	NullResourceStatistics& statistics = NullRenderingContext::GetResourceStatistics();
+	statistics.TexturesMemory -= m_Memory;
+	--statistics.Textures;
+}
+
+void NullTexture2D::Initialize()
+{
+	m_bIsInitialized = true;
+
+	UpdateMemory();
+}
+
+void NullTexture2D::RefreshData()
+{
+	if (m_bIsInitialized)
+	{
+		UpdateMemory();
+	}
+}
+
+void NullTexture2D::GenerateMipMaps()
+{
+	UpdateMemory();
+}
+
+void NullTexture2D::DeleteMipMaps()
+{
+	UpdateMemory();
+}
+
+void NullTexture2D::RefreshParameters()
+{
+
+}
+
+void NullTexture2D::UpdateMemory()
+{
+	uint64_t memory = (uint64_t) m_Data.GetWidth() * m_Data.GetHeight() * Types::GetPixelSize(m_PixelFormat);
+
+	// Full mip chain adds a third of the top level
+	if (m_bMipMapsEnabled)
+	{
+		memory = memory * 4 / 3;
+	}
+
+	NullResourceStatistics& statistics = NullRenderingContext::GetResourceStatistics();
+	statistics.TexturesMemory -= m_Memory;
+	statistics.TexturesMemory += memory;
+
+	m_Memory = memory;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Core/Rendering/Textures/Texture2D.h"
+
+ED_CLASS(NullTexture2D) : public Texture2D
+{
+	ED_CLASS_BODY(NullTexture2D, Texture2D)
+public:
+	NullTexture2D(const std::string& name = "Empty");
+
+	virtual void Initialize() override;
+
+	virtual ~NullTexture2D() override;
+protected:
+	virtual void RefreshData() override;
+	virtual void GenerateMipMaps() override;
+	virtual void DeleteMipMaps() override;
+	virtual void RefreshParameters() override;
+private:
+	void UpdateMemory();
+
+	uint64_t m_Memory = 0;
+};
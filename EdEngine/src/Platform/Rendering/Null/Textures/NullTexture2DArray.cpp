@@ -0,0 +1,45 @@
+#include "NullTexture2DArray.h"
+#include "Platform/Rendering/Null/NullRenderingContext.h"
+
+NullTexture2DArray::NullTexture2DArray(const std::string& name) : Super(name)
+{
+	++NullRenderingContext::GetResourceStatistics().Textures;
+}
+
+NullTexture2DArray::~NullTexture2DArray()
+{
+	NullResourceStatistics& statistics = NullRenderingContext::GetResourceStatistics();
+	statistics.TexturesMemory -= m_Memory;
+	--statistics.Textures;
+}
+
+void NullTexture2DArray::Initialize()
+{
+	m_bIsInitialized = true;
+
+	UpdateMemory();
+}
+
+void NullTexture2DArray::RefreshData()
+{
+	if (m_bIsInitialized)
+	{
+		UpdateMemory();
+	}
+}
+
+void NullTexture2DArray::RefreshParameters()
+{
+
+}
+
+void NullTexture2DArray::UpdateMemory()
+{
+	uint64_t memory = (uint64_t) m_Data.GetWidth() * m_Data.GetHeight() * m_Data.GetDepth() * Types::GetPixelSize(m_PixelFormat);
+
+	NullResourceStatistics& statistics = NullRenderingContext::GetResourceStatistics();
+	statistics.TexturesMemory -= m_Memory;
+	statistics.TexturesMemory += memory;
+
+	m_Memory = memory;
+}
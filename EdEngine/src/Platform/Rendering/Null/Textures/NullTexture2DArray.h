@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Core/Rendering/Textures/Texture2DArray.h"
+
+ED_CLASS(NullTexture2DArray) : public Texture2DArray
+{
+	ED_CLASS_BODY(NullTexture2DArray, Texture2DArray)
+public:
+	NullTexture2DArray(const std::string& name = "Empty");
+
+	virtual void Initialize() override;
+
+	virtual ~NullTexture2DArray() override;
+protected:
+	virtual void RefreshData() override;
+	virtual void RefreshParameters() override;
+private:
+	void UpdateMemory();
+
+	uint64_t m_Memory = 0;
+};
@@ -0,0 +1,39 @@
+#include "OpenGLStorageBuffer.h"
+#include "Core/Rendering/EdRendering.h"
+#include "Platform/Rendering/OpenGL/OpenGLTypes.h"
+
+OpenGLStorageBuffer::OpenGLStorageBuffer()
+{
+	glCreateBuffers(1, &m_Id);
+}
+
+void OpenGLStorageBuffer::SetData(void* data, BufferUsage usage)
+{
+	glNamedBufferData(m_Id, m_Size, data, OpenGLTypes::ConvertBufferUsage(usage));
+}
+
+void OpenGLStorageBuffer::SetData(void* data, int32_t size, BufferUsage usage)
+{
+	m_Size = size;
+	glNamedBufferData(m_Id, m_Size, data, OpenGLTypes::ConvertBufferUsage(usage));
+}
+
+void OpenGLStorageBuffer::SetSubdata(uint32_t offset, uint32_t size, void* data)
+{
+	glNamedBufferSubData(m_Id, offset, size, data);
+}
+
+uint32_t OpenGLStorageBuffer::GetSize() const
+{
+	return m_Size;
+}
+
+uint32_t OpenGLStorageBuffer::GetID() const
+{
+	return m_Id;
+}
+
+OpenGLStorageBuffer::~OpenGLStorageBuffer()
+{
+	glDeleteBuffers(1, &m_Id);
+}
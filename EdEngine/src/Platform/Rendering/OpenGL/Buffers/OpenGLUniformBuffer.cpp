@@ -0,0 +1,39 @@
+#include "OpenGLUniformBuffer.h"
+#include "Core/Rendering/EdRendering.h"
+#include "Platform/Rendering/OpenGL/OpenGLTypes.h"
+
+OpenGLUniformBuffer::OpenGLUniformBuffer()
+{
+	glCreateBuffers(1, &m_Id);
+}
+
+void OpenGLUniformBuffer::SetData(void* data, BufferUsage usage)
+{
+	glNamedBufferData(m_Id, m_Size, data, OpenGLTypes::ConvertBufferUsage(usage));
+}
+
+void OpenGLUniformBuffer::SetData(void* data, int32_t size, BufferUsage usage)
+{
+	m_Size = size;
+	glNamedBufferData(m_Id, m_Size, data, OpenGLTypes::ConvertBufferUsage(usage));
+}
+
+void OpenGLUniformBuffer::SetSubdata(uint32_t offset, uint32_t size, void* data)
+{
+	glNamedBufferSubData(m_Id, offset, size, data);
+}
+
+uint32_t OpenGLUniformBuffer::GetSize() const
+{
+	return m_Size;
+}
+
+uint32_t OpenGLUniformBuffer::GetID() const
+{
+	return m_Id;
+}
+
+OpenGLUniformBuffer::~OpenGLUniformBuffer()
+{
+	glDeleteBuffers(1, &m_Id);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Core/Rendering/Buffers/UniformBuffer.h"
+
+class OpenGLUniformBuffer : public UniformBuffer
+{
+public:
+	OpenGLUniformBuffer();
+
+	virtual void SetData(void* data, BufferUsage usage) override;
+	virtual void SetData(void* data, int32_t size, BufferUsage usage) override;
+
+	virtual void SetSubdata(uint32_t offset, uint32_t size, void* data) override;
+
+	virtual uint32_t GetSize() const override;
+
+	uint32_t GetID() const;
+
+	virtual ~OpenGLUniformBuffer() override;
+private:
+	uint32_t m_Id = 0;
+	uint32_t m_Size = 0;
+};
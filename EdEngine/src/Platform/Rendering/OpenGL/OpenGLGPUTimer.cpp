@@ -0,0 +1,59 @@
+#include "OpenGLGPUTimer.h"
+#include "Core/Rendering/EdRendering.h"
+
+bool OpenGLGPUTimer::BeginFrame(std::vector<uint64_t>& timestamps)
+{
+	m_CurrentSet = (m_CurrentSet + 1) % FramesInFlight;
+	QuerySet& set = m_Sets[m_CurrentSet];
+
+	timestamps.clear();
+
+	bool bAreAvailable = false;
+	if (set.Count > 0)
+	{
+		// Queries finish in order, so the last one being available means all of them are
+		int32_t available = 0;
+		glGetQueryObjectiv(set.Queries[set.Count - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+
+		bAreAvailable = available != 0;
+		if (bAreAvailable)
+		{
+			timestamps.resize(set.Count);
+			for (uint32_t i = 0; i < set.Count; ++i)
+			{
+				glGetQueryObjectui64v(set.Queries[i], GL_QUERY_RESULT, &timestamps[i]);
+			}
+		}
+	}
+
+	set.Count = 0;
+
+	return bAreAvailable;
+}
+
+uint32_t OpenGLGPUTimer::WriteTimestamp()
+{
+	QuerySet& set = m_Sets[m_CurrentSet];
+
+	if (set.Count == set.Queries.size())
+	{
+		uint32_t query = 0;
+		glCreateQueries(GL_TIMESTAMP, 1, &query);
+		set.Queries.push_back(query);
+	}
+
+	glQueryCounter(set.Queries[set.Count], GL_TIMESTAMP);
+
+	return set.Count++;
+}
+
+OpenGLGPUTimer::~OpenGLGPUTimer()
+{
+	for (QuerySet& set : m_Sets)
+	{
+		if (!set.Queries.empty())
+		{
+			glDeleteQueries(set.Queries.size(), set.Queries.data());
+		}
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Core/Rendering/GPUTimer.h"
+
+class OpenGLGPUTimer : public GPUTimer
+{
+public:
+	virtual bool BeginFrame(std::vector<uint64_t>& timestamps) override;
+	virtual uint32_t WriteTimestamp() override;
+
+	virtual ~OpenGLGPUTimer() override;
+private:
+	struct QuerySet
+	{
+		// Queries are created on demand and reused by following frames
+		std::vector<uint32_t> Queries;
+		uint32_t Count = 0;
+	};
+
+	QuerySet m_Sets[FramesInFlight];
+	uint32_t m_CurrentSet = 0;
+};
@@ -5,8 +5,11 @@
 #include "Core/Macros.h"
 #include "Buffers/OpenGLVertexBuffer.h"
 #include "Buffers/OpenGLIndexBuffer.h"
+#include "Buffers/OpenGLStorageBuffer.h"
+#include "Buffers/OpenGLUniformBuffer.h"
 #include "OpenGLTypes.h"
 #include "OpenGLShader.h"
+#include "Core/Rendering/PipelineState.h"
 #include <glm/gtc/type_ptr.hpp>
 #include <imgui.h>
 #include <backends/imgui_impl_opengl3.h>
@@ -15,13 +18,32 @@
 
 void OpenGLRenderingContext::SetDefaultFramebuffer()
 {
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	BindFramebuffer(0);
+
+	m_State.ViewportX = 0;
+	m_State.ViewportY = 0;
+	m_State.ViewportWidth = 0;
+	m_State.ViewportHeight = 0;
 }
 
 void OpenGLRenderingContext::SetFramebuffer(std::shared_ptr<Framebuffer> framebuffer)
 {
-	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer->GetID());
-	glViewport(0, 0, framebuffer->GetWidth(), framebuffer->GetHeight());
+	BindFramebuffer(framebuffer->GetID());
+	SetViewport(0, 0, framebuffer->GetWidth(), framebuffer->GetHeight());
+}
+
+void OpenGLRenderingContext::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+	bool bChanged = m_State.ViewportX != x || m_State.ViewportY != y || m_State.ViewportWidth != width || m_State.ViewportHeight != height;
+	CountStateChange(bChanged, false);
+
+	if (!bChanged) return;
+
+	m_State.ViewportX = x;
+	m_State.ViewportY = y;
+	m_State.ViewportWidth = width;
+	m_State.ViewportHeight = height;
+	glViewport(x, y, width, height);
 }
 
 void OpenGLRenderingContext::SetVertexBuffer(std::shared_ptr<VertexBuffer> buffer)
@@ -71,118 +93,235 @@ void OpenGLRenderingContext::SetIndexBuffer(std::shared_ptr<IndexBuffer> buffer)
 	}
 }
 
+void OpenGLRenderingContext::SetStorageBuffer(uint32_t binding, std::shared_ptr<StorageBuffer> buffer)
+{
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, buffer ? std::static_pointer_cast<OpenGLStorageBuffer>(buffer)->GetID() : 0);
+}
+
+void OpenGLRenderingContext::SetUniformBuffer(uint32_t binding, std::shared_ptr<UniformBuffer> buffer)
+{
+	ED_ASSERT(binding < MaxUniformBufferBindings, "Uniform buffer binding is out of range")
+
+	if (m_UniformBuffers[binding] == buffer) return;
+
+	m_UniformBuffers[binding] = buffer;
+	glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer ? std::static_pointer_cast<OpenGLUniformBuffer>(buffer)->GetID() : 0);
+}
+
 void OpenGLRenderingContext::SetShader(std::shared_ptr<Shader> shader)
 {
+	CountStateChange(m_Shader != shader);
+
 	if (m_Shader == shader) return;
 
 	m_Shader = shader;
-	m_ShaderID = std::static_pointer_cast<OpenGLShader>(shader)->GetID();
+	m_ActiveShader = static_cast<OpenGLShader*>(shader.get());
+	m_ShaderID = m_ActiveShader->GetID();
 	glUseProgram(m_ShaderID);
 }
 
-void OpenGLRenderingContext::SetShaderDataTexture(const std::string& name, std::shared_ptr<Texture> texture)
+const std::shared_ptr<Shader>& OpenGLRenderingContext::GetShader() const
 {
-	glActiveTexture(GL_TEXTURE0 + m_LastTextureSlot);
-	glBindTexture(OpenGLTypes::ConverTextureType(texture->GetTextureType()), texture->GetID());
+	return m_Shader;
+}
 
-	const int32_t location = glGetUniformLocation(m_ShaderID, name.c_str());
-	glUniform1i(location, m_LastTextureSlot);
-	
-	m_LastTextureSlot = (m_LastTextureSlot + 1) % MaxTextureSlots;
+void OpenGLRenderingContext::SetPipelineState(std::shared_ptr<PipelineState> state)
+{
+	if (m_PipelineState == state)
+	{
+		++m_Statistics.EliminatedPipelineStateChanges;
+		return;
+	}
+
+	++m_Statistics.PipelineStateChanges;
+
+	const PipelineStateDescription& description = state->GetDescription();
+
+	SetShader(description.Shader);
+
+	if (description.bUseBlending)
+	{
+		EnableBlending(description.SourceFactor, description.DestinationFactor);
+	}
+	else
+	{
+		DisableBlending();
+	}
+
+	if (description.bUseDepthTesting)
+	{
+		EnableDethTest(description.DepthFunction);
+	}
+	else
+	{
+		DisableDethTest();
+	}
+
+	if (description.bEnableFaceCulling)
+	{
+		EnableFaceCulling(description.FaceToCull);
+	}
+	else
+	{
+		DisableFaceCulling();
+	}
+
+	m_PipelineState = state;
 }
 
-void OpenGLRenderingContext::SetShaderDataImage(const std::string& name, std::shared_ptr<Texture> texture)
+int32_t OpenGLRenderingContext::GetUniformLocation(std::string_view name) const
 {
-	glBindImageTexture(m_LastTextureSlot, texture->GetID(), 0, GL_FALSE, 0, GL_READ_WRITE, OpenGLTypes::ConvertPixelFormat(texture->GetPixelFormat()));
-	m_LastTextureSlot = (m_LastTextureSlot + 1) % MaxTextureSlots;
+	return m_ActiveShader ? m_ActiveShader->GetUniformLocation(name) : -1;
 }
 
-void OpenGLRenderingContext::SetShaderDataInt(const std::string& name, int32_t value)
+bool OpenGLRenderingContext::ShouldUploadUniform(int32_t location, const void* data, uint32_t size)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name.c_str());
-	glUniform1i(location, value);
+	return m_ActiveShader && m_ActiveShader->UpdateUniformValue(location, data, size);
 }
 
 void OpenGLRenderingContext::SetShaderDataTexture(const char* name, std::shared_ptr<Texture> texture)
 {
-	glActiveTexture(GL_TEXTURE0 + m_LastTextureSlot);
-	glBindTexture(OpenGLTypes::ConverTextureType(texture->GetTextureType()), texture->GetID());
-
-	const int32_t location = glGetUniformLocation(m_ShaderID, name);
-	glUniform1i(location, m_LastTextureSlot);
-	
-	m_LastTextureSlot = (m_LastTextureSlot + 1) % MaxTextureSlots;
+	SetShaderDataTexture(GetUniformLocation(name), texture);
 }
 
 void OpenGLRenderingContext::SetShaderDataImage(const char* name, std::shared_ptr<Texture> texture)
 {
- 	glBindImageTexture(0, texture->GetID(), 0, GL_FALSE, 0, GL_READ_WRITE, OpenGLTypes::ConvertPixelFormat(texture->GetPixelFormat()));
+	SetShaderDataImage(GetUniformLocation(name), texture);
 }
 
 void OpenGLRenderingContext::SetShaderDataInt(const char* name, int32_t value)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name);
-	glUniform1i(location, value);
+	SetShaderDataInt(GetUniformLocation(name), value);
 }
 
 void OpenGLRenderingContext::SetShaderDataFloat(const char* name, float value)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name);
-	glUniform1f(location, value);
+	SetShaderDataFloat(GetUniformLocation(name), value);
 }
 
 void OpenGLRenderingContext::SetShaderDataFloat2(const char* name, glm::vec2 vector)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name);
-	glUniform2f(location, vector.x, vector.y);
+	SetShaderDataFloat2(GetUniformLocation(name), vector);
 }
 
 void OpenGLRenderingContext::SetShaderDataFloat2(const char* name, float x, float y)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name);
-	glUniform2f(location, x, y);
+	SetShaderDataFloat2(GetUniformLocation(name), glm::vec2(x, y));
 }
 
 void OpenGLRenderingContext::SetShaderDataFloat3(const char* name, float x, float y, float z)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name);
-	glUniform3f(location, x, y, z);
+	SetShaderDataFloat3(GetUniformLocation(name), glm::vec3(x, y, z));
 }
 
 void OpenGLRenderingContext::SetShaderDataFloat3(const char* name, glm::vec3 vector)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name);
-	glUniform3f(location, vector.x, vector.y, vector.z);
+	SetShaderDataFloat3(GetUniformLocation(name), vector);
 }
 
 void OpenGLRenderingContext::SetShaderDataFloat4(const char* name, float r, float g, float b, float a)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name);
-	glUniform4f(location, r, g, b, a);
+	SetShaderDataFloat4(GetUniformLocation(name), glm::vec4(r, g, b, a));
 }
 
 void OpenGLRenderingContext::SetShaderDataFloat4(const char* name, glm::vec4 vector)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name);
-	glUniform4f(location, vector.x, vector.y, vector.z, vector.w);
+	SetShaderDataFloat4(GetUniformLocation(name), vector);
 }
 
 void OpenGLRenderingContext::SetShaderDataMat4(const char* name, const glm::mat4& matrix)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name);
-	glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+	SetShaderDataMat4(GetUniformLocation(name), matrix);
 }
 
 void OpenGLRenderingContext::SetShaderDataMat3(const char* name, const glm::mat3& matrix)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name);
-	glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+	SetShaderDataMat3(GetUniformLocation(name), matrix);
 }
 
 void OpenGLRenderingContext::SetShaderDataBool(const char* name, bool value)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name);
-	glUniform1i(location, value);
+	SetShaderDataBool(GetUniformLocation(name), value);
+}
+
+void OpenGLRenderingContext::SetShaderDataTexture(int32_t location, std::shared_ptr<Texture> texture)
+{
+	glActiveTexture(GL_TEXTURE0 + m_LastTextureSlot);
+	glBindTexture(OpenGLTypes::ConverTextureType(texture->GetTextureType()), texture->GetID());
+
+	SetShaderDataInt(location, m_LastTextureSlot);
+
+	m_LastTextureSlot = (m_LastTextureSlot + 1) % MaxTextureSlots;
+}
+
+void OpenGLRenderingContext::SetShaderDataImage(int32_t location, std::shared_ptr<Texture> texture)
+{
+	glBindImageTexture(m_LastTextureSlot, texture->GetID(), 0, GL_FALSE, 0, GL_READ_WRITE, OpenGLTypes::ConvertPixelFormat(texture->GetPixelFormat()));
+
+	SetShaderDataInt(location, m_LastTextureSlot);
+
+	m_LastTextureSlot = (m_LastTextureSlot + 1) % MaxTextureSlots;
+}
+
+void OpenGLRenderingContext::SetShaderDataInt(int32_t location, int32_t value)
+{
+	if (ShouldUploadUniform(location, &value, sizeof(value)))
+	{
+		glUniform1i(location, value);
+	}
+}
+
+void OpenGLRenderingContext::SetShaderDataFloat(int32_t location, float value)
+{
+	if (ShouldUploadUniform(location, &value, sizeof(value)))
+	{
+		glUniform1f(location, value);
+	}
+}
+
+void OpenGLRenderingContext::SetShaderDataFloat2(int32_t location, glm::vec2 vector)
+{
+	if (ShouldUploadUniform(location, glm::value_ptr(vector), sizeof(vector)))
+	{
+		glUniform2f(location, vector.x, vector.y);
+	}
+}
+
+void OpenGLRenderingContext::SetShaderDataFloat3(int32_t location, glm::vec3 vector)
+{
+	if (ShouldUploadUniform(location, glm::value_ptr(vector), sizeof(vector)))
+	{
+		glUniform3f(location, vector.x, vector.y, vector.z);
+	}
+}
+
+void OpenGLRenderingContext::SetShaderDataFloat4(int32_t location, glm::vec4 vector)
+{
+	if (ShouldUploadUniform(location, glm::value_ptr(vector), sizeof(vector)))
+	{
+		glUniform4f(location, vector.x, vector.y, vector.z, vector.w);
+	}
+}
+
+void OpenGLRenderingContext::SetShaderDataMat4(int32_t location, const glm::mat4& matrix)
+{
+	if (ShouldUploadUniform(location, glm::value_ptr(matrix), sizeof(matrix)))
+	{
+		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+	}
+}
+
+void OpenGLRenderingContext::SetShaderDataMat3(int32_t location, const glm::mat3& matrix)
+{
+	if (ShouldUploadUniform(location, glm::value_ptr(matrix), sizeof(matrix)))
+	{
+		glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+	}
+}
+
+void OpenGLRenderingContext::SetShaderDataBool(int32_t location, bool value)
+{
+	SetShaderDataInt(location, value ? 1 : 0);
 }
 
 void OpenGLRenderingContext::RunComputeShader(uint32_t sizeX, uint32_t sizeY, uint32_t sizeZ)
@@ -210,57 +349,72 @@ void OpenGLRenderingContext::Draw(DrawMode drawMode)
 	}
 }
 
+void OpenGLRenderingContext::DrawInstanced(uint32_t instancesCount, uint32_t firstInstance, DrawMode drawMode)
+{
+	int32_t mode = OpenGLTypes::ConvertDrawMode(drawMode);
+
+	if (m_IBO)
+	{
+		int32_t count = m_IBO->GetCount();
+		glDrawElementsInstancedBaseInstance(mode, count, GL_UNSIGNED_INT, nullptr, instancesCount, firstInstance);
+	}
+	else
+	{
+		glDrawArraysInstancedBaseInstance(mode, 0, m_VBO->GetCount(), instancesCount, firstInstance);
+	}
+}
+
 void OpenGLRenderingContext::EnableBlending(BlendFactor source, BlendFactor destination)
 {
-	glEnable(GL_BLEND);
-	glBlendFunc(OpenGLTypes::ConvertBlendFactor(source), OpenGLTypes::ConvertBlendFactor(destination));
+	SetCapability(GL_BLEND, true, m_State.bBlending);
+	SetBlending(source, destination);
 }
 
 void OpenGLRenderingContext::SetBlending(BlendFactor source, BlendFactor destination)
 {
-	glBlendFunc(OpenGLTypes::ConvertBlendFactor(source), OpenGLTypes::ConvertBlendFactor(destination));
+	SetBlendFunction(OpenGLTypes::ConvertBlendFactor(source), OpenGLTypes::ConvertBlendFactor(destination));
 }
 
 void OpenGLRenderingContext::DisableBlending()
 {
-	glDisable(GL_BLEND);
+	SetCapability(GL_BLEND, false, m_State.bBlending);
 }
 
 void OpenGLRenderingContext::EnableDethTest(DepthTestFunction function)
 {
-	glEnable(GL_DEPTH_TEST);
-	glDepthFunc(OpenGLTypes::ConvertDepthTestFunction(function));
+	SetCapability(GL_DEPTH_TEST, true, m_State.bDepthTest);
+	SetDethTestFunction(function);
 }
 
 void OpenGLRenderingContext::SetDethTestFunction(DepthTestFunction function)
 {
-	glDepthFunc(OpenGLTypes::ConvertDepthTestFunction(function));
+	SetDepthFunction(OpenGLTypes::ConvertDepthTestFunction(function));
 }
 
 void OpenGLRenderingContext::DisableDethTest()
 {
-	glDisable(GL_DEPTH_TEST);
+	SetCapability(GL_DEPTH_TEST, false, m_State.bDepthTest);
 }
 
 void OpenGLRenderingContext::EnableFaceCulling()
 {
-	glEnable(GL_CULL_FACE);
+	SetCapability(GL_CULL_FACE, true, m_State.bFaceCulling);
 }
 
 void OpenGLRenderingContext::EnableFaceCulling(Face face)
 {
-	glEnable(GL_CULL_FACE);
-	glCullFace(OpenGLTypes::ConvertFace(face));
+	SetCapability(GL_CULL_FACE, true, m_State.bFaceCulling);
+	SetCullingFace(face);
 }
 
 void OpenGLRenderingContext::SetCullingFace(Face face)
 {
-	glCullFace(OpenGLTypes::ConvertFace(face));
+	SetCullFace(OpenGLTypes::ConvertFace(face));
 }
 
 void OpenGLRenderingContext::DisableFaceCulling()
 {
-	glDisable(GL_CULL_FACE);
+	SetCapability(GL_CULL_FACE, false, m_State.bFaceCulling);
 }
 
 void OpenGLRenderingContext::ClearDepthTarget()
@@ -268,6 +422,20 @@ void OpenGLRenderingContext::ClearDepthTarget()
 	glClear(GL_DEPTH_BUFFER_BIT);
 }
 
+void OpenGLRenderingContext::ClearDepthTarget(std::shared_ptr<Texture> target, glm::u32vec3 offset, glm::u32vec3 size)
+{
+	static const float depth = 1.0f;
+	glClearTexSubImage(target->GetID(), 0, offset.x, offset.y, offset.z, size.x, size.y, size.z, GL_DEPTH_COMPONENT, GL_FLOAT, &depth);
+}
+
+void OpenGLRenderingContext::CopyTexture(std::shared_ptr<Texture> source, std::shared_ptr<Texture> destination, glm::u32vec3 offset, glm::u32vec3 size)
+{
+	uint32_t sourceTarget = OpenGLTypes::ConverTextureType(source->GetTextureType());
+	uint32_t destinationTarget = OpenGLTypes::ConverTextureType(destination->GetTextureType());
+
+	glCopyImageSubData(source->GetID(), sourceTarget, 0, offset.x, offset.y, offset.z, destination->GetID(), destinationTarget, 0, offset.x, offset.y, offset.z, size.x, size.y, size.z);
+}
+
 void OpenGLRenderingContext::ClearColorTarget()
 {
 	glClear(GL_COLOR_BUFFER_BIT);
@@ -311,12 +479,106 @@ void OpenGLRenderingContext::SwapBuffers()
 	glfwSwapBuffers(m_Window);
 }
 
+const RenderingStateStatistics& OpenGLRenderingContext::GetStatistics() const
+{
+	return m_LastFrameStatistics;
+}
+
+void OpenGLRenderingContext::ResetStatistics()
+{
+	m_LastFrameStatistics = m_Statistics;
+	m_Statistics = RenderingStateStatistics();
+}
+
+void OpenGLRenderingContext::SetCapability(uint32_t capability, bool bEnable, bool& bCurrent)
+{
+	CountStateChange(bCurrent != bEnable);
+
+	if (bCurrent == bEnable) return;
+
+	bCurrent = bEnable;
+
+	if (bEnable)
+	{
+		glEnable(capability);
+	}
+	else
+	{
+		glDisable(capability);
+	}
+}
+
+void OpenGLRenderingContext::SetBlendFunction(uint32_t source, uint32_t destination)
+{
+	bool bChanged = m_State.BlendSource != source || m_State.BlendDestination != destination;
+	CountStateChange(bChanged);
+
+	if (!bChanged) return;
+
+	m_State.BlendSource = source;
+	m_State.BlendDestination = destination;
+	glBlendFunc(source, destination);
+}
+
+void OpenGLRenderingContext::SetDepthFunction(uint32_t function)
+{
+	CountStateChange(m_State.DepthFunction != function);
+
+	if (m_State.DepthFunction == function) return;
+
+	m_State.DepthFunction = function;
+	glDepthFunc(function);
+}
+
+void OpenGLRenderingContext::SetCullFace(uint32_t face)
+{
+	CountStateChange(m_State.CullFace != face);
+
+	if (m_State.CullFace == face) return;
+
+	m_State.CullFace = face;
+	glCullFace(face);
+}
+
+void OpenGLRenderingContext::BindFramebuffer(uint32_t id)
+{
+	CountStateChange(m_State.Framebuffer != id, false);
+
+	if (m_State.Framebuffer == id) return;
+
+	m_State.Framebuffer = id;
+	glBindFramebuffer(GL_FRAMEBUFFER, id);
+}
+
+void OpenGLRenderingContext::CountStateChange(bool bChanged, bool bPartOfPipelineState)
+{
+	if (bChanged)
+	{
+		// Current pipeline state doesn't describe GL state anymore, so the next one has to be applied in full
+		if (bPartOfPipelineState)
+		{
+			m_PipelineState = nullptr;
+		}
+
+		++m_Statistics.StateChanges;
+	}
+	else
+	{
+		++m_Statistics.EliminatedStateChanges;
+	}
+}
+
 OpenGLRenderingContext::OpenGLRenderingContext(Window* window)
 {
 	ED_LOG(OpenGLRenderingContext, info, "Started creating rendering context");
 
 	m_Window = (GLFWwindow*) window->GetNativeWindow();
 
+	m_State.BlendSource = GL_ONE;
+	m_State.BlendDestination = GL_ZERO;
+	m_State.DepthFunction = GL_LESS;
+	m_State.CullFace = GL_BACK;
+
 	ED_LOG(OpenGLRenderingContext, info, "Finished creating rendering context");
 }
 
@@ -325,62 +587,67 @@ OpenGLRenderingContext::~OpenGLRenderingContext()
 
 }
 
+void OpenGLRenderingContext::SetShaderDataTexture(const std::string& name, std::shared_ptr<Texture> texture)
+{
+	SetShaderDataTexture(GetUniformLocation(name), texture);
+}
+
+void OpenGLRenderingContext::SetShaderDataImage(const std::string& name, std::shared_ptr<Texture> texture)
+{
+	SetShaderDataImage(GetUniformLocation(name), texture);
+}
+
+void OpenGLRenderingContext::SetShaderDataInt(const std::string& name, int32_t value)
+{
+	SetShaderDataInt(GetUniformLocation(name), value);
+}
+
 void OpenGLRenderingContext::SetShaderDataFloat(const std::string& name, float value)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name.c_str());
-	glUniform1f(location, value);
+	SetShaderDataFloat(GetUniformLocation(name), value);
 }
 
 void OpenGLRenderingContext::SetShaderDataFloat2(const std::string& name, glm::vec2 vector)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name.c_str());
-	glUniform2f(location, vector.x, vector.y);
+	SetShaderDataFloat2(GetUniformLocation(name), vector);
 }
 
 void OpenGLRenderingContext::SetShaderDataFloat2(const std::string& name, float x, float y)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name.c_str());
-	glUniform2f(location, x, y);
+	SetShaderDataFloat2(GetUniformLocation(name), glm::vec2(x, y));
 }
 
 void OpenGLRenderingContext::SetShaderDataFloat3(const std::string& name, float x, float y, float z)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name.c_str());
-	glUniform3f(location, x, y, z);
+	SetShaderDataFloat3(GetUniformLocation(name), glm::vec3(x, y, z));
 }
 
 void OpenGLRenderingContext::SetShaderDataFloat3(const std::string& name, glm::vec3 vector)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name.c_str());
-	glUniform3f(location, vector.x, vector.y, vector.z);
+	SetShaderDataFloat3(GetUniformLocation(name), vector);
 }
 
 void OpenGLRenderingContext::SetShaderDataFloat4(const std::string& name, float r, float g, float b, float a)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name.c_str());
-	glUniform4f(location, r, g, b, a);
+	SetShaderDataFloat4(GetUniformLocation(name), glm::vec4(r, g, b, a));
 }
 
 void OpenGLRenderingContext::SetShaderDataFloat4(const std::string& name, glm::vec4 vector)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name.c_str());
-	glUniform4f(location, vector.x, vector.y, vector.z, vector.w);
+	SetShaderDataFloat4(GetUniformLocation(name), vector);
 }
 
 void OpenGLRenderingContext::SetShaderDataMat4(const std::string& name, const glm::mat4& matrix)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name.c_str());
-	glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+	SetShaderDataMat4(GetUniformLocation(name), matrix);
 }
 
 void OpenGLRenderingContext::SetShaderDataMat3(const std::string& name, const glm::mat3& matrix)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name.c_str());
-	glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+	SetShaderDataMat3(GetUniformLocation(name), matrix);
 }
 
 void OpenGLRenderingContext::SetShaderDataBool(const std::string& name, bool value)
 {
-	const int32_t location = glGetUniformLocation(m_ShaderID, name.c_str());
-	glUniform1i(location, value);
-}
+	SetShaderDataBool(GetUniformLocation(name), value);
+}
\ No newline at end of file
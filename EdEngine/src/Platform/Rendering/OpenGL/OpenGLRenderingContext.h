@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/Rendering/RenderingContex.h"
+#include <string_view>
 
 class OpenGLRenderingContext : public RenderingContext
 {
@@ -9,12 +10,19 @@ public:
 
 	virtual void SetDefaultFramebuffer() override;
 	virtual void SetFramebuffer(std::shared_ptr<Framebuffer> framebuffer) override;
+	virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
 
 	virtual void SetVertexBuffer(std::shared_ptr<VertexBuffer> buffer) override;
 	
 	virtual void SetIndexBuffer(std::shared_ptr<IndexBuffer> buffer) override;
 
+	virtual void SetStorageBuffer(uint32_t binding, std::shared_ptr<StorageBuffer> buffer) override;
+	virtual void SetUniformBuffer(uint32_t binding, std::shared_ptr<UniformBuffer> buffer) override;
+
 	virtual void SetShader(std::shared_ptr<Shader> shader) override;
+	virtual const std::shared_ptr<Shader>& GetShader() const override;
+
+	virtual void SetPipelineState(std::shared_ptr<PipelineState> state) override;
 
 	virtual void SetShaderDataTexture(const std::string& name, std::shared_ptr<Texture> texture) override;
 	virtual void SetShaderDataImage(const std::string& name, std::shared_ptr<Texture> texture) override;
@@ -44,10 +52,22 @@ public:
 	virtual void SetShaderDataMat3(const char* name, const glm::mat3& matrix) override;
 	virtual void SetShaderDataBool(const char* name, bool value) override;
 
+	virtual void SetShaderDataTexture(int32_t location, std::shared_ptr<Texture> texture) override;
+	virtual void SetShaderDataImage(int32_t location, std::shared_ptr<Texture> texture) override;
+	virtual void SetShaderDataInt(int32_t location, int32_t value) override;
+	virtual void SetShaderDataFloat(int32_t location, float value) override;
+	virtual void SetShaderDataFloat2(int32_t location, glm::vec2 vector) override;
+	virtual void SetShaderDataFloat3(int32_t location, glm::vec3 vector) override;
+	virtual void SetShaderDataFloat4(int32_t location, glm::vec4 vector) override;
+	virtual void SetShaderDataMat4(int32_t location, const glm::mat4& matrix) override;
+	virtual void SetShaderDataMat3(int32_t location, const glm::mat3& matrix) override;
+	virtual void SetShaderDataBool(int32_t location, bool value) override;
+
 	virtual void RunComputeShader(uint32_t sizeX, uint32_t sizeY, uint32_t sizeZ) override;
 	virtual void Barier(BarrierType type) override;
 
 	virtual void Draw(DrawMode drawMode = DrawMode::Triangles) override;
+	virtual void DrawInstanced(uint32_t instancesCount, uint32_t firstInstance = 0, DrawMode drawMode = DrawMode::Triangles) override;
 
 	virtual void EnableBlending(BlendFactor source, BlendFactor destination) override;
 	virtual void SetBlending(BlendFactor source, BlendFactor destination) override;
@@ -63,6 +83,8 @@ public:
 	virtual void DisableFaceCulling() override;
 
 	virtual void ClearDepthTarget() override;
+	virtual void ClearDepthTarget(std::shared_ptr<Texture> target, glm::u32vec3 offset, glm::u32vec3 size) override;
+	virtual void CopyTexture(std::shared_ptr<Texture> source, std::shared_ptr<Texture> destination, glm::u32vec3 offset, glm::u32vec3 size) override;
 	virtual void ClearColorTarget() override;
 	virtual void SetClearColor(float r, float g, float b, float a) override;
 	virtual void SetClearColor(glm::vec4 color) override;
@@ -72,16 +94,60 @@ public:
 
 	virtual void SwapBuffers() override;
 
+	virtual const RenderingStateStatistics& GetStatistics() const override;
+	virtual void ResetStatistics() override;
+
 	virtual ~OpenGLRenderingContext() override;
+private:
+	int32_t GetUniformLocation(std::string_view name) const;
+	bool ShouldUploadUniform(int32_t location, const void* data, uint32_t size);
+
+	void SetCapability(uint32_t capability, bool bEnable, bool& bCurrent);
+	void SetBlendFunction(uint32_t source, uint32_t destination);
+	void SetDepthFunction(uint32_t function);
+	void SetCullFace(uint32_t face);
+	void BindFramebuffer(uint32_t id);
+	void CountStateChange(bool bChanged, bool bPartOfPipelineState = true);
+
 private:
 	std::shared_ptr<VertexBuffer> m_VBO;
 	std::shared_ptr<IndexBuffer> m_IBO;
 
 	std::shared_ptr<Shader> m_Shader;
+	std::shared_ptr<PipelineState> m_PipelineState;
+
+	// Mirror of the GL state, starts with GL defaults
+	struct StateCache
+	{
+		bool bBlending = false;
+		uint32_t BlendSource = 0;
+		uint32_t BlendDestination = 0;
+
+		bool bDepthTest = false;
+		uint32_t DepthFunction = 0;
+
+		bool bFaceCulling = false;
+		uint32_t CullFace = 0;
+
+		uint32_t Framebuffer = 0;
+
+		// Zero size means unknown, window changes the viewport of the default framebuffer on its own
+		uint32_t ViewportX = 0;
+		uint32_t ViewportY = 0;
+		uint32_t ViewportWidth = 0;
+		uint32_t ViewportHeight = 0;
+	} m_State;
+
+	RenderingStateStatistics m_Statistics;
+	RenderingStateStatistics m_LastFrameStatistics;
+	class OpenGLShader* m_ActiveShader = nullptr;
 	int32_t m_ShaderID;
 
 	int32_t m_LastTextureSlot = 0;
 	const int32_t MaxTextureSlots = 16;
+
+	static const int32_t MaxUniformBufferBindings = 16;
+	std::shared_ptr<UniformBuffer> m_UniformBuffers[MaxUniformBufferBindings];
 	
 	struct GLFWwindow* m_Window;
 };
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include "Core/Rendering/EdRendering.h"
 #include "Core/Macros.h"
 #include "OpenGLTypes.h"
+#include <cstring>
+#include <algorithm>
 
 OpenGLShader::OpenGLShader()
 {
@@ -50,6 +52,35 @@ void OpenGLShader::LinkProgram()
 		glDetachShader(m_Id, shaderId);
 		glDeleteShader(shaderId);
 	}
+
+	ReflectUniforms();
+}
+
+int32_t OpenGLShader::GetUniformLocation(std::string_view name) const
+{
+	auto it = m_UniformLocations.find(name);
+	return it != m_UniformLocations.end() ? it->second : -1;
+}
+
+bool OpenGLShader::UpdateUniformValue(int32_t location, const void* data, uint32_t size)
+{
+	if (location < 0 || (size_t)location >= m_UniformValues.size())
+	{
+		return false;
+	}
+
+	ED_ASSERT(size <= sizeof(UniformValue::Data), "Uniform value is too big to be cached")
+
+	UniformValue& value = m_UniformValues[location];
+	if (value.Size == size && std::memcmp(value.Data, data, size) == 0)
+	{
+		return false;
+	}
+
+	std::memcpy(value.Data, data, size);
+	value.Size = size;
+
+	return true;
 }
 
 uint32_t OpenGLShader::GetID() const
@@ -57,6 +88,60 @@ uint32_t OpenGLShader::GetID() const
     return m_Id;
 }
 
+void OpenGLShader::ReflectUniforms()
+{
+	m_UniformLocations.clear();
+	m_UniformValues.clear();
+
+	int32_t uniformsCount = 0;
+	glGetProgramiv(m_Id, GL_ACTIVE_UNIFORMS, &uniformsCount);
+
+	int32_t maxNameLength = 0;
+	glGetProgramiv(m_Id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+	std::string name(maxNameLength, '\0');
+	int32_t maxLocation = -1;
+
+	for (int32_t i = 0; i < uniformsCount; ++i)
+	{
+		int32_t nameLength = 0;
+		int32_t size = 0;
+		uint32_t type = 0;
+		glGetActiveUniform(m_Id, i, maxNameLength, &nameLength, &size, &type, name.data());
+
+		std::string uniformName = name.substr(0, nameLength);
+
+		// Uniforms from blocks have no location
+		int32_t location = glGetUniformLocation(m_Id, uniformName.c_str());
+		if (location < 0)
+		{
+			continue;
+		}
+
+		m_UniformLocations[uniformName] = location;
+		maxLocation = std::max(maxLocation, location);
+
+		// Arrays are reported once as "name[0]", so the plain name and the rest of elements are registered here
+		size_t bracket = uniformName.rfind("[0]");
+		if (bracket != std::string::npos && bracket + 3 == uniformName.size())
+		{
+			std::string baseName = uniformName.substr(0, bracket);
+			m_UniformLocations[baseName] = location;
+
+			for (int32_t element = 1; element < size; ++element)
+			{
+				std::string elementName = baseName + "[" + std::to_string(element) + "]";
+				int32_t elementLocation = glGetUniformLocation(m_Id, elementName.c_str());
+
+				m_UniformLocations[elementName] = elementLocation;
+				maxLocation = std::max(maxLocation, elementLocation);
+			}
+		}
+	}
+
+	m_UniformValues.resize(maxLocation + 1);
+}
+
 OpenGLShader::~OpenGLShader()
 {
 	glDeleteProgram(m_Id);
@@ -2,6 +2,7 @@
 
 #include "Core/Rendering/Shader.h"
 #include <vector>
+#include <unordered_map>
 
 class OpenGLShader : public Shader {
 public:
@@ -10,10 +11,37 @@ public:
 	virtual void SetShaderCode(ShaderType type, const std::string& code) override;
 	void LinkProgram();
 
+	virtual int32_t GetUniformLocation(std::string_view name) const override;
+
+	// Compares value with the last one uploaded to this location, returns true if upload is needed
+	bool UpdateUniformValue(int32_t location, const void* data, uint32_t size);
+
 	uint32_t GetID() const;
 
 	virtual ~OpenGLShader() override;
 private:
+	void ReflectUniforms();
+
+private:
+	struct UniformNameHash
+	{
+		using is_transparent = void;
+
+		size_t operator()(std::string_view name) const
+		{
+			return std::hash<std::string_view>{}(name);
+		}
+	};
+
+	struct UniformValue
+	{
+		uint8_t Data[64];
+		uint8_t Size = 0;
+	};
+
 	uint32_t m_Id;
 	std::vector<uint32_t> m_ShadersIds;
-};
\ No newline at end of file
+
+	std::unordered_map<std::string, int32_t, UniformNameHash, std::equal_to<>> m_UniformLocations;
+	std::vector<UniformValue> m_UniformValues;
+};
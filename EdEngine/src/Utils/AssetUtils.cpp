@@ -22,13 +22,17 @@ AssetType AssetUtils::GetAssetTypeFromExtension(const std::string& extension)
 	{
 		return AssetType::Texture2D;
 	}
+	else if (extension == ".edprobes")
+	{
+		return AssetType::IrradianceVolume;
+	}
 
     ED_ASSERT(0, "Unknown extension")
 }
 
 bool AssetUtils::IsAssetExtension(const std::string& extension)
 {
-	return extension == ".edmesh" || extension == ".edmaterial" || extension == ".edtexture";
+	return extension == ".edmesh" || extension == ".edmaterial" || extension == ".edtexture" || extension == ".edprobes";
 }
 
 std::string AssetUtils::GetAssetNameLable(std::shared_ptr<Asset> asset)
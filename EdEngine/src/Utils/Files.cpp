@@ -10,6 +10,7 @@ std::string Files::GetSaveExtensions(AssetType type)
     case AssetType::CubeTexture: return ".edtexture";
     case AssetType::Material: return ".edmaterial";
     case AssetType::StaticMesh: return ".edmesh";
+    case AssetType::IrradianceVolume: return ".edprobes";
     }
     return "";
 }
@@ -2,28 +2,72 @@
 #include "Platform/Rendering/OpenGL/OpenGLFramebuffer.h"
 #include "Platform/Rendering/OpenGL/Buffers/OpenGLVertexBuffer.h"
 #include "Platform/Rendering/OpenGL/Buffers/OpenGLIndexBuffer.h"
+#include "Platform/Rendering/OpenGL/Buffers/OpenGLStorageBuffer.h"
+#include "Platform/Rendering/OpenGL/Buffers/OpenGLUniformBuffer.h"
+#include "Platform/Rendering/OpenGL/OpenGLGPUTimer.h"
 #include "Platform/Rendering/OpenGL/OpenGLRenderingContext.h"
 #include "Platform/Rendering/OpenGL/OpenGLShader.h"
 #include "Platform/Rendering/OpenGL/OpenGLWindow.h"
 #include "Platform/Rendering/OpenGL/Textures/OpenGLTexture2D.h"
 #include "Platform/Rendering/OpenGL/Textures/OpenGLCubeTexture.h"
 #include "Platform/Rendering/OpenGL/Textures/OpenGLTexture2DArray.h"
+#include "Platform/Rendering/Null/NullFramebuffer.h"
+#include "Platform/Rendering/Null/Buffers/NullVertexBuffer.h"
+#include "Platform/Rendering/Null/Buffers/NullIndexBuffer.h"
+#include "Platform/Rendering/Null/Buffers/NullStorageBuffer.h"
+#include "Platform/Rendering/Null/Buffers/NullUniformBuffer.h"
+#include "Platform/Rendering/Null/NullGPUTimer.h"
+#include "Platform/Rendering/Null/NullShader.h"
+#include "Platform/Rendering/Null/NullWindow.h"
+#include "Platform/Rendering/Null/Textures/NullTexture2D.h"
+#include "Platform/Rendering/Null/Textures/NullCubeTexture.h"
+#include "Platform/Rendering/Null/Textures/NullTexture2DArray.h"
 #include "Core/Rendering/RenderGraph.h"
+#include "Core/Rendering/RenderQueue.h"
+#include "Core/Rendering/ShadowCache.h"
+#include "Core/Components/StaticMeshComponent.h"
+#include "Core/Components/PointLightComponent.h"
+#include "Core/Components/SpotLightComponent.h"
+#include "Core/Assets/StaticMesh.h"
 #include "Core/Assets/AssetManager.h"
 #include "Core/Engine.h"
 #include "Core/Macros.h"
 #include <fstream>
+#include <sstream>
 
 #undef CreateWindow
 
+void RenderingHelper::SetRenderingAPI(RenderingAPI api)
+{
+	API = api;
+}
+
+RenderingAPI RenderingHelper::GetRenderingAPI()
+{
+	return API;
+}
+
 std::shared_ptr<Window> RenderingHelper::CreateWindow(WindowSpecification specificeton)
 {
-	return std::make_shared<OpenGLWindow>(specificeton);
+	switch (API)
+	{
+	case RenderingAPI::Null: return std::make_shared<NullWindow>(specificeton);
+	default:                 return std::make_shared<OpenGLWindow>(specificeton);
+	}
+}
+
+static std::shared_ptr<VertexBuffer> CreateEmptyVertexBuffer(RenderingAPI api)
+{
+	switch (api)
+	{
+	case RenderingAPI::Null: return std::make_shared<NullVertexBuffer>();
+	default:                 return std::make_shared<OpenGLVertexBuffer>();
+	}
 }
 
 std::shared_ptr<VertexBuffer> RenderingHelper::CreateVertexBuffer(void* data, uint32_t size, const VertexBufferLayout& layout, BufferUsage usage)
 {
-	std::shared_ptr<VertexBuffer> buffer = std::make_shared<OpenGLVertexBuffer>();
+	std::shared_ptr<VertexBuffer> buffer = CreateEmptyVertexBuffer(API);
 	buffer->SetData(data, size, usage);
 	buffer->SetLayout(layout);
 
@@ -69,7 +113,7 @@ std::shared_ptr<VertexBuffer> RenderingHelper::CreateCubeVertexBuffer()
 			{ "texCoords", ShaderDataType::Float2 }
 	};
 
-	std::shared_ptr<VertexBuffer> buffer = std::make_shared<OpenGLVertexBuffer>();
+	std::shared_ptr<VertexBuffer> buffer = CreateEmptyVertexBuffer(API);
 	buffer->SetData(data, sizeof(data), BufferUsage::StaticDraw);
 	buffer->SetLayout(layout);
 
@@ -78,13 +122,74 @@ std::shared_ptr<VertexBuffer> RenderingHelper::CreateCubeVertexBuffer()
 
 std::shared_ptr<IndexBuffer> RenderingHelper::CreateIndexBuffer(void* data, uint32_t size, BufferUsage usage)
 {
-	std::shared_ptr<IndexBuffer> buffer = std::make_shared<OpenGLIndexBuffer>();
+	std::shared_ptr<IndexBuffer> buffer;
+	switch (API)
+	{
+	case RenderingAPI::Null: buffer = std::make_shared<NullIndexBuffer>(); break;
+	default:                 buffer = std::make_shared<OpenGLIndexBuffer>(); break;
+	}
+
+	buffer->SetData(data, size, usage);
+
+	return buffer;
+}
+
+std::shared_ptr<StorageBuffer> RenderingHelper::CreateStorageBuffer(void* data, uint32_t size, BufferUsage usage)
+{
+	std::shared_ptr<StorageBuffer> buffer;
+	switch (API)
+	{
+	case RenderingAPI::Null: buffer = std::make_shared<NullStorageBuffer>(); break;
+	default:                 buffer = std::make_shared<OpenGLStorageBuffer>(); break;
+	}
+
+	buffer->SetData(data, size, usage);
+
+	return buffer;
+}
+
+void RenderingHelper::UploadStorageBuffer(std::shared_ptr<StorageBuffer>& buffer, void* data, uint32_t size, BufferUsage usage)
+{
+	if (!buffer)
+	{
+		buffer = CreateStorageBuffer(data, size, usage);
+	}
+	else
+	{
+		// Respecifying the whole store lets the driver orphan the previous one instead of waiting for it
+		buffer->SetData(data, size, usage);
+	}
+}
+
+std::shared_ptr<UniformBuffer> RenderingHelper::CreateUniformBuffer(void* data, uint32_t size, BufferUsage usage)
+{
+	std::shared_ptr<UniformBuffer> buffer;
+	switch (API)
+	{
+	case RenderingAPI::Null: buffer = std::make_shared<NullUniformBuffer>(); break;
+	default:                 buffer = std::make_shared<OpenGLUniformBuffer>(); break;
+	}
+
 	buffer->SetData(data, size, usage);
 
 	return buffer;
 }
 
+std::shared_ptr<GPUTimer> RenderingHelper::CreateGPUTimer()
+{
+	switch (API)
+	{
+	case RenderingAPI::Null: return std::make_shared<NullGPUTimer>();
+	default:                 return std::make_shared<OpenGLGPUTimer>();
+	}
+}
+
 std::shared_ptr<Shader> RenderingHelper::CreateShader(const std::string& path)
+{
+	return CreateShader(path, {});
+}
+
+std::shared_ptr<Shader> RenderingHelper::CreateShader(const std::string& path, const std::vector<std::string>& defines)
 {
 	std::string source;
 	ShaderType currentShaderType = ShaderType::None;
@@ -95,7 +200,12 @@ std::shared_ptr<Shader> RenderingHelper::CreateShader(const std::string& path)
 
 	ED_ASSERT(file.is_open(), "Couldn't find a shader")
 	
-	std::shared_ptr<OpenGLShader> shader = std::make_shared<OpenGLShader>();
+	std::shared_ptr<Shader> shader;
+	switch (API)
+	{
+	case RenderingAPI::Null: shader = std::make_shared<NullShader>(); break;
+	default:                 shader = std::make_shared<OpenGLShader>(); break;
+	}
 
 	while (std::getline(file, line)) {
 		if (line.find("// type") != std::string::npos) {
@@ -123,8 +233,17 @@ std::shared_ptr<Shader> RenderingHelper::CreateShader(const std::string& path)
 				currentShaderType = ShaderType::None;
 			}
 		}
+		else if (line.find("#include") == 0) {
+			source += ReadShaderInclude(line);
+		}
 		else {
 			source += line + "\n";
+
+			if (line.find("#version") != std::string::npos) {
+				for (const std::string& define : defines) {
+					source += "#define " + define + "\n";
+				}
+			}
 		}
 	}
 
@@ -132,11 +251,31 @@ std::shared_ptr<Shader> RenderingHelper::CreateShader(const std::string& path)
 		shader->SetShaderCode(currentShaderType, source);
 	}
 
-	shader->LinkProgram();
+	if (API == RenderingAPI::OpenGL)
+	{
+		std::static_pointer_cast<OpenGLShader>(shader)->LinkProgram();
+	}
 
 	return shader;
 }
 
+std::string RenderingHelper::ReadShaderInclude(const std::string& line)
+{
+	size_t begin = line.find('"');
+	size_t end = line.rfind('"');
+
+	ED_ASSERT(begin != std::string::npos && begin < end, "Shader include path has to be in quotes")
+
+	std::fstream file(Files::ContentFolderPath + line.substr(begin + 1, end - begin - 1), std::ios_base::in);
+
+	ED_ASSERT(file.is_open(), "Couldn't find an included shader file")
+
+	std::stringstream ss;
+	ss << file.rdbuf();
+
+	return ss.str() + "\n";
+}
+
 std::shared_ptr<Texture> RenderingHelper::CreateRenderTarget(const RenderTargetSpecification& specification, TextureType textureType)
 {
 	std::shared_ptr<TextureImportParameters> parameters;
@@ -188,7 +327,12 @@ std::shared_ptr<Framebuffer> RenderingHelper::CreateFramebuffer(const std::strin
 
 std::shared_ptr<Framebuffer> RenderingHelper::CreateFramebuffer(const FramebufferSpecification& specification)
 {
-	std::shared_ptr<Framebuffer> framebuffer = std::make_shared<OpenGLFramebuffer>(specification);
+	std::shared_ptr<Framebuffer> framebuffer;
+	switch (API)
+	{
+	case RenderingAPI::Null: framebuffer = std::make_shared<NullFramebuffer>(specification); break;
+	default:                 framebuffer = std::make_shared<OpenGLFramebuffer>(specification); break;
+	}
 
 	for (const RenderTargetSpecification& targetSpecification : specification.RenderTargets)
 	{
@@ -201,7 +345,11 @@ std::shared_ptr<Framebuffer> RenderingHelper::CreateFramebuffer(const Framebuffe
 
 std::shared_ptr<Texture2D> RenderingHelper::CreateTexture2D(const std::string& name)
 {
-	return std::make_shared<OpenGLTexture2D>(name);
+	switch (API)
+	{
+	case RenderingAPI::Null: return std::make_shared<NullTexture2D>(name);
+	default:                 return std::make_shared<OpenGLTexture2D>(name);
+	}
 }
 
 std::shared_ptr<Texture2D> RenderingHelper::CreateTexture2D(const std::string& name, std::shared_ptr<Texture2DImportParameters> parameters, Texture2DData&& data)
@@ -225,7 +373,11 @@ std::shared_ptr<Texture2D> RenderingHelper::CreateTexture2D(const std::string& n
 
 std::shared_ptr<CubeTexture> RenderingHelper::CreateCubeTexture(const std::string& name)
 {
-	return std::make_shared<OpenGLCubeTexture>(name);
+	switch (API)
+	{
+	case RenderingAPI::Null: return std::make_shared<NullCubeTexture>(name);
+	default:                 return std::make_shared<OpenGLCubeTexture>(name);
+	}
 }
 
 std::shared_ptr<CubeTexture> RenderingHelper::CreateCubeTexture(const std::string& name, std::shared_ptr<CubeTextureImportParameters> parameters, CubeTextureData&& data)
@@ -250,7 +402,11 @@ std::shared_ptr<CubeTexture> RenderingHelper::CreateCubeTexture(const std::strin
 
 std::shared_ptr<Texture2DArray> RenderingHelper::CreateTexture2DArray(const std::string& name)
 {
-	return std::make_shared<OpenGLTexture2DArray>(name);
+	switch (API)
+	{
+	case RenderingAPI::Null: return std::make_shared<NullTexture2DArray>(name);
+	default:                 return std::make_shared<OpenGLTexture2DArray>(name);
+	}
 }
 
 std::shared_ptr<Texture2DArray> RenderingHelper::CreateTexture2DArray(const std::string& name, std::shared_ptr<Texture2DArrayImportParameters> parameters, Texture2DArrayData&& data)
@@ -378,38 +534,119 @@ std::shared_ptr<Texture2D> RenderingHelper::GetWhiteTexture()
 	return texutre;
 }
 
-bool RenderingHelper::IsLightMeshVisible(const std::vector<glm::vec3>& vertices, const Transform& transform, const Camera& camera)
+void RenderingHelper::FillShadowRenderQueue(RenderQueue& queue, const std::vector<std::shared_ptr<StaticMeshComponent>>& meshes)
 {
-	glm::mat4 projectionViewModelMatrix = camera.GetProjectionView() * transform.GetMatrix();
+	queue.Clear();
 
-	glm::vec3 leftBottonCorner(std::numeric_limits<float>::max());
-	glm::vec3 rightTopCorner(std::numeric_limits<float>::min());
+	for (const std::shared_ptr<StaticMeshComponent>& component : meshes)
+	{
+		if (std::shared_ptr<StaticMesh> mesh = component->GetStaticMesh())
+		{
+			DrawCommand command;
+			command.ModelMatrix = component->GetWorldMatrix();
+
+			for (const std::shared_ptr<StaticSubmesh>& submesh : mesh->GetSubmeshes())
+			{
+				if (submesh->GetMaterial())
+				{
+					command.Submesh = submesh.get();
+
+					uint64_t key = RenderQueue::MakeSortKey(RenderQueuePass::Shadow, 0, 0, queue.GetGeometryId(command.Submesh));
+					queue.Submit(key, command);
+				}
+			}
+		}
+	}
+
+	queue.Sort();
+	queue.BuildBatches();
+}
 
-	for (const glm::vec3& point : vertices)
+void RenderingHelper::FillShadowCasters(std::vector<ShadowCaster>& casters, const std::vector<std::shared_ptr<StaticMeshComponent>>& meshes)
+{
+	casters.resize(meshes.size());
+
+	for (uint32_t i = 0; i < meshes.size(); ++i)
 	{
-		glm::vec4 transformed = projectionViewModelMatrix * glm::vec4(point, 1.0f);
-		transformed /= transformed.w;
+		casters[i].Key = meshes[i].get();
+		casters[i].BoundingSphere = meshes[i]->GetWorldBoundingSphere();
+		casters[i].Generation = meshes[i]->GetWorldTransformGeneration();
+	}
+}
 
-		leftBottonCorner.x = glm::min(leftBottonCorner.x, transformed.x);
-		leftBottonCorner.y = glm::min(leftBottonCorner.y, transformed.y);
-		leftBottonCorner.z = glm::min(leftBottonCorner.z, transformed.z);
+// Distance from the camera to the corners of the near plane, volumes closer than it to the camera can be cut by the near plane
+static float GetNearPlaneMargin(const Camera& camera)
+{
+	return glm::length(camera.GetFrustum().Corners[0] - camera.GetPosition());
+}
 
-		rightTopCorner.x = glm::max(rightTopCorner.x, transformed.x);
-		rightTopCorner.y = glm::max(rightTopCorner.y, transformed.y);
-		rightTopCorner.z = glm::max(rightTopCorner.z, transformed.z);
+void RenderingHelper::ClassifyPointLights(const std::vector<std::shared_ptr<PointLightComponent>>& lights, const Camera& camera, std::vector<LightVolumeVisibility>& visibilities)
+{
+	const Frustum& frustum = camera.GetFrustum();
+	glm::vec3 cameraPosition = camera.GetPosition();
+	const float margin = GetNearPlaneMargin(camera);
+
+	visibilities.resize(lights.size());
+
+	for (uint32_t i = 0; i < lights.size(); ++i)
+	{
+		const std::shared_ptr<PointLightComponent>& light = lights[i];
+
+		glm::vec3 center = light->GetWorldTransform().GetTranslation();
+		float radius = light->GetRadius();
+
+		if (!frustum.IsSphereVisible(center, radius))
+		{
+			visibilities[i] = LightVolumeVisibility::Hidden;
+		}
+		else if (glm::length(cameraPosition - center) < radius + margin)
+		{
+			visibilities[i] = LightVolumeVisibility::ContainsCamera;
+		}
+		else
+		{
+			visibilities[i] = LightVolumeVisibility::Visible;
+		}
 	}
+}
 
-	bool xChangesSign = leftBottonCorner.x * rightTopCorner.x < 0;
-	bool yChangesSign = leftBottonCorner.y * rightTopCorner.y < 0;
-	bool zChangesSign = leftBottonCorner.z * rightTopCorner.z < 0;
+void RenderingHelper::ClassifySpotLights(const std::vector<std::shared_ptr<SpotLightComponent>>& lights, const Camera& camera, std::vector<LightVolumeVisibility>& visibilities)
+{
+	const Frustum& frustum = camera.GetFrustum();
+	glm::vec3 cameraPosition = camera.GetPosition();
+	const float margin = GetNearPlaneMargin(camera);
+
+	visibilities.resize(lights.size());
+
+	for (uint32_t i = 0; i < lights.size(); ++i)
+	{
+		const std::shared_ptr<SpotLightComponent>& light = lights[i];
 
-	bool xInViewRange = (leftBottonCorner.x >= -1.0f && leftBottonCorner.x <= 1.0f) || (rightTopCorner.x >= -1.0f && rightTopCorner.x <= 1.0f);
-	bool yInViewRange = (leftBottonCorner.y >= -1.0f && leftBottonCorner.y <= 1.0f) || (rightTopCorner.y >= -1.0f && rightTopCorner.y <= 1.0f);
-	bool zInViewRange = (leftBottonCorner.z >= 0.0f && leftBottonCorner.z <= 1.0f) || (rightTopCorner.z >= 0.0f && rightTopCorner.z <= 1.0f);
+		// Same cone as the light mesh, apex at the light and base at its max distance
+		Transform transform = light->GetWorldTransform();
+		glm::vec3 apex = transform.GetTranslation();
+		glm::vec3 direction = glm::normalize(transform.GetRotation() * glm::vec3(0.0f, -1.0f, 0.0f));
 
-	return (xChangesSign && yChangesSign && zChangesSign) || (xInViewRange && yInViewRange && zInViewRange) ||
-		(xChangesSign && yChangesSign && zInViewRange) || (yChangesSign && zChangesSign && xInViewRange) || (xChangesSign && zChangesSign && yInViewRange) ||
-		(xChangesSign && yInViewRange && zInViewRange) || (yChangesSign && xInViewRange && zInViewRange) || (zChangesSign && yInViewRange && xInViewRange);
+		float angle = light->GetOuterAngle();
+		float height = light->GetMaxDistance();
+		float radius = glm::tan(angle) * height;
+
+		if (!frustum.IsConeVisible(apex, direction, height, radius))
+		{
+			visibilities[i] = LightVolumeVisibility::Hidden;
+			continue;
+		}
+
+		// Cone grown by the margin in every direction
+		glm::vec3 offset = cameraPosition - apex;
+		float axisDistance = glm::dot(offset, direction);
+		float radialDistance = glm::length(offset - direction * axisDistance);
+
+		bool bIsInsideHeight = axisDistance >= -margin && axisDistance <= height + margin;
+		bool bIsInsideAngle = radialDistance <= glm::max(axisDistance, 0.0f) * glm::tan(angle) + margin / glm::cos(angle);
+
+		visibilities[i] = bIsInsideHeight && bIsInsideAngle ? LightVolumeVisibility::ContainsCamera : LightVolumeVisibility::Visible;
+	}
 }
 
 std::shared_ptr<Texture2DImportParameters> RenderingHelper::GetRenderTargetTexture2DImportParameters(FramebufferAttachmentType type)
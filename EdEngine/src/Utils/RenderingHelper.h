@@ -14,6 +14,9 @@
 
 class VertexBuffer;
 class IndexBuffer;
+class StorageBuffer;
+class UniformBuffer;
+class GPUTimer;
 class RenderingContext;
 
 class Texture;
@@ -36,12 +39,29 @@ struct FramebufferSpecification;
 struct RenderTargetSpecification;
 
 class RenderGraph;
+class RenderQueue;
+class StaticMeshComponent;
+class PointLightComponent;
+class SpotLightComponent;
+struct ShadowCaster;
 
 enum class FramebufferAttachmentType;
 
+enum class LightVolumeVisibility : uint8_t
+{
+	Hidden,
+	Visible,
+	// Camera is inside the volume or close enough for the near plane to cut it, only back faces of the light mesh are drawn
+	ContainsCamera
+};
+
 class RenderingHelper
 {
 public:
+	// Has to be set before the window is created, every object is created for this API
+	static void SetRenderingAPI(RenderingAPI api);
+	static RenderingAPI GetRenderingAPI();
+
 	static std::shared_ptr<Window> CreateWindow(WindowSpecification specificeton);
 
 	static std::shared_ptr<VertexBuffer> CreateVertexBuffer(void* data, uint32_t size, const class VertexBufferLayout& layout, BufferUsage usage);
@@ -49,7 +69,17 @@ public:
 
 	static std::shared_ptr<IndexBuffer> CreateIndexBuffer(void* data, uint32_t size, BufferUsage usage);
 
+	static std::shared_ptr<StorageBuffer> CreateStorageBuffer(void* data, uint32_t size, BufferUsage usage);
+	// Creates the buffer the first time, later uploads respecify its whole store
+	static void UploadStorageBuffer(std::shared_ptr<StorageBuffer>& buffer, void* data, uint32_t size, BufferUsage usage);
+	static std::shared_ptr<UniformBuffer> CreateUniformBuffer(void* data, uint32_t size, BufferUsage usage);
+
+	static std::shared_ptr<GPUTimer> CreateGPUTimer();
+
 	static std::shared_ptr<Shader> CreateShader(const std::string& path);
+	// Defines are inserted right after #version of every stage, used for shader variants.
+	// Lines starting with #include "path" are replaced with the content of the file
+	static std::shared_ptr<Shader> CreateShader(const std::string& path, const std::vector<std::string>& defines);
 
 	template<typename T>
 	static std::shared_ptr<T> CreateRenderTarget(const RenderTargetSpecification& specification, TextureType textureType)
@@ -85,13 +115,25 @@ public:
 	static std::shared_ptr<Texture2D> ImportMetalicTexture(const std::string& path);
 	static std::shared_ptr<Texture2D> ImportRoughnessTexture(const std::string& path);
 
-	static bool IsLightMeshVisible(const std::vector<glm::vec3>& vertices, const Transform& transform, const Camera& camera);
+	// Depth only draws don't depend on material, so casters are grouped only by geometry
+	static void FillShadowRenderQueue(RenderQueue& queue, const std::vector<std::shared_ptr<StaticMeshComponent>>& meshes);
+	// One caster per mesh component in the same order, keyed by the component
+	static void FillShadowCasters(std::vector<ShadowCaster>& casters, const std::vector<std::shared_ptr<StaticMeshComponent>>& meshes);
 
-private:
-	static inline std::shared_ptr<Texture2D> WhiteTexture;
+	// Light volumes tested against planes of the camera frustum, one visibility per light
+	static void ClassifyPointLights(const std::vector<std::shared_ptr<PointLightComponent>>& lights, const Camera& camera, std::vector<LightVolumeVisibility>& visibilities);
+	static void ClassifySpotLights(const std::vector<std::shared_ptr<SpotLightComponent>>& lights, const Camera& camera, std::vector<LightVolumeVisibility>& visibilities);
 
+	// Texture parameters render targets of an attachment type are created with, the render target pool matches textures by their format
 	static std::shared_ptr<Texture2DImportParameters> GetRenderTargetTexture2DImportParameters(FramebufferAttachmentType type);
 	static std::shared_ptr<CubeTextureImportParameters> GetRenderTargetCubeTextureImportParameters(FramebufferAttachmentType type);
 	static std::shared_ptr<Texture2DArrayImportParameters> GetRenderTargetTexture2DArrayImportParameters(FramebufferAttachmentType type);
 
+private:
+	static inline RenderingAPI API = RenderingAPI::OpenGL;
+
+	static inline std::shared_ptr<Texture2D> WhiteTexture;
+
+	static std::string ReadShaderInclude(const std::string& line);
+
 };
\ No newline at end of file
@@ -22,6 +22,13 @@ namespace boost
             }
         }
 
+        template <class Archive>
+        void serialize(Archive& ar, glm::vec2& vec, uint32_t version)
+        {
+            ar & vec.x;
+            ar & vec.y;
+        }
+
         template <class Archive>
         void serialize(Archive& ar, glm::vec3& vec, uint32_t version)
         {
@@ -0,0 +1,10 @@
+#include "Test.h"
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    // Optional argument runs only tests whose names contain it, e.g. "TriangleBVH."
+    std::string filter = argc > 1 ? argv[1] : "";
+
+    return TestRegistry::Get().Run(filter) == 0 ? 0 : 1;
+}
\ No newline at end of file
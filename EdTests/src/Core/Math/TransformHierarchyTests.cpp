@@ -0,0 +1,325 @@
+#include "Test.h"
+#include "Core/Math/TransformHierarchy.h"
+#include "Core/Components/Component.h"
+#include "Core/Objects/Actor.h"
+#include "Core/Scene.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <random>
+
+static const float Tolerance = 1e-3f;
+
+static Transform MakeRandomTransform(std::mt19937& random)
+{
+	std::uniform_real_distribution<float> translation(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+	std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+	glm::vec3 position = glm::vec3(translation(random), translation(random), translation(random));
+	glm::vec3 rotation = glm::vec3(angle(random), angle(random), angle(random));
+	glm::vec3 size = glm::vec3(scale(random), scale(random), scale(random));
+
+	return Transform(position, glm::quat(glm::radians(rotation)), size);
+}
+
+static float GetMaxDifference(const glm::mat4& left, const glm::mat4& right)
+{
+	float difference = 0.0f;
+	for (int32_t column = 0; column < 4; ++column)
+	{
+		for (int32_t row = 0; row < 4; ++row)
+		{
+			difference = glm::max(difference, glm::abs(left[column][row] - right[column][row]));
+		}
+	}
+
+	return difference;
+}
+
+static void CheckTransformsMatch(const Transform& value, const Transform& expected)
+{
+	ED_CHECK_NEAR(glm::length(value.GetTranslation() - expected.GetTranslation()), 0.0f, Tolerance)
+	ED_CHECK_NEAR(glm::abs(glm::dot(value.GetRotation(), expected.GetRotation())), 1.0f, Tolerance)
+	ED_CHECK_NEAR(glm::length(value.GetScale() - expected.GetScale()), 0.0f, Tolerance)
+}
+
+// Random tree of components mirrored by a hierarchy, components aren't in a scene so they walk their parent chain
+struct ComponentTree
+{
+	TransformHierarchy Hierarchy;
+	std::vector<std::shared_ptr<Component>> Components;
+	std::vector<TransformNode> Nodes;
+	std::vector<uint32_t> Parents;
+	std::vector<bool> AliveFlags;
+
+	static const uint32_t NoParent = UINT32_MAX;
+
+	ComponentTree(uint32_t count, std::mt19937& random)
+	{
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			uint32_t parent = NoParent;
+			if (i > 0 && random() % 8 != 0)
+			{
+				parent = random() % i;
+			}
+
+			std::shared_ptr<Component> component = std::make_shared<Component>();
+			component->SetRelativeTransform(MakeRandomTransform(random));
+
+			if (parent != NoParent)
+			{
+				component->SetOwnerComponent(Components[parent]);
+			}
+
+			Components.push_back(component);
+			Parents.push_back(parent);
+			AliveFlags.push_back(true);
+			Nodes.push_back(Hierarchy.Create(parent != NoParent ? Nodes[parent] : TransformHierarchy::InvalidNode, component->GetRelativeTransform()));
+		}
+	}
+
+	void SetLocal(uint32_t index, const Transform& transform)
+	{
+		Components[index]->SetRelativeTransform(transform);
+		Hierarchy.SetLocal(Nodes[index], transform);
+	}
+
+	// Children of the destroyed node are moved to its parent, components do the same
+	void Destroy(uint32_t index)
+	{
+		Hierarchy.Destroy(Nodes[index]);
+		AliveFlags[index] = false;
+
+		for (uint32_t i = 0; i < Components.size(); ++i)
+		{
+			if (AliveFlags[i] && Parents[i] == index)
+			{
+				Parents[i] = Parents[index];
+				Components[i]->SetOwnerComponent(Parents[i] != NoParent ? Components[Parents[i]] : nullptr);
+			}
+		}
+	}
+
+	bool IsInSubtree(uint32_t index, uint32_t root) const
+	{
+		for (uint32_t current = index; current != NoParent; current = Parents[current])
+		{
+			if (current == root)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void CheckMatchesComponents() const
+	{
+		for (uint32_t i = 0; i < Components.size(); ++i)
+		{
+			if (!AliveFlags[i])
+			{
+				continue;
+			}
+
+			Transform expected = Components[i]->GetWorldTransform();
+
+			ED_CHECK(!Hierarchy.IsDirty(Nodes[i]))
+			CheckTransformsMatch(Hierarchy.GetWorld(Nodes[i]), expected);
+
+			ED_CHECK_NEAR(GetMaxDifference(Hierarchy.GetWorldMatrix(Nodes[i]), expected.GetMatrix()), 0.0f, Tolerance)
+			ED_CHECK_NEAR(GetMaxDifference(Hierarchy.GetNormalMatrix(Nodes[i]), expected.GetInversedTransposedMatrix()), 0.0f, Tolerance)
+		}
+	}
+};
+
+ED_TEST(TransformHierarchy, MatchesComponentParentChains)
+{
+	std::mt19937 random(5);
+	ComponentTree tree(200, random);
+
+	tree.Hierarchy.Update();
+	ED_CHECK(tree.Hierarchy.GetLastUpdatedNodesCount() == 200)
+	tree.CheckMatchesComponents();
+
+	// Only moved subtrees are recomputed
+	uint32_t moved = 17;
+	tree.SetLocal(moved, MakeRandomTransform(random));
+
+	uint32_t subtreeSize = 0;
+	for (uint32_t i = 0; i < tree.Components.size(); ++i)
+	{
+		subtreeSize += tree.IsInSubtree(i, moved);
+	}
+
+	tree.Hierarchy.Update();
+	ED_CHECK(tree.Hierarchy.GetLastUpdatedNodesCount() == subtreeSize)
+	tree.CheckMatchesComponents();
+
+	for (uint32_t i = 0; i < 20; ++i)
+	{
+		tree.SetLocal(random() % tree.Components.size(), MakeRandomTransform(random));
+	}
+
+	tree.Hierarchy.Update();
+	tree.CheckMatchesComponents();
+}
+
+ED_TEST(TransformHierarchy, DestroyMovesChildrenToParent)
+{
+	std::mt19937 random(9);
+	ComponentTree tree(100, random);
+	tree.Hierarchy.Update();
+
+	// Nodes with children, their children have to be reparented
+	std::vector<uint32_t> destroyed;
+	for (uint32_t i = 0; i < tree.Components.size() && destroyed.size() < 10; ++i)
+	{
+		for (uint32_t j = i + 1; j < tree.Components.size(); ++j)
+		{
+			if (tree.Parents[j] == i)
+			{
+				destroyed.push_back(i);
+				break;
+			}
+		}
+	}
+
+	ED_CHECK(destroyed.size() == 10)
+
+	for (uint32_t index : destroyed)
+	{
+		uint32_t parent = tree.Parents[index];
+		std::vector<uint32_t> children;
+		for (uint32_t i = 0; i < tree.Components.size(); ++i)
+		{
+			if (tree.AliveFlags[i] && tree.Parents[i] == index)
+			{
+				children.push_back(i);
+			}
+		}
+
+		tree.Destroy(index);
+
+		for (uint32_t child : children)
+		{
+			TransformNode expected = parent != ComponentTree::NoParent ? tree.Nodes[parent] : TransformHierarchy::InvalidNode;
+			ED_CHECK(tree.Hierarchy.GetParent(tree.Nodes[child]) == expected)
+			ED_CHECK(tree.Hierarchy.IsDirty(tree.Nodes[child]))
+		}
+	}
+
+	ED_CHECK(tree.Hierarchy.GetNodesCount() == 90)
+
+	tree.Hierarchy.Update();
+	tree.CheckMatchesComponents();
+}
+
+ED_TEST(TransformHierarchy, GenerationChangesOnlyWithWorldTransform)
+{
+	std::mt19937 random(13);
+
+	TransformHierarchy hierarchy;
+	Transform rootTransform = MakeRandomTransform(random);
+	TransformNode root = hierarchy.Create(TransformHierarchy::InvalidNode, rootTransform);
+	TransformNode child = hierarchy.Create(root, MakeRandomTransform(random));
+	TransformNode other = hierarchy.Create(TransformHierarchy::InvalidNode, MakeRandomTransform(random));
+
+	hierarchy.Update();
+	uint32_t rootGeneration = hierarchy.GetGeneration(root);
+	uint32_t childGeneration = hierarchy.GetGeneration(child);
+	uint32_t otherGeneration = hierarchy.GetGeneration(other);
+
+	// Nothing changed
+	hierarchy.Update();
+	ED_CHECK(hierarchy.GetGeneration(root) == rootGeneration)
+	ED_CHECK(hierarchy.GetGeneration(child) == childGeneration)
+
+	// Same local transform set again
+	hierarchy.SetLocal(root, rootTransform);
+	ED_CHECK(!hierarchy.IsDirty(root))
+	hierarchy.Update();
+	ED_CHECK(hierarchy.GetGeneration(root) == rootGeneration)
+
+	// Moving the parent changes world transforms of the whole subtree
+	hierarchy.SetLocal(root, MakeRandomTransform(random));
+	ED_CHECK(hierarchy.IsDirty(child))
+	hierarchy.Update();
+	ED_CHECK(hierarchy.GetGeneration(root) != rootGeneration)
+	ED_CHECK(hierarchy.GetGeneration(child) != childGeneration)
+	ED_CHECK(hierarchy.GetGeneration(other) == otherGeneration)
+
+	// Reused node never has the generation a value cached for the destroyed one was stored with
+	childGeneration = hierarchy.GetGeneration(child);
+	hierarchy.Destroy(child);
+	TransformNode reused = hierarchy.Create(root, MakeRandomTransform(random));
+	ED_CHECK(reused == child)
+
+	hierarchy.Update();
+	ED_CHECK(hierarchy.GetGeneration(reused) != childGeneration)
+}
+
+ED_TEST(TransformHierarchy, BatchedMatricesMatchScalarOnes)
+{
+	std::mt19937 random(21);
+
+	// Not a multiple of four, so the batched path and the remainder both run
+	const uint32_t count = 4 * 8 + 3;
+
+	std::vector<Transform> transforms;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		transforms.push_back(MakeRandomTransform(random));
+	}
+
+	std::vector<glm::mat4> worldMatrices(count);
+	std::vector<glm::mat4> normalMatrices(count);
+	TransformHierarchy::ComposeMatrices(transforms.data(), count, worldMatrices.data(), normalMatrices.data());
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		// Single transform always goes through the scalar path
+		glm::mat4 worldMatrix;
+		glm::mat4 normalMatrix;
+		TransformHierarchy::ComposeMatrices(&transforms[i], 1, &worldMatrix, &normalMatrix);
+
+		ED_CHECK_NEAR(GetMaxDifference(worldMatrices[i], worldMatrix), 0.0f, 1e-5f)
+		ED_CHECK_NEAR(GetMaxDifference(normalMatrices[i], normalMatrix), 0.0f, 1e-5f)
+
+		ED_CHECK_NEAR(GetMaxDifference(worldMatrix, transforms[i].GetMatrix()), 0.0f, Tolerance)
+		ED_CHECK_NEAR(GetMaxDifference(normalMatrix, transforms[i].GetInversedTransposedMatrix()), 0.0f, Tolerance)
+	}
+}
+
+ED_TEST(TransformHierarchy, InitializingSceneKeepsActorTransform)
+{
+	Transform actorTransform(glm::vec3(5.0f, -2.0f, 3.0f), glm::quat(glm::radians(glm::vec3(0.0f, 90.0f, 0.0f))), glm::vec3(2.0f));
+	Transform componentTransform(glm::vec3(1.0f, 0.0f, 0.0f), glm::quat(glm::vec3(0.0f)));
+	Transform childTransform(glm::vec3(0.0f, 1.0f, 0.0f), glm::quat(glm::radians(glm::vec3(45.0f, 0.0f, 0.0f))));
+
+	std::shared_ptr<Actor> actor = std::make_shared<Actor>("Actor");
+	actor->SetTransform(actorTransform);
+
+	std::shared_ptr<Component> component = std::make_shared<Component>("Component");
+	component->SetRelativeTransform(componentTransform);
+	actor->RegisterComponent(component);
+
+	std::shared_ptr<Component> child = std::make_shared<Component>("Child");
+	child->SetRelativeTransform(childTransform);
+	child->SetOwnerComponent(component);
+	component->AddChild(child);
+
+	// Actor gets its nodes when it is added and the scene sets its scene again when it is initialized
+	std::shared_ptr<Scene> scene = std::make_shared<Scene>();
+	scene->AddActor(actor);
+	scene->Initialize();
+	scene->Update(0.0f);
+
+	ED_CHECK(component->GetWorldTransformGeneration() != 0)
+	ED_CHECK(child->GetWorldTransformGeneration() != 0)
+	ED_CHECK(scene->GetTransforms().GetParent(component->GetTransformNode()) == actor->GetTransformNode())
+
+	CheckTransformsMatch(component->GetWorldTransform(), componentTransform + actorTransform);
+	CheckTransformsMatch(child->GetWorldTransform(), childTransform + componentTransform + actorTransform);
+}
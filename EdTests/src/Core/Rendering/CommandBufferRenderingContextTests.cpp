@@ -0,0 +1,204 @@
+#include "Test.h"
+#include "Core/Rendering/CommandBufferRenderingContext.h"
+#include "Core/Rendering/PipelineState.h"
+#include "Platform/Rendering/Null/NullRenderingContext.h"
+#include "Platform/Rendering/Null/NullFramebuffer.h"
+#include "Platform/Rendering/Null/NullShader.h"
+#include "Platform/Rendering/Null/Buffers/NullVertexBuffer.h"
+#include "Platform/Rendering/Null/Buffers/NullIndexBuffer.h"
+#include "Platform/Rendering/Null/Buffers/NullStorageBuffer.h"
+#include "Platform/Rendering/Null/Buffers/NullUniformBuffer.h"
+#include "Platform/Rendering/Null/Textures/NullTexture2D.h"
+#include <sstream>
+
+// Null objects a frame is made of, commands refer to them through the object table of the buffer
+struct FrameObjects
+{
+	FrameObjects()
+	{
+		Shader = std::make_shared<NullShader>();
+		ComputeShader = std::make_shared<NullShader>();
+		Framebuffer = std::make_shared<NullFramebuffer>(FramebufferSpecification());
+		Texture = std::make_shared<NullTexture2D>("Texture");
+		Target = std::make_shared<NullTexture2D>("Target");
+		VertexBuffer = std::make_shared<NullVertexBuffer>();
+		IndexBuffer = std::make_shared<NullIndexBuffer>();
+		StorageBuffer = std::make_shared<NullStorageBuffer>();
+		UniformBuffer = std::make_shared<NullUniformBuffer>();
+
+		PipelineStateDescription description;
+		description.Shader = Shader;
+		description.bUseDepthTesting = true;
+		PipelineState = std::make_shared<class PipelineState>(description);
+	}
+
+	std::shared_ptr<class Shader> Shader;
+	std::shared_ptr<class Shader> ComputeShader;
+	std::shared_ptr<class Framebuffer> Framebuffer;
+	std::shared_ptr<class Texture> Texture;
+	std::shared_ptr<class Texture> Target;
+	std::shared_ptr<class VertexBuffer> VertexBuffer;
+	std::shared_ptr<class IndexBuffer> IndexBuffer;
+	std::shared_ptr<class StorageBuffer> StorageBuffer;
+	std::shared_ptr<class UniformBuffer> UniformBuffer;
+	std::shared_ptr<class PipelineState> PipelineState;
+};
+
+// Every kind of call a pass makes, uniforms are set by name, by C string and by location. Returns the number of calls made
+static uint32_t RecordFrame(RenderingContext& context, const FrameObjects& objects)
+{
+	context.SetFramebuffer(objects.Framebuffer);
+	context.SetViewport(0, 0, 1280, 720);
+	context.SetClearColor(glm::vec4(0.1f, 0.2f, 0.3f, 1.0f));
+	context.ClearColorTarget();
+	context.ClearDepthTarget();
+
+	context.SetPipelineState(objects.PipelineState);
+	context.SetShader(objects.Shader);
+	context.SetVertexBuffer(objects.VertexBuffer);
+	context.SetIndexBuffer(objects.IndexBuffer);
+	context.SetUniformBuffer(0, objects.UniformBuffer);
+	context.SetStorageBuffer(1, objects.StorageBuffer);
+
+	context.SetShaderDataTexture(std::string("u_Albedo"), objects.Texture);
+	context.SetShaderDataInt("u_Index", 7);
+	context.SetShaderDataFloat("u_Roughness", 0.5f);
+	context.SetShaderDataFloat2("u_Jitter", 0.25f, -0.25f);
+	context.SetShaderDataFloat3(std::string("u_Position"), glm::vec3(1.0f, 2.0f, 3.0f));
+	context.SetShaderDataMat4("u_Model", glm::mat4(2.0f));
+	context.SetShaderDataMat3("u_Normal", glm::mat3(3.0f));
+	context.SetShaderDataBool("u_bShadows", true);
+
+	int32_t location = objects.Shader->GetUniformLocation("u_Color");
+	context.SetShaderDataFloat4(location, glm::vec4(1.0f, 0.5f, 0.25f, 1.0f));
+	context.SetShaderDataFloat(location + 1, 2.0f);
+
+	context.Draw();
+	context.DrawInstanced(16, 4);
+	context.DrawInstanced(3, 0, DrawMode::Lines);
+
+	context.EnableBlending(BlendFactor::SourceAlpha, BlendFactor::OneMinusSourceAlpha);
+	context.SetBlending(BlendFactor::One, BlendFactor::One);
+	context.DisableBlending();
+	context.EnableDethTest(DepthTestFunction::Lesser);
+	context.SetDethTestFunction(DepthTestFunction::Greater);
+	context.DisableDethTest();
+	context.EnableFaceCulling();
+	context.EnableFaceCulling(Face::Front);
+	context.SetCullingFace(Face::Back);
+	context.DisableFaceCulling();
+
+	context.SetShader(objects.ComputeShader);
+	context.SetShaderDataImage("u_Output", objects.Target);
+	context.RunComputeShader(8, 8, 1);
+	context.Barier(BarrierType::AllBits);
+
+	context.ClearDepthTarget(objects.Target, glm::u32vec3(0), glm::u32vec3(64, 64, 1));
+	context.CopyTexture(objects.Texture, objects.Target, glm::u32vec3(0), glm::u32vec3(32, 32, 1));
+	context.SetDefaultFramebuffer();
+
+	return 41;
+}
+
+static bool AreEqual(const NullFrameStatistics& left, const NullFrameStatistics& right)
+{
+	return left.Draws == right.Draws && left.Instances == right.Instances && left.ComputeDispatches == right.ComputeDispatches
+		&& left.Barriers == right.Barriers && left.FramebufferBinds == right.FramebufferBinds && left.Clears == right.Clears
+		&& left.Copies == right.Copies && left.UniformUploads == right.UniformUploads;
+}
+
+static bool AreEqual(const RenderingStateStatistics& left, const RenderingStateStatistics& right)
+{
+	return left.PipelineStateChanges == right.PipelineStateChanges && left.EliminatedPipelineStateChanges == right.EliminatedPipelineStateChanges
+		&& left.StateChanges == right.StateChanges && left.EliminatedStateChanges == right.EliminatedStateChanges;
+}
+
+static std::string Serialize(const CommandBufferRenderingContext& commands)
+{
+	std::stringstream stream;
+	commands.Serialize(stream);
+	return stream.str();
+}
+
+ED_TEST(CommandBufferRenderingContext, ReplayMatchesDirectCalls)
+{
+	FrameObjects objects;
+
+	NullRenderingContext direct;
+	RecordFrame(direct, objects);
+	direct.ResetStatistics();
+
+	CommandBufferRenderingContext commands;
+	uint32_t callsCount = RecordFrame(commands, objects);
+	ED_CHECK(commands.GetCommandsCount() == callsCount)
+
+	// Nothing reaches a context while recording
+	ED_CHECK(commands.GetStatistics().StateChanges == 0)
+
+	NullRenderingContext replayed;
+	commands.Replay(replayed);
+	replayed.ResetStatistics();
+
+	const NullFrameStatistics& frame = direct.GetFrameStatistics();
+	ED_CHECK(frame.Draws == 3)
+	ED_CHECK(frame.Instances == 1 + 16 + 3)
+	ED_CHECK(frame.ComputeDispatches == 1)
+	ED_CHECK(frame.Barriers == 1)
+	ED_CHECK(frame.FramebufferBinds == 2)
+	ED_CHECK(frame.Clears == 3)
+	ED_CHECK(frame.Copies == 1)
+	ED_CHECK(frame.UniformUploads == 11)
+	ED_CHECK(direct.GetStatistics().PipelineStateChanges == 1)
+
+	ED_CHECK(AreEqual(replayed.GetFrameStatistics(), frame))
+	ED_CHECK(AreEqual(replayed.GetStatistics(), direct.GetStatistics()))
+	ED_CHECK(replayed.GetShader() == direct.GetShader())
+	ED_CHECK(replayed.GetShader() == objects.ComputeShader)
+}
+
+ED_TEST(CommandBufferRenderingContext, ReplayKeepsCommandsAndArguments)
+{
+	FrameObjects objects;
+
+	CommandBufferRenderingContext commands;
+	RecordFrame(commands, objects);
+
+	std::string recorded = Serialize(commands);
+	std::vector<uint8_t> data = commands.GetData();
+
+	// Replaying into another buffer records the same commands with the same arguments and objects
+	CommandBufferRenderingContext rerecorded;
+	commands.Replay(rerecorded);
+
+	ED_CHECK(rerecorded.GetCommandsCount() == commands.GetCommandsCount())
+	ED_CHECK(Serialize(rerecorded) == recorded)
+	ED_CHECK(rerecorded.GetData() == data)
+
+	// Buffer stays intact, so a second replay submits the same frame again
+	NullRenderingContext direct;
+	RecordFrame(direct, objects);
+	direct.ResetStatistics();
+
+	NullRenderingContext replayed;
+	for (uint32_t i = 0; i < 2; ++i)
+	{
+		commands.Replay(replayed);
+		replayed.ResetStatistics();
+
+		ED_CHECK(AreEqual(replayed.GetFrameStatistics(), direct.GetFrameStatistics()))
+		ED_CHECK(AreEqual(replayed.GetStatistics(), direct.GetStatistics()))
+	}
+
+	ED_CHECK(commands.GetData() == data)
+
+	// Reset drops everything, an empty buffer replays nothing
+	commands.Reset();
+	ED_CHECK(commands.GetCommandsCount() == 0)
+	ED_CHECK(commands.GetData().empty())
+
+	commands.Replay(replayed);
+	replayed.ResetStatistics();
+
+	ED_CHECK(AreEqual(replayed.GetFrameStatistics(), NullFrameStatistics()))
+	ED_CHECK(AreEqual(replayed.GetStatistics(), RenderingStateStatistics()))
+}
@@ -0,0 +1,108 @@
+#include "Test.h"
+#include "Core/Rendering/FullscreenPassFusion.h"
+
+static FullscreenPassDescription MakePass(const std::string& name, const std::string& feature, std::vector<uint32_t> writes = { 1 }, bool bClearsTargets = false)
+{
+	FullscreenPassDescription pass;
+	pass.Name = name;
+	pass.Feature = feature;
+	pass.Writes = writes;
+	pass.bClearsTargets = bClearsTargets;
+	return pass;
+}
+
+static bool IsGroup(const FusedPassGroup& group, uint32_t first, uint32_t last)
+{
+	return group.First == first && group.Last == last;
+}
+
+ED_TEST(FullscreenPassFusion, FusesAdjacentPasses)
+{
+	std::vector<FullscreenPassDescription> passes = {
+		MakePass("Ambient", "AMBIENT_PASS"),
+		MakePass("Emission", "EMISSION_PASS"),
+		MakePass("Resolution", "RESOLUTION_PASS")
+	};
+
+	std::vector<FusedPassGroup> groups = FullscreenPassFusion::FindGroups(passes);
+	ED_CHECK(groups.size() == 1)
+	ED_CHECK(IsGroup(groups[0], 0, 2))
+
+	// Defines keep the execution order, the uber shader applies the features in it
+	std::vector<std::string> defines = FullscreenPassFusion::GetDefines(passes, groups[0]);
+	ED_CHECK((defines == std::vector<std::string>{ "AMBIENT_PASS", "EMISSION_PASS", "RESOLUTION_PASS" }))
+	ED_CHECK(FullscreenPassFusion::GetName(passes, groups[0]) == "Ambient + Emission + Resolution")
+
+	// Nothing to fuse
+	ED_CHECK(FullscreenPassFusion::FindGroups({}).empty())
+	ED_CHECK(FullscreenPassFusion::FindGroups({ passes[0] }).empty())
+}
+
+ED_TEST(FullscreenPassFusion, NonFusablePassesBreakGroups)
+{
+	std::vector<FullscreenPassDescription> passes = {
+		MakePass("Ambient", "AMBIENT_PASS"),
+		MakePass("Emission", "EMISSION_PASS"),
+		MakePass("DirectionalLight", ""),
+		MakePass("Resolution", "RESOLUTION_PASS"),
+		MakePass("Grayscale", "GRAYSCALE_PASS")
+	};
+
+	std::vector<FusedPassGroup> groups = FullscreenPassFusion::FindGroups(passes);
+	ED_CHECK(groups.size() == 2)
+	ED_CHECK(IsGroup(groups[0], 0, 1))
+	ED_CHECK(IsGroup(groups[1], 3, 4))
+
+	ED_CHECK((FullscreenPassFusion::GetDefines(passes, groups[0]) == std::vector<std::string>{ "AMBIENT_PASS", "EMISSION_PASS" }))
+	ED_CHECK((FullscreenPassFusion::GetDefines(passes, groups[1]) == std::vector<std::string>{ "RESOLUTION_PASS", "GRAYSCALE_PASS" }))
+
+	// Other targets, a clear or no targets at all break a group too, the clearing pass can start the next one
+	passes = {
+		MakePass("Ambient", "AMBIENT_PASS", { 1 }),
+		MakePass("Emission", "EMISSION_PASS", { 1, 2 }),
+		MakePass("Resolution", "RESOLUTION_PASS", { 1, 2 }, true),
+		MakePass("Grayscale", "GRAYSCALE_PASS", { 1, 2 }),
+		MakePass("Ambient", "AMBIENT_PASS", {}),
+		MakePass("Emission", "EMISSION_PASS", {})
+	};
+
+	groups = FullscreenPassFusion::FindGroups(passes);
+	ED_CHECK(groups.size() == 1)
+	ED_CHECK(IsGroup(groups[0], 2, 3))
+	ED_CHECK((FullscreenPassFusion::GetDefines(passes, groups[0]) == std::vector<std::string>{ "RESOLUTION_PASS", "GRAYSCALE_PASS" }))
+}
+
+ED_TEST(FullscreenPassFusion, DisabledPassDoesNotBreakGroups)
+{
+	std::vector<FullscreenPassDescription> passes = {
+		MakePass("Resolution", "RESOLUTION_PASS"),
+		MakePass("FXAA", ""),
+		MakePass("Grayscale", "GRAYSCALE_PASS")
+	};
+
+	ED_CHECK(FullscreenPassFusion::FindGroups(passes).empty())
+
+	// Disabled passes are culled before the schedule is described, so their neighbours become adjacent
+	passes.erase(passes.begin() + 1);
+
+	std::vector<FusedPassGroup> groups = FullscreenPassFusion::FindGroups(passes);
+	ED_CHECK(groups.size() == 1)
+	ED_CHECK(IsGroup(groups[0], 0, 1))
+	ED_CHECK((FullscreenPassFusion::GetDefines(passes, groups[0]) == std::vector<std::string>{ "RESOLUTION_PASS", "GRAYSCALE_PASS" }))
+
+	// Disabled fusable pass leaves its feature out of the group
+	passes = {
+		MakePass("Ambient", "AMBIENT_PASS"),
+		MakePass("Emission", "EMISSION_PASS"),
+		MakePass("Resolution", "RESOLUTION_PASS")
+	};
+
+	groups = FullscreenPassFusion::FindGroups(passes);
+	ED_CHECK(groups.size() == 1 && FullscreenPassFusion::GetDefines(passes, groups[0]).size() == 3)
+
+	passes.erase(passes.begin() + 1);
+
+	groups = FullscreenPassFusion::FindGroups(passes);
+	ED_CHECK(groups.size() == 1)
+	ED_CHECK((FullscreenPassFusion::GetDefines(passes, groups[0]) == std::vector<std::string>{ "AMBIENT_PASS", "RESOLUTION_PASS" }))
+}
@@ -0,0 +1,96 @@
+#include "Test.h"
+#include "Core/Rendering/IrradianceVolumeBaker.h"
+#include "Core/Rendering/LightBakeScene.h"
+#include "Core/Assets/IrradianceVolume.h"
+#include "Core/JobSystem.h"
+#include <cstring>
+
+static const glm::vec3 VolumeMin = glm::vec3(-1.0f, 0.1f, -1.0f);
+static const glm::vec3 VolumeMax = glm::vec3(1.0f, 1.5f, 1.0f);
+static const glm::u32vec3 ProbesCount = glm::u32vec3(3, 2, 3);
+
+// Floor with a point light above it and a square between them, so probes see direct, blocked and bounced light
+static void BuildScene(LightBakeScene& scene)
+{
+	std::vector<glm::vec3> floor = {
+		glm::vec3(-1, 0, -1), glm::vec3(1, 0, -1), glm::vec3(1, 0, 1),
+		glm::vec3(-1, 0, -1), glm::vec3(1, 0, 1), glm::vec3(-1, 0, 1)
+	};
+	scene.AddTriangles(floor, std::vector<glm::vec3>(6, glm::vec3(0, 1, 0)), {}, glm::vec3(0.5f));
+
+	std::vector<glm::vec3> blocker = {
+		glm::vec3(-0.7f, 0.5f, -0.7f), glm::vec3(-0.3f, 0.5f, -0.7f), glm::vec3(-0.3f, 0.5f, -0.3f),
+		glm::vec3(-0.7f, 0.5f, -0.7f), glm::vec3(-0.3f, 0.5f, -0.3f), glm::vec3(-0.7f, 0.5f, -0.3f)
+	};
+	scene.AddTriangles(blocker, std::vector<glm::vec3>(6, glm::vec3(0, -1, 0)), {}, glm::vec3(0.8f));
+
+	BakeLight light;
+	light.Type = BakeLightType::Point;
+	light.Position = glm::vec3(-0.5f, 2.0f, -0.5f);
+	light.Radiance = glm::vec3(10.0f);
+	light.Range = 10.0f;
+	scene.AddLight(light);
+
+	scene.Build();
+}
+
+static IrradianceVolumeBakeSettings GetSettings()
+{
+	IrradianceVolumeBakeSettings settings;
+	settings.SamplesCount = 64;
+	settings.BouncesCount = 2;
+	settings.Seed = 7;
+	return settings;
+}
+
+static bool AreIdentical(const std::vector<SHL2>& first, const std::vector<SHL2>& second)
+{
+	return first.size() == second.size() && std::memcmp(first.data(), second.data(), first.size() * sizeof(SHL2)) == 0;
+}
+
+ED_TEST(IrradianceVolumeBaker, SameSceneBakesIdenticalProbes)
+{
+	IrradianceVolumeBakeSettings settings = GetSettings();
+
+	LightBakeScene firstScene;
+	BuildScene(firstScene);
+
+	JobSystem single(0);
+	std::vector<SHL2> first = IrradianceVolumeBaker::Bake(firstScene, VolumeMin, VolumeMax, ProbesCount, settings, single);
+	ED_CHECK(first.size() == ProbesCount.x * ProbesCount.y * ProbesCount.z)
+
+	// Scene built again and baked on workers, every probe seeds its own random numbers
+	LightBakeScene secondScene;
+	BuildScene(secondScene);
+
+	JobSystem workers(4);
+	std::vector<SHL2> second = IrradianceVolumeBaker::Bake(secondScene, VolumeMin, VolumeMax, ProbesCount, settings, workers);
+	ED_CHECK(AreIdentical(first, second))
+
+	// Baking again gives the same probes too
+	ED_CHECK(AreIdentical(IrradianceVolumeBaker::Bake(secondScene, VolumeMin, VolumeMax, ProbesCount, settings, workers), first))
+
+	// Probe is the same as the one baked on its own with its own random numbers
+	uint32_t mismatches = 0;
+	for (uint32_t index = 0; index < first.size(); ++index)
+	{
+		glm::u32vec3 probe = glm::u32vec3(index % ProbesCount.x, index / ProbesCount.x % ProbesCount.y, index / (ProbesCount.x * ProbesCount.y));
+		glm::vec3 position = IrradianceVolume::GetProbePosition(VolumeMin, VolumeMax, ProbesCount, probe);
+
+		BakeRandom random(settings.Seed, index);
+		SHL2 expected = IrradianceVolumeBaker::BakeProbe(firstScene, position, settings, random);
+
+		if (std::memcmp(&expected, &first[index], sizeof(SHL2)) != 0)
+		{
+			++mismatches;
+		}
+	}
+
+	ED_CHECK(mismatches == 0)
+
+	// Probes do receive light, and another seed traces other rays
+	ED_CHECK(first[ProbesCount.x * ProbesCount.y * ProbesCount.z - 1].Coefficients[0].x > 0.0f)
+
+	settings.Seed++;
+	ED_CHECK(!AreIdentical(IrradianceVolumeBaker::Bake(firstScene, VolumeMin, VolumeMax, ProbesCount, settings, single), first))
+}
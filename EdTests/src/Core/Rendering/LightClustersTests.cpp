@@ -0,0 +1,247 @@
+#include "Test.h"
+#include "Core/Rendering/LightClusters.h"
+#include "Core/JobSystem.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <limits>
+#include <random>
+
+static const float Fov = glm::radians(60.0f);
+static const float Aspect = 16.0f / 9.0f;
+static const float NearPlane = 0.1f;
+static const float FarPlane = 100.0f;
+
+static glm::mat4 GetView()
+{
+	return glm::lookAt(glm::vec3(2.0f, 3.0f, 10.0f), glm::vec3(0.0f, 0.0f, -10.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+static std::vector<ClusterLight> MakeLights(uint32_t count, std::mt19937& random)
+{
+	std::uniform_real_distribution<float> x(-20.0f, 20.0f);
+	std::uniform_real_distribution<float> y(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> z(-50.0f, 12.0f);
+	std::uniform_real_distribution<float> range(0.5f, 8.0f);
+	std::uniform_real_distribution<float> angle(glm::radians(10.0f), glm::radians(80.0f));
+	std::normal_distribution<float> direction;
+
+	std::vector<ClusterLight> lights(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		ClusterLight& light = lights[i];
+		light.Type = i % 2 == 0 ? ClusterLightType::Point : ClusterLightType::Spot;
+		light.Position = glm::vec3(x(random), y(random), z(random));
+		light.Range = range(random);
+
+		if (light.Type == ClusterLightType::Spot)
+		{
+			light.Direction = glm::normalize(glm::vec3(direction(random), direction(random), direction(random)));
+			light.OuterAngle = angle(random);
+		}
+	}
+
+	return lights;
+}
+
+static bool IsInsideLight(const ClusterLight& light, const glm::vec3& position)
+{
+	// Small margin so points right on the surface don't depend on rounding
+	glm::vec3 offset = position - light.Position;
+	float distance = glm::length(offset);
+	if (distance >= light.Range * 0.99f)
+	{
+		return false;
+	}
+
+	if (light.Type == ClusterLightType::Point || distance < 1e-4f)
+	{
+		return true;
+	}
+
+	return glm::dot(offset / distance, light.Direction) > glm::cos(light.OuterAngle * 0.99f);
+}
+
+// View space position of a point inside a froxel, fractions are in [0, 1] along x, y and depth
+static glm::vec3 GetFroxelPoint(uint32_t x, uint32_t y, uint32_t slice, const glm::vec3& fractions)
+{
+	float tanHalfFov = glm::tan(Fov / 2.0f);
+
+	float tileX = (2.0f * (x + fractions.x) / LightClusters::TilesX - 1.0f) * tanHalfFov * Aspect;
+	float tileY = (2.0f * (y + fractions.y) / LightClusters::TilesY - 1.0f) * tanHalfFov;
+	float depth = NearPlane * glm::pow(FarPlane / NearPlane, (slice + fractions.z) / LightClusters::Slices);
+
+	return glm::vec3(tileX * depth, tileY * depth, -depth);
+}
+
+static std::vector<std::vector<bool>> GetAssignedLights(const LightClusters& clusters, uint32_t lightsCount)
+{
+	std::vector<std::vector<bool>> assigned(LightClusters::ClustersCount, std::vector<bool>(lightsCount, false));
+	for (uint32_t i = 0; i < LightClusters::ClustersCount; ++i)
+	{
+		const LightCluster& cluster = clusters.GetClusters()[i];
+		for (uint32_t j = 0; j < cluster.Count; ++j)
+		{
+			assigned[i][clusters.GetLightIndices()[cluster.Offset + j]] = true;
+		}
+	}
+
+	return assigned;
+}
+
+ED_TEST(LightClusters, ParallelAssignmentMatchesInlineOne)
+{
+	std::mt19937 random(3);
+	std::vector<ClusterLight> lights = MakeLights(300, random);
+
+	JobSystem inlineJobs(0);
+	LightClusters inlineClusters;
+	inlineClusters.SetView(GetView(), Fov, Aspect, NearPlane, FarPlane);
+	inlineClusters.Assign(lights, inlineJobs);
+
+	JobSystem parallelJobs(4);
+	LightClusters parallelClusters;
+	parallelClusters.SetView(GetView(), Fov, Aspect, NearPlane, FarPlane);
+
+	// Assigned twice so scratch memory left from the first run is reused
+	parallelClusters.Assign(MakeLights(50, random), parallelJobs);
+	parallelClusters.Assign(lights, parallelJobs);
+
+	ED_CHECK(!inlineClusters.GetLightIndices().empty())
+	ED_CHECK(inlineClusters.GetLightIndices() == parallelClusters.GetLightIndices())
+
+	uint32_t mismatches = 0;
+	for (uint32_t i = 0; i < LightClusters::ClustersCount; ++i)
+	{
+		const LightCluster& inlineCluster = inlineClusters.GetClusters()[i];
+		const LightCluster& parallelCluster = parallelClusters.GetClusters()[i];
+
+		mismatches += inlineCluster.Offset != parallelCluster.Offset || inlineCluster.Count != parallelCluster.Count;
+	}
+
+	ED_CHECK(mismatches == 0)
+}
+
+ED_TEST(LightClusters, OverlapMaskMatchesScalarFallback)
+{
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> size(0.0f, 5.0f);
+
+	uint32_t mismatches = 0;
+	uint32_t overlaps = 0;
+
+	for (uint32_t i = 0; i < 10000; ++i)
+	{
+		float x[4], y[4], z[4], radius[4];
+		for (uint32_t lane = 0; lane < 4; ++lane)
+		{
+			x[lane] = position(random);
+			y[lane] = position(random);
+			z[lane] = position(random);
+			radius[lane] = size(random);
+		}
+
+		glm::vec3 boxMin = glm::vec3(position(random), position(random), position(random));
+		glm::vec3 boxMax = boxMin + glm::vec3(size(random), size(random), size(random));
+
+		uint32_t mask = LightClusters::GetOverlapMask(x, y, z, radius, boxMin, boxMax);
+		mismatches += mask != LightClusters::GetOverlapMaskScalar(x, y, z, radius, boxMin, boxMax);
+
+		for (uint32_t lane = 0; lane < 4; ++lane)
+		{
+			overlaps += (mask >> lane) & 1;
+		}
+	}
+
+	ED_CHECK(mismatches == 0)
+	ED_CHECK(overlaps > 0 && overlaps < 40000)
+}
+
+ED_TEST(LightClusters, ClustersContainEveryOverlappingLight)
+{
+	std::mt19937 random(11);
+	std::vector<ClusterLight> lights = MakeLights(40, random);
+
+	JobSystem jobs(0);
+	LightClusters clusters;
+	clusters.SetView(GetView(), Fov, Aspect, NearPlane, FarPlane);
+	clusters.Assign(lights, jobs);
+
+	std::vector<std::vector<bool>> assigned = GetAssignedLights(clusters, lights.size());
+	glm::mat4 view = GetView();
+	glm::mat4 inversedView = glm::inverse(view);
+
+	const uint32_t samples = 4;
+
+	uint32_t missed = 0;
+	uint32_t tooFar = 0;
+	uint32_t spotsInRange = 0;
+	uint32_t assignedSpots = 0;
+
+	for (uint32_t slice = 0; slice < LightClusters::Slices; ++slice)
+	{
+		for (uint32_t y = 0; y < LightClusters::TilesY; ++y)
+		{
+			for (uint32_t x = 0; x < LightClusters::TilesX; ++x)
+			{
+				uint32_t cluster = LightClusters::GetClusterIndex(x, y, slice);
+
+				// World space points inside the froxel and its view space bounds
+				std::vector<glm::vec3> points;
+				glm::vec3 boxMin = glm::vec3(std::numeric_limits<float>::max());
+				glm::vec3 boxMax = glm::vec3(-std::numeric_limits<float>::max());
+
+				for (uint32_t i = 0; i < samples * samples * samples; ++i)
+				{
+					glm::vec3 fractions = (glm::vec3(i % samples, i / samples % samples, i / samples / samples) + 0.5f) / (float)samples;
+					points.push_back(glm::vec3(inversedView * glm::vec4(GetFroxelPoint(x, y, slice, fractions), 1.0f)));
+				}
+
+				for (uint32_t i = 0; i < 8; ++i)
+				{
+					glm::vec3 corner = GetFroxelPoint(x, y, slice, glm::vec3(i & 1, (i >> 1) & 1, (i >> 2) & 1));
+					boxMin = glm::min(boxMin, corner);
+					boxMax = glm::max(boxMax, corner);
+				}
+
+				for (uint32_t i = 0; i < lights.size(); ++i)
+				{
+					const ClusterLight& light = lights[i];
+
+					bool bIsInside = false;
+					for (const glm::vec3& point : points)
+					{
+						bIsInside = bIsInside || IsInsideLight(light, point);
+					}
+
+					if (bIsInside && !assigned[cluster][i])
+					{
+						missed++;
+					}
+
+					// Nothing farther than the light range from the froxel may be assigned to it
+					glm::vec3 position = glm::vec3(view * glm::vec4(light.Position, 1.0f));
+					float distance = glm::length(glm::max(glm::max(boxMin - position, position - boxMax), glm::vec3(0.0f)));
+
+					bool bIsInRange = distance <= light.Range * 1.001f + 1e-3f;
+					if (assigned[cluster][i] && !bIsInRange)
+					{
+						tooFar++;
+					}
+
+					if (light.Type == ClusterLightType::Spot)
+					{
+						spotsInRange += bIsInRange;
+						assignedSpots += assigned[cluster][i];
+					}
+				}
+			}
+		}
+	}
+
+	ED_CHECK(missed == 0)
+	ED_CHECK(tooFar == 0)
+
+	// Cone test has to reject some of the froxels in range of spot lights
+	ED_CHECK(assignedSpots > 0)
+	ED_CHECK(assignedSpots < spotsInRange)
+}
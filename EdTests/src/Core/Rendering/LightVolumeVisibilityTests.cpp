@@ -0,0 +1,365 @@
+#include "Test.h"
+#include "Utils/RenderingHelper.h"
+#include "Utils/GeometryBuilder.h"
+#include "Core/Math/Camera.h"
+#include "Core/Components/PointLightComponent.h"
+#include "Core/Components/SpotLightComponent.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/constants.hpp>
+#include <limits>
+#include <random>
+
+// Same tessellation as the light meshes of the multipasses
+static const int32_t PointLightMeshSectorsCount = 30;
+static const int32_t PointLightMeshStackCount = 30;
+static const int32_t SpotLightMeshSectorsCount = 50;
+
+static const uint32_t CamerasCount = 64;
+static const uint32_t LightsCount = 64;
+static const uint32_t VolumeSamplesCount = 256;
+static const uint32_t NearPlaneSamplesCount = 16;
+
+// Samples closer than this to a plane or a volume surface aren't used as ground truth, float rounding can put them on either side
+static const float Epsilon = 1e-3f;
+
+// Light mesh test the light passes used before the analytic classification, light mesh vertices projected to NDC and their bounds tested against the view volume
+static bool IsLightMeshVisible(const std::vector<glm::vec3>& vertices, const Transform& transform, const Camera& camera)
+{
+	glm::mat4 projectionViewModelMatrix = camera.GetProjectionView() * transform.GetMatrix();
+
+	glm::vec3 leftBottonCorner(std::numeric_limits<float>::max());
+	glm::vec3 rightTopCorner(std::numeric_limits<float>::min());
+
+	for (const glm::vec3& point : vertices)
+	{
+		glm::vec4 transformed = projectionViewModelMatrix * glm::vec4(point, 1.0f);
+		transformed /= transformed.w;
+
+		leftBottonCorner.x = glm::min(leftBottonCorner.x, transformed.x);
+		leftBottonCorner.y = glm::min(leftBottonCorner.y, transformed.y);
+		leftBottonCorner.z = glm::min(leftBottonCorner.z, transformed.z);
+
+		rightTopCorner.x = glm::max(rightTopCorner.x, transformed.x);
+		rightTopCorner.y = glm::max(rightTopCorner.y, transformed.y);
+		rightTopCorner.z = glm::max(rightTopCorner.z, transformed.z);
+	}
+
+	bool xChangesSign = leftBottonCorner.x * rightTopCorner.x < 0;
+	bool yChangesSign = leftBottonCorner.y * rightTopCorner.y < 0;
+	bool zChangesSign = leftBottonCorner.z * rightTopCorner.z < 0;
+
+	bool xInViewRange = (leftBottonCorner.x >= -1.0f && leftBottonCorner.x <= 1.0f) || (rightTopCorner.x >= -1.0f && rightTopCorner.x <= 1.0f);
+	bool yInViewRange = (leftBottonCorner.y >= -1.0f && leftBottonCorner.y <= 1.0f) || (rightTopCorner.y >= -1.0f && rightTopCorner.y <= 1.0f);
+	bool zInViewRange = (leftBottonCorner.z >= 0.0f && leftBottonCorner.z <= 1.0f) || (rightTopCorner.z >= 0.0f && rightTopCorner.z <= 1.0f);
+
+	return (xChangesSign && yChangesSign && zChangesSign) || (xInViewRange && yInViewRange && zInViewRange) ||
+		(xChangesSign && yChangesSign && zInViewRange) || (yChangesSign && zChangesSign && xInViewRange) || (xChangesSign && zChangesSign && yInViewRange) ||
+		(xChangesSign && yInViewRange && zInViewRange) || (yChangesSign && xInViewRange && zInViewRange) || (zChangesSign && yInViewRange && xInViewRange);
+}
+
+// Projection of a vertex behind the camera flips, the mesh test means something only when the whole mesh is in front of it
+static bool IsMeshInFrontOfCamera(const std::vector<glm::vec3>& vertices, const Transform& transform, const Camera& camera)
+{
+	glm::mat4 projectionViewModelMatrix = camera.GetProjectionView() * transform.GetMatrix();
+
+	for (const glm::vec3& point : vertices)
+	{
+		if ((projectionViewModelMatrix * glm::vec4(point, 1.0f)).w <= 0.0f)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool IsInsideFrustum(const Frustum& frustum, const glm::vec3& point)
+{
+	for (const glm::vec4& plane : frustum.Planes)
+	{
+		if (glm::dot(glm::vec3(plane), point) + plane.w < Epsilon)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void GetNearPlaneSamples(const Camera& camera, std::vector<glm::vec3>& samples)
+{
+	const glm::vec3* corners = camera.GetFrustum().Corners;
+
+	samples.clear();
+	for (uint32_t i = 0; i <= NearPlaneSamplesCount; ++i)
+	{
+		for (uint32_t j = 0; j <= NearPlaneSamplesCount; ++j)
+		{
+			float u = 1.0f * i / NearPlaneSamplesCount;
+			float v = 1.0f * j / NearPlaneSamplesCount;
+
+			glm::vec3 bottom = glm::mix(corners[0], corners[3], u);
+			glm::vec3 top = glm::mix(corners[1], corners[2], u);
+			samples.push_back(glm::mix(bottom, top, v));
+		}
+	}
+}
+
+static std::vector<Camera> MakeCameras(std::mt19937& generator)
+{
+	std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> pitch(-80.0f, 80.0f);
+	std::uniform_real_distribution<float> yaw(-180.0f, 180.0f);
+	std::uniform_real_distribution<float> fov(45.0f, 90.0f);
+	std::uniform_real_distribution<float> nearDistance(0.1f, 1.0f);
+
+	std::vector<Camera> cameras;
+	for (uint32_t i = 0; i < CamerasCount; ++i)
+	{
+		float x = position(generator);
+		float y = position(generator);
+		float z = position(generator);
+
+		float cameraPitch = pitch(generator);
+		float cameraYaw = yaw(generator);
+		float cameraFov = fov(generator);
+		float cameraNear = nearDistance(generator);
+
+		cameras.emplace_back(cameraFov, 16.0f / 9.0f, cameraNear, 30.0f, glm::vec3(cameraPitch, cameraYaw, 0.0f), glm::vec3(x, y, z));
+	}
+
+	return cameras;
+}
+
+// Half of the lights are placed around the camera, so the camera is often inside or next to them
+static glm::vec3 GetLightPosition(std::mt19937& generator, const Camera& camera, uint32_t index, float size)
+{
+	std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+
+	if (index % 2 == 0)
+	{
+		float x = offset(generator);
+		float y = offset(generator);
+		float z = offset(generator);
+
+		return camera.GetPosition() + glm::vec3(x, y, z) * size * 1.5f;
+	}
+
+	float x = position(generator);
+	float y = position(generator);
+	float z = position(generator);
+
+	return glm::vec3(x, y, z);
+}
+
+static glm::quat GetRandomRotation(std::mt19937& generator)
+{
+	std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+
+	float pitch = angle(generator);
+	float yaw = angle(generator);
+	float roll = angle(generator);
+
+	return glm::quat(glm::radians(glm::vec3(pitch, yaw, roll)));
+}
+
+// Counts of cases the checks ran on, tests make sure every kind of case was hit
+struct VisibilityCounts
+{
+	uint32_t Hidden = 0;
+	uint32_t ContainsCamera = 0;
+	uint32_t MeshVisible = 0;
+	uint32_t SampledVisible = 0;
+	uint32_t NearPlaneCuts = 0;
+};
+
+static void CheckVisibility(LightVolumeVisibility visibility, bool bIsMeshVisible, bool bIsMeshInFront, bool bIsSampledVisible, bool bIsCutByNearPlane, VisibilityCounts& counts)
+{
+	// Whole volume behind one of the frustum planes puts every light mesh vertex outside of the NDC range on the same side
+	if (bIsMeshVisible && bIsMeshInFront)
+	{
+		ED_CHECK(visibility != LightVolumeVisibility::Hidden)
+		++counts.MeshVisible;
+	}
+
+	if (bIsSampledVisible)
+	{
+		ED_CHECK(visibility != LightVolumeVisibility::Hidden)
+		++counts.SampledVisible;
+	}
+
+	if (bIsCutByNearPlane)
+	{
+		ED_CHECK(visibility == LightVolumeVisibility::ContainsCamera)
+		++counts.NearPlaneCuts;
+	}
+
+	counts.Hidden += visibility == LightVolumeVisibility::Hidden;
+	counts.ContainsCamera += visibility == LightVolumeVisibility::ContainsCamera;
+}
+
+static void CheckCounts(const VisibilityCounts& counts)
+{
+	ED_CHECK(counts.Hidden > 0)
+	ED_CHECK(counts.ContainsCamera > 0)
+	ED_CHECK(counts.MeshVisible > 0)
+	ED_CHECK(counts.SampledVisible > 0)
+	ED_CHECK(counts.NearPlaneCuts > 0)
+}
+
+ED_TEST(LightVolumeVisibility, PointLightsMatchMeshTestAndSampledVolumes)
+{
+	std::mt19937 generator(11);
+	std::uniform_real_distribution<float> radiusDistribution(0.5f, 5.0f);
+	std::uniform_real_distribution<float> unitDistribution(-1.0f, 1.0f);
+
+	auto [vertices, indices] = GeometryBuilder::MakeSphere(1, PointLightMeshSectorsCount, PointLightMeshStackCount);
+
+	VisibilityCounts counts;
+	std::vector<glm::vec3> nearPlaneSamples;
+
+	for (const Camera& camera : MakeCameras(generator))
+	{
+		std::vector<std::shared_ptr<PointLightComponent>> lights;
+		for (uint32_t i = 0; i < LightsCount; ++i)
+		{
+			float radius = radiusDistribution(generator);
+
+			Transform transform;
+			transform.SetTranslation(GetLightPosition(generator, camera, i, radius));
+
+			std::shared_ptr<PointLightComponent> light = std::make_shared<PointLightComponent>();
+			light->SetRelativeTransform(transform);
+			light->SetRadius(radius);
+			lights.push_back(light);
+		}
+
+		std::vector<LightVolumeVisibility> visibilities;
+		RenderingHelper::ClassifyPointLights(lights, camera, visibilities);
+
+		ED_CHECK(visibilities.size() == lights.size())
+
+		GetNearPlaneSamples(camera, nearPlaneSamples);
+
+		for (uint32_t i = 0; i < lights.size(); ++i)
+		{
+			Transform transform = lights[i]->GetWorldTransform();
+			transform.SetScale(glm::vec3(lights[i]->GetRadius()));
+
+			glm::vec3 center = transform.GetTranslation();
+			float radius = lights[i]->GetRadius();
+
+			bool bIsSampledVisible = false;
+			for (uint32_t sample = 0; sample < VolumeSamplesCount && !bIsSampledVisible; ++sample)
+			{
+				float x = unitDistribution(generator);
+				float y = unitDistribution(generator);
+				float z = unitDistribution(generator);
+
+				glm::vec3 offset = glm::vec3(x, y, z);
+				if (glm::length(offset) <= 1.0f)
+				{
+					bIsSampledVisible = IsInsideFrustum(camera.GetFrustum(), center + offset * radius);
+				}
+			}
+
+			bool bIsCutByNearPlane = false;
+			for (const glm::vec3& sample : nearPlaneSamples)
+			{
+				bIsCutByNearPlane |= glm::length(sample - center) < radius - Epsilon;
+			}
+
+			bool bIsMeshVisible = IsLightMeshVisible(vertices, transform, camera);
+			bool bIsMeshInFront = IsMeshInFrontOfCamera(vertices, transform, camera);
+
+			CheckVisibility(visibilities[i], bIsMeshVisible, bIsMeshInFront, bIsSampledVisible || bIsCutByNearPlane, bIsCutByNearPlane, counts);
+		}
+	}
+
+	CheckCounts(counts);
+}
+
+ED_TEST(LightVolumeVisibility, SpotLightsMatchMeshTestAndSampledVolumes)
+{
+	std::mt19937 generator(17);
+	std::uniform_real_distribution<float> distanceDistribution(1.0f, 8.0f);
+	std::uniform_real_distribution<float> angleDistribution(glm::radians(5.0f), glm::radians(70.0f));
+	std::uniform_real_distribution<float> unitDistribution(0.0f, 1.0f);
+
+	auto [vertices, indices] = GeometryBuilder::MakeCone(SpotLightMeshSectorsCount);
+
+	VisibilityCounts counts;
+	std::vector<glm::vec3> nearPlaneSamples;
+
+	for (const Camera& camera : MakeCameras(generator))
+	{
+		std::vector<std::shared_ptr<SpotLightComponent>> lights;
+		for (uint32_t i = 0; i < LightsCount; ++i)
+		{
+			float distance = distanceDistribution(generator);
+			float angle = angleDistribution(generator);
+
+			Transform transform;
+			transform.SetTranslation(GetLightPosition(generator, camera, i, distance));
+			transform.SetRotation(GetRandomRotation(generator));
+
+			std::shared_ptr<SpotLightComponent> light = std::make_shared<SpotLightComponent>();
+			light->SetRelativeTransform(transform);
+			light->SetMaxDistance(distance);
+			light->SetOuterAngle(angle);
+			lights.push_back(light);
+		}
+
+		std::vector<LightVolumeVisibility> visibilities;
+		RenderingHelper::ClassifySpotLights(lights, camera, visibilities);
+
+		ED_CHECK(visibilities.size() == lights.size())
+
+		GetNearPlaneSamples(camera, nearPlaneSamples);
+
+		for (uint32_t i = 0; i < lights.size(); ++i)
+		{
+			const float angle = lights[i]->GetOuterAngle();
+			const float length = lights[i]->GetMaxDistance();
+			const float radius = glm::tan(angle) * length;
+
+			Transform transform = lights[i]->GetWorldTransform();
+			transform.SetScale(glm::vec3(radius, length, radius));
+
+			glm::vec3 apex = transform.GetTranslation();
+			glm::vec3 axis = transform.GetRotation() * glm::vec3(0.0f, -1.0f, 0.0f);
+			glm::vec3 tangent = transform.GetRotation() * glm::vec3(1.0f, 0.0f, 0.0f);
+			glm::vec3 bitangent = transform.GetRotation() * glm::vec3(0.0f, 0.0f, 1.0f);
+
+			bool bIsSampledVisible = false;
+			for (uint32_t sample = 0; sample < VolumeSamplesCount && !bIsSampledVisible; ++sample)
+			{
+				float height = unitDistribution(generator) * length;
+				float sampleRadius = unitDistribution(generator) * height * glm::tan(angle);
+				float sampleAngle = unitDistribution(generator) * 2.0f * glm::pi<float>();
+
+				glm::vec3 point = apex + axis * height + (tangent * glm::cos(sampleAngle) + bitangent * glm::sin(sampleAngle)) * sampleRadius;
+				bIsSampledVisible = IsInsideFrustum(camera.GetFrustum(), point);
+			}
+
+			bool bIsCutByNearPlane = false;
+			for (const glm::vec3& sample : nearPlaneSamples)
+			{
+				glm::vec3 offset = sample - apex;
+				float axisDistance = glm::dot(offset, axis);
+				float radialDistance = glm::length(offset - axis * axisDistance);
+
+				bIsCutByNearPlane |= axisDistance > Epsilon && axisDistance < length - Epsilon && radialDistance < axisDistance * glm::tan(angle) - Epsilon;
+			}
+
+			bool bIsMeshVisible = IsLightMeshVisible(vertices, transform, camera);
+			bool bIsMeshInFront = IsMeshInFrontOfCamera(vertices, transform, camera);
+
+			CheckVisibility(visibilities[i], bIsMeshVisible, bIsMeshInFront, bIsSampledVisible || bIsCutByNearPlane, bIsCutByNearPlane, counts);
+		}
+	}
+
+	CheckCounts(counts);
+}
@@ -0,0 +1,154 @@
+#include "Test.h"
+#include "Core/Rendering/LightmapBaker.h"
+#include "Core/Rendering/LightBakeScene.h"
+#include "Core/JobSystem.h"
+#include <cstring>
+
+static const glm::vec3 LightPosition = glm::vec3(-0.5f, 1.0f, -0.5f);
+static const float LightRadiance = 10.0f;
+static const float LightRange = 10.0f;
+
+static glm::vec2 GetFloorCoordinates(const glm::vec3& position)
+{
+	return glm::vec2(0.05f + 0.45f * (position.x + 1.0f), 0.05f + 0.45f * (position.z + 1.0f));
+}
+
+// Two by two floor with a point light above one of its quarters and a small square blocking the light right under it
+static void BuildScene(LightBakeScene& scene, std::vector<LightmapBakeInstance>& instances)
+{
+	std::vector<glm::vec3> floor = {
+		glm::vec3(-1, 0, -1), glm::vec3(1, 0, -1), glm::vec3(1, 0, 1),
+		glm::vec3(-1, 0, -1), glm::vec3(1, 0, 1), glm::vec3(-1, 0, 1)
+	};
+
+	std::vector<glm::vec2> coordinates;
+	for (const glm::vec3& corner : floor)
+	{
+		coordinates.push_back(GetFloorCoordinates(corner));
+	}
+
+	LightmapBakeInstance& instance = instances.emplace_back();
+	instance.FirstTriangle = scene.AddTriangles(floor, std::vector<glm::vec3>(6, glm::vec3(0, 1, 0)), coordinates, glm::vec3(0.5f));
+	instance.TrianglesCount = 2;
+	instance.Resolution = 32;
+
+	std::vector<glm::vec3> blocker = {
+		glm::vec3(-0.7f, 0.5f, -0.7f), glm::vec3(-0.3f, 0.5f, -0.7f), glm::vec3(-0.3f, 0.5f, -0.3f),
+		glm::vec3(-0.7f, 0.5f, -0.7f), glm::vec3(-0.3f, 0.5f, -0.3f), glm::vec3(-0.7f, 0.5f, -0.3f)
+	};
+	scene.AddTriangles(blocker, std::vector<glm::vec3>(6, glm::vec3(0, -1, 0)), {}, glm::vec3(0.8f));
+
+	BakeLight light;
+	light.Type = BakeLightType::Point;
+	light.Position = LightPosition;
+	light.Radiance = glm::vec3(LightRadiance);
+	light.Range = LightRange;
+	scene.AddLight(light);
+
+	scene.Build();
+}
+
+static glm::vec3 GetTexel(const LightmapBaker& baker, const LightmapBakeInstance& instance, const glm::vec3& position)
+{
+	glm::vec2 coordinates = GetFloorCoordinates(position);
+	glm::vec2 atlasCoordinates = coordinates * glm::vec2(instance.ScaleOffset.x, instance.ScaleOffset.y) + glm::vec2(instance.ScaleOffset.z, instance.ScaleOffset.w);
+
+	uint32_t size = baker.GetSize();
+	uint32_t x = atlasCoordinates.x * size;
+	uint32_t y = atlasCoordinates.y * size;
+
+	return baker.GetTexels()[y * size + x];
+}
+
+ED_TEST(LightBakeScene, DirectIrradianceMatchesLightFalloff)
+{
+	LightBakeScene scene;
+	std::vector<LightmapBakeInstance> instances;
+	BuildScene(scene, instances);
+
+	glm::vec3 position = glm::vec3(0.6f, 0.0f, 0.6f);
+	glm::vec3 toLight = LightPosition - position;
+
+	// Same falloff as the point light shader
+	float distanceSquared = glm::dot(toLight, toLight);
+	float ratio = distanceSquared / (LightRange * LightRange);
+	float falloff = glm::clamp(1.0f - ratio * ratio, 0.0f, 1.0f);
+	float expected = LightRadiance * falloff * falloff / (distanceSquared + 1.0f) * (toLight.y / std::sqrt(distanceSquared));
+
+	ED_CHECK_NEAR(scene.GetDirectIrradiance(position, glm::vec3(0, 1, 0)).x, expected, 1e-4f)
+
+	// Right under the blocker
+	ED_CHECK(scene.GetDirectIrradiance(glm::vec3(-0.5f, 0.0f, -0.5f), glm::vec3(0, 1, 0)).x == 0.0f)
+	// Facing away from the light
+	ED_CHECK(scene.GetDirectIrradiance(position, glm::vec3(0, -1, 0)).x == 0.0f)
+}
+
+ED_TEST(LightmapBaker, ShadowedTexelsAreDarker)
+{
+	LightBakeScene scene;
+	std::vector<LightmapBakeInstance> instances;
+	BuildScene(scene, instances);
+
+	LightmapBakeSettings settings;
+	settings.SamplesCount = 32;
+	settings.BouncesCount = 2;
+
+	JobSystem jobs(2);
+	LightmapBaker baker;
+	ED_CHECK(baker.Bake(scene, instances, settings, jobs))
+
+	ED_CHECK(baker.GetSize() > 0)
+	ED_CHECK(baker.GetTexels().size() == baker.GetSize() * baker.GetSize())
+
+	glm::vec3 shadowed = GetTexel(baker, instances[0], glm::vec3(-0.5f, 0.0f, -0.5f));
+	glm::vec3 lit = GetTexel(baker, instances[0], glm::vec3(0.6f, 0.0f, 0.6f));
+	ED_CHECK(shadowed.x < lit.x)
+
+	for (const glm::vec3& texel : baker.GetTexels())
+	{
+		ED_CHECK(std::isfinite(texel.x) && texel.x >= 0.0f)
+	}
+}
+
+ED_TEST(LightmapBaker, ResultDoesntDependOnThreads)
+{
+	LightmapBakeSettings settings;
+	settings.SamplesCount = 16;
+	settings.BouncesCount = 2;
+
+	LightBakeScene firstScene;
+	std::vector<LightmapBakeInstance> firstInstances;
+	BuildScene(firstScene, firstInstances);
+
+	JobSystem single(0);
+	LightmapBaker first;
+	ED_CHECK(first.Bake(firstScene, firstInstances, settings, single))
+
+	LightBakeScene secondScene;
+	std::vector<LightmapBakeInstance> secondInstances;
+	BuildScene(secondScene, secondInstances);
+
+	JobSystem workers(4);
+	LightmapBaker second;
+	ED_CHECK(second.Bake(secondScene, secondInstances, settings, workers))
+
+	ED_CHECK(first.GetTexels().size() == second.GetTexels().size())
+	ED_CHECK(std::memcmp(first.GetTexels().data(), second.GetTexels().data(), first.GetTexels().size() * sizeof(glm::vec3)) == 0)
+	ED_CHECK(firstInstances[0].ScaleOffset == secondInstances[0].ScaleOffset)
+}
+
+ED_TEST(LightmapBaker, FailsWhenInstancesDontFit)
+{
+	LightBakeScene scene;
+	std::vector<LightmapBakeInstance> instances;
+	BuildScene(scene, instances);
+
+	instances[0].Resolution = 256;
+
+	LightmapBakeSettings settings;
+	settings.MaxAtlasSize = 128;
+
+	JobSystem jobs(0);
+	LightmapBaker baker;
+	ED_CHECK(!baker.Bake(scene, instances, settings, jobs))
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "Test.h"
+#include "Core/Rendering/LightmapUnwrap.h"
+
+static float Cross(const glm::vec2& a, const glm::vec2& b)
+{
+	return a.x * b.y - a.y * b.x;
+}
+
+static void AddCube(LightmapUnwrapSection& section)
+{
+	const glm::vec3 normals[] = { glm::vec3(1, 0, 0), glm::vec3(-1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(0, -1, 0), glm::vec3(0, 0, 1), glm::vec3(0, 0, -1) };
+
+	for (const glm::vec3& normal : normals)
+	{
+		glm::vec3 tangent = normal.x != 0.0f ? glm::vec3(0, 1, 0) : glm::vec3(1, 0, 0);
+		glm::vec3 bitangent = glm::cross(normal, tangent);
+
+		int32_t first = section.Positions.size();
+		section.Positions.push_back(normal - tangent - bitangent);
+		section.Positions.push_back(normal + tangent - bitangent);
+		section.Positions.push_back(normal + tangent + bitangent);
+		section.Positions.push_back(normal - tangent + bitangent);
+
+		for (int32_t index : { 0, 1, 2, 0, 2, 3 })
+		{
+			section.Indices.push_back(first + index);
+		}
+	}
+}
+
+static void AddBumpyGrid(LightmapUnwrapSection& section, int32_t size)
+{
+	for (int32_t y = 0; y <= size; ++y)
+	{
+		for (int32_t x = 0; x <= size; ++x)
+		{
+			section.Positions.push_back(glm::vec3(x * 0.3f + 5.0f, std::sin(x * 0.7f) * std::cos(y * 0.5f), y * 0.3f));
+		}
+	}
+
+	for (int32_t y = 0; y < size; ++y)
+	{
+		for (int32_t x = 0; x < size; ++x)
+		{
+			int32_t corner = y * (size + 1) + x;
+			for (int32_t index : { corner, corner + size + 1, corner + 1, corner + 1, corner + size + 1, corner + size + 2 })
+			{
+				section.Indices.push_back(index);
+			}
+		}
+	}
+}
+
+ED_TEST(LightmapUnwrap, TrianglesKeepTheirCornersAndDontOverlap)
+{
+	std::vector<LightmapUnwrapSection> sections(2);
+	AddCube(sections[0]);
+	AddBumpyGrid(sections[1], 20);
+
+	const uint32_t resolution = 128;
+	ED_CHECK(LightmapUnwrap::Unwrap(sections, resolution))
+
+	// Coverage is tested on a grid finer than texels, so triangles touching only at their edges aren't counted as overlapping
+	const uint32_t samples = 4 * resolution;
+	std::vector<int32_t> owners(samples * samples, -1);
+
+	int32_t triangle = 0;
+	uint32_t overlaps = 0;
+
+	for (const LightmapUnwrapSection& section : sections)
+	{
+		ED_CHECK(section.UnwrappedIndices.size() == section.Indices.size())
+		ED_CHECK(section.SourceVertices.size() == section.Coordinates.size())
+
+		for (uint32_t i = 0; i < section.UnwrappedIndices.size(); ++i)
+		{
+			ED_CHECK(section.Positions[section.SourceVertices[section.UnwrappedIndices[i]]] == section.Positions[section.Indices[i]])
+		}
+
+		for (const glm::vec2& coordinate : section.Coordinates)
+		{
+			ED_CHECK(coordinate.x >= 0.0f && coordinate.y >= 0.0f && coordinate.x <= 1.0f && coordinate.y <= 1.0f)
+		}
+
+		for (uint32_t i = 0; i < section.UnwrappedIndices.size(); i += 3, ++triangle)
+		{
+			glm::vec2 a = section.Coordinates[section.UnwrappedIndices[i]] * float(samples);
+			glm::vec2 b = section.Coordinates[section.UnwrappedIndices[i + 1]] * float(samples);
+			glm::vec2 c = section.Coordinates[section.UnwrappedIndices[i + 2]] * float(samples);
+
+			float area = Cross(b - a, c - a);
+			ED_CHECK(area != 0.0f)
+
+			for (uint32_t y = 0; y < samples; ++y)
+			{
+				for (uint32_t x = 0; x < samples; ++x)
+				{
+					glm::vec2 point = glm::vec2(x + 0.5f, y + 0.5f);
+
+					float weightA = Cross(c - b, point - b) / area;
+					float weightB = Cross(a - c, point - c) / area;
+					float weightC = 1.0f - weightA - weightB;
+
+					if (weightA > 1e-4f && weightB > 1e-4f && weightC > 1e-4f)
+					{
+						overlaps += owners[y * samples + x] >= 0;
+						owners[y * samples + x] = triangle;
+					}
+				}
+			}
+		}
+	}
+
+	ED_CHECK(overlaps == 0)
+}
+
+ED_TEST(LightmapUnwrap, FailsWhenChartsDontFit)
+{
+	std::vector<LightmapUnwrapSection> sections(1);
+
+	// Triangles far apart are separate charts, each needs padding around it
+	for (int32_t i = 0; i < 500; ++i)
+	{
+		glm::vec3 origin = glm::vec3(i * 3.0f, 0.0f, 0.0f);
+
+		int32_t first = sections[0].Positions.size();
+		sections[0].Positions.push_back(origin);
+		sections[0].Positions.push_back(origin + glm::vec3(1.0f, 0.0f, 0.0f));
+		sections[0].Positions.push_back(origin + glm::vec3(0.0f, 1.0f, 0.0f));
+
+		for (int32_t index : { 0, 1, 2 })
+		{
+			sections[0].Indices.push_back(first + index);
+		}
+	}
+
+	ED_CHECK(!LightmapUnwrap::Unwrap(sections, 16))
+	ED_CHECK(sections[0].Coordinates.empty())
+}
\ No newline at end of file
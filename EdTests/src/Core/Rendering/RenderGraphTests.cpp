@@ -0,0 +1,340 @@
+#include "Test.h"
+#include "Core/Rendering/RenderGraph.h"
+#include "Core/Rendering/Passes/RenderPass.h"
+#include "Platform/Rendering/Null/NullGPUTimer.h"
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <thread>
+
+// Graph recording into a command buffer instead of a graphics API context, so what reached the context can be compared
+class RecordingRenderGraph : public RenderGraph
+{
+public:
+	RecordingRenderGraph()
+	{
+		m_Context = std::make_shared<CommandBufferRenderingContext>();
+		m_Profiler.SetTimer(std::make_shared<NullGPUTimer>());
+	}
+
+	std::string GetRecordedCommands() const
+	{
+		std::stringstream stream;
+		std::static_pointer_cast<CommandBufferRenderingContext>(m_Context)->Serialize(stream);
+		return stream.str();
+	}
+};
+
+// Stands for a shadow or a shading pass of a light, every item is a viewport naming the light and the pass. Recording waits a bit
+// for another thread to record at the same time, so overlapping records are seen even when items are cheap
+class LightItemPass : public RenderPass<ComputeRenderPassParameters, ShaderParameters>
+{
+public:
+	LightItemPass(const std::string& name, uint32_t id)
+	{
+		m_Parameters.Name = name;
+		m_Id = id;
+	}
+
+	virtual void PrepareItem(uint32_t index) override
+	{
+		ED_CHECK(std::this_thread::get_id() == MainThread)
+		++PreparedItems;
+	}
+
+	virtual void RecordItem(uint32_t index, const std::shared_ptr<RenderingContext>& context) override
+	{
+		uint32_t recording = ++RecordingPasses;
+
+		uint32_t maximum = MaxRecordingPasses;
+		while (recording > maximum && !MaxRecordingPasses.compare_exchange_weak(maximum, recording))
+		{
+		}
+
+		auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(20);
+		while (MaxRecordingPasses < 2 && bWaitForOthers && std::chrono::steady_clock::now() < end)
+		{
+			std::this_thread::yield();
+		}
+
+		if (std::this_thread::get_id() != MainThread)
+		{
+			++WorkerRecords;
+		}
+
+		context->SetViewport(index, m_Id, 1, 1);
+		context->Draw();
+
+		--RecordingPasses;
+	}
+
+	static void Reset(bool bWait)
+	{
+		MainThread = std::this_thread::get_id();
+		PreparedItems = 0;
+		RecordingPasses = 0;
+		MaxRecordingPasses = 0;
+		WorkerRecords = 0;
+		bWaitForOthers = bWait;
+	}
+
+	static inline std::thread::id MainThread;
+	static inline std::atomic<uint32_t> PreparedItems = 0;
+	static inline std::atomic<uint32_t> RecordingPasses = 0;
+	static inline std::atomic<uint32_t> MaxRecordingPasses = 0;
+	static inline std::atomic<uint32_t> WorkerRecords = 0;
+	static inline bool bWaitForOthers = false;
+
+private:
+	uint32_t m_Id = 0;
+};
+
+static const uint32_t LightsCount = 16;
+
+// Items the light multipasses build, a shadow and a shading pass per light, and the commands they have to produce in that order
+static std::string RecordLights(RecordingRenderGraph& graph, std::string& expected)
+{
+	std::shared_ptr<LightItemPass> shadowPass = std::make_shared<LightItemPass>("Shadow", 0);
+	std::shared_ptr<LightItemPass> shadingPass = std::make_shared<LightItemPass>("Shading", 1);
+
+	std::vector<RenderGraphItem> items;
+	for (uint32_t i = 0; i < LightsCount; ++i)
+	{
+		RenderGraphItem& item = items.emplace_back();
+		item.Name = std::to_string(i) + ". Light";
+		item.Index = i * 3;
+		item.Passes = { shadowPass, shadingPass };
+
+		shadowPass->PrepareItem(item.Index);
+		shadingPass->PrepareItem(item.Index);
+	}
+
+	CommandBufferRenderingContext expectedCommands;
+	for (const RenderGraphItem& item : items)
+	{
+		for (uint32_t pass = 0; pass < item.Passes.size(); ++pass)
+		{
+			expectedCommands.SetShader(nullptr);
+			expectedCommands.SetViewport(item.Index, pass, 1, 1);
+			expectedCommands.Draw();
+		}
+	}
+
+	std::stringstream stream;
+	expectedCommands.Serialize(stream);
+	expected = stream.str();
+
+	graph.GetProfiler().BeginFrame();
+	graph.RecordItems(items);
+	graph.GetProfiler().EndFrame();
+
+	return graph.GetRecordedCommands();
+}
+
+ED_TEST(RenderGraph, LightsAreRecordedOnWorkersAndReplayedInOrder)
+{
+	RecordingRenderGraph graph;
+	LightItemPass::Reset(true);
+
+	std::string expected;
+	std::string commands = RecordLights(graph, expected);
+
+	ED_CHECK(LightItemPass::PreparedItems == 2 * LightsCount)
+	ED_CHECK(commands == expected)
+
+	// Nothing can run next to the main thread on a single core machine, items are still recorded through the same path
+	if (graph.GetJobSystem().GetWorkersCount() > 0)
+	{
+		ED_CHECK(LightItemPass::MaxRecordingPasses >= 2)
+		ED_CHECK(LightItemPass::WorkerRecords > 0)
+	}
+}
+
+ED_TEST(RenderGraph, LightsAreRecordedInlineWhenParallelRecordingIsDisabled)
+{
+	RecordingRenderGraph graph;
+	graph.SetParallelRecordingEnabled(false);
+	LightItemPass::Reset(false);
+
+	std::string expected;
+	std::string commands = RecordLights(graph, expected);
+
+	ED_CHECK(commands == expected)
+	ED_CHECK(LightItemPass::MaxRecordingPasses == 1)
+	ED_CHECK(LightItemPass::WorkerRecords == 0)
+}
+
+// Graph whose nodes are set directly instead of being built from passes, so its cycle check can run on synthetic graphs
+class SyntheticRenderGraph : public RenderGraph
+{
+public:
+	void CheckNodesForCycles(const std::vector<std::shared_ptr<RenderGraphNode>>& nodes)
+	{
+		m_Nodes = nodes;
+		CheckGraphForCycles();
+	}
+};
+
+static void AddEdge(const std::shared_ptr<RenderGraphNode>& upstream, const std::shared_ptr<RenderGraphNode>& downstream)
+{
+	upstream->Downstream.push_back(downstream);
+	downstream->Upstream.push_back(upstream);
+}
+
+static std::vector<std::shared_ptr<RenderGraphNode>> MakeNodes(uint32_t count)
+{
+	std::vector<std::shared_ptr<RenderGraphNode>> nodes;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		std::shared_ptr<RenderGraphNode> node = std::make_shared<RenderGraphNode>();
+		node->Index = i;
+		nodes.push_back(node);
+	}
+
+	return nodes;
+}
+
+// Every node reads a few nodes placed before it in a random order, so node indices don't follow the dependencies
+static std::vector<std::shared_ptr<RenderGraphNode>> MakeRandomGraph(uint32_t count, uint32_t maxInputs, std::mt19937& random)
+{
+	std::vector<std::shared_ptr<RenderGraphNode>> nodes = MakeNodes(count);
+
+	std::vector<uint32_t> placement(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		placement[i] = i;
+	}
+	std::shuffle(placement.begin(), placement.end(), random);
+
+	for (uint32_t i = 1; i < count; ++i)
+	{
+		std::uniform_int_distribution<uint32_t> input(0, i - 1);
+		std::uniform_int_distribution<uint32_t> inputs(0, maxInputs);
+
+		for (uint32_t edge = inputs(random); edge > 0; --edge)
+		{
+			AddEdge(nodes[placement[input(random)]], nodes[placement[i]]);
+		}
+	}
+
+	return nodes;
+}
+
+// Chain of diamonds, every diamond doubles the number of paths from the first node to the last one
+static std::vector<std::shared_ptr<RenderGraphNode>> MakeDiamondChain(uint32_t diamondsCount)
+{
+	std::vector<std::shared_ptr<RenderGraphNode>> nodes = MakeNodes(3 * diamondsCount + 1);
+
+	for (uint32_t i = 0; i < diamondsCount; ++i)
+	{
+		const std::shared_ptr<RenderGraphNode>& top = nodes[3 * i];
+		const std::shared_ptr<RenderGraphNode>& bottom = nodes[3 * i + 3];
+
+		AddEdge(top, nodes[3 * i + 1]);
+		AddEdge(top, nodes[3 * i + 2]);
+		AddEdge(nodes[3 * i + 1], bottom);
+		AddEdge(nodes[3 * i + 2], bottom);
+	}
+
+	return nodes;
+}
+
+static bool IsTopologicalOrder(const std::vector<std::shared_ptr<RenderGraphNode>>& nodes, const std::vector<uint32_t>& order)
+{
+	if (order.size() != nodes.size())
+	{
+		return false;
+	}
+
+	std::vector<uint32_t> positions(nodes.size(), UINT32_MAX);
+	for (uint32_t i = 0; i < order.size(); ++i)
+	{
+		if (order[i] >= nodes.size() || positions[order[i]] != UINT32_MAX)
+		{
+			return false;
+		}
+
+		positions[order[i]] = i;
+	}
+
+	for (const std::shared_ptr<RenderGraphNode>& node : nodes)
+	{
+		for (const std::shared_ptr<RenderGraphNode>& downstreamNode : node->Downstream)
+		{
+			if (positions[node->Index] >= positions[downstreamNode->Index])
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+ED_TEST(RenderGraph, SortsHundredsOfSyntheticPasses)
+{
+	std::mt19937 random(31);
+
+	for (uint32_t count : { 100u, 500u, 2000u })
+	{
+		std::vector<std::shared_ptr<RenderGraphNode>> nodes = MakeRandomGraph(count, 4, random);
+
+		const uint32_t iterations = 100;
+		std::vector<uint32_t> order;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < iterations; ++i)
+		{
+			ED_CHECK(RenderGraph::SortTopologically(nodes, order))
+		}
+		std::chrono::duration<double, std::micro> duration = std::chrono::steady_clock::now() - start;
+
+		ED_CHECK(IsTopologicalOrder(nodes, order))
+
+		std::printf("SortTopologically of %u passes takes %.1f us\n", count, duration.count() / iterations);
+	}
+}
+
+ED_TEST(RenderGraph, SortIsStableBetweenBuilds)
+{
+	std::mt19937 random(37);
+	std::vector<std::shared_ptr<RenderGraphNode>> nodes = MakeRandomGraph(300, 3, random);
+
+	std::vector<uint32_t> first;
+	std::vector<uint32_t> second;
+	ED_CHECK(RenderGraph::SortTopologically(nodes, first))
+	ED_CHECK(RenderGraph::SortTopologically(nodes, second))
+
+	ED_CHECK(first == second)
+}
+
+ED_TEST(RenderGraph, SortFailsOnCycles)
+{
+	std::mt19937 random(41);
+	std::vector<std::shared_ptr<RenderGraphNode>> nodes = MakeRandomGraph(200, 3, random);
+
+	std::vector<uint32_t> order;
+	ED_CHECK(RenderGraph::SortTopologically(nodes, order))
+
+	// Edges both ways between the first and the last sorted node close a cycle
+	AddEdge(nodes[order.back()], nodes[order.front()]);
+	AddEdge(nodes[order.front()], nodes[order.back()]);
+
+	ED_CHECK(!RenderGraph::SortTopologically(nodes, order))
+}
+
+ED_TEST(RenderGraph, CycleCheckVisitsEveryNodeOnce)
+{
+	// 2^64 paths go through the chain, the check finishes only if it doesn't walk the same nodes again
+	std::vector<std::shared_ptr<RenderGraphNode>> nodes = MakeDiamondChain(64);
+
+	std::shared_ptr<SyntheticRenderGraph> graph = std::make_shared<SyntheticRenderGraph>();
+	graph->CheckNodesForCycles(nodes);
+
+	std::vector<uint32_t> order;
+	ED_CHECK(RenderGraph::SortTopologically(nodes, order))
+	ED_CHECK(IsTopologicalOrder(nodes, order))
+}
@@ -0,0 +1,144 @@
+#include "Test.h"
+#include "Core/Rendering/RenderProfiler.h"
+#include "Platform/Rendering/Null/NullGPUTimer.h"
+
+static const uint64_t Millisecond = 1000000;
+
+// Every timestamp is one step after the previous one, so a scope takes a step for every timestamp written inside it plus one
+static void ProfileFrame(RenderProfiler& profiler, NullGPUTimer& timer, uint64_t step)
+{
+	timer.SetTimestampStep(step);
+
+	profiler.BeginFrame();
+
+	profiler.BeginScope("Lighting");
+	profiler.BeginScope("Shadows");
+	profiler.EndScope();
+	profiler.EndScope();
+
+	// Same scope entered again is summed
+	profiler.BeginScope("Lighting");
+	profiler.EndScope();
+
+	// Same name under another parent is another scope
+	profiler.BeginScope("PostProcess");
+	profiler.BeginScope("Shadows");
+	profiler.EndScope();
+	profiler.EndScope();
+
+	profiler.EndFrame();
+}
+
+static const ProfilerScopeStatistics* FindScope(const std::vector<ProfilerScopeStatistics>& statistics, const std::string& name, uint32_t depth)
+{
+	for (const ProfilerScopeStatistics& scope : statistics)
+	{
+		if (scope.Name == name && scope.Depth == depth)
+		{
+			return &scope;
+		}
+	}
+
+	return nullptr;
+}
+
+ED_TEST(RenderProfiler, AggregatesNestedScopes)
+{
+	std::shared_ptr<NullGPUTimer> timer = std::make_shared<NullGPUTimer>();
+
+	RenderProfiler profiler;
+	profiler.SetTimer(timer);
+
+	// Frame i takes i + 1 milliseconds per timestamp step
+	const uint32_t framesCount = 10;
+	for (uint32_t i = 0; i < framesCount; ++i)
+	{
+		ProfileFrame(profiler, *timer, (i + 1) * Millisecond);
+	}
+
+	std::vector<ProfilerScopeStatistics> statistics = profiler.GetStatistics();
+
+	// Depth first, children in the order they were first entered
+	ED_CHECK(statistics.size() == 5)
+	if (statistics.size() != 5)
+	{
+		return;
+	}
+
+	ED_CHECK(statistics[0].Name == "Frame" && statistics[0].Depth == 0)
+	ED_CHECK(statistics[1].Name == "Lighting" && statistics[1].Depth == 1)
+	ED_CHECK(statistics[2].Name == "Shadows" && statistics[2].Depth == 2)
+	ED_CHECK(statistics[3].Name == "PostProcess" && statistics[3].Depth == 1)
+	ED_CHECK(statistics[4].Name == "Shadows" && statistics[4].Depth == 2)
+
+	// Timestamps are read back two frames later, so the last two frames aren't in the averages yet
+	const uint32_t gpuFramesCount = framesCount - GPUTimer::FramesInFlight;
+	float averageStep = 0.0f;
+	for (uint32_t i = 0; i < gpuFramesCount; ++i)
+	{
+		averageStep += i + 1.0f;
+	}
+	averageStep /= gpuFramesCount;
+
+	float maxStep = gpuFramesCount;
+
+	// Steps each scope spans in one frame, lighting is entered twice
+	const float steps[] = { 11.0f, 4.0f, 1.0f, 3.0f, 1.0f };
+	for (uint32_t i = 0; i < statistics.size(); ++i)
+	{
+		ED_CHECK_NEAR(statistics[i].AverageGPUTime, steps[i] * averageStep, 1e-3f)
+		ED_CHECK_NEAR(statistics[i].MaxGPUTime, steps[i] * maxStep, 1e-3f)
+	}
+
+	// Parents include the CPU time of their children
+	const ProfilerScopeStatistics* frame = FindScope(statistics, "Frame", 0);
+	const ProfilerScopeStatistics* lighting = FindScope(statistics, "Lighting", 1);
+	const ProfilerScopeStatistics* postProcess = FindScope(statistics, "PostProcess", 1);
+
+	ED_CHECK(frame->AverageCPUTime + 1e-3f >= lighting->AverageCPUTime + postProcess->AverageCPUTime)
+	ED_CHECK(lighting->AverageCPUTime + 1e-3f >= statistics[2].AverageCPUTime)
+	ED_CHECK(postProcess->AverageCPUTime + 1e-3f >= statistics[4].AverageCPUTime)
+
+	for (const ProfilerScopeStatistics& scope : statistics)
+	{
+		ED_CHECK(scope.MaxCPUTime >= scope.AverageCPUTime)
+	}
+
+	// Disabled profiler doesn't record frames
+	profiler.SetEnabled(false);
+	ProfileFrame(profiler, *timer, 100 * Millisecond);
+
+	std::vector<ProfilerScopeStatistics> disabledStatistics = profiler.GetStatistics();
+	ED_CHECK(disabledStatistics.size() == statistics.size())
+	ED_CHECK(disabledStatistics[0].AverageGPUTime == statistics[0].AverageGPUTime)
+	ED_CHECK(disabledStatistics[0].AverageCPUTime == statistics[0].AverageCPUTime)
+}
+
+ED_TEST(RenderProfiler, AveragesOverLastFrames)
+{
+	std::shared_ptr<NullGPUTimer> timer = std::make_shared<NullGPUTimer>();
+
+	RenderProfiler profiler;
+	profiler.SetTimer(timer);
+
+	for (uint32_t i = 0; i < 3 * RenderProfiler::HistorySize; ++i)
+	{
+		ProfileFrame(profiler, *timer, Millisecond);
+	}
+
+	std::vector<ProfilerScopeStatistics> statistics = profiler.GetStatistics();
+	ED_CHECK_NEAR(statistics[0].AverageGPUTime, 11.0f, 1e-3f)
+	ED_CHECK_NEAR(statistics[2].AverageGPUTime, 1.0f, 1e-3f)
+
+	// Once the whole history is made of slower frames the faster ones no longer count
+	for (uint32_t i = 0; i < RenderProfiler::HistorySize + GPUTimer::FramesInFlight; ++i)
+	{
+		ProfileFrame(profiler, *timer, 2 * Millisecond);
+	}
+
+	statistics = profiler.GetStatistics();
+	ED_CHECK_NEAR(statistics[0].AverageGPUTime, 22.0f, 1e-3f)
+	ED_CHECK_NEAR(statistics[0].MaxGPUTime, 22.0f, 1e-3f)
+	ED_CHECK_NEAR(statistics[1].AverageGPUTime, 8.0f, 1e-3f)
+	ED_CHECK_NEAR(statistics[2].AverageGPUTime, 2.0f, 1e-3f)
+}
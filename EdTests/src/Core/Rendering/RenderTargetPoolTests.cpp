@@ -0,0 +1,147 @@
+#include "Test.h"
+#include "Core/Rendering/RenderGraph.h"
+#include "Core/Rendering/RenderTargetPool.h"
+#include "Core/Components/CameraComponent.h"
+#include "Core/Components/StaticMeshComponent.h"
+#include "Core/Components/PointLightComponent.h"
+#include "Core/Components/SpotLightComponent.h"
+#include "Core/Components/DirectionalLightComponent.h"
+#include "Core/Components/IrradianceVolumeComponent.h"
+#include "Core/Rendering/Passes/GBufferPass.h"
+#include "Core/Rendering/Passes/SSAO/SSAOMultiPass.h"
+#include "Core/Rendering/Passes/EmissionPass.h"
+#include "Core/Rendering/Passes/AmbientPass.h"
+#include "Core/Rendering/Passes/Lighting/DirectionalLight/DirectionalLightMultiPass.h"
+#include "Core/Rendering/Passes/Lighting/SpotLight/SpotLightMultiPass.h"
+#include "Core/Rendering/Passes/Lighting/PointLight/PointLightMultiPass.h"
+#include "Core/Rendering/Passes/Lighting/ClusteredLightingPass.h"
+#include "Core/Rendering/Passes/FXAAPass.h"
+#include "Core/Rendering/Passes/TAAPass.h"
+#include "Core/Rendering/Passes/Bloom/BloomMultiPass.h"
+#include "Core/Rendering/Passes/ResolutionPass.h"
+#include "Core/Rendering/Passes/GrayscalePass.h"
+#include "Platform/Rendering/Null/NullRenderingContext.h"
+#include "Platform/Rendering/Null/NullGPUTimer.h"
+#include "Utils/RenderingHelper.h"
+
+// Graph built on the null API with the parameters the renderer declares, the renderer itself isn't initialized, passes only read its settings at build
+class NullRenderGraph : public RenderGraph
+{
+public:
+	NullRenderGraph()
+	{
+		RenderingHelper::SetRenderingAPI(RenderingAPI::Null);
+
+		m_Context = std::make_shared<NullRenderingContext>();
+		m_Renderer = std::make_shared<Renderer>();
+		m_Profiler.SetTimer(std::make_shared<NullGPUTimer>());
+
+		DeclareObjectPtrParameter("Camera", m_Camera);
+
+		DeclareParameter("Scene.Component", m_Components);
+		DeclareParameter("Scene.StaticMesh", m_StaticMeshes);
+		DeclareParameter("Scene.PointLight", m_PointLights);
+		DeclareParameter("Scene.DirectionalLight", m_DirectionalLights);
+		DeclareParameter("Scene.SpotLight", m_SpotLights);
+		DeclareParameter("Scene.IrradianceVolume", m_IrradianceVolumes);
+	}
+
+	// Same passes as the renderer adds, except for the editor icons that need a loaded engine
+	void AddDefaultPasses()
+	{
+		AddPass<GBufferPass>();
+
+		AddPass<SSAOMultiPass>();
+
+		AddPass<AmbientPass>();
+		AddPass<EmissionPass>();
+
+		AddPass<DirectionalLightMultiPass>();
+		AddPass<SpotLightMultiPass>();
+		AddPass<PointLightMultiPass>();
+		AddPass<ClusteredLightingPass>();
+
+		AddPass<FXAAPass>();
+		AddPass<TAAPass>();
+
+		AddPass<BloomMultiPass>();
+
+		AddPass<ResolutionPass>();
+
+		AddPass<GrayscalePass>();
+
+		SetOutput("Resolution.Color");
+	}
+
+	const std::vector<TransientRenderTarget>& GetTransientRenderTargets() const
+	{
+		return m_TransientRenderTargets;
+	}
+
+private:
+	std::shared_ptr<CameraComponent> m_Camera;
+
+	std::vector<std::shared_ptr<Component>> m_Components;
+	std::vector<std::shared_ptr<StaticMeshComponent>> m_StaticMeshes;
+	std::vector<std::shared_ptr<PointLightComponent>> m_PointLights;
+	std::vector<std::shared_ptr<DirectionalLightComponent>> m_DirectionalLights;
+	std::vector<std::shared_ptr<SpotLightComponent>> m_SpotLights;
+	std::vector<std::shared_ptr<IrradianceVolumeComponent>> m_IrradianceVolumes;
+};
+
+static bool DoLifetimesOverlap(const TransientRenderTarget& left, const TransientRenderTarget& right)
+{
+	return left.FirstUse <= right.LastUse && right.FirstUse <= left.LastUse;
+}
+
+ED_TEST(RenderTargetPool, DefaultPassesTakeLessMemoryThanUnaliasedTargets)
+{
+	std::shared_ptr<NullRenderGraph> graph = std::make_shared<NullRenderGraph>();
+	graph->AddDefaultPasses();
+	graph->Build();
+
+	// Lifetimes come from the schedule compiled by the build, physical targets are assigned again from them
+	std::vector<TransientRenderTarget> targets = graph->GetTransientRenderTargets();
+	std::vector<RenderTargetDescription> physicalTargets = RenderTargetPool::AssignPhysicalTargets(targets);
+
+	RenderTargetPoolStatistics statistics = RenderTargetPool::CalculateStatistics(targets, physicalTargets, glm::u32vec2(1920, 1080));
+
+	ED_CHECK(statistics.TransientTargetsCount > 0)
+	ED_CHECK(statistics.PhysicalTargetsCount < statistics.TransientTargetsCount)
+	ED_CHECK(statistics.AllocatedMemory < statistics.RequestedMemory)
+
+	for (uint32_t i = 0; i < targets.size(); ++i)
+	{
+		if (!targets[i].IsUsed())
+		{
+			ED_CHECK(targets[i].PhysicalTarget == TransientRenderTarget::Unassigned)
+			continue;
+		}
+
+		ED_CHECK(targets[i].PhysicalTarget < physicalTargets.size())
+		ED_CHECK(physicalTargets[targets[i].PhysicalTarget] == targets[i].Description)
+
+		for (uint32_t j = i + 1; j < targets.size(); ++j)
+		{
+			if (targets[j].IsUsed() && targets[j].PhysicalTarget == targets[i].PhysicalTarget)
+			{
+				ED_CHECK(!DoLifetimesOverlap(targets[i], targets[j]))
+			}
+		}
+	}
+
+	// Graph output has to survive until the end of the frame, nothing may take its texture after it is written
+	for (const TransientRenderTarget& target : targets)
+	{
+		if (target.Name == "Resolution.Color")
+		{
+			for (const TransientRenderTarget& other : targets)
+			{
+				if (&other != &target && other.IsUsed() && other.PhysicalTarget == target.PhysicalTarget)
+				{
+					ED_CHECK(other.LastUse < target.FirstUse)
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,281 @@
+#include "Test.h"
+#include "Core/Rendering/ShadowAtlas.h"
+#include "Core/Rendering/ShadowCache.h"
+#include <algorithm>
+
+static bool DoTilesOverlap(const ShadowAtlasTile& first, const ShadowAtlasTile& second)
+{
+	return first.X < second.X + second.Size && second.X < first.X + first.Size && first.Y < second.Y + second.Size && second.Y < first.Y + first.Size;
+}
+
+static ShadowCaster MakeCaster(const void* key, const glm::vec4& sphere, uint32_t generation = 0)
+{
+	ShadowCaster caster;
+	caster.Key = key;
+	caster.BoundingSphere = sphere;
+	caster.Generation = generation;
+	return caster;
+}
+
+static ShadowLight MakeLight(const void* key, uint32_t tileSize)
+{
+	ShadowLight light;
+	light.Key = key;
+	light.BoundingSphere = glm::vec4(0.0f, 0.0f, 0.0f, 10.0f);
+	light.TileSize = tileSize;
+	return light;
+}
+
+static ShadowUpdate UpdateFrame(ShadowCache& cache, const std::vector<ShadowCaster>& casters, const ShadowLight& light, ShadowAtlasTile& tile)
+{
+	cache.BeginFrame(casters);
+	ShadowUpdate update = cache.UpdateLight(light, tile);
+	cache.EndFrame();
+
+	return update;
+}
+
+static bool Contains(const std::vector<uint32_t>& casters, uint32_t caster)
+{
+	return std::find(casters.begin(), casters.end(), caster) != casters.end();
+}
+
+ED_TEST(ShadowAtlasAllocator, SplitsAndMergesTiles)
+{
+	ShadowAtlasAllocator allocator;
+	allocator.Reset(1024, 64);
+
+	const uint64_t atlasArea = 1024 * 1024;
+	ED_CHECK(allocator.GetFreeArea() == atlasArea)
+
+	// Sizes are rounded up to powers of two and clamped to the min tile size
+	std::vector<ShadowAtlasTile> tiles(4);
+	ED_CHECK(allocator.Allocate(256, tiles[0]))
+	ED_CHECK(allocator.Allocate(100, tiles[1]))
+	ED_CHECK(allocator.Allocate(1, tiles[2]))
+	ED_CHECK(allocator.Allocate(512, tiles[3]))
+
+	ED_CHECK(tiles[0].Size == 256)
+	ED_CHECK(tiles[1].Size == 128)
+	ED_CHECK(tiles[2].Size == 64)
+	ED_CHECK(tiles[3].Size == 512)
+
+	ED_CHECK(allocator.GetAllocatedTilesCount() == 4)
+	ED_CHECK(allocator.GetFreeArea() == atlasArea - 256 * 256 - 128 * 128 - 64 * 64 - 512 * 512)
+
+	for (uint32_t i = 0; i < tiles.size(); ++i)
+	{
+		ED_CHECK(tiles[i].X % tiles[i].Size == 0 && tiles[i].Y % tiles[i].Size == 0)
+		ED_CHECK(tiles[i].X + tiles[i].Size <= 1024 && tiles[i].Y + tiles[i].Size <= 1024)
+
+		for (uint32_t j = i + 1; j < tiles.size(); ++j)
+		{
+			ED_CHECK(!DoTilesOverlap(tiles[i], tiles[j]))
+		}
+	}
+
+	// Whole atlas is split, so it can't be allocated until every tile is freed and merged back
+	ShadowAtlasTile atlas;
+	ED_CHECK(!allocator.Allocate(1024, atlas))
+
+	allocator.Free(tiles[1]);
+	ED_CHECK(allocator.GetFreeArea() == atlasArea - 256 * 256 - 64 * 64 - 512 * 512)
+
+	// Freed space is reused before another big tile is split
+	ShadowAtlasTile reused;
+	ED_CHECK(allocator.Allocate(128, reused))
+	ED_CHECK(reused == tiles[1])
+	allocator.Free(reused);
+
+	for (const ShadowAtlasTile& tile : tiles)
+	{
+		if (!(tile == tiles[1]))
+		{
+			allocator.Free(tile);
+		}
+	}
+
+	ED_CHECK(allocator.GetAllocatedTilesCount() == 0)
+	ED_CHECK(allocator.GetFreeArea() == atlasArea)
+
+	ED_CHECK(allocator.Allocate(1024, atlas))
+	ED_CHECK(atlas.X == 0 && atlas.Y == 0 && atlas.Size == 1024)
+	ED_CHECK(allocator.GetFreeArea() == 0)
+}
+
+ED_TEST(ShadowAtlasAllocator, AllocationFailsWhenAtlasIsFull)
+{
+	ShadowAtlasAllocator allocator;
+	allocator.Reset(1024, 64);
+
+	std::vector<ShadowAtlasTile> tiles;
+	ShadowAtlasTile tile;
+	while (allocator.Allocate(64, tile))
+	{
+		tiles.push_back(tile);
+	}
+
+	ED_CHECK(tiles.size() == (1024 / 64) * (1024 / 64))
+	ED_CHECK(allocator.GetFreeArea() == 0)
+	ED_CHECK(!allocator.Allocate(64, tile))
+
+	// Single free tile fits only tiles of its size
+	allocator.Free(tiles[37]);
+	ED_CHECK(allocator.GetFreeArea() == 64 * 64)
+	ED_CHECK(!allocator.Allocate(128, tile))
+	ED_CHECK(allocator.Allocate(64, tile))
+	ED_CHECK(tile == tiles[37])
+}
+
+ED_TEST(ShadowCache, StaticCastersInvalidateCache)
+{
+	ShadowCache cache;
+	cache.Reset(1024, 64);
+
+	int32_t lightKey = 0;
+	int32_t nearKey = 0;
+	int32_t farKey = 0;
+	int32_t newKey = 0;
+
+	ShadowLight light = MakeLight(&lightKey, 256);
+	ShadowAtlasTile tile;
+
+	std::vector<ShadowCaster> casters = {
+		MakeCaster(&nearKey, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)),
+		MakeCaster(&farKey, glm::vec4(100.0f, 0.0f, 0.0f, 1.0f))
+	};
+
+	// First frame draws everything within the light bounds
+	ED_CHECK(UpdateFrame(cache, casters, light, tile) == ShadowUpdate::Full)
+	ED_CHECK(tile.Size == 256)
+	ED_CHECK(Contains(cache.GetStaticCasters(), 0))
+	ED_CHECK(!Contains(cache.GetStaticCasters(), 1))
+	ED_CHECK(UpdateFrame(cache, casters, light, tile) == ShadowUpdate::None)
+
+	// Caster appears
+	casters.push_back(MakeCaster(&newKey, glm::vec4(3.0f, 0.0f, 0.0f, 1.0f)));
+	ED_CHECK(UpdateFrame(cache, casters, light, tile) == ShadowUpdate::Full)
+	ED_CHECK(Contains(cache.GetStaticCasters(), 2))
+	ED_CHECK(UpdateFrame(cache, casters, light, tile) == ShadowUpdate::None)
+
+	// Caster starts moving, the cache still has it where it was. It is drawn as a dynamic caster while it keeps moving
+	casters[0].Generation++;
+	ED_CHECK(UpdateFrame(cache, casters, light, tile) == ShadowUpdate::Full)
+	ED_CHECK(!Contains(cache.GetStaticCasters(), 0))
+	ED_CHECK(Contains(cache.GetDynamicCasters(), 0))
+
+	casters[0].Generation++;
+	casters[0].BoundingSphere.x += 1.0f;
+	ED_CHECK(UpdateFrame(cache, casters, light, tile) == ShadowUpdate::Dynamic)
+	ED_CHECK(Contains(cache.GetDynamicCasters(), 0))
+
+	// Stays dynamic until it settles, then goes back to the cache
+	for (uint32_t frame = 1; frame < ShadowCache::SettleFrames; ++frame)
+	{
+		ED_CHECK(UpdateFrame(cache, casters, light, tile) == ShadowUpdate::Dynamic)
+	}
+
+	ED_CHECK(UpdateFrame(cache, casters, light, tile) == ShadowUpdate::Full)
+	ED_CHECK(Contains(cache.GetStaticCasters(), 0))
+	ED_CHECK(cache.GetDynamicCasters().empty())
+	ED_CHECK(UpdateFrame(cache, casters, light, tile) == ShadowUpdate::None)
+
+	// Casters outside the light bounds don't touch it
+	casters[1].Generation++;
+	ED_CHECK(UpdateFrame(cache, casters, light, tile) == ShadowUpdate::None)
+
+	// Caster disappears
+	casters.pop_back();
+	ED_CHECK(UpdateFrame(cache, casters, light, tile) == ShadowUpdate::Full)
+	ED_CHECK(UpdateFrame(cache, casters, light, tile) == ShadowUpdate::None)
+
+	// Skipped light keeps its shadow and gets the pending update when it is updated again
+	casters.push_back(MakeCaster(&newKey, glm::vec4(3.0f, 0.0f, 0.0f, 1.0f)));
+	light.bShouldUpdate = false;
+	ED_CHECK(UpdateFrame(cache, casters, light, tile) == ShadowUpdate::None)
+	ED_CHECK(tile.Size == 256)
+
+	light.bShouldUpdate = true;
+	ED_CHECK(UpdateFrame(cache, casters, light, tile) == ShadowUpdate::Full)
+
+	// Light itself moves
+	light.ProjectionView[3][0] += 1.0f;
+	ED_CHECK(UpdateFrame(cache, casters, light, tile) == ShadowUpdate::Full)
+	ED_CHECK(UpdateFrame(cache, casters, light, tile) == ShadowUpdate::None)
+}
+
+ED_TEST(ShadowCache, EvictsLeastRecentlyUsedLights)
+{
+	ShadowCache cache;
+	cache.Reset(512, 64);
+
+	// Atlas fits four of these lights
+	int32_t keys[7] = {};
+	std::vector<ShadowLight> lights;
+	for (int32_t& key : keys)
+	{
+		lights.push_back(MakeLight(&key, 256));
+	}
+
+	std::vector<ShadowAtlasTile> tiles(lights.size());
+	std::vector<ShadowCaster> casters;
+
+	cache.BeginFrame(casters);
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		cache.UpdateLight(lights[i], tiles[i]);
+		ED_CHECK(tiles[i].Size == 256)
+	}
+	cache.EndFrame();
+
+	ED_CHECK(cache.GetAllocator().GetFreeArea() == 0)
+
+	// First light isn't used, so it is the least recently used one
+	cache.BeginFrame(casters);
+	for (uint32_t i = 1; i < 4; ++i)
+	{
+		cache.UpdateLight(lights[i], tiles[i]);
+	}
+	cache.EndFrame();
+
+	cache.BeginFrame(casters);
+	cache.UpdateLight(lights[2], tiles[2]);
+	cache.UpdateLight(lights[3], tiles[3]);
+
+	ED_CHECK(cache.UpdateLight(lights[4], tiles[4]) == ShadowUpdate::Full)
+	ED_CHECK(tiles[4] == tiles[0])
+	ED_CHECK(cache.GetCachedLightsCount() == 4)
+
+	ED_CHECK(cache.UpdateLight(lights[5], tiles[5]) == ShadowUpdate::Full)
+	ED_CHECK(tiles[5] == tiles[1])
+	ED_CHECK(cache.GetCachedLightsCount() == 4)
+
+	// Every tile belongs to a light of this frame, nothing can be evicted
+	ED_CHECK(cache.UpdateLight(lights[6], tiles[6]) == ShadowUpdate::None)
+	ED_CHECK(!tiles[6].IsValid())
+	ED_CHECK(cache.GetCachedLightsCount() == 5)
+
+	// Lights used this frame keep their tiles
+	ShadowAtlasTile tile;
+	ED_CHECK(cache.UpdateLight(lights[2], tile) == ShadowUpdate::None)
+	ED_CHECK(tile == tiles[2])
+	cache.EndFrame();
+
+	// Lights that aren't used for long enough give their tiles up at the end of a frame
+	for (uint32_t frame = 0; frame < ShadowCache::EvictionFrames; ++frame)
+	{
+		cache.BeginFrame(casters);
+		cache.UpdateLight(lights[2], tiles[2]);
+		cache.EndFrame();
+	}
+
+	ED_CHECK(cache.GetCachedLightsCount() == 5)
+
+	cache.BeginFrame(casters);
+	cache.UpdateLight(lights[2], tiles[2]);
+	cache.EndFrame();
+
+	ED_CHECK(cache.GetCachedLightsCount() == 1)
+	ED_CHECK(cache.GetAllocator().GetAllocatedTilesCount() == 1)
+	ED_CHECK(cache.GetAllocator().GetFreeArea() == 512 * 512 - 256 * 256)
+}
@@ -0,0 +1,202 @@
+#include "Test.h"
+#include "Core/Rendering/ShadowCascades.h"
+#include "Core/Math/Camera.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+static const float FarPlane = 100.0f;
+static const uint32_t CascadesCount = 4;
+static const float Lambda = 0.7f;
+static const uint32_t Resolution = 1024;
+static const float DepthMultiplier = 2.0f;
+
+static glm::vec3 GetLightDirection()
+{
+	return glm::normalize(glm::vec3(-1.0f, -2.0f, -1.0f));
+}
+
+static Camera MakeCamera()
+{
+	return Camera(60.0f, 16.0f / 9.0f, 0.1f, FarPlane, glm::vec3(-20.0f, 30.0f, 0.0f), glm::vec3(0.0f, 5.0f, 0.0f));
+}
+
+static void UpdateCascades(ShadowCascades& cascades, const Camera& camera)
+{
+	cascades.Update(camera, FarPlane, GetLightDirection(), CascadesCount, Lambda, Resolution, DepthMultiplier);
+}
+
+static float GetMaxDifference(const glm::mat4& left, const glm::mat4& right)
+{
+	float difference = 0.0f;
+	for (int32_t column = 0; column < 4; ++column)
+	{
+		for (int32_t row = 0; row < 4; ++row)
+		{
+			difference = glm::max(difference, glm::abs(left[column][row] - right[column][row]));
+		}
+	}
+
+	return difference;
+}
+
+ED_TEST(ShadowCascades, SplitsBlendUniformAndLogarithmicOnes)
+{
+	const float nearPlane = 0.1f;
+
+	float uniform[CascadesCount + 1];
+	float logarithmic[CascadesCount + 1];
+	float blended[CascadesCount + 1];
+
+	ShadowCascades::CalculateSplits(nearPlane, FarPlane, CascadesCount, 0.0f, uniform);
+	ShadowCascades::CalculateSplits(nearPlane, FarPlane, CascadesCount, 1.0f, logarithmic);
+	ShadowCascades::CalculateSplits(nearPlane, FarPlane, CascadesCount, Lambda, blended);
+
+	// Ends are exact whatever the lambda is
+	for (const float* splits : { uniform, logarithmic, blended })
+	{
+		ED_CHECK(splits[0] == nearPlane)
+		ED_CHECK(splits[CascadesCount] == FarPlane)
+
+		for (uint32_t i = 0; i < CascadesCount; ++i)
+		{
+			ED_CHECK(splits[i] < splits[i + 1])
+		}
+	}
+
+	for (uint32_t i = 1; i < CascadesCount; ++i)
+	{
+		float fraction = (float)i / CascadesCount;
+
+		ED_CHECK_NEAR(uniform[i], nearPlane + (FarPlane - nearPlane) * fraction, 1e-4f)
+		ED_CHECK_NEAR(logarithmic[i], nearPlane * glm::pow(FarPlane / nearPlane, fraction), 1e-4f)
+		ED_CHECK_NEAR(blended[i], (1.0f - Lambda) * uniform[i] + Lambda * logarithmic[i], 1e-4f)
+
+		// Logarithmic splits give near cascades more of the resolution
+		ED_CHECK(logarithmic[i] < blended[i] && blended[i] < uniform[i])
+	}
+
+	// Single cascade covers the whole range
+	float single[2];
+	ShadowCascades::CalculateSplits(nearPlane, FarPlane, 1, Lambda, single);
+	ED_CHECK(single[0] == nearPlane && single[1] == FarPlane)
+}
+
+ED_TEST(ShadowCascades, ProjectionMovesByWholeTexels)
+{
+	Camera camera = MakeCamera();
+
+	ShadowCascades cascades;
+	UpdateCascades(cascades, camera);
+
+	// First cascade updates every frame, camera is moved across the light view
+	const ShadowCascade& cascade = cascades.GetCascade(0);
+	ED_CHECK(cascade.UpdateInterval == 1)
+
+	float radius = cascade.BoundingSphere.w;
+	float texelSize = 2.0f * radius / Resolution;
+
+	glm::mat4 lightView = glm::lookAt(glm::vec3(0.0f), GetLightDirection(), glm::vec3(0.0f, 1.0f, 0.0f));
+	glm::vec3 lightRight = glm::vec3(lightView[0][0], lightView[1][0], lightView[2][0]);
+	glm::vec3 lightUp = glm::vec3(lightView[0][1], lightView[1][1], lightView[2][1]);
+
+	// Camera is moved so the center of the cascade is in the middle of a texel
+	glm::vec2 center = glm::vec2(lightView * glm::vec4(glm::vec3(cascade.BoundingSphere), 1.0f));
+	glm::vec2 offset = (glm::floor(center / texelSize) + 0.5f) * texelSize - center;
+
+	glm::vec3 position = camera.GetPosition() + lightRight * offset.x + lightUp * offset.y;
+	camera.SetPosition(position);
+	UpdateCascades(cascades, camera);
+
+	// Radius depends only on the depth range, so moving doesn't change the size of texels
+	ED_CHECK(cascade.BoundingSphere.w == radius)
+	ED_CHECK_NEAR(cascade.LightCenter.x / texelSize, glm::round(cascade.LightCenter.x / texelSize), 1e-3f)
+	ED_CHECK_NEAR(cascade.LightCenter.y / texelSize, glm::round(cascade.LightCenter.y / texelSize), 1e-3f)
+
+	glm::mat4 projectionView = cascade.ProjectionView;
+	glm::vec2 lightCenter = cascade.LightCenter;
+
+	// Moves smaller than a texel keep the projection
+	const glm::vec2 moves[] = { { 0.3f, 0.0f }, { -0.3f, 0.0f }, { 0.0f, 0.3f }, { 0.0f, -0.3f }, { 0.2f, -0.2f } };
+	for (const glm::vec2& move : moves)
+	{
+		camera.SetPosition(position + (lightRight * move.x + lightUp * move.y) * texelSize);
+		UpdateCascades(cascades, camera);
+
+		ED_CHECK(cascade.LightCenter == lightCenter)
+		ED_CHECK_NEAR(GetMaxDifference(cascade.ProjectionView, projectionView), 0.0f, 1e-4f)
+	}
+
+	// Move over a texel border shifts it by exactly one texel
+	camera.SetPosition(position + lightRight * texelSize);
+	UpdateCascades(cascades, camera);
+
+	ED_CHECK_NEAR(cascade.LightCenter.x - lightCenter.x, texelSize, texelSize * 1e-2f)
+	ED_CHECK_NEAR(cascade.LightCenter.y, lightCenter.y, texelSize * 1e-2f)
+	ED_CHECK(GetMaxDifference(cascade.ProjectionView, projectionView) > 1e-4f)
+
+	// Going back gives the same projection again
+	camera.SetPosition(position);
+	UpdateCascades(cascades, camera);
+
+	ED_CHECK(cascade.LightCenter == lightCenter)
+	ED_CHECK_NEAR(GetMaxDifference(cascade.ProjectionView, projectionView), 0.0f, 1e-4f)
+}
+
+ED_TEST(ShadowCascades, TurningCameraUpdatesCascadesBeforeTheyAreDue)
+{
+	Camera camera = MakeCamera();
+
+	ShadowCascades cascades;
+	UpdateCascades(cascades, camera);
+
+	ED_CHECK(cascades.GetCount() == CascadesCount)
+	for (uint32_t i = 0; i < CascadesCount; ++i)
+	{
+		ED_CHECK(cascades.GetCascade(i).bShouldUpdate)
+		ED_CHECK(cascades.GetCascade(i).UpdateInterval == ShadowCascades::GetUpdateInterval(i))
+	}
+
+	ED_CHECK(cascades.GetCascade(2).UpdateInterval == 2)
+	ED_CHECK(cascades.GetCascade(3).UpdateInterval == 4)
+
+	// Second frame, the last cascade isn't due and its projection still covers its slice
+	UpdateCascades(cascades, camera);
+	ED_CHECK(cascades.GetCascade(0).bShouldUpdate)
+	ED_CHECK(!cascades.GetCascade(3).bShouldUpdate)
+
+	glm::mat4 projectionView = cascades.GetCascade(3).ProjectionView;
+
+	// Third frame, neither of the far cascades is due but the slices turned out of their projections
+	camera.SetRotation(glm::vec3(-20.0f, 90.0f, 0.0f));
+	UpdateCascades(cascades, camera);
+
+	for (uint32_t i = 2; i < CascadesCount; ++i)
+	{
+		const ShadowCascade& cascade = cascades.GetCascade(i);
+		ED_CHECK(cascade.bShouldUpdate)
+
+		glm::vec3 corners[8];
+		camera.GetFrustumCorners(cascade.Near, cascade.Far, corners);
+
+		// Every corner of the new slice is inside the new projection
+		for (const glm::vec3& corner : corners)
+		{
+			glm::vec4 clip = cascade.ProjectionView * glm::vec4(corner, 1.0f);
+			glm::vec3 ndc = glm::vec3(clip) / clip.w;
+
+			ED_CHECK(glm::abs(ndc.x) <= 1.0f && glm::abs(ndc.y) <= 1.0f && glm::abs(ndc.z) <= 1.0f)
+		}
+	}
+
+	ED_CHECK(GetMaxDifference(cascades.GetCascade(3).ProjectionView, projectionView) > 1e-4f)
+
+	// Fourth frame, nothing moved and the last cascade still isn't due
+	UpdateCascades(cascades, camera);
+	ED_CHECK(!cascades.GetCascade(3).bShouldUpdate)
+
+	// Light changes update every cascade
+	cascades.Update(camera, FarPlane, glm::normalize(glm::vec3(1.0f, -2.0f, 0.0f)), CascadesCount, Lambda, Resolution, DepthMultiplier);
+	for (uint32_t i = 0; i < CascadesCount; ++i)
+	{
+		ED_CHECK(cascades.GetCascade(i).bShouldUpdate)
+	}
+}
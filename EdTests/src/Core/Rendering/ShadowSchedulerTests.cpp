@@ -0,0 +1,231 @@
+#include "Test.h"
+#include "Core/Rendering/ShadowScheduler.h"
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <random>
+
+static const float Fov = glm::half_pi<float>();
+static const glm::u32vec2 ViewportSize = glm::u32vec2(1920, 1080);
+static const float MaxDistance = 1000.0f;
+
+// Keys only have to be unique, characters make neighbouring keys differ in the lowest bits
+static char Keys[64];
+
+static ShadowRequest MakeRequest(uint32_t index, const glm::vec4& sphere, float intensity, uint32_t faces = 1)
+{
+	ShadowRequest request;
+	request.Key = &Keys[index];
+	request.BoundingSphere = sphere;
+	request.Intensity = intensity;
+	request.Faces = faces;
+	return request;
+}
+
+// Unit sphere straight ahead of a view at the origin that takes the given diameter on the screen
+static glm::vec4 GetSphereWithDiameter(float diameter)
+{
+	float projectionScale = 0.5f * ViewportSize.y / glm::tan(0.5f * Fov);
+	float distance = glm::sqrt(glm::pow(2.0f * projectionScale / diameter, 2.0f) + 1.0f);
+
+	return glm::vec4(0.0f, 0.0f, -distance, 1.0f);
+}
+
+static bool IsPowerOfTwo(uint32_t value)
+{
+	return value != 0 && (value & (value - 1)) == 0;
+}
+
+ED_TEST(ShadowScheduler, ScoresOrderLights)
+{
+	ShadowScheduler scheduler;
+	scheduler.Reset(256, 256, 3 * 256 * 256, 1u << 30);
+	scheduler.SetView(glm::vec3(0.0f), Fov, ViewportSize, MaxDistance);
+
+	glm::vec4 sphere = glm::vec4(0.0f, 0.0f, -20.0f, 2.0f);
+
+	// Brighter, closer and bigger lights matter more, lights out of reach don't matter at all
+	float score = scheduler.GetScore(MakeRequest(0, sphere, 1.0f));
+	ED_CHECK(score > 0.0f)
+	ED_CHECK(scheduler.GetScore(MakeRequest(0, sphere, 2.0f)) > score)
+	ED_CHECK(scheduler.GetScore(MakeRequest(0, glm::vec4(0.0f, 0.0f, -40.0f, 2.0f), 1.0f)) < score)
+	ED_CHECK(scheduler.GetScore(MakeRequest(0, glm::vec4(0.0f, 0.0f, -20.0f, 4.0f), 1.0f)) > score)
+	ED_CHECK(scheduler.GetScore(MakeRequest(0, sphere, 0.0f)) == 0.0f)
+	ED_CHECK(scheduler.GetScore(MakeRequest(0, glm::vec4(0.0f, 0.0f, -MaxDistance - 10.0f, 2.0f), 1.0f)) == 0.0f)
+
+	// View inside the light bounds covers the whole screen
+	ED_CHECK(scheduler.GetProjectedDiameter(glm::vec4(0.0f, 0.0f, -1.0f, 2.0f)) == std::numeric_limits<float>::infinity())
+	ED_CHECK(scheduler.GetScore(MakeRequest(0, glm::vec4(0.0f, 0.0f, -1.0f, 2.0f), 1.0f)) == 1.0f)
+
+	// Atlas fits three tiles, they go to the lights with the best scores
+	std::mt19937 random(17);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> intensity(0.1f, 10.0f);
+
+	std::vector<ShadowRequest> requests;
+	std::vector<float> scores;
+	for (uint32_t i = 0; i < 10; ++i)
+	{
+		requests.push_back(MakeRequest(i, glm::vec4(position(random), position(random), position(random), 2.0f), intensity(random)));
+		scores.push_back(scheduler.GetScore(requests.back()));
+	}
+
+	std::vector<float> sortedScores = scores;
+	std::sort(sortedScores.begin(), sortedScores.end(), std::greater<float>());
+
+	scheduler.Schedule(requests);
+
+	for (uint32_t i = 0; i < requests.size(); ++i)
+	{
+		const ShadowSchedule& schedule = scheduler.GetSchedule(requests[i].Key);
+
+		ED_CHECK(schedule.Score == scores[i])
+		ED_CHECK((schedule.TileSize != 0) == (scores[i] >= sortedScores[2]))
+	}
+
+	ED_CHECK(scheduler.GetAllocatedArea() == 3 * 256 * 256)
+}
+
+ED_TEST(ShadowScheduler, StaysWithinBudgets)
+{
+	const uint64_t atlasBudget = 2048 * 2048;
+	const uint64_t updateBudget = 1024 * 1024;
+
+	ShadowScheduler scheduler;
+	scheduler.Reset(64, 1024, atlasBudget, updateBudget);
+
+	std::mt19937 random(23);
+	std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+	std::uniform_real_distribution<float> radius(1.0f, 20.0f);
+	std::uniform_real_distribution<float> intensity(0.0f, 5.0f);
+
+	std::vector<ShadowRequest> requests;
+	for (uint32_t i = 0; i < 50; ++i)
+	{
+		requests.push_back(MakeRequest(i, glm::vec4(position(random), position(random), position(random), radius(random)), intensity(random), i % 3 == 0 ? 6 : 1));
+	}
+
+	bool bWasLimited = false;
+
+	for (uint32_t frame = 0; frame < 30; ++frame)
+	{
+		scheduler.SetView(glm::vec3(position(random), 0.0f, position(random)), Fov, ViewportSize, MaxDistance);
+		scheduler.Schedule(requests);
+
+		uint64_t allocatedArea = 0;
+		uint64_t updateCost = 0;
+
+		for (const ShadowRequest& request : requests)
+		{
+			const ShadowSchedule& schedule = scheduler.GetSchedule(request.Key);
+
+			if (schedule.TileSize == 0)
+			{
+				ED_CHECK(schedule.UpdateInterval == 0 && !schedule.bShouldUpdate)
+				bWasLimited = bWasLimited || schedule.Score > 0.0f;
+				continue;
+			}
+
+			ED_CHECK(IsPowerOfTwo(schedule.TileSize) && schedule.TileSize >= 64 && schedule.TileSize <= 1024)
+			ED_CHECK(schedule.UpdateInterval == 0 || (IsPowerOfTwo(schedule.UpdateInterval) && schedule.UpdateInterval <= ShadowScheduler::MaxUpdateInterval))
+			ED_CHECK(schedule.UpdateInterval != 0 || !schedule.bShouldUpdate)
+
+			bWasLimited = bWasLimited || schedule.UpdateInterval != 1;
+
+			uint64_t area = (uint64_t)schedule.TileSize * schedule.TileSize;
+			allocatedArea += area;
+
+			if (schedule.UpdateInterval != 0)
+			{
+				updateCost += request.Faces * area / schedule.UpdateInterval;
+			}
+		}
+
+		ED_CHECK(scheduler.GetAllocatedArea() == allocatedArea)
+		ED_CHECK(scheduler.GetUpdateCost() == updateCost)
+		ED_CHECK(scheduler.GetAllocatedArea() <= atlasBudget)
+		ED_CHECK(scheduler.GetUpdateCost() <= updateBudget)
+	}
+
+	// Budgets are small enough that some lights don't get everything they want
+	ED_CHECK(bWasLimited)
+}
+
+ED_TEST(ShadowScheduler, TileSizeChangesOnlyPastHysteresis)
+{
+	ShadowScheduler scheduler;
+	scheduler.Reset(64, 2048, 1u << 30, 1u << 30);
+	scheduler.SetView(glm::vec3(0.0f), Fov, ViewportSize, MaxDistance);
+
+	auto getTileSize = [&scheduler](float diameter)
+	{
+		std::vector<ShadowRequest> requests = { MakeRequest(0, GetSphereWithDiameter(diameter), 1.0f) };
+		scheduler.Schedule(requests);
+		return scheduler.GetSchedule(requests[0].Key).TileSize;
+	};
+
+	ED_CHECK_NEAR(scheduler.GetProjectedDiameter(GetSphereWithDiameter(300.0f)), 300.0f, 0.1f)
+
+	ED_CHECK(getTileSize(256.0f) == 256)
+	ED_CHECK(getTileSize(300.0f) == 256)
+
+	// Would be rounded to 512 on its own, but it is still close to the current size
+	ED_CHECK(getTileSize(400.0f) == 256)
+	ED_CHECK(getTileSize(500.0f) == 512)
+
+	// Same on the way down
+	ED_CHECK(getTileSize(340.0f) == 512)
+	ED_CHECK(getTileSize(250.0f) == 256)
+
+	// Light that wasn't scheduled in the last frame starts over
+	scheduler.Schedule({});
+	ED_CHECK(getTileSize(400.0f) == 512)
+}
+
+ED_TEST(ShadowScheduler, SpreadsUpdatesOverFrames)
+{
+	// Every light costs four times less than the previous one and gets a sixth of it from the budget left, so all of them update every eighth frame
+	ShadowScheduler scheduler;
+	scheduler.Reset(64, 1024, 1u << 30, 1024 * 1024 / 6);
+	scheduler.SetView(glm::vec3(0.0f), Fov, ViewportSize, MaxDistance);
+
+	std::vector<ShadowRequest> requests;
+	for (uint32_t size = 1024; size >= 64; size /= 2)
+	{
+		requests.push_back(MakeRequest(requests.size(), GetSphereWithDiameter(size), 1.0f));
+	}
+
+	const uint32_t interval = ShadowScheduler::MaxUpdateInterval;
+
+	std::vector<uint32_t> updatesPerFrame(interval, 0);
+	std::vector<uint32_t> updatesPerLight(requests.size(), 0);
+
+	for (uint32_t frame = 0; frame < 4 * interval; ++frame)
+	{
+		scheduler.Schedule(requests);
+
+		for (uint32_t i = 0; i < requests.size(); ++i)
+		{
+			const ShadowSchedule& schedule = scheduler.GetSchedule(requests[i].Key);
+			ED_CHECK(schedule.TileSize == 1024u >> i)
+			ED_CHECK(schedule.UpdateInterval == interval)
+
+			if (schedule.bShouldUpdate)
+			{
+				updatesPerLight[i]++;
+				updatesPerFrame[frame % interval]++;
+			}
+		}
+
+		ED_CHECK(scheduler.GetUpdateCost() <= 1024 * 1024 / 6)
+	}
+
+	// Each light updates once every interval and the lights don't all update in the same frame
+	for (uint32_t updates : updatesPerLight)
+	{
+		ED_CHECK(updates == 4)
+	}
+
+	ED_CHECK(*std::max_element(updatesPerFrame.begin(), updatesPerFrame.end()) < 4 * requests.size())
+}
@@ -0,0 +1,82 @@
+#include "Test.h"
+#include "Core/Rendering/SphericalHarmonics.h"
+#include <glm/gtc/constants.hpp>
+#include <functional>
+
+// Midpoint rule over a grid uniform in z and in the angle around it, every cell stands for the same solid angle
+static SHL2 Project(const std::function<float(const glm::vec3&)>& radiance)
+{
+	const uint32_t zCount = 64;
+	const uint32_t phiCount = 128;
+	const float weight = 4.0f * glm::pi<float>() / (zCount * phiCount);
+
+	SHL2 result;
+	for (uint32_t i = 0; i < zCount; ++i)
+	{
+		float z = -1.0f + 2.0f * (i + 0.5f) / zCount;
+		float radius = glm::sqrt(glm::max(0.0f, 1.0f - z * z));
+
+		for (uint32_t j = 0; j < phiCount; ++j)
+		{
+			float phi = 2.0f * glm::pi<float>() * (j + 0.5f) / phiCount;
+			glm::vec3 direction = glm::vec3(radius * glm::cos(phi), radius * glm::sin(phi), z);
+
+			result.AddRadiance(direction, glm::vec3(radiance(direction)), weight);
+		}
+	}
+
+	return result;
+}
+
+ED_TEST(SHL2, ProjectsConstantRadiance)
+{
+	SHL2 constant = Project([](const glm::vec3& direction) { return 1.0f; });
+
+	// Only the first band is left, its coefficient is the integral of the constant basis function over the sphere
+	ED_CHECK_NEAR(constant.Coefficients[0].x, 2.0f * glm::sqrt(glm::pi<float>()), 1e-3f)
+	for (uint32_t i = 1; i < SHL2::CoefficientsCount; ++i)
+	{
+		ED_CHECK_NEAR(constant.Coefficients[i].x, 0.0f, 2e-3f)
+	}
+
+	ED_CHECK(constant.Coefficients[0].x == constant.Coefficients[0].y && constant.Coefficients[0].x == constant.Coefficients[0].z)
+
+	// Uniform radiance gives pi times as much irradiance whichever way the surface faces
+	for (const glm::vec3& normal : { glm::vec3(0, 0, 1), glm::vec3(1, 0, 0), glm::normalize(glm::vec3(-1, 2, -3)) })
+	{
+		ED_CHECK_NEAR(constant.GetIrradiance(normal).x, glm::pi<float>(), 1e-3f)
+		ED_CHECK_NEAR(constant.Evaluate(normal).x, 1.0f, 2e-3f)
+	}
+}
+
+ED_TEST(SHL2, ProjectsCosineLobe)
+{
+	SHL2 lobe = Project([](const glm::vec3& direction) { return glm::max(direction.z, 0.0f); });
+
+	// Clamped cosine around z is zonal, only the m = 0 coefficients of every band are left (Ramamoorthi and Hanrahan)
+	const float zonal[3] = { glm::sqrt(glm::pi<float>()) / 2.0f, glm::sqrt(glm::pi<float>() / 3.0f), glm::sqrt(5.0f * glm::pi<float>()) / 8.0f };
+
+	ED_CHECK_NEAR(lobe.Coefficients[0].x, zonal[0], 1e-3f)
+	ED_CHECK_NEAR(lobe.Coefficients[2].x, zonal[1], 1e-3f)
+	ED_CHECK_NEAR(lobe.Coefficients[6].x, zonal[2], 2e-3f)
+
+	for (uint32_t i : { 1, 3, 4, 5, 7, 8 })
+	{
+		ED_CHECK_NEAR(lobe.Coefficients[i].x, 0.0f, 1e-3f)
+	}
+
+	// Irradiance along the axis is the integral of the squared cosine, 2pi/3, nine coefficients keep it within a percent
+	ED_CHECK_NEAR(lobe.GetIrradiance(glm::vec3(0, 0, 1)).x, 2.0f * glm::pi<float>() / 3.0f, 0.03f)
+
+	// Ringing pushes the opposite side slightly below zero, irradiance is clamped there
+	ED_CHECK(lobe.GetCosineConvolved().Evaluate(glm::vec3(0, 0, -1)).x < 0.0f)
+	ED_CHECK(lobe.GetIrradiance(glm::vec3(0, 0, -1)).x == 0.0f)
+
+	// Projection is linear, so adding weighted projections adds their radiance
+	SHL2 sum = lobe;
+	sum.Add(lobe, 2.0f);
+	for (uint32_t i = 0; i < SHL2::CoefficientsCount; ++i)
+	{
+		ED_CHECK_NEAR(sum.Coefficients[i].x, 3.0f * lobe.Coefficients[i].x, 1e-5f)
+	}
+}
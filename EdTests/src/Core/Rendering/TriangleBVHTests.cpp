@@ -0,0 +1,144 @@
+#include "Test.h"
+#include "Core/Rendering/TriangleBVH.h"
+#include <random>
+
+// Closest hit of every triangle tested one by one, what the hierarchy has to agree with
+static bool IntersectAll(const std::vector<glm::vec3>& corners, const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float& distance)
+{
+	distance = maxDistance;
+	bool bHasHit = false;
+
+	for (uint32_t i = 0; i < corners.size(); i += 3)
+	{
+		glm::vec3 edge1 = corners[i + 1] - corners[i];
+		glm::vec3 edge2 = corners[i + 2] - corners[i];
+
+		glm::vec3 p = glm::cross(direction, edge2);
+		float determinant = glm::dot(edge1, p);
+		if (std::abs(determinant) < 1e-12f)
+		{
+			continue;
+		}
+
+		glm::vec3 s = origin - corners[i];
+		float u = glm::dot(s, p) / determinant;
+		glm::vec3 q = glm::cross(s, edge1);
+		float v = glm::dot(direction, q) / determinant;
+		float t = glm::dot(edge2, q) / determinant;
+
+		if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t > 0.0f && t < distance)
+		{
+			distance = t;
+			bHasHit = true;
+		}
+	}
+
+	return bHasHit;
+}
+
+static std::vector<glm::vec3> MakeRandomTriangles(uint32_t count, std::mt19937& random)
+{
+	std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+
+	std::vector<glm::vec3> corners;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		glm::vec3 center = glm::vec3(position(random), position(random), position(random));
+		for (int32_t corner = 0; corner < 3; ++corner)
+		{
+			corners.push_back(center + glm::vec3(offset(random), offset(random), offset(random)));
+		}
+	}
+
+	return corners;
+}
+
+ED_TEST(TriangleBVH, MatchesTestingEveryTriangle)
+{
+	std::mt19937 random(7);
+	std::vector<glm::vec3> corners = MakeRandomTriangles(3000, random);
+
+	TriangleBVH bvh;
+	bvh.Build(corners);
+
+	ED_CHECK(bvh.GetTrianglesCount() == 3000)
+	ED_CHECK(bvh.GetNodesCount() > 1)
+
+	std::uniform_real_distribution<float> position(-15.0f, 15.0f);
+	std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+
+	uint32_t mismatches = 0;
+	for (uint32_t i = 0; i < 10000; ++i)
+	{
+		glm::vec3 origin = glm::vec3(position(random), position(random), position(random));
+		glm::vec3 rayDirection = glm::normalize(glm::vec3(direction(random), direction(random), direction(random)));
+		float maxDistance = i % 2 ? FLT_MAX : 5.0f;
+
+		float expectedDistance = 0.0f;
+		bool bExpectedHit = IntersectAll(corners, origin, rayDirection, maxDistance, expectedDistance);
+
+		TriangleHit hit;
+		bool bHit = bvh.Intersect(origin, rayDirection, maxDistance, hit);
+		bool bOccluded = bvh.IsOccluded(origin, rayDirection, maxDistance);
+
+		if (bHit != bExpectedHit || bOccluded != bExpectedHit || (bHit && std::abs(hit.Distance - expectedDistance) > 1e-3f))
+		{
+			++mismatches;
+		}
+	}
+
+	// Rays grazing an edge can go either way
+	ED_CHECK(mismatches <= 2)
+}
+
+ED_TEST(TriangleBVH, HitReportsTriangleAndBarycentrics)
+{
+	std::vector<glm::vec3> corners = {
+		glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f),
+		glm::vec3(0.0f, 0.0f, 2.0f), glm::vec3(1.0f, 0.0f, 2.0f), glm::vec3(0.0f, 1.0f, 2.0f)
+	};
+
+	TriangleBVH bvh;
+	bvh.Build(corners);
+
+	TriangleHit hit;
+	ED_CHECK(bvh.Intersect(glm::vec3(0.25f, 0.5f, -1.0f), glm::vec3(0.0f, 0.0f, 1.0f), FLT_MAX, hit))
+	ED_CHECK(hit.Triangle == 0)
+	ED_CHECK_NEAR(hit.Distance, 1.0f, 1e-5f)
+	ED_CHECK_NEAR(hit.Barycentrics.x, 0.25f, 1e-5f)
+	ED_CHECK_NEAR(hit.Barycentrics.y, 0.5f, 1e-5f)
+
+	// Triangles are hit from both sides
+	ED_CHECK(bvh.Intersect(glm::vec3(0.25f, 0.25f, 3.0f), glm::vec3(0.0f, 0.0f, -1.0f), FLT_MAX, hit))
+	ED_CHECK(hit.Triangle == 1)
+
+	ED_CHECK(!bvh.IsOccluded(glm::vec3(0.25f, 0.25f, -1.0f), glm::vec3(0.0f, 0.0f, 1.0f), 0.5f))
+	ED_CHECK(!bvh.IsOccluded(glm::vec3(2.0f, 2.0f, -1.0f), glm::vec3(0.0f, 0.0f, 1.0f), FLT_MAX))
+}
+
+ED_TEST(TriangleBVH, BuildIsDeterministic)
+{
+	std::mt19937 random(11);
+	std::vector<glm::vec3> corners = MakeRandomTriangles(500, random);
+
+	TriangleBVH first;
+	first.Build(corners);
+
+	TriangleBVH second;
+	second.Build(corners);
+
+	ED_CHECK(first.GetNodesCount() == second.GetNodesCount())
+	ED_CHECK(first.GetBoundsMin() == second.GetBoundsMin())
+	ED_CHECK(first.GetBoundsMax() == second.GetBoundsMax())
+}
+
+ED_TEST(TriangleBVH, EmptyHasNoHits)
+{
+	TriangleBVH bvh;
+	bvh.Build({});
+
+	TriangleHit hit;
+	ED_CHECK(!bvh.Intersect(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f), FLT_MAX, hit))
+	ED_CHECK(!bvh.IsOccluded(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f), FLT_MAX))
+}
\ No newline at end of file
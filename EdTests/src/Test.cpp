@@ -0,0 +1,49 @@
+#include "Test.h"
+#include <chrono>
+#include <cstdio>
+
+TestRegistry& TestRegistry::Get()
+{
+	static TestRegistry registry;
+	return registry;
+}
+
+bool TestRegistry::Add(const char* suite, const char* name, TestFunction function)
+{
+	m_Tests.push_back({ std::string(suite) + "." + name, function });
+	return true;
+}
+
+uint32_t TestRegistry::Run(const std::string& filter)
+{
+	uint32_t failedCount = 0;
+	uint32_t runCount = 0;
+
+	for (const Test& test : m_Tests)
+	{
+		if (test.Name.find(filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		m_CurrentFailures = 0;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		test.Function();
+		std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+
+		std::printf("[%s] %s (%.1f ms)\n", m_CurrentFailures ? "FAILED" : "OK", test.Name.c_str(), duration.count());
+
+		failedCount += m_CurrentFailures != 0;
+		++runCount;
+	}
+
+	std::printf("%u of %u tests failed\n", failedCount, runCount);
+	return failedCount;
+}
+
+void TestRegistry::Fail(const char* file, int32_t line, const std::string& message)
+{
+	std::printf("%s(%d): check failed: %s\n", file, line, message.c_str());
+	++m_CurrentFailures;
+}
\ No newline at end of file
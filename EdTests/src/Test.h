@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Tests of engine code that doesn't need a window or a graphics API. They register themselves before main runs,
+// a failed check marks its test as failed and the test keeps going, so one run reports every broken check
+class TestRegistry
+{
+public:
+	using TestFunction = void(*)();
+
+	static TestRegistry& Get();
+
+	bool Add(const char* suite, const char* name, TestFunction function);
+
+	// Runs tests whose full names contain the filter, returns the number of failed tests
+	uint32_t Run(const std::string& filter);
+
+	void Fail(const char* file, int32_t line, const std::string& message);
+
+private:
+	struct Test
+	{
+		std::string Name;
+		TestFunction Function = nullptr;
+	};
+
+	std::vector<Test> m_Tests;
+	uint32_t m_CurrentFailures = 0;
+};
+
+#define ED_TEST(suite, name) \
+	static void suite ## _ ## name(); \
+	static const bool suite ## _ ## name ## Registered = TestRegistry::Get().Add(#suite, #name, &suite ## _ ## name); \
+	static void suite ## _ ## name()
+
+#define ED_CHECK(condition) if (!(condition)) { TestRegistry::Get().Fail(__FILE__, __LINE__, #condition); }
+
+#define ED_CHECK_NEAR(value, expected, tolerance) \
+	if (!(std::abs((value) - (expected)) <= (tolerance))) \
+	{ \
+		TestRegistry::Get().Fail(__FILE__, __LINE__, std::string(#value) + " is " + std::to_string(value) + ", expected " + std::to_string(expected)); \
+	}
\ No newline at end of file
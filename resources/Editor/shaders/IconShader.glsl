@@ -18,7 +18,8 @@ void main() {
 
 #version 430 core
 
-uniform mat4 u_ProjectionViewMatrix;
+#include "shaders\common\view.glsl"
+
 uniform mat4 u_ModelTransform;
 
 layout(location = 0) in vec4 position;
@@ -17,6 +17,8 @@ void main()
 
 #version 430 core
 
+#include "shaders\common\grayscale.glsl"
+
 uniform sampler2D u_Color;
 
 in vec2 v_TextureCoordinates;
@@ -27,8 +29,5 @@ void main()
 {
 	vec3 color = texture2D(u_Color, v_TextureCoordinates).rgb;
 
-	vec3 multiplier = vec3(0.2126, 0.7152, 0.0722);
-	float scale = dot(multiplier, color);
-
-	grayscale = vec4(scale, scale, scale, 1.0f);
+	grayscale = vec4(ToGrayscale(color), 1.0f);
 }
\ No newline at end of file
@@ -0,0 +1,6 @@
+// Luminance of a color, used by the grayscale pass and the fused fullscreen pass
+vec3 ToGrayscale(vec3 color)
+{
+    vec3 multiplier = vec3(0.2126, 0.7152, 0.0722);
+    return vec3(dot(multiplier, color));
+}
@@ -0,0 +1,11 @@
+// Per instance data of instanced draws, filled by InstanceBuffer (see InstanceData)
+struct InstanceData {
+    mat4 ModelMatrix;
+    mat4 PreviousModelMatrix;
+    mat4 NormalMatrix;
+    vec4 LightmapScaleOffset;
+};
+
+layout(std430, binding = 0) readonly buffer Instances {
+    InstanceData u_Instances[];
+};
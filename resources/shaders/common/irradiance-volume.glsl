@@ -0,0 +1,77 @@
+// Baked irradiance volumes, filled by AmbientPass (see IrradianceVolumeData)
+struct IrradianceVolume {
+    vec3 Min;
+    float Padding0;
+    vec3 Max;
+    float Padding1;
+    uvec3 ProbesCount;
+    uint FirstProbe;
+};
+
+layout(std430, binding = 4) readonly buffer IrradianceVolumes {
+    IrradianceVolume u_IrradianceVolumes[];
+};
+
+// Nine cosine convolved spherical harmonics coefficients per probe, probes go along x first, then y, then z
+layout(std430, binding = 5) readonly buffer IrradianceProbes {
+    vec4 u_IrradianceProbes[];
+};
+
+uniform int u_IrradianceVolumesCount;
+
+// Irradiance divided by pi, the same thing lightmaps hold
+vec3 EvaluateIrradianceProbe(uint probe, vec3 n)
+{
+    uint first = 9 * probe;
+
+    vec3 result = 0.282095f * u_IrradianceProbes[first + 0].rgb;
+
+    result += 0.488603f * n.y * u_IrradianceProbes[first + 1].rgb;
+    result += 0.488603f * n.z * u_IrradianceProbes[first + 2].rgb;
+    result += 0.488603f * n.x * u_IrradianceProbes[first + 3].rgb;
+
+    result += 1.092548f * n.x * n.y * u_IrradianceProbes[first + 4].rgb;
+    result += 1.092548f * n.y * n.z * u_IrradianceProbes[first + 5].rgb;
+    result += 0.315392f * (3.0f * n.z * n.z - 1.0f) * u_IrradianceProbes[first + 6].rgb;
+    result += 1.092548f * n.x * n.z * u_IrradianceProbes[first + 7].rgb;
+    result += 0.546274f * (n.x * n.x - n.y * n.y) * u_IrradianceProbes[first + 8].rgb;
+
+    return result;
+}
+
+// Interpolates the eight probes around the position in the first volume containing it, false when no volume does
+bool SampleIrradianceVolumes(vec3 position, vec3 normal, out vec3 irradiance)
+{
+    for (int i = 0; i < u_IrradianceVolumesCount; ++i)
+    {
+        IrradianceVolume volume = u_IrradianceVolumes[i];
+
+        if (any(lessThan(position, volume.Min)) || any(greaterThan(position, volume.Max)))
+        {
+            continue;
+        }
+
+        vec3 last = vec3(volume.ProbesCount - 1u);
+        vec3 coordinates = clamp((position - volume.Min) / max(volume.Max - volume.Min, vec3(1e-6f)) * last, vec3(0.0f), last);
+
+        uvec3 base = uvec3(floor(coordinates));
+        vec3 fraction = coordinates - vec3(base);
+
+        irradiance = vec3(0.0f);
+        for (uint corner = 0u; corner < 8u; ++corner)
+        {
+            uvec3 offset = uvec3(corner & 1u, (corner >> 1u) & 1u, (corner >> 2u) & 1u);
+            uvec3 index = min(base + offset, volume.ProbesCount - 1u);
+
+            vec3 weights = mix(1.0f - fraction, fraction, vec3(offset));
+            uint probe = volume.FirstProbe + (index.z * volume.ProbesCount.y + index.y) * volume.ProbesCount.x + index.x;
+
+            irradiance += weights.x * weights.y * weights.z * EvaluateIrradianceProbe(probe, normal);
+        }
+
+        irradiance = max(irradiance, vec3(0.0f));
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,9 @@
+// Camera data shared by all passes, filled by Renderer::SetCamera (see ViewShaderParameters)
+layout(std140, binding = 0) uniform View {
+    mat4 u_ViewMatrix;
+    mat4 u_ProjectionMatrix;
+    mat4 u_ProjectionViewMatrix;
+    mat4 u_InvProjectionViewMatrix;
+    vec3 u_ViewPosition;
+    float u_FarPlane;
+};
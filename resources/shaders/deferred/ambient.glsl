@@ -0,0 +1,29 @@
+// Ambient light of a G-buffer pixel, used by the ambient pass and the fused fullscreen pass.
+// Includes can't be nested, so shaders\common\irradiance-volume.glsl has to be included before this file
+
+uniform sampler2D u_AmbientOcclusion;
+uniform sampler2D u_Lightmap;
+uniform sampler2D u_Position;
+uniform sampler2D u_Normal;
+
+// Lightmaps already hold occlusion of baked light, probes are used where there is no lightmap
+vec3 CalculateAmbientLight(vec2 coordinates, vec3 albedo)
+{
+    vec4 lightmap = texture(u_Lightmap, coordinates);
+    if (lightmap.a > 0.0f)
+    {
+        return albedo * lightmap.rgb;
+    }
+
+    vec3 position = texture(u_Position, coordinates).xyz;
+    vec3 normal = normalize(texture(u_Normal, coordinates).xyz);
+
+    vec3 irradiance;
+    if (SampleIrradianceVolumes(position, normal, irradiance))
+    {
+        return albedo * irradiance;
+    }
+
+    float AO = texture(u_AmbientOcclusion, coordinates).x;
+    return 0.1f * AO * albedo;
+}
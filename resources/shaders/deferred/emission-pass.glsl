@@ -12,10 +12,11 @@ void main() {
 
 #version 460 core
 
+#include "shaders\deferred\emission.glsl"
+
 uniform vec2 u_PixelSize;
 
 uniform sampler2D u_Albedo;
-uniform sampler2D u_RoughnessMetalic;
 
 layout(location = 0) out vec4 diffuse;
 layout(location = 1) out vec4 specular;
@@ -26,10 +27,7 @@ void main() {
     
     vec3 albedo = texture(u_Albedo, pos).xyz;
     
-    vec4 roughnessMetalic = texture(u_RoughnessMetalic, pos);
-    float emission = roughnessMetalic.z;
-    
-    diffuse = vec4(albedo * emission, 1.0f);
+    diffuse = vec4(CalculateEmission(pos, albedo), 1.0f);
     specular = vec4(0.0f, 0.0f, 0.0f, 1.0f);
     combined = diffuse;
 }
@@ -0,0 +1,9 @@
+// Light emitted by a G-buffer pixel, used by the emission pass and the fused fullscreen pass
+
+uniform sampler2D u_RoughnessMetalic;
+
+vec3 CalculateEmission(vec2 coordinates, vec3 albedo)
+{
+    float emission = texture(u_RoughnessMetalic, coordinates).z;
+    return albedo * emission;
+}
@@ -2,20 +2,38 @@
 
 #version 460 core
 
-uniform mat4 u_ProjectionMatrix;
-
-uniform mat4 u_PreviousViewMatrix;
-uniform mat4 u_ViewMatrix;
-
-uniform mat4 u_InvProjectionViewMatrix;
+#include "shaders\common\view.glsl"
+
+// Camera of the previous frame, filled by GBufferPass::UpdateCamera (see GBufferPassShaderParameters)
+layout(std140, binding = 1) uniform Frame {
+    mat4 u_PreviousViewMatrix;
+    mat4 u_PreviousProjectionMatrix;
+    vec2 u_Jitter;
+    vec2 u_PreviousJitter;
+};
 
-uniform vec3 u_ViewPosition;
+#ifdef INSTANCED
+#include "shaders\common\instance.glsl"
 
+#define u_PreviousModelMatrix u_Instances[gl_BaseInstance + gl_InstanceID].PreviousModelMatrix
+#define u_ModelMatrix u_Instances[gl_BaseInstance + gl_InstanceID].ModelMatrix
+#define u_NormalMatrix mat3(u_Instances[gl_BaseInstance + gl_InstanceID].NormalMatrix)
+#define u_LightmapScaleOffset u_Instances[gl_BaseInstance + gl_InstanceID].LightmapScaleOffset
+#else
 uniform mat4 u_PreviousModelMatrix;
 uniform mat4 u_ModelMatrix;
 uniform mat3 u_NormalMatrix;
+uniform vec4 u_LightmapScaleOffset;
+#endif
 
-uniform bool u_PerformNormalMapping;
+// Constants of the material drawn, filled by GBufferPass::UpdateMaterials (see GBufferPassMaterialShaderParameters)
+layout(std140, binding = 2) uniform Material {
+    vec3 BaseColor;
+    float Roughness;
+    float Metalic;
+    float Emission;
+    bool PerformNormalMapping;
+} u_Material;
 
 layout(location = 0) in vec3 vertex;
 layout(location = 1) in vec4 BaseColor;
@@ -23,6 +41,7 @@ layout(location = 2) in vec3 textureCoordinates;
 layout(location = 3) in vec3 normal;
 layout(location = 4) in vec3 tangent;
 layout(location = 5) in vec3 bitangent;
+layout(location = 6) in vec2 lightmapCoordinates;
 
 out vec4 v_CurrentPosition;
 out vec4 v_PreviousPosition;
@@ -31,6 +50,7 @@ out vec3 v_Position;
 out vec3 v_Normal;
 out vec4 v_BaseColor;
 out vec3 v_TextureCoordinates;
+out vec2 v_LightmapCoordinates;
 out mat3 v_TBN;
 
 void main()
@@ -43,7 +63,10 @@ void main()
     v_BaseColor = vec4(1.0f, 1.0f, 1.0f, 1.0f);
     v_TextureCoordinates = textureCoordinates;
 
-    if (u_PerformNormalMapping) {
+    // Negative coordinates mark meshes without a region in the lightmap
+    v_LightmapCoordinates = u_LightmapScaleOffset.x > 0.0f ? lightmapCoordinates * u_LightmapScaleOffset.xy + u_LightmapScaleOffset.zw : vec2(-1.0f);
+
+    if (u_Material.PerformNormalMapping) {
         vec3 T = normalize(u_NormalMatrix * tangent);
         vec3 N = normalize(u_NormalMatrix * normal);
         vec3 B = normalize(cross(T, N)); // TODO: maybe add switch or smth ;)
@@ -63,23 +86,20 @@ void main()
 #version 460 core
 #extension GL_ARB_bindless_texture : require
 
-struct Material {
+// Constants of the material drawn, filled by GBufferPass::UpdateMaterials (see GBufferPassMaterialShaderParameters)
+layout(std140, binding = 2) uniform Material {
     vec3 BaseColor;
-
     float Roughness;
     float Metalic;
     float Emission;
+    bool PerformNormalMapping;
+} u_Material;
 
-    sampler2D BaseColorTexture;
-    sampler2D NormalTexture;
-
-    bool HasNormalTexture;
-
-    sampler2D RoughnessTexture;
-    sampler2D MetalicTexture;
-};
-
-uniform Material u_Material;
+uniform sampler2D u_BaseColorTexture;
+uniform sampler2D u_NormalTexture;
+uniform sampler2D u_RoughnessTexture;
+uniform sampler2D u_MetalicTexture;
+uniform sampler2D u_Lightmap;
 
 in vec4 v_CurrentPosition;
 in vec4 v_PreviousPosition;
@@ -88,6 +108,7 @@ in vec3 v_Position;
 in vec3 v_Normal;
 in vec4 v_BaseColor;
 in vec3 v_TextureCoordinates;
+in vec2 v_LightmapCoordinates;
 in mat3 v_TBN;
 
 layout(location = 0) out vec4 albedo;
@@ -95,25 +116,28 @@ layout(location = 1) out vec4 position;
 layout(location = 2) out vec4 normal;
 layout(location = 3) out vec4 roughnessMetalic;
 layout(location = 4) out vec2 velocity;
+layout(location = 5) out vec4 lightmap;
 
 void main()
 {
-    albedo = vec4(u_Material.BaseColor, 1.0f) * v_BaseColor * texture2D(u_Material.BaseColorTexture, v_TextureCoordinates.xy);
+    albedo = vec4(u_Material.BaseColor, 1.0f) * v_BaseColor * texture2D(u_BaseColorTexture, v_TextureCoordinates.xy);
     position = vec4(v_Position, 1.0f);
 
-    if (u_Material.HasNormalTexture)
+    if (u_Material.PerformNormalMapping)
     {
-        normal = vec4(v_TBN * (2.0f * texture2D(u_Material.NormalTexture, v_TextureCoordinates.xy).xyz - 1.0f), 1.0f);
+        normal = vec4(v_TBN * (2.0f * texture2D(u_NormalTexture, v_TextureCoordinates.xy).xyz - 1.0f), 1.0f);
     }
     else
     {
         normal = vec4(v_Normal, 1.0f);
     }
 
-    float roughness = u_Material.Roughness * texture2D(u_Material.RoughnessTexture, v_TextureCoordinates.xy).r;
-    float metalic = u_Material.Metalic * texture2D(u_Material.MetalicTexture, v_TextureCoordinates.xy).r;
+    float roughness = u_Material.Roughness * texture2D(u_RoughnessTexture, v_TextureCoordinates.xy).r;
+    float metalic = u_Material.Metalic * texture2D(u_MetalicTexture, v_TextureCoordinates.xy).r;
     roughnessMetalic = vec4(roughness, metalic, u_Material.Emission, 1.0f);
 
+    lightmap = v_LightmapCoordinates.x >= 0.0f ? vec4(texture(u_Lightmap, v_LightmapCoordinates).rgb, 1.0f) : vec4(0.0f);
+
     vec2 current = (v_CurrentPosition.xy / v_CurrentPosition.w) * 0.5f + 0.5f;
     vec2 previous = (v_PreviousPosition.xy / v_PreviousPosition.w) * 0.5f + 0.5f;
     velocity = current - previous; // Not subtracting jitter because used the same projection matrix with the same jitter.
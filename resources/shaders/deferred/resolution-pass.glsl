@@ -17,42 +17,13 @@ void main()
 
 #version 460 core
 
-in vec2 v_TextureCoordinates;
-
-uniform sampler2D u_Light;
+#include "shaders\deferred\resolution.glsl"
 
-uniform sampler2D u_Bloom;
-uniform float u_BloomStrength;
-uniform float u_BloomIntensity = 1.0f;
-uniform bool u_IsBloomEnabled;
-
-uniform float u_Gamma;
+in vec2 v_TextureCoordinates;
 
 layout(location = 0) out vec4 result;
 
-vec3 ACESFilm(vec3 x)
-{
-    float a = 2.51f;
-    float b = 0.03f;
-    float c = 2.43f;
-    float d = 0.59f;
-    float e = 0.14f;
-    return clamp((x * (a * x + b)) / (x * (c * x + d) + e), 0.0, 1.0);
-}
-
 void main()
 {
-    vec3 color = texture(u_Light, v_TextureCoordinates).xyz;
-    
-    if (u_IsBloomEnabled)
-    {
-        vec3 bloom = texture(u_Bloom, v_TextureCoordinates).xyz * u_BloomIntensity;
-        color = mix(color, bloom, u_BloomStrength);
-    }
-
-    color = ACESFilm(color);
-    
-    color = pow(color, vec3(1.0f / u_Gamma));
-    
-    result = vec4(color, 1.0f);
+    result = vec4(ResolveColor(v_TextureCoordinates), 1.0f);
 }
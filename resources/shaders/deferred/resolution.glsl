@@ -0,0 +1,35 @@
+// Bloom, tone mapping and gamma correction of the lit image, used by the resolution pass and the fused fullscreen pass
+
+uniform sampler2D u_Light;
+
+uniform sampler2D u_Bloom;
+uniform float u_BloomStrength;
+uniform float u_BloomIntensity = 1.0f;
+uniform bool u_IsBloomEnabled;
+
+uniform float u_Gamma;
+
+vec3 ACESFilm(vec3 x)
+{
+    float a = 2.51f;
+    float b = 0.03f;
+    float c = 2.43f;
+    float d = 0.59f;
+    float e = 0.14f;
+    return clamp((x * (a * x + b)) / (x * (c * x + d) + e), 0.0, 1.0);
+}
+
+vec3 ResolveColor(vec2 coordinates)
+{
+    vec3 color = texture(u_Light, coordinates).xyz;
+
+    if (u_IsBloomEnabled)
+    {
+        vec3 bloom = texture(u_Bloom, coordinates).xyz * u_BloomIntensity;
+        color = mix(color, bloom, u_BloomStrength);
+    }
+
+    color = ACESFilm(color);
+
+    return pow(color, vec3(1.0f / u_Gamma));
+}
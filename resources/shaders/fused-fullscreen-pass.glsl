@@ -0,0 +1,94 @@
+// type vertex
+
+#version 460 core
+
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 textureCoordinates;
+
+out vec2 v_TextureCoordinates;
+
+void main()
+{
+    gl_Position = vec4(position, 0.0f, 1.0f);
+	v_TextureCoordinates = textureCoordinates;
+}
+
+// type fragment
+
+#version 460 core
+
+// Every define enables one of the merged fullscreen passes, their results are combined the way their blending would have combined them
+
+in vec2 v_TextureCoordinates;
+
+// Bodies of the passes live in the same files their standalone shaders include
+
+#if defined(AMBIENT_PASS) || defined(EMISSION_PASS)
+uniform sampler2D u_Albedo;
+
+layout(location = 0) out vec4 diffuse;
+layout(location = 1) out vec4 specular;
+layout(location = 2) out vec4 combined;
+#endif
+
+#ifdef AMBIENT_PASS
+#include "shaders\common\irradiance-volume.glsl"
+#include "shaders\deferred\ambient.glsl"
+#endif
+
+#ifdef EMISSION_PASS
+#include "shaders\deferred\emission.glsl"
+#endif
+
+#if defined(RESOLUTION_PASS) || defined(GRAYSCALE_PASS)
+layout(location = 0) out vec4 result;
+#endif
+
+#ifdef RESOLUTION_PASS
+#include "shaders\deferred\resolution.glsl"
+#endif
+
+#ifdef GRAYSCALE_PASS
+#include "shaders\common\grayscale.glsl"
+
+#ifndef RESOLUTION_PASS
+uniform sampler2D u_Color;
+#endif
+#endif
+
+void main()
+{
+#if defined(AMBIENT_PASS) || defined(EMISSION_PASS)
+    vec3 albedo = texture(u_Albedo, v_TextureCoordinates).xyz;
+    vec3 light = vec3(0.0f);
+
+#ifdef AMBIENT_PASS
+    light += CalculateAmbientLight(v_TextureCoordinates, albedo);
+#endif
+
+#ifdef EMISSION_PASS
+    // Emission pass is blended additively
+    light += CalculateEmission(v_TextureCoordinates, albedo);
+#endif
+
+    diffuse = vec4(light, 1.0f);
+    specular = vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    combined = diffuse;
+#endif
+
+#if defined(RESOLUTION_PASS) || defined(GRAYSCALE_PASS)
+#ifdef RESOLUTION_PASS
+    vec3 color = ResolveColor(v_TextureCoordinates);
+#else
+    // Nothing before it in the draw, the color is read from the target the way the standalone pass reads it
+    vec3 color = texture(u_Color, v_TextureCoordinates).rgb;
+#endif
+
+#ifdef GRAYSCALE_PASS
+    // Grayscale pass reads back the color at the same pixel, so it can work on the value computed before it
+    color = ToGrayscale(color);
+#endif
+
+    result = vec4(color, 1.0f);
+#endif
+}
@@ -0,0 +1,186 @@
+﻿// type vertex
+
+#version 460 core
+
+layout(location = 0) in vec3 position;
+
+void main() {
+    gl_Position = vec4(position, 0.0f);
+}
+
+// type fragment
+
+#version 460 core
+
+#define M_PI 3.1415926535897932384626433832795
+
+// Same as LightClusters
+#define CLUSTER_TILES_X 16
+#define CLUSTER_TILES_Y 9
+#define CLUSTER_SLICES 24
+
+#define POINT_LIGHT 0
+#define SPOT_LIGHT 1
+
+struct LightIntensity
+{
+    vec3 diffuse;
+    vec3 specular;
+};
+
+// Layout matches ClusteredLightData
+struct ClusteredLight
+{
+    vec3 Position;
+    float Range;
+    vec3 Color;
+    float Intensity;
+    vec3 Direction;
+    float InnerAngleCos;
+    float OuterAngleCos;
+    uint Type;
+    vec2 Padding;
+};
+
+layout(std430, binding = 1) readonly buffer Lights {
+    ClusteredLight lights[];
+};
+
+// Offset and count of every cluster in light indices
+layout(std430, binding = 2) readonly buffer Clusters {
+    uvec2 clusters[];
+};
+
+layout(std430, binding = 3) readonly buffer LightIndices {
+    uint lightIndices[];
+};
+
+uniform vec2 u_PixelSize;
+
+#include "shaders\common\view.glsl"
+
+uniform sampler2D u_Albedo;
+uniform sampler2D u_Position;
+uniform sampler2D u_Normal;
+uniform sampler2D u_RoughnessMetalic;
+
+uniform float u_SliceScale;
+uniform float u_SliceBias;
+
+layout(location = 0) out vec4 diffuse;
+layout(location = 1) out vec4 specular;
+layout(location = 2) out vec4 combined;
+
+float GX(float dot, float r) {
+    float k = (1.0f + r) * (1.0f + r) / 8.0f;
+    return dot / (dot * (1 - k) + k);
+}
+
+uint GetClusterIndex(vec2 pos, vec3 position)
+{
+    float depth = -(u_ViewMatrix * vec4(position, 1.0f)).z;
+    uint slice = uint(clamp(log(depth) * u_SliceScale + u_SliceBias, 0.0f, CLUSTER_SLICES - 1));
+
+    uvec2 tile = min(uvec2(pos * vec2(CLUSTER_TILES_X, CLUSTER_TILES_Y)), uvec2(CLUSTER_TILES_X - 1, CLUSTER_TILES_Y - 1));
+
+    return (slice * CLUSTER_TILES_Y + tile.y) * CLUSTER_TILES_X + tile.x;
+}
+
+LightIntensity GetIntensity(ClusteredLight light, vec3 albedo, float roughness, float metalic, vec3 normal, vec3 view, vec3 lightDirection)
+{
+    vec3 h = normalize(lightDirection + view);
+
+    float NdotV = max(dot(normal, view), 0.0f);
+    float HdotV = max(dot(h, view), 0.0f);
+    float NdotH = max(dot(normal, h), 0.0f);
+    float NdotL = max(dot(normal, lightDirection), 0.0f);
+
+    float NdotH2 = NdotH * NdotH;
+    float r2 = roughness * roughness;
+
+    vec3 F0 = mix(vec3(0.04f), albedo, metalic);
+
+    vec3 F = F0 + (vec3(1.0f) - F0) * pow(clamp((1.0f - HdotV), 0.0f, 1.0f), 5.0f);
+
+    float denominator = (NdotH2 * (r2 * r2 - 1.0f) + 1.0f);
+    float D = r2 * r2 / (M_PI * denominator * denominator + 0.0001f);
+
+    float G = GX(NdotV, roughness) * GX(NdotL, roughness);
+
+    vec3 diffuseIntensity = (vec3(1.0f) - F) * albedo / M_PI;
+    vec3 specularIntensity = F * G * D / (4.0f * NdotV * NdotL + 0.0001f);
+
+    vec3 baseIntensity = light.Intensity * light.Color * NdotL;
+
+    LightIntensity intensity;
+    intensity.diffuse = baseIntensity * diffuseIntensity;
+    intensity.specular = baseIntensity * specularIntensity;
+
+    return intensity;
+}
+
+// Same falloffs as point-light-pass.glsl and spot-light-pass.glsl without shadows
+float GetAttenuation(ClusteredLight light, vec3 position)
+{
+    vec3 pointLightVector = light.Position - position;
+    float distanceSqr = dot(pointLightVector, pointLightVector);
+
+    if (light.Type == POINT_LIGHT)
+    {
+        float radiusSqr = light.Range * light.Range;
+
+        float A = distanceSqr / radiusSqr;
+        float B = clamp(1 - A * A, 0.0f, 1.0f);
+
+        return B * B / (distanceSqr + 1.0f);
+    }
+
+    float angle = dot(normalize(position - light.Position), light.Direction);
+
+    if (light.OuterAngleCos > angle || distanceSqr >= light.Range * light.Range)
+    {
+        return 0.0f;
+    }
+
+    float a = 1.0f / (light.InnerAngleCos - light.OuterAngleCos);
+    float b = -light.OuterAngleCos * a;
+    float softness = clamp((a * angle + b) * (a * angle + b), 0.0f, 1.0f);
+
+    return softness / (distanceSqr + 1.0f);
+}
+
+void main()
+{
+    vec2 pos = gl_FragCoord.xy * u_PixelSize;
+
+    vec3 position = texture(u_Position, pos).xyz;
+    vec3 normal = texture(u_Normal, pos).xyz;
+    vec3 albedo = texture(u_Albedo, pos).xyz;
+
+    vec4 roughnessMetalic = texture(u_RoughnessMetalic, pos);
+    float roughness = roughnessMetalic.x;
+    float metalic = roughnessMetalic.y;
+
+    vec3 view = normalize(u_ViewPosition - position);
+
+    uvec2 cluster = clusters[GetClusterIndex(pos, position)];
+
+    diffuse = vec4(0.0f);
+    specular = vec4(0.0f);
+
+    for (uint i = 0; i < cluster.y; ++i)
+    {
+        ClusteredLight light = lights[lightIndices[cluster.x + i]];
+
+        float attenuation = GetAttenuation(light, position);
+        if (attenuation > 0.0f)
+        {
+            LightIntensity intensity = GetIntensity(light, albedo, roughness, metalic, normal, view, normalize(light.Position - position));
+
+            diffuse.xyz += intensity.diffuse * attenuation;
+            specular.xyz += intensity.specular * attenuation;
+        }
+    }
+
+    combined = diffuse + specular;
+}
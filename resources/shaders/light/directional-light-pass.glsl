@@ -45,17 +45,13 @@ struct Light
 
 uniform vec2 u_PixelSize;
 
-uniform vec3 u_ViewPosition;
-uniform float u_FarPlane;
+#include "shaders\common\view.glsl"
 
 uniform sampler2D u_Albedo;
 uniform sampler2D u_Position;
 uniform sampler2D u_Normal;
 uniform sampler2D u_RoughnessMetalic;
 
-uniform mat4 u_ViewMatrix;
-uniform mat4 u_ProjectionViewMatrix;
-
 uniform Light u_Light;
 
 layout(location = 0) out vec4 diffuse;
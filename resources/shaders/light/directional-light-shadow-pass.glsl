@@ -2,7 +2,13 @@
 
 #version 460 core
 
+#ifdef INSTANCED
+#include "shaders\common\instance.glsl"
+
+#define u_ModelMatrix u_Instances[gl_BaseInstance + gl_InstanceID].ModelMatrix
+#else
 uniform mat4 u_ModelMatrix;
+#endif
 
 layout(location = 0) in vec3 vertex;
 
@@ -14,27 +20,23 @@ void main() {
 
 #version 460 core
 
-#define MAX_CASCADES_COUNT 4
-
-uniform float u_Cascades;
-uniform mat4 u_ProjectionViewMatries[MAX_CASCADES_COUNT];
+// Cascades are drawn one at a time, only into the layers that need it
+uniform float u_Cascade;
+uniform mat4 u_ProjectionViewMatrix;
 
 layout(triangles) in;
 layout(triangle_strip) out;
-layout(max_vertices = 12) out;
+layout(max_vertices = 3) out;
 
 void main()
 {
-    for (int i = 0; i < u_Cascades && i <MAX_CASCADES_COUNT; ++i)
+    for (int j = 0; j < 3; ++j)
     {
-        for (int j = 0; j < 3; ++j)
-        {
-            gl_Position = u_ProjectionViewMatries[i] * gl_in[j].gl_Position;
-            gl_Layer = i;
-
-            EmitVertex();
-        }
-        
-        EndPrimitive();
+        gl_Position = u_ProjectionViewMatrix * gl_in[j].gl_Position;
+        gl_Layer = int(u_Cascade);
+
+        EmitVertex();
     }
+
+    EndPrimitive();
 }
\ No newline at end of file
@@ -2,7 +2,8 @@
 
 #version 460 core
 
-uniform mat4 u_ProjectionViewMatrix;
+#include "shaders\common\view.glsl"
+
 uniform mat4 u_ModelMatrix;
 
 layout(location = 0) in vec3 position;
@@ -34,15 +35,20 @@ struct Light
     
     bool UseShadowMap;
 
-    samplerCube ShadowMap;
+    // Faces are six layers starting at ShadowMapLayer, the light owns only the tile with scale in xy and offset in zw of every layer
+    sampler2DArray ShadowMap;
     float ShadowMapPixelSize;
+    vec4 ShadowMapTile;
+    float ShadowMapLayer;
     float FilterSize;
 };
 
 uniform vec2 u_PixelSize;
 
-uniform vec3 u_ViewPosition;
-uniform float u_FarPlane;
+#include "shaders\common\view.glsl"
+
+// Far plane of the point light shadow projection, View block has the one of the camera
+uniform float u_ShadowFarPlane;
 
 uniform sampler2D u_Albedo;
 uniform sampler2D u_Position;
@@ -53,9 +59,6 @@ uniform float u_Radius;
 uniform float u_SampleCount;
 uniform vec3 u_Samples[MAX_SAMPLES_COUNT];
 
-uniform mat4 u_ViewMatrix;
-uniform mat4 u_ProjectionViewMatrix;
-
 uniform Light u_Light;
 
 vec3 sampleOffsetDirections[20] = vec3[]
@@ -76,6 +79,38 @@ float GX(float dot, float r) {
     return dot / (dot * (1 - k) + k);
 }
 
+// Same faces and orientations as a cube map, returns coordinates within the face in xy and the face in z
+vec3 GetCubeFaceCoordinates(vec3 direction)
+{
+    vec3 absolute = abs(direction);
+
+    if (absolute.x >= absolute.y && absolute.x >= absolute.z)
+    {
+        vec2 coordinates = direction.x > 0.0f ? vec2(-direction.z, -direction.y) : vec2(direction.z, -direction.y);
+        return vec3(coordinates / absolute.x * 0.5f + 0.5f, direction.x > 0.0f ? 0.0f : 1.0f);
+    }
+
+    if (absolute.y >= absolute.z)
+    {
+        vec2 coordinates = direction.y > 0.0f ? vec2(direction.x, direction.z) : vec2(direction.x, -direction.z);
+        return vec3(coordinates / absolute.y * 0.5f + 0.5f, direction.y > 0.0f ? 2.0f : 3.0f);
+    }
+
+    vec2 coordinates = direction.z > 0.0f ? vec2(direction.x, -direction.y) : vec2(-direction.x, -direction.y);
+    return vec3(coordinates / absolute.z * 0.5f + 0.5f, direction.z > 0.0f ? 4.0f : 5.0f);
+}
+
+float SampleShadowMap(vec3 direction)
+{
+    vec3 face = GetCubeFaceCoordinates(direction);
+
+    // Samples stay inside the tile of the light, the rest of the layer belongs to other lights
+    vec2 halfPixel = vec2(0.5f * u_Light.ShadowMapPixelSize);
+    vec2 coordinates = clamp(face.xy * u_Light.ShadowMapTile.xy, halfPixel, u_Light.ShadowMapTile.xy - halfPixel) + u_Light.ShadowMapTile.zw;
+
+    return texture(u_Light.ShadowMap, vec3(coordinates, u_Light.ShadowMapLayer + face.z)).r;
+}
+
 float GetVisibility(vec2 pos, vec3 position, vec3 light, vec3 normal)
 {
     if (u_Light.UseShadowMap)
@@ -96,7 +131,7 @@ float GetVisibility(vec2 pos, vec3 position, vec3 light, vec3 normal)
             {
                 for (float k = -offset; k < offset; k += delta)
                 {
-                    float nearest = texture(u_Light.ShadowMap, -light.xyz + vec3(i, j, k)).r * u_FarPlane;
+                    float nearest = SampleShadowMap(-light.xyz + vec3(i, j, k)) * u_ShadowFarPlane;
                     if (nearest + bias < distance)
                     {
                         shadowIntensity += 1;
@@ -2,7 +2,13 @@
 
 #version 460 core
 
+#ifdef INSTANCED
+#include "shaders\common\instance.glsl"
+
+#define u_ModelMatrix u_Instances[gl_BaseInstance + gl_InstanceID].ModelMatrix
+#else
 uniform mat4 u_ModelMatrix;
+#endif
 
 layout(location = 0) in vec3 vertex;
 
@@ -15,6 +21,8 @@ void main() {
 #version 460 core
 
 uniform mat4 u_ViewProjection[6];
+// Faces of the light are the six layers starting at this one
+uniform float u_FirstLayer;
 
 out vec3 v_Position;
 
@@ -24,7 +32,7 @@ layout(max_vertices = 18) out;
 
 void main() {
     for (int i = 0; i < 6; ++i) {
-        gl_Layer = i;
+        gl_Layer = int(u_FirstLayer) + i;
         for (int j = 0; j < 3; ++j) {
             gl_Position = u_ViewProjection[i] * gl_in[j].gl_Position;
             v_Position = gl_in[j].gl_Position.xyz;
@@ -2,7 +2,8 @@
 
 #version 460 core
 
-uniform mat4 u_ProjectionViewMatrix;
+#include "shaders\common\view.glsl"
+
 uniform mat4 u_ModelMatrix;
 
 layout(location = 0) in vec3 position;
@@ -44,6 +45,8 @@ struct Light
     
     sampler2D ShadowMap;
     vec2 ShadowMapPixelSize;
+    // Scale in xy and offset in zw of the light tile in the atlas
+    vec4 ShadowMapTile;
 
     mat4 ShadowProjectionViewMatrix;
 
@@ -53,10 +56,9 @@ struct Light
     float ShadowFilterRadius;
 };
 
-uniform vec3 u_ViewPosition;
-uniform vec2 u_PixelSize;
+#include "shaders\common\view.glsl"
 
-uniform float u_FarPlane;
+uniform vec2 u_PixelSize;
 
 uniform sampler2D u_Albedo;
 uniform sampler2D u_Position;
@@ -85,6 +87,11 @@ float GetVisibility(vec2 pos, vec3 position, vec3 light, vec3 normal)
 
         projected.xyz = projected.xyz * 0.5f + 0.5f;
 
+        // Samples stay inside the tile of the light, the rest of the atlas belongs to other lights
+        vec2 tilePosition = projected.xy * u_Light.ShadowMapTile.xy + u_Light.ShadowMapTile.zw;
+        vec2 tileMin = u_Light.ShadowMapTile.zw + 0.5f * u_Light.ShadowMapPixelSize;
+        vec2 tileMax = u_Light.ShadowMapTile.zw + u_Light.ShadowMapTile.xy - 0.5f * u_Light.ShadowMapPixelSize;
+
         float visible = 0.0f;
 
         int r = int(u_Light.ShadowFilterSize / 2) + 1;
@@ -95,7 +102,8 @@ float GetVisibility(vec2 pos, vec3 position, vec3 light, vec3 normal)
             for (int j = l; j < r; ++j)
             {
                 vec2 samplePosition = texture2D(u_Light.ShadowSamples, vec2(projected.x + i * u_Light.ShadowSamplesPixelSize.x, j * u_Light.ShadowSamplesPixelSize.y)).xy;
-                float depth = texture2D(u_Light.ShadowMap, projected.xy + samplePosition * u_Light.ShadowFilterRadius * u_Light.ShadowMapPixelSize).r;
+                vec2 shadowMapPosition = clamp(tilePosition + samplePosition * u_Light.ShadowFilterRadius * u_Light.ShadowMapPixelSize, tileMin, tileMax);
+                float depth = texture2D(u_Light.ShadowMap, shadowMapPosition).r;
                 visible += depth + 0.001f >= projected.z ? 1.0f : 0.0f;
             }
         }
@@ -2,7 +2,14 @@
 
 #version 460 core
 
+#ifdef INSTANCED
+#include "shaders\common\instance.glsl"
+
+#define u_ModelMatrix u_Instances[gl_BaseInstance + gl_InstanceID].ModelMatrix
+#else
 uniform mat4 u_ModelMatrix;
+#endif
+
 uniform mat4 u_ProjectionViewMatrix;
 
 layout(location = 0) in vec3 vertex;
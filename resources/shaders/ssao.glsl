@@ -32,10 +32,9 @@ uniform sampler2D u_Noise;
 
 uniform vec2 u_ScreenSize;
 
-uniform mat4 u_ViewMatrix;
+#include "shaders\common\view.glsl"
+
 uniform mat4 u_NormalMatrix;
-uniform mat4 u_ProjectionMatrix;
-uniform mat4 u_ProjectionViewMatrix;
 
 uniform float u_Radius;
 uniform float u_Bias;
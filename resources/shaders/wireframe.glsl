@@ -2,7 +2,8 @@
 
 #version 460 core
 
-uniform mat4 u_ProjectionViewMatrix;
+#include "shaders\common\view.glsl"
+
 uniform mat4 u_ModelMatrix;
 
 layout(location = 0) in vec3 vertex;